@@ -36,6 +36,8 @@ const bool UStaticMeshComponent::bPropertiesRegistered = []() {
 BEGIN_PROPERTIES(UStaticMeshComponent)
     MARK_AS_COMPONENT("스태틱 메시 컴포넌트", "정적 메시를 렌더링하는 컴포넌트입니다")
     ADD_PROPERTY_STATICMESH(UStaticMesh*, StaticMesh, "Static Mesh", true, "Static mesh asset to render")
+    ADD_PROPERTY(bool, bUseAsOccluder, "Rendering", true, "화면에서 충분히 크면 CPU 오클루전 컬링의 오클루더(가리개)로 사용 (유리, 철망처럼 뒤가 보이는 메시는 끌 것)")
+    ADD_PROPERTY(bool, bForceOccluder, "Rendering", true, "화면 크기와 상관없이 항상 오클루더로 우선 사용 (벽, 건물 외벽 등)")
     ADD_PROPERTY(bool, bEnableCollision, "Physics", true, "체크 시 Static 물리 전환, 체크 해제 시 물리 제거")
     ADD_PROPERTY(bool, bSimulatePhysics, "Physics", true, "체크 시 Dynamic 물리로 전환")
     ADD_PROPERTY(float, MassOverride, "Physics", true, "Mass in kg")
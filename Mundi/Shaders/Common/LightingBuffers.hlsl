@@ -22,9 +22,11 @@ cbuffer LightBuffer : register(b8)
 };
 
 // --- 타일 기반 라이트 컬링 리소스 ---
-// t2: 타일별 라이트 인덱스 Structured Buffer
-// 구조:  [TileIndex * MaxLightsPerTile] = LightCount
-//        [TileIndex * MaxLightsPerTile + 1 ~ ...] = LightIndices (상위 16비트: 타입, 하위 16비트: 인덱스)
+// t2: 타일(클러스터)별 라이트 인덱스 Structured Buffer
+// 칸 인덱스: 2D 타일이면 TileIndex, 클러스터면 TileIndex * ClusterSliceCount + 깊이 슬라이스
+// 구조:  [CellIndex * 2] = 이 칸 목록의 시작 오프셋, [CellIndex * 2 + 1] = LightCount
+//        [Offset ~ Offset + LightCount) = LightIndices (상위 16비트: 타입, 하위 16비트: 인덱스)
+//        (그리드 뒤에 모든 타일의 목록이 빈틈없이 이어짐)
 StructuredBuffer<uint> g_TileLightIndices : register(t2);
 
 // PointLight, SpotLight Structured Buffer
@@ -40,7 +42,10 @@ cbuffer TileCullingBuffer : register(b11)
     uint bUseTileCulling;   // 타일 컬링 활성화 여부 (0=비활성화, 1=활성화)
     uint ViewportStartX;    // 뷰포트 시작 X 좌표
     uint ViewportStartY;    // 뷰포트 시작 Y 좌표
-    uint2 Padding;          // 16바이트 정렬을 위한 패딩
+    uint ClusterSliceCount; // 0: 2D 타일, 그 외: 타일당 깊이 슬라이스 수 (클러스터 컬링)
+    float ClusterDepthScale; // 슬라이스 = floor(log(뷰 깊이) * Scale + Bias)
+    float ClusterDepthBias;
+    uint3 Padding;          // 16바이트 정렬을 위한 패딩
 };
 
 TextureCubeArray g_PointShadowMapArray : register(t10);
@@ -55,12 +55,25 @@ uint CalculateTileIndex(float4 screenPos, float viewportStartX, float viewportSt
     return tileY * TileCountX + tileX;
 }
 
-// 타일별 라이트 인덱스 데이터의 시작 오프셋 계산
-uint GetTileDataOffset(uint tileIndex)
+// 픽셀이 읽을 라이트 그리드 칸 (2D 타일 또는 클러스터)
+// 클러스터 모드는 원근 투영에서만 켜지므로 SV_POSITION.w가 뷰 공간 깊이
+uint CalculateLightGridIndex(float4 screenPos, float viewportStartX, float viewportStartY)
 {
-    // MaxLightsPerTile = 256 (TileLightCuller.h와 일치)
-    const uint MaxLightsPerTile = 256;
-    return tileIndex * MaxLightsPerTile;
+    uint tileIndex = CalculateTileIndex(screenPos, viewportStartX, viewportStartY);
+    if (ClusterSliceCount == 0)
+    {
+        return tileIndex;
+    }
+
+    float slice = floor(log(max(screenPos.w, 1e-4f)) * ClusterDepthScale + ClusterDepthBias);
+    return tileIndex * ClusterSliceCount + (uint)clamp(slice, 0.0f, (float)(ClusterSliceCount - 1));
+}
+
+// 칸별 라이트 목록의 시작 오프셋과 개수 (TileLightCuller.h의 레이아웃과 일치)
+void GetTileLightRange(uint tileIndex, out uint lightOffset, out uint lightCount)
+{
+    lightOffset = g_TileLightIndices[tileIndex * 2];
+    lightCount = g_TileLightIndices[tileIndex * 2 + 1];
 }
 
 //================================================================================================
@@ -879,13 +892,13 @@ float3 CalculateAllLights(
     // Point + Spot with 타일 컬링
     if (bUseTileCulling)
     {
-        uint tileIndex = CalculateTileIndex(screenPos, ViewportStartX, ViewportStartY);
-        uint tileDataOffset = GetTileDataOffset(tileIndex);
-        uint lightCount = g_TileLightIndices[tileDataOffset];
+        uint tileIndex = CalculateLightGridIndex(screenPos, ViewportStartX, ViewportStartY);
+        uint lightOffset, lightCount;
+        GetTileLightRange(tileIndex, lightOffset, lightCount);
 
         for (uint i = 0; i < lightCount; i++)
         {
-            uint packedIndex = g_TileLightIndices[tileDataOffset + 1 + i];
+            uint packedIndex = g_TileLightIndices[lightOffset + i];
             uint lightType = (packedIndex >> 16) & 0xFFFF;
             uint lightIdx = packedIndex & 0xFFFF;
 
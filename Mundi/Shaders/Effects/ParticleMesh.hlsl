@@ -225,14 +225,14 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     // Tile Culling 적용
     if (bUseTileCulling)
     {
-        uint tileIndex = CalculateTileIndex(Input.Position, ViewportStartX, ViewportStartY);
-        uint tileDataOffset = GetTileDataOffset(tileIndex);
-        uint lightCount = g_TileLightIndices[tileDataOffset];
+        uint tileIndex = CalculateLightGridIndex(Input.Position, ViewportStartX, ViewportStartY);
+        uint lightOffset, lightCount;
+        GetTileLightRange(tileIndex, lightOffset, lightCount);
 
         [loop]
         for (uint i = 0; i < lightCount; i++)
         {
-            uint packedIndex = g_TileLightIndices[tileDataOffset + 1 + i];
+            uint packedIndex = g_TileLightIndices[lightOffset + i];
             uint lightType = (packedIndex >> 16) & 0xFFFF;
             uint lightIdx = packedIndex & 0xFFFF;
 
@@ -13,6 +13,12 @@
 #define USE_GPU_SKINNING 0
 #endif
 
+// 자동 인스턴싱 (FSceneRenderer::RenderOpaquePass에서 같은 상태의 스태틱 메시 드로우를 합침)
+// 켜면 ModelBuffer/ColorBuffer 대신 인스턴스 버퍼(t15)에서 월드 행렬과 색상/ID를 읽음
+#ifndef USE_INSTANCING
+#define USE_INSTANCING 0
+#endif
+
 // --- Material 구조체 (OBJ 머티리얼 정보) ---
 // 주의: SPECULAR_COLOR 매크로에서 사용하므로 include 전에 정의 필요
 struct FMaterial
@@ -95,6 +101,26 @@ StructuredBuffer<float4x4> g_SkinnedMatrices : register(t12);
 StructuredBuffer<float4x4> g_SkinnedNormalMatrices : register(t13);
 #endif
 
+#if USE_INSTANCING
+// FMeshInstanceData와 정확히 일치 (160 bytes)
+struct FInstanceData
+{
+    row_major float4x4 WorldMatrix;
+    row_major float4x4 WorldInverseTranspose;
+    float4 LerpColor;
+    uint UUID;
+    uint3 Padding;
+};
+StructuredBuffer<FInstanceData> g_InstanceData : register(t15);
+
+// b9: FInstancingBufferType - 이 드로우의 첫 인스턴스 위치
+cbuffer InstancingBuffer : register(b9)
+{
+    uint InstanceOffset;
+    uint3 InstancingPadding;
+};
+#endif
+
 SamplerState g_Sample : register(s0);
 SamplerState g_Sample2 : register(s1);
 SamplerComparisonState g_ShadowSample : register(s2);
@@ -151,6 +177,9 @@ struct VS_INPUT
     uint4 BoneIndices : BLENDINDICES0;
     float4 BoneWeights : BLENDWEIGHT0;
 #endif        
+#if USE_INSTANCING
+    uint InstanceID : SV_InstanceID;
+#endif
 };
 
 struct PS_INPUT
@@ -161,6 +190,10 @@ struct PS_INPUT
     row_major float3x3 TBN : TBN;
     float4 Color : COLOR;
     float2 TexCoord : TEXCOORD0;
+#if USE_INSTANCING
+    nointerpolation float4 InstanceColor : INSTANCECOLOR;
+    nointerpolation uint InstanceUUID : INSTANCEUUID;
+#endif
 };
 
 struct PS_OUTPUT
@@ -186,16 +219,27 @@ PS_INPUT mainVS(VS_INPUT Input)
     float3 ModelTangent = Input.Tangent.xyz;
 #endif
 
-    float4 WorldPos = mul(float4(ModelPosition, 1.0f), WorldMatrix);
+#if USE_INSTANCING
+    const FInstanceData Instance = g_InstanceData[InstanceOffset + Input.InstanceID];
+    const float4x4 ObjectWorldMatrix = Instance.WorldMatrix;
+    const float4x4 ObjectWorldInverseTranspose = Instance.WorldInverseTranspose;
+    Out.InstanceColor = Instance.LerpColor;
+    Out.InstanceUUID = Instance.UUID;
+#else
+    const float4x4 ObjectWorldMatrix = WorldMatrix;
+    const float4x4 ObjectWorldInverseTranspose = WorldInverseTranspose;
+#endif
+
+    float4 WorldPos = mul(float4(ModelPosition, 1.0f), ObjectWorldMatrix);
     Out.WorldPos = WorldPos.xyz;
 
     float4 ViewPos = mul(WorldPos, ViewMatrix);
     Out.Position = mul(ViewPos, ProjectionMatrix);
 
-    float3 WorldNormal = normalize(mul(ModelNormal, (float3x3)WorldInverseTranspose));
+    float3 WorldNormal = normalize(mul(ModelNormal, (float3x3)ObjectWorldInverseTranspose));
     Out.Normal = WorldNormal;
 
-    float3 Tangent = normalize(mul(ModelTangent, (float3x3)WorldMatrix));
+    float3 Tangent = normalize(mul(ModelTangent, (float3x3)ObjectWorldMatrix));
     float3 BiTangent = normalize(cross(WorldNormal, Tangent) * Input.Tangent.w);
     row_major float3x3 TBN;
     TBN._m00_m01_m02 = Tangent;
@@ -282,7 +326,13 @@ PS_INPUT mainVS(VS_INPUT Input)
 PS_OUTPUT mainPS(PS_INPUT Input)
 {
     PS_OUTPUT Output;
+#if USE_INSTANCING
+    const float4 ObjectLerpColor = Input.InstanceColor;
+    Output.UUID = Input.InstanceUUID;
+#else
+    const float4 ObjectLerpColor = LerpColor;
     Output.UUID = UUID;
+#endif
     
     //CSM 구간 시각화
     float3 Color[2] =
@@ -390,7 +440,7 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     // 비머티리얼 오브젝트의 머티리얼/색상 블렌딩 적용
     if (!bHasMaterial)
     {
-        finalPixel.rgb = lerp(finalPixel.rgb, LerpColor.rgb, LerpColor.a);
+        finalPixel.rgb = lerp(finalPixel.rgb, ObjectLerpColor.rgb, ObjectLerpColor.a);
     }
 
     // 머티리얼 투명도 적용 (0=불투명, 1=투명)
@@ -421,7 +471,7 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     else
     {
         // 텍스처와 머티리얼 모두 없음, LerpColor와 블렌드
-        baseColor.rgb = lerp(baseColor.rgb, LerpColor.rgb, LerpColor.a);
+        baseColor.rgb = lerp(baseColor.rgb, ObjectLerpColor.rgb, ObjectLerpColor.a);
     }
 
     float3 litColor = float3(0.0f, 0.0f, 0.0f);
@@ -442,18 +492,18 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     // 타일 기반 라이트 컬링 적용 (활성화된 경우)
     if (bUseTileCulling)
     {
-        // 현재 픽셀이 속한 타일 계산
-        uint tileIndex = CalculateTileIndex(Input.Position, ViewportStartX, ViewportStartY);
-        uint tileDataOffset = GetTileDataOffset(tileIndex);
+        // 현재 픽셀이 속한 타일(클러스터) 계산
+        uint tileIndex = CalculateLightGridIndex(Input.Position, ViewportStartX, ViewportStartY);
 
-        // 타일에 영향을 주는 라이트 개수
-        uint lightCount = g_TileLightIndices[tileDataOffset];
+        // 타일에 영향을 주는 라이트 목록 범위
+        uint lightOffset, lightCount;
+        GetTileLightRange(tileIndex, lightOffset, lightCount);
 
         // 타일 내 라이트만 순회
         [loop]
         for (uint i = 0; i < lightCount; i++)
         {
-            uint packedIndex = g_TileLightIndices[tileDataOffset + 1 + i];
+            uint packedIndex = g_TileLightIndices[lightOffset + i];
             uint lightType = (packedIndex >> 16) & 0xFFFF;  // 상위 16비트: 타입
             uint lightIdx = packedIndex & 0xFFFF;           // 하위 16비트: 인덱스
 
@@ -530,7 +580,7 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     else
     {
         // 텍스처와 머티리얼 모두 없음, LerpColor와 블렌드
-        baseColor.rgb = lerp(baseColor.rgb, LerpColor.rgb, LerpColor.a);
+        baseColor.rgb = lerp(baseColor.rgb, ObjectLerpColor.rgb, ObjectLerpColor.a);
     }
 
     float3 litColor = float3(0.0f, 0.0f, 0.0f);
@@ -554,18 +604,18 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     // 타일 기반 라이트 컬링 적용 (활성화된 경우)
     if (bUseTileCulling)
     {
-        // 현재 픽셀이 속한 타일 계산
-        uint tileIndex = CalculateTileIndex(Input.Position, ViewportStartX, ViewportStartY);
-        uint tileDataOffset = GetTileDataOffset(tileIndex);
+        // 현재 픽셀이 속한 타일(클러스터) 계산
+        uint tileIndex = CalculateLightGridIndex(Input.Position, ViewportStartX, ViewportStartY);
 
-        // 타일에 영향을 주는 라이트 개수
-        uint lightCount = g_TileLightIndices[tileDataOffset];
+        // 타일에 영향을 주는 라이트 목록 범위
+        uint lightOffset, lightCount;
+        GetTileLightRange(tileIndex, lightOffset, lightCount);
 
         // 타일 내 라이트만 순회
         [loop]
         for (uint i = 0; i < lightCount; i++)
         {
-            uint packedIndex = g_TileLightIndices[tileDataOffset + 1 + i];
+            uint packedIndex = g_TileLightIndices[lightOffset + i];
             uint lightType = (packedIndex >> 16) & 0xFFFF;  // 상위 16비트: 타입
             uint lightIdx = packedIndex & 0xFFFF;           // 하위 16비트: 인덱스
 
@@ -633,7 +683,7 @@ PS_OUTPUT mainPS(PS_INPUT Input)
     else
     {
         // LerpColor와 블렌드
-        finalPixel.rgb = lerp(finalPixel.rgb, LerpColor.rgb, LerpColor.a);
+        finalPixel.rgb = lerp(finalPixel.rgb, ObjectLerpColor.rgb, ObjectLerpColor.a);
         finalPixel.rgb *= texColor.rgb;
     }
 
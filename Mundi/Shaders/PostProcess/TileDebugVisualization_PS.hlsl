@@ -13,7 +13,10 @@ cbuffer TileCullingBuffer : register(b11)
     uint bUseTileCulling;   // 타일 컬링 활성화 여부 (0=비활성화, 1=활성화)
     uint ViewportStartX;    // 뷰포트 시작 X 좌표
     uint ViewportStartY;    // 뷰포트 시작 Y 좌표
-    uint2 Padding;          // 16바이트 정렬을 위한 패딩
+    uint ClusterSliceCount; // 0: 2D 타일, 그 외: 타일당 깊이 슬라이스 수 (클러스터 컬링)
+    float ClusterDepthScale; // 슬라이스 = floor(log(뷰 깊이) * Scale + Bias)
+    float ClusterDepthBias;
+    uint3 Padding;          // 16바이트 정렬을 위한 패딩
 };
 
 // t0: 원본 씬 텍스처
@@ -21,8 +24,8 @@ Texture2D g_SceneTexture : register(t0);
 SamplerState g_SamplerLinear : register(s0);
 
 // t2: 타일별 라이트 인덱스 Structured Buffer
-// 구조: [TileIndex * MaxLightsPerTile] = LightCount
-//       [TileIndex * MaxLightsPerTile + 1 ~ ...] = LightIndices
+// 구조: [TileIndex * 2] = 목록 시작 오프셋, [TileIndex * 2 + 1] = LightCount
+//       [Offset ~ Offset + LightCount) = LightIndices
 StructuredBuffer<uint> g_TileLightIndices : register(t2);
 
 // 타일 인덱스 계산
@@ -38,11 +41,21 @@ uint CalculateTileIndex(float2 screenPos)
     return tileY * TileCountX + tileX;
 }
 
-// 타일별 라이트 인덱스 데이터의 시작 오프셋 계산
-uint GetTileDataOffset(uint tileIndex)
+// 타일의 라이트 개수 (그리드의 두 번째 값)
+// 클러스터 모드는 화면 깊이를 모르므로 타일 안 슬라이스 중 최댓값
+uint GetTileLightCount(uint tileIndex)
 {
-    const uint MaxLightsPerTile = 256;
-    return tileIndex * MaxLightsPerTile;
+    if (ClusterSliceCount == 0)
+    {
+        return g_TileLightIndices[tileIndex * 2 + 1];
+    }
+
+    uint maxCount = 0;
+    for (uint slice = 0; slice < ClusterSliceCount; slice++)
+    {
+        maxCount = max(maxCount, g_TileLightIndices[(tileIndex * ClusterSliceCount + slice) * 2 + 1]);
+    }
+    return maxCount;
 }
 
 // 라이트 개수를 색상으로 변환 (히트맵)
@@ -98,10 +111,9 @@ float4 mainPS(float4 Pos : SV_Position, float2 TexCoord : TEXCOORD0) : SV_Target
 
     // 현재 픽셀이 속한 타일 계산
     uint tileIndex = CalculateTileIndex(Pos.xy);
-    uint tileDataOffset = GetTileDataOffset(tileIndex);
 
     // 타일의 라이트 개수
-    uint lightCount = g_TileLightIndices[tileDataOffset];
+    uint lightCount = GetTileLightCount(tileIndex);
 
     // 히트맵 색상 계산
     float3 heatmapColor = LightCountToHeatmap(lightCount);
@@ -0,0 +1,21 @@
+// 정적 캐스터 섀도우 캐시를 아틀라스 영역(또는 큐브 면)에 깊이로 합성
+// 깊이 리소스는 CopySubresourceRegion으로 일부 영역만 복사할 수 없으므로 SV_Depth로 씀
+// FullScreenTriangle_VS와 함께 사용 (ViewportConstants는 TexCoord가 0~1이 되도록 설정)
+
+Texture2D<float> g_StaticShadowDepth : register(t0);
+
+struct PS_INPUT
+{
+    float4 Position : SV_POSITION;
+    float2 TexCoord : TEXCOORD0;
+};
+
+float mainPS(PS_INPUT Input) : SV_Depth
+{
+    uint Width, Height;
+    g_StaticShadowDepth.GetDimensions(Width, Height);
+
+    // 캐시와 대상 영역은 같은 해상도이므로 텍셀 1:1
+    int2 Texel = min(int2(Input.TexCoord * float2(Width, Height)), int2(Width - 1, Height - 1));
+    return g_StaticShadowDepth.Load(int3(Texel, 0));
+}
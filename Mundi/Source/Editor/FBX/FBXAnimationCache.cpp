@@ -3,11 +3,48 @@
 #include "Source/Runtime/Engine/Animation/AnimSequence.h"
 #include "Source/Runtime/Engine/Animation/AnimDateModel.h"
 #include "ObjectFactory.h"
-#include "WindowsBinReader.h"
-#include "WindowsBinWriter.h"
+#include "CookedAsset.h"
 #include "PathUtils.h"
 #include <filesystem>
 
+namespace
+{
+	constexpr uint32 TagBoneNames = CookedAsset::MakeTag('B', 'N', 'A', 'M');
+	constexpr uint32 TagTracks = CookedAsset::MakeTag('T', 'R', 'A', 'K');
+	constexpr uint32 TagPosKeys = CookedAsset::MakeTag('P', 'O', 'S', 'K');
+	constexpr uint32 TagRotKeys = CookedAsset::MakeTag('R', 'O', 'T', 'K');
+	constexpr uint32 TagScaleKeys = CookedAsset::MakeTag('S', 'C', 'L', 'K');
+
+	struct FCookedAnimMeta
+	{
+		FCookedStringRef Name;
+		float PlayLength;
+		int32 FrameRate;
+		int32 NumberOfFrames;
+		int32 NumberOfKeys;
+	};
+
+	/** 키 배열 내 구간 */
+	struct FCookedKeyRange
+	{
+		uint32 Offset;
+		uint32 Count;
+
+		bool IsValidFor(int32 NumKeys) const
+		{
+			return static_cast<uint64>(Offset) + Count <= static_cast<uint64>(NumKeys);
+		}
+	};
+
+	struct FCookedAnimTrack
+	{
+		FCookedStringRef Name;
+		FCookedKeyRange PosKeys;
+		FCookedKeyRange RotKeys;
+		FCookedKeyRange ScaleKeys;
+	};
+}
+
 bool FBXAnimationCache::TryLoadAnimationsFromCache(const FString& NormalizedPath, TArray<UAnimSequence*>& OutAnimations)
 {
 #ifdef USE_OBJ_CACHE
@@ -29,7 +66,7 @@ bool FBXAnimationCache::TryLoadAnimationsFromCache(const FString& NormalizedPath
 			continue;
 		}
 
-		if (Entry.path().extension() != ".bin")
+		if (Entry.path().extension() != CookedAsset::Extension)
 		{
 			continue;
 		}
@@ -52,7 +89,7 @@ bool FBXAnimationCache::TryLoadAnimationsFromCache(const FString& NormalizedPath
 
 	if (!bLoadedAny)
 	{
-		UE_LOG("Animation cache directory '%s' did not contain valid .anim.bin files", AnimCacheDir.c_str());
+		UE_LOG("Animation cache directory '%s' did not contain valid .anim.cooked files", AnimCacheDir.c_str());
 	}
 
 	return bLoadedAny;
@@ -70,176 +107,142 @@ bool FBXAnimationCache::SaveAnimationToCache(UAnimSequence* Animation, const FSt
 		return false;
 	}
 
-	try
+	UAnimDataModel* DataModel = Animation->GetDataModel();
+	if (!DataModel)
 	{
-		FWindowsBinWriter Writer(CachePath);
-
-		UAnimDataModel* DataModel = Animation->GetDataModel();
-		if (!DataModel)
-		{
-			return false;
-		}
+		return false;
+	}
 
-		// 애니메이션 이름 먼저 쓰기
-		FString AnimName = Animation->ObjectName.ToString();
-		Serialization::WriteString(Writer, AnimName);
-
-		// 메타데이터 쓰기
-		float PlayLength = DataModel->GetPlayLength();
-		int32 FrameRate = DataModel->GetFrameRate();
-		int32 NumberOfFrames = DataModel->GetNumberOfFrames();
-		int32 NumberOfKeys = DataModel->GetNumberOfKeys();
-
-		Writer << PlayLength;
-		Writer << FrameRate;
-		Writer << NumberOfFrames;
-		Writer << NumberOfKeys;
-
-		// 호환성 검사를 위한 본 이름 쓰기
-		const TArray<FName>& BoneNames = Animation->GetBoneNames();
-		uint32 NumBoneNames = (uint32)BoneNames.Num();
-		Writer << NumBoneNames;
-		for (const FName& BoneName : BoneNames)
-		{
-			FString BoneNameStr = BoneName.ToString();
-			Serialization::WriteString(Writer, BoneNameStr);
-		}
+	FCookedAssetWriter Writer(ECookedAssetType::AnimSequence);
 
-		// 본 트랙 쓰기
-		TArray<FBoneAnimationTrack>& Tracks = DataModel->GetBoneAnimationTracks();
-		uint32 NumTracks = (uint32)Tracks.Num();
-		Writer << NumTracks;
+	// 메타데이터
+	FCookedAnimMeta Meta{};
+	Meta.Name = Writer.AddString(Animation->ObjectName.ToString());
+	Meta.PlayLength = DataModel->GetPlayLength();
+	Meta.FrameRate = DataModel->GetFrameRate();
+	Meta.NumberOfFrames = DataModel->GetNumberOfFrames();
+	Meta.NumberOfKeys = DataModel->GetNumberOfKeys();
+	Writer.AddStruct(CookedAsset::TagMeta, Meta);
 
-		for (FBoneAnimationTrack& Track : Tracks)
-		{
-			// 본 이름 쓰기
-			FString BoneName = Track.Name.ToString();
-			Serialization::WriteString(Writer, BoneName);
-
-			// 위치 키 쓰기
-			Serialization::WriteArray(Writer, Track.InternalTrack.PosKeys);
-
-			// 회전 키 쓰기 (FQuat는 직접 직렬화)
-			TArray<FQuat>& RotKeys = Track.InternalTrack.RotKeys;
-			uint32 NumRotKeys = (uint32)RotKeys.Num();
-			Writer << NumRotKeys;
-			for (FQuat& Rot : RotKeys)
-			{
-				Writer << Rot.X << Rot.Y << Rot.Z << Rot.W;
-			}
+	// 호환성 검사를 위한 본 이름
+	TArray<FCookedStringRef> BoneNames;
+	for (const FName& BoneName : Animation->GetBoneNames())
+	{
+		BoneNames.Add(Writer.AddString(BoneName.ToString()));
+	}
+	Writer.AddArray(TagBoneNames, BoneNames);
+
+	// 본 트랙: 키는 종류별로 하나의 배열에 모으고 트랙은 구간만 기록
+	const TArray<FBoneAnimationTrack>& Tracks = DataModel->GetBoneAnimationTracks();
+	TArray<FCookedAnimTrack> CookedTracks;
+	TArray<FVector> PosKeys;
+	TArray<FQuat> RotKeys;
+	TArray<FVector> ScaleKeys;
+	CookedTracks.reserve(Tracks.Num());
+	for (const FBoneAnimationTrack& Track : Tracks)
+	{
+		const FRawAnimSequenceTrack& Raw = Track.InternalTrack;
 
-			// 스케일 키 쓰기
-			Serialization::WriteArray(Writer, Track.InternalTrack.ScaleKeys);
-		}
+		FCookedAnimTrack& Cooked = CookedTracks.emplace_back();
+		Cooked.Name = Writer.AddString(Track.Name.ToString());
+		Cooked.PosKeys = { static_cast<uint32>(PosKeys.size()), static_cast<uint32>(Raw.PosKeys.size()) };
+		Cooked.RotKeys = { static_cast<uint32>(RotKeys.size()), static_cast<uint32>(Raw.RotKeys.size()) };
+		Cooked.ScaleKeys = { static_cast<uint32>(ScaleKeys.size()), static_cast<uint32>(Raw.ScaleKeys.size()) };
 
-		Writer.Close();
-		UE_LOG("Animation saved to cache: %s", CachePath.c_str());
-		return true;
+		PosKeys.insert(PosKeys.end(), Raw.PosKeys.begin(), Raw.PosKeys.end());
+		RotKeys.insert(RotKeys.end(), Raw.RotKeys.begin(), Raw.RotKeys.end());
+		ScaleKeys.insert(ScaleKeys.end(), Raw.ScaleKeys.begin(), Raw.ScaleKeys.end());
 	}
-	catch (const std::exception& e)
+	Writer.AddArray(TagTracks, CookedTracks);
+	Writer.AddArray(TagPosKeys, PosKeys);
+	Writer.AddArray(TagRotKeys, RotKeys);
+	Writer.AddArray(TagScaleKeys, ScaleKeys);
+
+	if (!Writer.Save(CachePath))
 	{
-		UE_LOG("Failed to save animation cache: %s", e.what());
+		UE_LOG("Failed to save animation cache: %s", CachePath.c_str());
 		return false;
 	}
+
+	UE_LOG("Animation saved to cache: %s", CachePath.c_str());
+	return true;
 }
 
 UAnimSequence* FBXAnimationCache::LoadAnimationFromCache(const FString& CachePath)
 {
-	try
+	FCookedAssetFile File;
+	if (!File.Open(CachePath, ECookedAssetType::AnimSequence))
 	{
-		FWindowsBinReader Reader(CachePath);
-		if (!Reader.IsOpen())
-		{
-			return nullptr;
-		}
-
-		// 새 애니메이션 시퀀스 생성
-		UAnimSequence* Animation = NewObject<UAnimSequence>();
+		return nullptr;
+	}
 
-		// 애니메이션 이름 먼저 읽기
-		FString AnimName;
-		Serialization::ReadString(Reader, AnimName);
-		Animation->ObjectName = FName(AnimName);
+	FCookedAnimMeta Meta{};
+	TCookedArrayView<FCookedStringRef> BoneNameRefs;
+	TCookedArrayView<FCookedAnimTrack> Tracks;
+	TCookedArrayView<FVector> PosKeys;
+	TCookedArrayView<FQuat> RotKeys;
+	TCookedArrayView<FVector> ScaleKeys;
+	if (!File.ReadStruct(CookedAsset::TagMeta, Meta)
+		|| !File.GetArray(TagBoneNames, BoneNameRefs)
+		|| !File.GetArray(TagTracks, Tracks)
+		|| !File.GetArray(TagPosKeys, PosKeys)
+		|| !File.GetArray(TagRotKeys, RotKeys)
+		|| !File.GetArray(TagScaleKeys, ScaleKeys))
+	{
+		UE_LOG("Failed to load animation from cache: %s", CachePath.c_str());
+		return nullptr;
+	}
 
-		UAnimDataModel* DataModel = Animation->GetDataModel();
-		if (!DataModel)
+	// 트랙 구간이 키 배열을 벗어나면 손상된 캐시
+	for (const FCookedAnimTrack& Track : Tracks)
+	{
+		if (!Track.PosKeys.IsValidFor(PosKeys.Num())
+			|| !Track.RotKeys.IsValidFor(RotKeys.Num())
+			|| !Track.ScaleKeys.IsValidFor(ScaleKeys.Num()))
 		{
+			UE_LOG("Failed to load animation from cache: %s (corrupt track range)", CachePath.c_str());
 			return nullptr;
 		}
+	}
 
-		// 메타데이터 읽기
-		float PlayLength;
-		int32 FrameRate;
-		int32 NumberOfFrames;
-		int32 NumberOfKeys;
-
-		Reader << PlayLength;
-		Reader << FrameRate;
-		Reader << NumberOfFrames;
-		Reader << NumberOfKeys;
-
-		DataModel->SetPlayLength(PlayLength);
-		DataModel->SetFrameRate(FrameRate);
-		DataModel->SetNumberOfFrames(NumberOfFrames);
-		DataModel->SetNumberOfKeys(NumberOfKeys);
-
-		// 호환성 검사를 위한 본 이름 읽기
-		uint32 NumBoneNames;
-		Reader << NumBoneNames;
-		TArray<FName> BoneNames;
-		for (uint32 i = 0; i < NumBoneNames; ++i)
-		{
-			FString BoneNameStr;
-			Serialization::ReadString(Reader, BoneNameStr);
-			BoneNames.Add(FName(BoneNameStr));
-		}
-		Animation->SetBoneNames(BoneNames);
-
-		// 본 트랙 읽기
-		uint32 NumTracks;
-		Reader << NumTracks;
+	// 새 애니메이션 시퀀스 생성
+	UAnimSequence* Animation = NewObject<UAnimSequence>();
 
-		for (uint32 i = 0; i < NumTracks; ++i)
-		{
-			// 본 이름 읽기
-			FString BoneNameStr;
-			Serialization::ReadString(Reader, BoneNameStr);
-			FName BoneName(BoneNameStr);
-
-			// 본 트랙 추가
-			DataModel->AddBoneTrack(BoneName);
-
-			// 위치 키 읽기
-			TArray<FVector> PosKeys;
-			Serialization::ReadArray(Reader, PosKeys);
-
-			// 회전 키 읽기
-			uint32 NumRotKeys;
-			Reader << NumRotKeys;
-			TArray<FQuat> RotKeys;
-			RotKeys.resize(NumRotKeys);
-			for (uint32 j = 0; j < NumRotKeys; ++j)
-			{
-				float X, Y, Z, W;
-				Reader << X << Y << Z << W;
-				RotKeys[j] = FQuat(X, Y, Z, W);
-			}
+	const FString AnimName = File.GetString(Meta.Name);
+	Animation->ObjectName = FName(AnimName);
 
-			// 스케일 키 읽기
-			TArray<FVector> ScaleKeys;
-			Serialization::ReadArray(Reader, ScaleKeys);
+	UAnimDataModel* DataModel = Animation->GetDataModel();
+	if (!DataModel)
+	{
+		return nullptr;
+	}
 
-			// 데이터 모델에 키 설정
-			DataModel->SetBoneTrackKeys(BoneName, PosKeys, RotKeys, ScaleKeys);
-		}
+	DataModel->SetPlayLength(Meta.PlayLength);
+	DataModel->SetFrameRate(Meta.FrameRate);
+	DataModel->SetNumberOfFrames(Meta.NumberOfFrames);
+	DataModel->SetNumberOfKeys(Meta.NumberOfKeys);
 
-		Reader.Close();
-		UE_LOG("Animation loaded from cache: %s (Name: %s)", CachePath.c_str(), AnimName.c_str());
-		return Animation;
+	TArray<FName> BoneNames;
+	BoneNames.reserve(BoneNameRefs.Num());
+	for (const FCookedStringRef& Ref : BoneNameRefs)
+	{
+		BoneNames.Add(FName(File.GetString(Ref)));
 	}
-	catch (const std::exception& e)
+	Animation->SetBoneNames(BoneNames);
+
+	for (const FCookedAnimTrack& Track : Tracks)
 	{
-		UE_LOG("Failed to load animation from cache: %s", e.what());
-		return nullptr;
+		FName BoneName(File.GetString(Track.Name));
+		DataModel->AddBoneTrack(BoneName);
+
+		// 맵핑된 키 구간을 그대로 복사 (키 단위 읽기 없음)
+		TArray<FVector> TrackPosKeys(PosKeys.begin() + Track.PosKeys.Offset, PosKeys.begin() + Track.PosKeys.Offset + Track.PosKeys.Count);
+		TArray<FQuat> TrackRotKeys(RotKeys.begin() + Track.RotKeys.Offset, RotKeys.begin() + Track.RotKeys.Offset + Track.RotKeys.Count);
+		TArray<FVector> TrackScaleKeys(ScaleKeys.begin() + Track.ScaleKeys.Offset, ScaleKeys.begin() + Track.ScaleKeys.Offset + Track.ScaleKeys.Count);
+
+		DataModel->SetBoneTrackKeys(BoneName, TrackPosKeys, TrackRotKeys, TrackScaleKeys);
 	}
+
+	UE_LOG("Animation loaded from cache: %s (Name: %s)", CachePath.c_str(), AnimName.c_str());
+	return Animation;
 }
@@ -6,6 +6,7 @@
 #include "Source/Runtime/Engine/Animation/AnimDateModel.h"
 #include "ObjectFactory.h"
 #include "PathUtils.h"
+#include "CookedAsset.h"
 #include <filesystem>
 
 // 헬퍼 함수: 직계 자식 중에 스켈레톤이 있는 첫 번째 비-스켈레톤 노드를 재귀적으로 찾음
@@ -212,7 +213,7 @@ void FBXAnimationLoader::ProcessAnimations(FbxScene* Scene, const FSkeletalMeshD
 					ch = '_';
 				}
 			}
-			FString AnimCachePath = AnimCacheDir + "/" + SanitizedName + ".anim.bin";
+			FString AnimCachePath = AnimCacheDir + "/" + SanitizedName + ".anim" + CookedAsset::Extension;
 
 			if (FBXAnimationCache::SaveAnimationToCache(OutAnimations[i], AnimCachePath))
 			{
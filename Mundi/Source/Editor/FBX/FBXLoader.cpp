@@ -6,6 +6,9 @@
 #include "ObjectIterator.h"
 #include "WindowsBinReader.h"
 #include "WindowsBinWriter.h"
+#include "CookedMeshData.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "PathUtils.h"
 #include <filesystem>
 #include "Source/Runtime/Engine/Animation/AnimSequence.h"
@@ -125,9 +128,9 @@ FSkeletalMeshData* UFbxLoader::LoadFbxMeshAsset(const FString& FilePath)
 	FSkeletalMeshData* MeshData = nullptr;
 #ifdef USE_OBJ_CACHE
 	
-	// 1. 캐시 파일 경로 설정
+	// 1. 캐시 파일 경로 설정 (메모리 맵핑되는 쿠킹 컨테이너)
 	FString CachePathStr = ConvertDataPathToCachePath(NormalizedPath);
-	const FString BinPathFileName = CachePathStr + ".bin";
+	const FString BinPathFileName = CachePathStr + CookedAsset::Extension;
 
 	// 파일 시스템용 wide path
 	FWideString WBinPath = UTF8ToWide(BinPathFileName);
@@ -174,13 +177,10 @@ FSkeletalMeshData* UFbxLoader::LoadFbxMeshAsset(const FString& FilePath)
 			MeshData = new FSkeletalMeshData();
 			MeshData->PathFileName = NormalizedPath;
 
-			FWindowsBinReader Reader(BinPathFileName);
-			if (!Reader.IsOpen())
+			if (!CookedMeshData::LoadSkeletalMesh(BinPathFileName, *MeshData))
 			{
-				throw std::runtime_error("Failed to open bin file for reading.");
+				throw std::runtime_error("Failed to load cooked mesh (missing, outdated or corrupt).");
 			}
-			Reader << *MeshData;
-			Reader.Close();
 
 			for (int Index = 0; Index < MeshData->GroupInfos.Num(); Index++)
 			{
@@ -380,13 +380,22 @@ FSkeletalMeshData* UFbxLoader::LoadFbxMeshAsset(const FString& FilePath)
 		Count += IndexList.Num();
 	}
 
+	// 정점 캐시/오버드로우/페치 순서 최적화 (결과가 그대로 쿠킹됨)
+	MeshOptimizer::OptimizeMesh(NormalizedPath, MeshData->Vertices, MeshData->Indices, MeshData->GroupInfos,
+		[](const FSkinnedVertex& Vertex) -> const FVector& { return Vertex.Position; });
+
+	// 자동 LOD 생성 (본 가중치가 다른 영역끼리는 늦게 합쳐짐)
+	MeshSimplifier::BuildLODs(NormalizedPath, MeshData->Vertices, MeshData->Indices, MeshData->GroupInfos,
+		[](const FSkinnedVertex& Vertex) -> const FVector& { return Vertex.Position; }, MeshData->LODs);
+
 #ifdef USE_OBJ_CACHE
 	// 5. 캐시 저장
 	try
 	{
-		FWindowsBinWriter Writer(BinPathFileName);
-		Writer << *MeshData;
-		Writer.Close();
+		if (!CookedMeshData::SaveSkeletalMesh(*MeshData, BinPathFileName))
+		{
+			throw std::runtime_error("Failed to write cooked mesh.");
+		}
 
 		for (FMaterialInfo& MaterialInfo : MaterialInfos)
 		{
@@ -7,6 +7,13 @@
 #include "Enums.h"
 #include "WindowsBinReader.h"
 #include "WindowsBinWriter.h"
+#include "CookedMeshData.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MeshBVH.h"
+#include "PlatformTime.h"
+#include "ObjParser.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
 #include <filesystem>
 #include <unordered_set>
 
@@ -89,6 +96,17 @@ namespace
 		// 옵션 플래그를 찾지 못한 경우
 		return InDefaultValue;
 	}
+
+	/** 피킹용 BVH 빌드 (쿠킹 캐시에 함께 저장되어 다음 실행부터는 로드만 함) */
+	void BuildMeshBVH(const FString& AssetPath, FStaticMesh& Mesh)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Mesh.MeshBVH = std::make_shared<FMeshBVH>();
+		Mesh.MeshBVH->Build(Mesh.Vertices, Mesh.Indices);
+		UE_LOG("[MeshBVH] '%s': %u triangles -> %u nodes (depth %u) in %.2f ms",
+			AssetPath.c_str(), static_cast<uint32>(Mesh.Indices.size() / 3), Mesh.MeshBVH->GetNumNodes(), Mesh.MeshBVH->GetMaxDepth(),
+			FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+	}
 }
 
 /**
@@ -166,7 +184,7 @@ bool GetMtlDependencies(const FString& ObjPath, TArray<FWideString>& OutMtlFileP
 /**
  * @brief 캐시 파일이 원본(.obj) 및 모든 의존성(.mtl) 파일보다 최신인지 검사합니다.
  * @param ObjPath 원본 .obj 파일의 경로입니다.
- * @param BinPath 메쉬 데이터 캐시(.obj.bin) 파일의 경로입니다.
+ * @param BinPath 메쉬 데이터 캐시(.obj.cooked) 파일의 경로입니다.
  * @param MatBinPath 머티리얼 데이터 캐시(.mtl.bin) 파일의 경로입니다.
  * @return 캐시를 다시 생성해야 하면 true, 캐시가 유효하면 false를 반환합니다.
  */
@@ -228,6 +246,7 @@ void FObjManager::Preload()
 
 	size_t LoadedCount = 0;
 	std::unordered_set<FString> ProcessedFiles; // 중복 로딩 방지
+	const uint64 StartCycles = FPlatformTime::Cycles64();
 
 	for (const auto& Entry : fs::recursive_directory_iterator(DataDir))
 	{
@@ -246,20 +265,34 @@ void FObjManager::Preload()
 			if (ProcessedFiles.find(PathStr) == ProcessedFiles.end())
 			{
 				ProcessedFiles.insert(PathStr);
-				LoadObjStaticMesh(PathStr);
+				if (Extension == ".obj")
+				{
+					// 캐시 로드/파싱은 워커에서 병렬로, GPU 버퍼 생성은 아래 Flush에서 게임 스레드가 처리
+					RESOURCE.LoadAsync<UStaticMesh>(PathStr);
+				}
+				else
+				{
+					// FBX SDK는 스레드 안전하지 않으므로 기존처럼 동기 로드
+					LoadObjStaticMesh(PathStr);
+				}
 				++LoadedCount;
 			}
 		}
 		else if (Extension == ".dds" || Extension == ".jpg" || Extension == ".png")
 		{
-			UResourceManager::GetInstance().Load<UTexture>(Path.string()); // 데칼 텍스쳐를 ui에서 고를 수 있게 하기 위해 임시로 만듬.
+			// 데칼 텍스쳐를 ui에서 고를 수 있게 하기 위해 임시로 만듬. (메시 머티리얼보다 나중에 처리되도록 Low)
+			RESOURCE.LoadAsync<UTexture>(Path.string(), EAsyncLoadPriority::Low);
 		}
 	}
 
+	// 프리로드는 시작 시 모두 끝나 있어야 함
+	RESOURCE.FlushAsyncLoads();
+
 	// 4) 모든 StaticMeshs 가져오기
 	RESOURCE.SetStaticMeshs();
 
-	UE_LOG("FObjManager::Preload: Loaded %zu .obj files from %s", LoadedCount, DataDir.string().c_str());
+	UE_LOG("FObjManager::Preload: Loaded %zu .obj files from %s (%.1f ms)", LoadedCount, DataDir.string().c_str(),
+		FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
 }
 
 void FObjManager::Clear()
@@ -283,6 +316,20 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 		return *It;
 	}
 
+	FStaticMesh* NewFStaticMesh = new FStaticMesh();
+	TArray<FMaterialInfo> MaterialInfos;
+	if (!LoadObjStaticMeshData(NormalizedPathStr, *NewFStaticMesh, MaterialInfos))
+	{
+		delete NewFStaticMesh;
+		return nullptr;
+	}
+
+	return RegisterObjStaticMeshAsset(NormalizedPathStr, NewFStaticMesh, MaterialInfos);
+}
+
+// 2~4단계: 캐시 로드(또는 재생성) + 텍스처 경로 해석. 엔진 전역 상태를 건드리지 않으므로 워커 스레드에서 호출 가능
+bool FObjManager::LoadObjStaticMeshData(const FString& NormalizedPathStr, FStaticMesh& OutMesh, TArray<FMaterialInfo>& OutMaterialInfos)
+{
 	std::filesystem::path Path(NormalizedPathStr);
 
 	// 2. 파일 경로 설정
@@ -293,28 +340,29 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 	if (Extension != ".obj")
 	{
 		UE_LOG("this file is not obj!: %s", NormalizedPathStr.c_str());
-		return nullptr;
+		return false;
 	}
 
+	FStaticMesh* NewFStaticMesh = &OutMesh;
+	TArray<FMaterialInfo>& MaterialInfos = OutMaterialInfos;
+	bool bLoadedSuccessfully = false;
+
 #ifdef USE_OBJ_CACHE
 	// 2-1. 캐시 파일 경로 설정
 	FString CachePathStr = ConvertDataPathToCachePath(NormalizedPathStr);
 
-	const FString BinPathFileName = CachePathStr + ".bin";
+	const FString BinPathFileName = CachePathStr + CookedAsset::Extension;  // 메모리 맵핑되는 쿠킹 컨테이너
 	const FString MatBinPathFileName = CachePathStr + ".mat.bin";
 
-	// 캐시를 저장할 디렉토리가 없으면 생성
+	// 캐시를 저장할 디렉토리가 없으면 생성 (여러 워커가 같은 디렉토리를 동시에 만들 수 있으므로 error_code 버전 사용)
 	fs::path CacheFileDirPath(BinPathFileName);
 	if (CacheFileDirPath.has_parent_path())
 	{
-		fs::create_directories(CacheFileDirPath.parent_path());
+		std::error_code Ec;
+		fs::create_directories(CacheFileDirPath.parent_path(), Ec);
 	}
 
 	// 3. 캐시 데이터 로드 시도 및 실패 시 재생성 로직
-	FStaticMesh* NewFStaticMesh = new FStaticMesh();
-	TArray<FMaterialInfo> MaterialInfos;
-	bool bLoadedSuccessfully = false;
-
 	// 캐시가 오래되었는지 먼저 확인
 	bool bShouldRegenerate = ShouldRegenerateCache(NormalizedPathStr, BinPathFileName, MatBinPathFileName);
 
@@ -323,15 +371,11 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 		UE_LOG("Attempting to load '%s' from cache.", NormalizedPathStr.c_str());
 		try
 		{
-			// 캐시에서 FStaticMesh 데이터 로드
-			FWindowsBinReader Reader(BinPathFileName);
-			if (!Reader.IsOpen())
+			// 캐시에서 FStaticMesh 데이터 로드 (섹션 단위 일괄 복사, 필드 파싱 없음)
+			if (!CookedMeshData::LoadStaticMesh(BinPathFileName, *NewFStaticMesh))
 			{
-				// Reader 생성자에서 예외를 던지지 않는 경우를 대비한 명시적 실패 처리
-				throw std::runtime_error("Failed to open bin file for reading.");
+				throw std::runtime_error("Failed to load cooked mesh (missing, outdated or corrupt).");
 			}
-			Reader << *NewFStaticMesh;
-			Reader.Close();
 
 			// 캐시에서 Material 데이터 로드
 			FWindowsBinReader MatReader(MatBinPathFileName);
@@ -353,24 +397,22 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 			UE_LOG("Error loading from cache: %s. Cache might be corrupt or incompatible.", e.what());
 			UE_LOG("Deleting corrupt cache and forcing regeneration for '%s'.", NormalizedPathStr.c_str());
 
-			// 실패 시 생성 중이던 객체 메모리 정리
-			delete NewFStaticMesh;
-			NewFStaticMesh = nullptr; // 포인터를 nullptr로 설정하여 이중 삭제 방지
+			// 실패 시 읽다 만 데이터 정리
+			*NewFStaticMesh = FStaticMesh();
+			MaterialInfos.Empty();
 
 			// 손상된 캐시 파일 삭제
-			fs::remove(BinPathFileName);
-			fs::remove(MatBinPathFileName);
+			std::error_code Ec;
+			fs::remove(BinPathFileName, Ec);
+			fs::remove(MatBinPathFileName, Ec);
 
 			bLoadedSuccessfully = false;
 		}
 	}
-#else
-	FStaticMesh* NewFStaticMesh = new FStaticMesh();
-	TArray<FMaterialInfo> MaterialInfos;
-	bool bLoadedSuccessfully = false;
 #endif // USE_OBJ_CACHE
 
 	// 기본 머티리얼 주입 로직을 헬퍼 람다로 분리합니다.
+	// (기본 머티리얼은 ResourceManager 초기화 때 만들어져 이후 읽기만 하므로 워커에서 접근해도 안전)
 	auto EnsureDefaultMaterial = [&](FStaticMesh* Mesh, TArray<FMaterialInfo>& Materials)
 		{
 			if (Mesh->GroupInfos.size() > 0 && Materials.empty())
@@ -398,26 +440,32 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 	// 캐시 로드에 실패했거나, 처음부터 재생성이 필요했던 경우
 	if (!bLoadedSuccessfully)
 	{
-		if (NewFStaticMesh == nullptr) { NewFStaticMesh = new FStaticMesh(); }
 		UE_LOG("Regenerating cache for '%s'...", NormalizedPathStr.c_str());
 
 		FObjInfo RawObjInfo;
 		if (!FObjImporter::LoadObjModel(NormalizedPathStr, &RawObjInfo, MaterialInfos, true))
 		{
-			delete NewFStaticMesh;
-			return nullptr;
+			return false;
 		}
 
 		FObjImporter::ConvertToStaticMesh(RawObjInfo, MaterialInfos, NewFStaticMesh);
 
+		// 정점 캐시/오버드로우/페치 순서 최적화 (결과가 그대로 쿠킹됨)
+		MeshOptimizer::OptimizeMesh(NormalizedPathStr, NewFStaticMesh->Vertices, NewFStaticMesh->Indices, NewFStaticMesh->GroupInfos,
+			[](const FNormalVertex& Vertex) -> const FVector& { return Vertex.pos; });
+
+		// 자동 LOD 생성 (최적화된 정점 순서를 그대로 공유)
+		MeshSimplifier::BuildLODs(NormalizedPathStr, NewFStaticMesh->Vertices, NewFStaticMesh->Indices, NewFStaticMesh->GroupInfos,
+			[](const FNormalVertex& Vertex) -> const FVector& { return Vertex.pos; }, NewFStaticMesh->LODs);
+
+		BuildMeshBVH(NormalizedPathStr, *NewFStaticMesh);
+
 		// 캐시 저장 *직전에* 기본 머티리얼 로직을 호출합니다.
 		EnsureDefaultMaterial(NewFStaticMesh, MaterialInfos);
 
 #ifdef USE_OBJ_CACHE
-		// 새로운 캐시 파일(.bin) 저장 (이제 올바른 데이터가 저장됨)
-		FWindowsBinWriter Writer(BinPathFileName);
-		Writer << *NewFStaticMesh;
-		Writer.Close();
+		// 새로운 캐시 파일(.cooked) 저장 (이제 올바른 데이터가 저장됨)
+		CookedMeshData::SaveStaticMesh(*NewFStaticMesh, BinPathFileName);
 
 		FWindowsBinWriter MatWriter(MatBinPathFileName);
 		Serialization::WriteArray<FMaterialInfo>(MatWriter, MaterialInfos);
@@ -430,23 +478,31 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 	{
 		// 캐시 로드에 성공한 경우(bLoadedSuccessfully == true)
 		// 구버전 캐시(기본 머티리얼이 없는)일 수 있으므로, 동일한 검사를 수행합니다.
-		if (EnsureDefaultMaterial(NewFStaticMesh, MaterialInfos))
+		const bool bMaterialUpdated = EnsureDefaultMaterial(NewFStaticMesh, MaterialInfos);
+
+		// BVH가 없거나 빌더 버전이 다른 캐시는 BVH만 다시 빌드해서 함께 갱신합니다.
+		const bool bBVHUpdated = !NewFStaticMesh->MeshBVH;
+		if (bBVHUpdated)
+		{
+			BuildMeshBVH(NormalizedPathStr, *NewFStaticMesh);
+		}
+
+		if (bMaterialUpdated || bBVHUpdated)
 		{
 #ifdef USE_OBJ_CACHE
 			// 변경된 경우, 캐시를 갱신합니다.
-			UE_LOG("Updating outdated cache for '%s' with default material.", NormalizedPathStr.c_str());
+			UE_LOG("Updating outdated cache for '%s' (%s).", NormalizedPathStr.c_str(),
+				bMaterialUpdated && bBVHUpdated ? "default material, mesh BVH" : (bMaterialUpdated ? "default material" : "mesh BVH"));
 			try
 			{
-				FWindowsBinWriter Writer(BinPathFileName);
-				Writer << *NewFStaticMesh;
-				Writer.Close();
+				CookedMeshData::SaveStaticMesh(*NewFStaticMesh, BinPathFileName);
 				FWindowsBinWriter MatWriter(MatBinPathFileName);
 				Serialization::WriteArray<FMaterialInfo>(MatWriter, MaterialInfos);
 				MatWriter.Close();
 			}
 			catch (const std::exception& e)
 			{
-				UE_LOG("Failed to update cache for default material: %s", e.what());
+				UE_LOG("Failed to update outdated cache: %s", e.what());
 			}
 #endif // USE_OBJ_CACHE
 		}
@@ -485,6 +541,22 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 			ResolveAssetRelativePath(MaterialInfo.EmissiveTextureFileName, ObjBaseDir);
 	}
 
+	return true;
+}
+
+// 5단계: 머티리얼 생성/등록 후 메모리 캐시에 추가 (UObject 생성이 있으므로 게임 스레드 전용)
+FStaticMesh* FObjManager::RegisterObjStaticMeshAsset(const FString& NormalizedPathStr, FStaticMesh* InStaticMesh, const TArray<FMaterialInfo>& InMaterialInfos)
+{
+	// 비동기 로드가 끝나기 전에 동기 로드로 먼저 등록된 경우: 기존 것을 유지
+	if (FStaticMesh** Existing = ObjStaticMeshMap.Find(NormalizedPathStr))
+	{
+		if (*Existing != InStaticMesh)
+		{
+			delete InStaticMesh;
+		}
+		return *Existing;
+	}
+
 	// 루프가 시작되기 전에 기본 UberLit 셰이더 포인터를 한 번만 가져옵니다.
 	UShader* DefaultUberlitShader = nullptr;
 	UMaterial* DefaultMaterial = UResourceManager::GetInstance().GetDefaultMaterial();
@@ -498,7 +570,7 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 		UE_LOG("CRITICAL: Default Uberlit Shader not found. OBJ materials may fail.");
 	}
 
-	for (const FMaterialInfo& InMaterialInfo : MaterialInfos)
+	for (const FMaterialInfo& InMaterialInfo : InMaterialInfos)
 	{
 		if (!UResourceManager::GetInstance().Get<UMaterial>(InMaterialInfo.MaterialName))
 		{
@@ -516,9 +588,9 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
 		}
 	}
 
-	// 5. 메모리 캐시에 등록하고 반환
-	ObjStaticMeshMap.Add(NormalizedPathStr, NewFStaticMesh);
-	return NewFStaticMesh;
+	// 메모리 캐시에 등록하고 반환
+	ObjStaticMeshMap.Add(NormalizedPathStr, InStaticMesh);
+	return InStaticMesh;
 }
 
 void FObjManager::RegisterStaticMeshAsset(const FString& PathFileName, FStaticMesh* InStaticMesh)
@@ -566,26 +638,13 @@ UStaticMesh* FObjManager::LoadObjStaticMesh(const FString& PathFileName)
 // obj File to FObjInfo, FMaterialParameters
 bool FObjImporter::LoadObjModel(const FString& InFileName, FObjInfo* const OutObjInfo, TArray<FMaterialInfo>& OutMaterialInfos, bool bIsRightHanded)
 {
-	uint32 subsetCount = 0;
-	FString MtlFileName;
-
-	bool bHasTexcoord = false;
-	bool bHasNormal = false;
-	FString MaterialNameTemp;
-
-	FString Face;
-	uint32 VIndex = 0;
-	uint32 MeshTriangles = 0;
-
 	size_t pos = InFileName.find_last_of("/\\");
 	FString objDir = (pos == FString::npos) ? "" : InFileName.substr(0, pos + 1);
 
 	// [안정성] .obj 파일이 존재하지 않으면 로드 실패를 반환합니다.
 	// 이는 필수 데이터이므로 더 이상 진행할 수 없습니다.
-	// 한글 경로 지원: UTF-8 → UTF-16 변환 후 파일 열기
-	FWideString WPath = UTF8ToWide(InFileName);
-	std::ifstream FileIn(WPath);
-	if (!FileIn)
+	ObjParser::FMappedFile ObjFile;
+	if (!ObjFile.Open(InFileName))
 	{
 		UE_LOG("Error: The file '%s' does not exist!", InFileName.c_str());
 		return false;
@@ -593,159 +652,15 @@ bool FObjImporter::LoadObjModel(const FString& InFileName, FObjInfo* const OutOb
 
 	OutObjInfo->ObjFileName = FString(InFileName.begin(), InFileName.end());
 
-	FString line;
-	while (std::getline(FileIn, line))
-	{
-		if (line.empty()) continue;
-
-		line.erase(0, line.find_first_not_of(" \t\n\r"));
-
-		if (line[0] == '#')
-			continue;
-
-		if (line.rfind("v ", 0) == 0) // 정점 좌표 (v x y z)
-		{
-			std::stringstream wss(line.substr(2));
-			float vx, vy, vz;
-			wss >> vx >> vy >> vz;
-			if (bIsRightHanded)
-			{
-				OutObjInfo->Positions.push_back(FVector(vx, -vy, vz));
-			}
-			else
-			{
-				OutObjInfo->Positions.push_back(FVector(vx, vy, vz));
-			}
-		}
-		else if (line.rfind("vt ", 0) == 0) // 텍스처 좌표 (vt u v)
-		{
-			std::stringstream wss(line.substr(3));
-			float u, v;
-			wss >> u >> v;
-			// obj의 vt는 좌하단이 (0,0) -> DirectX UV는 좌상단이 (0,0) (상하 반전으로 컨버팅)
-			v = 1.0f - v;
-			OutObjInfo->TexCoords.push_back(FVector2D(u, v));
-			bHasTexcoord = true;
-		}
-		else if (line.rfind("vn ", 0) == 0) // 법선 (vn x y z)
-		{
-			std::stringstream wss(line.substr(3));
-			float nx, ny, nz;
-			wss >> nx >> ny >> nz;
-			if (bIsRightHanded)
-			{
-				OutObjInfo->Normals.push_back(FVector(nx, -ny, nz));
-			}
-			else
-			{
-				OutObjInfo->Normals.push_back(FVector(nx, ny, nz));
-			}
-			bHasNormal = true;
-		}
-		else if (line.rfind("g ", 0) == 0) // 그룹 (g groupName)
-		{
-			// 현재 'usemtl'을 기준으로 그룹을 나누므로 'g' 태그는 무시합니다.
-		}
-		else if (line.rfind("f ", 0) == 0) // 면 (f v1/vt1/vn1 v2/vt2/vn2 ...)
-		{
-			Face = line.substr(2);
-			if (Face.length() <= 0)
-			{
-				continue;
-			}
-
-			// Parse face line and trim at '#' or newline
-			std::stringstream wss(Face);
-			FString VertexDef;
-
-			TArray<FFaceVertex> LineFaceVertices;
-			while (wss >> VertexDef)
-			{
-				// '#'을 만나면 주석 처리 (이후 데이터 무시)
-				if (VertexDef[0] == '#')
-				{
-					break;
-				}
-
-				FFaceVertex FaceVertex = ParseVertexDef(VertexDef);
-				LineFaceVertices.push_back(FaceVertex);
-			}
-
-			// 4각형 이상의 폴리곤도 처리하기 위해서 for문으로 처리
-			for (uint32 i = 1; i < LineFaceVertices.size() - 1; ++i)
-			{
-				if (bIsRightHanded)
-				{
-					OutObjInfo->PositionIndices.push_back(LineFaceVertices[0].PositionIndex);
-					OutObjInfo->TexCoordIndices.push_back(LineFaceVertices[0].TexCoordIndex);
-					OutObjInfo->NormalIndices.push_back(LineFaceVertices[0].NormalIndex);
-
-					OutObjInfo->PositionIndices.push_back(LineFaceVertices[i + 1].PositionIndex);
-					OutObjInfo->TexCoordIndices.push_back(LineFaceVertices[i + 1].TexCoordIndex);
-					OutObjInfo->NormalIndices.push_back(LineFaceVertices[i + 1].NormalIndex);
-
-					OutObjInfo->PositionIndices.push_back(LineFaceVertices[i].PositionIndex);
-					OutObjInfo->TexCoordIndices.push_back(LineFaceVertices[i].TexCoordIndex);
-					OutObjInfo->NormalIndices.push_back(LineFaceVertices[i].NormalIndex);
-				}
-				else
-				{
-					OutObjInfo->PositionIndices.push_back(LineFaceVertices[0].PositionIndex);
-					OutObjInfo->TexCoordIndices.push_back(LineFaceVertices[0].TexCoordIndex);
-					OutObjInfo->NormalIndices.push_back(LineFaceVertices[0].NormalIndex);
-
-					OutObjInfo->PositionIndices.push_back(LineFaceVertices[i].PositionIndex);
-					OutObjInfo->TexCoordIndices.push_back(LineFaceVertices[i].TexCoordIndex);
-					OutObjInfo->NormalIndices.push_back(LineFaceVertices[i].NormalIndex);
-
-					OutObjInfo->PositionIndices.push_back(LineFaceVertices[i + 1].PositionIndex);
-					OutObjInfo->TexCoordIndices.push_back(LineFaceVertices[i + 1].TexCoordIndex);
-					OutObjInfo->NormalIndices.push_back(LineFaceVertices[i + 1].NormalIndex);
-				}
-				VIndex += 3;
-				++MeshTriangles;
-			}
-		}
-		else if (line.rfind("mtllib ", 0) == 0)
-		{
-			MtlFileName = objDir + line.substr(7);
-		}
-		else if (line.rfind("usemtl ", 0) == 0)
-		{
-			MaterialNameTemp = line.substr(7);
-			OutObjInfo->MaterialNames.push_back(MaterialNameTemp);
-			OutObjInfo->GroupIndexStartArray.push_back(VIndex);
-			subsetCount++;
-		}
-		else
-		{
-			UE_LOG("While parsing the filename %s, the following unknown symbol was encountered: \'%s\'", InFileName.c_str(), line.c_str());
-		}
-	}
-
-	if (subsetCount == 0)
-	{
-		OutObjInfo->GroupIndexStartArray.push_back(0);
-		subsetCount++;
-	}
-	OutObjInfo->GroupIndexStartArray.push_back(VIndex);
-
-	if (OutObjInfo->GroupIndexStartArray.size() > 1 && OutObjInfo->GroupIndexStartArray[1] == 0)
-	{
-		OutObjInfo->GroupIndexStartArray.erase(OutObjInfo->GroupIndexStartArray.begin() + 1);
-		subsetCount--;
-	}
-
-	if (!bHasNormal)
-	{
-		OutObjInfo->Normals.push_back(FVector(0.0f, 0.0f, 0.0f));
-	}
-	if (!bHasTexcoord)
-	{
-		OutObjInfo->TexCoords.push_back(FVector2D(0.0f, 0.0f));
-	}
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	FString MtlFileName;
+	ObjParser::ParseObj(ObjFile.GetData(), ObjFile.GetSize(), objDir, bIsRightHanded, *OutObjInfo, MtlFileName);
+	const uint64 ObjFileSize = ObjFile.GetSize();
+	ObjFile.Close();
 
-	FileIn.close();
+	UE_LOG("[ObjImporter::LoadObjModel] Parsed %s (%.1f MB, %zu vertices, %zu triangles) in %.1f ms", InFileName.c_str(),
+		static_cast<double>(ObjFileSize) / (1024.0 * 1024.0), OutObjInfo->Positions.size(), OutObjInfo->PositionIndices.size() / 3,
+		FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
 
 	// Material 파싱 시작
 	UE_LOG("[ObjImporter::LoadObjModel] MTL file path: %s", MtlFileName.c_str());
@@ -759,7 +674,7 @@ bool FObjImporter::LoadObjModel(const FString& InFileName, FObjInfo* const OutOb
 
 	// 한글 경로 지원: UTF-8 → UTF-16 변환 후 파일 열기
 	FWideString WMtlPath = UTF8ToWide(MtlFileName);
-	FileIn.open(WMtlPath);
+	std::ifstream FileIn(WMtlPath);
 
 	// .mtl 파일이 존재하지 않더라도 로딩을 중단하지 않습니다.
 	// 경고를 로깅하고, 머티리얼이 없는 모델로 처리를 계속합니다.
@@ -777,6 +692,7 @@ bool FObjImporter::LoadObjModel(const FString& InFileName, FObjInfo* const OutOb
 	TArray<FString> TempOptions;
 	FString TempTexturePath;
 
+	FString line;
 	while (std::getline(FileIn, line))
 	{
 		if (line.empty()) continue;
@@ -880,8 +796,11 @@ void FObjImporter::ConvertToStaticMesh(const FObjInfo& InObjInfo, const TArray<F
 	TangentForVertex.SetNum(NumDuplicatedVertex, FVector(0.f, 0.f, 0.f));
 	BiTangentForVertex.SetNum(NumDuplicatedVertex, FVector(0.f, 0.f, 0.f));
 
-	for (uint32 Index = 0; Index < NumDuplicatedVertex; Index += 3)
+	// 삼각형마다 자기 코너 3개에만 기록하므로 병렬 처리 가능
+	ParallelFor(static_cast<int32>(NumDuplicatedVertex / 3), [&](int32 Triangle)
 	{
+		const uint32 Index = static_cast<uint32>(Triangle) * 3;
+
 		FVector P0 = InObjInfo.Positions[InObjInfo.PositionIndices[Index]];
 		FVector P1 = InObjInfo.Positions[InObjInfo.PositionIndices[Index + 1]];
 		FVector P2 = InObjInfo.Positions[InObjInfo.PositionIndices[Index + 2]];
@@ -910,42 +829,35 @@ void FObjImporter::ConvertToStaticMesh(const FObjInfo& InObjInfo, const TArray<F
 		BiTangentForVertex[Index] += BiTangent;
 		BiTangentForVertex[Index + 1] += BiTangent;
 		BiTangentForVertex[Index + 2] += BiTangent;
-	}
+	}, 4096);
 
-	std::unordered_map<VertexKey, uint32, VertexKeyHash> VertexMap;
+	// (위치, UV, 노멀) 인덱스가 같은 코너를 하나의 정점으로 병합. 정점 순서는 처음 등장한 코너 순서
+	TArray<uint32> VertexToCorner;
+	ObjParser::WeldCorners(InObjInfo.PositionIndices.data(), InObjInfo.TexCoordIndices.data(), InObjInfo.NormalIndices.data(),
+		NumDuplicatedVertex, OutStaticMesh->Indices, VertexToCorner);
 
-	for (uint32 CurIndex = 0; CurIndex < NumDuplicatedVertex; ++CurIndex)
+	OutStaticMesh->Vertices.resize(VertexToCorner.size());
+	ParallelFor(static_cast<int32>(VertexToCorner.size()), [&](int32 VertexIndex)
 	{
-		VertexKey Key{ InObjInfo.PositionIndices[CurIndex], InObjInfo.TexCoordIndices[CurIndex], InObjInfo.NormalIndices[CurIndex] };
-		auto It = VertexMap.find(Key);
-		if (It != VertexMap.end())
-		{
-			OutStaticMesh->Indices.push_back(It->second);
-		}
-		else
-		{
-			FVector Tangent = TangentForVertex[CurIndex];
-			FVector Normal = InObjInfo.Normals[Key.NormalIndex];
-			FVector BiTangent = BiTangentForVertex[CurIndex];
-
-			Tangent = Tangent - Normal * FVector::Dot(Tangent, Normal);
-			Tangent.Normalize();
-			FVector4 FinalTangent(Tangent.X, Tangent.Y, Tangent.Z);
-			FinalTangent.W = FVector::Dot(FVector::Cross(Tangent, Normal), BiTangent) > 0.0f ? 1.0f : -1.0f;
-
-			FNormalVertex NormalVertex(
-				InObjInfo.Positions[Key.PosIndex],
-				Normal,
-				InObjInfo.TexCoords[Key.TexIndex],
-				FinalTangent,
-				FVector4(1, 1, 1, 1)
-			);
-			OutStaticMesh->Vertices.push_back(NormalVertex);
-			uint32 NewIndex = static_cast<uint32>(OutStaticMesh->Vertices.size() - 1);
-			OutStaticMesh->Indices.push_back(NewIndex);
-			VertexMap[Key] = NewIndex;
-		}
-	}
+		const uint32 CurIndex = VertexToCorner[VertexIndex];
+
+		FVector Tangent = TangentForVertex[CurIndex];
+		FVector Normal = InObjInfo.Normals[InObjInfo.NormalIndices[CurIndex]];
+		FVector BiTangent = BiTangentForVertex[CurIndex];
+
+		Tangent = Tangent - Normal * FVector::Dot(Tangent, Normal);
+		Tangent.Normalize();
+		FVector4 FinalTangent(Tangent.X, Tangent.Y, Tangent.Z);
+		FinalTangent.W = FVector::Dot(FVector::Cross(Tangent, Normal), BiTangent) > 0.0f ? 1.0f : -1.0f;
+
+		OutStaticMesh->Vertices[VertexIndex] = FNormalVertex(
+			InObjInfo.Positions[InObjInfo.PositionIndices[CurIndex]],
+			Normal,
+			InObjInfo.TexCoords[InObjInfo.TexCoordIndices[CurIndex]],
+			FinalTangent,
+			FVector4(1, 1, 1, 1)
+		);
+	}, 4096);
 
 	// bHasMtl 체크를 제거하거나 bHasMaterial = true로 설정 (이후 로더에서 기본값을 주입할 것이므로)
 	OutStaticMesh->bHasMaterial = true;
@@ -980,17 +892,3 @@ void FObjImporter::ConvertToStaticMesh(const FObjInfo& InObjInfo, const TArray<F
 		// else: InitialMaterialName은 비어있게 됨 (정상)
 	}
 }
-
-FObjImporter::FFaceVertex FObjImporter::ParseVertexDef(const FString& InVertexDef)
-{
-	FFaceVertex Result{ 0, 0, 0 };
-	std::stringstream ss(InVertexDef);
-	FString part;
-	uint32 temp_val;
-
-	if (std::getline(ss, part, '/')) { if (!part.empty()) { std::stringstream conv(part); if (conv >> temp_val) Result.PositionIndex = temp_val - 1; } }
-	if (std::getline(ss, part, '/')) { if (!part.empty()) { std::stringstream conv(part); if (conv >> temp_val) Result.TexCoordIndex = temp_val - 1; } }
-	if (std::getline(ss, part, '/')) { if (!part.empty()) { std::stringstream conv(part); if (conv >> temp_val) Result.NormalIndex = temp_val - 1; } }
-
-	return Result;
-}
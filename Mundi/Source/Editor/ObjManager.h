@@ -34,25 +34,11 @@ struct FObjInfo
 struct FObjImporter
 {
 public:
-	struct VertexKey
-	{
-		uint32 PosIndex, TexIndex, NormalIndex;
-		bool operator==(const VertexKey& Other) const { return PosIndex == Other.PosIndex && TexIndex == Other.TexIndex && NormalIndex == Other.NormalIndex; }
-	};
-
-	struct VertexKeyHash
-	{
-		size_t operator()(const VertexKey& Key) const { return std::hash<uint32>()(Key.PosIndex) ^ (std::hash<uint32>()(Key.TexIndex) << 1) ^ (std::hash<uint32>()(Key.NormalIndex) << 2); }
-	};
-
+	// .obj 지오메트리는 ObjParser(메모리 맵 + 청크 병렬 파싱), .mtl은 기존 줄 단위 파서
 	static bool LoadObjModel(const FString& InFileName, FObjInfo* const OutObjInfo, TArray<FMaterialInfo>& OutMaterialInfos, bool bIsRightHanded = true);
 
+	// 탄젠트 계산/정점 병합은 ParallelFor + ObjParser::WeldCorners로 병렬 처리
 	static void ConvertToStaticMesh(const FObjInfo& InObjInfo, const TArray<FMaterialInfo>& InMaterialInfos, FStaticMesh* const OutStaticMesh);
-
-private:
-	struct FFaceVertex { uint32 PositionIndex, TexCoordIndex, NormalIndex; };
-
-	static FFaceVertex ParseVertexDef(const FString& InVertexDef);
 };
 
 class UStaticMesh;
@@ -65,6 +51,12 @@ public:
 	static void Preload();
 	static void Clear();
 	static FStaticMesh* LoadObjStaticMeshAsset(const FString& PathFileName);
+
+	// LoadObjStaticMeshAsset를 비동기 로드용으로 나눈 두 단계
+	// - LoadObjStaticMeshData: 캐시 로드/재생성 + 텍스처 경로 해석 (워커 스레드에서 호출 가능)
+	// - RegisterObjStaticMeshAsset: 머티리얼 생성 + 메모리 캐시 등록 (게임 스레드 전용, 이미 등록된 경로면 InStaticMesh를 삭제하고 기존 것을 반환)
+	static bool LoadObjStaticMeshData(const FString& NormalizedPath, FStaticMesh& OutMesh, TArray<FMaterialInfo>& OutMaterialInfos);
+	static FStaticMesh* RegisterObjStaticMeshAsset(const FString& NormalizedPath, FStaticMesh* InStaticMesh, const TArray<FMaterialInfo>& InMaterialInfos);
 	static UStaticMesh* LoadObjStaticMesh(const FString& PathFileName);
 
 	// FBX 등 외부에서 생성된 FStaticMesh를 캐시에 등록
@@ -0,0 +1,586 @@
+﻿#include "pch.h"
+#include "ObjParser.h"
+#include "ObjManager.h"
+#include "InlineArray.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+
+namespace
+{
+    // 이보다 작은 파일/메시는 청크로 나누지 않음 (작업 분배 비용이 더 큼)
+    constexpr uint64 MinChunkBytes = 4ull * 1024 * 1024;
+    constexpr uint32 MinParallelWeldCorners = 1u << 16;
+    constexpr uint32 WeldBucketBits = 8;
+    constexpr uint32 InvalidCorner = 0xFFFFFFFFu;
+
+    struct FFaceCorner
+    {
+        int32 Position = 0;
+        int32 TexCoord = 0;
+        int32 Normal = 0;
+    };
+
+    /** 청크 하나의 파싱 결과. 인덱스는 0-based, 음수 인덱스는 청크 로컬 기준으로 저장 후 병합 때 보정 */
+    struct FObjChunk
+    {
+        TArray<FVector> Positions;
+        TArray<FVector2D> TexCoords;
+        TArray<FVector> Normals;
+
+        TArray<uint32> PositionIndices;
+        TArray<uint32> TexCoordIndices;
+        TArray<uint32> NormalIndices;
+
+        // 상대 인덱스가 들어간 코너 슬롯 (앞 청크들의 정점 수를 더해야 함)
+        TArray<uint32> RelativePositionSlots;
+        TArray<uint32> RelativeTexCoordSlots;
+        TArray<uint32> RelativeNormalSlots;
+
+        // usemtl (청크 내 코너 오프셋, 머티리얼 이름)
+        TArray<std::pair<uint32, FString>> MaterialMarks;
+
+        FString MtlPath;
+        int32 NumUnknownLines = 0;
+        FString FirstUnknownLine;
+    };
+
+    /** 줄 시작이 Keyword + 공백인지 확인하고, 맞으면 키워드 뒤 위치를 반환 */
+    const char* MatchKeyword(const char* P, const char* End, const char* Keyword, size_t Length)
+    {
+        if (static_cast<size_t>(End - P) <= Length || std::memcmp(P, Keyword, Length) != 0 || !ObjParser::IsBlank(P[Length]))
+        {
+            return nullptr;
+        }
+        return P + Length;
+    }
+
+    /** 줄 끝의 \r\n을 뺀 나머지 (usemtl/mtllib 인자, getline 결과와 같게) */
+    FString RestOfLine(const char* P, const char* LineEnd)
+    {
+        P = ObjParser::SkipBlanks(P, LineEnd);
+        while (LineEnd > P && (LineEnd[-1] == '\n' || LineEnd[-1] == '\r'))
+        {
+            --LineEnd;
+        }
+        return FString(P, LineEnd);
+    }
+
+    uint32 ResolveIndex(int32 RawIndex, uint32 LocalCount, uint32 Slot, TArray<uint32>& OutRelativeSlots)
+    {
+        if (RawIndex > 0)
+        {
+            return static_cast<uint32>(RawIndex - 1);
+        }
+        if (RawIndex < 0)
+        {
+            // -1 = 직전 정점. 앞 청크 정점 수는 병합 때 더함 (uint32 wrap-around로 음수 로컬 인덱스도 보정됨)
+            OutRelativeSlots.push_back(Slot);
+            return LocalCount + static_cast<uint32>(RawIndex);
+        }
+        return 0;
+    }
+
+    void ParseChunk(const char* Begin, const char* End, bool bIsRightHanded, FObjChunk& Chunk)
+    {
+        using namespace ObjParser;
+
+        // 대략적인 예약 (줄당 평균 30바이트 가정, 대부분이 v/f 줄)
+        const size_t EstimatedLines = static_cast<size_t>(End - Begin) / 30;
+        Chunk.Positions.reserve(EstimatedLines / 3);
+        Chunk.PositionIndices.reserve(EstimatedLines);
+        Chunk.TexCoordIndices.reserve(EstimatedLines);
+        Chunk.NormalIndices.reserve(EstimatedLines);
+
+        const float YSign = bIsRightHanded ? -1.0f : 1.0f;
+        TInlineArray<FFaceCorner, 8> FaceCorners;
+
+        for (const char* Line = Begin; Line < End; )
+        {
+            const char* LineEnd = NextLine(Line, End);
+            const char* P = SkipBlanks(Line, LineEnd);
+            if (P >= LineEnd || *P == '\n' || *P == '#')
+            {
+                Line = LineEnd;
+                continue;
+            }
+
+            const char* Args = nullptr;
+            if ((Args = MatchKeyword(P, LineEnd, "v", 1)) != nullptr)
+            {
+                float X, Y, Z;
+                Args = ParseFloat(Args, LineEnd, X);
+                Args = ParseFloat(Args, LineEnd, Y);
+                ParseFloat(Args, LineEnd, Z);
+                Chunk.Positions.push_back(FVector(X, Y * YSign, Z));
+            }
+            else if ((Args = MatchKeyword(P, LineEnd, "vt", 2)) != nullptr)
+            {
+                float U, V;
+                Args = ParseFloat(Args, LineEnd, U);
+                ParseFloat(Args, LineEnd, V);
+                // obj의 vt는 좌하단이 (0,0) -> DirectX UV는 좌상단이 (0,0) (상하 반전으로 컨버팅)
+                Chunk.TexCoords.push_back(FVector2D(U, 1.0f - V));
+            }
+            else if ((Args = MatchKeyword(P, LineEnd, "vn", 2)) != nullptr)
+            {
+                float X, Y, Z;
+                Args = ParseFloat(Args, LineEnd, X);
+                Args = ParseFloat(Args, LineEnd, Y);
+                ParseFloat(Args, LineEnd, Z);
+                Chunk.Normals.push_back(FVector(X, Y * YSign, Z));
+            }
+            else if ((Args = MatchKeyword(P, LineEnd, "f", 1)) != nullptr)
+            {
+                // v, v/vt, v//vn, v/vt/vn. '#' 이후는 주석
+                FaceCorners.Reset();
+                for (const char* Token = SkipBlanks(Args, LineEnd); Token < LineEnd && *Token != '\n' && *Token != '#'; Token = SkipBlanks(Token, LineEnd))
+                {
+                    FFaceCorner Corner;
+                    Token = ParseInt(Token, LineEnd, Corner.Position);
+                    if (Token < LineEnd && *Token == '/')
+                    {
+                        Token = ParseInt(Token + 1, LineEnd, Corner.TexCoord);
+                        if (Token < LineEnd && *Token == '/')
+                        {
+                            Token = ParseInt(Token + 1, LineEnd, Corner.Normal);
+                        }
+                    }
+                    Token = SkipToken(Token, LineEnd);
+                    FaceCorners.Add(Corner);
+                }
+
+                // 4각형 이상의 폴리곤은 팬으로 삼각형 분할
+                for (int32 i = 1; i + 1 < FaceCorners.Num(); ++i)
+                {
+                    const int32 Order[3] = { 0, bIsRightHanded ? i + 1 : i, bIsRightHanded ? i : i + 1 };
+                    for (int32 CornerIndex : Order)
+                    {
+                        const FFaceCorner& Corner = FaceCorners[CornerIndex];
+                        const uint32 Slot = static_cast<uint32>(Chunk.PositionIndices.size());
+                        Chunk.PositionIndices.push_back(ResolveIndex(Corner.Position, static_cast<uint32>(Chunk.Positions.size()), Slot, Chunk.RelativePositionSlots));
+                        Chunk.TexCoordIndices.push_back(ResolveIndex(Corner.TexCoord, static_cast<uint32>(Chunk.TexCoords.size()), Slot, Chunk.RelativeTexCoordSlots));
+                        Chunk.NormalIndices.push_back(ResolveIndex(Corner.Normal, static_cast<uint32>(Chunk.Normals.size()), Slot, Chunk.RelativeNormalSlots));
+                    }
+                }
+            }
+            else if ((Args = MatchKeyword(P, LineEnd, "usemtl", 6)) != nullptr)
+            {
+                Chunk.MaterialMarks.emplace_back(static_cast<uint32>(Chunk.PositionIndices.size()), RestOfLine(Args, LineEnd));
+            }
+            else if ((Args = MatchKeyword(P, LineEnd, "mtllib", 6)) != nullptr)
+            {
+                Chunk.MtlPath = RestOfLine(Args, LineEnd);
+            }
+            else if (MatchKeyword(P, LineEnd, "g", 1))
+            {
+                // 현재 'usemtl'을 기준으로 그룹을 나누므로 'g' 태그는 무시합니다.
+            }
+            else
+            {
+                // 줄마다 로그를 남기면 대용량 파일에서 파싱보다 로그가 더 오래 걸리므로 개수만 셈
+                if (Chunk.NumUnknownLines++ == 0)
+                {
+                    Chunk.FirstUnknownLine = RestOfLine(P, LineEnd);
+                }
+            }
+
+            Line = LineEnd;
+        }
+    }
+
+    template<typename T>
+    void AppendRange(TArray<T>& Dest, size_t Offset, const TArray<T>& Source)
+    {
+        if (!Source.empty())
+        {
+            std::memcpy(Dest.data() + Offset, Source.data(), Source.size() * sizeof(T));
+        }
+    }
+
+    uint64 HashCorner(uint32 Position, uint32 TexCoord, uint32 Normal)
+    {
+        uint64 Hash = Position * 0x9E3779B97F4A7C15ull;
+        Hash ^= TexCoord * 0xC2B2AE3D27D4EB4Full;
+        Hash ^= Normal * 0x165667B19E3779F9ull;
+        Hash ^= Hash >> 29;
+        Hash *= 0xBF58476D1CE4E5B9ull;
+        Hash ^= Hash >> 32;
+        return Hash;
+    }
+
+    uint32 NextPowerOfTwo(uint32 Value)
+    {
+        uint32 Result = 1;
+        while (Result < Value)
+        {
+            Result <<= 1;
+        }
+        return Result;
+    }
+}
+
+// ──────────────────────────────────────────────
+// FMappedFile
+// ──────────────────────────────────────────────
+
+bool ObjParser::FMappedFile::Open(const FString& FilePath)
+{
+    Close();
+
+    const FWideString WidePath = UTF8ToWide(FilePath);
+    HANDLE File = CreateFileW(WidePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (File == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    FileHandle = File;
+
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(File, &FileSize))
+    {
+        Close();
+        return false;
+    }
+
+    // 빈 파일은 맵핑할 수 없으므로 크기 0인 뷰로 취급
+    Size = static_cast<uint64>(FileSize.QuadPart);
+    if (Size == 0)
+    {
+        return true;
+    }
+
+    HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!Mapping)
+    {
+        Close();
+        return false;
+    }
+    MappingHandle = Mapping;
+
+    Data = static_cast<const char*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!Data)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void ObjParser::FMappedFile::Close()
+{
+    if (Data)
+    {
+        UnmapViewOfFile(Data);
+        Data = nullptr;
+    }
+    if (MappingHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(MappingHandle));
+        MappingHandle = nullptr;
+    }
+    if (FileHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(FileHandle));
+        FileHandle = nullptr;
+    }
+    Size = 0;
+}
+
+// ──────────────────────────────────────────────
+// ParseObj
+// ──────────────────────────────────────────────
+
+void ObjParser::ParseObj(const char* Data, uint64 Size, const FString& ObjDir, bool bIsRightHanded, FObjInfo& OutObjInfo, FString& OutMtlPath)
+{
+    OutMtlPath.clear();
+
+    // 1) 줄 경계에 맞춰 청크 분할
+    const int32 NumWorkers = FTaskGraph::GetInstance().GetNumWorkers() + 1;
+    const uint64 MaxChunks = static_cast<uint64>(NumWorkers) * 4;
+    const int32 NumChunks = static_cast<int32>(std::clamp<uint64>(Size / MinChunkBytes, 1, MaxChunks));
+
+    const char* const End = Data + Size;
+    TArray<const char*> Boundaries;
+    Boundaries.reserve(NumChunks + 1);
+    Boundaries.push_back(Data);
+    for (int32 i = 1; i < NumChunks; ++i)
+    {
+        const char* Split = std::max(Data + Size * i / NumChunks, Boundaries.back());
+        Boundaries.push_back(Split < End ? NextLine(Split, End) : End);
+    }
+    Boundaries.push_back(End);
+
+    // 2) 청크별 병렬 파싱
+    TArray<FObjChunk> Chunks(NumChunks);
+    ParallelFor(NumChunks, [&](int32 ChunkIndex)
+    {
+        ParseChunk(Boundaries[ChunkIndex], Boundaries[ChunkIndex + 1], bIsRightHanded, Chunks[ChunkIndex]);
+    });
+
+    // 3) 청크별 시작 오프셋 (앞 청크들의 개수 합)
+    struct FChunkBase { size_t Position, TexCoord, Normal, Corner; };
+    TArray<FChunkBase> Bases(NumChunks + 1);
+    Bases[0] = { 0, 0, 0, 0 };
+    for (int32 i = 0; i < NumChunks; ++i)
+    {
+        Bases[i + 1].Position = Bases[i].Position + Chunks[i].Positions.size();
+        Bases[i + 1].TexCoord = Bases[i].TexCoord + Chunks[i].TexCoords.size();
+        Bases[i + 1].Normal = Bases[i].Normal + Chunks[i].Normals.size();
+        Bases[i + 1].Corner = Bases[i].Corner + Chunks[i].PositionIndices.size();
+    }
+    const FChunkBase& Totals = Bases[NumChunks];
+
+    // 4) 병합: 각 청크를 자기 오프셋에 복사 (병렬)
+    OutObjInfo.Positions.resize(Totals.Position);
+    OutObjInfo.TexCoords.resize(Totals.TexCoord);
+    OutObjInfo.Normals.resize(Totals.Normal);
+    OutObjInfo.PositionIndices.resize(Totals.Corner);
+    OutObjInfo.TexCoordIndices.resize(Totals.Corner);
+    OutObjInfo.NormalIndices.resize(Totals.Corner);
+
+    ParallelFor(NumChunks, [&](int32 ChunkIndex)
+    {
+        const FObjChunk& Chunk = Chunks[ChunkIndex];
+        const FChunkBase& Base = Bases[ChunkIndex];
+
+        AppendRange(OutObjInfo.Positions, Base.Position, Chunk.Positions);
+        AppendRange(OutObjInfo.TexCoords, Base.TexCoord, Chunk.TexCoords);
+        AppendRange(OutObjInfo.Normals, Base.Normal, Chunk.Normals);
+        AppendRange(OutObjInfo.PositionIndices, Base.Corner, Chunk.PositionIndices);
+        AppendRange(OutObjInfo.TexCoordIndices, Base.Corner, Chunk.TexCoordIndices);
+        AppendRange(OutObjInfo.NormalIndices, Base.Corner, Chunk.NormalIndices);
+
+        for (uint32 Slot : Chunk.RelativePositionSlots)
+        {
+            OutObjInfo.PositionIndices[Base.Corner + Slot] += static_cast<uint32>(Base.Position);
+        }
+        for (uint32 Slot : Chunk.RelativeTexCoordSlots)
+        {
+            OutObjInfo.TexCoordIndices[Base.Corner + Slot] += static_cast<uint32>(Base.TexCoord);
+        }
+        for (uint32 Slot : Chunk.RelativeNormalSlots)
+        {
+            OutObjInfo.NormalIndices[Base.Corner + Slot] += static_cast<uint32>(Base.Normal);
+        }
+    });
+
+    // 5) 머티리얼 그룹/mtllib/알 수 없는 줄은 청크 순서대로
+    int32 NumUnknownLines = 0;
+    for (int32 i = 0; i < NumChunks; ++i)
+    {
+        const FObjChunk& Chunk = Chunks[i];
+        for (const auto& [CornerOffset, MaterialName] : Chunk.MaterialMarks)
+        {
+            OutObjInfo.MaterialNames.push_back(MaterialName);
+            OutObjInfo.GroupIndexStartArray.push_back(static_cast<uint32>(Bases[i].Corner + CornerOffset));
+        }
+        if (!Chunk.MtlPath.empty())
+        {
+            OutMtlPath = ObjDir + Chunk.MtlPath;
+        }
+        if (Chunk.NumUnknownLines > 0 && NumUnknownLines == 0)
+        {
+            UE_LOG("While parsing the filename %s, the following unknown symbol was encountered: \'%s\'",
+                OutObjInfo.ObjFileName.c_str(), Chunk.FirstUnknownLine.c_str());
+        }
+        NumUnknownLines += Chunk.NumUnknownLines;
+    }
+    if (NumUnknownLines > 1)
+    {
+        UE_LOG("[ObjParser] %s: %d unsupported lines ignored", OutObjInfo.ObjFileName.c_str(), NumUnknownLines);
+    }
+
+    if (OutObjInfo.MaterialNames.empty())
+    {
+        OutObjInfo.GroupIndexStartArray.push_back(0);
+    }
+    OutObjInfo.GroupIndexStartArray.push_back(static_cast<uint32>(Totals.Corner));
+
+    // 첫 usemtl 앞에 면이 없으면 빈 그룹이 생기지 않도록 제거
+    if (OutObjInfo.GroupIndexStartArray.size() > 1 && OutObjInfo.GroupIndexStartArray[1] == 0)
+    {
+        OutObjInfo.GroupIndexStartArray.erase(OutObjInfo.GroupIndexStartArray.begin() + 1);
+    }
+
+    if (OutObjInfo.Normals.empty())
+    {
+        OutObjInfo.Normals.push_back(FVector(0.0f, 0.0f, 0.0f));
+    }
+    if (OutObjInfo.TexCoords.empty())
+    {
+        OutObjInfo.TexCoords.push_back(FVector2D(0.0f, 0.0f));
+    }
+}
+
+// ──────────────────────────────────────────────
+// WeldCorners
+// ──────────────────────────────────────────────
+
+void ObjParser::WeldCorners(const uint32* PositionIndices, const uint32* TexCoordIndices, const uint32* NormalIndices, uint32 NumCorners,
+    TArray<uint32>& OutCornerToVertex, TArray<uint32>& OutVertexToCorner)
+{
+    OutCornerToVertex.resize(NumCorners);
+    OutVertexToCorner.clear();
+    if (NumCorners == 0)
+    {
+        return;
+    }
+
+    auto IsSameCorner = [&](uint32 A, uint32 B)
+    {
+        return PositionIndices[A] == PositionIndices[B] && TexCoordIndices[A] == TexCoordIndices[B] && NormalIndices[A] == NormalIndices[B];
+    };
+
+    // 코너 목록(오름차순)을 오픈 어드레싱 테이블로 병합. 같은 키의 첫 코너가 대표(Representative)
+    auto WeldRange = [&](const uint32* Corners, uint32 Num, uint32* OutRepresentative, TArray<uint32>& Table)
+    {
+        const uint32 TableSize = NextPowerOfTwo(std::max(Num * 2, 16u));
+        const uint32 Mask = TableSize - 1;
+        Table.assign(TableSize, InvalidCorner);
+
+        for (uint32 i = 0; i < Num; ++i)
+        {
+            const uint32 Corner = Corners ? Corners[i] : i;
+            uint32 Slot = static_cast<uint32>(HashCorner(PositionIndices[Corner], TexCoordIndices[Corner], NormalIndices[Corner])) & Mask;
+            while (true)
+            {
+                const uint32 Existing = Table[Slot];
+                if (Existing == InvalidCorner)
+                {
+                    Table[Slot] = Corner;
+                    OutRepresentative[Corner] = Corner;
+                    break;
+                }
+                if (IsSameCorner(Existing, Corner))
+                {
+                    OutRepresentative[Corner] = Existing;
+                    break;
+                }
+                Slot = (Slot + 1) & Mask;
+            }
+        }
+    };
+
+    // 대표 코너 → 정점 번호 (처음 등장 순서), 나머지 코너는 대표의 번호를 따름
+    TArray<uint32>& Representative = OutCornerToVertex;
+
+    if (NumCorners < MinParallelWeldCorners || FTaskGraph::GetInstance().GetNumWorkers() == 0)
+    {
+        TArray<uint32> Table;
+        WeldRange(nullptr, NumCorners, Representative.data(), Table);
+        for (uint32 Corner = 0; Corner < NumCorners; ++Corner)
+        {
+            if (Representative[Corner] == Corner)
+            {
+                Representative[Corner] = static_cast<uint32>(OutVertexToCorner.size());
+                OutVertexToCorner.push_back(Corner);
+            }
+            else
+            {
+                Representative[Corner] = Representative[Representative[Corner]];
+            }
+        }
+        return;
+    }
+
+    // 1) 해시 상위 비트로 버킷 분할: 블록별 버킷 개수 → 오프셋 → 안정적 scatter (버킷 안에서 코너 오름차순 유지)
+    constexpr uint32 NumBuckets = 1u << WeldBucketBits;
+    const uint32 BlockSize = 16384;
+    const int32 NumBlocks = static_cast<int32>((NumCorners + BlockSize - 1) / BlockSize);
+    auto GetBucket = [&](uint32 Corner)
+    {
+        return static_cast<uint32>(HashCorner(PositionIndices[Corner], TexCoordIndices[Corner], NormalIndices[Corner]) >> (64 - WeldBucketBits));
+    };
+
+    TArray<uint32> BlockBucketOffsets(static_cast<size_t>(NumBlocks) * NumBuckets, 0);
+    ParallelFor(NumBlocks, [&](int32 Block)
+    {
+        uint32* Counts = BlockBucketOffsets.data() + static_cast<size_t>(Block) * NumBuckets;
+        const uint32 Begin = Block * BlockSize;
+        const uint32 End = std::min(Begin + BlockSize, NumCorners);
+        for (uint32 Corner = Begin; Corner < End; ++Corner)
+        {
+            ++Counts[GetBucket(Corner)];
+        }
+    });
+
+    TArray<uint32> BucketStarts(NumBuckets + 1, 0);
+    uint32 Running = 0;
+    for (uint32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        BucketStarts[Bucket] = Running;
+        for (int32 Block = 0; Block < NumBlocks; ++Block)
+        {
+            uint32& Slot = BlockBucketOffsets[static_cast<size_t>(Block) * NumBuckets + Bucket];
+            const uint32 Count = Slot;
+            Slot = Running;
+            Running += Count;
+        }
+    }
+    BucketStarts[NumBuckets] = Running;
+
+    TArray<uint32> SortedCorners(NumCorners);
+    ParallelFor(NumBlocks, [&](int32 Block)
+    {
+        uint32* Offsets = BlockBucketOffsets.data() + static_cast<size_t>(Block) * NumBuckets;
+        const uint32 Begin = Block * BlockSize;
+        const uint32 End = std::min(Begin + BlockSize, NumCorners);
+        for (uint32 Corner = Begin; Corner < End; ++Corner)
+        {
+            SortedCorners[Offsets[GetBucket(Corner)]++] = Corner;
+        }
+    });
+
+    // 2) 버킷별 병렬 병합 (같은 키는 항상 같은 버킷)
+    ParallelFor(static_cast<int32>(NumBuckets), [&](int32 Bucket)
+    {
+        thread_local TArray<uint32> Table;
+        const uint32 Begin = BucketStarts[Bucket];
+        WeldRange(SortedCorners.data() + Begin, BucketStarts[Bucket + 1] - Begin, Representative.data(), Table);
+    });
+
+    // 3) 대표 코너에 처음 등장 순서대로 번호 부여 (블록별 개수 → prefix sum → 블록별 기록)
+    TArray<uint32> BlockVertexStarts(NumBlocks + 1, 0);
+    ParallelFor(NumBlocks, [&](int32 Block)
+    {
+        const uint32 Begin = Block * BlockSize;
+        const uint32 End = std::min(Begin + BlockSize, NumCorners);
+        uint32 Count = 0;
+        for (uint32 Corner = Begin; Corner < End; ++Corner)
+        {
+            Count += Representative[Corner] == Corner ? 1 : 0;
+        }
+        BlockVertexStarts[Block + 1] = Count;
+    });
+    for (int32 Block = 0; Block < NumBlocks; ++Block)
+    {
+        BlockVertexStarts[Block + 1] += BlockVertexStarts[Block];
+    }
+
+    OutVertexToCorner.resize(BlockVertexStarts[NumBlocks]);
+    TArray<uint32> VertexOfCorner(NumCorners);
+    ParallelFor(NumBlocks, [&](int32 Block)
+    {
+        const uint32 Begin = Block * BlockSize;
+        const uint32 End = std::min(Begin + BlockSize, NumCorners);
+        uint32 Vertex = BlockVertexStarts[Block];
+        for (uint32 Corner = Begin; Corner < End; ++Corner)
+        {
+            if (Representative[Corner] == Corner)
+            {
+                VertexOfCorner[Corner] = Vertex;
+                OutVertexToCorner[Vertex] = Corner;
+                ++Vertex;
+            }
+        }
+    });
+
+    // 4) 모든 코너 → 대표의 정점 번호 (대표 번호는 3)에서 모두 확정됨)
+    ParallelForRange(static_cast<int32>(NumCorners), [&](int32 Begin, int32 End)
+    {
+        for (int32 Corner = Begin; Corner < End; ++Corner)
+        {
+            OutCornerToVertex[Corner] = VertexOfCorner[Representative[Corner]];
+        }
+    }, static_cast<int32>(BlockSize));
+}
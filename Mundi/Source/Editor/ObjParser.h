@@ -0,0 +1,108 @@
+﻿#pragma once
+#include <charconv>
+
+struct FObjInfo;
+
+/**
+ * 대용량 .obj 파서
+ *
+ * - 파일을 메모리 맵핑해서 한 번도 복사하지 않고 파싱 (getline/stringstream 없음)
+ * - 파일을 줄 경계 기준 청크로 나눠 FTaskGraph에서 병렬 파싱한 뒤, 청크 순서대로 이어붙임
+ *   (결과는 순차 파싱과 완전히 같음. 음수(상대) 인덱스도 병합 시 보정)
+ * - 숫자는 std::from_chars로 파싱 (로케일/스트림 오버헤드 없음)
+ * - WeldCorners: (위치, UV, 노멀) 인덱스가 같은 면 코너를 하나의 정점으로 병렬 병합
+ */
+namespace ObjParser
+{
+    /** 읽기 전용 메모리 맵 파일 */
+    class FMappedFile
+    {
+    public:
+        FMappedFile() = default;
+        ~FMappedFile() { Close(); }
+
+        FMappedFile(const FMappedFile&) = delete;
+        FMappedFile& operator=(const FMappedFile&) = delete;
+
+        bool Open(const FString& FilePath);
+        void Close();
+
+        const char* GetData() const { return Data; }
+        uint64 GetSize() const { return Size; }
+
+    private:
+        const char* Data = nullptr;
+        uint64 Size = 0;
+        void* FileHandle = nullptr;
+        void* MappingHandle = nullptr;
+    };
+
+    /**
+     * .obj 텍스트를 FObjInfo로 파싱 (FObjImporter::LoadObjModel의 지오메트리 부분)
+     * - bIsRightHanded이면 Y를 뒤집고 삼각형 감기 순서를 바꿈, UV의 V는 1 - v
+     * - 노멀/UV가 하나도 없으면 0번에 기본값을 하나 넣어 인덱스 0이 항상 유효하도록 함
+     * @param ObjDir      mtllib 경로 앞에 붙일 .obj 디렉토리 ('/' 포함)
+     * @param OutMtlPath  마지막 mtllib 경로 (없으면 빈 문자열)
+     */
+    void ParseObj(const char* Data, uint64 Size, const FString& ObjDir, bool bIsRightHanded, FObjInfo& OutObjInfo, FString& OutMtlPath);
+
+    /**
+     * 인덱스 조합이 같은 코너를 하나의 정점으로 병합 (해시 버킷별 병렬 처리, 전역 해시맵/락 없음)
+     * 정점 순서는 처음 등장한 순서라서 unordered_map으로 순차 병합한 결과와 같음
+     * @param OutCornerToVertex 코너 → 정점 인덱스 (그대로 인덱스 버퍼로 사용 가능)
+     * @param OutVertexToCorner 정점 → 처음 등장한 코너
+     */
+    void WeldCorners(const uint32* PositionIndices, const uint32* TexCoordIndices, const uint32* NormalIndices, uint32 NumCorners,
+        TArray<uint32>& OutCornerToVertex, TArray<uint32>& OutVertexToCorner);
+
+    // ──────────────────────────────────────────────
+    // 토큰 단위 헬퍼 (Begin..End 범위, 줄 끝을 넘지 않음)
+    // ──────────────────────────────────────────────
+
+    inline bool IsBlank(char C) { return C == ' ' || C == '\t' || C == '\r'; }
+
+    inline const char* SkipBlanks(const char* P, const char* End)
+    {
+        while (P < End && IsBlank(*P)) ++P;
+        return P;
+    }
+
+    inline const char* SkipToken(const char* P, const char* End)
+    {
+        while (P < End && !IsBlank(*P)) ++P;
+        return P;
+    }
+
+    /** 다음 줄 시작 (마지막 줄이면 End) */
+    inline const char* NextLine(const char* P, const char* End)
+    {
+        const void* NewLine = std::memchr(P, '\n', static_cast<size_t>(End - P));
+        return NewLine ? static_cast<const char*>(NewLine) + 1 : End;
+    }
+
+    /** 실패하면 OutValue = 0, 토큰을 건너뜀 */
+    inline const char* ParseFloat(const char* P, const char* End, float& OutValue)
+    {
+        P = SkipBlanks(P, End);
+        if (P < End && *P == '+') ++P;  // from_chars는 '+'를 받지 않음
+        const std::from_chars_result Result = std::from_chars(P, End, OutValue);
+        if (Result.ec != std::errc())
+        {
+            OutValue = 0.0f;
+            return SkipToken(P, End);
+        }
+        return Result.ptr;
+    }
+
+    inline const char* ParseInt(const char* P, const char* End, int32& OutValue)
+    {
+        if (P < End && *P == '+') ++P;
+        const std::from_chars_result Result = std::from_chars(P, End, OutValue);
+        if (Result.ec != std::errc())
+        {
+            OutValue = 0;
+            return P;
+        }
+        return Result.ptr;
+    }
+}
@@ -0,0 +1,559 @@
+﻿#include "pch.h"
+#include "AssetRegistry.h"
+#include "ResourceManager.h"
+#include "JsonSerializer.h"
+#include "PlatformTime.h"
+#include <psapi.h>
+
+#pragma comment(lib, "psapi.lib")
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // 매니페스트 구조가 바뀌면 올릴 것 (버전이 다르면 전체 재스캔)
+    constexpr int32 ManifestVersion = 1;
+
+    FString ToLower(FString Str)
+    {
+        std::transform(Str.begin(), Str.end(), Str.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return Str;
+    }
+
+    FString TrimLine(FString Line)
+    {
+        Line.erase(0, Line.find_first_not_of(" \t\r\n"));
+        Line.erase(Line.find_last_not_of(" \t\r\n") + 1);
+        return Line;
+    }
+
+    /** "map_Kd -bm 1.0 path/to/file.png" → 마지막 토큰 (ObjManager의 mtl 파서와 같은 규칙) */
+    FString GetLastToken(const FString& Line, size_t Offset)
+    {
+        std::stringstream Stream(Line.substr(Offset));
+        FString Token;
+        FString Last;
+        while (Stream >> Token)
+        {
+            Last = Token;
+        }
+        return NormalizePath(Last);
+    }
+
+    // JSON 정수는 long(Windows 32비트)이므로 64비트 값은 문자열로 저장
+    JSON MakeUInt64(uint64 Value)
+    {
+        return JSON(std::to_string(Value));
+    }
+
+    uint64 ReadUInt64(const JSON& Value)
+    {
+        try
+        {
+            return std::stoull(Value.ToString());
+        }
+        catch (...)
+        {
+            return 0;
+        }
+    }
+
+    JSON MakeStringArray(const TArray<FString>& Strings)
+    {
+        JSON Array = JSON::Make(JSON::Class::Array);
+        for (const FString& Str : Strings)
+        {
+            Array.append(Str);
+        }
+        return Array;
+    }
+
+    void ReadStringArray(const JSON& Array, TArray<FString>& OutStrings)
+    {
+        OutStrings.clear();
+        if (Array.JSONType() != JSON::Class::Array)
+        {
+            return;
+        }
+        for (int32 i = 0; i < static_cast<int32>(Array.size()); ++i)
+        {
+            OutStrings.push_back(Array.at(i).ToString());
+        }
+    }
+}
+
+FAssetRegistry& FAssetRegistry::GetInstance()
+{
+    static FAssetRegistry Instance;
+    return Instance;
+}
+
+EResourceType FAssetRegistry::ClassifyExtension(const FString& LowerExtension)
+{
+    if (LowerExtension == ".obj") return EResourceType::StaticMesh;
+    if (LowerExtension == ".fbx") return EResourceType::SkeletalMesh;
+    if (LowerExtension == ".dds" || LowerExtension == ".png" || LowerExtension == ".jpg"
+        || LowerExtension == ".jpeg" || LowerExtension == ".tga") return EResourceType::Texture;
+    if (LowerExtension == ".wav") return EResourceType::Sound;
+    if (LowerExtension == ".particle") return EResourceType::Particle;
+    if (LowerExtension == ".phys") return EResourceType::PhysicsAsset;
+    return EResourceType::End;  // 레지스트리 대상 아님
+}
+
+FString FAssetRegistry::GetManifestPath()
+{
+    return GCacheDir + "/AssetRegistry.json";
+}
+
+void FAssetRegistry::Initialize()
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    const fs::path DataDir(UTF8ToWide(GDataDir));
+    if (!fs::exists(DataDir) || !fs::is_directory(DataDir))
+    {
+        UE_LOG("[AssetRegistry] Data directory not found: %s", GDataDir.c_str());
+        return;
+    }
+
+    const bool bManifestLoaded = LoadManifest();
+
+    // 1) 디렉토리 순회: 크기/수정 시간이 같으면 매니페스트 항목을 그대로 사용
+    TMap<FString, FAssetData> Previous = std::move(Assets);
+    Assets.clear();
+
+    TArray<FString> ChangedPaths;
+    std::error_code Ec;
+    for (fs::recursive_directory_iterator It(DataDir, Ec), End; It != End; It.increment(Ec))
+    {
+        if (Ec)
+        {
+            break;
+        }
+
+        const fs::directory_entry& Entry = *It;
+        if (!Entry.is_regular_file(Ec))
+        {
+            continue;
+        }
+
+        const FString Extension = ToLower(WideToUTF8(Entry.path().extension().wstring()));
+        EResourceType Type = ClassifyExtension(Extension);
+        if (Type == EResourceType::End)
+        {
+            if (Extension != ".mtl")
+            {
+                continue;
+            }
+            Type = EResourceType::None;   // .obj 의존성 변경 감지용
+        }
+
+        FAssetData Data;
+        Data.Path = NormalizePath(WideToUTF8(Entry.path().wstring()));
+        Data.Type = Type;
+        Data.Size = static_cast<uint64>(Entry.file_size(Ec));
+        Data.LastWriteTime = static_cast<int64>(Entry.last_write_time(Ec).time_since_epoch().count());
+
+        auto Found = Previous.find(Data.Path);
+        if (Found != Previous.end()
+            && Found->second.Type == Data.Type
+            && Found->second.Size == Data.Size
+            && Found->second.LastWriteTime == Data.LastWriteTime)
+        {
+            Data.Dependencies = std::move(Found->second.Dependencies);
+            Data.LinearTextures = std::move(Found->second.LinearTextures);
+        }
+        else
+        {
+            ChangedPaths.push_back(Data.Path);
+        }
+        Assets[Data.Path] = std::move(Data);
+    }
+
+    // 2) 바뀌거나 삭제된 .mtl을 참조하는 .obj도 다시 스캔 (텍스처 의존성이 .mtl 안에 있음)
+    TSet<FString> ChangedSet(ChangedPaths.begin(), ChangedPaths.end());
+    for (auto& [Path, Asset] : Assets)
+    {
+        if (Asset.Type != EResourceType::StaticMesh || ChangedSet.count(Path))
+        {
+            continue;
+        }
+        for (const FString& Dependency : Asset.Dependencies)
+        {
+            const bool bRemoved = Previous.count(Dependency) && !Assets.count(Dependency);
+            if (ChangedSet.count(Dependency) || bRemoved)
+            {
+                ChangedPaths.push_back(Path);
+                break;
+            }
+        }
+    }
+
+    for (const FString& Path : ChangedPaths)
+    {
+        ScanDependencies(Assets[Path]);
+    }
+
+    // 3) 삭제된 파일 수 (Previous에 남아 있고 디렉토리에 없는 항목)
+    int32 NumRemoved = 0;
+    for (const auto& Pair : Previous)
+    {
+        if (!Assets.count(Pair.first))
+        {
+            ++NumRemoved;
+        }
+    }
+
+    if (!bManifestLoaded || !ChangedPaths.empty() || NumRemoved > 0)
+    {
+        SaveManifest();
+    }
+
+    RegistryMS = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+    UE_LOG("[AssetRegistry] %d assets registered (%d rescanned, %d removed) in %.1f ms",
+        Num(), static_cast<int32>(ChangedPaths.size()), NumRemoved, RegistryMS);
+}
+
+void FAssetRegistry::BeginStartup()
+{
+    StartupBeginCycles = FPlatformTime::Cycles64();
+    StartupMS = 0.0;
+}
+
+void FAssetRegistry::EndStartup()
+{
+    if (StartupBeginCycles == 0)
+    {
+        return;
+    }
+    StartupMS = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartupBeginCycles);
+
+    const FAssetStartupReport Report = GetStartupReport();
+    UE_LOG("[AssetRegistry] Startup %.1f ms (registry %.1f ms), %d/%d meshes+textures loaded (%.1f/%.1f MB), working set %.1f MB, private %.1f MB",
+        Report.StartupMS, Report.RegistryMS, Report.NumLoaded, Report.NumAssets,
+        static_cast<double>(Report.LoadedBytes) / (1024.0 * 1024.0), static_cast<double>(Report.LibraryBytes) / (1024.0 * 1024.0),
+        static_cast<double>(Report.WorkingSetBytes) / (1024.0 * 1024.0), static_cast<double>(Report.PrivateBytes) / (1024.0 * 1024.0));
+}
+
+FAssetStartupReport FAssetRegistry::GetStartupReport() const
+{
+    FAssetStartupReport Report;
+    Report.StartupMS = StartupMS;
+    Report.RegistryMS = RegistryMS;
+
+    for (const auto& [Path, Asset] : Assets)
+    {
+        bool bLoaded = false;
+        if (Asset.Type == EResourceType::StaticMesh)
+        {
+            bLoaded = RESOURCE.Get<UStaticMesh>(Path) != nullptr;
+        }
+        else if (Asset.Type == EResourceType::Texture)
+        {
+            bLoaded = RESOURCE.Get<UTexture>(Path) != nullptr;
+        }
+        else
+        {
+            continue;
+        }
+
+        ++Report.NumAssets;
+        Report.LibraryBytes += Asset.Size;
+        if (bLoaded)
+        {
+            ++Report.NumLoaded;
+            Report.LoadedBytes += Asset.Size;
+        }
+    }
+
+    PROCESS_MEMORY_COUNTERS_EX Counters = {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&Counters), sizeof(Counters)))
+    {
+        Report.WorkingSetBytes = Counters.WorkingSetSize;
+        Report.PeakWorkingSetBytes = Counters.PeakWorkingSetSize;
+        Report.PrivateBytes = Counters.PrivateUsage;
+    }
+    return Report;
+}
+
+const FAssetData* FAssetRegistry::Find(const FString& Path) const
+{
+    auto It = Assets.find(NormalizePath(Path));
+    return It != Assets.end() ? &It->second : nullptr;
+}
+
+TArray<FString> FAssetRegistry::GetAssetPaths(EResourceType Type) const
+{
+    TArray<FString> Paths;
+    for (const auto& [Path, Asset] : Assets)
+    {
+        // .fbx는 스태틱 메시로도 로드 가능 (FObjManager가 FBX 임포터로 위임)
+        if (Asset.Type == Type || (Type == EResourceType::StaticMesh && Asset.Type == EResourceType::SkeletalMesh))
+        {
+            Paths.push_back(Path);
+        }
+    }
+    std::sort(Paths.begin(), Paths.end());
+    return Paths;
+}
+
+void FAssetRegistry::CollectLevelAssets(const JSON& LevelJson, TArray<FString>& OutPaths) const
+{
+    TArray<FString> Strings;
+    CollectStrings(LevelJson, Strings);
+
+    TSet<FString> Visited;
+    for (const FString& Str : Strings)
+    {
+        AddWithDependencies(NormalizePath(Str), Visited, OutPaths);
+    }
+}
+
+int32 FAssetRegistry::PrefetchLevelAssets(const JSON& LevelJson)
+{
+    if (!bPrefetchEnabled || Assets.empty())
+    {
+        return 0;
+    }
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    TArray<FString> Strings;
+    CollectStrings(LevelJson, Strings);
+
+    TSet<FString> DirectRefs;
+    for (const FString& Str : Strings)
+    {
+        DirectRefs.insert(NormalizePath(Str));
+    }
+
+    TArray<FString> Paths;
+    CollectLevelAssets(LevelJson, Paths);
+
+    // 노멀맵 등 sRGB가 아닌 텍스처 (참조한 메시의 .mtl 기준)
+    TSet<FString> LinearTextures;
+    for (const FString& Path : Paths)
+    {
+        const FAssetData* Asset = Find(Path);
+        for (const FString& Texture : Asset->LinearTextures)
+        {
+            LinearTextures.insert(Texture);
+        }
+    }
+
+    // 워커 단계가 있는 타입만 요청. 나머지(FBX/사운드 등)는 역직렬화 중 기존처럼 동기 로드
+    // 레벨이 직접 참조한 에셋을 먼저 꺼내도록 High, 의존성은 Normal
+    int32 NumRequested = 0;
+    for (const FString& Path : Paths)
+    {
+        const FAssetData* Asset = Find(Path);
+        const EAsyncLoadPriority Priority = DirectRefs.count(Path) ? EAsyncLoadPriority::High : EAsyncLoadPriority::Normal;
+
+        if (Asset->Type == EResourceType::StaticMesh)
+        {
+            RESOURCE.LoadAsync<UStaticMesh>(Path, Priority);
+            ++NumRequested;
+        }
+        else if (Asset->Type == EResourceType::Texture)
+        {
+            const bool bSRGB = LinearTextures.count(Path) == 0;
+            RESOURCE.LoadAsync<UTexture>(Path, Priority, nullptr, bSRGB);
+            ++NumRequested;
+        }
+    }
+
+    UE_LOG("[AssetRegistry] Level references %d assets, prefetching %d (%.2f ms to issue)",
+        static_cast<int32>(Paths.size()), NumRequested,
+        FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+    return NumRequested;
+}
+
+bool FAssetRegistry::LoadManifest()
+{
+    JSON Manifest;
+    if (!FJsonSerializer::LoadJsonFromFile(Manifest, UTF8ToWide(GetManifestPath()))
+        || Manifest.JSONType() != JSON::Class::Object
+        || !Manifest.hasKey("Version")
+        || Manifest["Version"].ToInt() != ManifestVersion
+        || !Manifest.hasKey("Assets"))
+    {
+        return false;
+    }
+
+    const JSON& AssetArray = Manifest["Assets"];
+    if (AssetArray.JSONType() != JSON::Class::Array)
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < static_cast<int32>(AssetArray.size()); ++i)
+    {
+        const JSON& Item = AssetArray.at(i);
+        if (Item.JSONType() != JSON::Class::Object || !Item.hasKey("Path"))
+        {
+            continue;
+        }
+
+        FAssetData Data;
+        Data.Path = Item.at("Path").ToString();
+        Data.Type = Item.hasKey("Type") ? static_cast<EResourceType>(Item.at("Type").ToInt()) : EResourceType::None;
+        Data.Size = Item.hasKey("Size") ? ReadUInt64(Item.at("Size")) : 0;
+        Data.LastWriteTime = Item.hasKey("Time") ? static_cast<int64>(ReadUInt64(Item.at("Time"))) : 0;
+        if (Item.hasKey("Dependencies"))
+        {
+            ReadStringArray(Item.at("Dependencies"), Data.Dependencies);
+        }
+        if (Item.hasKey("LinearTextures"))
+        {
+            ReadStringArray(Item.at("LinearTextures"), Data.LinearTextures);
+        }
+        Assets[Data.Path] = std::move(Data);
+    }
+    return true;
+}
+
+bool FAssetRegistry::SaveManifest() const
+{
+    // 경로 순으로 기록 (매니페스트 diff를 읽기 쉽게)
+    TArray<const FAssetData*> Sorted;
+    Sorted.reserve(Assets.size());
+    for (const auto& Pair : Assets)
+    {
+        Sorted.push_back(&Pair.second);
+    }
+    std::sort(Sorted.begin(), Sorted.end(), [](const FAssetData* A, const FAssetData* B) { return A->Path < B->Path; });
+
+    JSON AssetArray = JSON::Make(JSON::Class::Array);
+    for (const FAssetData* Asset : Sorted)
+    {
+        JSON Item = JSON::Make(JSON::Class::Object);
+        Item["Path"] = Asset->Path;
+        Item["Type"] = static_cast<int>(Asset->Type);
+        Item["Size"] = MakeUInt64(Asset->Size);
+        Item["Time"] = MakeUInt64(static_cast<uint64>(Asset->LastWriteTime));
+        if (!Asset->Dependencies.empty())
+        {
+            Item["Dependencies"] = MakeStringArray(Asset->Dependencies);
+        }
+        if (!Asset->LinearTextures.empty())
+        {
+            Item["LinearTextures"] = MakeStringArray(Asset->LinearTextures);
+        }
+        AssetArray.append(Item);
+    }
+
+    JSON Manifest = JSON::Make(JSON::Class::Object);
+    Manifest["Version"] = ManifestVersion;
+    Manifest["Assets"] = AssetArray;
+
+    std::error_code Ec;
+    fs::create_directories(fs::path(UTF8ToWide(GCacheDir)), Ec);
+    if (!FJsonSerializer::SaveJsonToFile(Manifest, UTF8ToWide(GetManifestPath())))
+    {
+        UE_LOG("[AssetRegistry] Failed to save manifest: %s", GetManifestPath().c_str());
+        return false;
+    }
+    return true;
+}
+
+void FAssetRegistry::ScanDependencies(FAssetData& Asset) const
+{
+    Asset.Dependencies.clear();
+    Asset.LinearTextures.clear();
+
+    // .obj → mtllib(.mtl) → map_Kd/map_Bump 텍스처
+    // 텍스처 경로는 ObjManager와 같이 .obj 디렉토리 기준으로 해석
+    if (Asset.Type != EResourceType::StaticMesh)
+    {
+        return;
+    }
+
+    const FString ObjBaseDir = NormalizePath(WideToUTF8(fs::path(UTF8ToWide(Asset.Path)).parent_path().wstring()));
+
+    TArray<FString> MtlPaths;
+    {
+        std::ifstream ObjFile(fs::path(UTF8ToWide(Asset.Path)));
+        FString Line;
+        while (std::getline(ObjFile, Line))
+        {
+            Line = TrimLine(Line);
+            if (Line.rfind("mtllib ", 0) == 0)
+            {
+                const FString MtlPath = ResolveAssetRelativePath(TrimLine(Line.substr(7)), ObjBaseDir);
+                if (!MtlPath.empty())
+                {
+                    MtlPaths.AddUnique(MtlPath);
+                }
+            }
+        }
+    }
+
+    for (const FString& MtlPath : MtlPaths)
+    {
+        Asset.Dependencies.AddUnique(MtlPath);
+
+        std::ifstream MtlFile(fs::path(UTF8ToWide(MtlPath)));
+        FString Line;
+        while (std::getline(MtlFile, Line))
+        {
+            Line = TrimLine(Line);
+            const bool bDiffuse = Line.rfind("map_Kd ", 0) == 0;
+            const bool bNormal = Line.rfind("map_Bump ", 0) == 0;
+            if (!bDiffuse && !bNormal)
+            {
+                continue;
+            }
+
+            const FString TexturePath = ResolveAssetRelativePath(GetLastToken(Line, bDiffuse ? 7 : 9), ObjBaseDir);
+            if (TexturePath.empty())
+            {
+                continue;
+            }
+            Asset.Dependencies.AddUnique(TexturePath);
+            if (bNormal)
+            {
+                Asset.LinearTextures.AddUnique(TexturePath);
+            }
+        }
+    }
+}
+
+void FAssetRegistry::CollectStrings(const JSON& Node, TArray<FString>& OutStrings) const
+{
+    switch (Node.JSONType())
+    {
+    case JSON::Class::String:
+        OutStrings.push_back(Node.ToString());
+        break;
+    case JSON::Class::Array:
+        for (int32 i = 0; i < static_cast<int32>(Node.size()); ++i)
+        {
+            CollectStrings(Node.at(i), OutStrings);
+        }
+        break;
+    case JSON::Class::Object:
+        for (const auto& [Key, Value] : Node.ObjectRange())
+        {
+            CollectStrings(Value, OutStrings);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void FAssetRegistry::AddWithDependencies(const FString& Path, TSet<FString>& Visited, TArray<FString>& OutPaths) const
+{
+    const FAssetData* Asset = Find(Path);
+    if (!Asset || !Visited.insert(Asset->Path).second)
+    {
+        return;
+    }
+
+    // 의존성(텍스처)을 먼저 넣어 메시 파이널라이즈 시점에 이미 요청되어 있도록
+    for (const FString& Dependency : Asset->Dependencies)
+    {
+        AddWithDependencies(Dependency, Visited, OutPaths);
+    }
+    OutPaths.push_back(Asset->Path);
+}
@@ -0,0 +1,94 @@
+﻿#pragma once
+#include "Enums.h"
+
+namespace json { class JSON; }
+using JSON = json::JSON;
+
+/** 레지스트리 항목 하나 (매니페스트에 그대로 기록됨) */
+struct FAssetData
+{
+    FString Path;                                   // 정규화 경로 (ResourceManager 키와 동일)
+    EResourceType Type = EResourceType::None;       // None = 직접 로드하지 않는 의존 파일 (.mtl 등)
+    uint64 Size = 0;
+    int64 LastWriteTime = 0;                        // file_time_type tick (변경 감지용)
+
+    TArray<FString> Dependencies;                   // 이 에셋과 함께 필요한 에셋 (.obj → .mtl → 텍스처)
+    TArray<FString> LinearTextures;                 // Dependencies 중 sRGB가 아닌 텍스처 (노멀맵)
+};
+
+/** 시작 비용 보고 (ASSET STARTUP REPORT). 에셋 바이트는 원본 파일 크기, 메모리는 프로세스 워킹셋 기준 */
+struct FAssetStartupReport
+{
+    double StartupMS = 0.0;             // 엔진 Startup 전체 (마지막 레벨 로드 포함). EndStartup 전이면 0
+    double RegistryMS = 0.0;            // Initialize (매니페스트 로드 + 증분 갱신)
+    int32 NumAssets = 0;                // 레지스트리의 메시/텍스처 (변경 전 Preload가 모두 읽던 대상)
+    uint64 LibraryBytes = 0;
+    int32 NumLoaded = 0;                // 그중 현재 로드된 것
+    uint64 LoadedBytes = 0;
+    uint64 WorkingSetBytes = 0;
+    uint64 PeakWorkingSetBytes = 0;
+    uint64 PrivateBytes = 0;
+};
+
+/**
+ * 에셋 레지스트리
+ *
+ * - Data 디렉토리의 에셋 목록(경로/타입/크기/의존성)을 매니페스트(GCacheDir/AssetRegistry.json)로 유지
+ * - 시작 시 매니페스트를 읽고, 크기/수정 시간이 바뀐 파일만 다시 스캔 (전체 로드 없음)
+ * - 레벨을 열 때 레벨 JSON이 참조하는 에셋 + 의존성만 골라 비동기 프리페치
+ *   (역직렬화 중의 동기 Load는 진행 중인 요청에 합류하므로 같은 파일을 두 번 읽지 않음)
+ * - 에디터 선택 목록은 로드 여부와 무관하게 레지스트리 경로를 보여주고, 고를 때 로드
+ */
+class FAssetRegistry
+{
+public:
+    static FAssetRegistry& GetInstance();
+
+    /** 매니페스트 로드 + 증분 갱신. 엔진 Startup에서 호출 */
+    void Initialize();
+
+    const FAssetData* Find(const FString& Path) const;
+    int32 Num() const { return static_cast<int32>(Assets.size()); }
+
+    /** 해당 타입의 모든 에셋 경로 (정렬됨). StaticMesh에는 .fbx도 포함 (스태틱 메시로도 로드 가능) */
+    TArray<FString> GetAssetPaths(EResourceType Type) const;
+
+    /** 레벨 JSON 안의 모든 문자열 중 레지스트리에 있는 경로 + 그 의존성 (의존성이 먼저 오도록) */
+    void CollectLevelAssets(const JSON& LevelJson, TArray<FString>& OutPaths) const;
+
+    /**
+     * 레벨이 쓰는 에셋을 비동기 로드로 미리 요청 (워커 단계가 있는 메시/텍스처만)
+     * @return 요청한 에셋 수
+     */
+    int32 PrefetchLevelAssets(const JSON& LevelJson);
+
+    void SetPrefetchEnabled(bool bEnabled) { bPrefetchEnabled = bEnabled; }
+    bool IsPrefetchEnabled() const { return bPrefetchEnabled; }
+
+    /** 엔진 Startup 처음/끝에서 호출. EndStartup은 시작 시간과 상주 메모리를 로그로 남김 */
+    void BeginStartup();
+    void EndStartup();
+
+    /** 지금 로드된 메시/텍스처 비율과 프로세스 메모리 (전체 Preload와 비교하려면 콘솔 ASSET PRELOAD ALL 후 다시 호출) */
+    FAssetStartupReport GetStartupReport() const;
+
+private:
+    FAssetRegistry() = default;
+
+    static EResourceType ClassifyExtension(const FString& LowerExtension);
+    static FString GetManifestPath();
+
+    bool LoadManifest();
+    bool SaveManifest() const;
+    void ScanDependencies(FAssetData& Asset) const;
+
+    void CollectStrings(const JSON& Node, TArray<FString>& OutStrings) const;
+    void AddWithDependencies(const FString& Path, TSet<FString>& Visited, TArray<FString>& OutPaths) const;
+
+    TMap<FString, FAssetData> Assets;
+    bool bPrefetchEnabled = true;
+
+    uint64 StartupBeginCycles = 0;
+    double StartupMS = 0.0;
+    double RegistryMS = 0.0;
+};
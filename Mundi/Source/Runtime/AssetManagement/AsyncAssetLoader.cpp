@@ -0,0 +1,345 @@
+﻿#include "pch.h"
+#include "AsyncAssetLoader.h"
+#include "PlatformTime.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+
+FAsyncAssetLoader::~FAsyncAssetLoader()
+{
+    CancelAll();
+}
+
+std::shared_ptr<FAsyncLoadRequest> FAsyncAssetLoader::MakeCompletedRequest(UResourceBase* InResource)
+{
+    std::shared_ptr<FAsyncLoadRequest> Request = std::make_shared<FAsyncLoadRequest>();
+    Request->Result = InResource;
+    Request->State.store(InResource ? EAsyncLoadState::Succeeded : EAsyncLoadState::Failed, std::memory_order_release);
+    return Request;
+}
+
+FString FAsyncAssetLoader::MakeKey(uint8 TypeIndex, const FString& Path)
+{
+    return std::to_string(TypeIndex) + ":" + Path;
+}
+
+std::shared_ptr<FAsyncLoadRequest> FAsyncAssetLoader::FindInFlight(uint8 TypeIndex, const FString& Path) const
+{
+    if (InFlightRequests.empty())
+    {
+        return nullptr;
+    }
+
+    auto It = InFlightRequests.find(MakeKey(TypeIndex, Path));
+    return It != InFlightRequests.end() ? It->second : nullptr;
+}
+
+void FAsyncAssetLoader::Enqueue(const std::shared_ptr<FAsyncLoadRequest>& Request)
+{
+    InFlightRequests[MakeKey(Request->TypeIndex, Request->Path)] = Request;
+
+    {
+        std::lock_guard<std::mutex> Lock(QueueLock);
+        QueuedRequests[static_cast<int32>(Request->Priority.load())].Enqueue(Request);
+    }
+
+    // 요청 하나당 작업 하나. 작업은 "이 요청"이 아니라 실행 시점의 최우선 요청을 처리
+    NumScheduledTasks.fetch_add(1, std::memory_order_relaxed);
+    FTaskGraph::GetInstance().Launch([this]()
+    {
+        LoadNextPayload();
+        NumScheduledTasks.fetch_sub(1, std::memory_order_release);
+    });
+}
+
+void FAsyncAssetLoader::RaisePriority(const std::shared_ptr<FAsyncLoadRequest>& Request, EAsyncLoadPriority NewPriority)
+{
+    if (NewPriority >= Request->Priority.load())
+    {
+        return;
+    }
+    Request->Priority.store(NewPriority);
+
+    std::lock_guard<std::mutex> Lock(QueueLock);
+    const EAsyncLoadState Current = Request->State.load(std::memory_order_acquire);
+    if (Current == EAsyncLoadState::Queued)
+    {
+        // 기존 하위 큐 항목은 선점 후 건너뛰어짐
+        QueuedRequests[static_cast<int32>(NewPriority)].Enqueue(Request);
+    }
+    else if (Current == EAsyncLoadState::PendingFinalize)
+    {
+        for (TArray<std::shared_ptr<FAsyncLoadRequest>>& Completed : CompletedRequests)
+        {
+            auto It = std::find(Completed.begin(), Completed.end(), Request);
+            if (It != Completed.end())
+            {
+                Completed.erase(It);
+                CompletedRequests[static_cast<int32>(NewPriority)].push_back(Request);
+                break;
+            }
+        }
+    }
+}
+
+void FAsyncAssetLoader::AddCallback(const std::shared_ptr<FAsyncLoadRequest>& Request, std::function<void(UResourceBase*)> Callback)
+{
+    if (!Callback)
+    {
+        return;
+    }
+
+    if (Request->IsCompleted())
+    {
+        Callback(Request->Result);
+        return;
+    }
+    Request->Callbacks.Add(std::move(Callback));
+}
+
+bool FAsyncAssetLoader::TryClaim(FAsyncLoadRequest& Request)
+{
+    EAsyncLoadState Expected = EAsyncLoadState::Queued;
+    return Request.State.compare_exchange_strong(Expected, EAsyncLoadState::Loading, std::memory_order_acq_rel);
+}
+
+void FAsyncAssetLoader::LoadNextPayload()
+{
+    std::shared_ptr<FAsyncLoadRequest> Request;
+    {
+        std::lock_guard<std::mutex> Lock(QueueLock);
+        for (TQueue<std::shared_ptr<FAsyncLoadRequest>>& Queue : QueuedRequests)
+        {
+            std::shared_ptr<FAsyncLoadRequest> Candidate;
+            while (Queue.Dequeue(Candidate))
+            {
+                if (TryClaim(*Candidate))
+                {
+                    Request = std::move(Candidate);
+                    break;
+                }
+            }
+            if (Request)
+            {
+                break;
+            }
+        }
+    }
+
+    // 게임 스레드가 Wait에서 직접 처리했거나 취소된 경우
+    if (Request)
+    {
+        RunPayload(Request);
+    }
+}
+
+void FAsyncAssetLoader::RunPayload(const std::shared_ptr<FAsyncLoadRequest>& Request)
+{
+    bool bSucceeded = false;
+    try
+    {
+        bSucceeded = Request->LoadPayload ? Request->LoadPayload() : true;
+    }
+    catch (const std::exception& e)
+    {
+        UE_LOG("[AsyncLoad] Exception while loading '%s': %s", Request->Path.c_str(), e.what());
+    }
+    Request->bPayloadSucceeded = bSucceeded;
+
+    std::lock_guard<std::mutex> Lock(QueueLock);
+    Request->State.store(EAsyncLoadState::PendingFinalize, std::memory_order_release);
+    CompletedRequests[static_cast<int32>(Request->Priority.load())].push_back(Request);
+}
+
+void FAsyncAssetLoader::FinalizeRequest(const std::shared_ptr<FAsyncLoadRequest>& Request)
+{
+    Request->State.store(EAsyncLoadState::Finalizing, std::memory_order_release);
+
+    UResourceBase* Result = Request->Finalize ? Request->Finalize(Request->bPayloadSucceeded) : nullptr;
+    if (!Result)
+    {
+        UE_LOG("[AsyncLoad] Failed to load '%s'", Request->Path.c_str());
+    }
+
+    Request->Result = Result;
+    Request->LoadPayload = nullptr;
+    Request->Finalize = nullptr;
+    InFlightRequests.erase(MakeKey(Request->TypeIndex, Request->Path));
+    Request->State.store(Result ? EAsyncLoadState::Succeeded : EAsyncLoadState::Failed, std::memory_order_release);
+
+    // 콜백 안에서 다른 LoadAsync를 호출할 수 있으므로 목록을 먼저 떼어냄
+    TArray<std::function<void(UResourceBase*)>> Callbacks = std::move(Request->Callbacks);
+    Request->Callbacks.Empty();
+    for (const std::function<void(UResourceBase*)>& Callback : Callbacks)
+    {
+        Callback(Result);
+    }
+}
+
+int32 FAsyncAssetLoader::ProcessCompleted(double TimeBudgetMs)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    int32 NumProcessed = 0;
+
+    while (true)
+    {
+        // 한 번에 하나씩 꺼냄: Finalize 도중 Wait()가 나머지 요청을 찾을 수 있어야 함
+        std::shared_ptr<FAsyncLoadRequest> Request;
+        {
+            std::lock_guard<std::mutex> Lock(QueueLock);
+            for (TArray<std::shared_ptr<FAsyncLoadRequest>>& Completed : CompletedRequests)
+            {
+                if (!Completed.empty())
+                {
+                    Request = Completed.front();
+                    Completed.erase(Completed.begin());
+                    break;
+                }
+            }
+        }
+
+        if (!Request)
+        {
+            break;
+        }
+
+        FinalizeRequest(Request);
+        ++NumProcessed;
+
+        if (FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles) >= TimeBudgetMs)
+        {
+            break;
+        }
+    }
+    return NumProcessed;
+}
+
+void FAsyncAssetLoader::Wait(const std::shared_ptr<FAsyncLoadRequest>& Request)
+{
+    while (!Request->IsCompleted())
+    {
+        switch (Request->State.load(std::memory_order_acquire))
+        {
+        case EAsyncLoadState::Queued:
+            // 아직 워커가 못 가져갔으면 직접 처리 (워커 작업은 다른 요청을 가져가거나 그냥 끝남)
+            if (TryClaim(*Request))
+            {
+                RunPayload(Request);
+            }
+            break;
+
+        case EAsyncLoadState::PendingFinalize:
+        {
+            bool bFound = false;
+            {
+                std::lock_guard<std::mutex> Lock(QueueLock);
+                for (TArray<std::shared_ptr<FAsyncLoadRequest>>& Completed : CompletedRequests)
+                {
+                    auto It = std::find(Completed.begin(), Completed.end(), Request);
+                    if (It != Completed.end())
+                    {
+                        Completed.erase(It);
+                        bFound = true;
+                        break;
+                    }
+                }
+            }
+            if (bFound)
+            {
+                FinalizeRequest(Request);
+            }
+            break;
+        }
+
+        case EAsyncLoadState::Finalizing:
+            // 이 요청의 Finalize 안에서 다시 자신을 기다리는 경우 - 더 진행할 수 없음
+            return;
+
+        default:
+            // 워커가 Payload 실행 중: 노는 대신 다른 작업 처리
+            if (!FTaskGraph::GetInstance().TryExecuteOneTask())
+            {
+                std::this_thread::yield();
+            }
+            break;
+        }
+    }
+}
+
+void FAsyncAssetLoader::Flush()
+{
+    // Finalize 콜백이 새 요청을 올릴 수 있으므로 빌 때까지 반복
+    while (!InFlightRequests.empty())
+    {
+        TArray<std::shared_ptr<FAsyncLoadRequest>> Pending;
+        Pending.reserve(InFlightRequests.size());
+        for (auto& Pair : InFlightRequests)
+        {
+            Pending.Add(Pair.second);
+        }
+
+        // 우선순위 순으로 기다려야 중요한 에셋이 먼저 올라감
+        std::stable_sort(Pending.begin(), Pending.end(), [](const std::shared_ptr<FAsyncLoadRequest>& A, const std::shared_ptr<FAsyncLoadRequest>& B)
+        {
+            return A->Priority.load() < B->Priority.load();
+        });
+
+        for (const std::shared_ptr<FAsyncLoadRequest>& Request : Pending)
+        {
+            Wait(Request);
+        }
+    }
+}
+
+void FAsyncAssetLoader::CancelAll()
+{
+    TArray<std::shared_ptr<FAsyncLoadRequest>> Pending;
+    for (auto& Pair : InFlightRequests)
+    {
+        Pending.Add(Pair.second);
+    }
+    InFlightRequests.clear();
+
+    for (const std::shared_ptr<FAsyncLoadRequest>& Request : Pending)
+    {
+        // 아직 시작 전이면 선점해서 Payload를 건너뛰고, 실행 중이면 끝날 때까지 대기
+        if (TryClaim(*Request))
+        {
+            Request->bPayloadSucceeded = false;
+        }
+        else
+        {
+            while (Request->State.load(std::memory_order_acquire) == EAsyncLoadState::Loading)
+            {
+                if (!FTaskGraph::GetInstance().TryExecuteOneTask())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // 실패로 Finalize → 생성해둔 리소스 객체 정리
+        Request->Callbacks.Empty();
+        if (Request->Finalize)
+        {
+            Request->Finalize(false);
+        }
+        Request->Finalize = nullptr;
+        Request->LoadPayload = nullptr;
+        Request->State.store(EAsyncLoadState::Failed, std::memory_order_release);
+    }
+
+    // 올려둔 워커 작업이 이 객체에 접근하지 않을 때까지 대기
+    while (NumScheduledTasks.load(std::memory_order_acquire) > 0)
+    {
+        if (!FTaskGraph::GetInstance().TryExecuteOneTask())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::lock_guard<std::mutex> Lock(QueueLock);
+    for (int32 i = 0; i < static_cast<int32>(EAsyncLoadPriority::Count); ++i)
+    {
+        QueuedRequests[i].Empty();
+        CompletedRequests[i].Empty();
+    }
+}
@@ -0,0 +1,168 @@
+﻿#pragma once
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+class UResourceBase;
+class FAsyncAssetLoader;
+
+/**
+ * 비동기 에셋 로딩 (UResourceManager::LoadAsync가 사용)
+ *
+ * 한 요청은 두 단계로 나뉨
+ * 1) Payload  - 워커 스레드(FTaskGraph): 파일 I/O, 캐시 로드/파싱, 디코딩 등 CPU 작업
+ * 2) Finalize - 게임 스레드: GPU 리소스 생성, UObject 생성/등록, 완료 콜백 호출
+ *
+ * - 같은 타입 + 정규화 경로의 요청은 하나로 합쳐짐 (콜백만 추가, 우선순위는 더 높은 쪽으로 승격)
+ * - 워커는 실행 시점에 대기 중인 요청 중 우선순위가 가장 높은 것을 가져감
+ * - 게임 스레드는 ProcessCompleted()에서 시간 예산 안에서만 Finalize (프레임 스파이크 방지)
+ */
+
+enum class EAsyncLoadPriority : uint8
+{
+    High,       // 지금 화면에 필요한 에셋
+    Normal,
+    Low,        // 에디터 브라우저용 프리로드 등
+    Count
+};
+
+enum class EAsyncLoadState : uint8
+{
+    Queued,             // 워커 배정 대기
+    Loading,            // Payload 실행 중
+    PendingFinalize,    // 게임 스레드 Finalize 대기
+    Finalizing,
+    Succeeded,
+    Failed,
+};
+
+struct FAsyncLoadRequest
+{
+    FString Path;           // 정규화 경로 (리소스 맵 키)
+    uint8 TypeIndex = 0;    // EResourceType
+
+    std::atomic<EAsyncLoadPriority> Priority{ EAsyncLoadPriority::Normal };
+    std::atomic<EAsyncLoadState> State{ EAsyncLoadState::Queued };
+
+    // 워커 스레드에서 실행. false면 Finalize에 실패로 전달됨
+    std::function<bool()> LoadPayload;
+    // 게임 스레드에서 실행. 등록된 리소스(실패 시 nullptr)를 반환하고, 실패한 객체는 직접 정리
+    std::function<UResourceBase*(bool bPayloadSucceeded)> Finalize;
+
+    bool bPayloadSucceeded = false;
+    UResourceBase* Result = nullptr;
+
+    // 게임 스레드 전용
+    TArray<std::function<void(UResourceBase*)>> Callbacks;
+
+    bool IsCompleted() const
+    {
+        const EAsyncLoadState Current = State.load(std::memory_order_acquire);
+        return Current == EAsyncLoadState::Succeeded || Current == EAsyncLoadState::Failed;
+    }
+};
+
+/** LoadAsync 결과 핸들. 복사해서 들고 있어도 되고, 버려도 로드는 계속 진행됨 */
+template<typename T>
+class TAsyncLoadHandle
+{
+public:
+    TAsyncLoadHandle() = default;
+    TAsyncLoadHandle(std::shared_ptr<FAsyncLoadRequest> InRequest, FAsyncAssetLoader* InLoader)
+        : Request(std::move(InRequest)), Loader(InLoader) {}
+
+    bool IsValid() const { return Request != nullptr; }
+    /** 유효하지 않은 핸들은 완료된 것으로 취급 */
+    bool IsCompleted() const { return !Request || Request->IsCompleted(); }
+    bool Succeeded() const { return Request && Request->State.load(std::memory_order_acquire) == EAsyncLoadState::Succeeded; }
+
+    /** 완료 전이면 nullptr */
+    T* Get() const { return Succeeded() ? static_cast<T*>(Request->Result) : nullptr; }
+
+    /** 게임 스레드 전용 - 완료될 때까지 대기 후 결과 반환 (대기 중 이 요청을 직접 처리하거나 다른 작업을 실행) */
+    T* Wait() const;
+
+    void Reset() { Request.reset(); Loader = nullptr; }
+
+private:
+    std::shared_ptr<FAsyncLoadRequest> Request;
+    FAsyncAssetLoader* Loader = nullptr;
+};
+
+class FAsyncAssetLoader
+{
+public:
+    FAsyncAssetLoader() = default;
+    ~FAsyncAssetLoader();
+
+    FAsyncAssetLoader(const FAsyncAssetLoader&) = delete;
+    FAsyncAssetLoader& operator=(const FAsyncAssetLoader&) = delete;
+
+    /** 이미 로드된 리소스를 완료 상태 요청으로 감쌈 (LoadAsync 캐시 히트용) */
+    static std::shared_ptr<FAsyncLoadRequest> MakeCompletedRequest(UResourceBase* InResource);
+
+    // --- 아래는 모두 게임 스레드 전용 ---
+
+    /** 같은 타입/경로로 진행 중인 요청 (없으면 nullptr) */
+    std::shared_ptr<FAsyncLoadRequest> FindInFlight(uint8 TypeIndex, const FString& Path) const;
+
+    /** 새 요청을 등록하고 워커 작업을 올림 */
+    void Enqueue(const std::shared_ptr<FAsyncLoadRequest>& Request);
+
+    /** 중복 요청이 더 높은 우선순위로 들어오면 승격 (낮추지는 않음) */
+    void RaisePriority(const std::shared_ptr<FAsyncLoadRequest>& Request, EAsyncLoadPriority NewPriority);
+
+    /** 완료 콜백 추가. 이미 끝난 요청이면 즉시 호출 */
+    void AddCallback(const std::shared_ptr<FAsyncLoadRequest>& Request, std::function<void(UResourceBase*)> Callback);
+
+    /**
+     * 워커에서 준비가 끝난 요청을 우선순위 순으로 Finalize
+     * @param TimeBudgetMs 이 시간을 넘기면 남은 요청은 다음 프레임으로 (최소 1개는 처리)
+     * @return 처리한 요청 수
+     */
+    int32 ProcessCompleted(double TimeBudgetMs);
+
+    /** 요청 하나가 끝날 때까지 대기 */
+    void Wait(const std::shared_ptr<FAsyncLoadRequest>& Request);
+
+    /** 진행 중인 모든 요청을 끝까지 처리 (프리로드/레벨 로드 마무리) */
+    void Flush();
+
+    /** 진행 중인 요청을 모두 취소하고 올려둔 워커 작업이 끝날 때까지 대기 (셧다운). 콜백은 호출하지 않음 */
+    void CancelAll();
+
+    int32 GetNumInFlight() const { return static_cast<int32>(InFlightRequests.size()); }
+
+private:
+    static FString MakeKey(uint8 TypeIndex, const FString& Path);
+
+    /** 워커 작업 본체: 대기 중인 요청 중 가장 높은 우선순위 하나를 처리 */
+    void LoadNextPayload();
+    void RunPayload(const std::shared_ptr<FAsyncLoadRequest>& Request);
+    void FinalizeRequest(const std::shared_ptr<FAsyncLoadRequest>& Request);
+
+    /** Queued → Loading 선점. 워커/대기 스레드 중 하나만 성공 */
+    static bool TryClaim(FAsyncLoadRequest& Request);
+
+    // 게임 스레드 전용
+    TMap<FString, std::shared_ptr<FAsyncLoadRequest>> InFlightRequests;
+
+    // 워커 ↔ 게임 스레드 공유 (QueueLock 보호)
+    // 우선순위 승격 시 상위 큐에 한 번 더 넣으므로, 꺼낼 때 이미 선점된 항목은 건너뜀
+    std::mutex QueueLock;
+    TQueue<std::shared_ptr<FAsyncLoadRequest>> QueuedRequests[static_cast<int32>(EAsyncLoadPriority::Count)];
+    TArray<std::shared_ptr<FAsyncLoadRequest>> CompletedRequests[static_cast<int32>(EAsyncLoadPriority::Count)];
+
+    // FTaskGraph에 올려두고 아직 실행되지 않은 작업 수 (CancelAll이 이 값이 0이 될 때까지 대기)
+    std::atomic<int32> NumScheduledTasks{ 0 };
+};
+
+template<typename T>
+T* TAsyncLoadHandle<T>::Wait() const
+{
+    if (Request && Loader)
+    {
+        Loader->Wait(Request);
+    }
+    return Get();
+}
@@ -0,0 +1,570 @@
+﻿#include "pch.h"
+#include "CookedMeshData.h"
+#include "PackedVertex.h"
+#include "MeshBVH.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <cstring>
+
+namespace
+{
+    constexpr uint32 TagStaticVertices = CookedAsset::MakeTag('V', 'T', 'X', 'N');
+    constexpr uint32 TagSkinnedVertices = CookedAsset::MakeTag('V', 'T', 'X', 'S');
+    constexpr uint32 TagBones = CookedAsset::MakeTag('B', 'O', 'N', 'E');
+
+    // 압축 정점 포맷 (PackedVertex 설정에 따라 셋 중 하나만 기록)
+    constexpr uint32 TagPackedStaticVertices = CookedAsset::MakeTag('V', 'T', 'P', 'N');
+    constexpr uint32 TagPackedSkinnedVertices = CookedAsset::MakeTag('V', 'T', 'P', 'S');
+    constexpr uint32 TagQuantizedStaticVertices = CookedAsset::MakeTag('V', 'T', 'Q', 'N');
+    constexpr uint32 TagQuantizedSkinnedVertices = CookedAsset::MakeTag('V', 'T', 'Q', 'S');
+    constexpr uint32 TagPositionBounds = CookedAsset::MakeTag('Q', 'B', 'N', 'D');
+
+    // 자동 생성 LOD (모든 LOD의 인덱스/섹션을 각각 한 섹션에 이어서 기록)
+    constexpr uint32 TagLODs = CookedAsset::MakeTag('L', 'O', 'D', 'S');
+    constexpr uint32 TagLODIndices = CookedAsset::MakeTag('L', 'I', 'D', 'X');
+    constexpr uint32 TagLODSections = CookedAsset::MakeTag('L', 'S', 'E', 'C');
+
+    // 피킹용 메시 BVH (FMeshBVH 노드/삼각형 순서 그대로, 선택 섹션)
+    constexpr uint32 TagBVHMeta = CookedAsset::MakeTag('B', 'V', 'H', 'M');
+    constexpr uint32 TagBVHNodes = CookedAsset::MakeTag('B', 'V', 'H', 'N');
+    constexpr uint32 TagBVHTriangles = CookedAsset::MakeTag('B', 'V', 'H', 'T');
+
+    constexpr int32 DecodeGrainSize = 4096;
+
+    enum class ECookedVertexEncoding
+    {
+        Full,       // FNormalVertex / FSkinnedVertex 그대로
+        Packed,     // FPackedVertex / FPackedSkinnedVertex
+        Quantized,  // Packed + 위치를 바운드 기준 16비트로 양자화
+    };
+
+    ECookedVertexEncoding GetVertexEncoding()
+    {
+        if (!PackedVertex::IsEnabled())
+        {
+            return ECookedVertexEncoding::Full;
+        }
+        return PackedVertex::IsPositionQuantizationEnabled() ? ECookedVertexEncoding::Quantized : ECookedVertexEncoding::Packed;
+    }
+
+    /** FPackedVertex에서 위치만 양자화한 쿠킹 전용 정점 (24바이트) */
+    struct FCookedQuantizedVertex
+    {
+        uint16 Position[3];
+        uint16 Reserved;
+        uint32 Normal;
+        uint32 UV;
+        uint32 Tangent;
+        uint32 Color;
+    };
+
+    struct FCookedQuantizedSkinnedVertex
+    {
+        FCookedQuantizedVertex Base;
+        uint16 BoneIndices[4];
+        uint32 BoneWeights;
+    };
+
+    struct FCookedPositionBounds
+    {
+        FVector Min;
+        FVector Extent;
+    };
+
+    template<typename TVertex, typename TGetPosition>
+    FCookedPositionBounds ComputePositionBounds(const TArray<TVertex>& Vertices, TGetPosition GetPosition)
+    {
+        FVector Min(FLT_MAX, FLT_MAX, FLT_MAX);
+        FVector Max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for (const TVertex& Vertex : Vertices)
+        {
+            const FVector& Position = GetPosition(Vertex);
+            Min = FVector(std::min(Min.X, Position.X), std::min(Min.Y, Position.Y), std::min(Min.Z, Position.Z));
+            Max = FVector(std::max(Max.X, Position.X), std::max(Max.Y, Position.Y), std::max(Max.Z, Position.Z));
+        }
+        if (Vertices.empty())
+        {
+            return { FVector(0, 0, 0), FVector(0, 0, 0) };
+        }
+        return { Min, Max - Min };
+    }
+
+    FCookedQuantizedVertex QuantizeVertex(const FPackedVertex& Packed, const FCookedPositionBounds& Bounds)
+    {
+        FCookedQuantizedVertex Quantized{};
+        Quantized.Position[0] = PackedVertex::QuantizePosition(Packed.Position.X, Bounds.Min.X, Bounds.Extent.X);
+        Quantized.Position[1] = PackedVertex::QuantizePosition(Packed.Position.Y, Bounds.Min.Y, Bounds.Extent.Y);
+        Quantized.Position[2] = PackedVertex::QuantizePosition(Packed.Position.Z, Bounds.Min.Z, Bounds.Extent.Z);
+        Quantized.Normal = Packed.Normal;
+        Quantized.UV = Packed.UV;
+        Quantized.Tangent = Packed.Tangent;
+        Quantized.Color = Packed.Color;
+        return Quantized;
+    }
+
+    FPackedVertex DequantizeVertex(const FCookedQuantizedVertex& Quantized, const FCookedPositionBounds& Bounds)
+    {
+        FPackedVertex Packed;
+        Packed.Position = FVector(
+            PackedVertex::DequantizePosition(Quantized.Position[0], Bounds.Min.X, Bounds.Extent.X),
+            PackedVertex::DequantizePosition(Quantized.Position[1], Bounds.Min.Y, Bounds.Extent.Y),
+            PackedVertex::DequantizePosition(Quantized.Position[2], Bounds.Min.Z, Bounds.Extent.Z));
+        Packed.Normal = Quantized.Normal;
+        Packed.UV = Quantized.UV;
+        Packed.Tangent = Quantized.Tangent;
+        Packed.Color = Quantized.Color;
+        return Packed;
+    }
+
+    /** 양자화 후 복원한 위치의 최대 오차를 허용치(축마다 Extent / 131070 + float 오차)와 함께 로그 */
+    void LogQuantizationError(const FString& AssetPath, const FCookedPositionBounds& Bounds, float MaxError)
+    {
+        const float MaxExtent = std::max({ Bounds.Extent.X, Bounds.Extent.Y, Bounds.Extent.Z });
+        const float Tolerance = MaxExtent / 131070.0f + MaxExtent * 1e-6f;
+        UE_LOG("[CookedMesh] '%s': quantized positions, max error %.6f (tolerance %.6f)%s",
+            AssetPath.c_str(), MaxError, Tolerance, MaxError > Tolerance ? " - EXCEEDED" : "");
+    }
+
+    float PositionError(const FVector& A, const FVector& B)
+    {
+        return std::max({ std::abs(A.X - B.X), std::abs(A.Y - B.Y), std::abs(A.Z - B.Z) });
+    }
+
+    void AddStaticVertices(FCookedAssetWriter& Writer, const FStaticMesh& Mesh)
+    {
+        const ECookedVertexEncoding Encoding = GetVertexEncoding();
+        if (Encoding == ECookedVertexEncoding::Full)
+        {
+            Writer.AddArray(TagStaticVertices, Mesh.Vertices);
+            return;
+        }
+
+        TArray<FPackedVertex> Packed(Mesh.Vertices.size());
+        ParallelFor(static_cast<int32>(Packed.size()), [&](int32 i)
+        {
+            Packed[i].FillFrom(Mesh.Vertices[i]);
+        }, DecodeGrainSize);
+
+        if (Encoding == ECookedVertexEncoding::Packed)
+        {
+            Writer.AddArray(TagPackedStaticVertices, Packed);
+            return;
+        }
+
+        const FCookedPositionBounds Bounds = ComputePositionBounds(Mesh.Vertices, [](const FNormalVertex& V) -> const FVector& { return V.pos; });
+        TArray<FCookedQuantizedVertex> Quantized(Packed.size());
+        float MaxError = 0.0f;
+        for (size_t i = 0; i < Packed.size(); ++i)
+        {
+            Quantized[i] = QuantizeVertex(Packed[i], Bounds);
+            MaxError = std::max(MaxError, PositionError(DequantizeVertex(Quantized[i], Bounds).Position, Mesh.Vertices[i].pos));
+        }
+        LogQuantizationError(Mesh.PathFileName, Bounds, MaxError);
+
+        Writer.AddStruct(TagPositionBounds, Bounds);
+        Writer.AddArray(TagQuantizedStaticVertices, Quantized);
+    }
+
+    /** 현재 설정과 다른 인코딩으로 쿠킹된 파일이면 false (호출부에서 재생성) */
+    bool ReadStaticVertices(const FCookedAssetFile& File, TArray<FNormalVertex>& OutVertices)
+    {
+        switch (GetVertexEncoding())
+        {
+        case ECookedVertexEncoding::Full:
+            return File.ReadArray(TagStaticVertices, OutVertices);
+
+        case ECookedVertexEncoding::Packed:
+        {
+            TCookedArrayView<FPackedVertex> Packed;
+            if (!File.GetArray(TagPackedStaticVertices, Packed))
+            {
+                return false;
+            }
+            OutVertices.resize(Packed.Num());
+            ParallelFor(Packed.Num(), [&](int32 i) { OutVertices[i] = Packed[i].Decode(); }, DecodeGrainSize);
+            return true;
+        }
+
+        case ECookedVertexEncoding::Quantized:
+        {
+            FCookedPositionBounds Bounds{};
+            TCookedArrayView<FCookedQuantizedVertex> Quantized;
+            if (!File.ReadStruct(TagPositionBounds, Bounds) || !File.GetArray(TagQuantizedStaticVertices, Quantized))
+            {
+                return false;
+            }
+            OutVertices.resize(Quantized.Num());
+            ParallelFor(Quantized.Num(), [&](int32 i) { OutVertices[i] = DequantizeVertex(Quantized[i], Bounds).Decode(); }, DecodeGrainSize);
+            return true;
+        }
+        }
+        return false;
+    }
+
+    void AddSkinnedVertices(FCookedAssetWriter& Writer, const FSkeletalMeshData& MeshData)
+    {
+        const ECookedVertexEncoding Encoding = GetVertexEncoding();
+        if (Encoding == ECookedVertexEncoding::Full)
+        {
+            Writer.AddArray(TagSkinnedVertices, MeshData.Vertices);
+            return;
+        }
+
+        TArray<FPackedSkinnedVertex> Packed(MeshData.Vertices.size());
+        ParallelFor(static_cast<int32>(Packed.size()), [&](int32 i)
+        {
+            Packed[i].FillFrom(MeshData.Vertices[i]);
+        }, DecodeGrainSize);
+
+        if (Encoding == ECookedVertexEncoding::Packed)
+        {
+            Writer.AddArray(TagPackedSkinnedVertices, Packed);
+            return;
+        }
+
+        const FCookedPositionBounds Bounds = ComputePositionBounds(MeshData.Vertices, [](const FSkinnedVertex& V) -> const FVector& { return V.Position; });
+        TArray<FCookedQuantizedSkinnedVertex> Quantized(Packed.size());
+        float MaxError = 0.0f;
+        for (size_t i = 0; i < Packed.size(); ++i)
+        {
+            Quantized[i].Base = QuantizeVertex(Packed[i].Base, Bounds);
+            std::memcpy(Quantized[i].BoneIndices, Packed[i].BoneIndices, sizeof(Quantized[i].BoneIndices));
+            Quantized[i].BoneWeights = Packed[i].BoneWeights;
+            MaxError = std::max(MaxError, PositionError(DequantizeVertex(Quantized[i].Base, Bounds).Position, MeshData.Vertices[i].Position));
+        }
+        LogQuantizationError(MeshData.PathFileName, Bounds, MaxError);
+
+        Writer.AddStruct(TagPositionBounds, Bounds);
+        Writer.AddArray(TagQuantizedSkinnedVertices, Quantized);
+    }
+
+    bool ReadSkinnedVertices(const FCookedAssetFile& File, TArray<FSkinnedVertex>& OutVertices)
+    {
+        switch (GetVertexEncoding())
+        {
+        case ECookedVertexEncoding::Full:
+            return File.ReadArray(TagSkinnedVertices, OutVertices);
+
+        case ECookedVertexEncoding::Packed:
+        {
+            TCookedArrayView<FPackedSkinnedVertex> Packed;
+            if (!File.GetArray(TagPackedSkinnedVertices, Packed))
+            {
+                return false;
+            }
+            OutVertices.resize(Packed.Num());
+            ParallelFor(Packed.Num(), [&](int32 i) { OutVertices[i] = Packed[i].Decode(); }, DecodeGrainSize);
+            return true;
+        }
+
+        case ECookedVertexEncoding::Quantized:
+        {
+            FCookedPositionBounds Bounds{};
+            TCookedArrayView<FCookedQuantizedSkinnedVertex> Quantized;
+            if (!File.ReadStruct(TagPositionBounds, Bounds) || !File.GetArray(TagQuantizedSkinnedVertices, Quantized))
+            {
+                return false;
+            }
+            OutVertices.resize(Quantized.Num());
+            ParallelFor(Quantized.Num(), [&](int32 i)
+            {
+                FPackedSkinnedVertex Packed;
+                Packed.Base = DequantizeVertex(Quantized[i].Base, Bounds);
+                std::memcpy(Packed.BoneIndices, Quantized[i].BoneIndices, sizeof(Packed.BoneIndices));
+                Packed.BoneWeights = Quantized[i].BoneWeights;
+                OutVertices[i] = Packed.Decode();
+            }, DecodeGrainSize);
+            return true;
+        }
+        }
+        return false;
+    }
+
+    struct FCookedGroupInfo
+    {
+        uint32 StartIndex;
+        uint32 IndexCount;
+        FCookedStringRef InitialMaterialName;
+    };
+
+    struct FCookedStaticMeshMeta
+    {
+        FCookedStringRef PathFileName;
+        uint32 bHasMaterial;
+        uint32 Reserved;
+    };
+
+    struct FCookedSkeletalMeshMeta
+    {
+        FCookedStringRef SkeletonName;
+        uint32 bHasMaterial;
+        uint32 Reserved;
+    };
+
+    struct FCookedBone
+    {
+        FCookedStringRef Name;
+        int32 ParentIndex;
+        uint32 Reserved;
+        FMatrix BindPose;
+        FMatrix InverseBindPose;
+    };
+
+    struct FCookedMeshLOD
+    {
+        uint32 FirstIndex;
+        uint32 NumIndices;
+        uint32 FirstSection;
+        uint32 NumSections;
+        float RelativeError;
+        uint32 Reserved;
+    };
+
+    void AddLODs(FCookedAssetWriter& Writer, const TArray<FMeshLOD>& LODs)
+    {
+        TArray<FCookedMeshLOD> CookedLODs;
+        TArray<uint32> Indices;
+        TArray<FMeshLODSection> Sections;
+        for (const FMeshLOD& LOD : LODs)
+        {
+            FCookedMeshLOD& Cooked = CookedLODs.emplace_back();
+            Cooked.FirstIndex = static_cast<uint32>(Indices.size());
+            Cooked.NumIndices = static_cast<uint32>(LOD.Indices.size());
+            Cooked.FirstSection = static_cast<uint32>(Sections.size());
+            Cooked.NumSections = static_cast<uint32>(LOD.Sections.size());
+            Cooked.RelativeError = LOD.RelativeError;
+            Cooked.Reserved = 0;
+            Indices.insert(Indices.end(), LOD.Indices.begin(), LOD.Indices.end());
+            Sections.insert(Sections.end(), LOD.Sections.begin(), LOD.Sections.end());
+        }
+        Writer.AddArray(TagLODs, CookedLODs);
+        Writer.AddArray(TagLODIndices, Indices);
+        Writer.AddArray(TagLODSections, Sections);
+    }
+
+    /** 범위가 어긋난 LOD는 캐시 손상으로 보고 false */
+    bool ReadLODs(const FCookedAssetFile& File, uint32 NumVertices, TArray<FMeshLOD>& OutLODs)
+    {
+        TCookedArrayView<FCookedMeshLOD> CookedLODs;
+        TCookedArrayView<uint32> Indices;
+        TCookedArrayView<FMeshLODSection> Sections;
+        if (!File.GetArray(TagLODs, CookedLODs) || !File.GetArray(TagLODIndices, Indices) || !File.GetArray(TagLODSections, Sections))
+        {
+            return false;
+        }
+
+        OutLODs.resize(CookedLODs.Num());
+        for (int32 i = 0; i < CookedLODs.Num(); ++i)
+        {
+            const FCookedMeshLOD& Cooked = CookedLODs[i];
+            if (static_cast<uint64>(Cooked.FirstIndex) + Cooked.NumIndices > static_cast<uint64>(Indices.Num())
+                || static_cast<uint64>(Cooked.FirstSection) + Cooked.NumSections > static_cast<uint64>(Sections.Num()))
+            {
+                return false;
+            }
+
+            FMeshLOD& LOD = OutLODs[i];
+            LOD.Indices.assign(Indices.begin() + Cooked.FirstIndex, Indices.begin() + Cooked.FirstIndex + Cooked.NumIndices);
+            LOD.Sections.assign(Sections.begin() + Cooked.FirstSection, Sections.begin() + Cooked.FirstSection + Cooked.NumSections);
+            LOD.RelativeError = Cooked.RelativeError;
+
+            for (const FMeshLODSection& Section : LOD.Sections)
+            {
+                if (static_cast<uint64>(Section.StartIndex) + Section.IndexCount > LOD.Indices.size())
+                {
+                    return false;
+                }
+            }
+            for (uint32 Index : LOD.Indices)
+            {
+                if (Index >= NumVertices)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    struct FCookedMeshBVHMeta
+    {
+        uint32 Version;
+        uint32 NumTriangles;
+        uint32 NumNodes;
+        uint32 Reserved;
+    };
+
+    void AddMeshBVH(FCookedAssetWriter& Writer, const FMeshBVH* BVH, uint32 NumTriangles)
+    {
+        if (!BVH || BVH->IsEmpty())
+        {
+            return;
+        }
+
+        FCookedMeshBVHMeta Meta{};
+        Meta.Version = FMeshBVH::CookVersion;
+        Meta.NumTriangles = NumTriangles;
+        Meta.NumNodes = BVH->GetNumNodes();
+        Writer.AddStruct(TagBVHMeta, Meta);
+        Writer.AddArray(TagBVHNodes, BVH->GetNodes());
+        Writer.AddArray(TagBVHTriangles, BVH->GetTriIndices());
+    }
+
+    /** 섹션이 없거나 빌더 버전/삼각형 수가 다르거나 손상되었으면 nullptr (메시 자체는 정상 로드, 호출부에서 다시 빌드) */
+    std::shared_ptr<FMeshBVH> ReadMeshBVH(const FCookedAssetFile& File, uint32 NumTriangles)
+    {
+        FCookedMeshBVHMeta Meta{};
+        TArray<FMeshBVHNode> Nodes;
+        TArray<uint32> TriIndices;
+        if (!File.ReadStruct(TagBVHMeta, Meta) || Meta.Version != FMeshBVH::CookVersion || Meta.NumTriangles != NumTriangles
+            || !File.ReadArray(TagBVHNodes, Nodes) || !File.ReadArray(TagBVHTriangles, TriIndices))
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<FMeshBVH> BVH = std::make_shared<FMeshBVH>();
+        if (!BVH->InitFromCooked(std::move(Nodes), std::move(TriIndices), NumTriangles))
+        {
+            return nullptr;
+        }
+        return BVH;
+    }
+
+    void AddGroups(FCookedAssetWriter& Writer, const TArray<FGroupInfo>& GroupInfos)
+    {
+        TArray<FCookedGroupInfo> Groups;
+        Groups.reserve(GroupInfos.size());
+        for (const FGroupInfo& Group : GroupInfos)
+        {
+            Groups.push_back({ Group.StartIndex, Group.IndexCount, Writer.AddString(Group.InitialMaterialName) });
+        }
+        Writer.AddArray(CookedAsset::TagGroups, Groups);
+    }
+
+    bool ReadGroups(const FCookedAssetFile& File, TArray<FGroupInfo>& OutGroupInfos)
+    {
+        TCookedArrayView<FCookedGroupInfo> Groups;
+        if (!File.GetArray(CookedAsset::TagGroups, Groups))
+        {
+            return false;
+        }
+
+        OutGroupInfos.resize(Groups.Num());
+        for (int32 i = 0; i < Groups.Num(); ++i)
+        {
+            OutGroupInfos[i].StartIndex = Groups[i].StartIndex;
+            OutGroupInfos[i].IndexCount = Groups[i].IndexCount;
+            OutGroupInfos[i].InitialMaterialName = File.GetString(Groups[i].InitialMaterialName);
+        }
+        return true;
+    }
+}
+
+bool CookedMeshData::SaveStaticMesh(const FStaticMesh& Mesh, const FString& CookedPath)
+{
+    FCookedAssetWriter Writer(ECookedAssetType::StaticMesh);
+
+    FCookedStaticMeshMeta Meta{};
+    Meta.PathFileName = Writer.AddString(Mesh.PathFileName);
+    Meta.bHasMaterial = Mesh.bHasMaterial ? 1 : 0;
+    Writer.AddStruct(CookedAsset::TagMeta, Meta);
+
+    AddStaticVertices(Writer, Mesh);
+    Writer.AddArray(CookedAsset::TagIndices, Mesh.Indices);
+    AddGroups(Writer, Mesh.GroupInfos);
+    AddLODs(Writer, Mesh.LODs);
+    AddMeshBVH(Writer, Mesh.MeshBVH.get(), static_cast<uint32>(Mesh.Indices.size() / 3));
+
+    return Writer.Save(CookedPath);
+}
+
+bool CookedMeshData::LoadStaticMesh(const FString& CookedPath, FStaticMesh& OutMesh)
+{
+    FCookedAssetFile File;
+    if (!File.Open(CookedPath, ECookedAssetType::StaticMesh))
+    {
+        return false;
+    }
+
+    FCookedStaticMeshMeta Meta{};
+    if (!File.ReadStruct(CookedAsset::TagMeta, Meta)
+        || !ReadStaticVertices(File, OutMesh.Vertices)
+        || !File.ReadArray(CookedAsset::TagIndices, OutMesh.Indices)
+        || !ReadGroups(File, OutMesh.GroupInfos)
+        || !ReadLODs(File, static_cast<uint32>(OutMesh.Vertices.size()), OutMesh.LODs))
+    {
+        return false;
+    }
+
+    OutMesh.PathFileName = File.GetString(Meta.PathFileName);
+    OutMesh.bHasMaterial = Meta.bHasMaterial != 0;
+    OutMesh.MeshBVH = ReadMeshBVH(File, static_cast<uint32>(OutMesh.Indices.size() / 3));
+    return true;
+}
+
+bool CookedMeshData::SaveSkeletalMesh(const FSkeletalMeshData& MeshData, const FString& CookedPath)
+{
+    FCookedAssetWriter Writer(ECookedAssetType::SkeletalMesh);
+
+    FCookedSkeletalMeshMeta Meta{};
+    Meta.SkeletonName = Writer.AddString(MeshData.Skeleton.Name);
+    Meta.bHasMaterial = MeshData.bHasMaterial ? 1 : 0;
+    Writer.AddStruct(CookedAsset::TagMeta, Meta);
+
+    AddSkinnedVertices(Writer, MeshData);
+    Writer.AddArray(CookedAsset::TagIndices, MeshData.Indices);
+    AddGroups(Writer, MeshData.GroupInfos);
+    AddLODs(Writer, MeshData.LODs);
+
+    TArray<FCookedBone> Bones;
+    Bones.reserve(MeshData.Skeleton.Bones.size());
+    for (const FBone& Bone : MeshData.Skeleton.Bones)
+    {
+        FCookedBone& Cooked = Bones.emplace_back();
+        Cooked.Name = Writer.AddString(Bone.Name);
+        Cooked.ParentIndex = Bone.ParentIndex;
+        Cooked.Reserved = 0;
+        Cooked.BindPose = Bone.BindPose;
+        Cooked.InverseBindPose = Bone.InverseBindPose;
+    }
+    Writer.AddArray(TagBones, Bones);
+
+    return Writer.Save(CookedPath);
+}
+
+bool CookedMeshData::LoadSkeletalMesh(const FString& CookedPath, FSkeletalMeshData& OutMeshData)
+{
+    FCookedAssetFile File;
+    if (!File.Open(CookedPath, ECookedAssetType::SkeletalMesh))
+    {
+        return false;
+    }
+
+    FCookedSkeletalMeshMeta Meta{};
+    TCookedArrayView<FCookedBone> Bones;
+    if (!File.ReadStruct(CookedAsset::TagMeta, Meta)
+        || !ReadSkinnedVertices(File, OutMeshData.Vertices)
+        || !File.ReadArray(CookedAsset::TagIndices, OutMeshData.Indices)
+        || !ReadGroups(File, OutMeshData.GroupInfos)
+        || !ReadLODs(File, static_cast<uint32>(OutMeshData.Vertices.size()), OutMeshData.LODs)
+        || !File.GetArray(TagBones, Bones))
+    {
+        return false;
+    }
+
+    OutMeshData.bHasMaterial = Meta.bHasMaterial != 0;
+
+    FSkeleton& Skeleton = OutMeshData.Skeleton;
+    Skeleton.Name = File.GetString(Meta.SkeletonName);
+    Skeleton.Bones.resize(Bones.Num());
+    Skeleton.BoneNameToIndex.clear();
+    for (int32 i = 0; i < Bones.Num(); ++i)
+    {
+        FBone& Bone = Skeleton.Bones[i];
+        Bone.Name = File.GetString(Bones[i].Name);
+        Bone.ParentIndex = Bones[i].ParentIndex;
+        Bone.BindPose = Bones[i].BindPose;
+        Bone.InverseBindPose = Bones[i].InverseBindPose;
+        Skeleton.BoneNameToIndex[Bone.Name] = i;
+    }
+    return true;
+}
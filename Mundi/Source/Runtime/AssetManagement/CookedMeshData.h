@@ -0,0 +1,24 @@
+﻿#pragma once
+#include "CookedAsset.h"
+
+struct FStaticMesh;
+struct FSkeletalMeshData;
+
+/**
+ * 메시 데이터 <-> 쿠킹 컨테이너(.cooked) 변환
+ * - 정점/인덱스는 런타임 구조체(FNormalVertex, FSkinnedVertex) 레이아웃 그대로 한 섹션에 기록
+ * - 압축 정점 포맷(PackedVertex)이 켜져 있으면 FPackedVertex 레이아웃(선택적으로 16비트 양자화 위치)으로 기록하고
+ *   로드 시 float 정점으로 복원 → 설정과 다른 인코딩의 캐시는 로드 실패로 처리해 재생성
+ * - 본/그룹은 고정 크기 레코드 + 문자열 테이블로 기록해 로드 시 스트림 읽기 없이 한 번에 복원
+ * - 자동 LOD(FMeshLOD)는 LOD 레코드/인덱스/섹션 세 섹션에 모든 LOD를 이어서 기록
+ * - 스태틱 메시의 BVH(FMeshBVH)는 노드/삼각형 순서를 그대로 기록, 없거나 버전이 다르면 MeshBVH만 비운 채 로드 성공
+ */
+namespace CookedMeshData
+{
+    bool SaveStaticMesh(const FStaticMesh& Mesh, const FString& CookedPath);
+    /** 파일이 없거나, 버전/레이아웃이 다르거나, 손상되었으면 false (호출부에서 재생성) */
+    bool LoadStaticMesh(const FString& CookedPath, FStaticMesh& OutMesh);
+
+    bool SaveSkeletalMesh(const FSkeletalMeshData& MeshData, const FString& CookedPath);
+    bool LoadSkeletalMesh(const FString& CookedPath, FSkeletalMeshData& OutMeshData);
+}
@@ -1,5 +1,6 @@
 ﻿#include "pch.h"
 #include "MeshLoader.h"
+#include "ObjParser.h"
 
 IMPLEMENT_CLASS(UMeshLoader)
 
@@ -13,24 +14,23 @@ UMeshLoader& UMeshLoader::GetInstance()
     return *Instance;
 }
 
-UMeshLoader::FFace UMeshLoader::ParseFaceBuffer(const FString& FaceBuffer)
+const char* UMeshLoader::ParseFaceBuffer(const char* Begin, const char* End, FFace& OutFace)
 {
-    FFace Face = {};
-    std::istringstream Tokenizer(FaceBuffer);
-    FString IndexBuffer;
+    OutFace = {};
+    int32 Index = 0;
 
     // v (항상 존재)
-    if (std::getline(Tokenizer, IndexBuffer, '/'))
-        Face.IndexPosition = std::stoi(IndexBuffer);
+    const char* P = ObjParser::ParseInt(Begin, End, Index);
+    OutFace.IndexPosition = Index;
 
     // vt (항상 존재)
-    if (std::getline(Tokenizer, IndexBuffer, '/'))
+    if (P < End && *P == '/')
     {
-        if (!IndexBuffer.empty())
-            Face.IndexTexCoord = std::stoi(IndexBuffer);
+        P = ObjParser::ParseInt(P + 1, End, Index);
+        OutFace.IndexTexCoord = Index;
     }
 
-    return Face;
+    return ObjParser::SkipToken(P, End);
 }
 
 UMeshLoader::~UMeshLoader()
@@ -53,11 +53,9 @@ FMeshData* UMeshLoader::LoadMesh(const std::filesystem::path& FilePath)
         return it->second;
     }
 
-    if (!std::filesystem::exists(FilePath))
-        return nullptr;
-
-    std::ifstream File(FilePath);
-    if (!File)
+    // 메모리 맵으로 읽고 줄/토큰은 포인터로 직접 파싱 (stringstream 없음)
+    ObjParser::FMappedFile File;
+    if (!File.Open(WideToUTF8(FilePath.wstring())))
         return nullptr;
 
     TArray<FPosition> Positions;
@@ -65,48 +63,48 @@ FMeshData* UMeshLoader::LoadMesh(const std::filesystem::path& FilePath)
     TArray<FTexCoord> TexCoords;
     TArray<FFace> Faces;
 
-    FString Line;
-    while (std::getline(File, Line))
+    const char* const End = File.GetData() + File.GetSize();
+    for (const char* Line = File.GetData(); Line < End; )
     {
-        std::istringstream Tokenizer(Line);
+        const char* LineEnd = ObjParser::NextLine(Line, End);
+        const char* Prefix = ObjParser::SkipBlanks(Line, LineEnd);
+        const char* Tokenizer = ObjParser::SkipToken(Prefix, LineEnd);
+        const std::string_view PrefixView(Prefix, Tokenizer - Prefix);
 
-        FString Prefix;
-        Tokenizer >> Prefix;
-
-        if (Prefix == "v") // position
+        if (PrefixView == "v") // position
         {
             FPosition Position;
-            Tokenizer >> Position.x >> Position.y >> Position.z;
+            Tokenizer = ObjParser::ParseFloat(Tokenizer, LineEnd, Position.x);
+            Tokenizer = ObjParser::ParseFloat(Tokenizer, LineEnd, Position.y);
+            ObjParser::ParseFloat(Tokenizer, LineEnd, Position.z);
             Positions.push_back(Position);
         }
-        else if (Prefix == "vn") // normal
+        else if (PrefixView == "vn") // normal
         {
             FNormal Normal;
-            Tokenizer >> Normal.x >> Normal.y >> Normal.z;
+            Tokenizer = ObjParser::ParseFloat(Tokenizer, LineEnd, Normal.x);
+            Tokenizer = ObjParser::ParseFloat(Tokenizer, LineEnd, Normal.y);
+            ObjParser::ParseFloat(Tokenizer, LineEnd, Normal.z);
             Normals.push_back(Normal);
         }
-        else if (Prefix == "vt") // uv
+        else if (PrefixView == "vt") // uv
         {
             FTexCoord TexCoord;
-            Tokenizer >> TexCoord.u >> TexCoord.v;
+            Tokenizer = ObjParser::ParseFloat(Tokenizer, LineEnd, TexCoord.u);
+            ObjParser::ParseFloat(Tokenizer, LineEnd, TexCoord.v);
             TexCoords.push_back(TexCoord);
         }
-        else if (Prefix == "f") // face
-        {
-            FString FaceBuffer;
-            while (Tokenizer >> FaceBuffer)
-            {
-                Faces.push_back(ParseFaceBuffer(FaceBuffer));
-            }
-        }
-        else if (Prefix == "l") // line (바운딩박스 OBJ용)
+        else if (PrefixView == "f" || PrefixView == "l") // face, line (바운딩박스 OBJ용)
         {
-            FString LineBuffer;
-            while (Tokenizer >> LineBuffer)
+            for (Tokenizer = ObjParser::SkipBlanks(Tokenizer, LineEnd); Tokenizer < LineEnd && *Tokenizer != '\n'; Tokenizer = ObjParser::SkipBlanks(Tokenizer, LineEnd))
             {
-                Faces.push_back(ParseFaceBuffer(LineBuffer));
+                FFace Face;
+                Tokenizer = ParseFaceBuffer(Tokenizer, LineEnd, Face);
+                Faces.push_back(Face);
             }
         }
+
+        Line = LineEnd;
     }
     FMeshData* MeshData = new FMeshData();
     TMap<FVertexKey, uint32> UniqueVertexMap;
@@ -80,6 +80,7 @@ private:
         size_t IndexTexCoord;
     };
 
-    static FFace ParseFaceBuffer(const FString& FaceBuffer);
+    /** "v/vt/vn" 토큰 하나를 파싱하고 토큰 끝을 반환 */
+    static const char* ParseFaceBuffer(const char* Begin, const char* End, FFace& OutFace);
     TMap<FString, FMeshData*> MeshCache;
 };
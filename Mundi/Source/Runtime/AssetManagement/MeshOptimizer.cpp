@@ -0,0 +1,496 @@
+﻿#include "pch.h"
+#include "MeshOptimizer.h"
+
+namespace
+{
+    constexpr uint32 MaxCacheSize = 64;
+    constexpr uint32 MaxValence = 32;
+
+    /**
+     * FIFO 캐시 시뮬레이터
+     * 미스가 날 때만 타임스탬프를 올리므로 "마지막 적재 이후 미스 수 <= CacheSize"이면 캐시에 남아 있음
+     */
+    struct FFifoCache
+    {
+        FFifoCache(uint32 NumVertices, uint32 InCacheSize)
+            : CacheTime(NumVertices, 0)
+            , CacheSize(InCacheSize)
+            , Timestamp(InCacheSize + 1)
+        {
+        }
+
+        uint32 Access(uint32 Vertex)
+        {
+            if (Timestamp - CacheTime[Vertex] > CacheSize)
+            {
+                CacheTime[Vertex] = Timestamp++;
+                return 1;
+            }
+            return 0;
+        }
+
+        uint32 AccessTriangle(const uint32* Tri)
+        {
+            return Access(Tri[0]) + Access(Tri[1]) + Access(Tri[2]);
+        }
+
+        /** 모든 정점을 캐시 밖으로 밀어냄 */
+        void Reset()
+        {
+            Timestamp += CacheSize + 1;
+        }
+
+        TArray<uint32> CacheTime;
+        uint32 CacheSize;
+        uint32 Timestamp;
+    };
+
+    /** Forsyth, "Linear-Speed Vertex Cache Optimisation" 점수표 */
+    struct FForsythScores
+    {
+        explicit FForsythScores(uint32 CacheSize)
+        {
+            constexpr float CacheDecayPower = 1.5f;
+            constexpr float LastTriScore = 0.75f;
+            constexpr float ValenceBoostScale = 2.0f;
+            constexpr float ValenceBoostPower = 0.5f;
+
+            for (uint32 i = 0; i < MaxCacheSize; ++i)
+            {
+                if (i >= CacheSize)
+                {
+                    Cache[i] = 0.0f;
+                }
+                else if (i < 3)
+                {
+                    // 방금 쓴 삼각형의 정점은 일부러 낮게 (같은 삼각형 주변만 맴도는 것 방지)
+                    Cache[i] = LastTriScore;
+                }
+                else
+                {
+                    const float Scaler = 1.0f / static_cast<float>(CacheSize - 3);
+                    Cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * Scaler, CacheDecayPower);
+                }
+            }
+
+            Valence[0] = 0.0f;
+            for (uint32 i = 1; i < MaxValence; ++i)
+            {
+                Valence[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+            }
+        }
+
+        float Get(int32 CachePosition, uint32 LiveTriangles) const
+        {
+            if (LiveTriangles == 0)
+            {
+                return -1.0f;
+            }
+            const float CacheScore = CachePosition >= 0 ? Cache[CachePosition] : 0.0f;
+            return CacheScore + Valence[std::min(LiveTriangles, MaxValence - 1)];
+        }
+
+        float Cache[MaxCacheSize];
+        float Valence[MaxValence];
+    };
+}
+
+MeshOptimizer::FVertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32* Indices, uint32 NumIndices, uint32 NumVertices, uint32 CacheSize)
+{
+    FVertexCacheStats Stats;
+    Stats.NumTriangles = NumIndices / 3;
+    if (Stats.NumTriangles == 0 || NumVertices == 0)
+    {
+        return Stats;
+    }
+
+    FFifoCache Cache(NumVertices, CacheSize);
+    TArray<uint8> Referenced(NumVertices, 0);
+    for (uint32 i = 0; i < Stats.NumTriangles * 3; ++i)
+    {
+        const uint32 Vertex = Indices[i];
+        if (Vertex >= NumVertices)
+        {
+            continue;
+        }
+        Stats.NumCacheMisses += Cache.Access(Vertex);
+        if (!Referenced[Vertex])
+        {
+            Referenced[Vertex] = 1;
+            ++Stats.NumVertices;
+        }
+    }
+
+    Stats.ACMR = static_cast<float>(Stats.NumCacheMisses) / static_cast<float>(Stats.NumTriangles);
+    Stats.ATVR = Stats.NumVertices > 0 ? static_cast<float>(Stats.NumCacheMisses) / static_cast<float>(Stats.NumVertices) : 0.0f;
+    return Stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint32* Indices, uint32 NumIndices, uint32 NumVertices, uint32 CacheSize)
+{
+    const uint32 NumTriangles = NumIndices / 3;
+    if (NumTriangles < 2 || NumVertices == 0)
+    {
+        return;
+    }
+
+    CacheSize = std::clamp(CacheSize, 4u, MaxCacheSize - 3);
+    const FForsythScores Scores(CacheSize);
+
+    // 1) 정점 → 삼각형 인접 리스트 (CSR)
+    TArray<uint32> LiveTriangles(NumVertices, 0);
+    for (uint32 i = 0; i < NumTriangles * 3; ++i)
+    {
+        ++LiveTriangles[Indices[i]];
+    }
+
+    TArray<uint32> AdjacencyOffsets(NumVertices + 1, 0);
+    for (uint32 v = 0; v < NumVertices; ++v)
+    {
+        AdjacencyOffsets[v + 1] = AdjacencyOffsets[v] + LiveTriangles[v];
+    }
+
+    TArray<uint32> Adjacency(NumTriangles * 3);
+    {
+        TArray<uint32> Cursor(AdjacencyOffsets.begin(), AdjacencyOffsets.end() - 1);
+        for (uint32 Tri = 0; Tri < NumTriangles; ++Tri)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                Adjacency[Cursor[Indices[Tri * 3 + k]]++] = Tri;
+            }
+        }
+    }
+
+    // 2) 초기 점수
+    TArray<int32> CachePosition(NumVertices, -1);
+    TArray<float> VertexScore(NumVertices);
+    for (uint32 v = 0; v < NumVertices; ++v)
+    {
+        VertexScore[v] = Scores.Get(-1, LiveTriangles[v]);
+    }
+
+    TArray<uint8> TriangleEmitted(NumTriangles, 0);
+    uint32 BestTriangle = 0;
+    float BestInitialScore = -1.0f;
+    for (uint32 Tri = 0; Tri < NumTriangles; ++Tri)
+    {
+        const uint32* T = Indices + Tri * 3;
+        const float Score = VertexScore[T[0]] + VertexScore[T[1]] + VertexScore[T[2]];
+        if (Score > BestInitialScore)
+        {
+            BestInitialScore = Score;
+            BestTriangle = Tri;
+        }
+    }
+
+    // 3) 점수가 가장 높은 삼각형을 하나씩 출력
+    TArray<uint32> Output(NumTriangles * 3);
+    uint32 Cache[MaxCacheSize + 3];
+    uint32 CacheCount = 0;
+    uint32 NextUnemitted = 0;
+    bool bHasBest = true;
+
+    for (uint32 OutTri = 0; OutTri < NumTriangles; ++OutTri)
+    {
+        if (!bHasBest)
+        {
+            // 캐시 주변에 남은 삼각형이 없으면 아직 안 쓴 삼각형 중 원래 순서대로 다음 것
+            while (TriangleEmitted[NextUnemitted])
+            {
+                ++NextUnemitted;
+            }
+            BestTriangle = NextUnemitted;
+        }
+
+        const uint32 Tri = BestTriangle;
+        const uint32* T = Indices + Tri * 3;
+        TriangleEmitted[Tri] = 1;
+        Output[OutTri * 3 + 0] = T[0];
+        Output[OutTri * 3 + 1] = T[1];
+        Output[OutTri * 3 + 2] = T[2];
+
+        // 인접 리스트에서 이 삼각형 제거 (살아 있는 삼각형은 앞쪽 LiveTriangles개)
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            const uint32 Vertex = T[k];
+            uint32* List = Adjacency.data() + AdjacencyOffsets[Vertex];
+            const uint32 Count = LiveTriangles[Vertex];
+            for (uint32 i = 0; i < Count; ++i)
+            {
+                if (List[i] == Tri)
+                {
+                    List[i] = List[Count - 1];
+                    break;
+                }
+            }
+            --LiveTriangles[Vertex];
+        }
+
+        // 새 캐시 = 이 삼각형의 정점 + 기존 캐시 (CacheSize를 넘는 3개는 점수 갱신용으로만 유지)
+        uint32 NewCache[MaxCacheSize + 3];
+        uint32 NewCount = 0;
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            if (std::find(NewCache, NewCache + NewCount, T[k]) == NewCache + NewCount)
+            {
+                NewCache[NewCount++] = T[k];
+            }
+        }
+        for (uint32 i = 0; i < CacheCount && NewCount < CacheSize + 3; ++i)
+        {
+            if (Cache[i] != T[0] && Cache[i] != T[1] && Cache[i] != T[2])
+            {
+                NewCache[NewCount++] = Cache[i];
+            }
+        }
+
+        for (uint32 i = 0; i < NewCount; ++i)
+        {
+            const uint32 Vertex = NewCache[i];
+            CachePosition[Vertex] = i < CacheSize ? static_cast<int32>(i) : -1;
+            VertexScore[Vertex] = Scores.Get(CachePosition[Vertex], LiveTriangles[Vertex]);
+        }
+
+        // 캐시에 닿아 있는 삼각형만 점수 갱신 후 최고점 선택
+        float BestScore = -1.0f;
+        bHasBest = false;
+        for (uint32 i = 0; i < NewCount; ++i)
+        {
+            const uint32 Vertex = NewCache[i];
+            const uint32* List = Adjacency.data() + AdjacencyOffsets[Vertex];
+            for (uint32 j = 0; j < LiveTriangles[Vertex]; ++j)
+            {
+                const uint32 Candidate = List[j];
+                const uint32* C = Indices + Candidate * 3;
+                const float Score = VertexScore[C[0]] + VertexScore[C[1]] + VertexScore[C[2]];
+                if (Score > BestScore)
+                {
+                    BestScore = Score;
+                    BestTriangle = Candidate;
+                    bHasBest = true;
+                }
+            }
+        }
+
+        std::copy(NewCache, NewCache + NewCount, Cache);
+        CacheCount = NewCount;
+    }
+
+    std::copy(Output.begin(), Output.end(), Indices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(uint32* Indices, uint32 NumIndices, const TArray<FVector>& Positions, uint32 CacheSize, float Threshold)
+{
+    const uint32 NumTriangles = NumIndices / 3;
+    if (NumTriangles < 2 || Positions.empty())
+    {
+        return;
+    }
+
+    FFifoCache Cache(static_cast<uint32>(Positions.size()), CacheSize);
+
+    // 1) 하드 경계: 세 정점이 모두 미스인 곳 (캐시 최적화 결과가 새로 시작된 지점)
+    TArray<uint32> HardClusters;
+    for (uint32 Tri = 0; Tri < NumTriangles; ++Tri)
+    {
+        if (Cache.AccessTriangle(Indices + Tri * 3) == 3 || Tri == 0)
+        {
+            HardClusters.push_back(Tri);
+        }
+    }
+
+    // 2) 소프트 경계: 클러스터 앞부분의 ACMR이 (하드 클러스터 ACMR * Threshold) 이하가 되는 곳마다 자름
+    TArray<uint32> Clusters;
+    for (size_t c = 0; c < HardClusters.size(); ++c)
+    {
+        const uint32 Start = HardClusters[c];
+        const uint32 End = c + 1 < HardClusters.size() ? HardClusters[c + 1] : NumTriangles;
+
+        Cache.Reset();
+        uint32 HardMisses = 0;
+        for (uint32 Tri = Start; Tri < End; ++Tri)
+        {
+            HardMisses += Cache.AccessTriangle(Indices + Tri * 3);
+        }
+        const float ClusterThreshold = Threshold * static_cast<float>(HardMisses) / static_cast<float>(End - Start);
+
+        Cache.Reset();
+        Clusters.push_back(Start);
+        uint32 ClusterStart = Start;
+        uint32 ClusterMisses = 0;
+        for (uint32 Tri = Start; Tri < End; ++Tri)
+        {
+            ClusterMisses += Cache.AccessTriangle(Indices + Tri * 3);
+            if (Tri + 1 < End && static_cast<float>(ClusterMisses) <= ClusterThreshold * static_cast<float>(Tri + 1 - ClusterStart))
+            {
+                Clusters.push_back(Tri + 1);
+                Cache.Reset();
+                ClusterStart = Tri + 1;
+                ClusterMisses = 0;
+            }
+        }
+    }
+
+    if (Clusters.size() < 2)
+    {
+        return;
+    }
+
+    // 3) 클러스터 정렬 키: 메시 중심에서 클러스터 중심으로의 벡터 · 클러스터 평균 노멀
+    //    (바깥을 향하는 클러스터가 먼저 그려져 안쪽/뒤쪽 면이 Early-Z에 걸리도록)
+    //    엔진은 시계 방향이 앞면이라 Cross(B - A, C - A)가 바깥 방향
+    FVector MeshCentroid(0, 0, 0);
+    for (uint32 i = 0; i < NumTriangles * 3; ++i)
+    {
+        MeshCentroid += Positions[Indices[i]];
+    }
+    MeshCentroid /= static_cast<float>(NumTriangles * 3);
+
+    struct FClusterKey
+    {
+        float Key;
+        uint32 Cluster;
+    };
+    TArray<FClusterKey> Keys(Clusters.size());
+    for (size_t c = 0; c < Clusters.size(); ++c)
+    {
+        const uint32 Start = Clusters[c];
+        const uint32 End = c + 1 < Clusters.size() ? Clusters[c + 1] : NumTriangles;
+
+        FVector WeightedCentroid(0, 0, 0);
+        FVector AreaNormal(0, 0, 0);
+        float TotalArea = 0.0f;
+        for (uint32 Tri = Start; Tri < End; ++Tri)
+        {
+            const FVector& A = Positions[Indices[Tri * 3 + 0]];
+            const FVector& B = Positions[Indices[Tri * 3 + 1]];
+            const FVector& C = Positions[Indices[Tri * 3 + 2]];
+            const FVector Normal = FVector::Cross(B - A, C - A);
+            const float Area = Normal.Size();
+            WeightedCentroid += (A + B + C) * (Area / 3.0f);
+            AreaNormal += Normal;
+            TotalArea += Area;
+        }
+
+        const FVector ClusterCentroid = TotalArea > 0.0f ? WeightedCentroid / TotalArea : MeshCentroid;
+        Keys[c].Key = FVector::Dot(ClusterCentroid - MeshCentroid, AreaNormal.GetNormalized());
+        Keys[c].Cluster = static_cast<uint32>(c);
+    }
+
+    std::stable_sort(Keys.begin(), Keys.end(), [](const FClusterKey& A, const FClusterKey& B)
+    {
+        return A.Key > B.Key;
+    });
+
+    // 4) 정렬된 클러스터 순서대로 이어붙임
+    TArray<uint32> Output;
+    Output.reserve(NumTriangles * 3);
+    for (const FClusterKey& Key : Keys)
+    {
+        const uint32 Start = Clusters[Key.Cluster];
+        const uint32 End = Key.Cluster + 1 < Clusters.size() ? Clusters[Key.Cluster + 1] : NumTriangles;
+        Output.insert(Output.end(), Indices + Start * 3, Indices + End * 3);
+    }
+    std::copy(Output.begin(), Output.end(), Indices);
+}
+
+uint32 MeshOptimizer::OptimizeIndices(TArray<uint32>& Indices, const TArray<FGroupInfo>& Groups, const TArray<FVector>& Positions,
+    const FSettings& Settings, TArray<uint32>& OutRemap)
+{
+    const uint32 NumVertices = static_cast<uint32>(Positions.size());
+    const uint32 NumIndices = static_cast<uint32>(Indices.size());
+
+    // 범위를 벗어난 인덱스가 있으면 손상된 메시이므로 순서를 건드리지 않음 (항등 매핑)
+    if (std::any_of(Indices.begin(), Indices.end(), [NumVertices](uint32 Index) { return Index >= NumVertices; }))
+    {
+        OutRemap.resize(NumVertices);
+        for (uint32 v = 0; v < NumVertices; ++v)
+        {
+            OutRemap[v] = v;
+        }
+        return NumVertices;
+    }
+
+    // 그룹 범위 밖(또는 그룹 정보 없음)도 하나의 범위로 처리
+    TArray<std::pair<uint32, uint32>> Ranges;
+    for (const FGroupInfo& Group : Groups)
+    {
+        const uint32 Start = std::min(Group.StartIndex, NumIndices);
+        const uint32 Count = std::min(Group.IndexCount, NumIndices - Start) / 3 * 3;
+        if (Count >= 3)
+        {
+            Ranges.push_back({ Start, Count });
+        }
+    }
+    if (Ranges.empty())
+    {
+        Ranges.push_back({ 0, NumIndices / 3 * 3 });
+    }
+
+    // 1) 그룹마다 그룹이 쓰는 정점만 로컬 번호로 모아서 캐시/오버드로우 최적화
+    TArray<uint32> GlobalToLocal(NumVertices, UINT32_MAX);
+    TArray<uint32> LocalToGlobal;
+    TArray<uint32> LocalIndices;
+    TArray<FVector> LocalPositions;
+    for (const std::pair<uint32, uint32>& Range : Ranges)
+    {
+        uint32* RangeIndices = Indices.data() + Range.first;
+        const uint32 RangeCount = Range.second;
+
+        LocalToGlobal.clear();
+        LocalIndices.resize(RangeCount);
+        for (uint32 i = 0; i < RangeCount; ++i)
+        {
+            const uint32 Global = RangeIndices[i];
+            if (GlobalToLocal[Global] == UINT32_MAX)
+            {
+                GlobalToLocal[Global] = static_cast<uint32>(LocalToGlobal.size());
+                LocalToGlobal.push_back(Global);
+            }
+            LocalIndices[i] = GlobalToLocal[Global];
+        }
+
+        const uint32 NumLocal = static_cast<uint32>(LocalToGlobal.size());
+        OptimizeVertexCache(LocalIndices.data(), RangeCount, NumLocal, Settings.CacheSize);
+
+        if (Settings.bOptimizeOverdraw)
+        {
+            LocalPositions.resize(NumLocal);
+            for (uint32 i = 0; i < NumLocal; ++i)
+            {
+                LocalPositions[i] = Positions[LocalToGlobal[i]];
+            }
+            // 하드 경계 판정은 실제 GPU 캐시 크기에 가까운 16으로
+            OptimizeOverdraw(LocalIndices.data(), RangeCount, LocalPositions, 16, Settings.OverdrawThreshold);
+        }
+
+        for (uint32 i = 0; i < RangeCount; ++i)
+        {
+            RangeIndices[i] = LocalToGlobal[LocalIndices[i]];
+        }
+        for (uint32 Global : LocalToGlobal)
+        {
+            GlobalToLocal[Global] = UINT32_MAX;
+        }
+    }
+
+    // 2) 정점 페치: 인덱스 버퍼에서 처음 등장한 순서로 번호를 다시 매김
+    OutRemap.assign(NumVertices, UINT32_MAX);
+    uint32 NextVertex = 0;
+    for (uint32& Index : Indices)
+    {
+        if (OutRemap[Index] == UINT32_MAX)
+        {
+            OutRemap[Index] = NextVertex++;
+        }
+        Index = OutRemap[Index];
+    }
+    return NextVertex;
+}
+
+void MeshOptimizer::LogStats(const FString& AssetName, const FVertexCacheStats& Before, const FVertexCacheStats& After)
+{
+    UE_LOG("[MeshOptimizer] '%s': %u tris, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, vertices %u -> %u",
+        AssetName.c_str(), After.NumTriangles, Before.ACMR, After.ACMR, Before.ATVR, After.ATVR, Before.NumVertices, After.NumVertices);
+}
@@ -0,0 +1,94 @@
+﻿#pragma once
+
+struct FGroupInfo;
+
+/**
+ * 쿠킹 시점 메시 최적화 (OBJ/FBX 임포트 직후, .cooked 저장 전)
+ *
+ * 1) 정점 캐시 최적화: 그룹(머티리얼 섹션)마다 Forsyth 방식으로 삼각형 순서 재배치
+ * 2) 오버드로우 최적화(선택): 캐시 효율을 Threshold 배 이내로 유지하는 클러스터로 나눈 뒤
+ *    바깥을 향하는 클러스터가 먼저 그려지도록 정렬 (Sander et al.)
+ * 3) 정점 페치 최적화: 인덱스 버퍼에서 처음 참조되는 순서대로 정점을 재배치하고 인덱스 재매핑
+ *    (참조되지 않는 정점은 제거)
+ *
+ * 그룹의 StartIndex/IndexCount는 바뀌지 않음 (그룹 범위 안에서만 삼각형 순서를 바꿈)
+ */
+namespace MeshOptimizer
+{
+    struct FSettings
+    {
+        /** Forsyth 점수 계산에 쓰는 캐시 크기 */
+        uint32 CacheSize = 32;
+        bool bOptimizeOverdraw = true;
+        /** 오버드로우 클러스터가 허용하는 ACMR 악화 비율 (1.0이면 캐시 효율을 전혀 양보하지 않음) */
+        float OverdrawThreshold = 1.05f;
+    };
+
+    /** FIFO 캐시 시뮬레이션 결과 */
+    struct FVertexCacheStats
+    {
+        uint32 NumTriangles = 0;
+        uint32 NumVertices = 0;      // 인덱스 버퍼가 실제로 참조하는 정점 수
+        uint32 NumCacheMisses = 0;
+        float ACMR = 0.0f;           // 삼각형당 캐시 미스 (0.5 ~ 3.0, 낮을수록 좋음)
+        float ATVR = 0.0f;           // 정점당 변환 횟수 (1.0이 최적)
+    };
+
+    /** 하드웨어 post-transform 캐시를 FIFO로 가정하고 ACMR/ATVR 측정 */
+    FVertexCacheStats AnalyzeVertexCache(const uint32* Indices, uint32 NumIndices, uint32 NumVertices, uint32 CacheSize = 16);
+
+    /** Forsyth 방식 삼각형 재배치 (In-place) */
+    void OptimizeVertexCache(uint32* Indices, uint32 NumIndices, uint32 NumVertices, uint32 CacheSize = 32);
+
+    /** 캐시 최적화가 끝난 인덱스를 클러스터 단위로 재정렬 (In-place) */
+    void OptimizeOverdraw(uint32* Indices, uint32 NumIndices, const TArray<FVector>& Positions, uint32 CacheSize, float Threshold);
+
+    /**
+     * 그룹별 캐시/오버드로우 최적화 후 정점 페치 순서 재매핑 테이블 생성
+     * @param OutRemap 기존 정점 → 새 정점 인덱스 (참조되지 않으면 UINT32_MAX), Indices는 이미 재매핑되어 있음
+     * @return 새 정점 개수
+     */
+    uint32 OptimizeIndices(TArray<uint32>& Indices, const TArray<FGroupInfo>& Groups, const TArray<FVector>& Positions,
+        const FSettings& Settings, TArray<uint32>& OutRemap);
+
+    void LogStats(const FString& AssetName, const FVertexCacheStats& Before, const FVertexCacheStats& After);
+
+    /**
+     * 정점/인덱스를 한 번에 최적화하고 전후 ACMR/ATVR을 로그로 남김
+     * @param GetPosition TVertex → FVector
+     */
+    template<typename TVertex, typename TGetPosition>
+    void OptimizeMesh(const FString& AssetName, TArray<TVertex>& Vertices, TArray<uint32>& Indices, const TArray<FGroupInfo>& Groups,
+        TGetPosition GetPosition, const FSettings& Settings = FSettings())
+    {
+        if (Vertices.empty() || Indices.size() < 3)
+        {
+            return;
+        }
+
+        TArray<FVector> Positions;
+        Positions.reserve(Vertices.size());
+        for (const TVertex& Vertex : Vertices)
+        {
+            Positions.push_back(GetPosition(Vertex));
+        }
+
+        const FVertexCacheStats Before = AnalyzeVertexCache(Indices.data(), static_cast<uint32>(Indices.size()), static_cast<uint32>(Vertices.size()));
+
+        TArray<uint32> Remap;
+        const uint32 NumUsedVertices = OptimizeIndices(Indices, Groups, Positions, Settings, Remap);
+
+        TArray<TVertex> Reordered(NumUsedVertices);
+        for (size_t i = 0; i < Vertices.size(); ++i)
+        {
+            if (Remap[i] != UINT32_MAX)
+            {
+                Reordered[Remap[i]] = Vertices[i];
+            }
+        }
+        Vertices = std::move(Reordered);
+
+        const FVertexCacheStats After = AnalyzeVertexCache(Indices.data(), static_cast<uint32>(Indices.size()), static_cast<uint32>(Vertices.size()));
+        LogStats(AssetName, Before, After);
+    }
+}
@@ -0,0 +1,740 @@
+﻿#include "pch.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+
+namespace
+{
+    constexpr uint32 InvalidIndex = UINT32_MAX;
+
+    /** 붕괴 한 번에 허용하는 면 법선 회전 (약 78도) */
+    constexpr float MinNormalCosine = 0.2f;
+
+    float PointTriangleDistance(const FVector& P, const FVector& A, const FVector& B, const FVector& C)
+    {
+        // Ericson, Real-Time Collision Detection 5.1.5
+        const FVector AB = B - A;
+        const FVector AC = C - A;
+        const FVector AP = P - A;
+        const float D1 = FVector::Dot(AB, AP);
+        const float D2 = FVector::Dot(AC, AP);
+        if (D1 <= 0.0f && D2 <= 0.0f)
+        {
+            return (P - A).Size();
+        }
+
+        const FVector BP = P - B;
+        const float D3 = FVector::Dot(AB, BP);
+        const float D4 = FVector::Dot(AC, BP);
+        if (D3 >= 0.0f && D4 <= D3)
+        {
+            return (P - B).Size();
+        }
+
+        const float VC = D1 * D4 - D3 * D2;
+        if (VC <= 0.0f && D1 >= 0.0f && D3 <= 0.0f)
+        {
+            return (P - (A + AB * (D1 / (D1 - D3)))).Size();
+        }
+
+        const FVector CP = P - C;
+        const float D5 = FVector::Dot(AB, CP);
+        const float D6 = FVector::Dot(AC, CP);
+        if (D6 >= 0.0f && D5 <= D6)
+        {
+            return (P - C).Size();
+        }
+
+        const float VB = D5 * D2 - D1 * D6;
+        if (VB <= 0.0f && D2 >= 0.0f && D6 <= 0.0f)
+        {
+            return (P - (A + AC * (D2 / (D2 - D6)))).Size();
+        }
+
+        const float VA = D3 * D6 - D5 * D4;
+        if (VA <= 0.0f && (D4 - D3) >= 0.0f && (D5 - D6) >= 0.0f)
+        {
+            return (P - (B + (C - B) * ((D4 - D3) / ((D4 - D3) + (D5 - D6))))).Size();
+        }
+
+        const float Denom = 1.0f / (VA + VB + VC);
+        return (P - (A + AB * (VB * Denom) + AC * (VC * Denom))).Size();
+    }
+
+    /** 평면까지 거리 제곱의 면적 가중 합: v^T A v + 2 b·v + c (A는 대칭이라 6개 성분) */
+    struct FQuadric
+    {
+        double A00 = 0.0, A01 = 0.0, A02 = 0.0, A11 = 0.0, A12 = 0.0, A22 = 0.0;
+        double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+        double C = 0.0;
+        double Weight = 0.0;
+
+        static FQuadric FromPlane(double Nx, double Ny, double Nz, double D, double InWeight)
+        {
+            FQuadric Q;
+            Q.A00 = Nx * Nx * InWeight; Q.A01 = Nx * Ny * InWeight; Q.A02 = Nx * Nz * InWeight;
+            Q.A11 = Ny * Ny * InWeight; Q.A12 = Ny * Nz * InWeight; Q.A22 = Nz * Nz * InWeight;
+            Q.B0 = Nx * D * InWeight; Q.B1 = Ny * D * InWeight; Q.B2 = Nz * D * InWeight;
+            Q.C = D * D * InWeight;
+            Q.Weight = InWeight;
+            return Q;
+        }
+
+        void operator+=(const FQuadric& Other)
+        {
+            A00 += Other.A00; A01 += Other.A01; A02 += Other.A02;
+            A11 += Other.A11; A12 += Other.A12; A22 += Other.A22;
+            B0 += Other.B0; B1 += Other.B1; B2 += Other.B2;
+            C += Other.C;
+            Weight += Other.Weight;
+        }
+
+        /** 면적으로 정규화한 RMS 평면 거리 */
+        double EvaluateDistance(const FVector& P) const
+        {
+            const double X = P.X, Y = P.Y, Z = P.Z;
+            const double Sum = A00 * X * X + A11 * Y * Y + A22 * Z * Z
+                + 2.0 * (A01 * X * Y + A02 * X * Z + A12 * Y * Z)
+                + 2.0 * (B0 * X + B1 * Y + B2 * Z) + C;
+            return Weight > 0.0 ? std::sqrt(std::max(Sum, 0.0) / Weight) : 0.0;
+        }
+    };
+
+    struct FPositionKey
+    {
+        float X, Y, Z;
+        bool operator==(const FPositionKey& Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z; }
+    };
+
+    struct FPositionKeyHash
+    {
+        size_t operator()(const FPositionKey& Key) const
+        {
+            uint32 Bits[3];
+            std::memcpy(Bits, &Key, sizeof(Bits));
+            return (static_cast<size_t>(Bits[0]) * 73856093u) ^ (static_cast<size_t>(Bits[1]) * 19349663u) ^ (static_cast<size_t>(Bits[2]) * 83492791u);
+        }
+    };
+
+    /** 본 가중치 분포 차이 (0 = 같음, 1 = 겹치는 본 없음) */
+    float SkinWeightDistance(const MeshSimplifier::FSkinWeights& A, const MeshSimplifier::FSkinWeights& B)
+    {
+        float Shared = 0.0f;
+        for (int32 i = 0; i < 4; ++i)
+        {
+            for (int32 j = 0; j < 4; ++j)
+            {
+                if (A.BoneIndices[i] == B.BoneIndices[j])
+                {
+                    Shared += std::min(A.BoneWeights[i], B.BoneWeights[j]);
+                    break;
+                }
+            }
+        }
+        return std::clamp(1.0f - Shared, 0.0f, 1.0f);
+    }
+
+    struct FCollapse
+    {
+        float Cost;
+        uint32 From;
+        uint32 To;
+        uint32 FromVersion;
+        uint32 ToVersion;
+
+        bool operator>(const FCollapse& Other) const { return Cost > Other.Cost; }
+    };
+
+    /** 메시 전체가 공유하는 입력 (위치 용접 결과 포함) */
+    struct FSimplifyInput
+    {
+        const TArray<FVector>& Positions;
+        const TArray<uint32>& WedgeIds;
+        const TArray<MeshSimplifier::FSkinWeights>* SkinWeights;
+        TArray<uint32> PositionIds;     // 정점 → 용접된 위치 ID
+        uint32 NumPositions = 0;
+        float Diagonal = 0.0f;
+        float MaxError = 0.0f;          // 절대 거리
+        float SkinErrorScale = 0.0f;    // 절대 거리
+    };
+
+    /**
+     * 그룹 하나를 점진적으로 단순화
+     * 정점 대신 용접된 위치 단위로 위상을 만들고, 붕괴할 때 대상 위치의 정점(wedge)으로 인덱스를 바꿈
+     */
+    class FGroupSimplifier
+    {
+    public:
+        FGroupSimplifier(const FSimplifyInput& InInput, const uint32* InIndices, uint32 InNumIndices, TArray<uint32>& InLocalOfPosition)
+            : Input(InInput)
+            , LocalOfPosition(InLocalOfPosition)
+        {
+            Build(InIndices, InNumIndices);
+        }
+
+        ~FGroupSimplifier()
+        {
+            // 공유 스크래치 배열 복원
+            for (uint32 Position : GlobalOfLocal)
+            {
+                LocalOfPosition[Position] = InvalidIndex;
+            }
+        }
+
+        uint32 GetNumAliveTriangles() const { return NumAliveTriangles; }
+
+        /**
+         * 원본 위치마다 붕괴로 합쳐진 위치 주변의 남은 삼각형까지 최소 거리를 구해 최댓값 반환
+         * (실제 단측 하우스도르프 거리의 상한, QEM 비용은 RMS라 과소평가됨)
+         */
+        float MeasureError()
+        {
+            float MaxError = 0.0f;
+            for (uint32 Local = 0; Local < static_cast<uint32>(Points.size()); ++Local)
+            {
+                if (bAlive[Local])
+                {
+                    continue;
+                }
+                const uint32 Representative = FindRepresentative(Local);
+                float Distance = FLT_MAX;
+                for (uint32 Tri : TrianglesOf[Representative])
+                {
+                    if (!bTriangleAlive[Tri])
+                    {
+                        continue;
+                    }
+                    const uint32* P = &CornerPositions[Tri * 3];
+                    Distance = std::min(Distance, PointTriangleDistance(Points[Local], Points[P[0]], Points[P[1]], Points[P[2]]));
+                }
+                if (Distance == FLT_MAX)
+                {
+                    Distance = (Points[Local] - Points[Representative]).Size();
+                }
+                MaxError = std::max(MaxError, Distance);
+            }
+            return MaxError;
+        }
+
+        /** 살아있는 삼각형이 Target 이하가 될 때까지 붕괴 (오차 한도에 걸리면 더 이상 진행하지 않음) */
+        void SimplifyTo(uint32 TargetTriangles)
+        {
+            while (NumAliveTriangles > TargetTriangles && !bExhausted)
+            {
+                if (Heap.empty())
+                {
+                    bExhausted = true;
+                    break;
+                }
+
+                const FCollapse Top = Heap.top();
+                Heap.pop();
+
+                if (!bAlive[Top.From] || !bAlive[Top.To])
+                {
+                    continue;
+                }
+                if (Top.FromVersion != Versions[Top.From] || Top.ToVersion != Versions[Top.To])
+                {
+                    PushCollapse(Top.From, Top.To);
+                    continue;
+                }
+                if (Top.Cost > Input.MaxError)
+                {
+                    bExhausted = true;
+                    break;
+                }
+
+                const uint32 TargetVertex = FindTargetVertex(Top.From, Top.To);
+                if (TargetVertex == InvalidIndex || !IsCollapseValid(Top.From, Top.To))
+                {
+                    continue;
+                }
+
+                Collapse(Top.From, Top.To, TargetVertex);
+            }
+        }
+
+        void AppendAliveIndices(TArray<uint32>& OutIndices) const
+        {
+            for (uint32 Tri = 0; Tri < NumTriangles; ++Tri)
+            {
+                if (bTriangleAlive[Tri])
+                {
+                    OutIndices.push_back(Corners[Tri * 3 + 0]);
+                    OutIndices.push_back(Corners[Tri * 3 + 1]);
+                    OutIndices.push_back(Corners[Tri * 3 + 2]);
+                }
+            }
+        }
+
+    private:
+        void Build(const uint32* InIndices, uint32 InNumIndices)
+        {
+            NumTriangles = InNumIndices / 3;
+            Corners.assign(InIndices, InIndices + NumTriangles * 3);
+            CornerPositions.resize(Corners.size());
+            bTriangleAlive.assign(NumTriangles, true);
+            OriginalNormals.resize(NumTriangles);
+            NumAliveTriangles = NumTriangles;
+
+            for (size_t i = 0; i < Corners.size(); ++i)
+            {
+                const uint32 Global = Input.PositionIds[Corners[i]];
+                if (LocalOfPosition[Global] == InvalidIndex)
+                {
+                    LocalOfPosition[Global] = static_cast<uint32>(GlobalOfLocal.size());
+                    GlobalOfLocal.push_back(Global);
+                    Points.push_back(Input.Positions[Corners[i]]);
+                    FirstWedge.push_back(Input.WedgeIds[Corners[i]]);
+                    bSeam.push_back(false);
+                }
+                const uint32 Local = LocalOfPosition[Global];
+                CornerPositions[i] = Local;
+                if (FirstWedge[Local] != Input.WedgeIds[Corners[i]])
+                {
+                    bSeam[Local] = true;
+                }
+            }
+
+            const size_t NumLocal = GlobalOfLocal.size();
+            Quadrics.resize(NumLocal);
+            TrianglesOf.resize(NumLocal);
+            bAlive.assign(NumLocal, true);
+            CollapsedInto.assign(NumLocal, InvalidIndex);
+            bLocked.assign(NumLocal, false);
+            Versions.assign(NumLocal, 0);
+
+            std::unordered_map<uint64, uint32> EdgeUseCount;
+            EdgeUseCount.reserve(NumTriangles * 3);
+            for (uint32 Tri = 0; Tri < NumTriangles; ++Tri)
+            {
+                const uint32* P = &CornerPositions[Tri * 3];
+                if (P[0] == P[1] || P[1] == P[2] || P[0] == P[2])
+                {
+                    // 위치가 겹친 퇴화 삼각형은 LOD에서 바로 제거
+                    bTriangleAlive[Tri] = false;
+                    --NumAliveTriangles;
+                    continue;
+                }
+
+                const FVector& A = Points[P[0]];
+                const FVector& B = Points[P[1]];
+                const FVector& C = Points[P[2]];
+                const FVector Cross = FVector::Cross(B - A, C - A);
+                const double Length = Cross.Size();
+                OriginalNormals[Tri] = Cross;
+                if (Length > 0.0)
+                {
+                    const double Nx = Cross.X / Length, Ny = Cross.Y / Length, Nz = Cross.Z / Length;
+                    const double D = -(Nx * A.X + Ny * A.Y + Nz * A.Z);
+                    const FQuadric Plane = FQuadric::FromPlane(Nx, Ny, Nz, D, Length * 0.5);
+                    for (int32 k = 0; k < 3; ++k)
+                    {
+                        Quadrics[P[k]] += Plane;
+                    }
+                }
+
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    TrianglesOf[P[k]].push_back(Tri);
+                    ++EdgeUseCount[EdgeKey(P[k], P[(k + 1) % 3])];
+                }
+            }
+
+            // 열린 경계/비다양체 에지의 양 끝, 이음새 위치는 고정
+            for (const auto& [Key, Count] : EdgeUseCount)
+            {
+                if (Count != 2)
+                {
+                    bLocked[static_cast<uint32>(Key >> 32)] = true;
+                    bLocked[static_cast<uint32>(Key & 0xFFFFFFFFu)] = true;
+                }
+            }
+            for (size_t Local = 0; Local < NumLocal; ++Local)
+            {
+                bLocked[Local] = bLocked[Local] || bSeam[Local];
+            }
+
+            for (uint32 Tri = 0; Tri < NumTriangles; ++Tri)
+            {
+                if (!bTriangleAlive[Tri])
+                {
+                    continue;
+                }
+                const uint32* P = &CornerPositions[Tri * 3];
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    PushCollapse(P[k], P[(k + 1) % 3]);
+                    PushCollapse(P[(k + 1) % 3], P[k]);
+                }
+            }
+        }
+
+        uint32 FindRepresentative(uint32 Local)
+        {
+            uint32 Root = Local;
+            while (!bAlive[Root])
+            {
+                Root = CollapsedInto[Root];
+            }
+            while (CollapsedInto[Local] != Root && !bAlive[Local])
+            {
+                const uint32 Next = CollapsedInto[Local];
+                CollapsedInto[Local] = Root;
+                Local = Next;
+            }
+            return Root;
+        }
+
+        static uint64 EdgeKey(uint32 A, uint32 B)
+        {
+            return A < B ? (static_cast<uint64>(A) << 32) | B : (static_cast<uint64>(B) << 32) | A;
+        }
+
+        bool TriangleHas(uint32 Tri, uint32 Local) const
+        {
+            const uint32* P = &CornerPositions[Tri * 3];
+            return P[0] == Local || P[1] == Local || P[2] == Local;
+        }
+
+        /** From 쪽 삼각형이 붕괴 후 쓸 To 위치의 정점 (From-To 에지를 공유하는 삼각형에서 찾음, 모호하면 실패) */
+        uint32 FindTargetVertex(uint32 From, uint32 To) const
+        {
+            uint32 Found = InvalidIndex;
+            for (uint32 Tri : TrianglesOf[From])
+            {
+                if (!bTriangleAlive[Tri] || !TriangleHas(Tri, To))
+                {
+                    continue;
+                }
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    if (CornerPositions[Tri * 3 + k] == To)
+                    {
+                        const uint32 Vertex = Corners[Tri * 3 + k];
+                        if (Found != InvalidIndex && Input.WedgeIds[Found] != Input.WedgeIds[Vertex])
+                        {
+                            return InvalidIndex;
+                        }
+                        Found = Vertex;
+                    }
+                }
+            }
+            return Found;
+        }
+
+        uint32 FindSourceVertex(uint32 From) const
+        {
+            for (uint32 Tri : TrianglesOf[From])
+            {
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    if (CornerPositions[Tri * 3 + k] == From)
+                    {
+                        return Corners[Tri * 3 + k];
+                    }
+                }
+            }
+            return InvalidIndex;
+        }
+
+        void PushCollapse(uint32 From, uint32 To)
+        {
+            if (From == To || bLocked[From] || !bAlive[From] || !bAlive[To])
+            {
+                return;
+            }
+
+            FQuadric Combined = Quadrics[From];
+            Combined += Quadrics[To];
+            float Cost = static_cast<float>(Combined.EvaluateDistance(Points[To]));
+
+            if (Input.SkinWeights)
+            {
+                const uint32 SourceVertex = FindSourceVertex(From);
+                const uint32 TargetVertex = FindTargetVertex(From, To);
+                if (SourceVertex != InvalidIndex && TargetVertex != InvalidIndex)
+                {
+                    Cost += Input.SkinErrorScale * SkinWeightDistance((*Input.SkinWeights)[SourceVertex], (*Input.SkinWeights)[TargetVertex]);
+                }
+            }
+
+            Heap.push({ Cost, From, To, Versions[From], Versions[To] });
+        }
+
+        void GatherNeighbors(uint32 Local, TArray<uint32>& OutNeighbors) const
+        {
+            OutNeighbors.clear();
+            for (uint32 Tri : TrianglesOf[Local])
+            {
+                if (!bTriangleAlive[Tri])
+                {
+                    continue;
+                }
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    const uint32 Other = CornerPositions[Tri * 3 + k];
+                    if (Other != Local)
+                    {
+                        OutNeighbors.push_back(Other);
+                    }
+                }
+            }
+            std::sort(OutNeighbors.begin(), OutNeighbors.end());
+            OutNeighbors.erase(std::unique(OutNeighbors.begin(), OutNeighbors.end()), OutNeighbors.end());
+        }
+
+        bool IsCollapseValid(uint32 From, uint32 To)
+        {
+            // 링크 조건: 공통 이웃 수 == From-To 에지를 공유하는 삼각형 수 (아니면 비다양체가 생김)
+            GatherNeighbors(From, NeighborsFrom);
+            GatherNeighbors(To, NeighborsTo);
+            TArray<uint32> Shared;
+            std::set_intersection(NeighborsFrom.begin(), NeighborsFrom.end(), NeighborsTo.begin(), NeighborsTo.end(), std::back_inserter(Shared));
+
+            uint32 NumEdgeTriangles = 0;
+            for (uint32 Tri : TrianglesOf[From])
+            {
+                if (bTriangleAlive[Tri] && TriangleHas(Tri, To))
+                {
+                    ++NumEdgeTriangles;
+                }
+            }
+            if (NumEdgeTriangles == 0 || Shared.size() != NumEdgeTriangles)
+            {
+                return false;
+            }
+
+            // 남는 삼각형이 뒤집히거나 퇴화하지 않아야 함
+            for (uint32 Tri : TrianglesOf[From])
+            {
+                if (!bTriangleAlive[Tri] || TriangleHas(Tri, To))
+                {
+                    continue;
+                }
+                FVector Before[3];
+                FVector After[3];
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    const uint32 Local = CornerPositions[Tri * 3 + k];
+                    Before[k] = Points[Local];
+                    After[k] = Local == From ? Points[To] : Points[Local];
+                }
+                const FVector NormalBefore = FVector::Cross(Before[1] - Before[0], Before[2] - Before[0]);
+                const FVector NormalAfter = FVector::Cross(After[1] - After[0], After[2] - After[0]);
+                // 한 번에 크게 꺾이는 것과, 여러 번 붕괴가 누적되어 원래 면과 반대가 되는 것을 모두 막음
+                const float LengthProduct = NormalBefore.Size() * NormalAfter.Size();
+                if (LengthProduct <= 0.0f
+                    || FVector::Dot(NormalBefore, NormalAfter) < MinNormalCosine * LengthProduct
+                    || FVector::Dot(OriginalNormals[Tri], NormalAfter) <= 0.0f)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void Collapse(uint32 From, uint32 To, uint32 TargetVertex)
+        {
+            for (uint32 Tri : TrianglesOf[From])
+            {
+                if (!bTriangleAlive[Tri])
+                {
+                    continue;
+                }
+                if (TriangleHas(Tri, To))
+                {
+                    bTriangleAlive[Tri] = false;
+                    --NumAliveTriangles;
+                    continue;
+                }
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    if (CornerPositions[Tri * 3 + k] == From)
+                    {
+                        CornerPositions[Tri * 3 + k] = To;
+                        Corners[Tri * 3 + k] = TargetVertex;
+                    }
+                }
+                TrianglesOf[To].push_back(Tri);
+            }
+            TrianglesOf[From].clear();
+
+            // 죽은 삼각형 정리
+            TArray<uint32>& ToTriangles = TrianglesOf[To];
+            ToTriangles.erase(std::remove_if(ToTriangles.begin(), ToTriangles.end(), [this](uint32 Tri) { return !bTriangleAlive[Tri]; }), ToTriangles.end());
+
+            Quadrics[To] += Quadrics[From];
+            bAlive[From] = false;
+            CollapsedInto[From] = To;
+            ++Versions[From];
+            ++Versions[To];
+
+            GatherNeighbors(To, NeighborsTo);
+            for (uint32 Neighbor : NeighborsTo)
+            {
+                PushCollapse(To, Neighbor);
+                PushCollapse(Neighbor, To);
+            }
+        }
+
+    private:
+        const FSimplifyInput& Input;
+        TArray<uint32>& LocalOfPosition;
+
+        // 삼각형
+        uint32 NumTriangles = 0;
+        uint32 NumAliveTriangles = 0;
+        TArray<uint32> Corners;             // 정점 인덱스 (붕괴 시 대상 정점으로 교체)
+        TArray<uint32> CornerPositions;     // 로컬 위치 ID
+        TArray<bool> bTriangleAlive;
+        TArray<FVector> OriginalNormals;
+
+        // 로컬 위치
+        TArray<uint32> GlobalOfLocal;
+        TArray<FVector> Points;
+        TArray<uint32> FirstWedge;
+        TArray<bool> bSeam;
+        TArray<bool> bLocked;
+        TArray<bool> bAlive;
+        TArray<uint32> CollapsedInto;      // 붕괴된 위치 → 합쳐진 위치
+        TArray<uint32> Versions;
+        TArray<FQuadric> Quadrics;
+        TArray<TArray<uint32>> TrianglesOf;
+
+        std::priority_queue<FCollapse, std::vector<FCollapse>, std::greater<FCollapse>> Heap;
+        bool bExhausted = false;
+
+        TArray<uint32> NeighborsFrom;
+        TArray<uint32> NeighborsTo;
+    };
+}
+
+void MeshSimplifier::GenerateLODs(const TArray<FVector>& Positions, const TArray<uint32>& WedgeIds, const TArray<FSkinWeights>* SkinWeights,
+    const TArray<uint32>& Indices, const TArray<FGroupInfo>& Groups, const FSettings& Settings, TArray<FMeshLOD>& OutLODs)
+{
+    OutLODs.clear();
+
+    const uint32 NumVertices = static_cast<uint32>(Positions.size());
+    const uint32 NumIndices = static_cast<uint32>(Indices.size());
+    for (uint32 Index : Indices)
+    {
+        if (Index >= NumVertices)
+        {
+            return;
+        }
+    }
+
+    // 그룹이 없으면 전체를 한 섹션으로 취급
+    TArray<FMeshLODSection> BaseSections;
+    if (Groups.empty())
+    {
+        BaseSections.push_back({ 0, NumIndices - NumIndices % 3 });
+    }
+    for (const FGroupInfo& Group : Groups)
+    {
+        if (Group.StartIndex + Group.IndexCount > NumIndices)
+        {
+            return;
+        }
+        BaseSections.push_back({ Group.StartIndex, Group.IndexCount - Group.IndexCount % 3 });
+    }
+
+    FSimplifyInput Input{ Positions, WedgeIds, SkinWeights };
+    Input.PositionIds.resize(NumVertices);
+    {
+        std::unordered_map<FPositionKey, uint32, FPositionKeyHash> PositionMap;
+        PositionMap.reserve(NumVertices);
+        for (uint32 i = 0; i < NumVertices; ++i)
+        {
+            const FVector& P = Positions[i];
+            Input.PositionIds[i] = PositionMap.emplace(FPositionKey{ P.X, P.Y, P.Z }, static_cast<uint32>(PositionMap.size())).first->second;
+        }
+        Input.NumPositions = static_cast<uint32>(PositionMap.size());
+    }
+
+    FVector Min = Positions[0];
+    FVector Max = Positions[0];
+    for (const FVector& P : Positions)
+    {
+        Min = Min.ComponentMin(P);
+        Max = Max.ComponentMax(P);
+    }
+    Input.Diagonal = (Max - Min).Size();
+    if (Input.Diagonal <= 0.0f)
+    {
+        return;
+    }
+    Input.MaxError = Settings.MaxRelativeError * Input.Diagonal;
+    Input.SkinErrorScale = Settings.SkinWeightErrorScale * Input.Diagonal;
+
+    const uint32 NumLODs = Settings.NumLODs;
+    TArray<TArray<TArray<uint32>>> LODSectionIndices(NumLODs, TArray<TArray<uint32>>(BaseSections.size()));
+    TArray<float> LODErrors(NumLODs, 0.0f);
+
+    TArray<uint32> LocalOfPosition(Input.NumPositions, InvalidIndex);
+    for (size_t SectionIndex = 0; SectionIndex < BaseSections.size(); ++SectionIndex)
+    {
+        const FMeshLODSection& Section = BaseSections[SectionIndex];
+        if (Section.IndexCount == 0)
+        {
+            continue;
+        }
+
+        FGroupSimplifier Simplifier(Input, Indices.data() + Section.StartIndex, Section.IndexCount, LocalOfPosition);
+        const uint32 NumTriangles = Section.IndexCount / 3;
+        float Ratio = 1.0f;
+        for (uint32 LOD = 0; LOD < NumLODs; ++LOD)
+        {
+            Ratio *= Settings.ReductionPerLOD;
+            Simplifier.SimplifyTo(static_cast<uint32>(static_cast<float>(NumTriangles) * Ratio));
+            Simplifier.AppendAliveIndices(LODSectionIndices[LOD][SectionIndex]);
+            LODErrors[LOD] = std::max(LODErrors[LOD], Simplifier.MeasureError());
+        }
+    }
+
+    uint32 PreviousIndexCount = NumIndices;
+    for (uint32 LOD = 0; LOD < NumLODs; ++LOD)
+    {
+        FMeshLOD MeshLOD;
+        for (TArray<uint32>& SectionIndices : LODSectionIndices[LOD])
+        {
+            const uint32 Start = static_cast<uint32>(MeshLOD.Indices.size());
+            const uint32 Count = static_cast<uint32>(SectionIndices.size());
+            MeshLOD.Indices.insert(MeshLOD.Indices.end(), SectionIndices.begin(), SectionIndices.end());
+            MeshLOD.Sections.push_back({ Start, Count });
+        }
+
+        const uint32 IndexCount = static_cast<uint32>(MeshLOD.Indices.size());
+        if (IndexCount == 0 || static_cast<float>(IndexCount) > static_cast<float>(PreviousIndexCount) * Settings.MinReductionPerLOD)
+        {
+            break;
+        }
+
+        for (const FMeshLODSection& Section : MeshLOD.Sections)
+        {
+            MeshOptimizer::OptimizeVertexCache(MeshLOD.Indices.data() + Section.StartIndex, Section.IndexCount, NumVertices);
+        }
+        MeshLOD.RelativeError = LODErrors[LOD] / Input.Diagonal;
+
+        PreviousIndexCount = IndexCount;
+        OutLODs.push_back(std::move(MeshLOD));
+    }
+}
+
+void MeshSimplifier::LogLODs(const FString& AssetName, uint32 NumBaseIndices, const TArray<FMeshLOD>& LODs)
+{
+    if (LODs.empty())
+    {
+        UE_LOG("[MeshSimplifier] '%s': no LOD generated (%u tris, locked or error limit reached)", AssetName.c_str(), NumBaseIndices / 3);
+        return;
+    }
+
+    for (size_t LOD = 0; LOD < LODs.size(); ++LOD)
+    {
+        const uint32 NumTriangles = static_cast<uint32>(LODs[LOD].Indices.size() / 3);
+        UE_LOG("[MeshSimplifier] '%s': LOD%zu %u tris (%.1f%% of LOD0), error %.4f%% of bounds",
+            AssetName.c_str(), LOD + 1, NumTriangles, NumBaseIndices > 0 ? 100.0f * LODs[LOD].Indices.size() / NumBaseIndices : 0.0f,
+            LODs[LOD].RelativeError * 100.0f);
+    }
+}
@@ -0,0 +1,105 @@
+﻿#pragma once
+#include <type_traits>
+
+struct FGroupInfo;
+struct FMeshLOD;
+
+/**
+ * 쿠킹 시점 LOD 생성 (QEM 에지 붕괴, Garland & Heckbert)
+ *
+ * - 정점을 새로 만들지 않고 기존 정점으로 붕괴(half-edge collapse)시켜 모든 LOD가 LOD0 정점 버퍼를 공유
+ * - 그룹(머티리얼 섹션)마다 따로 단순화하므로 섹션 경계가 유지됨
+ * - 열린 경계, 비다양체 에지, UV/노멀 이음새(같은 위치에 서로 다른 정점)는 고정
+ * - 스키닝 메시는 본 가중치 차이를 붕괴 비용에 더해 서로 다른 본 영역이 섞이는 것을 늦춤
+ *
+ * 오차는 붕괴된 원본 위치에서 남은 면까지의 최대 거리(단측 하우스도르프 상한)를 바운드 대각선 길이로 나눈 값
+ */
+namespace MeshSimplifier
+{
+    struct FSettings
+    {
+        /** LOD0 외에 만들 LOD 개수 */
+        uint32 NumLODs = 3;
+        /** LOD마다 이전 LOD 대비 목표 삼각형 비율 */
+        float ReductionPerLOD = 0.5f;
+        /** QEM 비용이 이 상대 거리를 넘는 붕괴는 하지 않음 (더 줄일 수 없으면 LOD 생성 중단) */
+        float MaxRelativeError = 0.1f;
+        /** 본 가중치가 완전히 다를 때 더해지는 비용 (바운드 대각선 대비) */
+        float SkinWeightErrorScale = 0.05f;
+        /** 이전 LOD보다 이 비율 이상 줄지 않으면 LOD를 버리고 중단 */
+        float MinReductionPerLOD = 0.9f;
+    };
+
+    struct FSkinWeights
+    {
+        uint32 BoneIndices[4];
+        float BoneWeights[4];
+    };
+
+    /**
+     * @param WedgeIds 정점마다 같은 속성을 가진 첫 정점 인덱스 (이음새 판별용)
+     * @param SkinWeights 스키닝 메시가 아니면 nullptr
+     */
+    void GenerateLODs(const TArray<FVector>& Positions, const TArray<uint32>& WedgeIds, const TArray<FSkinWeights>* SkinWeights,
+        const TArray<uint32>& Indices, const TArray<FGroupInfo>& Groups, const FSettings& Settings, TArray<FMeshLOD>& OutLODs);
+
+    /** 바이트 단위로 같은 정점끼리 묶음 (FBX처럼 폴리곤 정점마다 정점을 만든 메시의 가짜 이음새 제거) */
+    template<typename TVertex>
+    TArray<uint32> ComputeWedgeIds(const TArray<TVertex>& Vertices)
+    {
+        static_assert(std::is_trivially_copyable_v<TVertex>, "Wedge ids compare raw vertex bytes");
+
+        TArray<uint32> WedgeIds(Vertices.size());
+        std::unordered_map<std::string_view, uint32> FirstVertex;
+        FirstVertex.reserve(Vertices.size());
+        for (size_t i = 0; i < Vertices.size(); ++i)
+        {
+            const std::string_view Bytes(reinterpret_cast<const char*>(&Vertices[i]), sizeof(TVertex));
+            WedgeIds[i] = FirstVertex.emplace(Bytes, static_cast<uint32>(i)).first->second;
+        }
+        return WedgeIds;
+    }
+
+    void LogLODs(const FString& AssetName, uint32 NumBaseIndices, const TArray<FMeshLOD>& LODs);
+
+    /**
+     * 정점 배열에서 위치/본 가중치를 뽑아 LOD를 만들고 결과를 로그로 남김
+     * @param GetPosition TVertex → FVector
+     */
+    template<typename TVertex, typename TGetPosition>
+    void BuildLODs(const FString& AssetName, const TArray<TVertex>& Vertices, const TArray<uint32>& Indices, const TArray<FGroupInfo>& Groups,
+        TGetPosition GetPosition, TArray<FMeshLOD>& OutLODs, const FSettings& Settings = FSettings())
+    {
+        OutLODs.clear();
+        if (Vertices.empty() || Indices.size() < 3 || Settings.NumLODs == 0)
+        {
+            return;
+        }
+
+        TArray<FVector> Positions;
+        Positions.reserve(Vertices.size());
+        for (const TVertex& Vertex : Vertices)
+        {
+            Positions.push_back(GetPosition(Vertex));
+        }
+
+        const TArray<uint32> WedgeIds = ComputeWedgeIds(Vertices);
+
+        if constexpr (std::is_same_v<TVertex, FSkinnedVertex>)
+        {
+            TArray<FSkinWeights> SkinWeights(Vertices.size());
+            for (size_t i = 0; i < Vertices.size(); ++i)
+            {
+                std::memcpy(SkinWeights[i].BoneIndices, Vertices[i].BoneIndices, sizeof(SkinWeights[i].BoneIndices));
+                std::memcpy(SkinWeights[i].BoneWeights, Vertices[i].BoneWeights, sizeof(SkinWeights[i].BoneWeights));
+            }
+            GenerateLODs(Positions, WedgeIds, &SkinWeights, Indices, Groups, Settings, OutLODs);
+        }
+        else
+        {
+            GenerateLODs(Positions, WedgeIds, nullptr, Indices, Groups, Settings, OutLODs);
+        }
+
+        LogLODs(AssetName, static_cast<uint32>(Indices.size()), OutLODs);
+    }
+}
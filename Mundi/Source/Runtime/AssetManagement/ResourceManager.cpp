@@ -7,6 +7,8 @@
 #include "Quad.h"
 #include "MeshBVH.h"
 #include "Enums.h"
+#include "PackedVertex.h"
+#include "PlatformTime.h"
 
 #include <filesystem>
 #include <cwctype>
@@ -40,6 +42,17 @@ void UResourceManager::Initialize(ID3D11Device* InDevice, ID3D11DeviceContext* I
     //CreateGridMesh(GRIDNUM,"Grid");
     //CreateAxisMesh(AXISLENGTH,"Axis");
 
+    // 정점 포맷은 입력 레이아웃/정점 버퍼를 만들기 전에 한 번만 결정
+    const FString* PackedVertexSetting = EditorINI.Find("PackedVertexFormat");
+    const FString* QuantizeSetting = EditorINI.Find("PackedVertexQuantizePositions");
+    PackedVertex::SetEnabled(PackedVertexSetting && *PackedVertexSetting == "1");
+    PackedVertex::SetPositionQuantizationEnabled(QuantizeSetting && *QuantizeSetting == "1");
+    if (PackedVertex::IsEnabled())
+    {
+        UE_LOG("[PackedVertex] Packed vertex format enabled (quantized cooked positions: %s)",
+            PackedVertex::IsPositionQuantizationEnabled() ? "on" : "off");
+    }
+
     InitShaderILMap();
 
     InitTexToShaderMap();
@@ -54,6 +67,9 @@ void UResourceManager::Initialize(ID3D11Device* InDevice, ID3D11DeviceContext* I
 // 전체 해제
 void UResourceManager::Clear()
 {
+    // 워커가 아직 채우고 있는 리소스 객체가 있을 수 있으므로 가장 먼저 정리
+    AsyncLoader.CancelAll();
+
     {////////////// Deprecated //////////////
         for (auto& [Key, Data] : ResourceMap)
         {
@@ -98,7 +114,12 @@ void UResourceManager::Clear()
         }
         MaterialMap.clear();
 
-        // Mesh BVH cache clear
+        // Mesh BVH cache clear (빌드 중인 BVH는 끝날 때까지 대기)
+        for (auto& Pair : PendingMeshBVHBuilds)
+        {
+            Pair.second.Wait();
+        }
+        PendingMeshBVHBuilds.clear();
         for (auto& Pair : MeshBVHCache)
         {
             delete Pair.second;
@@ -123,8 +144,18 @@ void UResourceManager::Clear()
     // Instance lifetime is managed by ObjectFactory
 }
 
+void UResourceManager::WaitForMeshBVHBuild(const FString& ObjPath)
+{
+    if (FTaskHandle* Pending = PendingMeshBVHBuilds.Find(ObjPath))
+    {
+        Pending->Wait();
+        PendingMeshBVHBuilds.Remove(ObjPath);
+    }
+}
+
 FMeshBVH* UResourceManager::GetMeshBVH(const FString& ObjPath)
 {
+    WaitForMeshBVHBuild(ObjPath);
     if (auto* Found = MeshBVHCache.Find(ObjPath))
         return *Found;
     return nullptr;
@@ -132,18 +163,44 @@ FMeshBVH* UResourceManager::GetMeshBVH(const FString& ObjPath)
 
 FMeshBVH* UResourceManager::GetOrBuildMeshBVH(const FString& ObjPath, const FStaticMesh* StaticMeshAsset)
 {
-    if (auto* Found = MeshBVHCache.Find(ObjPath))
-        return *Found;
+    // 쿠킹 캐시에서 함께 로드된 BVH (빌드 없음)
+    if (StaticMeshAsset && StaticMeshAsset->MeshBVH)
+        return StaticMeshAsset->MeshBVH.get();
+
+    if (FMeshBVH* Found = GetMeshBVH(ObjPath))
+        return Found;
 
     if (!StaticMeshAsset)
         return nullptr;
 
+    // 쿠킹된 BVH도, 미리 요청된 빌드도 없으면 여기서 빌드 (첫 피킹 히치)
+    const uint64 StartCycles = FPlatformTime::Cycles64();
     FMeshBVH* NewBVH = new FMeshBVH();
     NewBVH->Build(StaticMeshAsset->Vertices, StaticMeshAsset->Indices);
     MeshBVHCache.Add(ObjPath, NewBVH);
+    UE_LOG("[MeshBVH] '%s': built on first query (%u triangles, %.2f ms)", ObjPath.c_str(),
+        static_cast<uint32>(StaticMeshAsset->Indices.size() / 3), FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
     return NewBVH;
 }
 
+void UResourceManager::RequestMeshBVHBuild(const FString& ObjPath, const FStaticMesh* StaticMeshAsset)
+{
+    if (!StaticMeshAsset || StaticMeshAsset->MeshBVH || StaticMeshAsset->Indices.size() < 3
+        || MeshBVHCache.Contains(ObjPath) || !FTaskGraph::GetInstance().IsRunning())
+    {
+        return;
+    }
+
+    // 캐시에 먼저 넣어두고 워커가 채움 → 완료 전 조회는 WaitForMeshBVHBuild에서 대기
+    // (FStaticMesh는 FObjManager가 종료 시까지 소유하므로 워커에서 참조해도 안전)
+    FMeshBVH* NewBVH = new FMeshBVH();
+    MeshBVHCache.Add(ObjPath, NewBVH);
+    PendingMeshBVHBuilds.Add(ObjPath, FTaskGraph::GetInstance().Launch([NewBVH, StaticMeshAsset]()
+    {
+        NewBVH->Build(StaticMeshAsset->Vertices, StaticMeshAsset->Indices);
+    }));
+}
+
 void UResourceManager::SetStaticMeshs()
 {
     StaticMeshs = GetAll<UStaticMesh>();
@@ -460,8 +517,23 @@ void UResourceManager::InitShaderILMap()
 {
     TArray<D3D11_INPUT_ELEMENT_DESC> layout;
 
+    // 메시 정점 레이아웃 (FVertexDynamic 또는 FPackedVertex, IA가 float로 풀어주므로 셰이더는 공용)
+    const bool bPacked = PackedVertex::IsEnabled();
+    const DXGI_FORMAT NormalFormat = bPacked ? DXGI_FORMAT_R8G8B8A8_SNORM : DXGI_FORMAT_R32G32B32_FLOAT;
+    const DXGI_FORMAT UVFormat = bPacked ? DXGI_FORMAT_R16G16_FLOAT : DXGI_FORMAT_R32G32_FLOAT;
+    const DXGI_FORMAT TangentFormat = bPacked ? DXGI_FORMAT_R8G8B8A8_SNORM : DXGI_FORMAT_R32G32B32A32_FLOAT;
+    const DXGI_FORMAT ColorFormat = bPacked ? DXGI_FORMAT_R8G8B8A8_UNORM : DXGI_FORMAT_R32G32B32A32_FLOAT;
+    const auto AddMeshVertexElements = [&](TArray<D3D11_INPUT_ELEMENT_DESC>& OutLayout)
+    {
+        OutLayout.Add({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+        OutLayout.Add({ "NORMAL", 0, NormalFormat, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+        OutLayout.Add({ "TEXCOORD", 0, UVFormat, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+        OutLayout.Add({ "TANGENT", 0, TangentFormat, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+        OutLayout.Add({ "COLOR", 0, ColorFormat, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    };
+
     layout.Add({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    layout.Add({ "NORMAL", 0, NormalFormat, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 });
     ShaderToInputLayoutMap["Shaders/UI/Gizmo.hlsl"] = layout;
 	layout.clear();
 
@@ -471,11 +543,7 @@ void UResourceManager::InitShaderILMap()
     ShaderToInputLayoutMap["Shaders/Primitives/Primitive.hlsl"] = layout;
     layout.clear();
 
-    layout.Add({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 48, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    AddMeshVertexElements(layout);
    
     ShaderToInputLayoutMap["Shaders/Effects/Decal.hlsl"] = layout;
 	ShaderToInputLayoutMap["Shaders/Materials/UberLit.hlsl"] = layout;
@@ -484,11 +552,7 @@ void UResourceManager::InitShaderILMap()
 	ShaderToInputLayoutMap["Shaders/Shadows/DepthOnly_VS.hlsl"] = layout;
     layout.clear();
 
-    layout.Add({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0 });
-    layout.Add({ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 48, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    AddMeshVertexElements(layout);
 
     layout.Add({ "INSTANCE_WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 });
     layout.Add({ "INSTANCE_WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
@@ -643,8 +707,8 @@ void UResourceManager::CheckAndReloadShaders(float DeltaTime)
         return;
     }
 
-    // Ensure device context flushes before reloading
-    if (Context)
+    // Ensure device context flushes before reloading (지연 컨텍스트에는 Flush가 없음)
+    if (Context && Context->GetType() == D3D11_DEVICE_CONTEXT_IMMEDIATE)
     {
         Context->Flush();
     }
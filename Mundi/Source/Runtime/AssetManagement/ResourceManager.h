@@ -18,6 +18,9 @@
 #include "Source/Runtime/Engine/Animation/AnimSequence.h"
 #include "Source/Runtime/Engine/Particle/ParticleSystem.h"
 #include "Source/Runtime/Engine/Physics/PhysicsAsset.h"
+#include "AsyncAssetLoader.h"
+#include "AssetRegistry.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
 // ... 기타 include ...
 
 // --- 전방 선언 ---
@@ -48,6 +51,23 @@ public:
 	template<typename T, typename... Args>
 	T* Load(const FString& InFilePath, Args&&... InArgs);
 
+	/**
+	 * 비동기 로드: 파일 I/O/파싱은 워커 스레드, GPU 리소스 생성과 콜백은 게임 스레드(ProcessAsyncLoads)에서 실행
+	 * - 이미 로드된 리소스면 완료된 핸들을 반환하고 콜백을 즉시 호출
+	 * - 같은 경로가 로드 중이면 그 요청에 합류 (중복 로드 없음)
+	 * - T가 LoadAsyncPayload/FinalizeAsyncLoad를 제공하지 않으면 게임 스레드에서 기존 Load를 그대로 실행
+	 * InArgs는 LoadAsyncPayload(또는 Load)의 추가 인자로 전달 (값으로 복사되어 보관됨)
+	 */
+	template<typename T, typename... Args>
+	TAsyncLoadHandle<T> LoadAsync(const FString& InFilePath, EAsyncLoadPriority Priority = EAsyncLoadPriority::Normal,
+		std::function<void(T*)> OnCompleted = nullptr, Args&&... InArgs);
+
+	/** 게임 스레드에서 매 프레임 호출 - 준비된 비동기 로드를 시간 예산 안에서 마무리 */
+	int32 ProcessAsyncLoads(double TimeBudgetMs = 4.0) { return AsyncLoader.ProcessCompleted(TimeBudgetMs); }
+	/** 진행 중인 비동기 로드를 모두 끝냄 (프리로드/레벨 로드 마무리) */
+	void FlushAsyncLoads() { AsyncLoader.Flush(); }
+	int32 GetNumAsyncLoadsInFlight() const { return AsyncLoader.GetNumInFlight(); }
+
 	template<typename T>
 	bool Add(const FString& InFilePath, UObject* InObject);
 
@@ -60,6 +80,10 @@ public:
 	template<typename T>
 	TArray<FString> GetAllFilePaths();
 
+	/** 로드된 리소스 경로 + 에셋 레지스트리에 등록된(아직 로드되지 않은) 경로. 에디터 선택 목록용 */
+	template<typename T>
+	TArray<FString> GetAllAssetPaths();
+
 	template<typename T>
 	EResourceType GetResourceType();
 
@@ -92,7 +116,10 @@ public:
 
 	// --- 캐시 관리 ---
 	FMeshBVH* GetMeshBVH(const FString& ObjPath);
+	/** 쿠킹된 BVH → 백그라운드 빌드 결과(대기) → 즉석 빌드 순으로 찾음 */
 	FMeshBVH* GetOrBuildMeshBVH(const FString& ObjPath, const struct FStaticMesh* StaticMeshAsset);
+	/** 쿠킹된 BVH가 없는 메시(FBX 등)는 로드 직후 워커에서 미리 빌드해 첫 피킹 히치를 줄임 */
+	void RequestMeshBVHBuild(const FString& ObjPath, const struct FStaticMesh* StaticMeshAsset);
 	void SetStaticMeshs();
 	void SetSkeletalMeshs();
 	const TArray<UStaticMesh*>& GetStaticMeshs() { return StaticMeshs; }
@@ -116,7 +143,7 @@ protected:
 	ID3D11DeviceContext* Context = nullptr;
 
 	//Resource Type의 개수만큼 Array 생성 및 저장
-	TArray<TMap<FString, UResourceBase*>> Resources;
+	TArray<TFlatMap<FString, UResourceBase*>> Resources;
 
 	TMap<FString, TArray<D3D11_INPUT_ELEMENT_DESC>> ShaderToInputLayoutMap;
 	TMap<FString, FString> TextureToShaderMap;
@@ -135,7 +162,19 @@ private:
 	TMap<FString, UMaterial*> MaterialMap;
 
 	// Cache for per-mesh BVHs to avoid rebuilding for identical OBJ assets
+	// (쿠킹 캐시에 BVH가 없는 메시만, 쿠킹된 BVH는 FStaticMesh::MeshBVH가 소유)
 	TMap<FString, FMeshBVH*> MeshBVHCache;
+	// 워커에서 빌드 중인 BVH (완료 전에 조회하면 대기)
+	TMap<FString, FTaskHandle> PendingMeshBVHBuilds;
+
+	void WaitForMeshBVHBuild(const FString& ObjPath);
+
+	// 비동기 로드 요청 관리 (LoadAsync)
+	FAsyncAssetLoader AsyncLoader;
+
+	/** 비동기 로드 Finalize 공통 마무리: 성공 시 리소스 맵 등록, 실패 시 객체 삭제 */
+	template<typename T>
+	T* FinishAsyncLoad(T* InResource, const FString& InNormalizedPath, bool bSucceeded);
 
 	UMaterial* DefaultMaterialInstance;
 
@@ -206,6 +245,16 @@ inline T* UResourceManager::Load(const FString& InFilePath, Args && ...InArgs)
 	}
 	else//없으면 해당 리소스의 Load실행
 	{
+		// 같은 경로가 비동기 로드 중이면 새로 로드하지 않고 그 요청을 끝내서 사용
+		if (std::shared_ptr<FAsyncLoadRequest> Pending = AsyncLoader.FindInFlight(typeIndex, NormalizedPath))
+		{
+			AsyncLoader.Wait(Pending);
+			if (Pending->State.load() == EAsyncLoadState::Succeeded)
+			{
+				return static_cast<T*>(Pending->Result);
+			}
+		}
+
 		T* Resource = NewObject<T>();
 		if (!Resource->Load(NormalizedPath, Device, std::forward<Args>(InArgs)...))
 		{
@@ -218,6 +267,104 @@ inline T* UResourceManager::Load(const FString& InFilePath, Args && ...InArgs)
 	}
 }
 
+template<typename T, typename ...Args>
+inline TAsyncLoadHandle<T> UResourceManager::LoadAsync(const FString& InFilePath, EAsyncLoadPriority Priority,
+	std::function<void(T*)> OnCompleted, Args && ...InArgs)
+{
+	if (InFilePath.empty())
+	{
+		return TAsyncLoadHandle<T>();
+	}
+
+	FString NormalizedPath = NormalizePath(InFilePath);
+	uint8 typeIndex = static_cast<uint8>(GetResourceType<T>());
+
+	// 1) 이미 로드됨
+	auto iter = Resources[typeIndex].find(NormalizedPath);
+	if (iter != Resources[typeIndex].end())
+	{
+		T* Existing = static_cast<T*>(iter->second);
+		if (OnCompleted)
+		{
+			OnCompleted(Existing);
+		}
+		return TAsyncLoadHandle<T>(FAsyncAssetLoader::MakeCompletedRequest(Existing), &AsyncLoader);
+	}
+
+	// 2) 같은 경로가 로드 중이면 합류, 아니면 새 요청
+	std::shared_ptr<FAsyncLoadRequest> Request = AsyncLoader.FindInFlight(typeIndex, NormalizedPath);
+	if (Request)
+	{
+		AsyncLoader.RaisePriority(Request, Priority);
+	}
+	else
+	{
+		Request = std::make_shared<FAsyncLoadRequest>();
+		Request->Path = NormalizedPath;
+		Request->TypeIndex = typeIndex;
+		Request->Priority.store(Priority);
+
+		// UObject 생성은 게임 스레드에서. 워커는 이 객체의 CPU 측 멤버만 채움
+		T* Resource = NewObject<T>();
+
+		if constexpr (requires(T& R, const FString& P, ID3D11Device* D, Args&... A) { R.LoadAsyncPayload(P, A...); R.FinalizeAsyncLoad(D); })
+		{
+			Request->LoadPayload = [Resource, NormalizedPath, ...CapturedArgs = std::forward<Args>(InArgs)]()
+			{
+				return Resource->LoadAsyncPayload(NormalizedPath, CapturedArgs...);
+			};
+			Request->Finalize = [this, Resource, NormalizedPath](bool bPayloadSucceeded) -> UResourceBase*
+			{
+				const bool bSucceeded = bPayloadSucceeded && Resource->FinalizeAsyncLoad(Device);
+				return FinishAsyncLoad<T>(Resource, NormalizedPath, bSucceeded);
+			};
+		}
+		else
+		{
+			// 단계 분리를 지원하지 않는 타입: 워커 단계 없이 게임 스레드에서 동기 Load
+			Request->Finalize = [this, Resource, NormalizedPath, ...CapturedArgs = std::forward<Args>(InArgs)](bool bPayloadSucceeded) mutable -> UResourceBase*
+			{
+				const bool bSucceeded = bPayloadSucceeded && Resource->Load(NormalizedPath, Device, CapturedArgs...);
+				return FinishAsyncLoad<T>(Resource, NormalizedPath, bSucceeded);
+			};
+		}
+
+		AsyncLoader.Enqueue(Request);
+	}
+
+	if (OnCompleted)
+	{
+		AsyncLoader.AddCallback(Request, [OnCompleted](UResourceBase* InResource)
+		{
+			OnCompleted(static_cast<T*>(InResource));
+		});
+	}
+	return TAsyncLoadHandle<T>(Request, &AsyncLoader);
+}
+
+template<typename T>
+inline T* UResourceManager::FinishAsyncLoad(T* InResource, const FString& InNormalizedPath, bool bSucceeded)
+{
+	if (!bSucceeded)
+	{
+		DeleteObject(InResource);
+		return nullptr;
+	}
+
+	// 로드 도중 Add 등으로 같은 경로가 먼저 등록된 경우 기존 것을 유지
+	uint8 typeIndex = static_cast<uint8>(GetResourceType<T>());
+	auto iter = Resources[typeIndex].find(InNormalizedPath);
+	if (iter != Resources[typeIndex].end())
+	{
+		DeleteObject(InResource);
+		return static_cast<T*>(iter->second);
+	}
+
+	InResource->SetFilePath(InNormalizedPath);
+	Resources[typeIndex][InNormalizedPath] = InResource;
+	return InResource;
+}
+
 template<>
 inline UShader* UResourceManager::Load(const FString& InFilePath, TArray<FShaderMacro>& InMacros)
 {
@@ -324,3 +471,20 @@ TArray<FString> UResourceManager::GetAllFilePaths()
 	}
 	return Paths;
 }
+
+template<typename T>
+TArray<FString> UResourceManager::GetAllAssetPaths()
+{
+	TArray<FString> Paths = FAssetRegistry::GetInstance().GetAssetPaths(GetResourceType<T>());
+
+	// 레지스트리 밖에서 로드된 리소스 (Data 외부 경로 등)
+	TSet<FString> Known(Paths.begin(), Paths.end());
+	for (const FString& Path : GetAllFilePaths<T>())
+	{
+		if (Known.insert(Path).second)
+		{
+			Paths.push_back(Path);
+		}
+	}
+	return Paths;
+}
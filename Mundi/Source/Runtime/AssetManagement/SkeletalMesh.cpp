@@ -2,6 +2,8 @@
 #include "SkeletalMesh.h"
 #include "Source/Editor/FBX/FbxLoader.h"
 #include "WindowsBinReader.h"
+#include "PackedVertex.h"
+#include "MeshLOD.h"
 #include <filesystem>
 
 IMPLEMENT_CLASS(USkeletalMesh)
@@ -61,11 +63,20 @@ bool USkeletalMesh::Load(const FString& InFilePath, ID3D11Device* InDevice)
     CreateIndexBuffer(Data, InDevice);
     VertexCount = static_cast<uint32>(Data->Vertices.size());
     IndexCount = static_cast<uint32>(Data->Indices.size());
-    CPUSkinnedVertexStride = sizeof(FVertexDynamic);
-    GPUSkinnedVertexStride = sizeof(FSkinnedVertex);
+    CPUSkinnedVertexStride = PackedVertex::GetStaticVertexStride();
+    GPUSkinnedVertexStride = PackedVertex::GetSkinnedVertexStride();
+    if (PackedVertex::IsEnabled())
+    {
+        PackedVertex::LogMemorySavings(InFilePath, VertexCount, sizeof(FSkinnedVertex), sizeof(FPackedSkinnedVertex));
+    }
     return true;
 }
 
+void USkeletalMesh::GetSectionRange(int32 LODIndex, uint32 SectionIndex, uint32& OutStartIndex, uint32& OutIndexCount) const
+{
+    MeshLOD::GetSectionRange(GetMeshGroupInfo(), IndexCount, GetLODs(), LODIndex, SectionIndex, OutStartIndex, OutIndexCount);
+}
+
 void USkeletalMesh::ReleaseResources()
 {
     if (IndexBuffer)
@@ -85,7 +96,9 @@ void USkeletalMesh::CreateCPUSkinnedVertexBuffer(ID3D11Buffer** InVertexBuffer)
 {
     if (!Data) { return; }
     ID3D11Device* Device = GEngine.GetRHIDevice()->GetDevice();
-    HRESULT hr = D3D11RHI::CreateVertexBuffer<FVertexDynamic>(Device, Data->Vertices, InVertexBuffer);
+    HRESULT hr = PackedVertex::IsEnabled()
+        ? D3D11RHI::CreateVertexBuffer<FPackedVertex>(Device, Data->Vertices, InVertexBuffer)
+        : D3D11RHI::CreateVertexBuffer<FVertexDynamic>(Device, Data->Vertices, InVertexBuffer);
     assert(SUCCEEDED(hr));
 }
 
@@ -96,7 +109,9 @@ void USkeletalMesh::CreateGPUSkinnedVertexBuffer(ID3D11Buffer** InVertexBuffer)
         return;
     }
     ID3D11Device* Device = GEngine.GetRHIDevice()->GetDevice();
-    HRESULT hr = D3D11RHI::CreateVertexBuffer<FSkinnedVertex>(Device, Data->Vertices, InVertexBuffer);
+    HRESULT hr = PackedVertex::IsEnabled()
+        ? D3D11RHI::CreateVertexBuffer<FPackedSkinnedVertex>(Device, Data->Vertices, InVertexBuffer)
+        : D3D11RHI::CreateVertexBuffer<FSkinnedVertex>(Device, Data->Vertices, InVertexBuffer);
     assert(SUCCEEDED(hr));
 }
 
@@ -107,6 +122,13 @@ void USkeletalMesh::UpdateVertexBuffer(const TArray<FNormalVertex>& SkinnedVerti
     GEngine.GetRHIDevice()->VertexBufferUpdate(InVertexBuffer, SkinnedVertices);
 }
 
+void USkeletalMesh::UpdateVertexBuffer(const TArray<FPackedVertex>& SkinnedVertices, ID3D11Buffer* InVertexBuffer)
+{
+    if (!InVertexBuffer) { return; }
+
+    GEngine.GetRHIDevice()->VertexBufferUpdate(InVertexBuffer, SkinnedVertices);
+}
+
 void USkeletalMesh::CreateStructuredBuffer(ID3D11Buffer** InStructuredBuffer, ID3D11ShaderResourceView** InShaderResourceView, UINT ElementCount)
 {
     if (!InStructuredBuffer || !InShaderResourceView || !Data)
@@ -31,9 +31,15 @@ public:
 
     uint64 GetMeshGroupCount() const { return Data ? Data->GroupInfos.size() : 0; }
 
+    // LOD (LOD0 = 원본, 인덱스 버퍼에 LOD0 뒤로 이어붙여 업로드)
+    const TArray<FMeshLOD>& GetLODs() const { static TArray<FMeshLOD> EmptyLODs; return Data ? Data->LODs : EmptyLODs; }
+    int32 GetNumLODs() const { return static_cast<int32>(GetLODs().size()) + 1; }
+    void GetSectionRange(int32 LODIndex, uint32 SectionIndex, uint32& OutStartIndex, uint32& OutIndexCount) const;
+
     void CreateCPUSkinnedVertexBuffer(ID3D11Buffer** InVertexBuffer);
     void CreateGPUSkinnedVertexBuffer(ID3D11Buffer** InVertexBuffer);
     void UpdateVertexBuffer(const TArray<FNormalVertex>& SkinnedVertices, ID3D11Buffer* InVertexBuffer);
+    void UpdateVertexBuffer(const TArray<FPackedVertex>& SkinnedVertices, ID3D11Buffer* InVertexBuffer);
     void CreateStructuredBuffer(ID3D11Buffer** InStructuredBuffer, ID3D11ShaderResourceView** InShaderResourceView, UINT ElementCount);
 
     void BuildLocalAABBs();
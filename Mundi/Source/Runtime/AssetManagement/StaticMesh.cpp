@@ -3,9 +3,11 @@
 #include "StaticMeshComponent.h"
 #include "ObjManager.h"
 #include "ResourceManager.h"
+#include "MeshLOD.h"
 #include "Source/Editor/FBX/FbxLoader.h"
 #include "Source/Runtime/Engine/Physics/BodySetup.h"
 #include "Source/Runtime/Core/Misc/PathUtils.h"
+#include "Source/Runtime/Core/Misc/PackedVertex.h"
 #include "Source/Runtime/Core/Misc/WindowsBinReader.h"
 #include "Source/Runtime/Core/Misc/WindowsBinWriter.h"
 #include <filesystem>
@@ -35,8 +37,9 @@ namespace
         // 인덱스 복사
         StaticMesh->Indices = SkeletalData.Indices;
 
-        // 그룹 정보 복사
+        // 그룹/LOD 정보 복사 (LOD 인덱스는 정점 순서가 같으므로 그대로 사용)
         StaticMesh->GroupInfos = SkeletalData.GroupInfos;
+        StaticMesh->LODs = SkeletalData.LODs;
         StaticMesh->bHasMaterial = SkeletalData.bHasMaterial;
 
         // 캐시 경로 복사
@@ -88,19 +91,67 @@ bool UStaticMesh::Load(const FString& InFilePath, ID3D11Device* InDevice, EVerte
         StaticMeshAsset = FObjManager::LoadObjStaticMeshAsset(InFilePath);
     }
 
+    InitFromStaticMeshAsset(InDevice);
+    return true;
+}
+
+bool UStaticMesh::LoadAsyncPayload(const FString& InFilePath, EVertexLayoutType InVertexType)
+{
+    SetVertexType(InVertexType);
+    PendingFilePath = InFilePath;
+
+    std::filesystem::path FilePath(InFilePath);
+    FString Extension = FilePath.extension().string();
+    std::transform(Extension.begin(), Extension.end(), Extension.begin(), ::tolower);
+    if (Extension != ".obj")
+    {
+        return true;
+    }
+
+    PendingMeshAsset = std::make_unique<FStaticMesh>();
+    if (!FObjManager::LoadObjStaticMeshData(InFilePath, *PendingMeshAsset, PendingMaterialInfos))
+    {
+        PendingMeshAsset.reset();
+        return false;
+    }
+    return true;
+}
+
+bool UStaticMesh::FinalizeAsyncLoad(ID3D11Device* InDevice)
+{
+    assert(InDevice);
+
+    // .fbx 등 워커에서 준비하지 않은 포맷은 기존 동기 경로로 로드
+    if (!PendingMeshAsset)
+    {
+        return Load(PendingFilePath, InDevice, VertexType);
+    }
+
+    StaticMeshAsset = FObjManager::RegisterObjStaticMeshAsset(PendingFilePath, PendingMeshAsset.release(), PendingMaterialInfos);
+    PendingMaterialInfos.Empty();
+    PendingFilePath.clear();
+
+    InitFromStaticMeshAsset(InDevice);
+    return true;
+}
+
+void UStaticMesh::InitFromStaticMeshAsset(ID3D11Device* InDevice)
+{
     // 빈 버텍스, 인덱스로 버퍼 생성 방지
     if (StaticMeshAsset && 0 < StaticMeshAsset->Vertices.size() && 0 < StaticMeshAsset->Indices.size())
     {
         CacheFilePath = StaticMeshAsset->CacheFilePath;
-        CreateVertexBuffer(StaticMeshAsset, InDevice, InVertexType);
+        CreateVertexBuffer(StaticMeshAsset, InDevice, VertexType);
         CreateIndexBuffer(StaticMeshAsset, InDevice);
         CreateLocalBound(StaticMeshAsset);
         CreateBodySetupFromBounds();
         InitConvexMesh();
         VertexCount = static_cast<uint32>(StaticMeshAsset->Vertices.size());
         IndexCount = static_cast<uint32>(StaticMeshAsset->Indices.size());
+
+        // 쿠킹된 BVH가 없으면(FBX 등) 첫 피킹 전에 워커에서 미리 빌드
+        UResourceManager::GetInstance().RequestMeshBVHBuild(GetAssetPathFileName(), StaticMeshAsset);
     }
-    return true;
 }
 
 bool UStaticMesh::Load(FMeshData* InData, ID3D11Device* InDevice, EVertexLayoutType InVertexType)
@@ -129,6 +180,13 @@ bool UStaticMesh::Load(FMeshData* InData, ID3D11Device* InDevice, EVertexLayoutT
     return true;
 }
 
+void UStaticMesh::GetSectionRange(int32 LODIndex, uint32 SectionIndex, uint32& OutStartIndex, uint32& OutIndexCount) const
+{
+    static const TArray<FGroupInfo> EmptyGroups;
+    const TArray<FGroupInfo>& Groups = StaticMeshAsset ? StaticMeshAsset->GroupInfos : EmptyGroups;
+    MeshLOD::GetSectionRange(Groups, IndexCount, GetLODs(), LODIndex, SectionIndex, OutStartIndex, OutIndexCount);
+}
+
 void UStaticMesh::SetVertexType(EVertexLayoutType InVertexType)
 {
     VertexType = InVertexType;
@@ -140,7 +198,7 @@ void UStaticMesh::SetVertexType(EVertexLayoutType InVertexType)
         Stride = sizeof(FVertexSimple);
         break;
     case EVertexLayoutType::PositionColorTexturNormal:
-        Stride = sizeof(FVertexDynamic);
+        Stride = PackedVertex::GetStaticVertexStride();
         break;
     case EVertexLayoutType::PositionTextBillBoard:
         Stride = sizeof(FBillboardVertexInfo_GPU);
@@ -158,14 +216,29 @@ void UStaticMesh::SetVertexType(EVertexLayoutType InVertexType)
 void UStaticMesh::CreateVertexBuffer(FMeshData* InMeshData, ID3D11Device* InDevice, EVertexLayoutType InVertexType)
 {
     HRESULT hr;
-    hr = D3D11RHI::CreateVertexBuffer<FVertexDynamic>(InDevice, *InMeshData, &VertexBuffer);
+    if (PackedVertex::IsEnabled())
+    {
+        hr = D3D11RHI::CreateVertexBuffer<FPackedVertex>(InDevice, *InMeshData, &VertexBuffer);
+    }
+    else
+    {
+        hr = D3D11RHI::CreateVertexBuffer<FVertexDynamic>(InDevice, *InMeshData, &VertexBuffer);
+    }
     assert(SUCCEEDED(hr));
 }
 
 void UStaticMesh::CreateVertexBuffer(FStaticMesh* InStaticMesh, ID3D11Device* InDevice, EVertexLayoutType InVertexType)
 {
     HRESULT hr;
-    hr = D3D11RHI::CreateVertexBuffer<FVertexDynamic>(InDevice, InStaticMesh->Vertices, &VertexBuffer);
+    if (PackedVertex::IsEnabled())
+    {
+        hr = D3D11RHI::CreateVertexBuffer<FPackedVertex>(InDevice, InStaticMesh->Vertices, &VertexBuffer);
+        PackedVertex::LogMemorySavings(InStaticMesh->PathFileName, InStaticMesh->Vertices.size(), sizeof(FVertexDynamic), sizeof(FPackedVertex));
+    }
+    else
+    {
+        hr = D3D11RHI::CreateVertexBuffer<FVertexDynamic>(InDevice, InStaticMesh->Vertices, &VertexBuffer);
+    }
     assert(SUCCEEDED(hr));
 }
 
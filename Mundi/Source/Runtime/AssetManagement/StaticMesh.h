@@ -17,6 +17,12 @@ public:
     bool Load(const FString& InFilePath, ID3D11Device* InDevice, EVertexLayoutType InVertexType = EVertexLayoutType::PositionColorTexturNormal);
     bool Load(FMeshData* InData, ID3D11Device* InDevice, EVertexLayoutType InVertexType = EVertexLayoutType::PositionColorTexturNormal);
 
+    // --- 비동기 로드 (UResourceManager::LoadAsync) ---
+    // 워커 스레드: .obj 캐시 로드/파싱만 수행 (.fbx는 FBX SDK가 스레드 안전하지 않아 Finalize에서 동기 로드)
+    bool LoadAsyncPayload(const FString& InFilePath, EVertexLayoutType InVertexType = EVertexLayoutType::PositionColorTexturNormal);
+    // 게임 스레드: 머티리얼 등록 + GPU 버퍼 생성
+    bool FinalizeAsyncLoad(ID3D11Device* InDevice);
+
     ID3D11Buffer* GetVertexBuffer() const { return VertexBuffer; }
     ID3D11Buffer* GetIndexBuffer() const { return IndexBuffer; }
     uint32 GetVertexCount() const { return VertexCount; }
@@ -34,6 +40,12 @@ public:
     bool HasMaterial() const { return StaticMeshAsset->bHasMaterial; }
 
     uint64 GetMeshGroupCount() const { return StaticMeshAsset->GroupInfos.size(); }
+
+    // --- LOD (LOD0 = 원본, 인덱스 버퍼에 LOD0 뒤로 이어붙여 업로드) ---
+    const TArray<FMeshLOD>& GetLODs() const { static TArray<FMeshLOD> EmptyLODs; return StaticMeshAsset ? StaticMeshAsset->LODs : EmptyLODs; }
+    int32 GetNumLODs() const { return static_cast<int32>(GetLODs().size()) + 1; }
+    /** 인덱스 버퍼 기준 섹션 범위 (그룹이 없으면 SectionIndex 0이 전체) */
+    void GetSectionRange(int32 LODIndex, uint32 SectionIndex, uint32& OutStartIndex, uint32& OutIndexCount) const;
     
     FAABB GetLocalBound() const {return LocalBound; }
     
@@ -48,13 +60,14 @@ private:
     void CreateLocalBound(const FStaticMesh* InStaticMesh);
     void CreateBodySetupFromBounds();
     void InitConvexMesh();
+    void InitFromStaticMeshAsset(ID3D11Device* InDevice);
     void ReleaseResources();
 
 public:
     UBodySetup* BodySetup = nullptr;
 
 private:
-    FString CacheFilePath;  // 캐시된 소스 경로 (예: DerivedDataCache/cube.obj.bin)
+    FString CacheFilePath;  // 캐시된 소스 경로 (예: DerivedDataCache/cube.obj.cooked)
 
     // GPU 리소스
     ID3D11Buffer* VertexBuffer = nullptr;
@@ -67,9 +80,13 @@ private:
 	// CPU 리소스
     FStaticMesh* StaticMeshAsset = nullptr;
 
-    // 메시 단위 BVH (ResourceManager에서 캐싱, 소유)
-    // 초기화되지 않는 멤버변수 (참조도 ResourceManager에서만 이루어짐) 
-    // FMeshBVH* MeshBVH = nullptr;
+    // 비동기 로드 중간 결과 (워커 → 게임 스레드 전달용, Finalize 후 비워짐)
+    FString PendingFilePath;
+    std::unique_ptr<FStaticMesh> PendingMeshAsset;
+    TArray<FMaterialInfo> PendingMaterialInfos;
+
+    // 메시 단위 BVH는 FStaticMesh::MeshBVH(쿠킹 캐시에서 로드) 또는 ResourceManager 캐시(쿠킹되지 않은 메시)가 소유
+    // 조회는 UResourceManager::GetOrBuildMeshBVH
 
     // 로컬 AABB. (스태틱메시 액터 전체 경계 계산에 사용. StaticMeshAsset 로드할 때마다 갱신)
     FAABB LocalBound;
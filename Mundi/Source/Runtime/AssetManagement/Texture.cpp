@@ -3,10 +3,74 @@
 #include "TextureConverter.h"
 #include "DDSTextureLoader.h"
 #include "WICTextureLoader.h"
+#include <DirectXTex.h>
 #include <filesystem>
 
 IMPLEMENT_CLASS(UTexture)
 
+namespace
+{
+	// 디코딩된 이미지의 차원에 맞는 SRV 설명 (DDSTextureLoader가 만들던 뷰와 동일: 큐브맵은 TEXTURECUBE)
+	D3D11_SHADER_RESOURCE_VIEW_DESC MakeShaderResourceViewDesc(const DirectX::TexMetadata& Metadata, DXGI_FORMAT ViewFormat)
+	{
+		D3D11_SHADER_RESOURCE_VIEW_DESC Desc = {};
+		Desc.Format = ViewFormat;
+
+		const UINT MipLevels = static_cast<UINT>(Metadata.mipLevels);
+		const UINT ArraySize = static_cast<UINT>(Metadata.arraySize);
+		switch (Metadata.dimension)
+		{
+		case DirectX::TEX_DIMENSION_TEXTURE1D:
+			if (ArraySize > 1)
+			{
+				Desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE1DARRAY;
+				Desc.Texture1DArray.MipLevels = MipLevels;
+				Desc.Texture1DArray.ArraySize = ArraySize;
+			}
+			else
+			{
+				Desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE1D;
+				Desc.Texture1D.MipLevels = MipLevels;
+			}
+			break;
+
+		case DirectX::TEX_DIMENSION_TEXTURE3D:
+			Desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE3D;
+			Desc.Texture3D.MipLevels = MipLevels;
+			break;
+
+		default:
+			if (Metadata.IsCubemap())
+			{
+				if (ArraySize > 6)
+				{
+					Desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+					Desc.TextureCubeArray.MipLevels = MipLevels;
+					Desc.TextureCubeArray.NumCubes = ArraySize / 6;
+				}
+				else
+				{
+					Desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+					Desc.TextureCube.MipLevels = MipLevels;
+				}
+			}
+			else if (ArraySize > 1)
+			{
+				Desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+				Desc.Texture2DArray.MipLevels = MipLevels;
+				Desc.Texture2DArray.ArraySize = ArraySize;
+			}
+			else
+			{
+				Desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+				Desc.Texture2D.MipLevels = MipLevels;
+			}
+			break;
+		}
+		return Desc;
+	}
+}
+
 UTexture::UTexture()
 {
 	Width = 0;
@@ -23,6 +87,16 @@ bool UTexture::Load(const FString& InFilePath, ID3D11Device* InDevice, bool bSRG
 {
 	assert(InDevice);
 
+	// 동기 로드도 비동기 로드와 같은 두 단계를 호출 스레드에서 연달아 실행
+	if (!LoadAsyncPayload(InFilePath, bSRGB))
+	{
+		return false;
+	}
+	return FinalizeAsyncLoad(InDevice);
+}
+
+bool UTexture::LoadAsyncPayload(const FString& InFilePath, bool bSRGB)
+{
 	// 실제로 로드할 파일 경로 결정
 	FString ActualLoadPath = InFilePath;
 
@@ -96,57 +170,109 @@ bool UTexture::Load(const FString& InFilePath, ID3D11Device* InDevice, bool bSRG
 	std::wstring ext = LoadPath.has_extension() ? LoadPath.extension().wstring() : L"";
 	for (auto& ch : ext) ch = static_cast<wchar_t>(::towlower(ch));
 
+	// 파일을 읽어 이 스레드에서 디코딩까지 끝내 둠 (GPU 리소스 생성만 FinalizeAsyncLoad에서)
+	std::ifstream File(std::filesystem::path(WFilePath), std::ios::binary | std::ios::ate);
+	if (!File.is_open())
+	{
+		UE_LOG("[UTexture] Failed to open texture file: %s", ActualLoadPath.c_str());
+		return false;
+	}
+
+	const std::streamsize FileSize = File.tellg();
+	if (FileSize <= 0)
+	{
+		UE_LOG("[UTexture] Texture file is empty: %s", ActualLoadPath.c_str());
+		return false;
+	}
+
+	TArray<uint8> FileData;
+	FileData.SetNum(static_cast<int32>(FileSize));
+	File.seekg(0, std::ios::beg);
+	if (!File.read(reinterpret_cast<char*>(FileData.data()), FileSize))
+	{
+		UE_LOG("[UTexture] Failed to read texture file: %s", ActualLoadPath.c_str());
+		return false;
+	}
+
+	// DDS/WIC 디코딩 (WIC는 COM 사용 - 워커 스레드는 FTaskGraph::WorkerMain에서 초기화됨)
+	std::unique_ptr<DirectX::ScratchImage> Image = std::make_unique<DirectX::ScratchImage>();
 	HRESULT hr = E_FAIL;
 	if (ext == L".dds")
 	{
-		// DDS 로딩: Ex 버전 사용하여 sRGB 지정
-		hr = DirectX::CreateDDSTextureFromFileEx(
-			InDevice,
-			WFilePath.c_str(),
-			0, // maxsize (0 = no limit)
-			D3D11_USAGE_DEFAULT,
-			D3D11_BIND_SHADER_RESOURCE,
-			0, // cpuAccessFlags
-			0, // miscFlags
-			bSRGB ? DirectX::DDS_LOADER_FORCE_SRGB : DirectX::DDS_LOADER_DEFAULT,
-			reinterpret_cast<ID3D11Resource**>(&Texture2D),
-			&ShaderResourceView
-		);
+		hr = DirectX::LoadFromDDSMemory(FileData.data(), FileData.size(), DirectX::DDS_FLAGS_NONE, nullptr, *Image);
 	}
 	else
 	{
-		// WIC 로딩: Ex 버전 사용하여 sRGB 지정
-		hr = DirectX::CreateWICTextureFromFileEx(
-			InDevice,
-			WFilePath.c_str(),
-			0, // maxsize (0 = no limit)
-			D3D11_USAGE_DEFAULT,
-			D3D11_BIND_SHADER_RESOURCE,
-			0, // cpuAccessFlags
-			0, // miscFlags
-			bSRGB ? DirectX::WIC_LOADER_FORCE_SRGB : DirectX::WIC_LOADER_DEFAULT,
-			reinterpret_cast<ID3D11Resource**>(&Texture2D),
-			&ShaderResourceView
-		);
+		hr = DirectX::LoadFromWICMemory(FileData.data(), FileData.size(), DirectX::WIC_FLAGS_NONE, nullptr, *Image);
+	}
+
+	if (FAILED(hr))
+	{
+		UE_LOG("[UTexture] Failed to decode texture: %s (HRESULT: 0x%08X)", ActualLoadPath.c_str(), hr);
+		return false;
 	}
 
+	PendingImage = std::move(Image);
+	PendingLoadPath = ActualLoadPath;
+	bPendingSRGB = bSRGB;
+	return true;
+}
+
+bool UTexture::FinalizeAsyncLoad(ID3D11Device* InDevice)
+{
+	assert(InDevice);
+
+	if (!PendingImage)
+	{
+		return false;
+	}
+
+	// 디코딩된 이미지로 텍스처/SRV만 생성 (sRGB 지정은 기존 *_LOADER_FORCE_SRGB와 동일하게 포맷만 sRGB로)
+	const DirectX::TexMetadata& Metadata = PendingImage->GetMetadata();
+	const DXGI_FORMAT ViewFormat = bPendingSRGB ? DirectX::MakeSRGB(Metadata.format) : Metadata.format;
+	ID3D11Resource* Resource = nullptr;
+	HRESULT hr = DirectX::CreateTextureEx(
+		InDevice,
+		PendingImage->GetImages(),
+		PendingImage->GetImageCount(),
+		Metadata,
+		D3D11_USAGE_DEFAULT,
+		D3D11_BIND_SHADER_RESOURCE,
+		0, // cpuAccessFlags
+		0, // miscFlags
+		bPendingSRGB ? DirectX::CREATETEX_FORCE_SRGB : DirectX::CREATETEX_DEFAULT,
+		&Resource
+	);
+
 	if (SUCCEEDED(hr))
 	{
-		if (Texture2D)
-		{
-			D3D11_TEXTURE2D_DESC desc;
-			Texture2D->GetDesc(&desc);
-			Width = desc.Width;
-			Height = desc.Height;
-			Format = desc.Format;
-		}
+		const D3D11_SHADER_RESOURCE_VIEW_DESC ViewDesc = MakeShaderResourceViewDesc(Metadata, ViewFormat);
+		hr = InDevice->CreateShaderResourceView(Resource, &ViewDesc, &ShaderResourceView);
 	}
-	else
+
+	const uint32 LoadedWidth = static_cast<uint32>(Metadata.width);
+	const uint32 LoadedHeight = static_cast<uint32>(Metadata.height);
+
+	// 디코딩된 픽셀은 GPU에 올라간 뒤로 필요 없음
+	PendingImage.reset();
+
+	if (FAILED(hr))
 	{
-		UE_LOG("[UTexture] Failed to load texture: %s (HRESULT: 0x%08X)", ActualLoadPath.c_str(), hr);
+		if (Resource)
+		{
+			Resource->Release();
+		}
+		UE_LOG("[UTexture] Failed to load texture: %s (HRESULT: 0x%08X)", PendingLoadPath.c_str(), hr);
 		return false;
 	}
-	
+
+	// 2D가 아닌 리소스(볼륨 텍스처 등)는 SRV로만 사용
+	Resource->QueryInterface(__uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&Texture2D));
+	Resource->Release();
+
+	Width = LoadedWidth;
+	Height = LoadedHeight;
+	Format = ViewFormat;
 	return true;
 }
 
@@ -2,6 +2,8 @@
 #include "ResourceBase.h"
 #include <d3d11.h>
 
+namespace DirectX { class ScratchImage; }
+
 class UTexture : public UResourceBase
 {
 public:
@@ -14,6 +16,12 @@ public:
 	// bSRGB: true = sRGB 포맷 사용 (Diffuse/Albedo 텍스처), false = Linear 포맷 (Normal/Data 텍스처)
 	bool Load(const FString& InFilePath, ID3D11Device* InDevice, bool bSRGB = true);
 
+	// --- 비동기 로드 (UResourceManager::LoadAsync) ---
+	// 워커 스레드: DDS 캐시 변환 + 파일 읽기 + DirectXTex 디코딩 (디바이스 접근 없음)
+	bool LoadAsyncPayload(const FString& InFilePath, bool bSRGB = true);
+	// 게임 스레드: 디코딩된 이미지로 GPU 텍스처/SRV만 생성
+	bool FinalizeAsyncLoad(ID3D11Device* InDevice);
+
 	ID3D11ShaderResourceView* GetShaderResourceView() const { return ShaderResourceView; }
 	ID3D11Texture2D* GetTexture2D() const { return Texture2D; }
 
@@ -35,4 +43,9 @@ private:
 	uint32 Width = 0;
 	uint32 Height = 0;
 	DXGI_FORMAT Format = DXGI_FORMAT_UNKNOWN;
+
+	// LoadAsyncPayload → FinalizeAsyncLoad 사이에만 유지되는 디코딩 결과
+	std::unique_ptr<DirectX::ScratchImage> PendingImage;
+	FString PendingLoadPath;
+	bool bPendingSRGB = true;
 };
@@ -0,0 +1,494 @@
+﻿#include "pch.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+
+namespace
+{
+    // 현재 스레드의 워커 인덱스 (게임/렌더 스레드 등 워커가 아니면 -1)
+    thread_local int32 GWorkerIndex = -1;
+
+    // 잠들기 전에 작업을 다시 찾아보는 횟수
+    constexpr int32 SpinCountBeforeSleep = 64;
+}
+
+// ──────────────────────────────────────────────
+// FTaskHandle
+// ──────────────────────────────────────────────
+
+void FTaskHandle::Wait() const
+{
+    if (!Task)
+    {
+        return;
+    }
+
+    FTaskGraph& TaskGraph = FTaskGraph::GetInstance();
+    while (!Task->IsCompleted())
+    {
+        // 기다리는 동안 놀지 않고 다른 작업을 대신 처리
+        if (!TaskGraph.TryExecuteOneTask())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+FTaskHandle FTaskHandle::Then(std::function<void()> Work) const
+{
+    TArray<FTaskHandle> Prerequisites;
+    if (Task)
+    {
+        Prerequisites.Add(*this);
+    }
+    return FTaskGraph::GetInstance().Launch(std::move(Work), Prerequisites);
+}
+
+// ──────────────────────────────────────────────
+// FWorkStealingDeque (Chase-Lev)
+// ──────────────────────────────────────────────
+
+bool FTaskGraph::FWorkStealingDeque::Push(FTask* Task)
+{
+    const int64 B = Bottom.load(std::memory_order_relaxed);
+    const int64 T = Top.load(std::memory_order_acquire);
+    if (B - T >= Capacity)
+    {
+        return false;   // 가득 참 → 호출부에서 전역 큐로
+    }
+
+    Buffer[B & (Capacity - 1)].store(Task, std::memory_order_relaxed);
+    Bottom.store(B + 1, std::memory_order_release);
+    return true;
+}
+
+FTask* FTaskGraph::FWorkStealingDeque::Pop()
+{
+    const int64 B = Bottom.load(std::memory_order_relaxed) - 1;
+    Bottom.store(B, std::memory_order_seq_cst);
+    int64 T = Top.load(std::memory_order_seq_cst);
+
+    if (T > B)
+    {
+        // 비어 있음
+        Bottom.store(B + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    FTask* Task = Buffer[B & (Capacity - 1)].load(std::memory_order_relaxed);
+    if (T == B)
+    {
+        // 마지막 하나: 훔치려는 스레드와 경쟁
+        if (!Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            Task = nullptr;
+        }
+        Bottom.store(B + 1, std::memory_order_relaxed);
+    }
+    return Task;
+}
+
+FTask* FTaskGraph::FWorkStealingDeque::Steal()
+{
+    int64 T = Top.load(std::memory_order_seq_cst);
+    const int64 B = Bottom.load(std::memory_order_seq_cst);
+    if (T >= B)
+    {
+        return nullptr;
+    }
+
+    FTask* Task = Buffer[T & (Capacity - 1)].load(std::memory_order_relaxed);
+    if (!Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;   // 다른 스레드가 먼저 가져감
+    }
+    return Task;
+}
+
+// ──────────────────────────────────────────────
+// FTaskGraph
+// ──────────────────────────────────────────────
+
+FTaskGraph& FTaskGraph::GetInstance()
+{
+    static FTaskGraph Instance;
+    return Instance;
+}
+
+FTaskGraph::~FTaskGraph()
+{
+    Shutdown();
+}
+
+int32 FTaskGraph::GetCurrentWorkerIndex()
+{
+    return GWorkerIndex;
+}
+
+void FTaskGraph::Initialize(int32 NumWorkers)
+{
+    if (IsRunning())
+    {
+        return;
+    }
+
+    if (NumWorkers <= 0)
+    {
+        // 게임 스레드 몫으로 코어 하나를 남김
+        NumWorkers = std::max(1, static_cast<int32>(std::thread::hardware_concurrency()) - 1);
+    }
+
+    bStopRequested.store(false);
+
+    // 워커 배열은 스레드 시작 전에 확정 (실행 중에는 다른 워커의 덱을 인덱스로 접근)
+    Workers.Empty();
+    Workers.Reserve(NumWorkers);
+    for (int32 i = 0; i < NumWorkers; ++i)
+    {
+        Workers.Emplace(std::make_unique<FWorker>());
+    }
+
+    bRunning.store(true);
+    for (int32 i = 0; i < NumWorkers; ++i)
+    {
+        Workers[i]->Thread = std::thread(&FTaskGraph::WorkerMain, this, i);
+    }
+
+    UE_LOG("TaskGraph: Started %d worker threads", NumWorkers);
+}
+
+void FTaskGraph::Shutdown()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock(WakeMutex);
+        bStopRequested.store(true);
+    }
+    WakeCondition.notify_all();
+
+    for (std::unique_ptr<FWorker>& Worker : Workers)
+    {
+        if (Worker->Thread.joinable())
+        {
+            Worker->Thread.join();
+        }
+    }
+
+    bRunning.store(false);
+
+    // 워커 종료 직전에 비-워커 스레드가 넣은 작업이 남아 있을 수 있음
+    FTask* Task = nullptr;
+    while (GlobalQueue.Dequeue(Task))
+    {
+        NumQueuedTasks.fetch_sub(1);
+        Execute(Task);
+    }
+
+    Workers.Empty();
+}
+
+FTaskHandle FTaskGraph::Launch(std::function<void()> Work)
+{
+    std::shared_ptr<FTask> Task = std::make_shared<FTask>(std::move(Work));
+
+    // 선행 작업이 없으므로 보류 카운트만 해제하고 바로 예약
+    Task->NumPendingPrerequisites.store(0, std::memory_order_relaxed);
+    Schedule(Task);
+    return FTaskHandle(std::move(Task));
+}
+
+FTaskHandle FTaskGraph::Launch(std::function<void()> Work, const TArray<FTaskHandle>& Prerequisites)
+{
+    std::shared_ptr<FTask> Task = std::make_shared<FTask>(std::move(Work));
+
+    for (const FTaskHandle& Prerequisite : Prerequisites)
+    {
+        if (!Prerequisite.Task)
+        {
+            continue;
+        }
+
+        // 완료 처리(Complete)와 같은 잠금 안에서 확인해야 후속 등록이 누락되지 않음
+        std::lock_guard<std::mutex> Lock(Prerequisite.Task->SubsequentsLock);
+        if (!Prerequisite.Task->IsCompleted())
+        {
+            Task->NumPendingPrerequisites.fetch_add(1, std::memory_order_relaxed);
+            Prerequisite.Task->Subsequents.Add(Task);
+        }
+    }
+
+    // 등록 중 선행 작업이 끝나도 실행되지 않도록 잡아둔 보류 카운트 해제
+    if (Task->NumPendingPrerequisites.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        Schedule(Task);
+    }
+    return FTaskHandle(std::move(Task));
+}
+
+void FTaskGraph::Schedule(const std::shared_ptr<FTask>& Task)
+{
+    if (!IsRunning())
+    {
+        // 스케줄러가 없으면 호출 스레드에서 즉시 실행
+        Task->SelfReference = Task;
+        Execute(Task.get());
+        return;
+    }
+
+    Task->SelfReference = Task;
+
+    const int32 WorkerIndex = GWorkerIndex;
+    bool bQueued = false;
+    if (WorkerIndex >= 0)
+    {
+        bQueued = Workers[WorkerIndex]->Deque.Push(Task.get());
+    }
+    if (!bQueued)
+    {
+        bQueued = GlobalQueue.Enqueue(Task.get());
+    }
+    if (!bQueued)
+    {
+        // 모든 큐가 가득 참 - 역압(back-pressure)으로 직접 실행
+        Execute(Task.get());
+        return;
+    }
+
+    NumQueuedTasks.fetch_add(1);
+    if (NumSleepingWorkers.load() > 0)
+    {
+        std::lock_guard<std::mutex> Lock(WakeMutex);
+        WakeCondition.notify_one();
+    }
+}
+
+void FTaskGraph::Execute(FTask* Task)
+{
+    // 큐가 들고 있던 참조를 넘겨받아 실행이 끝날 때까지 수명 보장
+    std::shared_ptr<FTask> Keep = std::move(Task->SelfReference);
+
+    Task->Work();
+    // 캡처된 리소스를 핸들 수명과 무관하게 즉시 해제
+    Task->Work = nullptr;
+
+    Complete(Task);
+    NumExecutedTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FTaskGraph::Complete(FTask* Task)
+{
+    TArray<std::shared_ptr<FTask>> ReadySubsequents;
+    {
+        std::lock_guard<std::mutex> Lock(Task->SubsequentsLock);
+        Task->bCompleted.store(true, std::memory_order_release);
+        ReadySubsequents = std::move(Task->Subsequents);
+    }
+
+    for (std::shared_ptr<FTask>& Subsequent : ReadySubsequents)
+    {
+        if (Subsequent->NumPendingPrerequisites.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Schedule(Subsequent);
+        }
+    }
+}
+
+FTask* FTaskGraph::FindWork(int32 WorkerIndex)
+{
+    FTask* Task = nullptr;
+
+    // 1) 자기 덱 (LIFO - 캐시에 남아 있는 최근 작업부터)
+    if (WorkerIndex >= 0)
+    {
+        Task = Workers[WorkerIndex]->Deque.Pop();
+    }
+
+    // 2) 외부 스레드가 넣은 작업
+    if (!Task)
+    {
+        GlobalQueue.Dequeue(Task);
+    }
+
+    // 3) 다른 워커의 덱에서 훔치기 (자기 다음 인덱스부터 돌아가며)
+    if (!Task)
+    {
+        const int32 NumWorkers = GetNumWorkers();
+        const int32 Start = WorkerIndex >= 0 ? WorkerIndex + 1 : 0;
+        for (int32 i = 0; i < NumWorkers && !Task; ++i)
+        {
+            const int32 Victim = (Start + i) % NumWorkers;
+            if (Victim == WorkerIndex)
+            {
+                continue;
+            }
+            Task = Workers[Victim]->Deque.Steal();
+        }
+        if (Task)
+        {
+            NumStolenTasks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (Task)
+    {
+        NumQueuedTasks.fetch_sub(1);
+    }
+    return Task;
+}
+
+bool FTaskGraph::TryExecuteOneTask()
+{
+    if (!IsRunning())
+    {
+        return false;
+    }
+
+    FTask* Task = FindWork(GWorkerIndex);
+    if (!Task)
+    {
+        return false;
+    }
+
+    Execute(Task);
+    return true;
+}
+
+void FTaskGraph::WaitAll(const TArray<FTaskHandle>& Tasks)
+{
+    for (const FTaskHandle& Task : Tasks)
+    {
+        Task.Wait();
+    }
+}
+
+void FTaskGraph::WorkerMain(int32 WorkerIndex)
+{
+    GWorkerIndex = WorkerIndex;
+
+#if defined(_WIN32)
+    // 텍스처 디코딩(WIC/DirectXTex)처럼 COM을 쓰는 작업이 워커에서 돌므로 스레드 수명 동안 MTA로 초기화
+    const HRESULT ComResult = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+    int32 IdleSpins = 0;
+    while (true)
+    {
+        if (FTask* Task = FindWork(WorkerIndex))
+        {
+            Execute(Task);
+            IdleSpins = 0;
+            continue;
+        }
+
+        if (bStopRequested.load())
+        {
+            break;
+        }
+
+        if (++IdleSpins < SpinCountBeforeSleep)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // 새 작업이 들어오거나 종료 요청이 올 때까지 잠듦
+        std::unique_lock<std::mutex> Lock(WakeMutex);
+        NumSleepingWorkers.fetch_add(1);
+        WakeCondition.wait(Lock, [this]
+        {
+            return bStopRequested.load() || NumQueuedTasks.load() > 0;
+        });
+        NumSleepingWorkers.fetch_sub(1);
+        IdleSpins = 0;
+    }
+
+#if defined(_WIN32)
+    if (SUCCEEDED(ComResult))
+    {
+        ::CoUninitialize();
+    }
+#endif
+
+    GWorkerIndex = -1;
+}
+
+// ──────────────────────────────────────────────
+// ParallelFor
+// ──────────────────────────────────────────────
+
+namespace
+{
+    struct FParallelForContext
+    {
+        const std::function<void(int32, int32)>* Body = nullptr;
+        int32 Num = 0;
+        int32 GrainSize = 1;
+        int32 NumChunks = 0;
+        std::atomic<int32> NextChunk{ 0 };
+        std::atomic<int32> NumCompletedChunks{ 0 };
+
+        /** 남은 묶음을 하나씩 가져가 실행. 모든 묶음이 배분되면 반환 */
+        void Run()
+        {
+            while (true)
+            {
+                const int32 Chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (Chunk >= NumChunks)
+                {
+                    // Body는 호출자 스택에 있으므로 더 이상 접근하지 않음
+                    return;
+                }
+
+                const int32 Begin = Chunk * GrainSize;
+                const int32 End = std::min(Begin + GrainSize, Num);
+                (*Body)(Begin, End);
+                NumCompletedChunks.fetch_add(1, std::memory_order_release);
+            }
+        }
+    };
+}
+
+void ParallelForRange(int32 Num, const std::function<void(int32, int32)>& Body, int32 GrainSize)
+{
+    if (Num <= 0)
+    {
+        return;
+    }
+
+    GrainSize = std::max(1, GrainSize);
+    const int32 NumChunks = (Num + GrainSize - 1) / GrainSize;
+
+    FTaskGraph& TaskGraph = FTaskGraph::GetInstance();
+    if (NumChunks == 1 || !TaskGraph.IsRunning())
+    {
+        Body(0, Num);
+        return;
+    }
+
+    // 헬퍼 작업이 호출 반환 이후에 실행될 수 있으므로 컨텍스트는 공유 소유
+    std::shared_ptr<FParallelForContext> Context = std::make_shared<FParallelForContext>();
+    Context->Body = &Body;
+    Context->Num = Num;
+    Context->GrainSize = GrainSize;
+    Context->NumChunks = NumChunks;
+
+    // 묶음을 작업 하나씩으로 만들지 않고, 워커 수만큼의 헬퍼가 카운터로 묶음을 나눠 가짐
+    const int32 NumHelpers = std::min(NumChunks - 1, TaskGraph.GetNumWorkers());
+    for (int32 i = 0; i < NumHelpers; ++i)
+    {
+        TaskGraph.Launch([Context]() { Context->Run(); });
+    }
+
+    // 호출 스레드도 참여
+    Context->Run();
+
+    while (Context->NumCompletedChunks.load(std::memory_order_acquire) < NumChunks)
+    {
+        if (!TaskGraph.TryExecuteOneTask())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,170 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * 엔진 공용 작업 스케줄러 (work-stealing)
+ *
+ * - 워커 스레드마다 Chase-Lev 덱을 하나씩 가짐: 자기 덱은 LIFO로 꺼내고, 비면 다른 워커의 덱에서 FIFO로 훔침
+ * - 워커가 아닌 스레드(게임 스레드 등)에서 올린 작업은 전역 MPMC 큐로 들어감
+ * - 선행 작업(prerequisite)이 모두 끝나야 실행되는 의존성/연속 작업(Then) 지원
+ * - Wait()를 호출한 스레드는 기다리는 동안 다른 작업을 대신 실행 (데드락/유휴 방지)
+ * - Initialize() 전에는 모든 작업이 호출 스레드에서 즉시 실행됨 (툴/테스트 환경 호환)
+ *
+ * 사용 예)
+ *   FTaskHandle A = FTaskGraph::GetInstance().Launch([] { ... });
+ *   FTaskHandle B = A.Then([] { ... });
+ *   ParallelFor(Num, [&](int32 Index) { ... }, 256);
+ *   B.Wait();
+ */
+
+class FTaskGraph;
+
+/** 스케줄러 내부 작업 단위 */
+class FTask
+{
+public:
+    explicit FTask(std::function<void()>&& InWork) : Work(std::move(InWork)) {}
+
+    bool IsCompleted() const { return bCompleted.load(std::memory_order_acquire); }
+
+private:
+    friend class FTaskGraph;
+    friend class FTaskHandle;
+
+    std::function<void()> Work;
+
+    // 남은 선행 작업 수 (+1은 Launch 중 조기 실행을 막는 보류 카운트)
+    std::atomic<int32> NumPendingPrerequisites{ 1 };
+    std::atomic<bool> bCompleted{ false };
+
+    // 이 작업이 끝나면 실행 가능해지는 후속 작업들
+    std::mutex SubsequentsLock;
+    TArray<std::shared_ptr<FTask>> Subsequents;
+
+    // 큐에 들어가 있는 동안 스스로를 살려두는 참조 (실행 직후 해제)
+    std::shared_ptr<FTask> SelfReference;
+};
+
+/** 작업 핸들 - 완료 확인/대기/연속 작업 연결 */
+class FTaskHandle
+{
+public:
+    FTaskHandle() = default;
+    explicit FTaskHandle(std::shared_ptr<FTask> InTask) : Task(std::move(InTask)) {}
+
+    bool IsValid() const { return Task != nullptr; }
+    /** 유효하지 않은 핸들은 완료된 것으로 취급 */
+    bool IsCompleted() const { return !Task || Task->IsCompleted(); }
+
+    /** 완료될 때까지 대기 (대기 중 다른 작업을 실행) */
+    void Wait() const;
+
+    /** 이 작업이 끝난 뒤 실행될 작업을 등록 */
+    FTaskHandle Then(std::function<void()> Work) const;
+
+    void Reset() { Task.reset(); }
+
+private:
+    friend class FTaskGraph;
+    std::shared_ptr<FTask> Task;
+};
+
+class FTaskGraph
+{
+public:
+    static FTaskGraph& GetInstance();
+
+    /** @param NumWorkers 0 이하이면 (논리 코어 수 - 1) */
+    void Initialize(int32 NumWorkers = 0);
+    /** 남은 작업을 모두 실행한 뒤 워커를 종료. 엔진 Shutdown에서 호출 */
+    void Shutdown();
+
+    bool IsRunning() const { return bRunning.load(std::memory_order_acquire); }
+    int32 GetNumWorkers() const { return static_cast<int32>(Workers.size()); }
+    /** 현재 스레드의 워커 인덱스 (워커가 아니면 -1) */
+    static int32 GetCurrentWorkerIndex();
+
+    /** 선행 작업 없이 바로 실행 가능한 작업 */
+    FTaskHandle Launch(std::function<void()> Work);
+    /** Prerequisites가 모두 끝난 뒤 실행되는 작업 */
+    FTaskHandle Launch(std::function<void()> Work, const TArray<FTaskHandle>& Prerequisites);
+
+    /** 대기 중인 작업 하나를 현재 스레드에서 실행. 실행했으면 true */
+    bool TryExecuteOneTask();
+
+    void WaitAll(const TArray<FTaskHandle>& Tasks);
+
+    // --- 통계 (오버헤드 측정용) ---
+    uint64 GetNumExecutedTasks() const { return NumExecutedTasks.load(std::memory_order_relaxed); }
+    uint64 GetNumStolenTasks() const { return NumStolenTasks.load(std::memory_order_relaxed); }
+
+private:
+    FTaskGraph() = default;
+    ~FTaskGraph();
+    FTaskGraph(const FTaskGraph&) = delete;
+    FTaskGraph& operator=(const FTaskGraph&) = delete;
+
+    /** Chase-Lev work-stealing 덱 (소유 워커만 Push/Pop, 나머지는 Steal) */
+    class FWorkStealingDeque
+    {
+    public:
+        static constexpr int64 Capacity = 4096;
+
+        bool Push(FTask* Task);
+        FTask* Pop();
+        FTask* Steal();
+
+    private:
+        alignas(64) std::atomic<int64> Top{ 0 };
+        alignas(64) std::atomic<int64> Bottom{ 0 };
+        std::atomic<FTask*> Buffer[Capacity] = {};
+    };
+
+    struct FWorker
+    {
+        std::thread Thread;
+        FWorkStealingDeque Deque;
+    };
+
+    void WorkerMain(int32 WorkerIndex);
+    void Schedule(const std::shared_ptr<FTask>& Task);
+    void Execute(FTask* Task);
+    void Complete(FTask* Task);
+    FTask* FindWork(int32 WorkerIndex);
+
+    TArray<std::unique_ptr<FWorker>> Workers;
+    TQueue<FTask*, EQueueMode::Mpmc> GlobalQueue{ 8192 };
+
+    // 잠든 워커 깨우기
+    std::mutex WakeMutex;
+    std::condition_variable WakeCondition;
+    std::atomic<int32> NumQueuedTasks{ 0 };
+    std::atomic<int32> NumSleepingWorkers{ 0 };
+    std::atomic<bool> bStopRequested{ false };
+    std::atomic<bool> bRunning{ false };
+
+    std::atomic<uint64> NumExecutedTasks{ 0 };
+    std::atomic<uint64> NumStolenTasks{ 0 };
+};
+
+/**
+ * [Begin, End) 구간을 GrainSize 단위 묶음으로 나눠 병렬 실행. 호출 스레드도 참여하며 모든 묶음이 끝나야 반환
+ * Body(int32 Begin, int32 End)
+ */
+void ParallelForRange(int32 Num, const std::function<void(int32, int32)>& Body, int32 GrainSize = 1);
+
+/** Body(int32 Index) - 인덱스 단위 ParallelFor */
+template<typename BodyType>
+void ParallelFor(int32 Num, BodyType&& Body, int32 GrainSize = 1)
+{
+    ParallelForRange(Num, [&Body](int32 Begin, int32 End)
+    {
+        for (int32 Index = Begin; Index < End; ++Index)
+        {
+            Body(Index);
+        }
+    }, GrainSize);
+}
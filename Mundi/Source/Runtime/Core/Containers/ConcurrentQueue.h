@@ -0,0 +1,373 @@
+﻿#pragma once
+#include <atomic>
+#include <new>
+
+/**
+ * 스레드 간 전달용 TQueue 특수화 (UEContainer.h 끝에서 include)
+ * - EQueueMode::Spsc : 고정 크기 lock-free 링 버퍼 (생산자 1, 소비자 1)
+ * - EQueueMode::Mpsc : 무제한 lock-free 연결 큐 (Vyukov, 생산자 N, 소비자 1)
+ * - EQueueMode::Mpmc / Spmc : 고정 크기 lock-free 큐 (Vyukov, 셀마다 시퀀스 번호)
+ *
+ * *주의사항*
+ * - 고정 크기 큐의 Enqueue는 가득 차면 false를 반환 (호출부에서 재시도/드롭 결정)
+ * - Num()/IsEmpty()는 다른 스레드가 동시에 접근 중이면 근사값
+ * - Peek/Empty는 소비자 스레드에서만 호출
+ */
+namespace ConcurrentQueue
+{
+    static constexpr SIZE_T CacheLineSize = 64;
+    static constexpr uint32 DefaultCapacity = 1024;
+
+    inline uint32 RoundUpToPowerOfTwo(uint32 Value)
+    {
+        uint32 Result = 2;
+        while (Result < Value)
+        {
+            Result <<= 1;
+        }
+        return Result;
+    }
+
+    /** 요소를 생성/소멸 시점까지 직접 관리하는 저장 공간 */
+    template<typename T>
+    struct TSlotStorage
+    {
+        alignas(T) unsigned char Bytes[sizeof(T)];
+
+        T* Get() { return reinterpret_cast<T*>(Bytes); }
+        const T* Get() const { return reinterpret_cast<const T*>(Bytes); }
+    };
+}
+
+/** Single Producer Single Consumer - 고정 크기 lock-free 링 버퍼 */
+template<typename T, typename Compare>
+class TQueue<T, EQueueMode::Spsc, Compare>
+{
+public:
+    explicit TQueue(uint32 InCapacity = ConcurrentQueue::DefaultCapacity)
+        : Capacity(ConcurrentQueue::RoundUpToPowerOfTwo(InCapacity))
+        , Mask(Capacity - 1)
+        , Slots(new ConcurrentQueue::TSlotStorage<T>[Capacity])
+    {
+    }
+
+    ~TQueue()
+    {
+        Empty();
+        delete[] Slots;
+    }
+
+    TQueue(const TQueue&) = delete;
+    TQueue& operator=(const TQueue&) = delete;
+
+    /** [생산자] 가득 차 있으면 false */
+    bool Enqueue(const T& Item) { return EmplaceInternal(Item); }
+    bool Enqueue(T&& Item) { return EmplaceInternal(std::move(Item)); }
+
+    /** [소비자] */
+    bool Dequeue(T& OutItem)
+    {
+        const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+        if (CurrentHead == CachedTail)
+        {
+            CachedTail = Tail.load(std::memory_order_acquire);
+            if (CurrentHead == CachedTail)
+            {
+                return false;
+            }
+        }
+
+        T* Slot = Slots[CurrentHead & Mask].Get();
+        OutItem = std::move(*Slot);
+        Slot->~T();
+        Head.store(CurrentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** [소비자] */
+    bool Peek(T& OutItem) const
+    {
+        const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+        if (CurrentHead == Tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        OutItem = *Slots[CurrentHead & Mask].Get();
+        return true;
+    }
+
+    int32 Num() const
+    {
+        return static_cast<int32>(Tail.load(std::memory_order_acquire) - Head.load(std::memory_order_acquire));
+    }
+
+    bool IsEmpty() const { return Num() == 0; }
+    uint32 GetCapacity() const { return Capacity; }
+
+    /** [소비자] 남은 요소를 모두 버림 */
+    void Empty()
+    {
+        T Discard;
+        while (Dequeue(Discard))
+        {
+        }
+    }
+
+private:
+    template<typename ArgType>
+    bool EmplaceInternal(ArgType&& Item)
+    {
+        const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+        if (CurrentTail - CachedHead == Capacity)
+        {
+            CachedHead = Head.load(std::memory_order_acquire);
+            if (CurrentTail - CachedHead == Capacity)
+            {
+                return false;
+            }
+        }
+
+        new (Slots[CurrentTail & Mask].Get()) T(std::forward<ArgType>(Item));
+        Tail.store(CurrentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    const uint32 Capacity;
+    const uint32 Mask;
+    ConcurrentQueue::TSlotStorage<T>* Slots;
+
+    // 생산자/소비자가 쓰는 인덱스를 서로 다른 캐시 라인에 배치 (false sharing 방지)
+    alignas(ConcurrentQueue::CacheLineSize) std::atomic<uint32> Tail{ 0 };
+    uint32 CachedHead = 0;      // 생산자 전용: 마지막으로 읽은 Head
+    alignas(ConcurrentQueue::CacheLineSize) std::atomic<uint32> Head{ 0 };
+    uint32 CachedTail = 0;      // 소비자 전용: 마지막으로 읽은 Tail
+};
+
+/** Multiple Producer Single Consumer - 무제한 lock-free 연결 큐 (Vyukov) */
+template<typename T, typename Compare>
+class TQueue<T, EQueueMode::Mpsc, Compare>
+{
+    struct FNode
+    {
+        std::atomic<FNode*> Next{ nullptr };
+        ConcurrentQueue::TSlotStorage<T> Value;
+    };
+
+public:
+    TQueue()
+    {
+        // 스텁 노드: 항상 값이 없는 노드가 Tail에 하나 존재
+        FNode* Stub = new FNode();
+        Head.store(Stub, std::memory_order_relaxed);
+        Tail = Stub;
+    }
+
+    ~TQueue()
+    {
+        Empty();
+        delete Tail;
+    }
+
+    TQueue(const TQueue&) = delete;
+    TQueue& operator=(const TQueue&) = delete;
+
+    /** [생산자, 여러 스레드] 항상 성공 */
+    bool Enqueue(const T& Item) { return EmplaceInternal(Item); }
+    bool Enqueue(T&& Item) { return EmplaceInternal(std::move(Item)); }
+
+    /** [소비자] 생산자가 Next 연결 직전이면 잠시 비어 보일 수 있음 */
+    bool Dequeue(T& OutItem)
+    {
+        FNode* Next = Tail->Next.load(std::memory_order_acquire);
+        if (!Next)
+        {
+            return false;
+        }
+
+        T* Value = Next->Value.Get();
+        OutItem = std::move(*Value);
+        Value->~T();
+
+        // Next가 새 스텁이 됨
+        delete Tail;
+        Tail = Next;
+        Count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /** [소비자] */
+    bool Peek(T& OutItem) const
+    {
+        FNode* Next = Tail->Next.load(std::memory_order_acquire);
+        if (!Next)
+        {
+            return false;
+        }
+        OutItem = *Next->Value.Get();
+        return true;
+    }
+
+    int32 Num() const { return Count.load(std::memory_order_relaxed); }
+    bool IsEmpty() const { return Tail->Next.load(std::memory_order_acquire) == nullptr; }
+
+    /** [소비자] */
+    void Empty()
+    {
+        T Discard;
+        while (Dequeue(Discard))
+        {
+        }
+    }
+
+private:
+    template<typename ArgType>
+    bool EmplaceInternal(ArgType&& Item)
+    {
+        FNode* Node = new FNode();
+        new (Node->Value.Get()) T(std::forward<ArgType>(Item));
+        Count.fetch_add(1, std::memory_order_relaxed);
+
+        FNode* Prev = Head.exchange(Node, std::memory_order_acq_rel);
+        Prev->Next.store(Node, std::memory_order_release);
+        return true;
+    }
+
+    alignas(ConcurrentQueue::CacheLineSize) std::atomic<FNode*> Head;   // 생산자들이 교체
+    alignas(ConcurrentQueue::CacheLineSize) FNode* Tail;                // 소비자 전용 (스텁)
+    std::atomic<int32> Count{ 0 };
+};
+
+/** Multiple Producer Multiple Consumer - 고정 크기 lock-free 큐 (Vyukov) */
+template<typename T, typename Compare>
+class TQueue<T, EQueueMode::Mpmc, Compare>
+{
+    struct FCell
+    {
+        std::atomic<uint32> Sequence;
+        ConcurrentQueue::TSlotStorage<T> Value;
+    };
+
+public:
+    explicit TQueue(uint32 InCapacity = ConcurrentQueue::DefaultCapacity)
+        : Capacity(ConcurrentQueue::RoundUpToPowerOfTwo(InCapacity))
+        , Mask(Capacity - 1)
+        , Cells(new FCell[Capacity])
+    {
+        for (uint32 i = 0; i < Capacity; ++i)
+        {
+            Cells[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~TQueue()
+    {
+        Empty();
+        delete[] Cells;
+    }
+
+    TQueue(const TQueue&) = delete;
+    TQueue& operator=(const TQueue&) = delete;
+
+    /** [생산자, 여러 스레드] 가득 차 있으면 false */
+    bool Enqueue(const T& Item) { return EmplaceInternal(Item); }
+    bool Enqueue(T&& Item) { return EmplaceInternal(std::move(Item)); }
+
+    /** [소비자, 여러 스레드] */
+    bool Dequeue(T& OutItem)
+    {
+        FCell* Cell = nullptr;
+        uint32 Position = DequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell = &Cells[Position & Mask];
+            const uint32 Sequence = Cell->Sequence.load(std::memory_order_acquire);
+            const int32 Diff = static_cast<int32>(Sequence - (Position + 1));
+            if (Diff == 0)
+            {
+                if (DequeuePos.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Diff < 0)
+            {
+                return false;   // 비어 있음
+            }
+            else
+            {
+                Position = DequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* Value = Cell->Value.Get();
+        OutItem = std::move(*Value);
+        Value->~T();
+        // 한 바퀴 뒤의 생산자가 사용할 수 있도록 시퀀스 갱신
+        Cell->Sequence.store(Position + Mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    int32 Num() const
+    {
+        return static_cast<int32>(EnqueuePos.load(std::memory_order_acquire) - DequeuePos.load(std::memory_order_acquire));
+    }
+
+    bool IsEmpty() const { return Num() <= 0; }
+    uint32 GetCapacity() const { return Capacity; }
+
+    void Empty()
+    {
+        T Discard;
+        while (Dequeue(Discard))
+        {
+        }
+    }
+
+private:
+    template<typename ArgType>
+    bool EmplaceInternal(ArgType&& Item)
+    {
+        FCell* Cell = nullptr;
+        uint32 Position = EnqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell = &Cells[Position & Mask];
+            const uint32 Sequence = Cell->Sequence.load(std::memory_order_acquire);
+            const int32 Diff = static_cast<int32>(Sequence - Position);
+            if (Diff == 0)
+            {
+                if (EnqueuePos.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Diff < 0)
+            {
+                return false;   // 가득 참
+            }
+            else
+            {
+                Position = EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (Cell->Value.Get()) T(std::forward<ArgType>(Item));
+        Cell->Sequence.store(Position + 1, std::memory_order_release);
+        return true;
+    }
+
+    const uint32 Capacity;
+    const uint32 Mask;
+    FCell* Cells;
+
+    alignas(ConcurrentQueue::CacheLineSize) std::atomic<uint32> EnqueuePos{ 0 };
+    alignas(ConcurrentQueue::CacheLineSize) std::atomic<uint32> DequeuePos{ 0 };
+};
+
+/** Single Producer Multiple Consumer - MPMC 구현을 그대로 사용 */
+template<typename T, typename Compare>
+class TQueue<T, EQueueMode::Spmc, Compare> : public TQueue<T, EQueueMode::Mpmc, Compare>
+{
+public:
+    using TQueue<T, EQueueMode::Mpmc, Compare>::TQueue;
+};
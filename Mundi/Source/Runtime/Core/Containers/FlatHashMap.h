@@ -0,0 +1,550 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+/**
+ * Open-addressing(Robin Hood) 해시 컨테이너
+ * - 요소는 TArray 하나에 연속으로 저장 (순회 = 배열 순회, 삽입마다 노드 할당 없음)
+ * - 버킷 배열은 (거리|핑거프린트, 요소 인덱스) 8바이트만 보관
+ * - 삭제는 backward-shift + 마지막 요소를 빈 자리로 이동 (swap-remove)
+ *
+ * *주의사항*
+ * - 삽입/삭제 시 요소 포인터/반복자가 무효화될 수 있음 (std::vector와 동일한 규칙)
+ * - 삭제 시 순서가 보존되지 않음
+ * - TMap/TSet과 같은 API(Add, Find, Contains, Remove, 순회)와
+ *   자주 쓰는 std 스타일 API(find, insert, erase, count, emplace)를 제공
+ */
+namespace FlatHash
+{
+    struct FBucket
+    {
+        uint32 DistAndFingerprint = 0;   // 상위 24bit: 원래 위치로부터 거리 + 1, 하위 8bit: 해시 핑거프린트. 0이면 빈 버킷
+        uint32 ElementIndex = 0;
+    };
+
+    static constexpr uint32 DistInc = 1u << 8;
+    static constexpr uint32 FingerprintMask = DistInc - 1;
+    static constexpr uint32 InvalidIndex = ~0u;
+    static constexpr float MaxLoadFactor = 0.8f;
+
+    // std::hash가 포인터/정수에 대해 항등 함수인 경우가 있어 비트를 섞어 사용
+    inline uint64 MixHash(uint64 X)
+    {
+        X ^= X >> 33;
+        X *= 0xff51afd7ed558ccdULL;
+        X ^= X >> 33;
+        X *= 0xc4ceb9fe1a85ec53ULL;
+        X ^= X >> 33;
+        return X;
+    }
+
+    template<typename ElementType, typename KeyType>
+    struct TKeyOfMap
+    {
+        static const KeyType& Get(const ElementType& Element) { return Element.first; }
+    };
+
+    template<typename KeyType>
+    struct TKeyOfSet
+    {
+        static const KeyType& Get(const KeyType& Element) { return Element; }
+    };
+
+    /** TFlatMap/TFlatSet 공용 테이블 */
+    template<typename ElementType, typename KeyType, typename KeyOf, typename HasherType, typename KeyEqualType>
+    class TTable
+    {
+    public:
+        TTable() = default;
+
+        int32 Num() const { return Elements.Num(); }
+        bool IsEmpty() const { return Elements.IsEmpty(); }
+
+        /** 요소 + 버킷 메모리까지 해제 */
+        void Empty()
+        {
+            Elements = TArray<ElementType>();
+            Buckets = TArray<FBucket>();
+            Shift = 64;
+            MaxElementsBeforeGrow = 0;
+        }
+
+        /** 용량은 유지한 채 요소만 제거 (매 프레임 재사용하는 집합용) */
+        void Reset()
+        {
+            Elements.clear();
+            std::fill(Buckets.begin(), Buckets.end(), FBucket{});
+        }
+
+        void Reserve(int32 Count)
+        {
+            Elements.Reserve(Count);
+            if (static_cast<uint32>(Count) > MaxElementsBeforeGrow)
+            {
+                Rehash(BucketCountFor(static_cast<uint32>(Count)));
+            }
+        }
+
+        uint32 FindIndex(const KeyType& Key) const
+        {
+            if (Elements.IsEmpty())
+            {
+                return InvalidIndex;
+            }
+
+            const uint64 Hash = HashKey(Key);
+            uint32 DistAndFingerprint = MakeDistAndFingerprint(Hash);
+            uint32 BucketIndex = HomeBucket(Hash);
+
+            while (true)
+            {
+                const FBucket& Bucket = Buckets[BucketIndex];
+                if (Bucket.DistAndFingerprint == DistAndFingerprint
+                    && KeyEqualType()(KeyOf::Get(Elements[Bucket.ElementIndex]), Key))
+                {
+                    return Bucket.ElementIndex;
+                }
+                // Robin Hood 불변식: 더 가까운 버킷을 만나면 키가 없음 (빈 버킷 포함)
+                if (Bucket.DistAndFingerprint < DistAndFingerprint)
+                {
+                    return InvalidIndex;
+                }
+                DistAndFingerprint += DistInc;
+                BucketIndex = NextBucket(BucketIndex);
+            }
+        }
+
+        /**
+         * 키가 있으면 기존 인덱스, 없으면 MakeElement()로 요소를 만들어 삽입
+         * @return (요소 인덱스, 새로 삽입되었는지)
+         */
+        template<typename MakeElementFunc>
+        TPair<uint32, bool> FindOrInsert(const KeyType& Key, MakeElementFunc&& MakeElement)
+        {
+            if (static_cast<uint32>(Elements.Num()) >= MaxElementsBeforeGrow)
+            {
+                Rehash(Buckets.IsEmpty() ? 8u : static_cast<uint32>(Buckets.Num()) * 2u);
+            }
+
+            const uint64 Hash = HashKey(Key);
+            uint32 DistAndFingerprint = MakeDistAndFingerprint(Hash);
+            uint32 BucketIndex = HomeBucket(Hash);
+
+            while (true)
+            {
+                const FBucket& Bucket = Buckets[BucketIndex];
+                if (Bucket.DistAndFingerprint == DistAndFingerprint
+                    && KeyEqualType()(KeyOf::Get(Elements[Bucket.ElementIndex]), Key))
+                {
+                    return { Bucket.ElementIndex, false };
+                }
+                if (Bucket.DistAndFingerprint < DistAndFingerprint)
+                {
+                    break;
+                }
+                DistAndFingerprint += DistInc;
+                BucketIndex = NextBucket(BucketIndex);
+            }
+
+            const uint32 NewIndex = static_cast<uint32>(Elements.Num());
+            MakeElement(Elements);
+            PlaceAndShiftUp(FBucket{ DistAndFingerprint, NewIndex }, BucketIndex);
+            return { NewIndex, true };
+        }
+
+        bool RemoveKey(const KeyType& Key)
+        {
+            if (Elements.IsEmpty())
+            {
+                return false;
+            }
+
+            const uint64 Hash = HashKey(Key);
+            uint32 DistAndFingerprint = MakeDistAndFingerprint(Hash);
+            uint32 BucketIndex = HomeBucket(Hash);
+
+            while (true)
+            {
+                const FBucket& Bucket = Buckets[BucketIndex];
+                if (Bucket.DistAndFingerprint == DistAndFingerprint
+                    && KeyEqualType()(KeyOf::Get(Elements[Bucket.ElementIndex]), Key))
+                {
+                    RemoveAtBucket(BucketIndex);
+                    return true;
+                }
+                if (Bucket.DistAndFingerprint < DistAndFingerprint)
+                {
+                    return false;
+                }
+                DistAndFingerprint += DistInc;
+                BucketIndex = NextBucket(BucketIndex);
+            }
+        }
+
+        /** 요소 인덱스로 제거. 마지막 요소가 ElementIndex 자리로 이동함 */
+        void RemoveAtElement(uint32 ElementIndex)
+        {
+            RemoveAtBucket(FindBucketOfElement(ElementIndex));
+        }
+
+        TArray<ElementType> Elements;
+
+    private:
+        static uint64 HashKey(const KeyType& Key)
+        {
+            return MixHash(static_cast<uint64>(HasherType()(Key)));
+        }
+
+        static uint32 MakeDistAndFingerprint(uint64 Hash)
+        {
+            return DistInc | static_cast<uint32>(Hash & FingerprintMask);
+        }
+
+        uint32 HomeBucket(uint64 Hash) const
+        {
+            return static_cast<uint32>(Hash >> Shift);
+        }
+
+        uint32 NextBucket(uint32 BucketIndex) const
+        {
+            return (BucketIndex + 1 == static_cast<uint32>(Buckets.Num())) ? 0u : BucketIndex + 1;
+        }
+
+        static uint32 BucketCountFor(uint32 Count)
+        {
+            uint32 BucketCount = 8;
+            while (static_cast<uint32>(BucketCount * MaxLoadFactor) < Count)
+            {
+                BucketCount *= 2;
+            }
+            return BucketCount;
+        }
+
+        void PlaceAndShiftUp(FBucket Bucket, uint32 BucketIndex)
+        {
+            while (Buckets[BucketIndex].DistAndFingerprint != 0)
+            {
+                std::swap(Bucket, Buckets[BucketIndex]);
+                Bucket.DistAndFingerprint += DistInc;
+                BucketIndex = NextBucket(BucketIndex);
+            }
+            Buckets[BucketIndex] = Bucket;
+        }
+
+        uint32 FindBucketOfElement(uint32 ElementIndex) const
+        {
+            uint32 BucketIndex = HomeBucket(HashKey(KeyOf::Get(Elements[ElementIndex])));
+            while (Buckets[BucketIndex].ElementIndex != ElementIndex || Buckets[BucketIndex].DistAndFingerprint == 0)
+            {
+                BucketIndex = NextBucket(BucketIndex);
+            }
+            return BucketIndex;
+        }
+
+        void RemoveAtBucket(uint32 BucketIndex)
+        {
+            const uint32 ElementIndex = Buckets[BucketIndex].ElementIndex;
+
+            // backward-shift: 뒤따르는 체인을 한 칸씩 당김 (tombstone 없음)
+            uint32 NextIndex = NextBucket(BucketIndex);
+            while (Buckets[NextIndex].DistAndFingerprint >= DistInc * 2)
+            {
+                Buckets[BucketIndex] = { Buckets[NextIndex].DistAndFingerprint - DistInc, Buckets[NextIndex].ElementIndex };
+                BucketIndex = NextIndex;
+                NextIndex = NextBucket(NextIndex);
+            }
+            Buckets[BucketIndex] = FBucket{};
+
+            // 마지막 요소를 빈 자리로 옮기고 해당 버킷의 인덱스를 갱신
+            const uint32 LastIndex = static_cast<uint32>(Elements.Num() - 1);
+            if (ElementIndex != LastIndex)
+            {
+                Buckets[FindBucketOfElement(LastIndex)].ElementIndex = ElementIndex;
+                Elements[ElementIndex] = std::move(Elements[LastIndex]);
+            }
+            Elements.pop_back();
+        }
+
+        void Rehash(uint32 NewBucketCount)
+        {
+            Buckets = TArray<FBucket>(NewBucketCount);
+            Shift = 64;
+            for (uint32 Count = NewBucketCount; Count > 1; Count >>= 1)
+            {
+                --Shift;
+            }
+            MaxElementsBeforeGrow = static_cast<uint32>(NewBucketCount * MaxLoadFactor);
+
+            for (uint32 ElementIndex = 0; ElementIndex < static_cast<uint32>(Elements.Num()); ++ElementIndex)
+            {
+                const uint64 Hash = HashKey(KeyOf::Get(Elements[ElementIndex]));
+                uint32 DistAndFingerprint = MakeDistAndFingerprint(Hash);
+                uint32 BucketIndex = HomeBucket(Hash);
+                while (DistAndFingerprint <= Buckets[BucketIndex].DistAndFingerprint)
+                {
+                    DistAndFingerprint += DistInc;
+                    BucketIndex = NextBucket(BucketIndex);
+                }
+                PlaceAndShiftUp(FBucket{ DistAndFingerprint, ElementIndex }, BucketIndex);
+            }
+        }
+
+        TArray<FBucket> Buckets;
+        uint32 Shift = 64;
+        uint32 MaxElementsBeforeGrow = 0;
+    };
+}
+
+/** TFlatMap - Open-addressing 해시 맵 (TMap과 동일한 인터페이스) */
+template<typename KeyType, typename ValueType, typename HasherType = std::hash<KeyType>, typename KeyEqualType = std::equal_to<KeyType>>
+class TFlatMap
+{
+public:
+    using ElementType = TPair<KeyType, ValueType>;
+    using iterator = typename TArray<ElementType>::iterator;
+    using const_iterator = typename TArray<ElementType>::const_iterator;
+
+    TFlatMap() = default;
+    TFlatMap(std::initializer_list<ElementType> InitList)
+    {
+        Reserve(static_cast<int32>(InitList.size()));
+        for (const ElementType& Pair : InitList)
+        {
+            Add(Pair.first, Pair.second);
+        }
+    }
+
+    /** 요소 추가/수정 */
+    void Add(const KeyType& Key, const ValueType& Value)
+    {
+        FindOrAdd(Key) = Value;
+    }
+
+    void Add(const KeyType& Key, ValueType&& Value)
+    {
+        FindOrAdd(Key) = std::move(Value);
+    }
+
+    template<typename... Args>
+    void Emplace(const KeyType& Key, Args&&... args)
+    {
+        emplace(Key, std::forward<Args>(args)...);
+    }
+
+    ValueType& FindOrAdd(const KeyType& Key)
+    {
+        const auto Result = Table.FindOrInsert(Key, [&Key](TArray<ElementType>& Elements)
+        {
+            Elements.emplace_back(Key, ValueType{});
+        });
+        return Table.Elements[Result.first].second;
+    }
+
+    /** 제거 */
+    bool Remove(const KeyType& Key)
+    {
+        return Table.RemoveKey(Key);
+    }
+
+    /** 크기 관련 */
+    int32 Num() const { return Table.Num(); }
+    bool IsEmpty() const { return Table.IsEmpty(); }
+    void Empty() { Table.Empty(); }
+    void Reset() { Table.Reset(); }
+    void Reserve(int32 Count) { Table.Reserve(Count); }
+
+    /** 검색 */
+    bool Contains(const KeyType& Key) const
+    {
+        return Table.FindIndex(Key) != FlatHash::InvalidIndex;
+    }
+
+    ValueType* Find(const KeyType& Key)
+    {
+        const uint32 Index = Table.FindIndex(Key);
+        return (Index != FlatHash::InvalidIndex) ? &Table.Elements[Index].second : nullptr;
+    }
+
+    const ValueType* Find(const KeyType& Key) const
+    {
+        const uint32 Index = Table.FindIndex(Key);
+        return (Index != FlatHash::InvalidIndex) ? &Table.Elements[Index].second : nullptr;
+    }
+
+    /** 찾거나 기본값 반환 */
+    ValueType FindRef(const KeyType& Key) const
+    {
+        const ValueType* Value = Find(Key);
+        return Value ? *Value : ValueType{};
+    }
+
+    /** 키/값 배열 반환 */
+    TArray<KeyType> GetKeys() const
+    {
+        TArray<KeyType> Keys;
+        Keys.Reserve(Num());
+        for (const ElementType& Pair : Table.Elements)
+        {
+            Keys.Add(Pair.first);
+        }
+        return Keys;
+    }
+
+    TArray<ValueType> GetValues() const
+    {
+        TArray<ValueType> Values;
+        Values.Reserve(Num());
+        for (const ElementType& Pair : Table.Elements)
+        {
+            Values.Add(Pair.second);
+        }
+        return Values;
+    }
+
+    /** std::unordered_map 호환 인터페이스 (기존 호출부 유지용) */
+    iterator begin() { return Table.Elements.begin(); }
+    iterator end() { return Table.Elements.end(); }
+    const_iterator begin() const { return Table.Elements.begin(); }
+    const_iterator end() const { return Table.Elements.end(); }
+
+    iterator find(const KeyType& Key)
+    {
+        const uint32 Index = Table.FindIndex(Key);
+        return (Index != FlatHash::InvalidIndex) ? begin() + Index : end();
+    }
+
+    const_iterator find(const KeyType& Key) const
+    {
+        const uint32 Index = Table.FindIndex(Key);
+        return (Index != FlatHash::InvalidIndex) ? begin() + Index : end();
+    }
+
+    SIZE_T count(const KeyType& Key) const { return Contains(Key) ? 1 : 0; }
+    SIZE_T size() const { return Table.Elements.size(); }
+    bool empty() const { return Table.Elements.empty(); }
+    void clear() { Table.Reset(); }
+    void reserve(SIZE_T Count) { Reserve(static_cast<int32>(Count)); }
+
+    ValueType& operator[](const KeyType& Key) { return FindOrAdd(Key); }
+
+    TPair<iterator, bool> insert(const ElementType& Pair)
+    {
+        return emplace(Pair.first, Pair.second);
+    }
+
+    template<typename... Args>
+    TPair<iterator, bool> emplace(const KeyType& Key, Args&&... args)
+    {
+        const auto Result = Table.FindOrInsert(Key, [&](TArray<ElementType>& Elements)
+        {
+            Elements.emplace_back(std::piecewise_construct, std::forward_as_tuple(Key), std::forward_as_tuple(std::forward<Args>(args)...));
+        });
+        return { begin() + Result.first, Result.second };
+    }
+
+    SIZE_T erase(const KeyType& Key)
+    {
+        return Table.RemoveKey(Key) ? 1 : 0;
+    }
+
+    /** 순회 중 삭제: 반환된 반복자는 같은 위치(이동해 온 마지막 요소)를 가리킴 */
+    iterator erase(const_iterator It)
+    {
+        const uint32 Index = static_cast<uint32>(It - Table.Elements.cbegin());
+        Table.RemoveAtElement(Index);
+        return begin() + Index;
+    }
+
+private:
+    FlatHash::TTable<ElementType, KeyType, FlatHash::TKeyOfMap<ElementType, KeyType>, HasherType, KeyEqualType> Table;
+};
+
+/** TFlatSet - Open-addressing 해시 집합 (TSet과 동일한 인터페이스) */
+template<typename T, typename HasherType = std::hash<T>, typename KeyEqualType = std::equal_to<T>>
+class TFlatSet
+{
+public:
+    using iterator = typename TArray<T>::const_iterator;
+    using const_iterator = typename TArray<T>::const_iterator;
+
+    TFlatSet() = default;
+    TFlatSet(std::initializer_list<T> InitList)
+    {
+        Reserve(static_cast<int32>(InitList.size()));
+        for (const T& Item : InitList)
+        {
+            Add(Item);
+        }
+    }
+
+    /** 요소 추가 */
+    void Add(const T& Item)
+    {
+        insert(Item);
+    }
+
+    /** 제거 */
+    bool Remove(const T& Item)
+    {
+        return Table.RemoveKey(Item);
+    }
+
+    /** 크기 관련 */
+    int32 Num() const { return Table.Num(); }
+    bool IsEmpty() const { return Table.IsEmpty(); }
+    void Empty() { Table.Empty(); }
+    void Reset() { Table.Reset(); }
+    void Reserve(int32 Count) { Table.Reserve(Count); }
+
+    /** 검색 */
+    bool Contains(const T& Item) const
+    {
+        return Table.FindIndex(Item) != FlatHash::InvalidIndex;
+    }
+
+    /** 배열로 변환 (요소가 이미 연속 저장되어 있어 복사 한 번) */
+    TArray<T> Array() const
+    {
+        return Table.Elements;
+    }
+
+    /** std::unordered_set 호환 인터페이스 (기존 호출부 유지용) */
+    const_iterator begin() const { return Table.Elements.cbegin(); }
+    const_iterator end() const { return Table.Elements.cend(); }
+
+    const_iterator find(const T& Item) const
+    {
+        const uint32 Index = Table.FindIndex(Item);
+        return (Index != FlatHash::InvalidIndex) ? begin() + Index : end();
+    }
+
+    SIZE_T count(const T& Item) const { return Contains(Item) ? 1 : 0; }
+    SIZE_T size() const { return Table.Elements.size(); }
+    bool empty() const { return Table.Elements.empty(); }
+    void clear() { Table.Reset(); }
+    void reserve(SIZE_T Count) { Reserve(static_cast<int32>(Count)); }
+
+    TPair<const_iterator, bool> insert(const T& Item)
+    {
+        const auto Result = Table.FindOrInsert(Item, [&Item](TArray<T>& Elements)
+        {
+            Elements.push_back(Item);
+        });
+        return { begin() + Result.first, Result.second };
+    }
+
+    SIZE_T erase(const T& Item)
+    {
+        return Table.RemoveKey(Item) ? 1 : 0;
+    }
+
+    /** 순회 중 삭제: 반환된 반복자는 같은 위치(이동해 온 마지막 요소)를 가리킴 */
+    const_iterator erase(const_iterator It)
+    {
+        const uint32 Index = static_cast<uint32>(It - Table.Elements.cbegin());
+        Table.RemoveAtElement(Index);
+        return begin() + Index;
+    }
+
+private:
+    FlatHash::TTable<T, T, FlatHash::TKeyOfSet<T>, HasherType, KeyEqualType> Table;
+};
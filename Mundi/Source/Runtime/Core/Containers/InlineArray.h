@@ -0,0 +1,262 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+/**
+ * TInlineArray - 인라인 저장 공간을 가진 작은 배열
+ * - 요소 수가 N 이하인 동안에는 힙 할당 없이 객체 내부 버퍼를 사용
+ * - N을 넘으면 힙으로 옮겨 TArray처럼 2배씩 증가
+ * - BVH 순회 스택처럼 수명이 짧고 크기가 작은 임시 배열용
+ *
+ * *주의사항*
+ * - 인라인 상태에서는 이동(move)도 요소 단위 복사이므로 큰 T/N 조합은 피할 것
+ */
+template<typename T, int32 N>
+class TInlineArray
+{
+    static_assert(N > 0, "TInlineArray requires at least one inline element");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    TInlineArray() = default;
+
+    TInlineArray(std::initializer_list<T> InitList)
+    {
+        Reserve(static_cast<int32>(InitList.size()));
+        for (const T& Item : InitList)
+        {
+            Add(Item);
+        }
+    }
+
+    TInlineArray(const TInlineArray& Other)
+    {
+        Reserve(Other.Count);
+        std::uninitialized_copy(Other.begin(), Other.end(), Data);
+        Count = Other.Count;
+    }
+
+    TInlineArray(TInlineArray&& Other) noexcept
+    {
+        MoveFrom(std::move(Other));
+    }
+
+    TInlineArray& operator=(const TInlineArray& Other)
+    {
+        if (this != &Other)
+        {
+            Reset();
+            Reserve(Other.Count);
+            std::uninitialized_copy(Other.begin(), Other.end(), Data);
+            Count = Other.Count;
+        }
+        return *this;
+    }
+
+    TInlineArray& operator=(TInlineArray&& Other) noexcept
+    {
+        if (this != &Other)
+        {
+            Empty();
+            MoveFrom(std::move(Other));
+        }
+        return *this;
+    }
+
+    ~TInlineArray()
+    {
+        Empty();
+    }
+
+    /** 요소 추가 */
+    int32 Add(const T& Item)
+    {
+        return Emplace(Item);
+    }
+
+    int32 Add(T&& Item)
+    {
+        return Emplace(std::move(Item));
+    }
+
+    template<typename... Args>
+    int32 Emplace(Args&&... args)
+    {
+        if (Count == Capacity)
+        {
+            // 인자가 자기 자신의 요소를 참조할 수 있으므로 먼저 임시 객체로 만든 뒤 증가
+            T Temp(std::forward<Args>(args)...);
+            Grow(Capacity * 2);
+            new (Data + Count) T(std::move(Temp));
+        }
+        else
+        {
+            new (Data + Count) T(std::forward<Args>(args)...);
+        }
+        return Count++;
+    }
+
+    /** 빠르게 제거 (순서 보존 X) */
+    void RemoveAtSwap(int32 Index)
+    {
+        if (Index < 0 || Index >= Count)
+        {
+            return;
+        }
+        if (Index != Count - 1)
+        {
+            Data[Index] = std::move(Data[Count - 1]);
+        }
+        Pop();
+    }
+
+    /** Stack 기능 */
+    void Push(const T& Item)
+    {
+        Add(Item);
+    }
+
+    T Pop()
+    {
+        T Item = std::move(Data[Count - 1]);
+        Data[--Count].~T();
+        return Item;
+    }
+
+    /** 크기 관련 */
+    int32 Num() const { return Count; }
+    int32 Max() const { return Capacity; }
+    bool IsEmpty() const { return Count == 0; }
+    /** 힙으로 넘어갔는지 (디버그/통계용) */
+    bool IsUsingHeap() const { return Data != GetInlineData(); }
+
+    /** 요소를 모두 제거하고 힙 메모리를 해제 (인라인 상태로 복귀) */
+    void Empty()
+    {
+        Reset();
+        if (IsUsingHeap())
+        {
+            ::operator delete(Data, std::align_val_t(alignof(T)));
+            Data = GetInlineData();
+            Capacity = N;
+        }
+    }
+
+    /** 요소만 제거하고 용량 유지 */
+    void Reset()
+    {
+        std::destroy(Data, Data + Count);
+        Count = 0;
+    }
+
+    void Reserve(int32 NewCapacity)
+    {
+        if (NewCapacity > Capacity)
+        {
+            Grow(NewCapacity);
+        }
+    }
+
+    void SetNum(int32 NewSize)
+    {
+        if (NewSize > Count)
+        {
+            Reserve(NewSize);
+            std::uninitialized_value_construct(Data + Count, Data + NewSize);
+        }
+        else
+        {
+            std::destroy(Data + NewSize, Data + Count);
+        }
+        Count = NewSize;
+    }
+
+    /** 접근 */
+    T& operator[](int32 Index) { return Data[Index]; }
+    const T& operator[](int32 Index) const { return Data[Index]; }
+    T& Last() { return Data[Count - 1]; }
+    const T& Last() const { return Data[Count - 1]; }
+    T* GetData() { return Data; }
+    const T* GetData() const { return Data; }
+
+    /** 검색 */
+    int32 Find(const T& Item) const
+    {
+        for (int32 i = 0; i < Count; ++i)
+        {
+            if (Data[i] == Item)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool Contains(const T& Item) const
+    {
+        return Find(Item) != -1;
+    }
+
+    /** TArray로 변환 (TArray를 받는 기존 API 호출용) */
+    TArray<T> ToArray() const
+    {
+        return TArray<T>(begin(), end());
+    }
+
+    /** std 스타일 호환 인터페이스 */
+    iterator begin() { return Data; }
+    iterator end() { return Data + Count; }
+    const_iterator begin() const { return Data; }
+    const_iterator end() const { return Data + Count; }
+    void push_back(const T& Item) { Add(Item); }
+    void pop_back() { Data[--Count].~T(); }
+    T& back() { return Last(); }
+    const T& back() const { return Last(); }
+    bool empty() const { return Count == 0; }
+    SIZE_T size() const { return static_cast<SIZE_T>(Count); }
+    void clear() { Reset(); }
+
+private:
+    T* GetInlineData() { return reinterpret_cast<T*>(InlineStorage); }
+    const T* GetInlineData() const { return reinterpret_cast<const T*>(InlineStorage); }
+
+    void Grow(int32 NewCapacity)
+    {
+        T* NewData = static_cast<T*>(::operator new(sizeof(T) * NewCapacity, std::align_val_t(alignof(T))));
+        std::uninitialized_move(Data, Data + Count, NewData);
+        std::destroy(Data, Data + Count);
+        if (IsUsingHeap())
+        {
+            ::operator delete(Data, std::align_val_t(alignof(T)));
+        }
+        Data = NewData;
+        Capacity = NewCapacity;
+    }
+
+    void MoveFrom(TInlineArray&& Other)
+    {
+        if (Other.IsUsingHeap())
+        {
+            // 힙 버퍼는 포인터만 가져옴
+            Data = Other.Data;
+            Capacity = Other.Capacity;
+            Count = Other.Count;
+            Other.Data = Other.GetInlineData();
+            Other.Capacity = N;
+            Other.Count = 0;
+        }
+        else
+        {
+            std::uninitialized_move(Other.begin(), Other.end(), Data);
+            Count = Other.Count;
+            Other.Reset();
+        }
+    }
+
+    alignas(T) unsigned char InlineStorage[sizeof(T) * N];
+    T* Data = GetInlineData();
+    int32 Count = 0;
+    int32 Capacity = N;
+};
@@ -547,10 +547,11 @@ using TDoubleLinkedList = std::list<T>;
 /** 큐 모드 열거형 */
 enum class EQueueMode
 {
-    Spsc,           /** Single Producer Single Consumer (기본 FIFO) */
-    Mpmc,           /** Multiple Producer Multiple Consumer */
-    Mpsc,           /** Multiple Producer Single Consumer */
-    Spmc,           /** Single Producer Multiple Consumer */
+    Fifo,           /** 단일 스레드 FIFO (기본, 스레드 안전하지 않음) */
+    Spsc,           /** Single Producer Single Consumer (lock-free 링 버퍼, ConcurrentQueue.h) */
+    Mpmc,           /** Multiple Producer Multiple Consumer (lock-free 고정 크기, ConcurrentQueue.h) */
+    Mpsc,           /** Multiple Producer Single Consumer (lock-free 연결 큐, ConcurrentQueue.h) */
+    Spmc,           /** Single Producer Multiple Consumer (Mpmc 구현 사용) */
     Priority        /** Priority Queue */
 };
 
@@ -565,7 +566,7 @@ struct TDefaultCompare
 };
 
 /** 기본 TQueue - FIFO 큐 */
-template<typename T, EQueueMode Mode = EQueueMode::Spsc, typename Compare = TDefaultCompare<T>>
+template<typename T, EQueueMode Mode = EQueueMode::Fifo, typename Compare = TDefaultCompare<T>>
 class TQueue : public std::queue<T>
 {
 public:
@@ -725,6 +726,9 @@ public:
 #define TPriorityQueue(T) TQueue<T, EQueueMode::Priority>
 #define TPriorityQueueWithCompare(T, Compare) TQueue<T, EQueueMode::Priority, Compare>
 
+/** 스레드 간 전달용 큐 특수화 (Spsc/Mpsc/Mpmc/Spmc) */
+#include "ConcurrentQueue.h"
+
 
 // ANSI 문자열을 UTF-8로 변환하는 유틸리티 함수
 // TODO (동민, 한글) - 혹시나 프로젝트 설정의 /utf-8 옵션을 끈다면 이 설정이 무의미해집니다.
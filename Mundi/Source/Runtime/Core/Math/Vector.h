@@ -15,6 +15,10 @@
 #ifdef max
 #undef max
 #endif
+
+// Enums.h에 정의 (FMatrix::CreateProjectionMatrix 매개변수). 엔진 pch.h는 Vector.h를 Enums.h보다 먼저 include
+enum class ECameraProjectionMode;
+
 constexpr float KINDA_SMALL_NUMBER = 1e-6f;
 
 // ─────────────────────────────
@@ -314,7 +318,7 @@ struct FVector
 	}
 	bool operator!=(const FVector& V) const { return !(*this == V); }
 
-	FVector ComponentMin(const FVector& B)
+	FVector ComponentMin(const FVector& B) const
 	{
 		return FVector(
 			(X < B.X) ? X : B.X,
@@ -322,7 +326,7 @@ struct FVector
 			(Z < B.Z) ? Z : B.Z
 		);
 	}
-	FVector ComponentMax(const FVector& B)
+	FVector ComponentMax(const FVector& B) const
 	{
 		return FVector(
 			(X > B.X) ? X : B.X,
@@ -1244,7 +1248,7 @@ struct alignas(16) FMatrix
 		float NearClip,
 		float FarClip,
 		float ZoomFactor,
-		enum class ECameraProjectionMode ProjectionMode);
+		ECameraProjectionMode ProjectionMode);
 
 	// 직렬화 연산자
 	friend FArchive& operator<<(FArchive& Ar, FMatrix& Matrix)
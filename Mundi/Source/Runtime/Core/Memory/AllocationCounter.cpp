@@ -0,0 +1,187 @@
+﻿#include "pch.h"
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+std::atomic<bool> FAllocationCounter::bEnabled{ false };
+std::atomic<uint64> FAllocationCounter::NumAllocations{ 0 };
+std::atomic<uint64> FAllocationCounter::NumFrees{ 0 };
+std::atomic<uint64> FAllocationCounter::NumBytes{ 0 };
+
+uint64 FAllocationCounter::LastNumAllocations = 0;
+uint64 FAllocationCounter::LastNumFrees = 0;
+uint64 FAllocationCounter::LastNumBytes = 0;
+uint32 FAllocationCounter::HistoryAllocations[FAllocationCounter::AverageFrameCount] = {};
+uint64 FAllocationCounter::HistoryBytes[FAllocationCounter::AverageFrameCount] = {};
+int32 FAllocationCounter::HistoryCount = 0;
+int32 FAllocationCounter::HistoryHead = 0;
+FAllocationFrameStats FAllocationCounter::LastFrameStats;
+
+void FAllocationCounter::SetEnabled(bool bInEnabled)
+{
+	if (bInEnabled && !IsEnabled())
+	{
+		// 다시 켤 때 꺼져 있던 동안의 공백이 한 프레임 값으로 잡히지 않도록 기준점과 기록을 초기화
+		LastNumAllocations = GetNumAllocations();
+		LastNumFrees = GetNumFrees();
+		LastNumBytes = GetNumBytes();
+		HistoryCount = 0;
+		HistoryHead = 0;
+
+		const FAllocationFrameStats Marked = LastFrameStats;
+		LastFrameStats = FAllocationFrameStats();
+		LastFrameStats.MarkedAverageAllocations = Marked.MarkedAverageAllocations;
+		LastFrameStats.MarkedAverageBytes = Marked.MarkedAverageBytes;
+	}
+	bEnabled.store(bInEnabled, std::memory_order_relaxed);
+}
+
+void FAllocationCounter::EndFrame(uint64 FrameNumber)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const uint64 CurrentAllocations = GetNumAllocations();
+	const uint64 CurrentFrees = GetNumFrees();
+	const uint64 CurrentBytes = GetNumBytes();
+
+	LastFrameStats.FrameNumber = FrameNumber;
+	LastFrameStats.NumAllocations = static_cast<uint32>(CurrentAllocations - LastNumAllocations);
+	LastFrameStats.NumFrees = static_cast<uint32>(CurrentFrees - LastNumFrees);
+	LastFrameStats.AllocatedBytes = CurrentBytes - LastNumBytes;
+
+	LastNumAllocations = CurrentAllocations;
+	LastNumFrees = CurrentFrees;
+	LastNumBytes = CurrentBytes;
+
+	// 최근 프레임 원형 버퍼
+	HistoryAllocations[HistoryHead] = LastFrameStats.NumAllocations;
+	HistoryBytes[HistoryHead] = LastFrameStats.AllocatedBytes;
+	HistoryHead = (HistoryHead + 1) % AverageFrameCount;
+	HistoryCount = std::min(HistoryCount + 1, AverageFrameCount);
+
+	uint64 SumAllocations = 0;
+	uint64 SumBytes = 0;
+	uint32 PeakAllocations = 0;
+	for (int32 Index = 0; Index < HistoryCount; ++Index)
+	{
+		SumAllocations += HistoryAllocations[Index];
+		SumBytes += HistoryBytes[Index];
+		PeakAllocations = std::max(PeakAllocations, HistoryAllocations[Index]);
+	}
+	LastFrameStats.AverageAllocations = static_cast<float>(SumAllocations) / HistoryCount;
+	LastFrameStats.AverageBytes = static_cast<float>(SumBytes) / HistoryCount;
+	LastFrameStats.PeakAllocations = PeakAllocations;
+}
+
+void FAllocationCounter::MarkBaseline()
+{
+	LastFrameStats.MarkedAverageAllocations = LastFrameStats.AverageAllocations;
+	LastFrameStats.MarkedAverageBytes = LastFrameStats.AverageBytes;
+}
+
+void FAllocationCounter::ClearBaseline()
+{
+	LastFrameStats.MarkedAverageAllocations = -1.0f;
+	LastFrameStats.MarkedAverageBytes = -1.0f;
+}
+
+// ──────────────────────────────────────────────
+// 전역 operator new/delete 교체 (USE_ALLOCATION_STATS 빌드만)
+// 정렬 지정 버전은 _aligned_malloc/_aligned_free 짝이 맞아야 하므로 일반 버전과 분리
+// ──────────────────────────────────────────────
+
+#if defined(USE_ALLOCATION_STATS)
+
+namespace
+{
+	void* AllocateCounted(std::size_t Size)
+	{
+		FAllocationCounter::RecordAllocation(Size);
+		return std::malloc(Size ? Size : 1);
+	}
+
+	void* AllocateAlignedCounted(std::size_t Size, std::align_val_t Alignment)
+	{
+		FAllocationCounter::RecordAllocation(Size);
+		const std::size_t AlignmentValue = static_cast<std::size_t>(Alignment);
+#if defined(_WIN32)
+		return _aligned_malloc(Size ? Size : 1, AlignmentValue);
+#else
+		// aligned_alloc은 크기가 정렬의 배수여야 함
+		const std::size_t AlignedSize = ((Size ? Size : 1) + AlignmentValue - 1) / AlignmentValue * AlignmentValue;
+		return std::aligned_alloc(AlignmentValue, AlignedSize);
+#endif
+	}
+
+	void FreeCounted(void* Ptr) noexcept
+	{
+		if (Ptr)
+		{
+			FAllocationCounter::RecordFree();
+			std::free(Ptr);
+		}
+	}
+
+	void FreeAlignedCounted(void* Ptr) noexcept
+	{
+		if (Ptr)
+		{
+			FAllocationCounter::RecordFree();
+#if defined(_WIN32)
+			_aligned_free(Ptr);
+#else
+			std::free(Ptr);
+#endif
+		}
+	}
+
+	void* AllocateOrThrow(std::size_t Size)
+	{
+		void* Ptr = AllocateCounted(Size);
+		if (!Ptr)
+		{
+			throw std::bad_alloc();
+		}
+		return Ptr;
+	}
+
+	void* AllocateAlignedOrThrow(std::size_t Size, std::align_val_t Alignment)
+	{
+		void* Ptr = AllocateAlignedCounted(Size, Alignment);
+		if (!Ptr)
+		{
+			throw std::bad_alloc();
+		}
+		return Ptr;
+	}
+}
+
+void* operator new(std::size_t Size) { return AllocateOrThrow(Size); }
+void* operator new[](std::size_t Size) { return AllocateOrThrow(Size); }
+void* operator new(std::size_t Size, const std::nothrow_t&) noexcept { return AllocateCounted(Size); }
+void* operator new[](std::size_t Size, const std::nothrow_t&) noexcept { return AllocateCounted(Size); }
+void* operator new(std::size_t Size, std::align_val_t Alignment) { return AllocateAlignedOrThrow(Size, Alignment); }
+void* operator new[](std::size_t Size, std::align_val_t Alignment) { return AllocateAlignedOrThrow(Size, Alignment); }
+void* operator new(std::size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return AllocateAlignedCounted(Size, Alignment); }
+void* operator new[](std::size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return AllocateAlignedCounted(Size, Alignment); }
+
+void operator delete(void* Ptr) noexcept { FreeCounted(Ptr); }
+void operator delete[](void* Ptr) noexcept { FreeCounted(Ptr); }
+void operator delete(void* Ptr, std::size_t) noexcept { FreeCounted(Ptr); }
+void operator delete[](void* Ptr, std::size_t) noexcept { FreeCounted(Ptr); }
+void operator delete(void* Ptr, const std::nothrow_t&) noexcept { FreeCounted(Ptr); }
+void operator delete[](void* Ptr, const std::nothrow_t&) noexcept { FreeCounted(Ptr); }
+void operator delete(void* Ptr, std::align_val_t) noexcept { FreeAlignedCounted(Ptr); }
+void operator delete[](void* Ptr, std::align_val_t) noexcept { FreeAlignedCounted(Ptr); }
+void operator delete(void* Ptr, std::size_t, std::align_val_t) noexcept { FreeAlignedCounted(Ptr); }
+void operator delete[](void* Ptr, std::size_t, std::align_val_t) noexcept { FreeAlignedCounted(Ptr); }
+void operator delete(void* Ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAlignedCounted(Ptr); }
+void operator delete[](void* Ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAlignedCounted(Ptr); }
+
+#endif // USE_ALLOCATION_STATS
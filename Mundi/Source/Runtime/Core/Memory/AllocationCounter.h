@@ -0,0 +1,97 @@
+﻿#pragma once
+#include <atomic>
+#include "UEContainer.h"
+
+// 프레임당 힙 할당 통계 (STAT ALLOC)
+struct FAllocationFrameStats
+{
+	uint64 FrameNumber = 0;
+
+	uint32 NumAllocations = 0;		// 직전 프레임의 전역 operator new 호출 수
+	uint32 NumFrees = 0;			// 직전 프레임의 전역 operator delete 호출 수 (nullptr 제외)
+	uint64 AllocatedBytes = 0;		// 직전 프레임에 요청된 바이트 (해제량은 세지 않음)
+
+	// 최근 AverageFrameCount 프레임 평균 / 최대 (ALLOC MARK 전후 비교용)
+	float AverageAllocations = 0.0f;
+	float AverageBytes = 0.0f;
+	uint32 PeakAllocations = 0;
+
+	// ALLOC MARK로 저장한 기준 평균 (없으면 음수)
+	float MarkedAverageAllocations = -1.0f;
+	float MarkedAverageBytes = -1.0f;
+};
+
+/**
+ * 전역 operator new/delete 호출 카운터
+ * - AllocationCounter.cpp가 전역 operator new/delete를 교체해 STL 컨테이너, TArray 등의 힙 할당을 셈
+ *   교체는 USE_ALLOCATION_STATS 빌드(에디터/디버그)에서만. 그 외에는 켜도 0으로 남음 (IsCompiledIn)
+ *   UObject는 FMemoryManager를 거치므로 포함되지 않음 (STAT MEMORY 참고)
+ * - 꺼져 있을 때 할당마다 드는 비용은 relaxed 원자 읽기 하나. STAT ALLOC을 켜야 세기 시작
+ * - 스레드 구분 없이 셈 (렌더 스레드 모드에서는 렌더 스레드/워커의 할당도 같은 프레임에 들어감)
+ * - 메인 루프가 프레임 끝에 EndFrame()을 호출해 직전 프레임 값을 확정
+ */
+class FAllocationCounter
+{
+public:
+	static constexpr int32 AverageFrameCount = 60;
+
+	/** 전역 operator new/delete가 교체된 빌드인지 */
+	static constexpr bool IsCompiledIn()
+	{
+#if defined(USE_ALLOCATION_STATS)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	static void SetEnabled(bool bInEnabled);
+	static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+
+	static void RecordAllocation(SIZE_T Size)
+	{
+		if (bEnabled.load(std::memory_order_relaxed))
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			NumBytes.fetch_add(Size, std::memory_order_relaxed);
+		}
+	}
+
+	static void RecordFree()
+	{
+		if (bEnabled.load(std::memory_order_relaxed))
+		{
+			NumFrees.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	// 켠 뒤 누적 값 (벤치마크가 구간 전후 차이로 사용)
+	static uint64 GetNumAllocations() { return NumAllocations.load(std::memory_order_relaxed); }
+	static uint64 GetNumFrees() { return NumFrees.load(std::memory_order_relaxed); }
+	static uint64 GetNumBytes() { return NumBytes.load(std::memory_order_relaxed); }
+
+	// 게임 스레드 프레임 끝에서 호출
+	static void EndFrame(uint64 FrameNumber);
+
+	// 현재 평균을 기준으로 저장 (변경 전 상태에서 마크 → 변경 후 패널에서 비교)
+	static void MarkBaseline();
+	static void ClearBaseline();
+
+	static const FAllocationFrameStats& GetLastFrameStats() { return LastFrameStats; }
+
+private:
+	static std::atomic<bool> bEnabled;
+	static std::atomic<uint64> NumAllocations;
+	static std::atomic<uint64> NumFrees;
+	static std::atomic<uint64> NumBytes;
+
+	// 게임 스레드 전용
+	static uint64 LastNumAllocations;
+	static uint64 LastNumFrees;
+	static uint64 LastNumBytes;
+	static uint32 HistoryAllocations[AverageFrameCount];
+	static uint64 HistoryBytes[AverageFrameCount];
+	static int32 HistoryCount;
+	static int32 HistoryHead;
+	static FAllocationFrameStats LastFrameStats;
+};
@@ -0,0 +1,253 @@
+﻿#include "pch.h"
+#include "CookedAsset.h"
+
+namespace
+{
+    uint64 AlignUp(uint64 Value, uint64 Alignment)
+    {
+        return (Value + Alignment - 1) & ~(Alignment - 1);
+    }
+}
+
+// ──────────────────────────────────────────────
+// FCookedAssetWriter
+// ──────────────────────────────────────────────
+
+void FCookedAssetWriter::AddSection(uint32 Tag, const void* Data, uint32 ElementSize, uint64 Count)
+{
+    FPendingSection& Section = Sections.emplace_back();
+    Section.Tag = Tag;
+    Section.ElementSize = ElementSize;
+    Section.Count = Count;
+
+    const uint64 NumBytes = static_cast<uint64>(ElementSize) * Count;
+    if (NumBytes > 0)
+    {
+        const uint8* Bytes = static_cast<const uint8*>(Data);
+        Section.Bytes.assign(Bytes, Bytes + NumBytes);
+    }
+}
+
+FCookedStringRef FCookedAssetWriter::AddString(const FString& Str)
+{
+    FCookedStringRef Ref;
+    Ref.Offset = static_cast<uint32>(StringTable.size());
+    Ref.Length = static_cast<uint32>(Str.size());
+    StringTable.insert(StringTable.end(), Str.begin(), Str.end());
+    return Ref;
+}
+
+bool FCookedAssetWriter::Save(const FString& FilePath) const
+{
+    TArray<const FPendingSection*> AllSections;
+    AllSections.reserve(Sections.size() + 1);
+    for (const FPendingSection& Section : Sections)
+    {
+        AllSections.push_back(&Section);
+    }
+
+    FPendingSection StringSection{ CookedAsset::TagStrings, sizeof(char), StringTable.size(), {} };
+    if (!StringTable.empty())
+    {
+        StringSection.Bytes.assign(StringTable.begin(), StringTable.end());
+        AllSections.push_back(&StringSection);
+    }
+
+    // 1) 레이아웃 계산
+    FCookedAssetHeader Header;
+    Header.AssetType = AssetType;
+    Header.NumSections = static_cast<uint32>(AllSections.size());
+
+    TArray<FCookedSectionEntry> Entries(AllSections.size());
+    uint64 Cursor = sizeof(FCookedAssetHeader) + sizeof(FCookedSectionEntry) * AllSections.size();
+    for (size_t i = 0; i < AllSections.size(); ++i)
+    {
+        Cursor = AlignUp(Cursor, CookedAsset::SectionAlignment);
+        Entries[i].Tag = AllSections[i]->Tag;
+        Entries[i].ElementSize = AllSections[i]->ElementSize;
+        Entries[i].Offset = Cursor;
+        Entries[i].Count = AllSections[i]->Count;
+        Cursor += AllSections[i]->Bytes.size();
+    }
+    Header.FileSize = Cursor;
+
+    // 2) 임시 파일에 기록
+    const std::filesystem::path FinalPath(UTF8ToWide(FilePath));
+    std::filesystem::path TempPath = FinalPath;
+    TempPath += L".tmp";
+    {
+        std::ofstream File(TempPath, std::ios::binary | std::ios::out | std::ios::trunc);
+        if (!File.is_open())
+        {
+            UE_LOG("[CookedAsset] Failed to open '%s' for writing", FilePath.c_str());
+            return false;
+        }
+
+        File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+        File.write(reinterpret_cast<const char*>(Entries.data()), sizeof(FCookedSectionEntry) * Entries.size());
+
+        static const char Padding[CookedAsset::SectionAlignment] = {};
+        uint64 Written = sizeof(FCookedAssetHeader) + sizeof(FCookedSectionEntry) * Entries.size();
+        for (size_t i = 0; i < AllSections.size(); ++i)
+        {
+            File.write(Padding, static_cast<std::streamsize>(Entries[i].Offset - Written));
+            File.write(reinterpret_cast<const char*>(AllSections[i]->Bytes.data()), static_cast<std::streamsize>(AllSections[i]->Bytes.size()));
+            Written = Entries[i].Offset + AllSections[i]->Bytes.size();
+        }
+
+        if (!File.good())
+        {
+            UE_LOG("[CookedAsset] Write failed for '%s'", FilePath.c_str());
+            File.close();
+            std::error_code Ec;
+            std::filesystem::remove(TempPath, Ec);
+            return false;
+        }
+    }
+
+    // 3) 완성된 파일로 교체
+    std::error_code Ec;
+    std::filesystem::rename(TempPath, FinalPath, Ec);
+    if (Ec)
+    {
+        UE_LOG("[CookedAsset] Failed to replace '%s': %s", FilePath.c_str(), Ec.message().c_str());
+        std::filesystem::remove(TempPath, Ec);
+        return false;
+    }
+    return true;
+}
+
+// ──────────────────────────────────────────────
+// FCookedAssetFile
+// ──────────────────────────────────────────────
+
+bool FCookedAssetFile::Open(const FString& FilePath, ECookedAssetType ExpectedType)
+{
+    Close();
+
+    const FWideString WidePath = UTF8ToWide(FilePath);
+    HANDLE File = CreateFileW(WidePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (File == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    FileHandle = File;
+
+    LARGE_INTEGER FileSize{};
+    if (!GetFileSizeEx(File, &FileSize) || FileSize.QuadPart < static_cast<LONGLONG>(sizeof(FCookedAssetHeader)))
+    {
+        Close();
+        return false;
+    }
+
+    HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!Mapping)
+    {
+        Close();
+        return false;
+    }
+    MappingHandle = Mapping;
+
+    MappedData = static_cast<const uint8*>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!MappedData)
+    {
+        Close();
+        return false;
+    }
+    MappedSize = static_cast<uint64>(FileSize.QuadPart);
+
+    // 헤더 검증
+    const FCookedAssetHeader* Header = reinterpret_cast<const FCookedAssetHeader*>(MappedData);
+    if (Header->Magic != CookedAsset::Magic
+        || Header->Version != CookedAsset::FormatVersion
+        || Header->AssetType != ExpectedType
+        || Header->FileSize != MappedSize)
+    {
+        UE_LOG("[CookedAsset] '%s' is outdated, truncated or not a cooked asset (version %u, expected %u)",
+            FilePath.c_str(), Header->Version, CookedAsset::FormatVersion);
+        Close();
+        return false;
+    }
+
+    // 섹션 테이블 검증 (이후 접근은 모두 이 범위 안)
+    const uint64 TableEnd = sizeof(FCookedAssetHeader) + sizeof(FCookedSectionEntry) * static_cast<uint64>(Header->NumSections);
+    if (TableEnd > MappedSize)
+    {
+        Close();
+        return false;
+    }
+
+    const FCookedSectionEntry* Entries = reinterpret_cast<const FCookedSectionEntry*>(MappedData + sizeof(FCookedAssetHeader));
+    for (uint32 i = 0; i < Header->NumSections; ++i)
+    {
+        const FCookedSectionEntry& Entry = Entries[i];
+        const bool bAligned = (Entry.Offset % CookedAsset::SectionAlignment) == 0;
+        const bool bSaneCount = Entry.Count <= Serialization::MAX_REASONABLE_ARRAY_SIZE;
+        const uint64 NumBytes = static_cast<uint64>(Entry.ElementSize) * Entry.Count;
+        // Offset + NumBytes는 손상된 Offset(2^64 근처)에서 넘쳐 작아질 수 있으므로 뺄셈으로 비교
+        const bool bInFile = Entry.Offset <= MappedSize && NumBytes <= MappedSize - Entry.Offset;
+        if (!bAligned || !bSaneCount || Entry.Offset < TableEnd || !bInFile)
+        {
+            UE_LOG("[CookedAsset] '%s' has a corrupt section table", FilePath.c_str());
+            Close();
+            return false;
+        }
+    }
+
+    SectionTable = Entries;
+    NumSections = Header->NumSections;
+
+    if (!GetArray(CookedAsset::TagStrings, Strings))
+    {
+        Strings = TCookedArrayView<char>();
+    }
+    return true;
+}
+
+void FCookedAssetFile::Close()
+{
+    if (MappedData)
+    {
+        UnmapViewOfFile(MappedData);
+        MappedData = nullptr;
+    }
+    if (MappingHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(MappingHandle));
+        MappingHandle = nullptr;
+    }
+    if (FileHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(FileHandle));
+        FileHandle = nullptr;
+    }
+
+    MappedSize = 0;
+    SectionTable = nullptr;
+    NumSections = 0;
+    Strings = TCookedArrayView<char>();
+}
+
+const FCookedSectionEntry* FCookedAssetFile::FindSection(uint32 Tag) const
+{
+    // 섹션 수가 한 자리 수라 선형 탐색으로 충분
+    for (uint32 i = 0; i < NumSections; ++i)
+    {
+        if (SectionTable[i].Tag == Tag)
+        {
+            return &SectionTable[i];
+        }
+    }
+    return nullptr;
+}
+
+FString FCookedAssetFile::GetString(const FCookedStringRef& Ref) const
+{
+    const uint64 End = static_cast<uint64>(Ref.Offset) + Ref.Length;
+    if (Ref.Length == 0 || End > static_cast<uint64>(Strings.Num()))
+    {
+        return FString();
+    }
+    return FString(Strings.GetData() + Ref.Offset, Ref.Length);
+}
@@ -0,0 +1,213 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+/**
+ * 쿠킹된 에셋 컨테이너 (.cooked)
+ *
+ * [Header][Section Table][Section 0][Section 1]...
+ * - 각 섹션은 16바이트 정렬, 런타임 구조체 메모리 레이아웃 그대로 저장 (필드 단위 파싱 없음)
+ * - 로드 시 파일을 메모리 맵핑하고 섹션을 뷰(TCookedArrayView)로 바로 가리킴
+ * - 문자열은 'STRS' 문자열 테이블에 모아두고 레코드에서는 FCookedStringRef(오프셋/길이)로 참조
+ *
+ * *주의사항*
+ * - 섹션 요소 크기(ElementSize)가 sizeof(T)와 다르면 레이아웃이 바뀐 것이므로 읽기 실패 처리 → 캐시 재생성
+ * - 구조체 레이아웃을 바꾸면 CookedAsset::FormatVersion을 올릴 것
+ * - 뷰는 FCookedAssetFile이 열려 있는 동안만 유효
+ */
+namespace CookedAsset
+{
+    constexpr uint32 MakeTag(char A, char B, char C, char D)
+    {
+        return static_cast<uint32>(static_cast<uint8>(A))
+            | (static_cast<uint32>(static_cast<uint8>(B)) << 8)
+            | (static_cast<uint32>(static_cast<uint8>(C)) << 16)
+            | (static_cast<uint32>(static_cast<uint8>(D)) << 24);
+    }
+
+    constexpr uint32 Magic = MakeTag('M', 'C', 'K', 'D');
+    constexpr uint32 FormatVersion = 3; // 2: 쿠킹 시 정점 캐시/오버드로우/페치 최적화 적용, 3: 자동 LOD
+    constexpr uint64 SectionAlignment = 16;
+
+    // 공용 섹션 태그
+    constexpr uint32 TagMeta = MakeTag('M', 'E', 'T', 'A');
+    constexpr uint32 TagStrings = MakeTag('S', 'T', 'R', 'S');
+    constexpr uint32 TagIndices = MakeTag('I', 'D', 'X', ' ');
+    constexpr uint32 TagGroups = MakeTag('G', 'R', 'P', 'S');
+
+    // 캐시 파일 확장자
+    inline constexpr const char* Extension = ".cooked";
+}
+
+enum class ECookedAssetType : uint32
+{
+    StaticMesh = 1,
+    SkeletalMesh = 2,
+    AnimSequence = 3,
+};
+
+struct FCookedAssetHeader
+{
+    uint32 Magic = CookedAsset::Magic;
+    uint32 Version = CookedAsset::FormatVersion;
+    ECookedAssetType AssetType = ECookedAssetType::StaticMesh;
+    uint32 NumSections = 0;
+    uint64 FileSize = 0;
+    uint64 Reserved = 0;
+};
+
+struct FCookedSectionEntry
+{
+    uint32 Tag = 0;
+    uint32 ElementSize = 0;
+    uint64 Offset = 0;      // 파일 시작 기준, SectionAlignment 배수
+    uint64 Count = 0;
+};
+
+/** 문자열 테이블('STRS') 내 위치 */
+struct FCookedStringRef
+{
+    uint32 Offset = 0;
+    uint32 Length = 0;
+};
+
+/** 맵핑된 메모리를 가리키는 읽기 전용 배열 뷰 */
+template<typename T>
+class TCookedArrayView
+{
+public:
+    TCookedArrayView() = default;
+    TCookedArrayView(const T* InData, int32 InNum) : Data(InData), Count(InNum) {}
+
+    int32 Num() const { return Count; }
+    bool IsEmpty() const { return Count == 0; }
+    const T* GetData() const { return Data; }
+    const T& operator[](int32 Index) const { return Data[Index]; }
+
+    const T* begin() const { return Data; }
+    const T* end() const { return Data + Count; }
+
+    /** 소유 배열이 필요한 곳(FStaticMesh 등)으로 한 번에 복사 */
+    void CopyTo(TArray<T>& OutArray) const
+    {
+        OutArray.assign(Data, Data + Count);
+    }
+
+private:
+    const T* Data = nullptr;
+    int32 Count = 0;
+};
+
+/**
+ * 섹션을 모아서 한 번에 파일로 기록
+ * 임시 파일에 쓴 뒤 교체하므로, 기록 도중 실패해도 불완전한 캐시가 남지 않음
+ */
+class FCookedAssetWriter
+{
+public:
+    explicit FCookedAssetWriter(ECookedAssetType InAssetType) : AssetType(InAssetType) {}
+
+    void AddSection(uint32 Tag, const void* Data, uint32 ElementSize, uint64 Count);
+
+    template<typename T>
+    void AddArray(uint32 Tag, const TArray<T>& Array)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Cooked sections must be trivially copyable");
+        AddSection(Tag, Array.data(), sizeof(T), Array.size());
+    }
+
+    template<typename T>
+    void AddStruct(uint32 Tag, const T& Value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Cooked sections must be trivially copyable");
+        AddSection(Tag, &Value, sizeof(T), 1);
+    }
+
+    /** 문자열 테이블에 추가하고 참조 반환 ('STRS' 섹션은 Save 시 자동 기록) */
+    FCookedStringRef AddString(const FString& Str);
+
+    bool Save(const FString& FilePath) const;
+
+private:
+    struct FPendingSection
+    {
+        uint32 Tag;
+        uint32 ElementSize;
+        uint64 Count;
+        TArray<uint8> Bytes;
+    };
+
+    ECookedAssetType AssetType;
+    TArray<FPendingSection> Sections;
+    TArray<char> StringTable;
+};
+
+/**
+ * 메모리 맵핑된 쿠킹 에셋 파일 (읽기 전용)
+ * Open()에서 헤더/섹션 테이블 범위를 모두 검증하므로 이후 접근은 별도 검사 없이 안전
+ */
+class FCookedAssetFile
+{
+public:
+    FCookedAssetFile() = default;
+    ~FCookedAssetFile() { Close(); }
+
+    FCookedAssetFile(const FCookedAssetFile&) = delete;
+    FCookedAssetFile& operator=(const FCookedAssetFile&) = delete;
+
+    bool Open(const FString& FilePath, ECookedAssetType ExpectedType);
+    void Close();
+    bool IsOpen() const { return MappedData != nullptr; }
+
+    const FCookedSectionEntry* FindSection(uint32 Tag) const;
+
+    /** 섹션이 없거나 요소 크기가 다르면 false */
+    template<typename T>
+    bool GetArray(uint32 Tag, TCookedArrayView<T>& OutView) const
+    {
+        static_assert(alignof(T) <= CookedAsset::SectionAlignment, "Section alignment is too small for this type");
+        const FCookedSectionEntry* Section = FindSection(Tag);
+        if (!Section || Section->ElementSize != sizeof(T))
+        {
+            return false;
+        }
+        OutView = TCookedArrayView<T>(reinterpret_cast<const T*>(MappedData + Section->Offset), static_cast<int32>(Section->Count));
+        return true;
+    }
+
+    template<typename T>
+    bool ReadArray(uint32 Tag, TArray<T>& OutArray) const
+    {
+        TCookedArrayView<T> View;
+        if (!GetArray(Tag, View))
+        {
+            return false;
+        }
+        View.CopyTo(OutArray);
+        return true;
+    }
+
+    template<typename T>
+    bool ReadStruct(uint32 Tag, T& OutValue) const
+    {
+        TCookedArrayView<T> View;
+        if (!GetArray(Tag, View) || View.Num() != 1)
+        {
+            return false;
+        }
+        std::memcpy(&OutValue, View.GetData(), sizeof(T));
+        return true;
+    }
+
+    /** 문자열 테이블 범위를 벗어나면 빈 문자열 */
+    FString GetString(const FCookedStringRef& Ref) const;
+
+private:
+    const uint8* MappedData = nullptr;
+    uint64 MappedSize = 0;
+    void* FileHandle = nullptr;
+    void* MappingHandle = nullptr;
+
+    const FCookedSectionEntry* SectionTable = nullptr;
+    uint32 NumSections = 0;
+    TCookedArrayView<char> Strings;
+};
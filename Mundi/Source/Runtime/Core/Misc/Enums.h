@@ -180,10 +180,11 @@ enum class EEngineShowFlags : uint64
     
     SF_Particle = 1ull << 20,
     SF_DOF = 1ull << 21,          // Enable/disable Depth of Field
+    SF_OcclusionCulling = 1ull << 22, // Enable/disable CPU software occlusion culling
 
     // Default enabled flags
     SF_DefaultEnabled = SF_Primitives | SF_StaticMeshes | SF_SkeletalMeshes | SF_Grid | SF_Lighting | SF_Decals |
-        SF_Fog | SF_FXAA | SF_Billboard | SF_EditorIcon | SF_Shadows | SF_ShadowAntiAliasing | SF_GPUSkinning | SF_Particle | SF_DOF,
+        SF_Fog | SF_FXAA | SF_Billboard | SF_EditorIcon | SF_Shadows | SF_ShadowAntiAliasing | SF_GPUSkinning | SF_Particle | SF_DOF | SF_OcclusionCulling,
 
     // All flags (for initialization/reset)
     SF_All = 0xFFFFFFFFFFFFFFFFull
@@ -0,0 +1,239 @@
+﻿#include "pch.h"
+#include "PackedVertex.h"
+#include "VertexData.h"
+
+namespace
+{
+    bool bPackedVertexEnabled = false;
+    bool bQuantizePositions = false;
+
+    uint32 ToBits(float Value)
+    {
+        uint32 Bits;
+        std::memcpy(&Bits, &Value, sizeof(Bits));
+        return Bits;
+    }
+
+    float FromBits(uint32 Bits)
+    {
+        float Value;
+        std::memcpy(&Value, &Bits, sizeof(Value));
+        return Value;
+    }
+
+    uint32 PackSnorm8(float Value)
+    {
+        const float Clamped = std::clamp(Value, -1.0f, 1.0f);
+        return static_cast<uint8>(static_cast<int8>(std::lrintf(Clamped * 127.0f)));
+    }
+
+    float UnpackSnorm8(uint32 Byte)
+    {
+        // -128과 -127 모두 -1.0 (D3D SNORM 규칙)
+        return std::max(static_cast<float>(static_cast<int8>(Byte & 0xFF)) / 127.0f, -1.0f);
+    }
+
+    uint32 PackUnorm8(float Value)
+    {
+        return static_cast<uint32>(std::lrintf(std::clamp(Value, 0.0f, 1.0f) * 255.0f));
+    }
+}
+
+bool PackedVertex::IsEnabled()
+{
+    return bPackedVertexEnabled;
+}
+
+void PackedVertex::SetEnabled(bool bInEnabled)
+{
+    bPackedVertexEnabled = bInEnabled;
+}
+
+bool PackedVertex::IsPositionQuantizationEnabled()
+{
+    return bPackedVertexEnabled && bQuantizePositions;
+}
+
+void PackedVertex::SetPositionQuantizationEnabled(bool bInEnabled)
+{
+    bQuantizePositions = bInEnabled;
+}
+
+uint32 PackedVertex::GetStaticVertexStride()
+{
+    return bPackedVertexEnabled ? sizeof(FPackedVertex) : sizeof(FVertexDynamic);
+}
+
+uint32 PackedVertex::GetSkinnedVertexStride()
+{
+    return bPackedVertexEnabled ? sizeof(FPackedSkinnedVertex) : sizeof(FSkinnedVertex);
+}
+
+uint32 PackedVertex::PackSnorm8x4(const FVector4& Value)
+{
+    return PackSnorm8(Value.X) | (PackSnorm8(Value.Y) << 8) | (PackSnorm8(Value.Z) << 16) | (PackSnorm8(Value.W) << 24);
+}
+
+FVector4 PackedVertex::UnpackSnorm8x4(uint32 Packed)
+{
+    return FVector4(UnpackSnorm8(Packed), UnpackSnorm8(Packed >> 8), UnpackSnorm8(Packed >> 16), UnpackSnorm8(Packed >> 24));
+}
+
+uint32 PackedVertex::PackUnorm8x4(const FVector4& Value)
+{
+    return PackUnorm8(Value.X) | (PackUnorm8(Value.Y) << 8) | (PackUnorm8(Value.Z) << 16) | (PackUnorm8(Value.W) << 24);
+}
+
+FVector4 PackedVertex::UnpackUnorm8x4(uint32 Packed)
+{
+    constexpr float Inv255 = 1.0f / 255.0f;
+    return FVector4((Packed & 0xFF) * Inv255, ((Packed >> 8) & 0xFF) * Inv255, ((Packed >> 16) & 0xFF) * Inv255, (Packed >> 24) * Inv255);
+}
+
+uint16 PackedVertex::FloatToHalf(float Value)
+{
+    const uint32 Bits = ToBits(Value);
+    const uint32 Sign = (Bits >> 16) & 0x8000;
+    const uint32 Abs = Bits & 0x7FFFFFFF;
+
+    if (Abs >= 0x7F800000)
+    {
+        // inf / NaN (NaN은 quiet NaN으로 유지)
+        return static_cast<uint16>(Sign | 0x7C00 | (Abs > 0x7F800000 ? 0x200 : 0));
+    }
+    if (Abs >= 0x477FF000)
+    {
+        // 65520 이상은 반올림하면 half 최대값(65504)을 넘음
+        return static_cast<uint16>(Sign | 0x7C00);
+    }
+    if (Abs < 0x38800000)
+    {
+        // 2^-14 미만은 비정규화 수: 2^-24 단위로 반올림 (기본 라운딩 모드 = nearest-even)
+        return static_cast<uint16>(Sign | static_cast<uint32>(std::lrintf(FromBits(Abs) * 16777216.0f)));
+    }
+
+    // 지수 bias를 127 → 15로 옮기고 잘려나가는 하위 13비트로 nearest-even 반올림
+    uint32 Half = (Abs - 0x38000000) >> 13;
+    const uint32 Dropped = Abs & 0x1FFF;
+    if (Dropped > 0x1000 || (Dropped == 0x1000 && (Half & 1)))
+    {
+        ++Half;
+    }
+    return static_cast<uint16>(Sign | Half);
+}
+
+float PackedVertex::HalfToFloat(uint16 Half)
+{
+    const uint32 Sign = static_cast<uint32>(Half & 0x8000) << 16;
+    const uint32 Exponent = (Half >> 10) & 0x1F;
+    const uint32 Mantissa = Half & 0x3FF;
+
+    if (Exponent == 0)
+    {
+        const float Denormal = static_cast<float>(Mantissa) * (1.0f / 16777216.0f);
+        return Sign ? -Denormal : Denormal;
+    }
+    if (Exponent == 31)
+    {
+        return FromBits(Sign | 0x7F800000 | (Mantissa << 13));
+    }
+    return FromBits(Sign | ((Exponent + 112) << 23) | (Mantissa << 13));
+}
+
+uint32 PackedVertex::PackHalf2(const FVector2D& Value)
+{
+    return static_cast<uint32>(FloatToHalf(Value.X)) | (static_cast<uint32>(FloatToHalf(Value.Y)) << 16);
+}
+
+FVector2D PackedVertex::UnpackHalf2(uint32 Packed)
+{
+    return FVector2D(HalfToFloat(static_cast<uint16>(Packed & 0xFFFF)), HalfToFloat(static_cast<uint16>(Packed >> 16)));
+}
+
+uint32 PackedVertex::PackBoneWeights(const float InWeights[4])
+{
+    float Sum = 0.0f;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        Sum += std::max(InWeights[i], 0.0f);
+    }
+    if (Sum <= 0.0f)
+    {
+        return 0;
+    }
+
+    // 내림한 뒤 모자란 만큼을 잉여가 큰 순서로 1씩 배분 → 합이 항상 255
+    uint32 Quantized[4];
+    float Remainders[4];
+    uint32 Total = 0;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        const float Scaled = std::max(InWeights[i], 0.0f) / Sum * 255.0f;
+        Quantized[i] = std::min(static_cast<uint32>(Scaled), 255u);
+        Remainders[i] = Scaled - static_cast<float>(Quantized[i]);
+        Total += Quantized[i];
+    }
+    while (Total < 255)
+    {
+        int32 Best = 0;
+        for (int32 i = 1; i < 4; ++i)
+        {
+            if (Remainders[i] > Remainders[Best])
+            {
+                Best = i;
+            }
+        }
+        ++Quantized[Best];
+        Remainders[Best] = -1.0f;
+        ++Total;
+    }
+    while (Total > 255)
+    {
+        // 부동소수 오차로 넘친 경우 (실제로는 거의 발생하지 않음)
+        int32 Largest = 0;
+        for (int32 i = 1; i < 4; ++i)
+        {
+            if (Quantized[i] > Quantized[Largest])
+            {
+                Largest = i;
+            }
+        }
+        --Quantized[Largest];
+        --Total;
+    }
+
+    return Quantized[0] | (Quantized[1] << 8) | (Quantized[2] << 16) | (Quantized[3] << 24);
+}
+
+void PackedVertex::UnpackBoneWeights(uint32 Packed, float OutWeights[4])
+{
+    const FVector4 Weights = UnpackUnorm8x4(Packed);
+    OutWeights[0] = Weights.X;
+    OutWeights[1] = Weights.Y;
+    OutWeights[2] = Weights.Z;
+    OutWeights[3] = Weights.W;
+}
+
+uint16 PackedVertex::QuantizePosition(float Value, float Min, float Extent)
+{
+    if (Extent <= 0.0f)
+    {
+        return 0;
+    }
+    const float Normalized = std::clamp((Value - Min) / Extent, 0.0f, 1.0f);
+    return static_cast<uint16>(std::lrintf(Normalized * 65535.0f));
+}
+
+float PackedVertex::DequantizePosition(uint16 Quantized, float Min, float Extent)
+{
+    return Min + static_cast<float>(Quantized) * (1.0f / 65535.0f) * Extent;
+}
+
+void PackedVertex::LogMemorySavings(const FString& AssetPath, uint64 NumVertices, uint32 FullStride, uint32 PackedStride)
+{
+    const double FullKB = static_cast<double>(NumVertices * FullStride) / 1024.0;
+    const double PackedKB = static_cast<double>(NumVertices * PackedStride) / 1024.0;
+    const double SavedPercent = FullKB > 0.0 ? (1.0 - PackedKB / FullKB) * 100.0 : 0.0;
+    UE_LOG("[PackedVertex] '%s': %llu vertices, %.1f KB -> %.1f KB (%u -> %u bytes/vertex, %.0f%% saved)",
+        AssetPath.c_str(), NumVertices, FullKB, PackedKB, FullStride, PackedStride, SavedPercent);
+}
@@ -0,0 +1,57 @@
+﻿#pragma once
+#include "Vector.h"
+
+/**
+ * 압축 정점 포맷 (opt-in, editor.ini의 PackedVertexFormat=1)
+ *
+ * - 노멀/탄젠트: R8G8B8A8_SNORM (탄젠트 w는 ±1), UV: R16G16_FLOAT, 컬러: R8G8B8A8_UNORM
+ * - 본 인덱스: R16G16B16A16_UINT, 본 가중치: R8G8B8A8_UNORM (합이 정확히 255가 되도록 재정규화)
+ * - 모두 IA가 float/uint로 풀어주는 포맷이라 셰이더 입력 시그니처는 그대로 사용
+ * - 위치는 GPU에서는 float3 그대로, 쿠킹 캐시에서만 선택적으로 메시 바운드 기준 16비트 양자화
+ *   (PackedVertexQuantizePositions=1) → 로드 시 float로 복원해 CPU 스키닝/피킹은 기존 경로 사용
+ *
+ * *주의사항*
+ * - 입력 레이아웃/정점 버퍼가 만들어지기 전(UResourceManager::Initialize)에 한 번만 결정, 실행 중 변경 불가
+ */
+namespace PackedVertex
+{
+    bool IsEnabled();
+    void SetEnabled(bool bInEnabled);
+
+    /** 쿠킹 캐시에 위치를 16비트로 양자화해서 저장 (IsEnabled()일 때만 의미 있음) */
+    bool IsPositionQuantizationEnabled();
+    void SetPositionQuantizationEnabled(bool bInEnabled);
+
+    /** 메시 셰이더(UberLit 등)가 읽는 정점 버퍼 stride (FPackedVertex 또는 FVertexDynamic) */
+    uint32 GetStaticVertexStride();
+    /** GPU 스키닝 정점 버퍼 stride (FPackedSkinnedVertex 또는 FSkinnedVertex) */
+    uint32 GetSkinnedVertexStride();
+
+    // ──────────────────────────────────────────────
+    // 인코딩 / 디코딩 (D3D11 포맷 변환 규칙과 동일)
+    // ──────────────────────────────────────────────
+
+    uint32 PackSnorm8x4(const FVector4& Value);
+    FVector4 UnpackSnorm8x4(uint32 Packed);
+
+    uint32 PackUnorm8x4(const FVector4& Value);
+    FVector4 UnpackUnorm8x4(uint32 Packed);
+
+    /** round-to-nearest-even, 범위를 넘으면 inf */
+    uint16 FloatToHalf(float Value);
+    float HalfToFloat(uint16 Half);
+
+    uint32 PackHalf2(const FVector2D& Value);
+    FVector2D UnpackHalf2(uint32 Packed);
+
+    /** 음수는 0으로 보고 합이 255가 되도록 최대 잉여 방식으로 배분 (모두 0이면 0) */
+    uint32 PackBoneWeights(const float InWeights[4]);
+    void UnpackBoneWeights(uint32 Packed, float OutWeights[4]);
+
+    /** Min ~ Min + Extent 범위를 0 ~ 65535로 양자화 (오차는 축마다 Extent / 131070 이하) */
+    uint16 QuantizePosition(float Value, float Min, float Extent);
+    float DequantizePosition(uint16 Quantized, float Min, float Extent);
+
+    /** 에셋 하나의 정점 메모리 절감량을 로그로 남김 */
+    void LogMemorySavings(const FString& AssetPath, uint64 NumVertices, uint32 FullStride, uint32 PackedStride);
+}
@@ -1,5 +1,6 @@
 ﻿#include "pch.h"
 #include "VertexData.h"
+#include "PackedVertex.h"
 
 void FBillboardVertex::FillFrom(const FMeshData& mesh, size_t i)
 {
@@ -56,6 +57,81 @@ void FSkinnedVertex::FillFrom(const FSkinnedVertex& Src)
     }
 }
 
+namespace
+{
+    FPackedVertex PackVertex(const FVector& Position, const FVector& Normal, const FVector2D& UV, const FVector4& Tangent, const FVector4& Color)
+    {
+        FPackedVertex Packed;
+        Packed.Position = Position;
+        Packed.Normal = PackedVertex::PackSnorm8x4(FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f));
+        Packed.UV = PackedVertex::PackHalf2(UV);
+        Packed.Tangent = PackedVertex::PackSnorm8x4(FVector4(Tangent.X, Tangent.Y, Tangent.Z, Tangent.W < 0.0f ? -1.0f : 1.0f));
+        Packed.Color = PackedVertex::PackUnorm8x4(Color);
+        return Packed;
+    }
+}
+
+void FPackedVertex::FillFrom(const FMeshData& mesh, size_t i)
+{
+    *this = PackVertex(
+        mesh.Vertices[i],
+        (i < mesh.Normal.size()) ? mesh.Normal[i] : FVector(0, 0, 1),
+        (i < mesh.UV.size()) ? mesh.UV[i] : FVector2D(0, 0),
+        FVector4(0, 0, 0, 1),
+        (i < mesh.Color.size()) ? mesh.Color[i] : FVector4(1, 1, 1, 1));
+}
+
+void FPackedVertex::FillFrom(const FNormalVertex& src)
+{
+    *this = PackVertex(src.pos, src.normal, src.tex, src.Tangent, src.color);
+}
+
+void FPackedVertex::FillFrom(const FSkinnedVertex& Src)
+{
+    *this = PackVertex(Src.Position, Src.Normal, Src.UV, Src.Tangent, Src.Color);
+}
+
+FNormalVertex FPackedVertex::Decode() const
+{
+    const FVector4 DecodedNormal = PackedVertex::UnpackSnorm8x4(Normal);
+
+    FNormalVertex Vertex;
+    Vertex.pos = Position;
+    Vertex.normal = FVector(DecodedNormal.X, DecodedNormal.Y, DecodedNormal.Z);
+    Vertex.tex = PackedVertex::UnpackHalf2(UV);
+    Vertex.Tangent = PackedVertex::UnpackSnorm8x4(Tangent);
+    Vertex.color = PackedVertex::UnpackUnorm8x4(Color);
+    return Vertex;
+}
+
+void FPackedSkinnedVertex::FillFrom(const FSkinnedVertex& Src)
+{
+    Base.FillFrom(Src);
+    for (int i = 0; i < 4; i++)
+    {
+        BoneIndices[i] = static_cast<uint16>(Src.BoneIndices[i]);
+    }
+    BoneWeights = PackedVertex::PackBoneWeights(Src.BoneWeights);
+}
+
+FSkinnedVertex FPackedSkinnedVertex::Decode() const
+{
+    const FNormalVertex Decoded = Base.Decode();
+
+    FSkinnedVertex Vertex;
+    Vertex.Position = Decoded.pos;
+    Vertex.Normal = Decoded.normal;
+    Vertex.UV = Decoded.tex;
+    Vertex.Tangent = Decoded.Tangent;
+    Vertex.Color = Decoded.color;
+    for (int i = 0; i < 4; i++)
+    {
+        Vertex.BoneIndices[i] = BoneIndices[i];
+    }
+    PackedVertex::UnpackBoneWeights(BoneWeights, Vertex.BoneWeights);
+    return Vertex;
+}
+
 void FBillboardVertexInfo_GPU::FillFrom(const FMeshData& mesh, size_t i)
 {
     Position[0] = mesh.Vertices[i].X;
@@ -151,6 +151,34 @@ namespace std
     };
 }
 
+// 압축 런타임 포맷 (PackedVertex::IsEnabled()일 때 FVertexDynamic 대신 사용, 64 → 28바이트)
+struct FPackedVertex
+{
+    FVector Position;
+    uint32 Normal;      // R8G8B8A8_SNORM
+    uint32 UV;          // R16G16_FLOAT
+    uint32 Tangent;     // R8G8B8A8_SNORM (w는 binormal 방향 ±1)
+    uint32 Color;       // R8G8B8A8_UNORM
+
+    void FillFrom(const FMeshData& mesh, size_t i);
+    void FillFrom(const FNormalVertex& src);
+    void FillFrom(const FSkinnedVertex& Src);
+    FNormalVertex Decode() const;
+};
+static_assert(sizeof(FPackedVertex) == 28, "FPackedVertex must match the packed input layout");
+
+// 압축 GPU 스키닝 포맷 (FSkinnedVertex 대신 사용, 96 → 40바이트)
+struct FPackedSkinnedVertex
+{
+    FPackedVertex Base;
+    uint16 BoneIndices[4];  // R16G16B16A16_UINT
+    uint32 BoneWeights;     // R8G8B8A8_UNORM (합이 255)
+
+    void FillFrom(const FSkinnedVertex& Src);
+    FSkinnedVertex Decode() const;
+};
+static_assert(sizeof(FPackedSkinnedVertex) == 40, "FPackedSkinnedVertex must match the packed skinned input layout");
+
 struct FBillboardVertexInfo {
     FVector WorldPosition;
     FVector2D CharSize;//char scale
@@ -197,14 +225,37 @@ struct FGroupInfo
     }
 };
 
+/** LOD 하나에서 그룹(섹션) 하나가 차지하는 인덱스 범위 (FMeshLOD::Indices 기준) */
+struct FMeshLODSection
+{
+    uint32 StartIndex = 0;
+    uint32 IndexCount = 0;
+};
+
+/**
+ * 쿠킹 시 자동 생성되는 LOD1 이상 (LOD0은 원본 Indices/GroupInfos)
+ * - 정점 배열은 모든 LOD가 공유하고 인덱스만 따로 가짐
+ * - GPU 인덱스 버퍼에는 LOD0 뒤로 LOD1, LOD2... 순서로 이어붙여 올림 (MeshLOD::GetSectionRange)
+ */
+struct FMeshLOD
+{
+    TArray<uint32> Indices;
+    TArray<FMeshLODSection> Sections;   // GroupInfos와 같은 순서 (그룹이 없으면 1개)
+    float RelativeError = 0.0f;         // 원본 대비 최대 거리 오차 / 바운드 대각선 길이
+};
+
+class FMeshBVH;
+
 struct FStaticMesh
 {
     FString PathFileName;
-    FString CacheFilePath;  // 캐시된 소스 경로 (예: DerivedDataCache/cube.obj.bin)
+    FString CacheFilePath;  // 캐시된 소스 경로 (예: DerivedDataCache/cube.obj.cooked)
 
     TArray<uint32> Indices;
     TArray<FNormalVertex> Vertices;
     TArray<FGroupInfo> GroupInfos; // 각 group을 render 하기 위한 정보
+    TArray<FMeshLOD> LODs;          // 자동 생성 LOD (쿠킹 캐시에만 저장)
+    std::shared_ptr<FMeshBVH> MeshBVH;  // 피킹/라인 트레이스용 삼각형 BVH (쿠킹 캐시에만 저장, 없으면 UResourceManager가 빌드)
 
     bool bHasMaterial;
 
@@ -373,6 +424,7 @@ struct FSkeletalMeshData
     TArray<uint32> Indices; // 인덱스 배열
     FSkeleton Skeleton; // 스켈레톤 정보
     TArray<FGroupInfo> GroupInfos; // 머티리얼 그룹 (기존 시스템 재사용)
+    TArray<FMeshLOD> LODs; // 자동 생성 LOD (쿠킹 캐시에만 저장)
     bool bHasMaterial = false;
 
     friend FArchive& operator<<(FArchive& Ar, FSkeletalMeshData& Data)
@@ -152,6 +152,44 @@ FFrustum CreateFrustumFromCamera(const UCameraComponent& Camera, float OverrideA
     return Result;
 }
 
+// ------------------------------------------------------------
+// VP 행렬에서 평면 추출 (Gribb-Hartmann)
+//  - row-vector 규약(clip = p * VP)이므로 클립 성분 i는 VP의 i번째 "열"과의 내적
+//  - 평면 P = (a, b, c, d): a*x + b*y + c*z + d >= 0 이 안쪽
+//    → 우리 규약 dot(N, X) - D >= 0 에 맞춰 N = (a, b, c) / |N|, D = -d / |N|
+//  - D3D 클립 z 범위는 [0, w]이므로 Near는 열 2 단독, Far는 열 3 - 열 2
+// ------------------------------------------------------------
+static FPlane MakePlaneFromClipColumns(const FMatrix& VP, int32 Axis, float Sign)
+{
+    float P[4];
+    for (int32 Row = 0; Row < 4; ++Row)
+    {
+        const float W = VP.M[Row][3];
+        P[Row] = Axis < 0 ? VP.M[Row][2] : W + Sign * VP.M[Row][Axis];
+    }
+
+    FPlane Out;
+    const float Len = std::sqrt(P[0] * P[0] + P[1] * P[1] + P[2] * P[2]);
+    if (Len > 0.0f)
+    {
+        Out.Normal = FVector4(P[0] / Len, P[1] / Len, P[2] / Len, 0.0f);
+        Out.Distance = -P[3] / Len;
+    }
+    return Out;
+}
+
+FFrustum CreateFrustumFromViewProjection(const FMatrix& ViewProjection)
+{
+    FFrustum Result;
+    Result.LeftFace = MakePlaneFromClipColumns(ViewProjection, 0, +1.0f);
+    Result.RightFace = MakePlaneFromClipColumns(ViewProjection, 0, -1.0f);
+    Result.BottomFace = MakePlaneFromClipColumns(ViewProjection, 1, +1.0f);
+    Result.TopFace = MakePlaneFromClipColumns(ViewProjection, 1, -1.0f);
+    Result.NearFace = MakePlaneFromClipColumns(ViewProjection, -1, 0.0f);
+    Result.FarFace = MakePlaneFromClipColumns(ViewProjection, 2, -1.0f);
+    return Result;
+}
+
 // ------------------------------------------------------------
 // AABB vs 프러스텀 판정
 //  - 각 평면에 대해: 중심의 부호 + 박스의 "프로젝션 반경"으로 배제 테스트
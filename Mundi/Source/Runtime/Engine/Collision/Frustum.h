@@ -26,6 +26,8 @@ struct FFrustum
 };
 
 FFrustum CreateFrustumFromCamera(const UCameraComponent& Camera, float OverrideAspect = -1.0f);
+// View * Projection (row-vector, D3D 클립 z 0~1)에서 6평면 추출. 원근/직교 모두 사용 가능 (섀도우 뷰 등)
+FFrustum CreateFrustumFromViewProjection(const FMatrix& ViewProjection);
 bool IsAABBVisible(const FFrustum& Frustum, const FAABB& Bound);
 bool IsAABBIntersects(const FFrustum& Frustum, const FAABB& Bound);
 
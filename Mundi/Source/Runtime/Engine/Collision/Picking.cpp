@@ -156,75 +156,6 @@ FRay MakeRayFromViewport(const FMatrix& InView,
 	return Ray;
 }
 
-bool IntersectRaySphere(const FRay& InRay, const FVector& InCenter, float InRadius, float& OutT)
-{
-	// Solve ||(RayOrigin + T*RayDir) - Center||^2 = Radius^2
-	const FVector OriginToCenter = InRay.Origin - InCenter;
-	const float QuadraticA = FVector::Dot(InRay.Direction, InRay.Direction); // Typically 1 for normalized ray
-	const float QuadraticB = 2.0f * FVector::Dot(OriginToCenter, InRay.Direction);
-	const float QuadraticC = FVector::Dot(OriginToCenter, OriginToCenter) - InRadius * InRadius;
-
-	const float Discriminant = QuadraticB * QuadraticB - 4.0f * QuadraticA * QuadraticC;
-	if (Discriminant < 0.0f)
-	{
-		return false;
-	}
-
-	const float SqrtD = std::sqrt(Discriminant >= 0.0f ? Discriminant : 0.0f);
-	const float Inv2A = 1.0f / (2.0f * QuadraticA);
-	const float T0 = (-QuadraticB - SqrtD) * Inv2A;
-	const float T1 = (-QuadraticB + SqrtD) * Inv2A;
-
-	// Pick smallest positive T
-	const float ClosestT = (T0 > 0.0f) ? T0 : T1;
-	if (ClosestT <= 0.0f)
-	{
-		return false;
-	}
-
-	OutT = ClosestT;
-	return true;
-}
-
-// 삼각형을 이루는 3개의 점 
-bool IntersectRayTriangleMT(const FRay& InRay, const FVector& InA, const FVector& InB, const FVector& InC, float& OutT)
-{
-	const float Epsilon = KINDA_SMALL_NUMBER;
-
-	// 삼각형 한점으로 시작하는 두 벡터 
-	const FVector Edge1 = InB - InA;
-	const FVector Edge2 = InC - InA;
-
-	// 레이 방향과 , 삼각형 Edge와 수직한 벡터
-	const FVector Perpendicular = FVector::Cross(InRay.Direction, Edge2);
-	// 내적 했을때 0이라면, 세 벡터는 한 평면 안에 같이 있는 것이다. 
-	const float Determinant = FVector::Dot(Edge1, Perpendicular);
-
-	// 거의 0이면 평행 상태에 있다고 판단 
-	if (Determinant > -Epsilon && Determinant < Epsilon)
-		return false;
-
-	const float InvDeterminant = 1.0f / Determinant;
-	const FVector OriginToA = InRay.Origin - InA;
-	const float U = InvDeterminant * FVector::Dot(OriginToA, Perpendicular);
-	if (U < -Epsilon || U > 1.0f + Epsilon)
-		return false;
-
-	const FVector CrossQ = FVector::Cross(OriginToA, Edge1);
-	const float V = InvDeterminant * FVector::Dot(InRay.Direction, CrossQ);
-	if (V < -Epsilon || (U + V) > 1.0f + Epsilon)
-		return false;
-
-	const float Distance = InvDeterminant * FVector::Dot(Edge2, CrossQ);
-
-	if (Distance > Epsilon) // ray intersection
-	{
-		OutT = Distance;
-		return true;
-	}
-	return false;
-}
-
 // PickingSystem 구현
 AActor* CPickingSystem::PerformPicking(const TArray<AActor*>& Actors, ACameraActor* Camera)
 {
@@ -395,6 +326,53 @@ AActor* CPickingSystem::PerformViewportPicking(const TArray<AActor*>& Actors,
 	}
 }
 
+UPrimitiveComponent* CPickingSystem::PerformViewportComponentPicking(ACameraActor* Camera,
+	const FVector2D& ViewportMousePos,
+	const FVector2D& ViewportSize,
+	const FVector2D& ViewportOffset,
+	float ViewportAspectRatio, FViewport* Viewport)
+{
+	if (!Camera) return nullptr;
+	UWorld* CurrentWorld = Camera->GetWorld();
+	if (!CurrentWorld) return nullptr;
+	UWorldPartitionManager* Partition = CurrentWorld->GetPartitionManager();
+	if (!Partition) return nullptr;
+
+	const FMatrix View = Camera->GetViewMatrix();
+	const FMatrix Proj = Camera->GetProjectionMatrix(ViewportAspectRatio, Viewport);
+	const FRay Ray = MakeRayFromViewport(View, Proj, Camera->GetActorLocation(), Camera->GetRight(), Camera->GetUp(), Camera->GetForward(),
+		ViewportMousePos, ViewportSize, ViewportOffset);
+
+	FScopeCycleCounter PickCounter;
+	++TotalPickCount;
+
+	// 1) 월드 BVH로 가장 가까운 액터 (아직 트리에 없는 새 컴포넌트도 BVH 쿼리가 훑어 준다)
+	AActor* PickedActor = nullptr;
+	float PickedT = 1e9f;
+	Partition->RayQueryClosest(Ray, PickedActor, PickedT);
+
+	// 2) 그 액터의 메시 컴포넌트 중 실제로 가장 가까이 맞은 것 (메시 BVH)
+	UPrimitiveComponent* PickedComponent = nullptr;
+	if (PickedActor)
+	{
+		float BestT = FLT_MAX;
+		for (auto SceneComponent : PickedActor->GetSceneComponents())
+		{
+			UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(SceneComponent);
+			float HitT;
+			if (StaticMeshComponent && CheckComponentPicking(StaticMeshComponent, Ray, HitT) && HitT < BestT)
+			{
+				BestT = HitT;
+				PickedComponent = StaticMeshComponent;
+			}
+		}
+	}
+
+	LastPickTime = PickCounter.Finish();
+	TotalPickTime += LastPickTime;
+	return PickedComponent;
+}
+
 uint32 CPickingSystem::IsHoveringGizmoForViewport(AGizmoActor* GizmoTransActor, const ACameraActor* Camera,
 	const FVector2D& ViewportMousePos,
 	const FVector2D& ViewportSize,
@@ -657,42 +635,52 @@ bool CPickingSystem::CheckActorPicking(const AActor* Actor, const FRay& Ray, flo
 	{
 		if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(SceneComponent))
 		{
-			UStaticMesh* MeshRes = StaticMeshComponent->GetStaticMesh();
-			if (!MeshRes) continue;
-
-			FStaticMesh* StaticMesh = MeshRes->GetStaticMeshAsset();
-			if (!StaticMesh) continue;
-
-			// 로컬 공간에서의 레이로 변환
-			const FMatrix WorldMatrix = StaticMeshComponent->GetWorldMatrix();
-			const FMatrix InvWorld = WorldMatrix.InverseAffine();
-			const FVector4 RayOrigin4(Ray.Origin.X, Ray.Origin.Y, Ray.Origin.Z, 1.0f);
-			const FVector4 RayDir4(Ray.Direction.X, Ray.Direction.Y, Ray.Direction.Z, 0.0f);
-			const FVector4 LocalOrigin4 = RayOrigin4 * InvWorld;
-			const FVector4 LocalDir4 = RayDir4 * InvWorld;
-			const FRay LocalRay{ FVector(LocalOrigin4.X, LocalOrigin4.Y, LocalOrigin4.Z), FVector(LocalDir4.X, LocalDir4.Y, LocalDir4.Z) };
-
-			// 캐시된 BVH 사용 (동일 OBJ 경로는 동일 BVH 공유)
-			FMeshBVH* BVH = UResourceManager::GetInstance().GetOrBuildMeshBVH(MeshRes->GetAssetPathFileName(), StaticMesh);
-			if (BVH)
+			if (CheckComponentPicking(StaticMeshComponent, Ray, OutDistance))
 			{
-				float THitLocal;
-				if (BVH->IntersectRay(LocalRay, StaticMesh->Vertices, StaticMesh->Indices, THitLocal))
-				{
-					const FVector HitLocal = FVector(
-						LocalOrigin4.X + LocalDir4.X * THitLocal,
-						LocalOrigin4.Y + LocalDir4.Y * THitLocal,
-						LocalOrigin4.Z + LocalDir4.Z * THitLocal);
-					const FVector4 HitLocal4(HitLocal.X, HitLocal.Y, HitLocal.Z, 1.0f);
-					const FVector4 HitWorld4 = HitLocal4 * WorldMatrix;
-					const FVector HitWorld(HitWorld4.X, HitWorld4.Y, HitWorld4.Z);
-					const float THitWorld = (HitWorld - Ray.Origin).Size();
-					OutDistance = THitWorld;
-					return true;
-				}
+				return true;
 			}
 		}
 	}
 
 	return false;
 }
+
+bool CPickingSystem::CheckComponentPicking(const UStaticMeshComponent* Component, const FRay& Ray, float& OutDistance)
+{
+	if (!Component) return false;
+
+	UStaticMesh* MeshRes = Component->GetStaticMesh();
+	if (!MeshRes) return false;
+
+	FStaticMesh* StaticMesh = MeshRes->GetStaticMeshAsset();
+	if (!StaticMesh) return false;
+
+	// 로컬 공간에서의 레이로 변환
+	const FMatrix WorldMatrix = Component->GetWorldMatrix();
+	const FMatrix InvWorld = WorldMatrix.InverseAffine();
+	const FVector4 RayOrigin4(Ray.Origin.X, Ray.Origin.Y, Ray.Origin.Z, 1.0f);
+	const FVector4 RayDir4(Ray.Direction.X, Ray.Direction.Y, Ray.Direction.Z, 0.0f);
+	const FVector4 LocalOrigin4 = RayOrigin4 * InvWorld;
+	const FVector4 LocalDir4 = RayDir4 * InvWorld;
+	const FRay LocalRay{ FVector(LocalOrigin4.X, LocalOrigin4.Y, LocalOrigin4.Z), FVector(LocalDir4.X, LocalDir4.Y, LocalDir4.Z) };
+
+	// 캐시된 BVH 사용 (동일 OBJ 경로는 동일 BVH 공유)
+	FMeshBVH* BVH = UResourceManager::GetInstance().GetOrBuildMeshBVH(MeshRes->GetAssetPathFileName(), StaticMesh);
+	if (!BVH) return false;
+
+	float THitLocal;
+	if (!BVH->IntersectRay(LocalRay, StaticMesh->Vertices, StaticMesh->Indices, THitLocal))
+	{
+		return false;
+	}
+
+	const FVector HitLocal = FVector(
+		LocalOrigin4.X + LocalDir4.X * THitLocal,
+		LocalOrigin4.Y + LocalDir4.Y * THitLocal,
+		LocalOrigin4.Z + LocalDir4.Z * THitLocal);
+	const FVector4 HitLocal4(HitLocal.X, HitLocal.Y, HitLocal.Z, 1.0f);
+	const FVector4 HitWorld4 = HitLocal4 * WorldMatrix;
+	const FVector HitWorld(HitWorld4.X, HitWorld4.Y, HitWorld4.Z);
+	OutDistance = (HitWorld - Ray.Origin).Size();
+	return true;
+}
@@ -5,6 +5,7 @@
 #include "Enums.h"
 
 class UStaticMeshComponent;
+class UPrimitiveComponent;
 class AGizmoActor;
 // Forward Declarations
 class AActor;
@@ -79,6 +80,14 @@ public:
                                           const FVector2D& ViewportOffset,
                                           float ViewportAspectRatio, FViewport* Viewport);
 
+    // 월드 BVH + 메시 BVH로 CPU 레이 피킹해서 가장 가까운 메시 컴포넌트를 반환
+    // (ID 버퍼를 읽을 수 없는 렌더 스레드 모드에서 URenderer::GetPrimitiveCollided 대신 사용)
+    static UPrimitiveComponent* PerformViewportComponentPicking(ACameraActor* Camera,
+                                                                const FVector2D& ViewportMousePos,
+                                                                const FVector2D& ViewportSize,
+                                                                const FVector2D& ViewportOffset,
+                                                                float ViewportAspectRatio, FViewport* Viewport);
+
     // 뷰포트 정보를 명시적으로 받는 기즈모 호버링 검사
     static uint32 IsHoveringGizmoForViewport(AGizmoActor* GizmoActor, const ACameraActor* Camera,
                                              const FVector2D& ViewportMousePos,
@@ -91,6 +100,7 @@ public:
 
     /** === 헬퍼 함수들 === */
     static bool CheckActorPicking(const AActor* Actor, const FRay& Ray, float& OutDistance);
+    static bool CheckComponentPicking(const UStaticMeshComponent* Component, const FRay& Ray, float& OutDistance);
 
 
     static uint32 GetPickCount() { return TotalPickCount; }
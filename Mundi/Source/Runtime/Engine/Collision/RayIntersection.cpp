@@ -0,0 +1,74 @@
+﻿#include "pch.h"
+#include "Picking.h"
+
+// 레이-도형 교차 (선언은 Picking.h)
+// 피킹 시스템과 분리해 두어 MeshBVH 등 월드/뷰포트에 의존하지 않는 코드가 이것만 링크할 수 있음
+
+bool IntersectRaySphere(const FRay& InRay, const FVector& InCenter, float InRadius, float& OutT)
+{
+	// Solve ||(RayOrigin + T*RayDir) - Center||^2 = Radius^2
+	const FVector OriginToCenter = InRay.Origin - InCenter;
+	const float QuadraticA = FVector::Dot(InRay.Direction, InRay.Direction); // Typically 1 for normalized ray
+	const float QuadraticB = 2.0f * FVector::Dot(OriginToCenter, InRay.Direction);
+	const float QuadraticC = FVector::Dot(OriginToCenter, OriginToCenter) - InRadius * InRadius;
+
+	const float Discriminant = QuadraticB * QuadraticB - 4.0f * QuadraticA * QuadraticC;
+	if (Discriminant < 0.0f)
+	{
+		return false;
+	}
+
+	const float SqrtD = std::sqrt(Discriminant >= 0.0f ? Discriminant : 0.0f);
+	const float Inv2A = 1.0f / (2.0f * QuadraticA);
+	const float T0 = (-QuadraticB - SqrtD) * Inv2A;
+	const float T1 = (-QuadraticB + SqrtD) * Inv2A;
+
+	// Pick smallest positive T
+	const float ClosestT = (T0 > 0.0f) ? T0 : T1;
+	if (ClosestT <= 0.0f)
+	{
+		return false;
+	}
+
+	OutT = ClosestT;
+	return true;
+}
+
+// 삼각형을 이루는 3개의 점 
+bool IntersectRayTriangleMT(const FRay& InRay, const FVector& InA, const FVector& InB, const FVector& InC, float& OutT)
+{
+	const float Epsilon = KINDA_SMALL_NUMBER;
+
+	// 삼각형 한점으로 시작하는 두 벡터 
+	const FVector Edge1 = InB - InA;
+	const FVector Edge2 = InC - InA;
+
+	// 레이 방향과 , 삼각형 Edge와 수직한 벡터
+	const FVector Perpendicular = FVector::Cross(InRay.Direction, Edge2);
+	// 내적 했을때 0이라면, 세 벡터는 한 평면 안에 같이 있는 것이다. 
+	const float Determinant = FVector::Dot(Edge1, Perpendicular);
+
+	// 거의 0이면 평행 상태에 있다고 판단 
+	if (Determinant > -Epsilon && Determinant < Epsilon)
+		return false;
+
+	const float InvDeterminant = 1.0f / Determinant;
+	const FVector OriginToA = InRay.Origin - InA;
+	const float U = InvDeterminant * FVector::Dot(OriginToA, Perpendicular);
+	if (U < -Epsilon || U > 1.0f + Epsilon)
+		return false;
+
+	const FVector CrossQ = FVector::Cross(OriginToA, Edge1);
+	const float V = InvDeterminant * FVector::Dot(InRay.Direction, CrossQ);
+	if (V < -Epsilon || (U + V) > 1.0f + Epsilon)
+		return false;
+
+	const float Distance = InvDeterminant * FVector::Dot(Edge2, CrossQ);
+
+	if (Distance > Epsilon) // ray intersection
+	{
+		OutT = Distance;
+		return true;
+	}
+	return false;
+}
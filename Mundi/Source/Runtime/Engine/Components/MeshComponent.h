@@ -44,6 +44,14 @@ protected:
     TArray<UMaterialInterface*> MaterialSlots;
     TArray<UMaterialInstanceDynamic*> DynamicMaterialInstances;
 
+// LOD Section
+public:
+    int32 GetCurrentLOD() const { return CurrentLOD; }
+
+protected:
+    /** 마지막으로 선택된 LOD (MeshLOD::SelectLOD의 히스테리시스 기준) */
+    int32 CurrentLOD = 0;
+
 // Shadow Section
 public:
     bool IsCastShadows() const { return bCastShadows; }
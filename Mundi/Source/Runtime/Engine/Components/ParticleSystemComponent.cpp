@@ -145,10 +145,11 @@ void UParticleSystemComponent::TickComponent(float DeltaTime)
         QueryBox.Min = Center - FVector(SearchRadius, SearchRadius, SearchRadius);
         QueryBox.Max = Center + FVector(SearchRadius, SearchRadius, SearchRadius);
 
-        TArray<UPrimitiveComponent*> Candidates = GetWorld()->GetPartitionManager()->GetBVH()->QueryIntersectedComponents(QueryBox);
-        Context.WorldColliders.Reserve(Candidates.Num());
+        ColliderCandidates.clear();
+        GetWorld()->GetPartitionManager()->GetBVH()->QueryIntersectedComponents(QueryBox, ColliderCandidates);
+        Context.WorldColliders.Reserve(ColliderCandidates.Num());
 
-        for (UPrimitiveComponent* Prim : Candidates)
+        for (UPrimitiveComponent* Prim : ColliderCandidates)
         {
             UShapeComponent* ShapeComponent = Cast<UShapeComponent>(Prim);
             if (!ShapeComponent) continue;
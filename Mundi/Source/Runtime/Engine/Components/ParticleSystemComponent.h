@@ -102,6 +102,8 @@ private:
 	//Async
 	FParticleAsyncUpdater AsyncUpdater;
 	float AccumulatedDeltaTime = 0.0f;
+	// 충돌체 후보 BVH 쿼리 결과 (매 틱 재사용)
+	TArray<UPrimitiveComponent*> ColliderCandidates;
 
 public:
 	// Settings
@@ -32,7 +32,11 @@ public:
 
     virtual FAABB GetWorldAABB() const { return FAABB(); }
 
+    // 수집 전에 게임 스레드에서 한 번 호출됩니다. 즉시 컨텍스트를 쓰는 버퍼 갱신처럼 스레드 안전하지 않은 일은 여기서 합니다.
+    virtual void PrepareMeshBatches(const FSceneView* View) {}
+
     // 이 프리미티브를 렌더링하는 데 필요한 FMeshBatchElement를 수집합니다.
+    // 메시 컴포넌트는 워커 스레드에서 병렬로 불릴 수 있으므로 (FMeshBatchCollector) GWorld를 읽거나 GPU 리소스를 만들면 안 됩니다.
     virtual void CollectMeshBatches(TArray<FMeshBatchElement>& OutMeshBatchElements, const FSceneView* View) {}
 
     virtual UMaterialInterface* GetMaterial(uint32 InElementIndex) const
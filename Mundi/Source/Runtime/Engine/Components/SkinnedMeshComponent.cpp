@@ -5,6 +5,10 @@
 #include "MeshBatchElement.h"
 #include "PlatformTime.h"
 #include "SceneView.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include "PackedVertex.h"
+#include "MeshLOD.h"
+#include "RenderSettings.h"
 
 USkinnedMeshComponent::USkinnedMeshComponent() : SkeletalMesh(nullptr)
 {
@@ -112,17 +116,24 @@ void USkinnedMeshComponent::DuplicateSubObjects()
 //    Renderer->EndLineBatch(FMatrix::Identity());
 // }
 
-void USkinnedMeshComponent::CollectMeshBatches(TArray<FMeshBatchElement>& OutMeshBatchElements, const FSceneView* View)
+void USkinnedMeshComponent::PrepareMeshBatches(const FSceneView* View)
 {
    if (!SkeletalMesh || !SkeletalMesh->GetSkeletalMeshData()) { return; }
 
-   bForceGPUSkinning = GWorld->GetRenderSettings().IsShowFlagEnabled(EEngineShowFlags::SF_GPUSkinning);         
+   bForceGPUSkinning = View->RenderSettings && View->RenderSettings->IsShowFlagEnabled(EEngineShowFlags::SF_GPUSkinning);
 
    if (bSkinningMatricesDirty && !bForceGPUSkinning)
    {
       TIME_PROFILE(VertexBuffer)
       bSkinningMatricesDirty = false;
-      SkeletalMesh->UpdateVertexBuffer(SkinnedVertices, CPUSkinnedVertexBuffer);
+      if (PackedVertex::IsEnabled())
+      {
+         SkeletalMesh->UpdateVertexBuffer(PackedSkinnedVertices, CPUSkinnedVertexBuffer);
+      }
+      else
+      {
+         SkeletalMesh->UpdateVertexBuffer(SkinnedVertices, CPUSkinnedVertexBuffer);
+      }
       TIME_PROFILE_END(VertexBuffer)
    }
 
@@ -143,6 +154,14 @@ void USkinnedMeshComponent::CollectMeshBatches(TArray<FMeshBatchElement>& OutMes
                                         FinalSkinningNormalMatrices.Num());
       TIME_PROFILE_END(StructuredBuffer)
    }
+}
+
+void USkinnedMeshComponent::CollectMeshBatches(TArray<FMeshBatchElement>& OutMeshBatchElements, const FSceneView* View)
+{
+   if (!SkeletalMesh || !SkeletalMesh->GetSkeletalMeshData()) { return; }
+
+   // 스키닝 방식(bForceGPUSkinning)과 정점/본 행렬 버퍼는 PrepareMeshBatches에서 이미 갱신됨
+   static const FShaderMacro GPUSkinningMacro("USE_GPU_SKINNING", "1");
 
    const TArray<FGroupInfo>& MeshGroupInfos = SkeletalMesh->GetMeshGroupInfo();
    auto DetermineMaterialAndShader = [&](uint32 SectionIndex) -> TPair<UMaterialInterface*, UShader*>
@@ -174,22 +193,14 @@ void USkinnedMeshComponent::CollectMeshBatches(TArray<FMeshBatchElement>& OutMes
    const bool bHasSections = !MeshGroupInfos.IsEmpty();
    const uint32 NumSectionsToProcess = bHasSections ? static_cast<uint32>(MeshGroupInfos.size()) : 1;
 
+   // 정점은 모든 LOD가 공유하므로 스키닝은 그대로, 그리는 인덱스 범위만 LOD에 따라 바뀜
+   CurrentLOD = MeshLOD::SelectLOD(View, GetWorldAABB(), SkeletalMesh->GetLODs(), CurrentLOD);
+
    for (uint32 SectionIndex = 0; SectionIndex < NumSectionsToProcess; ++SectionIndex)
    {
       uint32 IndexCount = 0;
       uint32 StartIndex = 0;
-
-      if (bHasSections)
-      {
-         const FGroupInfo& Group = MeshGroupInfos[SectionIndex];
-         IndexCount = Group.IndexCount;
-         StartIndex = Group.StartIndex;
-      }
-      else
-      {
-         IndexCount = SkeletalMesh->GetIndexCount();
-         StartIndex = 0;
-      }
+      SkeletalMesh->GetSectionRange(CurrentLOD, SectionIndex, StartIndex, IndexCount);
 
       if (IndexCount == 0)
       {
@@ -206,7 +217,7 @@ void USkinnedMeshComponent::CollectMeshBatches(TArray<FMeshBatchElement>& OutMes
       TArray<FShaderMacro> ShaderMacros = View->ViewShaderMacros;
       if (bForceGPUSkinning)
       {
-         ShaderMacros.Add(FShaderMacro("USE_GPU_SKINNING", "1"));
+         ShaderMacros.Add(GPUSkinningMacro);
       }
 
       if (0 < MaterialToUse->GetShaderMacros().Num())
@@ -390,7 +401,16 @@ void USkinnedMeshComponent::PerformSkinning()
    const int32 NumVertices = SrcVertices.Num();
    SkinnedVertices.SetNum(NumVertices);
 
-   for (int32 Idx = 0; Idx < NumVertices; ++Idx)
+   // 압축 포맷이면 스키닝하면서 바로 인코딩 (업로드 시 추가 패스 없음)
+   const bool bPackVertices = PackedVertex::IsEnabled();
+   if (bPackVertices)
+   {
+      PackedSkinnedVertices.SetNum(NumVertices);
+   }
+
+   // 정점마다 독립적이므로 워커 풀에 분배 (묶음 단위가 작으면 스케줄링 비용이 더 큼)
+   constexpr int32 SkinningGrainSize = 1024;
+   ParallelFor(NumVertices, [this, &SrcVertices, bPackVertices](int32 Idx)
    {
       const FSkinnedVertex& SrcVert = SrcVertices[Idx];
       FNormalVertex& DstVert = SkinnedVertices[Idx];
@@ -399,7 +419,12 @@ void USkinnedMeshComponent::PerformSkinning()
       DstVert.normal = SkinVertexNormal(SrcVert);
       DstVert.Tangent = SkinVertexTangent(SrcVert);
       DstVert.tex = SrcVert.UV;
-   }
+
+      if (bPackVertices)
+      {
+         PackedSkinnedVertices[Idx].FillFrom(DstVert);
+      }
+   }, SkinningGrainSize);
    TIME_PROFILE_END(CPUSkinning)   
 }
 
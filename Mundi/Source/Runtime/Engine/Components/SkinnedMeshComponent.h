@@ -22,6 +22,7 @@ public:
     
 // Mesh Component Section
 public:
+    void PrepareMeshBatches(const FSceneView* View) override;
     void CollectMeshBatches(TArray<FMeshBatchElement>& OutMeshBatchElements, const FSceneView* View) override;
     
     FAABB GetWorldAABB() const override;
@@ -62,6 +63,10 @@ protected:
      * @brief CPU 스키닝 최종 결과물. 렌더러가 이 데이터를 사용합니다.
      */
     TArray<FNormalVertex> NormalSkinnedVertices;
+    /**
+     * @brief 압축 정점 포맷(PackedVertex)을 쓸 때 SkinnedVertices 대신 업로드하는 압축 사본
+     */
+    TArray<FPackedVertex> PackedSkinnedVertices;
 
 private:
     FVector SkinVertexPosition(const FSkinnedVertex& InVertex) const;
@@ -58,6 +58,11 @@ void USpotLightComponent::GetShadowRenderRequests(FSceneView* View, TArray<FShad
 	ShadowRenderRequest.WorldLocation = GetWorldLocation();
 	ShadowRenderRequest.Radius = GetAttenuationRadius();
 	ShadowRenderRequest.Size = ShadowResolutionScale;
+	// 화면에 작게 보이는 라이트는 아틀라스 해상도를 낮춤
+	if (View)
+	{
+		ShadowRenderRequest.ScreenImportance = FShadowAtlasAllocator::ComputeScreenImportance(View->ViewMatrix, View->ProjectionMatrix, ShadowRenderRequest.WorldLocation, ShadowRenderRequest.Radius);
+	}
 	// ShadowRenderRequest.ViewMatrix = GetViewMatrix() * GetProjectionMatrix();
 	// ShadowRenderRequest.ProjectionMatrix = WarpMatrix;
 	ShadowRenderRequest.SubViewIndex = 0;
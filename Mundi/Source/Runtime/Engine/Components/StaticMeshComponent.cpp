@@ -9,6 +9,8 @@
 #include "MeshBatchElement.h"
 #include "Material.h"
 #include "SceneView.h"
+#include "MeshLOD.h"
+#include "RenderSettings.h"
 #include "LuaBindHelpers.h"
 #include "Source/Runtime/Engine/Physics/BodyInstance.h"
 #include "Source/Runtime/Engine/Physics/PhysScene.h"
@@ -190,22 +192,18 @@ void UStaticMeshComponent::CollectMeshBatches(TArray<FMeshBatchElement>& OutMesh
 	const bool bHasSections = !MeshGroupInfos.IsEmpty();
 	const uint32 NumSectionsToProcess = bHasSections ? static_cast<uint32>(MeshGroupInfos.size()) : 1;
 
+	CurrentLOD = MeshLOD::SelectLOD(View, GetWorldAABB(), StaticMesh->GetLODs(), CurrentLOD);
+
+	// 자동 인스턴싱: 셰이더가 USE_INSTANCING을 지원하면 같은 상태의 다른 배치와 합칠 수 있도록 변형을 함께 넘김
+	const bool bAutoInstancing = View->RenderSettings && View->RenderSettings->IsAutoInstancing();
+	// 워커 스레드에서 FName 풀을 건드리지 않도록 한 번만 만듦
+	static const FShaderMacro InstancingMacro("USE_INSTANCING", "1");
+
 	for (uint32 SectionIndex = 0; SectionIndex < NumSectionsToProcess; ++SectionIndex)
 	{
 		uint32 IndexCount = 0;
 		uint32 StartIndex = 0;
-
-		if (bHasSections)
-		{
-			const FGroupInfo& Group = MeshGroupInfos[SectionIndex];
-			IndexCount = Group.IndexCount;
-			StartIndex = Group.StartIndex;
-		}
-		else
-		{
-			IndexCount = StaticMesh->GetIndexCount();
-			StartIndex = 0;
-		}
+		StaticMesh->GetSectionRange(CurrentLOD, SectionIndex, StartIndex, IndexCount);
 
 		if (IndexCount == 0)
 		{
@@ -234,6 +232,17 @@ void UStaticMeshComponent::CollectMeshBatches(TArray<FMeshBatchElement>& OutMesh
 			BatchElement.InputLayout = ShaderVariant->InputLayout;
 		}
 
+		if (bAutoInstancing && ShaderToUse->SupportsInstancing())
+		{
+			ShaderMacros.Add(InstancingMacro);
+			if (FShaderVariant* InstancingVariant = ShaderToUse->GetOrCompileShaderVariant(ShaderMacros))
+			{
+				BatchElement.InstancingVertexShader = InstancingVariant->VertexShader;
+				BatchElement.InstancingPixelShader = InstancingVariant->PixelShader;
+				BatchElement.InstancingInputLayout = InstancingVariant->InputLayout;
+			}
+		}
+
 		// UMaterialInterface를 UMaterial로 캐스팅해야 할 수 있음. 렌더러가 UMaterial을 기대한다면.
 		// 지금은 Material.h 구조상 UMaterialInterface에 필요한 정보가 다 있음.
 		BatchElement.Material = MaterialToUse;
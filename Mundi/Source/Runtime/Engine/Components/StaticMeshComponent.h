@@ -61,6 +61,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Static Mesh", Tooltip="Static mesh asset to render")
 	UStaticMesh* StaticMesh = nullptr;
 
+	// 오클루전 컬링
+	UPROPERTY(EditAnywhere, Category="Rendering", Tooltip="화면에서 충분히 크면 CPU 오클루전 컬링의 오클루더(가리개)로 사용 (유리, 철망처럼 뒤가 보이는 메시는 끌 것)")
+	bool bUseAsOccluder = true;
+
+	UPROPERTY(EditAnywhere, Category="Rendering", Tooltip="화면 크기와 상관없이 항상 오클루더로 우선 사용 (벽, 건물 외벽 등)")
+	bool bForceOccluder = false;
+
 	// Physics 설정
 	UPROPERTY(EditAnywhere, Category="Physics", Tooltip="체크 시 Static 물리 전환, 체크 해제 시 물리 제거")
 	bool bEnableCollision = true;
@@ -117,6 +124,13 @@ public:
 	bool IsSimulatingPhysics() const { return bSimulatePhysics; }
 	void SetSimulatePhysics(bool bSimulate) { bSimulatePhysics = bSimulate; }
 
+	// 오클루전 컬링
+	bool IsUsedAsOccluder() const { return bUseAsOccluder; }
+	void SetUseAsOccluder(bool bUse) { bUseAsOccluder = bUse; }
+
+	bool IsForceOccluder() const { return bUseAsOccluder && bForceOccluder; }
+	void SetForceOccluder(bool bForce) { bForceOccluder = bForce; }
+
 	// Getters/Setters for physics properties
 	float GetMassOverride() const { return MassOverride; }
 	void SetMassOverride(float InMass) { MassOverride = InMass; }
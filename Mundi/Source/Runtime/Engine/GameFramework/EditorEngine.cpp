@@ -12,6 +12,10 @@
 #include <roapi.h>
 
 #include "Source/Runtime/Debug/CrashHandler.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include "FrameTimingStats.h"
+#include "AllocationCounter.h"
+#include "PlatformTime.h"
 
 float UEditorEngine::ClientWidth = 1024.0f;
 float UEditorEngine::ClientHeight = 1024.0f;
@@ -182,11 +186,17 @@ bool UEditorEngine::CreateMainWindow(HINSTANCE hInstance)
 
 bool UEditorEngine::Startup(HINSTANCE hInstance)
 {
+    // 시작 시간/상주 메모리 보고 (마지막 레벨 로드까지)
+    FAssetRegistry::GetInstance().BeginStartup();
+
     LoadIniFile();
 
     if (!CreateMainWindow(hInstance))
         return false;
 
+    // 작업 스케줄러 (에셋 로딩/물리/파티클/스키닝이 같은 워커 풀을 공유)
+    FTaskGraph::GetInstance().Initialize();
+
     //디바이스 리소스 및 렌더러 생성
     RHIDevice.Initialize(HWnd);
     Renderer = std::make_unique<URenderer>(&RHIDevice);
@@ -198,7 +208,8 @@ bool UEditorEngine::Startup(HINSTANCE hInstance)
     UI.Initialize(HWnd, RHIDevice.GetDevice(), RHIDevice.GetDeviceContext());
     INPUT.Initialize(HWnd);
 
-    FObjManager::Preload(); 
+    // Data 전체를 미리 로드하지 않고 에셋 목록만 갱신. 메시/텍스처는 레벨 로드 시 참조된 것 + 에디터에서 고른 것만 로드
+    FAssetRegistry::GetInstance().Initialize();
     UFbxLoader::PreLoad();
     FAudioDevice::Preload();
     RESOURCE.PreloadParticles();
@@ -222,6 +233,7 @@ bool UEditorEngine::Startup(HINSTANCE hInstance)
 
     GPU_PROFILER.Initialize(&RHIDevice);
 
+    FAssetRegistry::GetInstance().EndStartup();
 
 
     bRunning = true;
@@ -230,6 +242,9 @@ bool UEditorEngine::Startup(HINSTANCE hInstance)
 
 void UEditorEngine::Tick(float DeltaSeconds)
 {
+    // 워커에서 준비가 끝난 비동기 로드 마무리 (GPU 리소스 생성 + 완료 콜백)
+    RESOURCE.ProcessAsyncLoads();
+
     //@TODO UV 스크롤 입력 처리 로직 이동
     HandleUVInput(DeltaSeconds);
     
@@ -337,12 +352,24 @@ void UEditorEngine::MainLoop()
             bChangedPieToEditor = false;
         }
 
+        // 에디터는 항상 직렬 (Tick → Render → Present). STAT THREADS 비교용으로 시간만 기록
+        FFrameTimingStats TimingStats;
+        TimingStats.FrameNumber = ++FrameNumber;
+        TimingStats.FrameMS = DeltaSeconds * 1000.0f;
+
+        const uint64 TickStart = FPlatformTime::Cycles64();
         Tick(DeltaSeconds);
+        const uint64 RenderStart = FPlatformTime::Cycles64();
         Render();
         
         // Shader Hot Reloading - Call AFTER render to avoid mid-frame resource conflicts
         // This ensures all GPU commands are submitted before we check for shader updates
         UResourceManager::GetInstance().CheckAndReloadShaders(DeltaSeconds);
+
+        TimingStats.GameTickMS = static_cast<float>(FPlatformTime::ToMilliseconds(RenderStart - TickStart));
+        TimingStats.GameRenderMS = static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - RenderStart));
+        FFrameTimingStatManager::GetInstance().UpdateStats(TimingStats);
+        FAllocationCounter::EndFrame(FrameNumber);
     }
 }
 
@@ -375,6 +402,8 @@ void UEditorEngine::Shutdown()
     // before the global GEngine variable's destructor runs
     FObjManager::Clear();
 
+    // 남은 비동기 작업을 모두 끝낸 뒤 워커 종료
+    FTaskGraph::GetInstance().Shutdown();
      
     // IMPORTANT: Explicitly release Renderer before RHIDevice destructor runs
     // Renderer may hold references to D3D resources
@@ -73,6 +73,7 @@ private:
     bool bPIEActive = false;
     float UVScrollTime = 0.0f;
     FVector2D UVScrollSpeed = FVector2D(0.5f, 0.5f);
+    uint64 FrameNumber = 0;
 
     // 클라이언트 사이즈
     static float ClientWidth;
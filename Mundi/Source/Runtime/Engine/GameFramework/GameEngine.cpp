@@ -9,6 +9,12 @@
 #include <sol/sol.hpp>
 
 #include "BlueprintGraph/BlueprintActionDatabase.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include "RenderThread.h"
+#include "FrameTimingStats.h"
+#include "AllocationCounter.h"
+#include "PlatformTime.h"
+#include "StatsOverlayD2D.h"
 
 float UGameEngine::ClientWidth = 1024.0f;
 float UGameEngine::ClientHeight = 1024.0f;
@@ -93,13 +99,7 @@ LRESULT CALLBACK UGameEngine::WndProc(HWND hWnd, UINT message, WPARAM wParam, LP
 
             UINT NewWidth = static_cast<UINT>(ClientWidth);
             UINT NewHeight = static_cast<UINT>(ClientHeight);
-            GEngine.GetRHIDevice()->OnResize(NewWidth, NewHeight);
-#ifdef _GAME
-            if (GEngine.GameViewport.get())
-            {
-                GEngine.GameViewport.get()->Resize(0, 0, NewWidth, NewHeight);
-            }
-#endif
+            GEngine.RequestResize(NewWidth, NewHeight);
             // Save CLIENT AREA size (will be converted back to window size on load)
             EditorINI["WindowWidth"] = std::to_string(NewWidth);
             EditorINI["WindowHeight"] = std::to_string(NewHeight);
@@ -173,15 +173,37 @@ bool UGameEngine::CreateMainWindow(HINSTANCE hInstance)
 
 bool UGameEngine::Startup(HINSTANCE hInstance)
 {
+    // 시작 시간/상주 메모리 보고 (시작 레벨 로드까지)
+    FAssetRegistry::GetInstance().BeginStartup();
+
     LoadIniFile();
 
     if (!CreateMainWindow(hInstance))
         return false;
 
+    // 작업 스케줄러 (에셋 로딩/물리/파티클/스키닝이 같은 워커 풀을 공유)
+    FTaskGraph::GetInstance().Initialize();
+
+    // 렌더 스레드 모드 (기본 꺼짐)
+    // 게임 스레드는 프레임 N을 지연 컨텍스트에 기록해 명령 리스트로 넘기고, 렌더 스레드가 실행 + Present하는 동안 N+1을 Tick
+    const bool bUseRenderThread = EditorINI.count("RenderThread") && EditorINI["RenderThread"] == "1";
+
     // 디바이스 리소스 및 렌더러 생성
-    RHIDevice.Initialize(HWnd);
+    RHIDevice.Initialize(HWnd, bUseRenderThread);
     Renderer = std::make_unique<URenderer>(&RHIDevice);
 
+    RenderThread = std::make_unique<FRenderThread>();
+    if (bUseRenderThread && RHIDevice.IsDeferredRecording())
+    {
+        // 게임 스레드의 셰이더 핫 리로드가 즉시 컨텍스트에 닿으므로 안전망으로 켜 둠
+        RHIDevice.SetMultithreadProtected(true);
+        // 창 스레드가 렌더 스레드를 기다리는 동안에도 메시지 처리 (Present가 창 메시지를 기다릴 수 있음)
+        RenderThread->SetWaitPump([this]() { PumpMessages(); });
+        RenderThread->Start();
+        UStatsOverlayD2D::Get().SetShowThreads(true);
+        UE_LOG("[GameEngine] Render thread mode enabled");
+    }
+
     // Initialize audio device for game runtime
     FAudioDevice::Initialize();
 
@@ -196,7 +218,8 @@ bool UGameEngine::Startup(HINSTANCE hInstance)
     // 매니저 초기화
     INPUT.Initialize(HWnd);
 
-    FObjManager::Preload();
+    // Data 전체를 미리 로드하지 않고 에셋 목록만 갱신. 메시/텍스처는 레벨 로드 시 참조된 것만 로드
+    FAssetRegistry::GetInstance().Initialize();
     FAudioDevice::Preload();
     RESOURCE.PreloadParticles();
 
@@ -222,6 +245,8 @@ bool UGameEngine::Startup(HINSTANCE hInstance)
         Actor->BeginPlay();
     }
 
+    FAssetRegistry::GetInstance().EndStartup();
+
     bPlayActive = true;
     bRunning = true;
     return true;
@@ -243,6 +268,8 @@ void UGameEngine::Tick(float DeltaSeconds)
 
 void UGameEngine::Render()
 {
+    ApplyUVScroll();
+
     Renderer->BeginFrame();
 
     if (GWorld)
@@ -263,7 +290,8 @@ void UGameEngine::Render()
         }
     }
 
-    Renderer->EndFrame();
+    // 오버레이 통계 수집과 Present는 MainLoop가 렌더 스레드로 넘김
+    Renderer->FinishFrame();
 }
 
 void UGameEngine::HandleUVInput(float DeltaSeconds)
@@ -275,17 +303,77 @@ void UGameEngine::HandleUVInput(float DeltaSeconds)
         if (bUVScrollPaused)
         {
             UVScrollTime = 0.0f;
-            if (Renderer) Renderer->GetRHIDevice()->UpdateUVScrollConstantBuffers(UVScrollSpeed, UVScrollTime);
+            bUVScrollDirty = true;
         }
     }
     if (!bUVScrollPaused)
     {
         UVScrollTime += DeltaSeconds;
-        if (Renderer) Renderer->GetRHIDevice()->UpdateUVScrollConstantBuffers(UVScrollSpeed, UVScrollTime);
+        bUVScrollDirty = true;
     }
 
 }
 
+void UGameEngine::ApplyUVScroll()
+{
+    if (bUVScrollDirty && Renderer)
+    {
+        Renderer->GetRHIDevice()->UpdateUVScrollConstantBuffers(UVScrollSpeed, UVScrollTime);
+    }
+    bUVScrollDirty = false;
+}
+
+void UGameEngine::FlushRenderThread()
+{
+    if (RenderThread)
+    {
+        RenderThread->Flush();
+    }
+}
+
+void UGameEngine::PumpMessages()
+{
+    MSG msg;
+    // 처리할 메시지가 더 이상 없을때 까지 수행
+    while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+    {
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (msg.message == WM_QUIT)
+        {
+            bRunning = false;
+            break;
+        }
+    }
+}
+
+void UGameEngine::RequestResize(UINT NewWidth, UINT NewHeight)
+{
+    // 렌더 스레드 모드에서는 렌더 스레드를 기다리며 펌프한 메시지일 수 있으므로 여기서 기다리지 않고 다음 프레임 시작 때 적용
+    if (RenderThread && RenderThread->IsRunning())
+    {
+        PendingResizeWidth = NewWidth;
+        PendingResizeHeight = NewHeight;
+        bResizePending = true;
+        return;
+    }
+
+    ApplyResize(NewWidth, NewHeight);
+}
+
+void UGameEngine::ApplyResize(UINT NewWidth, UINT NewHeight)
+{
+    // 렌더 스레드가 넘겨받은 명령 리스트가 백버퍼를 참조하므로 스왑 체인을 건드리기 전에 모두 실행
+    FlushRenderThread();
+    RHIDevice.OnResize(NewWidth, NewHeight);
+#ifdef _GAME
+    if (GameViewport)
+    {
+        GameViewport->Resize(0, 0, NewWidth, NewHeight);
+    }
+#endif
+}
+
 void UGameEngine::MainLoop()
 {
     LARGE_INTEGER Frequency;
@@ -294,39 +382,89 @@ void UGameEngine::MainLoop()
     LARGE_INTEGER PrevTime, CurrTime;
     QueryPerformanceCounter(&PrevTime);
 
-    MSG msg;
-
     while (bRunning)
     {
         QueryPerformanceCounter(&CurrTime);
         float DeltaSeconds = static_cast<float>((CurrTime.QuadPart - PrevTime.QuadPart) / double(Frequency.QuadPart));
         PrevTime = CurrTime;
 
-        // 처리할 메시지가 더 이상 없을때 까지 수행
-        while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+        PumpMessages();
+
+        if (!bRunning) break;
+
+        // WM_SIZE에서 미뤄 둔 스왑 체인 리사이즈 (렌더 스레드 모드)
+        if (bResizePending)
         {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-            if (msg.message == WM_QUIT)
-            {
-                bRunning = false;
-                break;
-            }
+            bResizePending = false;
+            ApplyResize(PendingResizeWidth, PendingResizeHeight);
         }
 
-        if (!bRunning) break;
+        ++FrameNumber;
+
+        FFrameTimingStats TimingStats;
+        TimingStats.bRenderThread = RenderThread->IsRunning();
+        TimingStats.FrameNumber = FrameNumber;
+        TimingStats.FrameMS = DeltaSeconds * 1000.0f;
 
+        // 워커에서 준비가 끝난 비동기 로드 마무리 (GPU 리소스 생성 + 완료 콜백)
+        // 렌더 스레드 모드에서는 여기부터 Render까지의 컨텍스트 사용이 모두 이번 프레임 명령 리스트에 기록됨
+        RESOURCE.ProcessAsyncLoads();
+
+        const uint64 TickStart = FPlatformTime::Cycles64();
         Tick(DeltaSeconds);
+        TimingStats.GameTickMS = static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - TickStart));
+
+        const uint64 RenderStart = FPlatformTime::Cycles64();
         Render();
 
         // Shader Hot Reloading - Call AFTER render to avoid mid-frame resource conflicts
         // This ensures all GPU commands are submitted before we check for shader updates
         UResourceManager::GetInstance().CheckAndReloadShaders(DeltaSeconds);
+
+        // 프레임 N의 불변 스냅샷: 기록을 닫은 명령 리스트 + 오버레이 패널 문자열
+        // 렌더 스레드는 씬/UObject를 읽지 않으므로 게임 스레드는 바로 N+1을 Tick
+        // 씬 스냅샷은 없음: 수집/기록은 위 Render()에서 게임 스레드가 끝내고, 렌더 스레드는 실행 + Present만 맡음
+        ID3D11CommandList* CommandList = RHIDevice.FinishRecording();
+        FStatsOverlayFrame OverlayFrame = UStatsOverlayD2D::Get().CaptureFrame();
+        TimingStats.GameRenderMS = static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - RenderStart));
+
+        // 렌더 스레드 모드가 아니면 여기서 바로 실행됨 (CommandList는 nullptr, 즉시 컨텍스트에 이미 제출됨)
+        TimingStats.GameWaitMS = static_cast<float>(RenderThread->EnqueueFrame(FrameNumber, [this, CommandList, OverlayFrame = std::move(OverlayFrame)]()
+        {
+            RHIDevice.ExecuteRecording(CommandList);
+            UStatsOverlayD2D::Get().DrawFrame(OverlayFrame);
+            RHIDevice.PresentSwapChain();
+        }));
+
+        // 렌더 스레드 시간은 EnqueueFrame이 끝나기를 기다린 프레임 기준 (렌더 스레드 모드면 한 프레임 늦게, 그 프레임 번호와 함께)
+        // 렌더 스레드는 지금 이번 프레임을 실행 중일 수 있으므로 "마지막으로 끝난 프레임"을 읽으면 프레임이 섞임
+        const uint64 RenderTimedFrame = TimingStats.bRenderThread ? FrameNumber - FRenderThread::MaxFramesInFlight : FrameNumber;
+        FRenderFrameTiming RenderTiming;
+        if (RenderThread->GetFrameTiming(RenderTimedFrame, RenderTiming))
+        {
+            TimingStats.RenderFrameNumber = RenderTiming.FrameNumber;
+            TimingStats.RenderThreadMS = static_cast<float>(RenderTiming.WorkMS);
+            TimingStats.RenderIdleMS = static_cast<float>(RenderTiming.IdleMS);
+        }
+
+        TimingStats.CalculateStats();
+        FFrameTimingStatManager::GetInstance().UpdateStats(TimingStats);
+        FAllocationCounter::EndFrame(FrameNumber);
     }
+
+    // 마지막 프레임 Present까지 끝낸 뒤 Shutdown으로
+    FlushRenderThread();
 }
 
 void UGameEngine::Shutdown()
 {
+    // 렌더 스레드부터 정지 (남은 프레임 실행 후 종료)
+    if (RenderThread)
+    {
+        RenderThread->Stop();
+        RHIDevice.SetMultithreadProtected(false);
+    }
+
     // AudioDevice 종료 (반드시 ObjectFactory::DeleteAll 이전에 호출)
     // 컴포넌트들이 아직 Tick 중일 수 있으므로 먼저 오디오 시스템을 정지시켜야 함
     FAudioDevice::Shutdown();
@@ -348,6 +486,9 @@ void UGameEngine::Shutdown()
     // before the global GEngine variable's destructor runs
     FObjManager::Clear();
 
+    // 남은 비동기 작업을 모두 끝낸 뒤 워커 종료
+    FTaskGraph::GetInstance().Shutdown();
+
     // IMPORTANT: Explicitly release Renderer before RHIDevice destructor runs
     // Renderer may hold references to D3D resources
     Renderer.reset();
@@ -5,6 +5,7 @@ class URenderer;
 class D3D11RHI;
 class UWorld;
 class FViewport;
+class FRenderThread;
 
 class UGameEngine final
 {
@@ -39,6 +40,18 @@ private:
     void Render();
 
     void HandleUVInput(float DeltaSeconds);
+    // HandleUVInput이 바꾼 값을 상수 버퍼에 반영 (즉시 컨텍스트를 쓰므로 Render 시작 때)
+    void ApplyUVScroll();
+
+    // 렌더 스레드에 넘긴 프레임을 모두 끝낼 때까지 대기 (스왑 체인 리사이즈 전)
+    void FlushRenderThread();
+
+    // 창 메시지 처리 (MainLoop 시작 + 렌더 스레드를 기다리는 동안). WM_QUIT이면 bRunning = false
+    void PumpMessages();
+
+    // WM_SIZE. 렌더 스레드 모드면 다음 프레임 시작 때 ApplyResize
+    void RequestResize(UINT NewWidth, UINT NewHeight);
+    void ApplyResize(UINT NewWidth, UINT NewHeight);
 
 private:
     //윈도우 핸들
@@ -51,12 +64,22 @@ private:
     //게임의 메인 뷰포트
     std::unique_ptr<FViewport> GameViewport;
 
+    // 렌더 스레드 모드 (editor.ini RenderThread = 1)
+    // 게임 스레드가 N+1 프레임을 Tick하고 기록하는 동안 렌더 스레드가 N 프레임 명령 리스트를 실행하고 Present
+    std::unique_ptr<FRenderThread> RenderThread;
+    uint64 FrameNumber = 0;
+
+    bool bResizePending = false;
+    UINT PendingResizeWidth = 0;
+    UINT PendingResizeHeight = 0;
+
     //월드 핸들
     TArray<FWorldContext> WorldContexts;
 
     //틱 상태
     bool bRunning = false;
     bool bUVScrollPaused = true;
+    bool bUVScrollDirty = false;
     bool bPlayActive = false;
     float UVScrollTime = 0.0f;
     FVector2D UVScrollSpeed = FVector2D(0.5f, 0.5f);
@@ -11,6 +11,7 @@
 #include "USlateManager.h"
 #include "StaticMesh.h"
 #include "ObjManager.h"
+#include "AssetRegistry.h"
 #include "WorldPartitionManager.h"
 #include "PrimitiveComponent.h"
 #include "Octree.h"
@@ -174,6 +175,7 @@ bool UWorld::TryLoadLastUsedLevel()
 	JSON LevelJsonData;
 	if (FJsonSerializer::LoadJsonFromFile(LevelJsonData, LastUsedLevelPath))
 	{
+		FAssetRegistry::GetInstance().PrefetchLevelAssets(LevelJsonData);
 		NewLevel->Serialize(true, LevelJsonData);
 	}
 	else
@@ -195,6 +197,7 @@ bool UWorld::LoadLevelFromFile(const FWideString& Path)
 
 	if (FJsonSerializer::LoadJsonFromFile(LevelJsonData, Path))
 	{
+		FAssetRegistry::GetInstance().PrefetchLevelAssets(LevelJsonData);
 		NewLevel->Serialize(true, LevelJsonData);
 	}
 	else
@@ -275,7 +278,7 @@ void UWorld::Tick(float DeltaSeconds)
     // Skip partition update for preview worlds (no spatial partitioning needed)
     if (Partition)
     {
-        Partition->Update(DeltaSeconds, /*budget*/256);
+        Partition->Update(DeltaSeconds);
     }
 
 	// 물리 결과 수확 (PIE에서만) - Actor Tick 전에 수행
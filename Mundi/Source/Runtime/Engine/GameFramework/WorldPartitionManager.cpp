@@ -42,7 +42,7 @@ void UWorldPartitionManager::Clear()
 	//ClearSceneOctree();
 	ClearBVHierarchy();
 
-	ComponentDirtyQueue.Empty();
+	ComponentDirtyList.Empty();
 	ComponentDirtySet.Empty();
 }
 
@@ -124,39 +124,51 @@ void UWorldPartitionManager::MarkDirty(UPrimitiveComponent* Smc)
 	}
 
 	// second: 새로운 요소가 성공적으로 삽입되었으면 true, 이미 요소가 존재하여 삽입에 실패했으면 false
-	// DirtyQueue 중복 삽입 방지 로직
+	// DirtyList 중복 삽입 방지 로직
 	if (ComponentDirtySet.insert(Smc).second)
 	{
-		ComponentDirtyQueue.push(Smc);
+		ComponentDirtyList.Add(Smc);
 	}
 }
 
 void UWorldPartitionManager::Update(float DeltaTime, const uint32 BudgetCount)
 {
 	// 프레임 히칭 방지를 위해 컴포넌트 카운트 제한
-	uint32 processed = 0;
-	while (processed < BudgetCount)
+	const int32 NumToProcess = std::min(ComponentDirtyList.Num(), static_cast<int32>(BudgetCount));
+
+	DirtyBatch.clear();
+	for (int32 Index = 0; Index < NumToProcess; ++Index)
 	{
-		UPrimitiveComponent* Component = nullptr;
-		if (!ComponentDirtyQueue.Dequeue(Component))
+		// Unregister된 컴포넌트는 Set에서 빠져 있으므로 건너뜀
+		UPrimitiveComponent* Component = ComponentDirtyList[Index];
+		if (Component && ComponentDirtySet.Contains(Component))
 		{
-			break;
+			DirtyBatch.Add(Component);
 		}
+	}
 
-		if (ComponentDirtySet.erase(Component) == 0)
+	if (NumToProcess == ComponentDirtyList.Num())
+	{
+		// 전부 처리한 경우 항목별 삭제 없이 통째로 비움
+		ComponentDirtyList.clear();
+		ComponentDirtySet.Reset();
+	}
+	else
+	{
+		for (UPrimitiveComponent* Component : DirtyBatch)
 		{
-			// 이미 처리되었거나 제거됨
-			continue;
+			ComponentDirtySet.Remove(Component);
 		}
-
-		if (!Component) continue;
-		if (BVH) BVH->Update(Component);
-
-		++processed;
+		ComponentDirtyList.erase(ComponentDirtyList.begin(), ComponentDirtyList.begin() + NumToProcess);
 	}
 
 	if (BVH)
 	{
+		if (!DirtyBatch.IsEmpty())
+		{
+			BVH->UpdateBatch(DirtyBatch);
+		}
+		// 끝난 백그라운드 리빌드 교체 + 필요하면 새 리빌드 시작 (기다리지 않음)
 		BVH->FlushRebuild();
 	}
 }
@@ -5,21 +5,22 @@
 
 FParticleAsyncUpdater::~FParticleAsyncUpdater()
 {
-    if (TaskHandle.valid())
+    if (TaskHandle.IsValid())
     {
         // 1. 작업이 끝날 때까지 기다림
-        TaskHandle.wait();
+        TaskHandle.Wait();
+        TaskHandle.Reset();
 
-        // 2. ★ 중요 ★ 결과물을 꺼내야 함!
-        // 이걸 안 하면 future 안에 들어있던 포인터 뭉치가 그냥 증발(Leak)함
-        FAsyncSimulationResult PendingResult = TaskHandle.get();
-
-        // 3. 꺼낸 데이터(막 생성된 따끈따끈한 릭 유발자들)를 수동으로 삭제
-        for (FDynamicEmitterDataBase* Data : PendingResult.RenderData)
+        // 2. ★ 중요 ★ 결과물을 꺼내서 직접 지워야 함!
+        // 이걸 안 하면 PendingResult 안에 들어있던 포인터 뭉치가 그냥 증발(Leak)함
+        if (PendingResult)
         {
-            if (Data) delete Data;
+            for (FDynamicEmitterDataBase* Data : PendingResult->RenderData)
+            {
+                if (Data) delete Data;
+            }
+            PendingResult.reset();
         }
-        PendingResult.RenderData.Empty();
     }
 
     // 4. 기존에 멤버변수로 들고 있던 데이터 삭제
@@ -30,19 +31,17 @@ void FParticleAsyncUpdater::KickOff(const TArray<FParticleEmitterInstance*>& Ins
 {
     if (IsBusy()) { return; }
     
-    if (TaskHandle.valid())
+    if (TaskHandle.IsValid())
     {
-        FAsyncSimulationResult Result = TaskHandle.get();
-        
         // 데이터 교체 (Swap)
-        InternalClearRenderData();
-        RenderData = std::move(Result.RenderData);
-        LastFrameStats = Result.Stats;
+        ConsumePendingResult();
     }
     
-    TaskHandle = std::async(std::launch::async, [Instances, Context]() 
+    std::shared_ptr<FAsyncSimulationResult> Result = std::make_shared<FAsyncSimulationResult>();
+    PendingResult = Result;
+    TaskHandle = FTaskGraph::GetInstance().Launch([Result, Instances, Context]()
     {
-        return DoSimulationWork(Instances, Context);
+        *Result = DoSimulationWork(Instances, Context);
     });
 }
 
@@ -63,10 +62,7 @@ void FParticleAsyncUpdater::KickOffSync(const TArray<FParticleEmitterInstance*>&
 
 void FParticleAsyncUpdater::EnsureCompletion()
 {
-    if (TaskHandle.valid())
-    {
-        TaskHandle.wait();
-    }
+    TaskHandle.Wait();
 }
 
 void FParticleAsyncUpdater::ResetStats()
@@ -82,20 +78,13 @@ void FParticleAsyncUpdater::Sync()
 
 bool FParticleAsyncUpdater::TrySync()
 {
-    if (!TaskHandle.valid()) return false;
+    if (!TaskHandle.IsValid()) return false;
 
     // 즉시 상태 확인
-    auto Status = TaskHandle.wait_for(std::chrono::seconds(0));
-    if (Status == std::future_status::ready)
+    if (TaskHandle.IsCompleted())
     {
-        // 작업 완료
-        FAsyncSimulationResult Result = TaskHandle.get();
-
-        // 데이터 교체
-        InternalClearRenderData();
-        RenderData = std::move(Result.RenderData);
-        LastFrameStats = Result.Stats;
-            
+        // 작업 완료 - 데이터 교체
+        ConsumePendingResult();
         return true;
     }
 
@@ -104,7 +93,7 @@ bool FParticleAsyncUpdater::TrySync()
 
 bool FParticleAsyncUpdater::IsBusy() const
 {
-    return TaskHandle.valid() && TaskHandle.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    return TaskHandle.IsValid() && !TaskHandle.IsCompleted();
 }
 
 FAsyncSimulationResult FParticleAsyncUpdater::DoSimulationWork(const TArray<FParticleEmitterInstance*>& Instances, FParticleSimulationContext Context)
@@ -164,6 +153,20 @@ FAsyncSimulationResult FParticleAsyncUpdater::DoSimulationWork(const TArray<FPar
     return Result;
 }
 
+void FParticleAsyncUpdater::ConsumePendingResult()
+{
+    TaskHandle.Reset();
+    if (!PendingResult)
+    {
+        return;
+    }
+
+    InternalClearRenderData();
+    RenderData = std::move(PendingResult->RenderData);
+    LastFrameStats = PendingResult->Stats;
+    PendingResult.reset();
+}
+
 void FParticleAsyncUpdater::InternalClearRenderData()
 {
     for (FDynamicEmitterDataBase* Data : RenderData)
@@ -1,6 +1,5 @@
 ﻿#pragma once
-#include <future>
-
+#include "Source/Runtime/Core/Async/TaskGraph.h"
 #include "Source/Runtime/Engine/Particle/DynamicEmitterDataBase.h"
 
 struct FParticleFrameStats
@@ -23,7 +22,7 @@ class FParticleAsyncUpdater
 public:
     FParticleAsyncUpdater() = default;
 
-    // TaskHandle(std::future)은 복사할 수 없으므로, 그냥 빈 상태로 초기화
+    // 진행 중인 작업은 원본 소유이므로, 복사본은 그냥 빈 상태로 초기화
     FParticleAsyncUpdater(const FParticleAsyncUpdater& Other)
     {
         LastFrameStats = FParticleFrameStats();
@@ -33,7 +32,7 @@ public:
     {
         if (this != &Other)
         {
-            if (TaskHandle.valid()) TaskHandle.wait();
+            TaskHandle.Wait();
             InternalClearRenderData();
             LastFrameStats = FParticleFrameStats();
         }
@@ -65,6 +64,10 @@ public:
 private:
     static FAsyncSimulationResult DoSimulationWork(const TArray<FParticleEmitterInstance*>& Instances, FParticleSimulationContext Context);
     void InternalClearRenderData();
-    // 비동기 작업 핸들
-    std::future<FAsyncSimulationResult> TaskHandle;
+    // 완료된 작업의 결과를 RenderData/LastFrameStats로 교체
+    void ConsumePendingResult();
+    // 비동기 작업 핸들 (FTaskGraph 워커에서 실행)
+    FTaskHandle TaskHandle;
+    // 작업이 채우는 결과 (updater가 이동되어도 작업이 안전하게 쓸 수 있도록 공유 소유)
+    std::shared_ptr<FAsyncSimulationResult> PendingResult;
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "BodySetup.h"
 #include "ObjectIterator.h"
 #include "StaticMesh.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
 #include <Windows.h>
 
 /**
@@ -101,6 +102,23 @@ const char* FPhysXCustomErrorCallback::GetErrorTypeString(PxErrorCode::Enum code
     }
 }
 
+// ===== FPhysXTaskDispatcher =====
+void FPhysXTaskDispatcher::submitTask(PxBaseTask& task)
+{
+    // PxBaseTask는 PhysX가 수명을 관리하므로 포인터만 캡처
+    PxBaseTask* Task = &task;
+    FTaskGraph::GetInstance().Launch([Task]()
+    {
+        Task->run();
+        Task->release();
+    });
+}
+
+PxU32 FPhysXTaskDispatcher::getWorkerCount() const
+{
+    return static_cast<PxU32>(std::max(1, FTaskGraph::GetInstance().GetNumWorkers()));
+}
+
 // ===== FPhysXSharedResources Static Members =====
 PxDefaultAllocator FPhysXSharedResources::Allocator;
 FPhysXCustomErrorCallback FPhysXSharedResources::ErrorCallback;  // 커스텀 에러 콜백 사용
@@ -109,7 +127,7 @@ PxFoundation* FPhysXSharedResources::Foundation = nullptr;
 PxPvd* FPhysXSharedResources::Pvd = nullptr;
 PxPvdTransport* FPhysXSharedResources::PvdTransport = nullptr;
 PxPhysics* FPhysXSharedResources::Physics = nullptr;
-PxDefaultCpuDispatcher* FPhysXSharedResources::Dispatcher = nullptr;
+PxCpuDispatcher* FPhysXSharedResources::Dispatcher = nullptr;
 PxMaterial* FPhysXSharedResources::DefaultMaterial = nullptr;
 int32 FPhysXSharedResources::RefCount = 0;
 bool FPhysXSharedResources::bInitialized = false;
@@ -186,17 +204,10 @@ bool FPhysXSharedResources::Initialize()
     }
 
     // 5) CPU Dispatcher - 멀티쓰레드 물리 계산용
-    SYSTEM_INFO sysInfo{};
-    GetSystemInfo(&sysInfo);
-    int numCores = sysInfo.dwNumberOfProcessors;
-    int numWorkerThreads = std::max(1, numCores - 1);
-
-    Dispatcher = PxDefaultCpuDispatcherCreate(numWorkerThreads);
-    if (!Dispatcher)
-    {
-        UE_LOG("[PhysXSharedResources] PxDefaultCpuDispatcherCreate failed!");
-        return false;
-    }
+    // 별도 스레드 풀을 만들지 않고 엔진 FTaskGraph 워커를 공유
+    // (FTaskGraph가 시작되지 않은 환경에서는 호출 스레드에서 즉시 실행됨)
+    Dispatcher = new FPhysXTaskDispatcher();
+    int numWorkerThreads = static_cast<int>(Dispatcher->getWorkerCount());
 
     // Initialize PhysX Vehicle SDK
     if (!PxInitVehicleSDK(*Physics))
@@ -225,7 +236,7 @@ void FPhysXSharedResources::Shutdown()
 
     if (Dispatcher)
     {
-        Dispatcher->release();
+        delete Dispatcher;
         Dispatcher = nullptr;
     }
 
@@ -698,7 +709,7 @@ PxMaterial* FPhysScene::GetDefaultMaterial() const
     return FPhysXSharedResources::GetDefaultMaterial();
 }
 
-PxDefaultCpuDispatcher* FPhysScene::GetDispatcher() const
+PxCpuDispatcher* FPhysScene::GetDispatcher() const
 {
     return FPhysXSharedResources::GetDispatcher();
 }
@@ -73,6 +73,19 @@ private:
     const char* GetErrorTypeString(PxErrorCode::Enum code);
 };
 
+/**
+ * @brief PhysX 작업을 엔진 FTaskGraph 워커 풀에서 실행하는 Dispatcher
+ *
+ * PxDefaultCpuDispatcher는 자체 스레드 풀을 만들어 엔진 워커와 코어를 두고 경쟁하므로,
+ * simulate()가 올리는 PxBaseTask를 엔진 작업으로 감싸 같은 풀에서 처리합니다.
+ */
+class FPhysXTaskDispatcher : public PxCpuDispatcher
+{
+public:
+    virtual void submitTask(PxBaseTask& task) override;
+    virtual PxU32 getWorkerCount() const override;
+};
+
 class FSimulationEventCallback;
 
 /**
@@ -92,7 +105,7 @@ public:
     static PxFoundation* GetFoundation() { return Foundation; }
     static PxPhysics* GetPhysics() { return Physics; }
     static PxPvd* GetPvd() { return Pvd; }
-    static PxDefaultCpuDispatcher* GetDispatcher() { return Dispatcher; }
+    static PxCpuDispatcher* GetDispatcher() { return Dispatcher; }
     static PxMaterial* GetDefaultMaterial() { return DefaultMaterial; }
     static bool IsInitialized() { return bInitialized; }
 
@@ -109,7 +122,7 @@ private:
     static PxPvd* Pvd;
     static PxPvdTransport* PvdTransport;
     static PxPhysics* Physics;
-    static PxDefaultCpuDispatcher* Dispatcher;
+    static PxCpuDispatcher* Dispatcher;
     static PxMaterial* DefaultMaterial;
     static int32 RefCount;
     static bool bInitialized;
@@ -159,7 +172,7 @@ public:
     PxPhysics*              GetPhysics()         const;
     PxScene*                GetScene()           const;
     PxMaterial*             GetDefaultMaterial() const;
-    PxDefaultCpuDispatcher* GetDispatcher()      const;
+    PxCpuDispatcher* GetDispatcher()      const;
 
     // ===== Surface Setup for Vehicles =====
     /**
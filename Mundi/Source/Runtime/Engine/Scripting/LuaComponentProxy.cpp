@@ -1,7 +1,7 @@
 ﻿#include "pch.h"
 #include "LuaComponentProxy.h"
 
-TMap<UClass*, FBoundClassDesc> GBoundClasses;
+TFlatMap<UClass*, FBoundClassDesc> GBoundClasses;
 
 void BuildBoundClass(UClass* Class)
 {
@@ -13,10 +13,10 @@ struct FBoundProp
 struct FBoundClassDesc   // Property list per class
 {
     UClass* Class = nullptr;
-    TMap<FString, FBoundProp> PropsByName;
+    TFlatMap<FString, FBoundProp> PropsByName;
 };
 
-extern TMap<UClass*, FBoundClassDesc> GBoundClasses;
+extern TFlatMap<UClass*, FBoundClassDesc> GBoundClasses;
 
 void BuildBoundClass(UClass* Class);
 
@@ -5,6 +5,7 @@
 #include <functional>
 #include <queue>
 #include "BVHierarchy.h"
+#include "InlineArray.h"
 #include "Actor.h"
 #include "Collision.h"
 #include "Vector.h"
@@ -45,6 +46,93 @@ namespace {
         outTMax = tmax;
         return true;
     }
+
+    // 이보다 적으면 백그라운드로 넘기지 않고 바로 빌드 (한 프레임 늦게 반영되는 것보다 동기 빌드가 쌈)
+    constexpr int32 AsyncRebuildThreshold = 2048;
+    // refit 후 노드 표면적 합이 빌드 직후의 이 배수를 넘으면 리빌드
+    constexpr double RefitQualityLimit = 1.5;
+
+    constexpr int32 AABBGrainSize = 64;     // GetWorldAABB는 컴포넌트마다 행렬 연산이 있어 작게
+    constexpr int32 BuildGrainSize = 2048;
+    constexpr int32 LeafGrainSize = 256;
+
+    constexpr int32 RadixBits = 8;
+    constexpr int32 RadixBuckets = 1 << RadixBits;
+
+    inline double SurfaceArea(const FAABB& Box)
+    {
+        const double X = double(Box.Max.X) - Box.Min.X;
+        const double Y = double(Box.Max.Y) - Box.Min.Y;
+        const double Z = double(Box.Max.Z) - Box.Min.Z;
+        return 2.0 * (X * Y + Y * Z + Z * X);
+    }
+
+    /**
+     * (Morton << 32 | 아이템 인덱스) 키를 상위 32비트(30비트 Morton)로 정렬하는 LSD radix sort
+     * 패스마다 청크별 히스토그램(병렬) → 버킷-청크 순 접두합 → 청크별 분산(병렬). 청크 순서대로 쓰므로 안정 정렬
+     */
+    void ParallelRadixSortMorton(TArray<uint64>& Keys, TArray<uint64>& Scratch)
+    {
+        const int32 N = static_cast<int32>(Keys.size());
+        Scratch.resize(N);
+        const int32 NumChunks = (N + BuildGrainSize - 1) / BuildGrainSize;
+
+        TArray<uint32> Offsets;
+        Offsets.resize(size_t(NumChunks) * RadixBuckets);
+
+        uint64* Src = Keys.data();
+        uint64* Dst = Scratch.data();
+        for (int32 Shift = 32; Shift < 62; Shift += RadixBits)
+        {
+            std::fill(Offsets.begin(), Offsets.end(), 0u);
+            ParallelFor(NumChunks, [&](int32 Chunk)
+            {
+                uint32* Histogram = &Offsets[size_t(Chunk) * RadixBuckets];
+                const int32 End = std::min(N, (Chunk + 1) * BuildGrainSize);
+                for (int32 i = Chunk * BuildGrainSize; i < End; ++i)
+                {
+                    ++Histogram[(Src[i] >> Shift) & (RadixBuckets - 1)];
+                }
+            });
+
+            // 모든 키가 한 버킷이면 이 자릿수는 건너뜀 (월드가 한 축으로 좁으면 흔함)
+            uint32 Running = 0;
+            bool bSingleBucket = false;
+            for (int32 Bucket = 0; Bucket < RadixBuckets; ++Bucket)
+            {
+                uint32 BucketCount = 0;
+                for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+                {
+                    uint32& Slot = Offsets[size_t(Chunk) * RadixBuckets + Bucket];
+                    const uint32 Count = Slot;
+                    Slot = Running;
+                    Running += Count;
+                    BucketCount += Count;
+                }
+                bSingleBucket |= (BucketCount == uint32(N));
+            }
+            if (bSingleBucket)
+            {
+                continue;
+            }
+
+            ParallelFor(NumChunks, [&](int32 Chunk)
+            {
+                uint32* ChunkOffsets = &Offsets[size_t(Chunk) * RadixBuckets];
+                const int32 End = std::min(N, (Chunk + 1) * BuildGrainSize);
+                for (int32 i = Chunk * BuildGrainSize; i < End; ++i)
+                {
+                    Dst[ChunkOffsets[(Src[i] >> Shift) & (RadixBuckets - 1)]++] = Src[i];
+                }
+            });
+            std::swap(Src, Dst);
+        }
+
+        if (Src != Keys.data())
+        {
+            std::copy(Src, Src + N, Keys.data());
+        }
+    }
 }
 
 FBVHierarchy::FBVHierarchy(const FAABB& InBounds, int InDepth, int InMaxDepth, int InMaxObjects)
@@ -62,76 +150,217 @@ FBVHierarchy::~FBVHierarchy()
 
 void FBVHierarchy::Clear()
 {
+    // 백그라운드 빌드가 PendingTree에 쓰는 중일 수 있으므로 끝날 때까지 대기
+    if (PendingBuild.IsValid())
+    {
+        PendingBuild.Wait();
+        PendingBuild.Reset();
+    }
+
     // NOTE: TMap, TArray를 clear로 비우면 capacity가 그대로이기 때문에 새 객체로 초기화
-    StaticMeshComponentBounds = TMap<UPrimitiveComponent*, FAABB>();
-    StaticMeshComponentArray = TArray<UPrimitiveComponent*>();
-    Nodes = TArray<FLBVHNode>();
+    ComponentSlots = TFlatMap<UPrimitiveComponent*, int32>();
+    SlotComponents = TArray<UPrimitiveComponent*>();
+    SlotBounds = TArray<FAABB>();
+    FreeSlots = TArray<int32>();
+    SlotsOutsideTree = TArray<int32>();
+    SlotOutsideTreeIndex = TArray<int32>();
+    UpdateComponents = TArray<UPrimitiveComponent*>();
+    UpdateBounds = TArray<FAABB>();
+    ActiveTree.reset();
+    PendingTree.reset();
     Bounds = FAABB();
-    bPendingRebuild = false;
+    bMembershipChanged = false;
+    bQualityDegraded = false;
 }
 
 void FBVHierarchy::BulkUpdate(const TArray<UPrimitiveComponent*>& Components)
 {
-    for (const auto& SMC : Components)
+    UpdateComponents.clear();
+    for (UPrimitiveComponent* SMC : Components)
     {
         if (SMC)
         {
-            StaticMeshComponentBounds.Add(SMC, SMC->GetWorldAABB());
+            UpdateComponents.Add(SMC);
         }
     }
+    UpdateBounds.resize(UpdateComponents.Num());
+    ParallelFor(UpdateComponents.Num(), [this](int32 Index)
+    {
+        UpdateBounds[Index] = UpdateComponents[Index]->GetWorldAABB();
+    }, AABBGrainSize);
+    ApplyBounds(UpdateComponents, UpdateBounds);
 
     // Level 복사 등으로 다량의 컴포넌트를 한 번에 넣는 상황 전제
     // 일반적인 update에서 budget 단위로 끊어 갱신되는 로직 우회해 강제 rebuild
-    BuildLBVH();
-    bPendingRebuild = false;
+    bMembershipChanged = true;
+    FlushRebuild(true);
 }
 
-void FBVHierarchy::Update(UPrimitiveComponent* InComponent)
+void FBVHierarchy::UpdateBatch(const TArray<UPrimitiveComponent*>& Components)
+{
+    // 제거 대상은 먼저 걸러내고 (Remove는 슬롯/트리를 건드리므로 게임 스레드에서 순차 처리)
+    UpdateComponents.clear();
+    for (UPrimitiveComponent* Component : Components)
+    {
+        if (!Component)
+        {
+            continue;
+        }
+
+        if (Component->IsPendingDestroy() || !Component->GetOwner() || !Component->GetOwner()->IsActorActive())
+        {
+            Remove(Component);
+            continue;
+        }
+        UpdateComponents.Add(Component);
+    }
+
+    // 월드 AABB 계산은 컴포넌트끼리 독립적이라 병렬 (const 조회만 함)
+    UpdateBounds.resize(UpdateComponents.Num());
+    ParallelFor(UpdateComponents.Num(), [this](int32 Index)
+    {
+        UpdateBounds[Index] = UpdateComponents[Index]->GetWorldAABB();
+    }, AABBGrainSize);
+
+    ApplyBounds(UpdateComponents, UpdateBounds);
+}
+
+void FBVHierarchy::ApplyBounds(const TArray<UPrimitiveComponent*>& Components, const TArray<FAABB>& WorldBounds)
+{
+    bool bRefit = false;
+    for (int32 Index = 0; Index < Components.Num(); ++Index)
+    {
+        UPrimitiveComponent* Component = Components[Index];
+        const FAABB& WorldBound = WorldBounds[Index];
+
+        const int32* FoundSlot = ComponentSlots.Find(Component);
+        if (!FoundSlot)
+        {
+            // 신규: 빈 슬롯 재사용. 트리에는 다음 리빌드에서 들어가고 그때까지는 쿼리가 직접 검사
+            int32 Slot;
+            if (!FreeSlots.IsEmpty())
+            {
+                Slot = FreeSlots.back();
+                FreeSlots.pop_back();
+                SlotComponents[Slot] = Component;
+                SlotBounds[Slot] = WorldBound;
+            }
+            else
+            {
+                Slot = SlotComponents.Add(Component);
+                SlotBounds.Add(WorldBound);
+                SlotOutsideTreeIndex.Add(-1);
+            }
+            ComponentSlots.Add(Component, Slot);
+            AddSlotOutsideTree(Slot);
+            bMembershipChanged = true;
+            continue;
+        }
+
+        const int32 Slot = *FoundSlot;
+        SlotBounds[Slot] = WorldBound;
+
+        // 이미 트리에 있으면 아이템 바운드만 바꾸고 refit
+        if (ActiveTree && Slot < ActiveTree->SlotToItem.Num())
+        {
+            const int32 Item = ActiveTree->SlotToItem[Slot];
+            if (Item >= 0 && ActiveTree->Items[Item] == Component)
+            {
+                ActiveTree->ItemBounds[Item] = WorldBound;
+                bRefit = true;
+            }
+        }
+    }
+
+    if (bRefit)
+    {
+        const double Area = RefitTree(*ActiveTree);
+        Bounds = ActiveTree->Nodes[0].Bounds;
+        if (Area > ActiveTree->BuiltArea * RefitQualityLimit)
+        {
+            bQualityDegraded = true;
+        }
+    }
+}
+
+void FBVHierarchy::Remove(UPrimitiveComponent* InComponent)
 {
     if (!InComponent)
     {
         return;
     }
 
-    if (InComponent->IsPendingDestroy() || !InComponent->GetOwner() || !InComponent->GetOwner()->IsActorActive())
+    const int32* FoundSlot = ComponentSlots.Find(InComponent);
+    if (!FoundSlot)
     {
-        Remove(InComponent);
         return;
     }
 
-    const FAABB WorldBounds = InComponent->GetWorldAABB();
+    const int32 Slot = *FoundSlot;
+    ComponentSlots.Remove(InComponent);
+    SlotComponents[Slot] = nullptr;
+    FreeSlots.Add(Slot);
+    RemoveSlotOutsideTree(Slot);
 
-    StaticMeshComponentBounds.Add(InComponent, WorldBounds);
-    bPendingRebuild = true;
+    // 쿼리가 곧바로 제거된 컴포넌트를 돌려주지 않도록 현재 트리에서도 비움 (노드 바운드는 리빌드 때 정리)
+    if (ActiveTree && Slot < ActiveTree->SlotToItem.Num())
+    {
+        const int32 Item = ActiveTree->SlotToItem[Slot];
+        if (Item >= 0 && ActiveTree->Items[Item] == InComponent)
+        {
+            ActiveTree->Items[Item] = nullptr;
+        }
+    }
+    bMembershipChanged = true;
 }
 
-void FBVHierarchy::Remove(UPrimitiveComponent* InComponent)
+void FBVHierarchy::AddSlotOutsideTree(int32 Slot)
 {
-    if (!InComponent)
+    if (SlotOutsideTreeIndex[Slot] < 0)
     {
-        return;
+        SlotOutsideTreeIndex[Slot] = SlotsOutsideTree.Add(Slot);
     }
+}
 
-    if (StaticMeshComponentBounds.Find(InComponent))
+void FBVHierarchy::RemoveSlotOutsideTree(int32 Slot)
+{
+    const int32 Index = SlotOutsideTreeIndex[Slot];
+    if (Index < 0)
     {
-        StaticMeshComponentBounds.Remove(InComponent);
-        bPendingRebuild = true;
+        return;
     }
+    // 마지막 항목을 빈자리로 옮겨 O(1) 제거
+    const int32 LastSlot = SlotsOutsideTree.back();
+    SlotsOutsideTree[Index] = LastSlot;
+    SlotOutsideTreeIndex[LastSlot] = Index;
+    SlotsOutsideTree.pop_back();
+    SlotOutsideTreeIndex[Slot] = -1;
 }
 
 void FBVHierarchy::QueryFrustum(const FFrustum& InFrustum)
 {
-    if (Nodes.empty()) return;
+    // 아직 트리에 없는 컴포넌트
+    for (int32 Slot : SlotsOutsideTree)
+    {
+        if (IsAABBVisible(InFrustum, SlotBounds[Slot]))
+        {
+            if (AActor* Owner = SlotComponents[Slot]->GetOwner())
+            {
+                Owner->SetCulled(false);
+            }
+        }
+    }
+
+    if (!ActiveTree || ActiveTree->Nodes.empty()) return;
+    const FLBVHTree& Tree = *ActiveTree;
     //프러스텀 외부에 바운드 존재
-    if (!IsAABBVisible(InFrustum, Nodes[0].Bounds)) return;
+    if (!IsAABBVisible(InFrustum, Tree.Nodes[0].Bounds)) return;
     //프러스텀 내부에 바운드 존재 (교차 X)
-    if (!IsAABBIntersects(InFrustum, Nodes[0].Bounds))
+    if (!IsAABBIntersects(InFrustum, Tree.Nodes[0].Bounds))
     {
-        for (UPrimitiveComponent* Component : StaticMeshComponentArray)
+        for (UPrimitiveComponent* Component : Tree.Items)
         {
             if (!Component) continue;
-            if (StaticMeshComponentBounds.find(Component) == StaticMeshComponentBounds.end())
-                continue;
             if (AActor* Owner = Component->GetOwner())
             {
                 Owner->SetCulled(false);
@@ -140,24 +369,23 @@ void FBVHierarchy::QueryFrustum(const FFrustum& InFrustum)
         return;
     }
     //프러스텀과 바운드가 교차
-    TArray<int32> IdxStack;
-    IdxStack.push_back({ 0 });
+    // 균형 잡힌 LBVH라 스택 깊이는 트리 깊이 수준 → 인라인 버퍼로 충분
+    TInlineArray<int32, 64> IdxStack;
+    IdxStack.push_back(0);
 
     while (!IdxStack.empty())
     {
         int32 Idx = IdxStack.back();
         IdxStack.pop_back();
-        const FLBVHNode& node = Nodes[Idx];
+        const FLBVHNode& node = Tree.Nodes[Idx];
         if (node.IsLeaf())
         {
             for (int32 i = 0; i < node.Count; ++i)
             {
-                UPrimitiveComponent* Component = StaticMeshComponentArray[node.First + i];
-                if (!Component || StaticMeshComponentBounds.find(Component) == StaticMeshComponentBounds.end())
+                UPrimitiveComponent* Component = Tree.Items[node.First + i];
+                if (!Component)
                     continue;
-                const FAABB* Cached = StaticMeshComponentBounds.Find(Component);
-                const FAABB Box = Cached ? *Cached : Component->GetWorldAABB();
-                if (IsAABBVisible(InFrustum, Box))
+                if (IsAABBVisible(InFrustum, Tree.ItemBounds[node.First + i]))
                 {
                     if (AActor* Owner = Component->GetOwner())
                     {
@@ -167,17 +395,27 @@ void FBVHierarchy::QueryFrustum(const FFrustum& InFrustum)
             }
             continue;
         }
-        if (node.Left >= 0 && IsAABBVisible(InFrustum, Nodes[node.Left].Bounds))
-            IdxStack.push_back({ node.Left });
-        if (node.Right >= 0 && IsAABBVisible(InFrustum, Nodes[node.Right].Bounds))
-            IdxStack.push_back({ node.Right });
+        if (node.Left >= 0 && IsAABBVisible(InFrustum, Tree.Nodes[node.Left].Bounds))
+            IdxStack.push_back(node.Left);
+        if (node.Right >= 0 && IsAABBVisible(InFrustum, Tree.Nodes[node.Right].Bounds))
+            IdxStack.push_back(node.Right);
     }
 }
 
 void FBVHierarchy::DebugDraw(URenderer* Renderer) const
 {
     if (!Renderer) return;
-    if (Nodes.empty()) return;
+    if (!ActiveTree || ActiveTree->Nodes.empty()) return;
+    const TArray<FLBVHNode>& Nodes = ActiveTree->Nodes;
+
+    // 노드마다 배열을 만들지 않고 한 번에 모아서 AddLines 한 번 호출
+    constexpr int32 LinesPerNode = 12;
+    TArray<FVector> Start;
+    TArray<FVector> End;
+    TArray<FVector4> Color;
+    Start.Reserve(Nodes.Num() * LinesPerNode);
+    End.Reserve(Nodes.Num() * LinesPerNode);
+    Color.Reserve(Nodes.Num() * LinesPerNode);
 
     for (size_t i = 0; i < Nodes.size(); ++i)
     {
@@ -186,10 +424,6 @@ void FBVHierarchy::DebugDraw(URenderer* Renderer) const
         const FVector Max = N.Bounds.Max;
         const FVector4 LineColor(1.0f, N.IsLeaf() ? 0.2f : 0.8f, 0.0f, 1.0f);
 
-        TArray<FVector> Start;
-        TArray<FVector> End;
-        TArray<FVector4> Color;
-
         const FVector v0(Min.X, Min.Y, Min.Z);
         const FVector v1(Max.X, Min.Y, Min.Z);
         const FVector v2(Max.X, Max.Y, Min.Z);
@@ -213,31 +447,34 @@ void FBVHierarchy::DebugDraw(URenderer* Renderer) const
         Start.Add(v1); End.Add(v5); Color.Add(LineColor);
         Start.Add(v2); End.Add(v6); Color.Add(LineColor);
         Start.Add(v3); End.Add(v7); Color.Add(LineColor);
-
-        Renderer->AddLines(Start, End, Color);
     }
+
+    Renderer->AddLines(Start, End, Color);
 }
 
 int FBVHierarchy::TotalNodeCount() const
 {
-    return static_cast<int>(Nodes.size());
+    return ActiveTree ? static_cast<int>(ActiveTree->Nodes.size()) : 0;
 }
 
 int FBVHierarchy::TotalActorCount() const
 {
-    return static_cast<int>(StaticMeshComponentArray.size());
+    return ComponentSlots.Num();
 }
 
 int FBVHierarchy::MaxOccupiedDepth() const
 {
-    return (Nodes.empty()) ? 0 : (int)std::ceil(std::log2((double)Nodes.size() + 1));
+    const int NumNodes = TotalNodeCount();
+    return (NumNodes == 0) ? 0 : (int)std::ceil(std::log2((double)NumNodes + 1));
 }
 
 void FBVHierarchy::DebugDump() const
 {
     UE_LOG("===== BVHierachy (LBVH) DUMP BEGIN =====\r\n");
     char buf[256];
-    std::snprintf(buf, sizeof(buf), "nodes=%zu, components=%zu\r\n", Nodes.size(), StaticMeshComponentArray.size());
+    static const TArray<FLBVHNode> EmptyNodes;
+    const TArray<FLBVHNode>& Nodes = ActiveTree ? ActiveTree->Nodes : EmptyNodes;
+    std::snprintf(buf, sizeof(buf), "nodes=%zu, components=%d\r\n", Nodes.size(), ComponentSlots.Num());
     UE_LOG(buf);
     for (size_t i = 0; i < Nodes.size(); ++i)
     {
@@ -269,136 +506,141 @@ namespace
     }
 }
 
-void FBVHierarchy::BuildLBVH()
+void FBVHierarchy::BuildTree(FBuildSnapshot& Snapshot, int32 InMaxObjects, FLBVHTree& OutTree)
 {
-    StaticMeshComponentArray = StaticMeshComponentBounds.GetKeys();
-    const int N = StaticMeshComponentArray.Num();
-    Nodes = TArray<FLBVHNode>();
-
+    const int32 N = Snapshot.Items.Num();
+    OutTree.SlotToItem.assign(Snapshot.NumSlots, -1);
     if (N == 0)
     {
-        Bounds = FAABB();
         return;
     }
 
-    bool bHasBounds = false;
-    for (const auto& Pair : StaticMeshComponentBounds)
+    // 1) 중심점 바운드 (청크별 부분 결과를 합침). AABB 전체 대신 중심점 범위로 양자화해야 Morton 해상도를 낭비하지 않음
+    const int32 NumChunks = (N + BuildGrainSize - 1) / BuildGrainSize;
+    TArray<FVector> ChunkMin;
+    TArray<FVector> ChunkMax;
+    ChunkMin.resize(NumChunks);
+    ChunkMax.resize(NumChunks);
+    ParallelFor(NumChunks, [&](int32 Chunk)
     {
-        const FAABB& Bound = Pair.second;
-        if (!bHasBounds)
-        {
-            Bounds = Bound;
-            bHasBounds = true;
-        }
-        else
+        FVector Min(FLT_MAX, FLT_MAX, FLT_MAX);
+        FVector Max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        const int32 End = std::min(N, (Chunk + 1) * BuildGrainSize);
+        for (int32 i = Chunk * BuildGrainSize; i < End; ++i)
         {
-            Bounds = FAABB::Union(Bounds, Bound);
+            const FVector Center = Snapshot.ItemBounds[i].GetCenter();
+            Min = FVector(std::min(Min.X, Center.X), std::min(Min.Y, Center.Y), std::min(Min.Z, Center.Z));
+            Max = FVector(std::max(Max.X, Center.X), std::max(Max.Y, Center.Y), std::max(Max.Z, Center.Z));
         }
-    }
+        ChunkMin[Chunk] = Min;
+        ChunkMax[Chunk] = Max;
+    });
 
-    if (!bHasBounds)
+    FVector CenterMin = ChunkMin[0];
+    FVector CenterMax = ChunkMax[0];
+    for (int32 Chunk = 1; Chunk < NumChunks; ++Chunk)
     {
-        Bounds = FAABB();
-        return;
+        CenterMin = FVector(std::min(CenterMin.X, ChunkMin[Chunk].X), std::min(CenterMin.Y, ChunkMin[Chunk].Y), std::min(CenterMin.Z, ChunkMin[Chunk].Z));
+        CenterMax = FVector(std::max(CenterMax.X, ChunkMax[Chunk].X), std::max(CenterMax.Y, ChunkMax[Chunk].Y), std::max(CenterMax.Z, ChunkMax[Chunk].Z));
     }
 
-    TArray<uint32> Codes;
-    Codes.resize(N);
-    const FVector Min = Bounds.Min;
-    const FVector Extent = Bounds.GetHalfExtent();
-
-    for (int i = 0; i < N; ++i)
-    {
-        UPrimitiveComponent* Component = StaticMeshComponentArray[i];
-        const FAABB* Bound = StaticMeshComponentBounds.Find(Component);
-        const FVector Center = Bound ? Bound->GetCenter() : Component->GetWorldAABB().GetCenter();
-
-        const auto Normalize = [](float Value, float MinValue, float ExtHalf)
+    // 2) Morton 코드 (상위 32비트) + 원래 인덱스 (하위 32비트)
+    const FVector Extent = CenterMax - CenterMin;
+    const auto Quantize = [](float Value, float MinValue, float Ext)
+        {
+            if (Ext > 0.0f)
             {
-                if (ExtHalf > 0.0f)
-                {
-                    return std::clamp((Value - MinValue) / (ExtHalf * 2.0f), 0.0f, 1.0f);
-                }
-                return 0.5f;
-            };
-
-        const float Nx = Normalize(Center.X, Min.X, Extent.X);
-        const float Ny = Normalize(Center.Y, Min.Y, Extent.Y);
-        const float Nz = Normalize(Center.Z, Min.Z, Extent.Z);
-
-        const uint32 Ix = static_cast<uint32>(Nx * 1023.0f);
-        const uint32 Iy = static_cast<uint32>(Ny * 1023.0f);
-        const uint32 Iz = static_cast<uint32>(Nz * 1023.0f);
-
-        Codes[i] = Morton3D(Ix, Iy, Iz);
-    }
+                return static_cast<uint32>(std::clamp((Value - MinValue) / Ext, 0.0f, 1.0f) * 1023.0f);
+            }
+            return 512u;
+        };
 
-    TArray<std::pair<UPrimitiveComponent*, uint32>> ComponentCodePairs;
-    ComponentCodePairs.resize(N);
-    for (int i = 0; i < N; ++i)
+    TArray<uint64> Keys;
+    Keys.resize(N);
+    ParallelFor(N, [&](int32 i)
     {
-        ComponentCodePairs[i] = { StaticMeshComponentArray[i], Codes[i] };
-    }
+        const FVector Center = Snapshot.ItemBounds[i].GetCenter();
+        const uint32 Code = Morton3D(Quantize(Center.X, CenterMin.X, Extent.X),
+            Quantize(Center.Y, CenterMin.Y, Extent.Y),
+            Quantize(Center.Z, CenterMin.Z, Extent.Z));
+        Keys[i] = (static_cast<uint64>(Code) << 32) | static_cast<uint32>(i);
+    }, BuildGrainSize);
+
+    // 3) 정렬 후 리프 순서로 재배치
+    TArray<uint64> Scratch;
+    ParallelRadixSortMorton(Keys, Scratch);
+
+    OutTree.Items.resize(N);
+    OutTree.ItemBounds.resize(N);
+    OutTree.ItemSlots.resize(N);
+    ParallelFor(N, [&](int32 i)
+    {
+        const int32 Source = static_cast<int32>(Keys[i] & 0xFFFFFFFFull);
+        OutTree.Items[i] = Snapshot.Items[Source];
+        OutTree.ItemBounds[i] = Snapshot.ItemBounds[Source];
+        OutTree.ItemSlots[i] = Snapshot.ItemSlots[Source];
+        OutTree.SlotToItem[Snapshot.ItemSlots[Source]] = i;
+    }, BuildGrainSize);
+
+    // 4) 구간 절반 분할이라 모양은 N만으로 정해짐 → 토폴로지만 순차로 만들고 바운드는 refit으로 병렬 계산
+    OutTree.Nodes.reserve(std::max(1, 2 * N));
+    OutTree.Leaves.reserve(N / std::max(1, InMaxObjects) + 1);
+    BuildTopology(OutTree, 0, N, std::max(1, InMaxObjects), OutTree.Leaves);
+    OutTree.BuiltArea = RefitTree(OutTree);
+}
 
-    std::sort(ComponentCodePairs.begin(), ComponentCodePairs.end(),
-        [](const auto& LHS, const auto& RHS)
-        {
-            return LHS.second < RHS.second;
-        });
+int32 FBVHierarchy::BuildTopology(FLBVHTree& Tree, int32 Start, int32 End, int32 InMaxObjects, TArray<int32>& OutLeaves)
+{
+    const int32 NodeIdx = Tree.Nodes.Add(FLBVHNode{});
 
-    for (int i = 0; i < N; ++i)
+    const int32 Count = End - Start;
+    if (Count <= InMaxObjects)
     {
-        StaticMeshComponentArray[i] = ComponentCodePairs[i].first;
+        Tree.Nodes[NodeIdx].First = Start;
+        Tree.Nodes[NodeIdx].Count = Count;
+        OutLeaves.Add(NodeIdx);
+        return NodeIdx;
     }
 
-    Nodes.reserve(std::max(1, 2 * N));
-    Nodes.clear();
-    BuildRange(0, N);
+    const int32 Mid = (Start + End) / 2;
+    const int32 L = BuildTopology(Tree, Start, Mid, InMaxObjects, OutLeaves);
+    const int32 R = BuildTopology(Tree, Mid, End, InMaxObjects, OutLeaves);
+    Tree.Nodes[NodeIdx].Left = L;
+    Tree.Nodes[NodeIdx].Right = R;
+    return NodeIdx;
 }
 
-int FBVHierarchy::BuildRange(int s, int e)
+double FBVHierarchy::RefitTree(FLBVHTree& Tree)
 {
-    int nodeIdx = static_cast<int>(Nodes.size());
-    Nodes.push_back(FLBVHNode{});
-    FLBVHNode& node = Nodes[nodeIdx];
-
-    int count = e - s;
-    if (count <= MaxObjects)
-    {
-        node.First = s;
-        node.Count = count;
-        bool bInitialized = false;
-        FAABB Accumulated;
-        for (int i = s; i < e; ++i)
+    if (Tree.Nodes.empty())
+    {
+        return 0.0;
+    }
+
+    // 리프는 서로 독립적이라 병렬
+    ParallelFor(Tree.Leaves.Num(), [&Tree](int32 LeafIndex)
+    {
+        FLBVHNode& Leaf = Tree.Nodes[Tree.Leaves[LeafIndex]];
+        FAABB Accumulated = Tree.ItemBounds[Leaf.First];
+        for (int32 i = 1; i < Leaf.Count; ++i)
         {
-            UPrimitiveComponent* Component = StaticMeshComponentArray[i];
-            if (!Component)
-            {
-                continue;
-            }
+            Accumulated = FAABB::Union(Accumulated, Tree.ItemBounds[Leaf.First + i]);
+        }
+        Leaf.Bounds = Accumulated;
+    }, LeafGrainSize);
 
-            const FAABB* Bound = StaticMeshComponentBounds.Find(Component);
-            const FAABB LocalBound = Bound ? *Bound : Component->GetWorldAABB();
-            if (!bInitialized)
-            {
-                Accumulated = LocalBound;
-                bInitialized = true;
-            }
-            else
-            {
-                Accumulated = FAABB::Union(Accumulated, LocalBound);
-            }
+    // 전위 순서라 뒤에서부터 훑으면 자식이 항상 먼저 갱신됨
+    double TotalArea = 0.0;
+    for (int32 Idx = Tree.Nodes.Num() - 1; Idx >= 0; --Idx)
+    {
+        FLBVHNode& Node = Tree.Nodes[Idx];
+        if (!Node.IsLeaf())
+        {
+            Node.Bounds = FAABB::Union(Tree.Nodes[Node.Left].Bounds, Tree.Nodes[Node.Right].Bounds);
         }
-        node.Bounds = bInitialized ? Accumulated : Bounds;
-        return nodeIdx;
+        TotalArea += SurfaceArea(Node.Bounds);
     }
-
-    int mid = (s + e) / 2;
-    int L = BuildRange(s, mid);
-    int R = BuildRange(mid, e);
-    node.Left = L; node.Right = R; node.First = -1; node.Count = 0;
-    node.Bounds = FAABB::Union(Nodes[L].Bounds, Nodes[R].Bounds);
-    return nodeIdx;
+    return TotalArea;
 }
 
 void FBVHierarchy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float& OutBestT) const
@@ -410,7 +652,31 @@ void FBVHierarchy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float
         OutBestT = std::numeric_limits<float>::infinity();
     }
 
-    if (Nodes.empty()) return;
+    const float Epsilon = 1e-3f;
+
+    // 아직 트리에 없는 컴포넌트를 먼저 검사 (찾은 거리가 트리 순회의 상한이 됨)
+    for (int32 Slot : SlotsOutsideTree)
+    {
+        AActor* Owner = SlotComponents[Slot]->GetOwner();
+        if (!Owner || Owner->GetActorHiddenInEditor()) continue;
+
+        float tmin, tmax;
+        if (!RayAABB_IntersectT(Ray, SlotBounds[Slot], tmin, tmax))
+            continue;
+        if (OutActor && tmin > OutBestT + Epsilon)
+            continue;
+
+        float hitDistance;
+        if (CPickingSystem::CheckActorPicking(Owner, Ray, hitDistance) && hitDistance < OutBestT)
+        {
+            OutBestT = hitDistance;
+            OutActor = Owner;
+        }
+    }
+
+    if (!ActiveTree || ActiveTree->Nodes.empty()) return;
+    const FLBVHTree& Tree = *ActiveTree;
+    const TArray<FLBVHNode>& Nodes = Tree.Nodes;
 
     float tminRoot, tmaxRoot;
     if (!RayAABB_IntersectT(Ray, Nodes[0].Bounds, tminRoot, tmaxRoot)) return;
@@ -425,7 +691,6 @@ void FBVHierarchy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float
     std::priority_queue<HeapItem> heap;
     heap.push({ 0, tminRoot });
 
-    const float Epsilon = 1e-3f;
     bool isPick = false;
     while (!heap.empty())
     {
@@ -440,14 +705,13 @@ void FBVHierarchy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float
         {
             for (int i = 0; i < node.Count; ++i)
             {
-                UPrimitiveComponent* Component = StaticMeshComponentArray[node.First + i];
+                UPrimitiveComponent* Component = Tree.Items[node.First + i];
                 if (!Component) continue;
                 AActor* Owner = Component->GetOwner();
                 if (!Owner) continue;
                 if (Owner->GetActorHiddenInEditor()) continue;
 
-                const FAABB* Cached = StaticMeshComponentBounds.Find(Component);
-                const FAABB Box = Cached ? *Cached : Component->GetWorldAABB();
+                const FAABB& Box = Tree.ItemBounds[node.First + i];
 
                 float tmin, tmax;
                 if (!RayAABB_IntersectT(Ray, Box, tmin, tmax))
@@ -494,85 +758,227 @@ void FBVHierarchy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float
     }
 }
 
-void FBVHierarchy::FlushRebuild()
+void FBVHierarchy::FlushRebuild(bool bWait)
 {
-    if (bPendingRebuild)
+    if (PendingBuild.IsValid())
     {
-        BuildLBVH();
-        bPendingRebuild = false;
+        if (bWait)
+        {
+            PendingBuild.Wait();
+        }
+        if (PendingBuild.IsCompleted())
+        {
+            FinishRebuild();
+        }
+    }
+
+    if (!PendingBuild.IsValid() && (bMembershipChanged || bQualityDegraded))
+    {
+        // 트리가 아직 없으면 쿼리할 대상이 없으므로 동기 빌드
+        const bool bAsync = !bWait && ActiveTree && ComponentSlots.Num() >= AsyncRebuildThreshold;
+        StartRebuild(bAsync);
+    }
+}
+
+void FBVHierarchy::StartRebuild(bool bAsync)
+{
+    // 빌드 입력은 스냅샷으로 복사 → 빌드 도중 게임 스레드가 슬롯을 바꿔도 안전
+    std::shared_ptr<FBuildSnapshot> Snapshot = std::make_shared<FBuildSnapshot>();
+    Snapshot->Items.Reserve(ComponentSlots.Num());
+    Snapshot->ItemBounds.Reserve(ComponentSlots.Num());
+    Snapshot->ItemSlots.Reserve(ComponentSlots.Num());
+    Snapshot->NumSlots = SlotComponents.Num();
+    for (int32 Slot = 0; Slot < SlotComponents.Num(); ++Slot)
+    {
+        if (SlotComponents[Slot])
+        {
+            Snapshot->Items.Add(SlotComponents[Slot]);
+            Snapshot->ItemBounds.Add(SlotBounds[Slot]);
+            Snapshot->ItemSlots.Add(Slot);
+        }
+    }
+
+    bMembershipChanged = false;
+    bQualityDegraded = false;
+
+    if (!bAsync)
+    {
+        std::unique_ptr<FLBVHTree> NewTree = std::make_unique<FLBVHTree>();
+        BuildTree(*Snapshot, MaxObjects, *NewTree);
+        ActiveTree = std::move(NewTree);
+        Bounds = ActiveTree->Nodes.empty() ? FAABB() : ActiveTree->Nodes[0].Bounds;
+
+        // 살아 있는 슬롯이 모두 트리에 들어감
+        for (int32 Slot : SlotsOutsideTree)
+        {
+            SlotOutsideTreeIndex[Slot] = -1;
+        }
+        SlotsOutsideTree.clear();
+        return;
+    }
+
+    PendingTree = std::make_unique<FLBVHTree>();
+    FLBVHTree* Target = PendingTree.get();
+    const int32 LeafSize = MaxObjects;
+    PendingBuild = FTaskGraph::GetInstance().Launch([Snapshot, Target, LeafSize]()
+    {
+        BuildTree(*Snapshot, LeafSize, *Target);
+    });
+}
+
+void FBVHierarchy::FinishRebuild()
+{
+    PendingBuild.Reset();
+    FLBVHTree& Tree = *PendingTree;
+
+    // 스냅샷 이후의 변경 반영: 제거됐거나 슬롯이 재사용된 아이템은 비우고, 바운드는 최신 값으로
+    ParallelFor(Tree.Items.Num(), [this, &Tree](int32 Item)
+    {
+        const int32 Slot = Tree.ItemSlots[Item];
+        if (Slot >= SlotComponents.Num() || SlotComponents[Slot] != Tree.Items[Item])
+        {
+            Tree.Items[Item] = nullptr;
+            return;
+        }
+        Tree.ItemBounds[Item] = SlotBounds[Slot];
+    }, BuildGrainSize);
+
+    const double Area = RefitTree(Tree);
+    if (Area > Tree.BuiltArea * RefitQualityLimit)
+    {
+        bQualityDegraded = true;
+    }
+
+    ActiveTree = std::move(PendingTree);
+    Bounds = ActiveTree->Nodes.empty() ? FAABB() : ActiveTree->Nodes[0].Bounds;
+
+    // 스냅샷에 있던 컴포넌트는 이제 트리에서 찾음. 스냅샷 이후 추가된 것(재사용 슬롯 포함)만 남김
+    for (int32 Index = SlotsOutsideTree.Num() - 1; Index >= 0; --Index)
+    {
+        const int32 Slot = SlotsOutsideTree[Index];
+        const int32 Item = Slot < Tree.SlotToItem.Num() ? Tree.SlotToItem[Slot] : -1;
+        if (Item >= 0 && Tree.Items[Item] == SlotComponents[Slot])
+        {
+            RemoveSlotOutsideTree(Slot);
+        }
     }
 }
 
 template<typename BoundType, typename NodeIntersectFunc, typename ComponentIntersectFunc>
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponentsGeneric(
+void FBVHierarchy::QueryIntersectedComponentsGeneric(
     const BoundType& InBound,
     NodeIntersectFunc NodeIntersects,
-    ComponentIntersectFunc ComponentIntersects) const
+    ComponentIntersectFunc ComponentIntersects,
+    TArray<UPrimitiveComponent*>& OutComponents) const
 {
-    TSet<UPrimitiveComponent*> IntersectedComponents;
-    if (Nodes.empty())
-        return TArray<UPrimitiveComponent*>();
-    TArray<int32> IdxStack;
-    IdxStack.push_back({ 0 });
+    // 아직 트리에 없는 컴포넌트 (추가 후 리빌드가 끝나기 전)
+    for (int32 Slot : SlotsOutsideTree)
+    {
+        if (ComponentIntersects(SlotBounds[Slot], InBound))
+        {
+            OutComponents.Add(SlotComponents[Slot]);
+        }
+    }
+
+    if (!ActiveTree || ActiveTree->Nodes.empty())
+        return;
+    const FLBVHTree& Tree = *ActiveTree;
+
+    // 각 컴포넌트는 리프 하나에만 속하므로 중복 제거용 Set 없이 바로 출력
+    TInlineArray<int32, 64> IdxStack;
+    IdxStack.push_back(0);
 
     while (!IdxStack.empty())
     {
         int32 Idx = IdxStack.back();
         IdxStack.pop_back();
-        const FLBVHNode& Node = Nodes[Idx];
+        const FLBVHNode& Node = Tree.Nodes[Idx];
         if (NodeIntersects(Node.Bounds, InBound))
         {
             if (Node.IsLeaf())
             {
                 for (int32 i = 0; i < Node.Count; ++i)
                 {
-                    UPrimitiveComponent* Component = StaticMeshComponentArray[Node.First + i];
-                    if (!Component || StaticMeshComponentBounds.find(Component) == StaticMeshComponentBounds.end())
+                    UPrimitiveComponent* Component = Tree.Items[Node.First + i];
+                    if (!Component)
                         continue;
-                    const FAABB* Cached = StaticMeshComponentBounds.Find(Component);
-                    const FAABB Box = Cached ? *Cached : Component->GetWorldAABB();
+                    const FAABB& Box = Tree.ItemBounds[Node.First + i];
                     if (ComponentIntersects(Box, InBound))
                     {
-                        IntersectedComponents.insert(Component);
+                        OutComponents.Add(Component);
                     }
                 }
             }
             else
             {
-                if (Node.Left >= 0) IdxStack.push_back({ Node.Left });
-                if (Node.Right >= 0) IdxStack.push_back({ Node.Right });
+                if (Node.Left >= 0) IdxStack.push_back(Node.Left);
+                if (Node.Right >= 0) IdxStack.push_back(Node.Right);
             }
         }
     }
-    return IntersectedComponents.Array();
 }
 
 // FAABB 오버로드
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FAABB& InBound) const
+void FBVHierarchy::QueryIntersectedComponents(const FAABB& InBound, TArray<UPrimitiveComponent*>& OutComponents) const
 {
-    return QueryIntersectedComponentsGeneric(
+    QueryIntersectedComponentsGeneric(
         InBound,
         [](const FAABB& nodeBound, const FAABB& inBound) { return nodeBound.Intersects(inBound); },
-        [](const FAABB& compBound, const FAABB& inBound) { return inBound.Intersects(compBound); }
+        [](const FAABB& compBound, const FAABB& inBound) { return inBound.Intersects(compBound); },
+        OutComponents
     );
 }
 
 // FOBB 오버로드
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FOBB& InBound) const
+void FBVHierarchy::QueryIntersectedComponents(const FOBB& InBound, TArray<UPrimitiveComponent*>& OutComponents) const
 {
-    return QueryIntersectedComponentsGeneric(
+    QueryIntersectedComponentsGeneric(
         InBound,
         [](const FAABB& nodeBound, const FOBB& inBound) { return Collision::Intersects(nodeBound, inBound); },
-        [](const FAABB& compBound, const FOBB& inBound) { return Collision::Intersects(compBound, inBound); }
+        [](const FAABB& compBound, const FOBB& inBound) { return Collision::Intersects(compBound, inBound); },
+        OutComponents
     );
 }
 
 // FBoundingSphere 오버로드
-TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FBoundingSphere& InBound) const
+void FBVHierarchy::QueryIntersectedComponents(const FBoundingSphere& InBound, TArray<UPrimitiveComponent*>& OutComponents) const
 {
-    return QueryIntersectedComponentsGeneric(
+    QueryIntersectedComponentsGeneric(
         InBound,
         [](const FAABB& nodeBound, const FBoundingSphere& inBound) { return Collision::Intersects(nodeBound, inBound); },
-        [](const FAABB& compBound, const FBoundingSphere& inBound) { return Collision::Intersects(compBound, inBound); }
+        [](const FAABB& compBound, const FBoundingSphere& inBound) { return Collision::Intersects(compBound, inBound); },
+        OutComponents
+    );
+}
+
+// FFrustum 오버로드
+void FBVHierarchy::QueryIntersectedComponents(const FFrustum& InBound, TArray<UPrimitiveComponent*>& OutComponents) const
+{
+    QueryIntersectedComponentsGeneric(
+        InBound,
+        [](const FAABB& nodeBound, const FFrustum& inBound) { return IsAABBVisible(inBound, nodeBound); },
+        [](const FAABB& compBound, const FFrustum& inBound) { return IsAABBVisible(inBound, compBound); },
+        OutComponents
     );
 }
+
+TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FAABB& InBound) const
+{
+    TArray<UPrimitiveComponent*> Result;
+    QueryIntersectedComponents(InBound, Result);
+    return Result;
+}
+
+TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FOBB& InBound) const
+{
+    TArray<UPrimitiveComponent*> Result;
+    QueryIntersectedComponents(InBound, Result);
+    return Result;
+}
+
+TArray<UPrimitiveComponent*> FBVHierarchy::QueryIntersectedComponents(const FBoundingSphere& InBound) const
+{
+    TArray<UPrimitiveComponent*> Result;
+    QueryIntersectedComponents(InBound, Result);
+    return Result;
+}
@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "Source/Runtime/Core/Async/TaskGraph.h"
 
 struct FFrustum;
 struct FRay; // forward declaration for ray type
@@ -9,6 +10,12 @@ struct FBoundingSphere;
 
 /**
  * @brief Broad phase BVH based on UPrimitiveComponent
+ *
+ * - 컴포넌트마다 고정 슬롯(SlotComponents/SlotBounds)을 두고 월드 AABB를 평탄한 배열로 보관
+ * - 바운드 갱신은 UpdateBatch로 모아서 반영: 월드 AABB 병렬 계산 → 현재 트리 refit
+ * - 추가/제거 또는 refit으로 트리 품질이 떨어지면 리빌드 (Morton 코드 병렬 radix sort + 병렬 리프 바운드)
+ * - 리빌드는 스냅샷으로 백그라운드 작업에서 수행하고 쿼리는 이전 트리(ActiveTree)를 계속 사용 (더블 버퍼)
+ * - 추가된 뒤 아직 트리에 없는 컴포넌트(SlotsOutsideTree)는 모든 쿼리가 바운드로 직접 검사 → 리빌드 중에도 바로 보임
  */
 class FBVHierarchy
 {
@@ -17,6 +24,7 @@ class FBVHierarchy
      * AActor 기반에서 UPrimitiveComponent 기반으로 변경을 거친 BVH입니다.
      * - AActor를 기준으로 만들어졌다가 재활용된 로직에 의한 혼동 및 버그 주의.
      * - 일반적인 USceneComponent에 대해서는 호환성 없음.
+     * - 빌드/쿼리/갱신은 게임 스레드에서만 호출. 백그라운드 빌드는 스냅샷만 읽음
      */
 public:
     // 생성자/소멸자
@@ -26,11 +34,18 @@ public:
     // 초기화
     void Clear();
 
+    /** 다량 추가 후 즉시 동기 리빌드 (레벨 로드 등) */
     void BulkUpdate(const TArray<UPrimitiveComponent*>& Components);
-    void Update(UPrimitiveComponent* InComponent);
+    /** 여러 컴포넌트의 추가/갱신을 한 번에 반영 (월드 AABB 병렬 계산 → refit). 리빌드는 FlushRebuild에서 */
+    void UpdateBatch(const TArray<UPrimitiveComponent*>& Components);
     void Remove(UPrimitiveComponent* InComponent);
 
-    void FlushRebuild();
+    /**
+     * 끝난 백그라운드 빌드를 교체하고, 리빌드가 필요하면 시작
+     * @param bWait true면 진행 중인 빌드까지 기다려 호출 직후 트리가 최신 상태
+     */
+    void FlushRebuild(bool bWait = false);
+    bool IsRebuildInFlight() const { return PendingBuild.IsValid(); }
 
     void QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float& OutBestT) const;
     void QueryFrustum(const FFrustum& InFrustum);
@@ -38,6 +53,13 @@ public:
     TArray<UPrimitiveComponent*> QueryIntersectedComponents(const FOBB& InBound) const;
     TArray<UPrimitiveComponent*> QueryIntersectedComponents(const FBoundingSphere& InBound) const;
 
+    // 결과를 OutComponents 뒤에 이어 붙임 (호출부에서 버퍼를 재사용해 프레임마다 할당하지 않도록)
+    void QueryIntersectedComponents(const FAABB& InBound, TArray<UPrimitiveComponent*>& OutComponents) const;
+    void QueryIntersectedComponents(const FOBB& InBound, TArray<UPrimitiveComponent*>& OutComponents) const;
+    void QueryIntersectedComponents(const FBoundingSphere& InBound, TArray<UPrimitiveComponent*>& OutComponents) const;
+    /** 절두체와 겹치는 컴포넌트 (QueryFrustum과 달리 컬링 플래그를 건드리지 않음 - 섀도우 뷰 캐스터 수집용) */
+    void QueryIntersectedComponents(const FFrustum& InBound, TArray<UPrimitiveComponent*>& OutComponents) const;
+
     void DebugDraw(URenderer* Renderer) const;
 
     // Debug/Stats
@@ -47,10 +69,10 @@ public:
     void DebugDump() const;
     const FAABB& GetBounds() const { return Bounds; }
 
-    // 프러스텀 기준으로 오클루더(내부노드 AABB) / 오클루디(리프의 액터들) 수집
-    // VP는 행벡터 기준(네 컨벤션): p' = p * VP
-
 private:
+    // Tests/BVHierarchyTests.cpp: 합성 바운드 반영(ApplyBounds), 트리 소속 확인, 변경 전 순회 재현
+    friend struct FBVHierarchyTestAccess;
+
     // === LBVH data ===
     struct FLBVHNode
     {
@@ -61,26 +83,71 @@ private:
         int32 Count = 0;
         bool IsLeaf() const { return Count > 0; }
     };
-    void BuildLBVH();
 
-private:
+    /** 쿼리가 읽는 트리 한 벌. 아이템은 리프 순서로 저장되어 쿼리 중 해시 조회가 없음 */
+    struct FLBVHTree
+    {
+        TArray<FLBVHNode> Nodes;            // 전위 순서 (부모 인덱스 < 자식 인덱스)
+        TArray<int32> Leaves;               // 리프 노드 인덱스 (refit 병렬화용)
+        TArray<UPrimitiveComponent*> Items; // 리프 순서. 제거된 컴포넌트는 nullptr
+        TArray<FAABB> ItemBounds;
+        TArray<int32> ItemSlots;
+        TArray<int32> SlotToItem;           // 슬롯 → 아이템 (-1: 이 트리에 없음)
+        double BuiltArea = 0.0;             // 빌드 직후 노드 표면적 합 (refit 후 품질 비교 기준)
+    };
+
+    /** 백그라운드 빌드 입력 (게임 스레드에서 복사한 스냅샷) */
+    struct FBuildSnapshot
+    {
+        TArray<UPrimitiveComponent*> Items;
+        TArray<FAABB> ItemBounds;
+        TArray<int32> ItemSlots;
+        int32 NumSlots = 0;
+    };
+
+    static void BuildTree(FBuildSnapshot& Snapshot, int32 InMaxObjects, FLBVHTree& OutTree);
+    static int32 BuildTopology(FLBVHTree& Tree, int32 Start, int32 End, int32 InMaxObjects, TArray<int32>& OutLeaves);
+    /** 아이템 바운드로 노드 바운드를 다시 계산하고 노드 표면적 합을 반환 */
+    static double RefitTree(FLBVHTree& Tree);
+
+    /** 슬롯 단위 반영 (컴포넌트는 역참조하지 않음) */
+    void ApplyBounds(const TArray<UPrimitiveComponent*>& Components, const TArray<FAABB>& WorldBounds);
+    void StartRebuild(bool bAsync);
+    void FinishRebuild();
+    void AddSlotOutsideTree(int32 Slot);
+    void RemoveSlotOutsideTree(int32 Slot);
+
     template<typename BoundType, typename NodeIntersectFunc, typename ComponentIntersectFunc>
-    TArray<UPrimitiveComponent*> QueryIntersectedComponentsGeneric(const BoundType& InBound
+    void QueryIntersectedComponentsGeneric(const BoundType& InBound
         , NodeIntersectFunc NodeIntersects
-        , ComponentIntersectFunc ComponentIntersects) const;
-
-    int BuildRange(int s, int e);
+        , ComponentIntersectFunc ComponentIntersects
+        , TArray<UPrimitiveComponent*>& OutComponents) const;
 
     int Depth;
     int MaxDepth;
     int MaxObjects;
     FAABB Bounds;
 
-    TMap<UPrimitiveComponent*, FAABB> StaticMeshComponentBounds;
-    TArray<UPrimitiveComponent*> StaticMeshComponentArray;
+    // 슬롯 (제거된 슬롯은 FreeSlots로 재사용)
+    TFlatMap<UPrimitiveComponent*, int32> ComponentSlots;
+    TArray<UPrimitiveComponent*> SlotComponents;
+    TArray<FAABB> SlotBounds;
+    TArray<int32> FreeSlots;
+
+    // 슬롯에는 있지만 ActiveTree에는 아직 없는 컴포넌트 (추가 후 리빌드 전, 백그라운드 빌드 스냅샷 이후 추가)
+    // 보통 수십 개 수준이라 쿼리마다 전수 검사. SlotOutsideTreeIndex는 슬롯 → 목록 위치 (-1: 트리에 있거나 빈 슬롯)
+    TArray<int32> SlotsOutsideTree;
+    TArray<int32> SlotOutsideTreeIndex;
+
+    // UpdateBatch 임시 버퍼 (프레임마다 할당하지 않도록 재사용)
+    TArray<UPrimitiveComponent*> UpdateComponents;
+    TArray<FAABB> UpdateBounds;
 
-    // LBVH nodes
-    TArray<FLBVHNode> Nodes;
+    // 쿼리용 트리 / 백그라운드 빌드 결과
+    std::unique_ptr<FLBVHTree> ActiveTree;
+    std::unique_ptr<FLBVHTree> PendingTree;
+    FTaskHandle PendingBuild;
 
-    bool bPendingRebuild = false;
+    bool bMembershipChanged = false; // 추가/제거 → 리빌드 필요
+    bool bQualityDegraded = false;   // refit 후 표면적이 빌드 직후보다 크게 늘어남 → 리빌드 필요
 };
@@ -1,333 +1,725 @@
 ﻿#include "pch.h"
 #include "MeshBVH.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <emmintrin.h>
+
+namespace
+{
+	// SAH 빈 개수 (축마다)
+	constexpr uint32 NumBins = 16;
+	// 삼각형 교차 비용을 1로 볼 때 노드 순회 비용
+	constexpr float TraversalCost = 1.0f;
+	// 이 개수 이하이고 SAH상 분할 이득이 없으면 리프
+	constexpr uint32 MaxLeafSize = 8;
+	// 이 깊이부터는 SAH 대신 중앙값 분할 → 트리 깊이가 SAHDepthLimit + log2(N)을 넘지 않음
+	constexpr uint32 SAHDepthLimit = 32;
+	constexpr uint32 MaxStackDepth = 64;
+	// 이보다 작은 서브트리는 태스크 하나가 통째로 빌드
+	constexpr uint32 ParallelSubtreeSize = 16384;
+	// 한 번에 병렬로 추적할 최소 패킷 수
+	constexpr uint32 ParallelPacketThreshold = 64;
+
+	struct FBin
+	{
+		FVector Min = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+		FVector Max = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		uint32 Count = 0;
+
+		void Add(const FVector& InMin, const FVector& InMax)
+		{
+			Min = Min.ComponentMin(InMin);
+			Max = Max.ComponentMax(InMax);
+		}
+	};
+
+	float HalfArea(const FVector& Min, const FVector& Max)
+	{
+		const FVector Extent = Max - Min;
+		return Extent.X * Extent.Y + Extent.Y * Extent.Z + Extent.Z * Extent.X;
+	}
+
+	// 0 방향 성분은 아주 큰 유한값으로 바꿔 슬랩 테스트에서 inf * 0 = NaN이 나오지 않게 함
+	float SafeInverse(float Value)
+	{
+		constexpr float MinComponent = 1e-20f;
+		if (std::abs(Value) < MinComponent)
+		{
+			Value = Value < 0.0f ? -MinComponent : MinComponent;
+		}
+		return 1.0f / Value;
+	}
+
+	bool IntersectNode(const FMeshBVHNode& Node, const FVector& Origin, const FVector& InvDir, float MaxDistance, float& OutEntry)
+	{
+		float Near = 0.0f;
+		float Far = MaxDistance;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			float T0 = (Node.BoundsMin[Axis] - Origin[Axis]) * InvDir[Axis];
+			float T1 = (Node.BoundsMax[Axis] - Origin[Axis]) * InvDir[Axis];
+			if (T0 > T1)
+			{
+				std::swap(T0, T1);
+			}
+			Near = std::max(Near, T0);
+			Far = std::min(Far, T1);
+		}
+		OutEntry = Near;
+		return Near <= Far;
+	}
+
+	// SoA 레이 4개
+	struct FRayPacket
+	{
+		__m128 OriginX, OriginY, OriginZ;
+		__m128 DirX, DirY, DirZ;
+		__m128 InvDirX, InvDirY, InvDirZ;
+	};
+
+	// 노드와 교차하는 레인 비트마스크, OutEntry = 레인별 진입 거리
+	int32 IntersectNodePacket(const FMeshBVHNode& Node, const FRayPacket& Packet, __m128 MaxDistance, __m128& OutEntry)
+	{
+		const __m128 X0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.BoundsMin[0]), Packet.OriginX), Packet.InvDirX);
+		const __m128 X1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.BoundsMax[0]), Packet.OriginX), Packet.InvDirX);
+		const __m128 Y0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.BoundsMin[1]), Packet.OriginY), Packet.InvDirY);
+		const __m128 Y1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.BoundsMax[1]), Packet.OriginY), Packet.InvDirY);
+		const __m128 Z0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.BoundsMin[2]), Packet.OriginZ), Packet.InvDirZ);
+		const __m128 Z1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(Node.BoundsMax[2]), Packet.OriginZ), Packet.InvDirZ);
+
+		const __m128 Near = _mm_max_ps(_mm_max_ps(_mm_min_ps(X0, X1), _mm_min_ps(Y0, Y1)), _mm_max_ps(_mm_min_ps(Z0, Z1), _mm_setzero_ps()));
+		const __m128 Far = _mm_min_ps(_mm_min_ps(_mm_max_ps(X0, X1), _mm_max_ps(Y0, Y1)), _mm_min_ps(_mm_max_ps(Z0, Z1), MaxDistance));
+
+		OutEntry = Near;
+		return _mm_movemask_ps(_mm_cmple_ps(Near, Far));
+	}
+
+	// 삼각형 하나와 레이 4개의 Möller–Trumbore (IntersectRayTriangleMT와 같은 허용 오차), 교차 레인 비트마스크 반환
+	int32 IntersectTrianglePacket(const FRayPacket& Packet, const FVector& A, const FVector& B, const FVector& C, __m128 MaxDistance, __m128& OutT)
+	{
+		const __m128 Epsilon = _mm_set1_ps(KINDA_SMALL_NUMBER);
+		const __m128 OnePlusEpsilon = _mm_set1_ps(1.0f + KINDA_SMALL_NUMBER);
+		const __m128 MinusEpsilon = _mm_set1_ps(-KINDA_SMALL_NUMBER);
+		const __m128 SignMask = _mm_set1_ps(-0.0f);
+
+		const __m128 Edge1X = _mm_set1_ps(B.X - A.X), Edge1Y = _mm_set1_ps(B.Y - A.Y), Edge1Z = _mm_set1_ps(B.Z - A.Z);
+		const __m128 Edge2X = _mm_set1_ps(C.X - A.X), Edge2Y = _mm_set1_ps(C.Y - A.Y), Edge2Z = _mm_set1_ps(C.Z - A.Z);
+
+		// P = Dir x Edge2
+		const __m128 PX = _mm_sub_ps(_mm_mul_ps(Packet.DirY, Edge2Z), _mm_mul_ps(Packet.DirZ, Edge2Y));
+		const __m128 PY = _mm_sub_ps(_mm_mul_ps(Packet.DirZ, Edge2X), _mm_mul_ps(Packet.DirX, Edge2Z));
+		const __m128 PZ = _mm_sub_ps(_mm_mul_ps(Packet.DirX, Edge2Y), _mm_mul_ps(Packet.DirY, Edge2X));
+
+		const __m128 Determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Edge1X, PX), _mm_mul_ps(Edge1Y, PY)), _mm_mul_ps(Edge1Z, PZ));
+		__m128 Mask = _mm_cmpge_ps(_mm_andnot_ps(SignMask, Determinant), Epsilon);
+		if (_mm_movemask_ps(Mask) == 0)
+		{
+			return 0;
+		}
+		const __m128 InvDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), Determinant);
+
+		const __m128 ToOriginX = _mm_sub_ps(Packet.OriginX, _mm_set1_ps(A.X));
+		const __m128 ToOriginY = _mm_sub_ps(Packet.OriginY, _mm_set1_ps(A.Y));
+		const __m128 ToOriginZ = _mm_sub_ps(Packet.OriginZ, _mm_set1_ps(A.Z));
+
+		const __m128 U = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ToOriginX, PX), _mm_mul_ps(ToOriginY, PY)), _mm_mul_ps(ToOriginZ, PZ)), InvDeterminant);
+		Mask = _mm_and_ps(Mask, _mm_and_ps(_mm_cmpge_ps(U, MinusEpsilon), _mm_cmple_ps(U, OnePlusEpsilon)));
+
+		// Q = ToOrigin x Edge1
+		const __m128 QX = _mm_sub_ps(_mm_mul_ps(ToOriginY, Edge1Z), _mm_mul_ps(ToOriginZ, Edge1Y));
+		const __m128 QY = _mm_sub_ps(_mm_mul_ps(ToOriginZ, Edge1X), _mm_mul_ps(ToOriginX, Edge1Z));
+		const __m128 QZ = _mm_sub_ps(_mm_mul_ps(ToOriginX, Edge1Y), _mm_mul_ps(ToOriginY, Edge1X));
+
+		const __m128 V = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(Packet.DirX, QX), _mm_mul_ps(Packet.DirY, QY)), _mm_mul_ps(Packet.DirZ, QZ)), InvDeterminant);
+		Mask = _mm_and_ps(Mask, _mm_and_ps(_mm_cmpge_ps(V, MinusEpsilon), _mm_cmple_ps(_mm_add_ps(U, V), OnePlusEpsilon)));
+
+		const __m128 T = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(Edge2X, QX), _mm_mul_ps(Edge2Y, QY)), _mm_mul_ps(Edge2Z, QZ)), InvDeterminant);
+		Mask = _mm_and_ps(Mask, _mm_and_ps(_mm_cmpgt_ps(T, Epsilon), _mm_cmplt_ps(T, MaxDistance)));
+
+		OutT = T;
+		return _mm_movemask_ps(Mask);
+	}
+}
+
+FAABB FMeshBVHNode::GetBounds() const
+{
+	return FAABB(FVector(BoundsMin[0], BoundsMin[1], BoundsMin[2]), FVector(BoundsMax[0], BoundsMax[1], BoundsMax[2]));
+}
+
+// 빌드용 삼각형 정보, TriIndices 대신 이 배열을 구간별로 분할해 바운드/빈 계산이 연속 메모리를 읽도록 함
+namespace
+{
+	struct FBuildPrimitive
+	{
+		FVector Min;
+		FVector Max;
+		FVector Centroid;
+		uint32 TriangleID;
+	};
+}
+
+struct FMeshBVH::FBuildContext
+{
+	TArray<FBuildPrimitive> Primitives;
+	std::atomic<uint32> MaxDepth{ 0 };
+
+	void UpdateMaxDepth(uint32 Depth)
+	{
+		uint32 Current = MaxDepth.load(std::memory_order_relaxed);
+		while (Depth > Current && !MaxDepth.compare_exchange_weak(Current, Depth, std::memory_order_relaxed))
+		{
+		}
+	}
+};
+
+// 나중에 병렬로 빌드할 서브트리 (NodeIndex는 최종 Nodes 배열 기준)
+struct FMeshBVH::FBuildTask
+{
+	uint32 NodeIndex;
+	uint32 Start;
+	uint32 Count;
+	uint32 Depth;
+};
 
 void FMeshBVH::Build(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
 {
 	TriIndices.Empty();
 	Nodes.Empty();
-	uint32 TriCount = Indices.Num() / 3;
+	MaxDepth = 0;
+	const uint32 TriCount = Indices.Num() / 3;
 	if (TriCount == 0) return;
 
-	TriIndices.Reserve(TriCount);
-	for (uint32 t = 0; t < TriCount; ++t)
-		TriIndices.Add(t);
+	FBuildContext Context;
+	Context.Primitives.resize(TriCount);
+	ParallelFor(static_cast<int32>(TriCount), [&](int32 TriangleID)
+	{
+		const FVector& A = Vertices[Indices[3 * TriangleID + 0]].pos;
+		const FVector& B = Vertices[Indices[3 * TriangleID + 1]].pos;
+		const FVector& C = Vertices[Indices[3 * TriangleID + 2]].pos;
+		FBuildPrimitive& Primitive = Context.Primitives[TriangleID];
+		Primitive.Min = A.ComponentMin(B).ComponentMin(C);
+		Primitive.Max = A.ComponentMax(B).ComponentMax(C);
+		Primitive.Centroid = (A + B + C) / 3.0f;
+		Primitive.TriangleID = static_cast<uint32>(TriangleID);
+	}, 4096);
+
+	// 위쪽 트리는 직렬로 나누고, ParallelSubtreeSize 이하 서브트리는 각자 로컬 배열에 빌드한 뒤 순서대로 이어붙임
+	TArray<FBuildTask> Tasks;
+	Nodes.Reserve(TriCount / 2 + 1);
+	Nodes.emplace_back();
+	BuildNode(Context, Nodes, 0, 0, TriCount, 0, TriCount >= 2 * ParallelSubtreeSize ? &Tasks : nullptr);
+
+	if (!Tasks.IsEmpty())
+	{
+		TArray<TArray<FMeshBVHNode>> SubtreeNodes(Tasks.Num());
+		ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+		{
+			const FBuildTask& Task = Tasks[TaskIndex];
+			TArray<FMeshBVHNode>& LocalNodes = SubtreeNodes[TaskIndex];
+			LocalNodes.Reserve(Task.Count);
+			LocalNodes.emplace_back();
+			BuildNode(Context, LocalNodes, 0, Task.Start, Task.Count, Task.Depth, nullptr);
+		});
+
+		for (int32 TaskIndex = 0; TaskIndex < Tasks.Num(); ++TaskIndex)
+		{
+			const TArray<FMeshBVHNode>& LocalNodes = SubtreeNodes[TaskIndex];
+			// 로컬 0번(서브트리 루트)은 예약해 둔 자리에, 나머지는 뒤에 붙임 → 로컬 i번은 Base + i - 1
+			const uint32 Base = static_cast<uint32>(Nodes.Num());
+			auto Relocate = [Base](FMeshBVHNode Node)
+			{
+				if (!Node.IsLeaf())
+				{
+					Node.LeftOrStart = Base + Node.LeftOrStart - 1;
+				}
+				return Node;
+			};
 
-	BuildRecursive(0, TriCount, Vertices, Indices);
+			Nodes[Tasks[TaskIndex].NodeIndex] = Relocate(LocalNodes[0]);
+			for (int32 i = 1; i < LocalNodes.Num(); ++i)
+			{
+				Nodes.Add(Relocate(LocalNodes[i]));
+			}
+		}
+	}
+
+	TriIndices.resize(TriCount);
+	for (uint32 i = 0; i < TriCount; ++i)
+		TriIndices[i] = Context.Primitives[i].TriangleID;
+
+	Nodes.shrink_to_fit();
+	MaxDepth = Context.MaxDepth.load();
 }
 
-// 삼각형과 맞을 경우 , BVH를 따라 내려가면서 교차 가능성 있는 노드만 검사한다. 
-// Möller–Trumbore로 교차 체크 ! 
-bool FMeshBVH::IntersectRay(const FRay& InLocalRay,
-	const TArray<FNormalVertex>& InVertices,
-	const TArray<uint32>& InIndices,
-	float& OutHitDistance)
+bool FMeshBVH::InitFromCooked(TArray<FMeshBVHNode>&& InNodes, TArray<uint32>&& InTriIndices, uint32 NumTriangles)
 {
-	if (Nodes.Num() == 0)
+	Nodes.Empty();
+	TriIndices.Empty();
+	MaxDepth = 0;
+
+	if (InNodes.IsEmpty() || InTriIndices.Num() != static_cast<int32>(NumTriangles))
 	{
-		return false;
+		return NumTriangles == 0 && InNodes.IsEmpty();
+	}
+	for (uint32 TriangleID : InTriIndices)
+	{
+		if (TriangleID >= NumTriangles)
+		{
+			return false;
+		}
 	}
 
-	float RootEntry, RootExit;
-	if (!Nodes[0].Bounds.IntersectsRay(InLocalRay, RootEntry, RootExit))
+	// 자식은 항상 부모보다 뒤에 있으므로 (빌드 순서) 순환 없이 루트에서 모든 노드를 한 번씩 방문
+	struct FVisit
+	{
+		uint32 NodeIndex;
+		uint32 Depth;
+	};
+	TArray<FVisit> Pending;
+	Pending.Add({ 0, 0 });
+	uint32 NumVisited = 0;
+	uint32 DeepestLevel = 0;
+	while (!Pending.IsEmpty())
+	{
+		const FVisit Visit = Pending.back();
+		Pending.pop_back();
+		if (++NumVisited > static_cast<uint32>(InNodes.Num()))
+		{
+			return false; // 자식을 공유하는 노드가 있음
+		}
+		DeepestLevel = std::max(DeepestLevel, Visit.Depth);
+
+		const FMeshBVHNode& Node = InNodes[Visit.NodeIndex];
+		if (Node.IsLeaf())
+		{
+			if (static_cast<uint64>(Node.LeftOrStart) + Node.Count > NumTriangles)
+			{
+				return false;
+			}
+			continue;
+		}
+		if (Node.LeftOrStart <= Visit.NodeIndex || static_cast<uint64>(Node.LeftOrStart) + 1 >= static_cast<uint64>(InNodes.Num())
+			|| Visit.Depth + 1 >= MaxStackDepth)
+		{
+			return false;
+		}
+		Pending.Add({ Node.LeftOrStart, Visit.Depth + 1 });
+		Pending.Add({ Node.LeftOrStart + 1, Visit.Depth + 1 });
+	}
+	if (NumVisited != static_cast<uint32>(InNodes.Num()))	// 루트에서 닿지 않는 노드가 있음
 	{
 		return false;
 	}
 
-	struct FHeapItem
+	Nodes = std::move(InNodes);
+	TriIndices = std::move(InTriIndices);
+	MaxDepth = DeepestLevel;
+	return true;
+}
+
+void FMeshBVH::BuildNode(FBuildContext& Context, TArray<FMeshBVHNode>& OutNodes, uint32 NodeIndex, uint32 Start, uint32 Count,
+	uint32 Depth, TArray<FBuildTask>* DeferredTasks)
+{
+	if (DeferredTasks && Count <= ParallelSubtreeSize)
 	{
-		int NodeIndex;
-		float EntryDistance;
+		DeferredTasks->Add({ NodeIndex, Start, Count, Depth });
+		return;
+	}
+
+	// 노드 바운드와 중심점 바운드 (분할 축/빈 범위 결정용)
+	FVector BoundsMin(FLT_MAX, FLT_MAX, FLT_MAX), BoundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+	FVector CentroidMin = BoundsMin, CentroidMax = BoundsMax;
+	FBuildPrimitive* const First = Context.Primitives.data() + Start;
+	FBuildPrimitive* const Last = First + Count;
+	for (const FBuildPrimitive* Primitive = First; Primitive != Last; ++Primitive)
+	{
+		BoundsMin = BoundsMin.ComponentMin(Primitive->Min);
+		BoundsMax = BoundsMax.ComponentMax(Primitive->Max);
+		CentroidMin = CentroidMin.ComponentMin(Primitive->Centroid);
+		CentroidMax = CentroidMax.ComponentMax(Primitive->Centroid);
+	}
 
-		bool operator>(const FHeapItem& Other) const
+	{
+		FMeshBVHNode& Node = OutNodes[NodeIndex];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
 		{
-			return EntryDistance > Other.EntryDistance; // 최소 힙
+			Node.BoundsMin[Axis] = BoundsMin[Axis];
+			Node.BoundsMax[Axis] = BoundsMax[Axis];
 		}
-	};
-
-	std::priority_queue<FHeapItem, TArray<FHeapItem>, std::greater<FHeapItem>> Heap;
-	Heap.push({ 0, RootEntry });
+		Node.LeftOrStart = Start;
+		Node.Count = Count;
+	}
 
-	while (!Heap.empty())
+	if (Count <= 1)
 	{
-		FHeapItem Current = Heap.top();
-		Heap.pop();
+		Context.UpdateMaxDepth(Depth);
+		return;
+	}
 
-		const FMeshBVHNode& Node = Nodes[Current.NodeIndex];
-		if (Node.IsLeaf())
+	const FVector CentroidExtent = CentroidMax - CentroidMin;
+	int32 LongestAxis = 0;
+	if (CentroidExtent.Y > CentroidExtent[LongestAxis]) LongestAxis = 1;
+	if (CentroidExtent.Z > CentroidExtent[LongestAxis]) LongestAxis = 2;
+
+	uint32 Mid = Start + Count / 2;
+	if (CentroidExtent[LongestAxis] <= 0.0f)
+	{
+		// 모든 중심이 한 점 → 공간적으로 나눌 수 없음, 너무 크면 개수로만 반씩 나눔
+		if (Count <= MaxLeafSize)
 		{
-			for (uint32 TriOffset = 0; TriOffset < Node.Count; ++TriOffset)
+			Context.UpdateMaxDepth(Depth);
+			return;
+		}
+	}
+	else if (Depth < SAHDepthLimit)
+	{
+		// -------------------------------
+		// 빈 SAH: 축마다 중심점을 NumBins개 구간에 넣고 NumBins-1개 경계 중 비용이 가장 작은 곳으로 분할
+		// 비용 = Traversal + (왼쪽 면적 * 왼쪽 개수 + 오른쪽 면적 * 오른쪽 개수) / 부모 면적
+		// -------------------------------
+		const float ParentArea = std::max(HalfArea(BoundsMin, BoundsMax), 1e-30f);
+		float BestCost = FLT_MAX;
+		int32 BestAxis = -1;
+		uint32 BestSplit = 0;
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (CentroidExtent[Axis] <= 0.0f)
 			{
-				const uint32 TriangleID = TriIndices[Node.Start + TriOffset];
-				const uint32 V0 = InIndices[3 * TriangleID + 0];
-				const uint32 V1 = InIndices[3 * TriangleID + 1];
-				const uint32 V2 = InIndices[3 * TriangleID + 2];
+				continue;
+			}
 
-				const FVector& A = InVertices[V0].pos;
-				const FVector& B = InVertices[V1].pos;
-				const FVector& C = InVertices[V2].pos;
+			FBin Bins[NumBins];
+			const float Scale = static_cast<float>(NumBins) * (1.0f - 1e-5f) / CentroidExtent[Axis];
+			for (const FBuildPrimitive* Primitive = First; Primitive != Last; ++Primitive)
+			{
+				const uint32 BinIndex = std::min(static_cast<uint32>((Primitive->Centroid[Axis] - CentroidMin[Axis]) * Scale), NumBins - 1);
+				Bins[BinIndex].Add(Primitive->Min, Primitive->Max);
+				++Bins[BinIndex].Count;
+			}
 
-				float HitT = 0.0f;
-				if (IntersectRayTriangleMT(InLocalRay, A, B, C, HitT))
-				{
-					OutHitDistance = HitT;
-					return true; // 🚀 첫 번째 히트 → 바로 종료
-				}
+			// 오른쪽부터 누적한 면적/개수
+			float RightArea[NumBins];
+			uint32 RightCount[NumBins];
+			FBin Accumulated;
+			for (uint32 b = NumBins - 1; b > 0; --b)
+			{
+				Accumulated.Add(Bins[b].Min, Bins[b].Max);
+				Accumulated.Count += Bins[b].Count;
+				RightArea[b] = Accumulated.Count > 0 ? HalfArea(Accumulated.Min, Accumulated.Max) : 0.0f;
+				RightCount[b] = Accumulated.Count;
 			}
-		}
-		else
-		{
-			if (Node.Left >= 0)
+
+			Accumulated = FBin();
+			for (uint32 Split = 1; Split < NumBins; ++Split)
 			{
-				float ChildEntry, ChildExit;
-				if (Nodes[Node.Left].Bounds.IntersectsRay(InLocalRay, ChildEntry, ChildExit))
+				Accumulated.Add(Bins[Split - 1].Min, Bins[Split - 1].Max);
+				Accumulated.Count += Bins[Split - 1].Count;
+				if (Accumulated.Count == 0 || RightCount[Split] == 0)
 				{
-					Heap.push({ Node.Left, ChildEntry });
+					continue;
 				}
-			}
-			if (Node.Right >= 0)
-			{
-				float ChildEntry, ChildExit;
-				if (Nodes[Node.Right].Bounds.IntersectsRay(InLocalRay, ChildEntry, ChildExit))
+
+				const float Cost = TraversalCost +
+					(HalfArea(Accumulated.Min, Accumulated.Max) * Accumulated.Count + RightArea[Split] * RightCount[Split]) / ParentArea;
+				if (Cost < BestCost)
 				{
-					Heap.push({ Node.Right, ChildEntry });
+					BestCost = Cost;
+					BestAxis = Axis;
+					BestSplit = Split;
 				}
 			}
 		}
+
+		if (Count <= MaxLeafSize && static_cast<float>(Count) <= BestCost)
+		{
+			Context.UpdateMaxDepth(Depth);
+			return;
+		}
+
+		if (BestAxis >= 0)
+		{
+			const float Scale = static_cast<float>(NumBins) * (1.0f - 1e-5f) / CentroidExtent[BestAxis];
+			const float AxisMin = CentroidMin[BestAxis];
+			const FBuildPrimitive* MidIt = std::partition(First, Last, [&](const FBuildPrimitive& Primitive)
+			{
+				return std::min(static_cast<uint32>((Primitive.Centroid[BestAxis] - AxisMin) * Scale), NumBins - 1) < BestSplit;
+			});
+			Mid = Start + static_cast<uint32>(MidIt - First);
+		}
+		else
+		{
+			std::nth_element(First, First + (Mid - Start), Last,
+				[LongestAxis](const FBuildPrimitive& A, const FBuildPrimitive& B) { return A.Centroid[LongestAxis] < B.Centroid[LongestAxis]; });
+		}
+	}
+	else
+	{
+		// 깊이 제한 이후: 가장 긴 축의 중앙값 분할 (순회 스택 크기 보장)
+		std::nth_element(First, First + (Mid - Start), Last,
+			[LongestAxis](const FBuildPrimitive& A, const FBuildPrimitive& B) { return A.Centroid[LongestAxis] < B.Centroid[LongestAxis]; });
 	}
 
-	return false;
+	// -------------------------------
+	// 내부 노드로 전환 & 형제 노드를 연속으로 할당
+	// -------------------------------
+	const uint32 LeftIndex = static_cast<uint32>(OutNodes.Num());
+	OutNodes.emplace_back();
+	OutNodes.emplace_back();
+	OutNodes[NodeIndex].LeftOrStart = LeftIndex;
+	OutNodes[NodeIndex].Count = 0;
+
+	BuildNode(Context, OutNodes, LeftIndex, Start, Mid - Start, Depth + 1, DeferredTasks);
+	BuildNode(Context, OutNodes, LeftIndex + 1, Mid, Start + Count - Mid, Depth + 1, DeferredTasks);
 }
-//bool FMeshBVH::IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance)
-//{
-//	if (Nodes.Num() == 0)
-//	{
-//		return false;
-//	}
-//
-//	TArray<FStackItem> NodeStack;
-//
-//	float RootEntryDistance, RootExitDistance;
-//	// 루트 노드가 안맞으면 바로 리턴 
-//	if (!Nodes[0].Bounds.RayAABB_IntersectT(InLocalRay, RootEntryDistance, RootExitDistance))
-//	{
-//		return false;
-//	}
-//	// 가장 늦게 나간 RootEntryDistance
-//	// 삼각형 리스트 인덱스 , 디스턴스 값 저장 
-//	NodeStack.Add({ 0, RootEntryDistance });
-//	bool bHasHit = false;
-//	float ClosestHitDistance = std::numeric_limits<float>::infinity();
-//
-//	// 깊이 우선 탐색 (DFS). 
-//	// 이미 더 가까운 교차가 있으면 멀리 있는 노드는 스킵.
-//	while (!NodeStack.IsEmpty())
-//	{
-//		const FStackItem CurrentItem = NodeStack.Pop();
-//		// 이미 가까운 교차가 있으면 무시 
-//		if (CurrentItem.EntryDistance > ClosestHitDistance)
-//		{
-//			continue;
-//		}
-//
-//		const FMeshBVHNode& CurrentNode = Nodes[CurrentItem.NodeIndex];
-//		if (CurrentNode.IsLeaf())
-//		{
-//			// 총 삼각형의 개수 만큼 돈다. 
-//			for (uint32 TriangleOffset = 0; TriangleOffset < CurrentNode.Count; ++TriangleOffset)
-//			{
-//				// 삼각형 배열에서 시작 위치 Start, TriangleOffset 삼각형의 총 개수만큼 돈다. 
-//				// 그쪽 영역의 삼각형이기 때문이다
-//				const uint32 TriangleID = TriIndices[CurrentNode.Start + TriangleOffset];
-//
-//				const uint32 VertexIndex0 = InIndices[3 * TriangleID + 0];
-//				const uint32 VertexIndex1 = InIndices[3 * TriangleID + 1];
-//				const uint32 VertexIndex2 = InIndices[3 * TriangleID + 2];
-//
-//				const FVector& VertexA = InVertices[VertexIndex0].pos;
-//				const FVector& VertexB = InVertices[VertexIndex1].pos;
-//				const FVector& VertexC = InVertices[VertexIndex2].pos;
-//
-//				float HitDistance = 0.0f;
-//				if (IntersectRayTriangleMT(InLocalRay, VertexA, VertexB, VertexC, HitDistance))
-//				{
-//					if (HitDistance < ClosestHitDistance)
-//					{
-//						ClosestHitDistance = HitDistance;
-//						bHasHit = true;
-//					}
-//				}
-//			}
-//			continue;
-//		}
-//
-//		// 내부 노드 → 자식 검사
-//		// 삼각형에 맞으면, 검사 영역에 넣어주고 맞지 않으면 넣어주지 않는다. 
-//		if (CurrentNode.Left >= 0)
-//		{
-//			float ChildEntry, ChildExit;
-//			if (Nodes[CurrentNode.Left].Bounds.RayAABB_IntersectT(InLocalRay, ChildEntry, ChildExit))
-//			{
-//				NodeStack.Add({ CurrentNode.Left, ChildEntry });
-//			}
-//		}
-//		if (CurrentNode.Right >= 0)
-//		{
-//			float ChildEntry, ChildExit;
-//			if (Nodes[CurrentNode.Right].Bounds.RayAABB_IntersectT(InLocalRay, ChildEntry, ChildExit))
-//			{
-//				NodeStack.Add({ CurrentNode.Right, ChildEntry });
-//			}
-//		}
-//	}
-//
-//	if (bHasHit)
-//	{
-//		OutHitDistance = ClosestHitDistance;
-//		return true;
-//	}
-//	return false;
-//}
-
-FAABB FMeshBVH::ComputeTriBounds(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
+
+bool FMeshBVH::IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance) const
 {
-	// TriangleID : 몇 번째 삼각형인지 (0번, 1번 , 2번)
-	uint32 VertexIndex0, VertexIndex1, VertexIndex2;
-
-	// 순차적으로 꺼내온다. 
-	VertexIndex0 = Indices[3 * TriangleID + 0];
-	VertexIndex1 = Indices[3 * TriangleID + 1];
-	VertexIndex2 = Indices[3 * TriangleID + 2];
-
-
-	// 실제 정점 좌표들을 가져온다. 
-	const FVector& VertexA = Vertices[VertexIndex0].pos;
-	const FVector& VertexB = Vertices[VertexIndex1].pos;
-	const FVector& VertexC = Vertices[VertexIndex2].pos;
-
-	// AABB 최소/최대 좌표 계산
-	FVector MinCorner(
-		std::min({ VertexA.X, VertexB.X, VertexC.X }),
-		std::min({ VertexA.Y, VertexB.Y, VertexC.Y }),
-		std::min({ VertexA.Z, VertexB.Z, VertexC.Z })
-	);
-
-	FVector MaxCorner(
-		std::max({ VertexA.X, VertexB.X, VertexC.X }),
-		std::max({ VertexA.Y, VertexB.Y, VertexC.Y }),
-		std::max({ VertexA.Z, VertexB.Z, VertexC.Z })
-	);
-
-	// 삼각형의 바운딩 박스 반환
-	return FAABB(MinCorner, MaxCorner);
+	FMeshRayHit Hit;
+	if (IntersectRay(InLocalRay, InVertices, InIndices, Hit, EMeshRayQuery::ClosestHit))
+	{
+		OutHitDistance = Hit.Distance;
+		return true;
+	}
+	return false;
 }
 
-FVector FMeshBVH::ComputeTriCenter(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
+// 가까운 자식부터 방문하는 스택 순회 (먼 자식은 진입 거리와 함께 스택에 넣고, 꺼낼 때 이미 더 가까운 히트가 있으면 스킵)
+// Möller–Trumbore로 교차 체크 !
+bool FMeshBVH::IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices,
+	FMeshRayHit& OutHit, EMeshRayQuery Query, float MaxDistance) const
 {
-	// 삼각형을 구성하는 세 개의 정점 인덱스
-	const uint32 VertexIndex0 = Indices[TriangleID * 3 + 0];
-	const uint32 VertexIndex1 = Indices[TriangleID * 3 + 1];
-	const uint32 VertexIndex2 = Indices[TriangleID * 3 + 2];
+	OutHit = FMeshRayHit();
+	if (Nodes.IsEmpty())
+	{
+		return false;
+	}
 
-	// 실제 좌표
-	const FVector& Position0 = Vertices[VertexIndex0].pos;
-	const FVector& Position1 = Vertices[VertexIndex1].pos;
-	const FVector& Position2 = Vertices[VertexIndex2].pos;
+	const FVector InvDir(SafeInverse(InLocalRay.Direction.X), SafeInverse(InLocalRay.Direction.Y), SafeInverse(InLocalRay.Direction.Z));
+	float ClosestDistance = MaxDistance;
 
-	// 중심점(무게중심) 계산
+	float Entry;
+	if (!IntersectNode(Nodes[0], InLocalRay.Origin, InvDir, ClosestDistance, Entry))
+	{
+		return false;
+	}
 
-	const FVector TriangleCenter = (Position0 + Position1 + Position2) / 3.0f;
+	struct FStackEntry
+	{
+		uint32 NodeIndex;
+		float Entry;
+	};
+	FStackEntry Stack[MaxStackDepth];
+	uint32 StackSize = 0;
+	uint32 NodeIndex = 0;
 
-	return TriangleCenter;
-}
+	while (true)
+	{
+		const FMeshBVHNode& Node = Nodes[NodeIndex];
+		if (Node.IsLeaf())
+		{
+			for (uint32 i = Node.LeftOrStart; i < Node.LeftOrStart + Node.Count; ++i)
+			{
+				const uint32 TriangleID = TriIndices[i];
+				const FVector& A = InVertices[InIndices[3 * TriangleID + 0]].pos;
+				const FVector& B = InVertices[InIndices[3 * TriangleID + 1]].pos;
+				const FVector& C = InVertices[InIndices[3 * TriangleID + 2]].pos;
 
-// 여러 삼각형을 한 번에 감싸는 AABB를 계산 
-FAABB FMeshBVH::ComputeBounds(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
-{
-	// 첫 번째 삼각형 ID로 AABB 초기화 
-	FAABB Bounds = ComputeTriBounds(TriIndices[Start], Vertices, Indices);
-	// Start+1 ~ Start+Count-1 까지 모든 삼각형에 대해 반복 
-	// 가장 큰 MIN , MAX 찾아낸다. 
-	for (uint32 i = 1; i < Count; i++)
-	{
-		FAABB TB = ComputeTriBounds(TriIndices[Start + i], Vertices, Indices);
-		Bounds.Min = Bounds.Min.ComponentMin(TB.Min);
-		Bounds.Max = Bounds.Max.ComponentMax(TB.Max);
+				float HitT = 0.0f;
+				if (IntersectRayTriangleMT(InLocalRay, A, B, C, HitT) && HitT < ClosestDistance)
+				{
+					ClosestDistance = HitT;
+					OutHit.Distance = HitT;
+					OutHit.TriangleIndex = TriangleID;
+					OutHit.bHit = true;
+					if (Query == EMeshRayQuery::AnyHit)
+					{
+						return true;
+					}
+				}
+			}
+		}
+		else
+		{
+			const uint32 Left = Node.LeftOrStart;
+			float LeftEntry, RightEntry;
+			const bool bHitLeft = IntersectNode(Nodes[Left], InLocalRay.Origin, InvDir, ClosestDistance, LeftEntry);
+			const bool bHitRight = IntersectNode(Nodes[Left + 1], InLocalRay.Origin, InvDir, ClosestDistance, RightEntry);
+
+			if (bHitLeft && bHitRight)
+			{
+				const bool bLeftFirst = LeftEntry <= RightEntry;
+				Stack[StackSize++] = bLeftFirst ? FStackEntry{ Left + 1, RightEntry } : FStackEntry{ Left, LeftEntry };
+				NodeIndex = bLeftFirst ? Left : Left + 1;
+				continue;
+			}
+			if (bHitLeft || bHitRight)
+			{
+				NodeIndex = bHitLeft ? Left : Left + 1;
+				continue;
+			}
+		}
+
+		// 다음 후보: 이미 찾은 히트보다 먼 노드는 버림
+		bool bFound = false;
+		while (StackSize > 0)
+		{
+			const FStackEntry Candidate = Stack[--StackSize];
+			if (Candidate.Entry <= ClosestDistance)
+			{
+				NodeIndex = Candidate.NodeIndex;
+				bFound = true;
+				break;
+			}
+		}
+		if (!bFound)
+		{
+			break;
+		}
 	}
-	return Bounds;
+
+	return OutHit.bHit;
 }
 
-// BVH 트리 -> 재귀 구축 
-int FMeshBVH::BuildRecursive(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
+void FMeshBVH::IntersectRays(const FRay* InLocalRays, uint32 NumRays, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices,
+	FMeshRayHit* OutHits, EMeshRayQuery Query, float MaxDistance) const
 {
-	FMeshBVHNode Node;
-	Node.Start = Start;
-	Node.Count = Count;
-
-	// 이 노드가 감싸는 AABB 계산
-	Node.Bounds = ComputeBounds(Start, Count, Vertices, Indices);
+	const uint32 NumPackets = (NumRays + 3) / 4;
+	auto TracePacket = [&](uint32 PacketIndex)
+	{
+		const uint32 First = PacketIndex * 4;
+		IntersectPacket(InLocalRays + First, std::min(4u, NumRays - First), InVertices, InIndices, OutHits + First, Query, MaxDistance);
+	};
 
-	// 현재 노드 인덱스 확보 & 추가 -> 자식으로 쪼갤 때 사용 
-	int NodeIndex = Nodes.Num();
-	Nodes.Add(Node);
+	if (NumPackets >= ParallelPacketThreshold)
+	{
+		ParallelFor(static_cast<int32>(NumPackets), [&](int32 PacketIndex) { TracePacket(static_cast<uint32>(PacketIndex)); }, 16);
+	}
+	else
+	{
+		for (uint32 PacketIndex = 0; PacketIndex < NumPackets; ++PacketIndex)
+		{
+			TracePacket(PacketIndex);
+		}
+	}
+}
 
-	// 리프 조건: 삼각형 개수가 LeafSize 이하
-	if (Count <= LeafSize)
+// 레이 4개가 같은 노드 순서로 내려가며, 교차하는 레인이 하나라도 있으면 방문
+// 끝난 레인(AnyHit에서 히트했거나 빈 레인)은 최대 거리를 음수로 두어 노드/삼각형 테스트에서 자동으로 빠지게 함
+void FMeshBVH::IntersectPacket(const FRay* InLocalRays, uint32 NumRays, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices,
+	FMeshRayHit* OutHits, EMeshRayQuery Query, float MaxDistance) const
+{
+	alignas(16) float Origin[3][4] = {};
+	alignas(16) float Dir[3][4] = {};
+	alignas(16) float InvDir[3][4] = {};
+	alignas(16) float LaneMax[4];
+	for (uint32 Lane = 0; Lane < 4; ++Lane)
+	{
+		const bool bActive = Lane < NumRays && !Nodes.IsEmpty();
+		const FRay& Ray = InLocalRays[bActive ? Lane : 0];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Origin[Axis][Lane] = Ray.Origin[Axis];
+			Dir[Axis][Lane] = Ray.Direction[Axis];
+			InvDir[Axis][Lane] = SafeInverse(Ray.Direction[Axis]);
+		}
+		LaneMax[Lane] = bActive ? MaxDistance : -1.0f;
+		if (Lane < NumRays)
+		{
+			OutHits[Lane] = FMeshRayHit();
+		}
+	}
+	if (Nodes.IsEmpty())
 	{
-		return NodeIndex;
+		return;
 	}
 
-	// -------------------------------
-	// 분할 축 선택 (가장 긴 축)
-	// -------------------------------
-	FVector Extent = Node.Bounds.GetHalfExtent();
-	EAxis Axis = EAxis::X;
+	FRayPacket Packet;
+	Packet.OriginX = _mm_load_ps(Origin[0]); Packet.OriginY = _mm_load_ps(Origin[1]); Packet.OriginZ = _mm_load_ps(Origin[2]);
+	Packet.DirX = _mm_load_ps(Dir[0]); Packet.DirY = _mm_load_ps(Dir[1]); Packet.DirZ = _mm_load_ps(Dir[2]);
+	Packet.InvDirX = _mm_load_ps(InvDir[0]); Packet.InvDirY = _mm_load_ps(InvDir[1]); Packet.InvDirZ = _mm_load_ps(InvDir[2]);
+	__m128 Closest = _mm_load_ps(LaneMax);
 
-	if (Extent.Y > Extent.X && Extent.Y >= Extent.Z)
-		Axis = EAxis::Y;
-	else if (Extent.Z > Extent.X && Extent.Z >= Extent.Y)
-		Axis = EAxis::Z;
+	uint32 Stack[MaxStackDepth + 1];
+	uint32 StackSize = 0;
+	Stack[StackSize++] = 0;
 
-	// 중간 지점 -> 반으로 쪼갤 준비하기 
-	uint32 Mid = Start + Count / 2;
-
-	// -------------------------------
-	// 삼각형 중심 좌표 기준으로 분할
-	// -------------------------------
-	// 오른쪽 왼쪽으로 나누기 좋은 
-	// nth_element 가이드 
-	// nth_element(first, nth, last, comp)
-	// nth 위치에 "정렬했을 때 올 원소"를 제자리에 넣음
-	// 왼쪽 구간 [first, nth) 에는 그 원소보다 "작은 것들"만
-	// 오른쪽 구간 [nth+1, last) 에는 "큰 것들"만 놓음
-
-	// 선택된 Axis를 방향으로 왼쪽과 오른쪽으로 나눈다. 
-	// 전체를 정렬하지 않고, n번째 작은 원소를 찾아서 놓는다. 
-	std::nth_element(
-		TriIndices.begin() + Start, // 분할할 구간 시작
-		TriIndices.begin() + Mid, // 중간 값의 위치 
-		TriIndices.begin() + Start + Count, // 분할할 구간의 끝 
-		[&](uint32 A, uint32 B)			// 비교함수 
+	while (StackSize > 0)
+	{
+		const FMeshBVHNode& Node = Nodes[Stack[--StackSize]];
+		__m128 Entry;
+		if (IntersectNodePacket(Node, Packet, Closest, Entry) == 0)
 		{
-			FVector CenterA = ComputeTriCenter(A, Vertices, Indices);
-			FVector CenterB = ComputeTriCenter(B, Vertices, Indices);
+			continue;
+		}
 
-			switch (Axis)
+		if (Node.IsLeaf())
+		{
+			for (uint32 i = Node.LeftOrStart; i < Node.LeftOrStart + Node.Count; ++i)
 			{
-			case EAxis::X: return CenterA.X < CenterB.X;
-			case EAxis::Y: return CenterA.Y < CenterB.Y;
-			case EAxis::Z: return CenterA.Z < CenterB.Z;
-			default:       return CenterA.X < CenterB.X;
+				const uint32 TriangleID = TriIndices[i];
+				const FVector& A = InVertices[InIndices[3 * TriangleID + 0]].pos;
+				const FVector& B = InVertices[InIndices[3 * TriangleID + 1]].pos;
+				const FVector& C = InVertices[InIndices[3 * TriangleID + 2]].pos;
+
+				__m128 HitT;
+				const int32 HitMask = IntersectTrianglePacket(Packet, A, B, C, Closest, HitT);
+				if (HitMask == 0)
+				{
+					continue;
+				}
+
+				alignas(16) float HitDistance[4];
+				_mm_store_ps(HitDistance, HitT);
+				for (uint32 Lane = 0; Lane < NumRays; ++Lane)
+				{
+					if (HitMask & (1 << Lane))
+					{
+						OutHits[Lane].Distance = HitDistance[Lane];
+						OutHits[Lane].TriangleIndex = TriangleID;
+						OutHits[Lane].bHit = true;
+					}
+				}
+
+				const __m128 LaneHit = _mm_castsi128_ps(_mm_cmpgt_epi32(
+					_mm_and_si128(_mm_set1_epi32(HitMask), _mm_setr_epi32(1, 2, 4, 8)), _mm_setzero_si128()));
+				const __m128 NewClosest = Query == EMeshRayQuery::AnyHit ? _mm_set1_ps(-1.0f) : HitT;
+				Closest = _mm_or_ps(_mm_and_ps(LaneHit, NewClosest), _mm_andnot_ps(LaneHit, Closest));
 			}
-		});
 
-	// -------------------------------
-	// 내부 노드로 전환 & 자식 생성
-	// -------------------------------
-	// 자식 생성으로 본인 Count 초기화.
-	// Left, Right에 자식 달기 
-	Nodes[NodeIndex].Count = 0;
-	Nodes[NodeIndex].Left = BuildRecursive(Start, Mid - Start, Vertices, Indices);
-	Nodes[NodeIndex].Right = BuildRecursive(Mid, Start + Count - Mid, Vertices, Indices);
+			if (Query == EMeshRayQuery::AnyHit && _mm_movemask_ps(_mm_cmpge_ps(Closest, _mm_setzero_ps())) == 0)
+			{
+				return;
+			}
+			continue;
+		}
 
-	return NodeIndex;
+		// 활성 레인 중 가장 작은 진입 거리가 가까운 자식을 나중에 넣어 먼저 꺼냄
+		const uint32 Left = Node.LeftOrStart;
+		__m128 LeftEntry, RightEntry;
+		const int32 LeftMask = IntersectNodePacket(Nodes[Left], Packet, Closest, LeftEntry);
+		const int32 RightMask = IntersectNodePacket(Nodes[Left + 1], Packet, Closest, RightEntry);
+		if (LeftMask && RightMask)
+		{
+			alignas(16) float LeftDistances[4], RightDistances[4];
+			_mm_store_ps(LeftDistances, LeftEntry);
+			_mm_store_ps(RightDistances, RightEntry);
+			float LeftNearest = FLT_MAX, RightNearest = FLT_MAX;
+			for (uint32 Lane = 0; Lane < 4; ++Lane)
+			{
+				if (LeftMask & (1 << Lane)) LeftNearest = std::min(LeftNearest, LeftDistances[Lane]);
+				if (RightMask & (1 << Lane)) RightNearest = std::min(RightNearest, RightDistances[Lane]);
+			}
+			const bool bLeftFirst = LeftNearest <= RightNearest;
+			Stack[StackSize++] = bLeftFirst ? Left + 1 : Left;
+			Stack[StackSize++] = bLeftFirst ? Left : Left + 1;
+		}
+		else if (LeftMask)
+		{
+			Stack[StackSize++] = Left;
+		}
+		else if (RightMask)
+		{
+			Stack[StackSize++] = Left + 1;
+		}
+	}
 }
@@ -1,47 +1,92 @@
 ﻿#pragma once
 #include "AABB.h"
 
+/**
+ * 32바이트 BVH 노드 (캐시 라인 하나에 형제 노드 두 개가 같이 들어감)
+ * - Count == 0 : 내부 노드, 왼쪽 자식 = LeftOrStart, 오른쪽 자식 = LeftOrStart + 1
+ * - Count > 0  : 리프 노드, TriIndices[LeftOrStart, LeftOrStart + Count) 삼각형
+ */
 struct FMeshBVHNode
 {
-	FAABB Bounds;     // 이 노드가 감싸는 AABB
-	int Left = -1;     // 왼쪽 자식 인덱스
-	int Right = -1;    // 오른쪽 자식 인덱스
-	uint32 Start = 0;  // TriIndices 배열에서 시작 위치
-	uint32 Count = 0;  // 리프 노드라면 포함된 삼각형 개수 
+	float BoundsMin[3];
+	uint32 LeftOrStart = 0;
+	float BoundsMax[3];
+	uint32 Count = 0;
 
 	bool IsLeaf() const { return Count > 0; }
+	FAABB GetBounds() const;
 };
+static_assert(sizeof(FMeshBVHNode) == 32, "FMeshBVHNode must stay 32 bytes");
 
-struct FStackItem
+enum class EMeshRayQuery : uint8
 {
-	int32 NodeIndex;
-	float EntryDistance;
+	ClosestHit,	// 가장 가까운 교차 (피킹, 데칼 투영)
+	AnyHit,		// 아무 교차나 찾으면 종료 (가시성/라인 트레이스)
 };
+
+struct FMeshRayHit
+{
+	float Distance = FLT_MAX;
+	uint32 TriangleIndex = UINT32_MAX;	// Indices 기준 삼각형 번호 (Indices[3 * TriangleIndex])
+	bool bHit = false;
+};
+
+/**
+ * 메시 삼각형 BVH (로컬 공간)
+ * - 빌드: 16개 빈 SAH, 큰 서브트리는 TaskGraph로 병렬 빌드 (결과는 스레드 수와 무관하게 동일)
+ * - 순회: 고정 크기 스택, 가까운 자식부터 방문
+ * - 배치 쿼리: 레이 4개를 한 패킷으로 묶어 SSE로 노드/삼각형을 동시에 검사
+ * - 쿠킹: 노드/삼각형 순서 배열을 그대로 .cooked에 저장하고 로드 시 검증만 거쳐 재빌드 없이 사용
+ */
 class FMeshBVH
 {
 public:
+	/** 빌더/노드 레이아웃이 바뀌면 올릴 것 (쿠킹된 BVH와 다르면 버리고 다시 빌드) */
+	static constexpr uint32 CookVersion = 1;
 
 	void Build(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
 
-	bool IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance);
+	/**
+	 * 쿠킹된 노드/삼각형 순서로 초기화 (빌드 없음)
+	 * 자식/리프 범위, 삼각형 번호, 순회 스택 깊이를 검사해 손상된 데이터면 false
+	 */
+	bool InitFromCooked(TArray<FMeshBVHNode>&& InNodes, TArray<uint32>&& InTriIndices, uint32 NumTriangles);
 
+	const TArray<FMeshBVHNode>& GetNodes() const { return Nodes; }
+	const TArray<uint32>& GetTriIndices() const { return TriIndices; }
 
-private:
-	// Helper 함수들
-	FAABB ComputeTriBounds(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
+	/** 가장 가까운 교차 거리 (레이 Direction 길이 단위) */
+	bool IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance) const;
 
-	FVector ComputeTriCenter(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
+	bool IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices,
+		FMeshRayHit& OutHit, EMeshRayQuery Query = EMeshRayQuery::ClosestHit, float MaxDistance = FLT_MAX) const;
 
-	FAABB ComputeBounds(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
+	/**
+	 * 여러 레이를 4개씩 패킷으로 추적 (OutHits는 NumRays개)
+	 * 비슷한 방향의 레이(피킹 영역, 데칼 투영 격자, 라인 트레이스 묶음)일수록 노드 방문을 많이 공유함
+	 */
+	void IntersectRays(const FRay* InLocalRays, uint32 NumRays, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices,
+		FMeshRayHit* OutHits, EMeshRayQuery Query = EMeshRayQuery::ClosestHit, float MaxDistance = FLT_MAX) const;
 
-	int BuildRecursive(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
+	bool IsEmpty() const { return Nodes.IsEmpty(); }
+	uint32 GetNumNodes() const { return static_cast<uint32>(Nodes.Num()); }
+	uint32 GetMaxDepth() const { return MaxDepth; }
+
+private:
+	struct FBuildContext;
+	struct FBuildTask;
+
+	void BuildNode(FBuildContext& Context, TArray<FMeshBVHNode>& OutNodes, uint32 NodeIndex, uint32 Start, uint32 Count,
+		uint32 Depth, TArray<FBuildTask>* DeferredTasks);
+
+	void IntersectPacket(const FRay* InLocalRays, uint32 NumRays, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices,
+		FMeshRayHit* OutHits, EMeshRayQuery Query, float MaxDistance) const;
 
 private:
 
 	TArray<FMeshBVHNode> Nodes;
-	//삼각형 ID(번호) 목록 , 삼각형의 인덱스를 의미한다. 
+	//삼각형 ID(번호) 목록 , 삼각형의 인덱스를 의미한다.
 	//삼각형 순서만 재배치  , 정점 좌표와 인덱스 버퍼를 직접적으로 건들면 안되기 때문이다.
 	TArray<uint32> TriIndices;
-	const uint32 LeafSize = 4;
+	uint32 MaxDepth = 0;
 };
-
@@ -1,10 +1,248 @@
 ﻿#include "pch.h"
 #include "Occlusion.h"
 #include "Frustum.h"
+#include "PlatformTime.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <emmintrin.h>
 
-// NDC Z가 [-1..1]인 프로젝션이면 아래 변환을 켜세요.
-// static inline float To01(float z_ndc) { return z_ndc * 0.5f + 0.5f; }
-static inline void Clamp01(float& v) { v = std::max(0.0f, std::min(1.0f, v)); }
+namespace
+{
+	// 래스터화 타일 크기 (너비는 SSE 폭 4의 배수), 타일 하나 = 태스크 하나
+	constexpr int TileWidth = 64;
+	constexpr int TileHeight = 16;
+	// 화면 밖 이 배수(NDC)까지는 클리핑하지 않음 → 변 함수 값이 float 정밀도 안에 머묾
+	constexpr float GuardBand = 2.0f;
+	// 셋업 태스크 하나가 맡을 삼각형 수 (큰 오클루더 하나도 여러 스레드로 나눔)
+	constexpr uint32 SetupChunkTriangles = 4096;
+	// 오클루디 깊이 비교 바이어스 (선형 0..1)
+	constexpr float DepthBias = 1e-4f;
+	// 오클루디 하나당 읽을 최대 HZB 텍셀 수 (거친 레벨에서 가려지지 않으면 이 한도 안에서 세밀한 레벨로 재검사)
+	constexpr int MaxTestTexels = 64;
+	constexpr int32 TestGrainSize = 64;
+
+	// 클립 공간 정점 + 선형 깊이
+	struct FClipVertex
+	{
+		float X, Y, W;
+		float Z;	// (ViewZ - Near) / (Far - Near), 근평면 앞이면 음수
+	};
+
+	// 화면 공간 삼각형 (픽셀 좌표, 반시계 방향으로 정렬됨)
+	struct FRasterTriangle
+	{
+		// 변 함수 E(x, y) = A * x + B * y + C, 세 변 모두 >= 0이면 내부
+		float EdgeA[3], EdgeB[3], EdgeC[3];
+		// 선형 깊이 = (ZA * x + ZB * y + ZC) / (WA * x + WB * y + WC) (Z/W와 1/W는 화면 공간에서 선형)
+		float ZA, ZB, ZC;
+		float WA, WB, WC;
+		// 세 정점 깊이 범위 (퇴화에 가까운 삼각형의 평면 계수 오차가 더 가까운 깊이를 쓰지 못하게 클램프)
+		float ZMin, ZMax;
+		int32 MinX, MinY, MaxX, MaxY;	// 픽셀 바운드 (포함, 화면으로 클램프됨)
+	};
+
+	// 셋업 작업 단위 (오클루더 하나의 삼각형 구간)
+	struct FSetupJob
+	{
+		uint32 OccluderIndex;
+		uint32 FirstTriangle;
+		uint32 NumTriangles;
+		TArray<FRasterTriangle> Triangles;
+	};
+
+	inline FClipVertex TransformVertex(const FVector& P, const FOccluderMesh& Mesh, float NearClip, float InvDepthRange)
+	{
+		const FMatrix& C = Mesh.WorldViewProj;
+		const FMatrix& V = Mesh.WorldView;
+
+		FClipVertex Out;
+		Out.X = P.X * C.M[0][0] + P.Y * C.M[1][0] + P.Z * C.M[2][0] + C.M[3][0];
+		Out.Y = P.X * C.M[0][1] + P.Y * C.M[1][1] + P.Z * C.M[2][1] + C.M[3][1];
+		Out.W = P.X * C.M[0][3] + P.Y * C.M[1][3] + P.Z * C.M[2][3] + C.M[3][3];
+		const float ViewZ = P.X * V.M[0][2] + P.Y * V.M[1][2] + P.Z * V.M[2][2] + V.M[3][2];
+		Out.Z = (ViewZ - NearClip) * InvDepthRange;
+		return Out;
+	}
+
+	// 클리핑 평면까지의 부호 거리 (>= 0 이면 안쪽): 근평면, 가드 밴드 좌/우/하/상
+	constexpr int NumClipPlanes = 5;
+	inline float PlaneDistance(const FClipVertex& V, int Plane)
+	{
+		switch (Plane)
+		{
+		case 0: return V.Z;
+		case 1: return GuardBand * V.W + V.X;
+		case 2: return GuardBand * V.W - V.X;
+		case 3: return GuardBand * V.W + V.Y;
+		default: return GuardBand * V.W - V.Y;
+		}
+	}
+
+	inline uint32 ComputeOutCode(const FClipVertex& V)
+	{
+		uint32 Code = 0;
+		for (int Plane = 0; Plane < NumClipPlanes; ++Plane)
+		{
+			Code |= (PlaneDistance(V, Plane) < 0.0f ? 1u : 0u) << Plane;
+		}
+		return Code;
+	}
+
+	// Sutherland-Hodgman, 결과는 Poly에 (삼각형 + 평면 5개 → 최대 8개 정점)
+	int ClipPolygon(FClipVertex* Poly, int Count)
+	{
+		FClipVertex Scratch[16];
+		for (int Plane = 0; Plane < NumClipPlanes; ++Plane)
+		{
+			int OutCount = 0;
+			for (int i = 0; i < Count; ++i)
+			{
+				const FClipVertex& A = Poly[i];
+				const FClipVertex& B = Poly[(i + 1) % Count];
+				const float DA = PlaneDistance(A, Plane);
+				const float DB = PlaneDistance(B, Plane);
+				if (DA >= 0.0f)
+				{
+					Scratch[OutCount++] = A;
+				}
+				if ((DA >= 0.0f) != (DB >= 0.0f))
+				{
+					const float T = DA / (DA - DB);
+					Scratch[OutCount++] = {
+						A.X + (B.X - A.X) * T,
+						A.Y + (B.Y - A.Y) * T,
+						A.W + (B.W - A.W) * T,
+						A.Z + (B.Z - A.Z) * T };
+				}
+			}
+			if (OutCount < 3)
+			{
+				return 0;
+			}
+			std::copy(Scratch, Scratch + OutCount, Poly);
+			Count = OutCount;
+		}
+		return Count;
+	}
+
+	void EmitTriangle(const FClipVertex& V0, const FClipVertex& V1, const FClipVertex& V2, int GridW, int GridH, TArray<FRasterTriangle>& Out)
+	{
+		// 화면 좌표 (y 위쪽, FOcclusionGrid 규약)
+		const FClipVertex* V[3] = { &V0, &V1, &V2 };
+		float X[3], Y[3], ZOverW[3], InvW[3], Z[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			InvW[i] = 1.0f / V[i]->W;
+			X[i] = (V[i]->X * InvW[i] * 0.5f + 0.5f) * float(GridW);
+			Y[i] = (V[i]->Y * InvW[i] * 0.5f + 0.5f) * float(GridH);
+			Z[i] = std::max(0.0f, V[i]->Z);
+			ZOverW[i] = Z[i] * InvW[i];
+		}
+
+		// D3D11 기본 래스터라이저(CULL_BACK, 화면에서 시계 방향 = 앞면)와 같은 면만 가림
+		// y 위쪽 좌표에서 시계 방향은 음수 면적 → 앞면은 1, 2를 바꿔 반시계로 맞춤
+		float Area = (X[1] - X[0]) * (Y[2] - Y[0]) - (X[2] - X[0]) * (Y[1] - Y[0]);
+		if (Area > -1e-6f)
+		{
+			return;
+		}
+		std::swap(X[1], X[2]);
+		std::swap(Y[1], Y[2]);
+		std::swap(ZOverW[1], ZOverW[2]);
+		std::swap(InvW[1], InvW[2]);
+		Area = -Area;
+
+		// 픽셀 중심 (x + 0.5)이 바운드 안에 있는 픽셀만
+		FRasterTriangle T;
+		T.MinX = std::max(0, int(std::ceil(std::min({ X[0], X[1], X[2] }) - 0.5f)));
+		T.MinY = std::max(0, int(std::ceil(std::min({ Y[0], Y[1], Y[2] }) - 0.5f)));
+		T.MaxX = std::min(GridW - 1, int(std::floor(std::max({ X[0], X[1], X[2] }) - 0.5f)));
+		T.MaxY = std::min(GridH - 1, int(std::floor(std::max({ Y[0], Y[1], Y[2] }) - 0.5f)));
+		if (T.MinX > T.MaxX || T.MinY > T.MaxY)
+		{
+			return;
+		}
+
+		for (int i = 0; i < 3; ++i)
+		{
+			const int j = (i + 1) % 3;
+			T.EdgeA[i] = Y[i] - Y[j];
+			T.EdgeB[i] = X[j] - X[i];
+			T.EdgeC[i] = -(T.EdgeA[i] * X[i] + T.EdgeB[i] * Y[i]);
+		}
+
+		const float InvArea = 1.0f / Area;
+		auto MakePlane = [&](const float F[3], float& OutA, float& OutB, float& OutC)
+			{
+				OutA = ((F[1] - F[0]) * (Y[2] - Y[0]) - (F[2] - F[0]) * (Y[1] - Y[0])) * InvArea;
+				OutB = ((F[2] - F[0]) * (X[1] - X[0]) - (F[1] - F[0]) * (X[2] - X[0])) * InvArea;
+				OutC = F[0] - OutA * X[0] - OutB * Y[0];
+			};
+		MakePlane(ZOverW, T.ZA, T.ZB, T.ZC);
+		MakePlane(InvW, T.WA, T.WB, T.WC);
+
+		T.ZMin = std::min(1.0f, std::min({ Z[0], Z[1], Z[2] }));
+		T.ZMax = std::min(1.0f, std::max({ Z[0], Z[1], Z[2] }));
+
+		Out.Add(T);
+	}
+
+	// 타일 [TileMinX..TileMaxX] x [TileMinY..TileMaxY] 안에서 삼각형을 4픽셀씩 그림 (깊이 min)
+	void RasterizeTriangleInTile(const FRasterTriangle& T, FOcclusionGrid& Grid, int TileMinX, int TileMinY, int TileMaxX, int TileMaxY)
+	{
+		// 타일 시작이 4의 배수이고 그리드 너비도 4의 배수라 x + 3은 항상 같은 타일/행 안
+		const int MinX = std::max(T.MinX, TileMinX) & ~3;
+		const int MaxX = std::min(T.MaxX, TileMaxX);
+		const int MinY = std::max(T.MinY, TileMinY);
+		const int MaxY = std::min(T.MaxY, TileMaxY);
+		if (MinX > MaxX || MinY > MaxY)
+		{
+			return;
+		}
+
+		const __m128 Zero = _mm_setzero_ps();
+		const __m128 ZMin = _mm_set1_ps(T.ZMin);
+		const __m128 ZMax = _mm_set1_ps(T.ZMax);
+		const __m128 Four = _mm_set1_ps(4.0f);
+		const __m128 A0 = _mm_set1_ps(T.EdgeA[0]);
+		const __m128 A1 = _mm_set1_ps(T.EdgeA[1]);
+		const __m128 A2 = _mm_set1_ps(T.EdgeA[2]);
+		const __m128 ZA = _mm_set1_ps(T.ZA);
+		const __m128 WA = _mm_set1_ps(T.WA);
+		const __m128 StartX = _mm_add_ps(_mm_set1_ps(float(MinX)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+
+		for (int y = MinY; y <= MaxY; ++y)
+		{
+			const float PY = float(y) + 0.5f;
+			const __m128 Row0 = _mm_set1_ps(T.EdgeB[0] * PY + T.EdgeC[0]);
+			const __m128 Row1 = _mm_set1_ps(T.EdgeB[1] * PY + T.EdgeC[1]);
+			const __m128 Row2 = _mm_set1_ps(T.EdgeB[2] * PY + T.EdgeC[2]);
+			const __m128 RowZ = _mm_set1_ps(T.ZB * PY + T.ZC);
+			const __m128 RowW = _mm_set1_ps(T.WB * PY + T.WC);
+
+			float* DepthRow = Grid.GetDepthRow(y);
+			__m128 PX = StartX;
+			for (int x = MinX; x <= MaxX; x += 4, PX = _mm_add_ps(PX, Four))
+			{
+				const __m128 E0 = _mm_add_ps(_mm_mul_ps(A0, PX), Row0);
+				const __m128 E1 = _mm_add_ps(_mm_mul_ps(A1, PX), Row1);
+				const __m128 E2 = _mm_add_ps(_mm_mul_ps(A2, PX), Row2);
+				const __m128 Inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(E0, Zero), _mm_cmpge_ps(E1, Zero)), _mm_cmpge_ps(E2, Zero));
+				if (_mm_movemask_ps(Inside) == 0)
+				{
+					continue;
+				}
+
+				const __m128 ZOverW = _mm_add_ps(_mm_mul_ps(ZA, PX), RowZ);
+				const __m128 InvW = _mm_add_ps(_mm_mul_ps(WA, PX), RowW);
+				const __m128 Depth = _mm_min_ps(_mm_max_ps(_mm_div_ps(ZOverW, InvW), ZMin), ZMax);
+
+				const __m128 Old = _mm_loadu_ps(DepthRow + x);
+				const __m128 New = _mm_min_ps(Old, Depth);
+				_mm_storeu_ps(DepthRow + x, _mm_or_ps(_mm_and_ps(Inside, New), _mm_andnot_ps(Inside, Old)));
+			}
+		}
+	}
+}
 
 // 헬퍼: 뷰공간 Z → [0..1] 선형
 static inline float LinearizeZ01(float zView, float zNear, float zFar) {
@@ -28,8 +266,40 @@ static inline void MakeAabbCornersMinMax(const FAABB& B, FVector Corners[8])
 	Corners[7] = { mx.X, mx.Y, mx.Z };
 }
 
-bool FOcclusionCullingManagerCPU::ComputeRectAndMinZ(
-	const FCandidateDrawable& D, int /*ViewW*/, int /*ViewH*/, FOcclusionRect& OutR)
+void FOcclusionGrid::BuildHZB()
+{
+	BuildLevels.clear();
+	LevelWidths.clear();
+	BuildLevels.push_back(Depth); // level 0
+	LevelWidths.push_back(Width);
+
+	int W = Width, H = Height;
+	while (W > 1 || H > 1)
+	{
+		const int NW = (W + 1) >> 1;
+		const int NH = (H + 1) >> 1;
+		const TArray<float>& Prev = BuildLevels.back();
+		TArray<float> Next(size_t(NW * NH));
+
+		for (int y = 0; y < NH; ++y)
+		{
+			// 홀수 크기의 마지막 텍셀은 남은 한 줄/한 칸만 덮음
+			const float* Row0 = &Prev[size_t(2 * y) * W];
+			const float* Row1 = &Prev[size_t(std::min(2 * y + 1, H - 1)) * W];
+			for (int x = 0; x < NW; ++x)
+			{
+				const int x0 = 2 * x;
+				const int x1 = std::min(2 * x + 1, W - 1);
+				Next[size_t(y) * NW + x] = std::max(std::max(Row0[x0], Row0[x1]), std::max(Row1[x0], Row1[x1]));
+			}
+		}
+		BuildLevels.push_back(std::move(Next));
+		LevelWidths.push_back(NW);
+		W = NW; H = NH;
+	}
+}
+
+bool FOcclusionCullingManagerCPU::ComputeRectAndMinZ(const FCandidateDrawable& D, FOcclusionRect& OutR)
 {
 	FVector C[8];
 	MakeAabbCornersMinMax(D.Bound, C);
@@ -37,192 +307,221 @@ bool FOcclusionCullingManagerCPU::ComputeRectAndMinZ(
 	float MinX = +1e9f, MinY = +1e9f, MaxX = -1e9f, MaxY = -1e9f;
 	float MinZLin = +1e9f, MaxZLin = -1e9f; // ★ 선형 깊이(0..1)
 
-	int used = 0;
 	for (int i = 0; i < 8; i++)
 	{
 		const float p[4] = { C[i].X, C[i].Y, C[i].Z, 1.0f };
 
-		// 1) 화면 사각형용: WVP → NDC
+		// 깊이: WorldView로 뷰 공간 z
+		float v4[4];
+		MulPointRow(p, D.WorldView, v4);     // p_world * (World*View) == p_world * View (월드좌표니까 View만 와도 OK)
+		const float zView = v4[2];          // LH: +Z 앞
+
+		// 코너 하나라도 근평면 앞이면 화면 사각형이 뒤집히거나 잘려서 의미가 없음 → 판정하지 않음 (카메라가 박스 안에 있는 경우 포함)
+		if (zView < D.NearClip)
+		{
+			return false;
+		}
+
+		// 화면 사각형용: WVP → NDC
 		float c[4];
 		MulPointRow(p, D.WorldViewProj, c);
-		if (c[3] <= 0.0f) continue;
+		if (c[3] <= 0.0f)
+		{
+			return false;
+		}
 
 		const float invW = 1.0f / c[3];
-		const float ndcX = c[0] * invW;  // -1..1
-		const float ndcY = c[1] * invW;  // -1..1
-		// const float ndcZ = c[2] * invW; // 깊이는 쓰지 않음
-
-		const float u = 0.5f * (ndcX + 1.0f);
-		const float v = 0.5f * (ndcY + 1.0f);
+		const float u = 0.5f * (c[0] * invW + 1.0f);
+		const float v = 0.5f * (c[1] * invW + 1.0f);
 
 		MinX = std::min(MinX, u); MinY = std::min(MinY, v);
 		MaxX = std::max(MaxX, u); MaxY = std::max(MaxY, v);
 
-		// 2) 깊이: WorldView로 뷰 공간 z → 선형 0..1
-		float v4[4];
-		MulPointRow(p, D.WorldView, v4);     // p_world * (World*View) == p_world * View (월드좌표니까 View만 와도 OK)
-		const float zView = v4[2];          // LH: +Z 앞
 		const float zLin01 = LinearizeZ01(zView, D.NearClip, D.FarClip);
-
 		MinZLin = std::min(MinZLin, zLin01);
 		MaxZLin = std::max(MaxZLin, zLin01);
-
-		used++;
 	}
 
-	if (used == 0) return false;
+	// 화면 밖은 오클루전이 아니라 절두체 컬링 몫
 	if (MaxX < 0 || MaxY < 0 || MinX > 1 || MinY > 1) return false;
 
-	Clamp01(MinX); Clamp01(MinY); Clamp01(MaxX); Clamp01(MaxY);
-	Clamp01(MinZLin); Clamp01(MaxZLin);
-
-	OutR.MinX = MinX; OutR.MinY = MinY; OutR.MaxX = MaxX; OutR.MaxY = MaxY;
+	OutR.MinX = std::max(0.0f, MinX); OutR.MinY = std::max(0.0f, MinY);
+	OutR.MaxX = std::min(1.0f, MaxX); OutR.MaxY = std::min(1.0f, MaxY);
 	OutR.MinZ = MinZLin;   // ★ 선형 깊이
 	OutR.MaxZ = MaxZLin;
 	OutR.ActorIndex = D.ActorIndex;
 	return true;
 }
-void FOcclusionCullingManagerCPU::BuildOccluderDepth(
-	const TArray<FCandidateDrawable>& Occluders, int ViewW, int ViewH)
+
+void FOcclusionCullingManagerCPU::RasterizeOccluders(const TArray<FOccluderMesh>& Occluders, float NearClip, float FarClip)
 {
 	Grid.Clear();
+	Stats.Reset();
+	Stats.GridWidth = uint32(Grid.GetWidth());
+	Stats.GridHeight = uint32(Grid.GetHeight());
+	Stats.NumOccluders = uint32(Occluders.Num());
 
 	const int GW = Grid.GetWidth();
 	const int GH = Grid.GetHeight();
+	const float InvDepthRange = 1.0f / std::max(FarClip - NearClip, KINDA_SMALL_NUMBER);
 
-	// --- 튜닝 파라미터 ---
-	const float ErodeScale = 0.5f;     // 0.5배 축소
-	const int   Dilate = 1;        // 경계 1px 팽창
-	const int   MinPxEdge = 8;        // 너무 작은 사각형은 erosion 스킵
-	const float MaxCover = 0.6f;     // 화면의 60% 이상 덮으면 erosion 스킵
+	// --- 1. 셋업: 정점 변환, 트리비얼 거부, 근평면/가드 밴드 클리핑, 뒷면 제거, 변/깊이 평면 계산 ---
+	uint64 StartCycles = FPlatformTime::Cycles64();
 
-	for (const auto& D : Occluders)
+	TArray<FSetupJob> Jobs;
+	for (int32 OccluderIndex = 0; OccluderIndex < Occluders.Num(); ++OccluderIndex)
 	{
-		FOcclusionRect R;
-		if (!ComputeRectAndMinZ(D, ViewW, ViewH, R))
-			continue;
-
-		int minPX = (int)std::floor(R.MinX * GW);
-		int minPY = (int)std::floor(R.MinY * GH);
-		int maxPX = (int)std::ceil(R.MaxX * GW) - 1;
-		int maxPY = (int)std::ceil(R.MaxY * GH) - 1;
-
-		// --- 화면 사각형 erosion(오클루더 영향 완화) ---
-		int w = std::max(0, maxPX - minPX + 1);
-		int h = std::max(0, maxPY - minPY + 1);
-		const bool bigCover =
-			(w >= int(MaxCover * GW)) || (h >= int(MaxCover * GH));
-		if (ErodeScale < 1.0f && w >= MinPxEdge && h >= MinPxEdge && !bigCover)
-		{
-			const float cx = 0.5f * float(minPX + maxPX);
-			const float cy = 0.5f * float(minPY + maxPY);
-			const float hw = 0.5f * float(w) * ErodeScale;
-			const float hh = 0.5f * float(h) * ErodeScale;
-
-			minPX = int(std::floor(cx - hw));
-			maxPX = int(std::ceil(cx + hw));
-			minPY = int(std::floor(cy - hh));
-			maxPY = int(std::ceil(cy + hh));
+		const uint32 NumTriangles = Occluders[OccluderIndex].NumIndices / 3;
+		Stats.NumOccluderTriangles += NumTriangles;
+		for (uint32 First = 0; First < NumTriangles; First += SetupChunkTriangles)
+		{
+			Jobs.Add({ uint32(OccluderIndex), First, std::min(SetupChunkTriangles, NumTriangles - First), {} });
 		}
-
-
-		// 화면 경계 클램프
-		minPX = std::max(0, std::min(GW - 1, minPX));
-		minPY = std::max(0, std::min(GH - 1, minPY));
-		maxPX = std::max(0, std::min(GW - 1, maxPX));
-		maxPY = std::max(0, std::min(GH - 1, maxPY));
-		if (minPX > maxPX || minPY > maxPY) continue;
-
-		Grid.RasterizeRectDepthMin(minPX, minPY, maxPX, maxPY, R.MaxZ);
 	}
-}
-
-// 2) 후보 가시성 판정(HZB 샘플)
-void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>& Candidates, int ViewW, int ViewH, TArray<uint8_t>& OutVisibleFlags)
-{
-	const float eps = 2e-3f;  // 1차 바이어스
-	const float eps2 = 2 * eps;  // 레벨0 재검증 바이어스(조금 더 큼)
-	// --- 크기 보장 ---
-	uint32_t maxId = 0;
-	for (auto& c : Candidates) maxId = std::max(maxId, c.ActorIndex);
 
-	if (OutVisibleFlags.size() <= maxId) OutVisibleFlags.resize(maxId + 1, 1);
-	if (VisibleStreak.size() <= maxId) VisibleStreak.resize(maxId + 1, 0);
-	if (OccludedStreak.size() <= maxId) OccludedStreak.resize(maxId + 1, 0);
-	if (LastState.size() <= maxId) LastState.resize(maxId + 1, 1); // 초기=보임
-
-	for (const auto& D : Candidates)
+	ParallelFor(Jobs.Num(), [&](int32 JobIndex)
+		{
+			FSetupJob& Job = Jobs[JobIndex];
+			const FOccluderMesh& Mesh = Occluders[Job.OccluderIndex];
+			Job.Triangles.Reserve(Job.NumTriangles);
+
+			for (uint32 Tri = Job.FirstTriangle; Tri < Job.FirstTriangle + Job.NumTriangles; ++Tri)
+			{
+				const uint32* Idx = &Mesh.Indices[3 * Tri];
+				FClipVertex Poly[16] = {
+					TransformVertex(Mesh.Vertices[Idx[0]].pos, Mesh, NearClip, InvDepthRange),
+					TransformVertex(Mesh.Vertices[Idx[1]].pos, Mesh, NearClip, InvDepthRange),
+					TransformVertex(Mesh.Vertices[Idx[2]].pos, Mesh, NearClip, InvDepthRange) };
+
+				const uint32 Code0 = ComputeOutCode(Poly[0]);
+				const uint32 Code1 = ComputeOutCode(Poly[1]);
+				const uint32 Code2 = ComputeOutCode(Poly[2]);
+				if (Code0 & Code1 & Code2)
+				{
+					continue;	// 세 정점이 같은 평면 밖
+				}
+
+				int Count = 3;
+				if (Code0 | Code1 | Code2)
+				{
+					Count = ClipPolygon(Poly, Count);
+				}
+				for (int k = 1; k + 1 < Count; ++k)
+				{
+					EmitTriangle(Poly[0], Poly[k], Poly[k + 1], GW, GH, Job.Triangles);
+				}
+			}
+		});
+
+	// 타일 비닝 (작업 순서대로라 결과는 스레드 수와 무관)
+	const int NumTilesX = (GW + TileWidth - 1) / TileWidth;
+	const int NumTilesY = (GH + TileHeight - 1) / TileHeight;
+	TArray<TArray<const FRasterTriangle*>> TileBins(size_t(NumTilesX * NumTilesY));
+	for (const FSetupJob& Job : Jobs)
 	{
-		uint32_t id = D.ActorIndex;
-
-		FOcclusionRect R;
-		if (!ComputeRectAndMinZ(D, ViewW, ViewH, R))
-		{
-			// 화면 밖(또는 w<=0 코너만) → 가려짐으로 처리
-			OutVisibleFlags[id] = 0;
-			// streak 업데이트 (선택): occluded 누적
-			OccludedStreak[id] = std::min<uint8_t>(255, OccludedStreak[id] + 1);
-			VisibleStreak[id] = 0;
-			LastState[id] = 0;
-			continue;
-		}
-
-		const float rw = std::max(0.0f, R.MaxX - R.MinX);
-		const float rh = std::max(0.0f, R.MaxY - R.MinY);
-		const float pxW = rw * GetGrid().GetWidth();
-		const float pxH = rh * GetGrid().GetHeight();
-
-		// --- 작은 사각형 가드: 한 변이라도 2px 미만이면 컬링하지 않음 ---
-		if (std::min(pxW, pxH) < 2.0f)
+		Stats.NumRasterizedTriangles += uint32(Job.Triangles.Num());
+		for (const FRasterTriangle& T : Job.Triangles)
 		{
-			OutVisibleFlags[id] = 1;
-			VisibleStreak[id] = std::min<uint8_t>(255, VisibleStreak[id] + 1);
-			OccludedStreak[id] = 0;
-			LastState[id] = 1;
-			continue;
+			for (int ty = T.MinY / TileHeight; ty <= T.MaxY / TileHeight; ++ty)
+			{
+				for (int tx = T.MinX / TileWidth; tx <= T.MaxX / TileWidth; ++tx)
+				{
+					TileBins[size_t(ty * NumTilesX + tx)].Add(&T);
+				}
+			}
 		}
+	}
 
-		// --- 보수적 mip 선택 ---
-		int mip = std::max(0, Grid.ChooseMip(rw, rh) - 1);
-		if (pxW < 48.0f || pxH < 48.0f)
-			mip = std::max(0, mip - 1);
-
-
-		// --- MAX HZB 적응형 샘플 ---
-		const float hzbMax = Grid.SampleMaxRectAdaptive(R.MinX, R.MinY, R.MaxX, R.MaxY, mip);
+	uint64 EndCycles = FPlatformTime::Cycles64();
+	Stats.SetupTimeMS = float(FPlatformTime::ToMilliseconds(EndCycles - StartCycles));
 
-		bool occluded = ((hzbMax + eps) <= R.MinZ);
+	// --- 2. 타일 단위 병렬 래스터화 (타일끼리 픽셀이 겹치지 않으므로 동기화 없음) ---
+	StartCycles = EndCycles;
 
-		// --- 레벨0 정밀 재검증(occluded일 때만) ---
-		if (occluded)
+	ParallelFor(NumTilesX * NumTilesY, [&](int32 TileIndex)
 		{
-			if (!Grid.FullyOccludedAtLevel0(R.MinX, R.MinY, R.MaxX, R.MaxY, R.MinZ, eps2))
-				occluded = false;
-		}
+			const int TileMinX = (TileIndex % NumTilesX) * TileWidth;
+			const int TileMinY = (TileIndex / NumTilesX) * TileHeight;
+			const int TileMaxX = std::min(GW, TileMinX + TileWidth) - 1;
+			const int TileMaxY = std::min(GH, TileMinY + TileHeight) - 1;
+			for (const FRasterTriangle* T : TileBins[size_t(TileIndex)])
+			{
+				RasterizeTriangleInTile(*T, Grid, TileMinX, TileMinY, TileMaxX, TileMaxY);
+			}
+		});
+
+	Stats.RasterTimeMS = float(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+}
 
-		// --- 양방향 히스테리시스(2~3프레임 연속일 때만 상태 전환) ---
-		const int thresh = 2; // 2~3 추천
+void FOcclusionCullingManagerCPU::BuildHZB()
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Grid.BuildHZB();
+	Stats.HZBTimeMS = float(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+}
 
-		if (occluded)
-		{
-			OccludedStreak[id] = std::min<uint8_t>(255, OccludedStreak[id] + 1);
-			VisibleStreak[id] = 0;
+// 3) 후보 가시성 판정(HZB 샘플)
+// 깊이 버퍼가 이번 프레임 오클루더로 만들어지므로 프레임 간 히스테리시스 없이 매 프레임 독립 판정
+// (지연이 없어 다시 보이는 물체가 한 프레임 늦게 나타나는 팝핑이 없음)
+void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>& Candidates, TArray<uint8_t>& OutVisibleFlags)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
 
-			// 직전이 보임이면, thresh 미만 동안은 보임 유지
-			if (LastState[id] == 1 && OccludedStreak[id] < thresh)
-				occluded = false;
-		}
-		else
-		{
-			VisibleStreak[id] = std::min<uint8_t>(255, VisibleStreak[id] + 1);
-			OccludedStreak[id] = 0;
+	// --- 크기 보장 ---
+	uint32_t maxId = 0;
+	for (auto& c : Candidates) maxId = std::max(maxId, c.ActorIndex);
+	if (OutVisibleFlags.size() <= maxId) OutVisibleFlags.resize(maxId + 1, 1);
 
-			// 직전이 가려짐이면, thresh 미만 동안은 가려짐 유지
-			if (LastState[id] == 0 && VisibleStreak[id] < thresh)
-				occluded = true;
-		}
+	const int GW = Grid.GetWidth();
+	const int GH = Grid.GetHeight();
+	const int NumLevels = Grid.GetNumLevels();
+
+	// 0 = 보임, 1 = 가려짐, 2 = 판정 불가(보임)
+	TArray<uint8_t> Results(Candidates.size(), 2);
 
-		LastState[id] = occluded ? 0 : 1;
-		OutVisibleFlags[id] = occluded ? 0 : 1;
+	ParallelFor(Candidates.Num(), [&](int32 Index)
+		{
+			const FCandidateDrawable& D = Candidates[Index];
+			OutVisibleFlags[D.ActorIndex] = 1;
+
+			FOcclusionRect R;
+			if (NumLevels == 0 || !ComputeRectAndMinZ(D, R))
+			{
+				return;
+			}
+
+			// 사각형이 조금이라도 걸치는 레벨0 픽셀 전부
+			const int MinPX = std::clamp(int(std::floor(R.MinX * GW)), 0, GW - 1);
+			const int MinPY = std::clamp(int(std::floor(R.MinY * GH)), 0, GH - 1);
+			const int MaxPX = std::clamp(int(std::ceil(R.MaxX * GW)) - 1, MinPX, GW - 1);
+			const int MaxPY = std::clamp(int(std::ceil(R.MaxY * GH)) - 1, MinPY, GH - 1);
+
+			// 2x2 텍셀 안에 들어오는 가장 거친 레벨부터 → 실패하면 텍셀 한도 안에서 세밀한 레벨로
+			int Mip = 0;
+			while (Mip + 1 < NumLevels && Grid.CountTexels(MinPX, MinPY, MaxPX, MaxPY, Mip) > 4)
+			{
+				++Mip;
+			}
+
+			bool bOccluded = false;
+			for (; Mip >= 0 && Grid.CountTexels(MinPX, MinPY, MaxPX, MaxPY, Mip) <= MaxTestTexels; --Mip)
+			{
+				if (Grid.SampleMaxRect(MinPX, MinPY, MaxPX, MaxPY, Mip) + DepthBias <= R.MinZ)
+				{
+					bOccluded = true;
+					break;
+				}
+			}
+
+			Results[Index] = bOccluded ? 1 : 0;
+			OutVisibleFlags[D.ActorIndex] = bOccluded ? 0 : 1;
+		}, TestGrainSize);
+
+	for (uint8_t Result : Results)
+	{
+		Stats.NumTested += Result != 2 ? 1 : 0;
+		Stats.NumOccluded += Result == 1 ? 1 : 0;
 	}
-}
\ No newline at end of file
+	Stats.CalculateStats();
+	Stats.TestTimeMS = float(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+}
@@ -1,9 +1,11 @@
 ﻿#pragma once
+#include "OcclusionStats.h"
 
 struct FVector;
 struct FVector4;
 struct FMatrix; // row-major, p' = p * M 가정(네 컨벤션대로)
 struct FAABB; // AABB
+struct FNormalVertex;
 
 struct FCandidateDrawable
 {
@@ -15,6 +17,16 @@ struct FCandidateDrawable
     float    FarClip;         // ★ 추가
 };
 
+// 오클루더로 래스터화할 메시 한 개 (로컬 공간 삼각형, 정점 배열은 LOD끼리 공유)
+struct FOccluderMesh
+{
+    const FNormalVertex* Vertices = nullptr;
+    const uint32* Indices = nullptr;
+    uint32 NumIndices = 0;
+    FMatrix WorldViewProj;  // 로컬 → 클립 (화면 좌표)
+    FMatrix WorldView;      // 로컬 → 뷰 (선형 깊이)
+};
+
 // 교체 (MaxZ 추가)
 struct FOcclusionRect
 {
@@ -24,13 +36,15 @@ struct FOcclusionRect
     uint32_t ActorIndex;
 };
 
-// 저해상도 깊이맵 + HZB(min) - CPU 전용
+// 저해상도 깊이맵 + HZB(max) - CPU 전용
+// 깊이는 선형 0..1 (1 = Far, 아무것도 안 그려짐), 픽셀 (x, y)의 중심은 NDC ((x + 0.5) / W * 2 - 1, (y + 0.5) / H * 2 - 1)
 class FOcclusionGrid
 {
 public:
+    /** 래스터라이저가 SSE로 4픽셀씩 쓰므로 너비는 4의 배수로 올림 */
     void Initialize(int InWidth, int InHeight)
     {
-        Width = InWidth; Height = InHeight;
+        Width = (std::max(InWidth, 4) + 3) & ~3; Height = std::max(InHeight, 1);
         // 교체: 1.0f (Far)
         Depth.assign(size_t(Width * Height), 1.0f);
         BuildLevels.clear();
@@ -66,159 +80,55 @@ public:
         }
     }
 
-    void BuildHZB()
-    {
-        BuildLevels.clear();
-        BuildLevels.push_back(Depth); // level 0
+    /** 래스터라이저가 타일 단위로 직접 씀 (서로 다른 타일은 겹치지 않으므로 락 불필요) */
+    float* GetDepthRow(int Y) { return &Depth[size_t(Y) * Width]; }
 
-        int W = Width, H = Height;
-        while (W > 1 || H > 1)
-        {
-            int NW = std::max(1, W >> 1);
-            int NH = std::max(1, H >> 1);
-            TArray<float> Next(size_t(NW * NH), +FLT_MAX);
+    /**
+     * MAX 피라미드 (텍셀 = 아래 레벨 2x2의 최댓값)
+     * 크기는 올림으로 줄여 홀수 너비/높이의 마지막 줄도 빠지지 않게 함 (빠지면 그 줄에 가려진 물체가 잘못 컬링됨)
+     */
+    void BuildHZB();
 
-            for (int y = 0; y < NH; ++y)
-                for (int x = 0; x < NW; ++x)
-                {
-                    int sx = x * 2, sy = y * 2;
-                    float a = SampleSafe(BuildLevels.back(), W, H, sx + 0, sy + 0);
-                    float b = SampleSafe(BuildLevels.back(), W, H, sx + 1, sy + 0);
-                    float c = SampleSafe(BuildLevels.back(), W, H, sx + 0, sy + 1);
-                    float d = SampleSafe(BuildLevels.back(), W, H, sx + 1, sy + 1);
-                    Next[size_t(y) * NW + x] = std::max(std::max(a, b), std::max(c, d));
-                }
-            BuildLevels.push_back(std::move(Next));
-            W = NW; H = NH;
-        }
-    }
+    int GetNumLevels() const { return int(BuildLevels.size()); }
 
-    int ChooseMip(float RectW01, float RectH01) const
+    /** 레벨0 픽셀 사각형 [MinPX..MaxPX] x [MinPY..MaxPY]가 걸치는 Mip 레벨 텍셀 수 */
+    int CountTexels(int MinPX, int MinPY, int MaxPX, int MaxPY, int Mip) const
     {
-        float pxW = RectW01 * Width;
-        float pxH = RectH01 * Height;
-        float s = std::max(pxW, pxH);
-        int mip = int(std::floor(std::log2(std::max(1.0f, s))));
-        mip = std::max(0, std::min(mip, int(BuildLevels.size() - 1)));
-        return mip;
+        return ((MaxPX >> Mip) - (MinPX >> Mip) + 1) * ((MaxPY >> Mip) - (MinPY >> Mip) + 1);
     }
 
-    float SampleMaxRect(float MinX01, float MinY01, float MaxX01, float MaxY01, int Mip) const
+    /** 레벨0 픽셀 사각형이 걸치는 Mip 레벨 텍셀을 빠짐없이 읽은 최댓값 (보수적) */
+    float SampleMaxRect(int MinPX, int MinPY, int MaxPX, int MaxPY, int Mip) const
     {
         const TArray<float>& L = BuildLevels[size_t(Mip)];
-        int W = std::max(1, Width >> Mip);
-        int H = std::max(1, Height >> Mip);
-
-        auto ToPx = [&](float u, float v)->std::pair<int, int> {
-            int x = int(u * W + 0.5f);
-            int y = int(v * H + 0.5f);
-            x = std::max(0, std::min(W - 1, x));
-            y = std::max(0, std::min(H - 1, y));
-            return { x,y };
-            };
-        auto Smp = [&](float u, float v)->float {
-            auto [x, y] = ToPx(u, v);
-            return L[size_t(y) * W + x];
-            };
-
-        float cx = 0.5f * (MinX01 + MaxX01);
-        float cy = 0.5f * (MinY01 + MaxY01);
-
-        float s0 = Smp(cx, cy);
-        float s1 = Smp(MinX01, MinY01);
-        float s2 = Smp(MaxX01, MinY01);
-        float s3 = Smp(MinX01, MaxY01);
-        float s4 = Smp(MaxX01, MaxY01);
-
-        return std::max(s0, std::max(s1, std::max(s2, std::max(s3, s4)))); // ★ MAX
-    }
-    // FOcclusionGrid 내부에 추가
-    float SampleMaxRectAdaptive(float MinX01, float MinY01, float MaxX01, float MaxY01, int Mip) const
-    {
-        const TArray<float>& L = BuildLevels[size_t(Mip)];
-        const int W = std::max(1, Width >> Mip);
-        const int H = std::max(1, Height >> Mip);
-
-        auto ToPx = [&](float u, float v)->std::pair<int, int> {
-            int x = int(u * W + 0.5f);
-            int y = int(v * H + 0.5f);
-            x = std::max(0, std::min(W - 1, x));
-            y = std::max(0, std::min(H - 1, y));
-            return { x,y };
-            };
-        auto Smp = [&](float u, float v)->float {
-            auto [x, y] = ToPx(u, v);
-            return L[size_t(y) * W + x];
-            };
-
-        // 샘플 밀도: 화면 픽셀 크기에 비례 (최대 5x5)
-        const int grid = ((MaxX01 - MinX01) * Width + (MaxY01 - MinY01) * Height > 80) ? 5 :
-            ((MaxX01 - MinX01) * Width + (MaxY01 - MinY01) * Height > 30) ? 4 : 3;
+        const int W = LevelWidths[size_t(Mip)];
 
-        float best = 0.0f; // MAX 피라미드이므로 최댓값을 모음
-        for (int j = 0; j < grid; j++)
+        float MaxDepth = 0.0f;
+        for (int y = MinPY >> Mip; y <= (MaxPY >> Mip); ++y)
         {
-            float v = std::lerp(MinY01, MaxY01, (grid == 1) ? 0.5f : float(j) / (grid - 1));
-            for (int i = 0; i < grid; i++)
+            const float* Row = &L[size_t(y) * W];
+            for (int x = MinPX >> Mip; x <= (MaxPX >> Mip); ++x)
             {
-                float u = std::lerp(MinX01, MaxX01, (grid == 1) ? 0.5f : float(i) / (grid - 1));
-                best = std::max(best, Smp(u, v));
+                MaxDepth = std::max(MaxDepth, Row[x]);
             }
         }
-        return best;
+        return MaxDepth;
     }
-    // FOcclusionGrid 내부에 추가 (레벨0 정밀 검사)
-    bool FullyOccludedAtLevel0(float MinX01, float MinY01, float MaxX01, float MaxY01, float MinZ, float eps2) const
-    {
-        const TArray<float>& L0 = BuildLevels[0];
-        const int W = Width, H = Height;
-
-        int x0 = std::max(0, std::min(W - 1, int(MinX01 * W)));
-        int y0 = std::max(0, std::min(H - 1, int(MinY01 * H)));
-        int x1 = std::max(0, std::min(W - 1, int(MaxX01 * W)));
-        int y1 = std::max(0, std::min(H - 1, int(MaxY01 * H)));
 
-        // 너무 큰 박스는 샘플링 간격을 둠 (성능)
-        const int maxScan = 128 * 128; // 임계 픽셀수
-        int w = std::max(1, x1 - x0 + 1);
-        int h = std::max(1, y1 - y0 + 1);
-        int step = (w * h > maxScan) ? 2 : 1;
-
-        for (int y = y0; y <= y1; y += step)
-        {
-            const float* row = &L0[size_t(y) * W];
-            for (int x = x0; x <= x1; x += step)
-            {
-                float z = row[x];           // 레벨0의 MAX-기반 값(=멀리 기록한 것들의 min 축약 결과 아님!)
-                // 주의: 우리는 base에 'MaxZ를 min으로 누적'시켰고, HZB는 최대화했음.
-                // 레벨0에서도 보수성 유지: z + eps2 <= MinZ 일 때만 occluded 픽셀로 간주.
-                if (z + eps2 > MinZ)
-                    return false; // 한 픽셀이라도 덮여있지 않음 → 전체 가림 실패
-            }
-        }
-        return true; // 전부 덮임
-    }
     int GetWidth()  const { return Width; }
     int GetHeight() const { return Height; }
 
-
-private:
-    static float SampleSafe(const TArray<float>& L, int W, int H, int X, int Y)
-    {
-        X = std::max(0, std::min(W - 1, X));
-        Y = std::max(0, std::min(H - 1, Y));
-        return L[size_t(Y) * W + X];
-    }
-
 private:
     int Width = 0, Height = 0;
     TArray<float> Depth;                     // level 0
-    TArray<TArray<float>> BuildLevels;  // [0..N-1], min chain
-
-
+    TArray<TArray<float>> BuildLevels;  // [0..N-1], max chain
+    TArray<int> LevelWidths;
 };
 
 // CPU 오클루전 매니저
+// 1) 오클루더 삼각형 → 저해상도 깊이 (타일 단위 병렬, SSE 하프스페이스 래스터라이저)
+// 2) MAX HZB
+// 3) 오클루디 AABB의 가장 가까운 깊이를 사각형이 걸치는 HZB 텍셀 최댓값과 비교
 class FOcclusionCullingManagerCPU
 {
 public:
@@ -226,19 +136,21 @@ public:
     void Shutdown() {}
 
     // 1) 오클루더로 저해상도 Depth 채우기
-    void BuildOccluderDepth(const TArray<FCandidateDrawable>& Occluders, int ViewW, int ViewH);
+    void RasterizeOccluders(const TArray<FOccluderMesh>& Occluders, float NearClip, float FarClip);
 
     // 2) CPU HZB
-    void BuildHZB() { Grid.BuildHZB(); }
+    void BuildHZB();
 
-    // 3) 후보 가시성 판정
-    void TestOcclusion(const TArray<FCandidateDrawable>& Candidates, int ViewW, int ViewH, TArray<uint8_t>& OutVisibleFlags);
+    // 3) 후보 가시성 판정 (OutVisibleFlags[ActorIndex], 판정할 수 없는 후보는 보임)
+    void TestOcclusion(const TArray<FCandidateDrawable>& Candidates, TArray<uint8_t>& OutVisibleFlags);
 
     const FOcclusionGrid& GetGrid() const { return Grid; }
+    const FOcclusionStats& GetStats() const { return Stats; }
 
 private:
     // AABB(Min/Max) → 화면 사각형 + MinZ (★이제 MinZ는 '선형 깊이 0..1')
-    static bool ComputeRectAndMinZ(const FCandidateDrawable& D, int ViewW, int ViewH, FOcclusionRect& OutRect);
+    // 근평면에 걸치거나 화면 밖이면 false (판정 불가 → 보임)
+    static bool ComputeRectAndMinZ(const FCandidateDrawable& D, FOcclusionRect& OutRect);
 
     // 행벡터: Out = In(1x4) * M(4x4)
     static inline void MulPointRow(const float In[4], const FMatrix& M, float Out[4])
@@ -251,7 +163,5 @@ private:
 
 private:
     FOcclusionGrid Grid;
-    TArray<uint8_t> VisibleStreak;   // 연속 보임 프레임 수
-    TArray<uint8_t> OccludedStreak;  // 연속 가림 프레임 수
-    TArray<uint8_t> LastState;       // 0=occluded, 1=visible
-};
\ No newline at end of file
+    FOcclusionStats Stats;
+};
@@ -33,7 +33,8 @@ public:
 	void MarkDirty(AActor* Actor);
 	void MarkDirty(UPrimitiveComponent* Smc);
 
-	void Update(float DeltaTime, const uint32 BudgetCount = 256);
+	/** 더티 컴포넌트를 최대 BudgetCount개까지 모아 BVH에 한 번에 반영 (AABB 병렬 계산, refit/백그라운드 리빌드) */
+	void Update(float DeltaTime, const uint32 BudgetCount = 8192);
 
     //void RayQueryOrdered(FRay InRay, OUT TArray<std::pair<AActor*, float>>& Candidates);
     void RayQueryClosest(FRay InRay, OUT AActor*& OutActor, OUT float& OutBestT);
@@ -54,8 +55,9 @@ private:
 	void ClearSceneOctree();
 	void ClearBVHierarchy();
 	
-	TQueue<UPrimitiveComponent*> ComponentDirtyQueue; // 추가 혹은 갱신이 필요한 요소의 대기 큐
-	TSet<UPrimitiveComponent*> ComponentDirtySet;     // 더티 큐 중복 추가를 막기 위한 Set
+	TArray<UPrimitiveComponent*> ComponentDirtyList; // 추가 혹은 갱신이 필요한 요소 (등록 순서)
+	TFlatSet<UPrimitiveComponent*> ComponentDirtySet;     // 더티 목록 중복 추가를 막기 위한 Set
+	TArray<UPrimitiveComponent*> DirtyBatch;          // 이번 Update에서 BVH로 넘길 묶음 (재사용)
 	FOctree* SceneOctree = nullptr;
 	FBVHierarchy* BVH = nullptr;
 };
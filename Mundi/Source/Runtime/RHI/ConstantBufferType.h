@@ -247,7 +247,10 @@ struct FTileCullingBufferType
     uint32 bUseTileCulling;   // 타일 컬링 활성화 여부 (0=비활성화, 1=활성화)
     uint32 ViewportStartX;    // 뷰포트 시작 X 좌표
     uint32 ViewportStartY;    // 뷰포트 시작 Y 좌표
-    uint32 Padding[2];
+    uint32 ClusterSliceCount; // 0: 2D 타일, 그 외: 타일당 깊이 슬라이스 수 (클러스터 컬링)
+    float ClusterDepthScale;  // 슬라이스 = floor(log(뷰 깊이) * Scale + Bias)
+    float ClusterDepthBias;
+    uint32 Padding[3];
 };
 
 struct FPointLightShadowBufferType
@@ -275,6 +278,13 @@ struct FParticleEmitterType
     FVector Padding0;        // 16바이트 정렬
 };
 
+// b9: 자동 인스턴싱 드로우의 인스턴스 버퍼(t15) 시작 위치 (UberLit.hlsl USE_INSTANCING)
+struct FInstancingBufferType
+{
+    uint32 InstanceOffset;   // SV_InstanceID에 더할 값
+    FVector Padding0;        // 16바이트 정렬
+};
+
 #define CONSTANT_BUFFER_INFO(TYPE, SLOT, VS, PS) \
 constexpr uint32 TYPE##Slot = SLOT;\
 constexpr bool TYPE##IsVS = VS;\
@@ -303,7 +313,8 @@ MACRO(FViewportConstants)           \
 MACRO(FTileCullingBufferType)       \
 MACRO(FPointLightShadowBufferType)  \
 MACRO(FSubUVBufferType) \
-MACRO(FParticleEmitterType)
+MACRO(FParticleEmitterType)         \
+MACRO(FInstancingBufferType)
 
 // 16 바이트 패딩 어썰트
 #define STATIC_ASSERT_CBUFFER_ALIGNMENT(Type) \
@@ -334,6 +345,7 @@ CONSTANT_BUFFER_INFO(FTileCullingBufferType, 11, false, true)  // b11, PS only (
 CONSTANT_BUFFER_INFO(FPointLightShadowBufferType, 12, true, true)  // b12, VS+PS
 CONSTANT_BUFFER_INFO(FSubUVBufferType, 2, true, true)  // b2, VS+PS (ParticleSprite.hlsl용)
 CONSTANT_BUFFER_INFO(FParticleEmitterType, 3, true, false)  // b3, VS (ParticleSprite.hlsl용)
+CONSTANT_BUFFER_INFO(FInstancingBufferType, 9, true, false)  // b9, VS (UberLit.hlsl USE_INSTANCING)
 
 
 
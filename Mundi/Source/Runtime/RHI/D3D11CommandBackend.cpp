@@ -0,0 +1,129 @@
+﻿#include "pch.h"
+#include "D3D11CommandBackend.h"
+#include "ObjectConstantRing.h"
+
+// 기록 쪽(RHICommandList.h)은 D3D11RHI를 모르므로 재생 함수는 여기서 한 번에 만듦
+#define INSTANTIATE_CONSTANT_BUFFER_APPLY(TYPE) \
+template struct TRHIConstantBufferApply<TYPE>;
+CONSTANT_BUFFER_LIST(INSTANTIATE_CONSTANT_BUFFER_APPLY)
+
+FD3D11CommandBackend::FD3D11CommandBackend(D3D11RHI* InRHIDevice, FObjectConstantRing* InConstantRing)
+	: RHIDevice(InRHIDevice)
+	, ConstantRing(InConstantRing)
+{
+}
+
+void FD3D11CommandBackend::Execute(const FRHICommandList& CommandList)
+{
+	ID3D11DeviceContext* Context = RHIDevice->GetDeviceContext();
+
+	uint32 ConstantBaseBlock = 0;
+	bool bConstantBlocksUploaded = false;
+	bool bUsedConstantBlocks = false;
+	FObjectConstantDraw BoundConstants = FObjectConstantDraw::Unbound();
+	uint32 NumRingDraws = 0;
+
+	CommandList.ForEach([&](const FRHICommandHeader& Header, const void* Payload)
+	{
+		switch (Header.Type)
+		{
+		case ERHICommand::SetShaders:
+		{
+			const FRHICmdSetShaders& Cmd = *static_cast<const FRHICmdSetShaders*>(Payload);
+			Context->IASetInputLayout(Cmd.InputLayout);
+			Context->VSSetShader(Cmd.VertexShader, nullptr, 0);
+			Context->PSSetShader(Cmd.PixelShader, nullptr, 0);
+			break;
+		}
+		case ERHICommand::SetVertexBuffers:
+		{
+			const FRHICmdSetVertexBuffers& Cmd = *static_cast<const FRHICmdSetVertexBuffers*>(Payload);
+			Context->IASetVertexBuffers(0, Cmd.NumBuffers, Cmd.Buffers, Cmd.Strides, Cmd.Offsets);
+			break;
+		}
+		case ERHICommand::SetIndexBuffer:
+		{
+			const FRHICmdSetIndexBuffer& Cmd = *static_cast<const FRHICmdSetIndexBuffer*>(Payload);
+			Context->IASetIndexBuffer(Cmd.Buffer, Cmd.Format, 0);
+			break;
+		}
+		case ERHICommand::SetPrimitiveTopology:
+			Context->IASetPrimitiveTopology(static_cast<const FRHICmdSetPrimitiveTopology*>(Payload)->Topology);
+			break;
+		case ERHICommand::SetShaderResources:
+		{
+			const FRHICmdSetShaderResources& Cmd = *static_cast<const FRHICmdSetShaderResources*>(Payload);
+			if (Cmd.Stage == ERHIShaderStage::Vertex)
+			{
+				Context->VSSetShaderResources(Cmd.StartSlot, Cmd.NumViews, Cmd.Views);
+			}
+			else
+			{
+				Context->PSSetShaderResources(Cmd.StartSlot, Cmd.NumViews, Cmd.Views);
+			}
+			break;
+		}
+		case ERHICommand::SetSamplers:
+		{
+			const FRHICmdSetSamplers& Cmd = *static_cast<const FRHICmdSetSamplers*>(Payload);
+			if (Cmd.Stage == ERHIShaderStage::Vertex)
+			{
+				Context->VSSetSamplers(Cmd.StartSlot, Cmd.NumSamplers, Cmd.Samplers);
+			}
+			else
+			{
+				Context->PSSetSamplers(Cmd.StartSlot, Cmd.NumSamplers, Cmd.Samplers);
+			}
+			break;
+		}
+		case ERHICommand::UpdateConstantBuffer:
+		{
+			const FRHICmdUpdateConstantBuffer& Cmd = *static_cast<const FRHICmdUpdateConstantBuffer*>(Payload);
+			Cmd.Apply(*RHIDevice, FRHICommandList::GetConstantData(Cmd));
+			break;
+		}
+		case ERHICommand::UploadConstantBlocks:
+		{
+			const FRHICmdUploadConstantBlocks& Cmd = *static_cast<const FRHICmdUploadConstantBlocks*>(Payload);
+			bConstantBlocksUploaded = ConstantRing && ConstantRing->Upload(RHIDevice, Cmd.Blocks, Cmd.NumBlocks, ConstantBaseBlock);
+			BoundConstants = FObjectConstantDraw::Unbound();
+			break;
+		}
+		case ERHICommand::BindConstantBlocks:
+			// 업로드에 실패했으면(링 버퍼 생성/Map 실패) 바인딩을 건너뜀 - 기록 전에 IsSupported로 걸러지므로 드묾
+			if (bConstantBlocksUploaded)
+			{
+				ConstantRing->BindDraw(static_cast<const FRHICmdBindConstantBlocks*>(Payload)->Draw, ConstantBaseBlock, BoundConstants);
+				bUsedConstantBlocks = true;
+				++NumRingDraws;
+			}
+			break;
+		case ERHICommand::DrawIndexed:
+		{
+			const FRHICmdDrawIndexed& Cmd = *static_cast<const FRHICmdDrawIndexed*>(Payload);
+			Context->DrawIndexed(Cmd.IndexCount, Cmd.StartIndex, Cmd.BaseVertex);
+			break;
+		}
+		case ERHICommand::DrawIndexedInstanced:
+		{
+			const FRHICmdDrawIndexedInstanced& Cmd = *static_cast<const FRHICmdDrawIndexedInstanced*>(Payload);
+			Context->DrawIndexedInstanced(Cmd.IndexCount, Cmd.InstanceCount, Cmd.StartIndex, Cmd.BaseVertex, Cmd.StartInstance);
+			break;
+		}
+		case ERHICommand::DrawInstanced:
+		{
+			const FRHICmdDrawInstanced& Cmd = *static_cast<const FRHICmdDrawInstanced*>(Payload);
+			Context->DrawInstanced(Cmd.VertexCount, Cmd.InstanceCount, Cmd.StartVertex, Cmd.StartInstance);
+			break;
+		}
+		default:
+			break;
+		}
+	});
+
+	if (bUsedConstantBlocks)
+	{
+		ConstantRing->AddFrameDraws(NumRingDraws);
+		ConstantRing->RestoreDefaultBindings(RHIDevice);
+	}
+}
@@ -0,0 +1,30 @@
+﻿#pragma once
+#include "RHICommandList.h"
+#include "D3D11RHI.h"
+
+class FObjectConstantRing;
+
+// UpdateConstantBuffer 명령 재생 (CONSTANT_BUFFER_LIST 타입은 D3D11CommandBackend.cpp에서 명시적 인스턴스화)
+template<typename T>
+void TRHIConstantBufferApply<T>::Apply(D3D11RHI& RHIDevice, const void* Data)
+{
+	RHIDevice.SetAndUpdateConstantBuffer(*static_cast<const T*>(Data));
+}
+
+/**
+ * D3D11 백엔드: 명령 리스트를 즉시 컨텍스트에 그대로 재생
+ * - 상태 중복 제거는 기록 쪽에서 끝났으므로 여기서는 명령마다 API 호출 하나
+ * - 상수 블록 명령은 FObjectConstantRing으로 올리고(Map 1회) 드로우마다 오프셋만 바인딩
+ * - 블록을 쓴 리스트가 끝나면 b0/b2/b3/b9를 RHI 전용 상수 버퍼로 되돌림
+ */
+class FD3D11CommandBackend : public IRHICommandBackend
+{
+public:
+	FD3D11CommandBackend(D3D11RHI* InRHIDevice, FObjectConstantRing* InConstantRing);
+
+	void Execute(const FRHICommandList& CommandList) override;
+
+private:
+	D3D11RHI* RHIDevice;
+	FObjectConstantRing* ConstantRing;
+};
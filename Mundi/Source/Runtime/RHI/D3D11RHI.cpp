@@ -1,11 +1,27 @@
 ﻿#include "pch.h"
 #include "StatsOverlayD2D.h"
+#include <d3d11_4.h>
 #include "Color.h"
 
-void D3D11RHI::Initialize(HWND hWindow)
+void D3D11RHI::Initialize(HWND hWindow, bool bDeferredRecording)
 {
     // 이곳에서 Device, DeviceContext, viewport, swapchain를 초기화한다
     CreateDeviceAndSwapChain(hWindow);
+
+    ImmediateContext = DeviceContext;
+    if (bDeferredRecording)
+    {
+        if (SUCCEEDED(Device->CreateDeferredContext(0, &DeferredContext)))
+        {
+            DeviceContext = DeferredContext;
+        }
+        else
+        {
+            UE_LOG("[D3D11RHI] CreateDeferredContext failed, recording on the immediate context");
+            DeferredContext = nullptr;
+        }
+    }
+
     CreateFrameBuffer();
     CreateIdBuffer();
     CreateDOFResources();  // DOF 렌더 타겟 생성
@@ -18,7 +34,7 @@ void D3D11RHI::Initialize(HWND hWindow)
     UResourceManager::GetInstance().Initialize(Device,DeviceContext);
 
     // Initialize Direct2D overlay after device/swapchain ready
-    UStatsOverlayD2D::Get().Initialize(Device, DeviceContext, SwapChain);
+    UStatsOverlayD2D::Get().Initialize(Device, ImmediateContext, SwapChain);
 }
 
 void D3D11RHI::Release()
@@ -30,6 +46,20 @@ void D3D11RHI::Release()
     // Direct2D 오버레이를 먼저 정리하여 D3D 리소스에 대한 참조를 제거
     UStatsOverlayD2D::Get().Shutdown();
 
+    if (DeferredContext)
+    {
+        // 실행하지 않은 기록은 버리고 아래 정리는 즉시 컨텍스트에서
+        DeferredContext->ClearState();
+        ID3D11CommandList* Discarded = nullptr;
+        if (SUCCEEDED(DeferredContext->FinishCommandList(FALSE, &Discarded)) && Discarded)
+        {
+            Discarded->Release();
+        }
+        DeferredContext->Release();
+        DeferredContext = nullptr;
+        DeviceContext = ImmediateContext;
+    }
+
     if (DeviceContext)
     {
         // 파이프라인에서 바인딩된 상태/리소스를 명시적으로 해제
@@ -300,19 +330,44 @@ HRESULT D3D11RHI::CreateIndexBuffer(ID3D11Device* device, const FMeshData* meshD
     return device->CreateBuffer(&ibd, &iinitData, outBuffer);
 }
 
+namespace
+{
+    // LOD0 인덱스 뒤로 LOD1, LOD2... 인덱스를 이어붙인 배열 (MeshLOD::GetSectionRange와 같은 배치)
+    TArray<uint32> AppendLODIndices(const TArray<uint32>& BaseIndices, const TArray<FMeshLOD>& LODs)
+    {
+        size_t NumIndices = BaseIndices.size();
+        for (const FMeshLOD& LOD : LODs)
+        {
+            NumIndices += LOD.Indices.size();
+        }
+
+        TArray<uint32> Combined;
+        Combined.reserve(NumIndices);
+        Combined.insert(Combined.end(), BaseIndices.begin(), BaseIndices.end());
+        for (const FMeshLOD& LOD : LODs)
+        {
+            Combined.insert(Combined.end(), LOD.Indices.begin(), LOD.Indices.end());
+        }
+        return Combined;
+    }
+}
+
 HRESULT D3D11RHI::CreateIndexBuffer(ID3D11Device* device, const FStaticMesh* mesh, ID3D11Buffer** outBuffer)
 {
     if (!mesh || mesh->Indices.empty())
         return E_FAIL;
 
+    const TArray<uint32> Indices = mesh->LODs.empty() ? TArray<uint32>() : AppendLODIndices(mesh->Indices, mesh->LODs);
+    const TArray<uint32>& Uploaded = mesh->LODs.empty() ? mesh->Indices : Indices;
+
     D3D11_BUFFER_DESC ibd = {};
     ibd.Usage = D3D11_USAGE_DEFAULT;
-    ibd.ByteWidth = static_cast<UINT>(sizeof(uint32) * mesh->Indices.size());
+    ibd.ByteWidth = static_cast<UINT>(sizeof(uint32) * Uploaded.size());
     ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
     ibd.CPUAccessFlags = 0;
 
     D3D11_SUBRESOURCE_DATA iinitData = {};
-    iinitData.pSysMem = mesh->Indices.data();
+    iinitData.pSysMem = Uploaded.data();
 
     return device->CreateBuffer(&ibd, &iinitData, outBuffer);
 }
@@ -322,14 +377,17 @@ HRESULT D3D11RHI::CreateIndexBuffer(ID3D11Device* Device, const FSkeletalMeshDat
     if (!Mesh || Mesh->Indices.empty())
         return E_FAIL;
 
+    const TArray<uint32> Indices = Mesh->LODs.empty() ? TArray<uint32>() : AppendLODIndices(Mesh->Indices, Mesh->LODs);
+    const TArray<uint32>& Uploaded = Mesh->LODs.empty() ? Mesh->Indices : Indices;
+
     D3D11_BUFFER_DESC IndexBufferDesc = {};
     IndexBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-    IndexBufferDesc.ByteWidth = static_cast<UINT>(sizeof(uint32) * Mesh->Indices.size());
+    IndexBufferDesc.ByteWidth = static_cast<UINT>(sizeof(uint32) * Uploaded.size());
     IndexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
     IndexBufferDesc.CPUAccessFlags = 0;
 
     D3D11_SUBRESOURCE_DATA InitData = {};
-    InitData.pSysMem = Mesh->Indices.data();
+    InitData.pSysMem = Uploaded.data();
 
     return Device->CreateBuffer(&IndexBufferDesc, &InitData, OutBuffer);
 }
@@ -522,9 +580,58 @@ void D3D11RHI::Present()
 {
     // Draw any Direct2D overlays before present
     UStatsOverlayD2D::Get().Draw();
+    PresentSwapChain();
+}
+
+void D3D11RHI::PresentSwapChain()
+{
     SwapChain->Present(0, 0); // vsync on
 }
 
+ID3D11CommandList* D3D11RHI::FinishRecording()
+{
+    if (!DeferredContext)
+    {
+        return nullptr;
+    }
+
+    ID3D11CommandList* CommandList = nullptr;
+    if (FAILED(DeferredContext->FinishCommandList(TRUE, &CommandList)))
+    {
+        UE_LOG("[D3D11RHI] FinishCommandList failed");
+        return nullptr;
+    }
+    ++NumFinishedRecordings;
+    return CommandList;
+}
+
+void D3D11RHI::ExecuteRecording(ID3D11CommandList* CommandList)
+{
+    if (!CommandList)
+    {
+        return;
+    }
+
+    // 실행 뒤 즉시 컨텍스트는 기본 상태로 (이후에는 D2D 오버레이와 Present만 씀)
+    ImmediateContext->ExecuteCommandList(CommandList, FALSE);
+    CommandList->Release();
+}
+
+void D3D11RHI::SetMultithreadProtected(bool bProtected)
+{
+    if (!ImmediateContext)
+    {
+        return;
+    }
+
+    ID3D11Multithread* Multithread = nullptr;
+    if (SUCCEEDED(ImmediateContext->QueryInterface(__uuidof(ID3D11Multithread), reinterpret_cast<void**>(&Multithread))))
+    {
+        Multithread->SetMultithreadProtected(bProtected ? TRUE : FALSE);
+        Multithread->Release();
+    }
+}
+
 void D3D11RHI::CreateDeviceAndSwapChain(HWND hWindow)
 {
     // 지원하는 Direct3D 기능 레벨을 정의
@@ -833,6 +940,7 @@ void D3D11RHI::UpdateUVScrollConstantBuffers(const FVector2D& Speed, float TimeS
     D3D11_MAPPED_SUBRESOURCE mapped;
     if (SUCCEEDED(DeviceContext->Map(UVScrollCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
     {
+        CountBufferMap();
         memcpy(mapped.pData, &data, sizeof(data));
         DeviceContext->Unmap(UVScrollCB, 0);
         DeviceContext->PSSetConstantBuffers(5, 1, &UVScrollCB);
@@ -1036,6 +1144,7 @@ void D3D11RHI::ReleaseDeviceAndSwapChain()
         DeviceContext->Release();
         DeviceContext = nullptr;
     }
+    ImmediateContext = nullptr;
 
     // VRAM Leak 디버깅용 함수
     // DXGI 누출 로그 출력 시 주석 해제로 타입 확인 가능
@@ -1119,13 +1228,17 @@ void D3D11RHI::OnResize(UINT NewWidth, UINT NewHeight)
     if (!SwapChain) return;
 
     // 렌더링 완료까지 대기 (중요!)
-    if (DeviceContext) {
-        DeviceContext->Flush();
+    // 렌더 스레드 모드에서는 호출 전에 렌더 스레드를 비워 둬야 함 (UGameEngine이 프레임 시작 때 처리)
+    if (ImmediateContext) {
+        ImmediateContext->Flush();
     }
 
-    // 현재 렌더 타겟 언바인딩
-    if (DeviceContext) {
-        DeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
+    // 현재 렌더 타겟 언바인딩 (지연 컨텍스트에 남은 바인딩도 백버퍼를 잡고 있음)
+    if (ImmediateContext) {
+        ImmediateContext->OMSetRenderTargets(0, nullptr, nullptr);
+    }
+    if (DeferredContext) {
+        DeferredContext->OMSetRenderTargets(0, nullptr, nullptr);
     }
 
 
@@ -1467,6 +1580,7 @@ void D3D11RHI::UpdateStructuredBuffer(ID3D11Buffer* InBuffer, const void* InData
     HRESULT hr = DeviceContext->Map(InBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
     if (SUCCEEDED(hr))
     {
+        CountBufferMap();
         memcpy(mappedResource.pData, InData, InDataSize);
         DeviceContext->Unmap(InBuffer, 0);
     }
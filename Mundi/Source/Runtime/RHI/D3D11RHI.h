@@ -53,7 +53,10 @@ public:
 
 
 public:
-	void Initialize(HWND hWindow);
+	// bDeferredRecording: 렌더 스레드 모드 (UGameEngine). GetDeviceContext()가 지연 컨텍스트를 돌려줘
+	// 게임 스레드의 모든 렌더링 명령이 명령 리스트로 기록되고, 즉시 컨텍스트는 렌더 스레드만 씀
+	// 리소스 매니저/상수 링이 초기화 때 GetDeviceContext()를 캐시하므로 시작할 때 정해야 함
+	void Initialize(HWND hWindow, bool bDeferredRecording = false);
 
 	void Release();
 
@@ -100,6 +103,7 @@ public:
 
 		D3D11_MAPPED_SUBRESOURCE MSR;
 		DeviceContext->Map(VertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MSR);
+		CountBufferMap();
 
 		const size_t DataSizeInBytes = Data.size() * sizeof(TVertex);
 		memcpy(MSR.pData, Data.data(), DataSizeInBytes);
@@ -112,6 +116,7 @@ public:
 		D3D11_MAPPED_SUBRESOURCE MSR;
 
 		DeviceContext->Map(ConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &MSR);
+		CountBufferMap();
 		memcpy(MSR.pData, &Data, sizeof(T));
 		DeviceContext->Unmap(ConstantBuffer, 0);
 	}
@@ -123,6 +128,11 @@ public:
 		
 	}
 	void ConstantBufferSet(ID3D11Buffer* ConstantBuffer, uint32 Slot, bool bIsVS, bool bIsPS);
+
+	// 프레임당 버퍼 Map 호출 수 (RHI를 거친 업로드만, URenderer::EndFrame에서 확정 후 초기화)
+	void CountBufferMap() { ++FrameBufferMapCount; }
+	uint32 GetFrameBufferMapCount() const { return FrameBufferMapCount; }
+	void ResetFrameBufferMapCount() { FrameBufferMapCount = 0; }
     void UpdateUVScrollConstantBuffers(const FVector2D& Speed, float TimeSec);
 	
 	void IASetPrimitiveTopology();
@@ -134,7 +144,23 @@ public:
 	void PSSetClampSampler(UINT StartSlot);
 
 	void DrawFullScreenQuad();
+	// D2D 통계 오버레이 + 스왑 체인 Present
 	void Present();
+	// 스왑 체인 Present만 (렌더 스레드 모드에서는 렌더 스레드가 오버레이를 따로 그린 뒤 호출)
+	void PresentSwapChain();
+
+	// 지연 기록 (Initialize의 bDeferredRecording)
+	bool IsDeferredRecording() const { return DeferredContext != nullptr; }
+	// [게임 스레드] 지금까지 지연 컨텍스트에 기록한 명령을 닫아 명령 리스트로 (지연 기록이 아니면 nullptr)
+	// 지연 컨텍스트의 파이프라인 상태는 그대로 이어지므로 다음 프레임 기록도 직렬 모드와 같은 상태에서 시작
+	ID3D11CommandList* FinishRecording();
+	// [렌더 스레드] FinishRecording 결과를 즉시 컨텍스트에서 실행하고 해제
+	void ExecuteRecording(ID3D11CommandList* CommandList);
+	// 지금까지 닫은 명령 리스트 수 (지연 컨텍스트의 동적 버퍼는 명령 리스트마다 첫 Map이 DISCARD여야 함)
+	uint64 GetNumFinishedRecordings() const { return NumFinishedRecordings; }
+
+	// 즉시 컨텍스트 호출을 장치 내부 락으로 직렬화 (두 스레드가 즉시 컨텍스트에 닿을 수 있을 때 안전망)
+	void SetMultithreadProtected(bool bProtected);
 
 	// Overlay precedence helpers
 	void OMSetDepthStencilState_OverlayWriteStencil();
@@ -218,10 +244,15 @@ public:
 	{
 		return Device;
 	}
+	// 렌더링 명령을 기록하는 컨텍스트 (지연 기록 중이면 지연 컨텍스트)
 	inline ID3D11DeviceContext* GetDeviceContext()
 	{
 		return DeviceContext;
 	}
+	inline ID3D11DeviceContext* GetImmediateContext()
+	{
+		return ImmediateContext;
+	}
 	inline IDXGISwapChain* GetSwapChain()
 	{
 		return SwapChain;
@@ -264,7 +295,9 @@ private:
 
 	//8
 	ID3D11Device* Device{};//
-	ID3D11DeviceContext* DeviceContext{};//
+	ID3D11DeviceContext* DeviceContext{};// 기록용 (ImmediateContext 또는 DeferredContext)
+	ID3D11DeviceContext* ImmediateContext{};//
+	ID3D11DeviceContext* DeferredContext{};// 지연 기록일 때만
 	IDXGISwapChain* SwapChain{};//
 
 	ID3D11RasterizerState* DefaultRasterizerState{};//
@@ -327,6 +360,9 @@ private:
 
 	UShader* PreShader = nullptr; // Shaders, Inputlayout
 
+	uint32 FrameBufferMapCount = 0;
+	uint64 NumFinishedRecordings = 0;
+
 	bool bReleased = false; // Prevent double Release() calls
 };
 
@@ -496,4 +532,30 @@ template<>
 inline HRESULT D3D11RHI::CreateVertexBuffer<FSkinnedVertex>(ID3D11Device* Device, const std::vector<FSkinnedVertex>& SrcVertices, ID3D11Buffer** OutBuffer)
 {
 	return CreateVertexBufferImpl<FSkinnedVertex>(Device, SrcVertices, OutBuffer, D3D11_USAGE_DEFAULT, 0);
-}
\ No newline at end of file
+}
+
+// 압축 정점 포맷 (PackedVertex::IsEnabled())
+template<>
+inline HRESULT D3D11RHI::CreateVertexBuffer<FPackedVertex>(ID3D11Device* Device, const FMeshData& Mesh, ID3D11Buffer** OutBuffer)
+{
+	return CreateVertexBufferImpl<FPackedVertex>(Device, Mesh, OutBuffer, D3D11_USAGE_DEFAULT, 0);
+}
+
+template<>
+inline HRESULT D3D11RHI::CreateVertexBuffer<FPackedVertex>(ID3D11Device* Device, const std::vector<FNormalVertex>& SrcVertices, ID3D11Buffer** OutBuffer)
+{
+	return CreateVertexBufferImpl<FPackedVertex>(Device, SrcVertices, OutBuffer, D3D11_USAGE_DEFAULT, 0);
+}
+
+// CPU 스키닝 결과를 매 프레임 덮어쓰므로 Dynamic
+template<>
+inline HRESULT D3D11RHI::CreateVertexBuffer<FPackedVertex>(ID3D11Device* Device, const std::vector<FSkinnedVertex>& SrcVertices, ID3D11Buffer** OutBuffer)
+{
+	return CreateVertexBufferImpl<FPackedVertex>(Device, SrcVertices, OutBuffer, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
+}
+
+template<>
+inline HRESULT D3D11RHI::CreateVertexBuffer<FPackedSkinnedVertex>(ID3D11Device* Device, const std::vector<FSkinnedVertex>& SrcVertices, ID3D11Buffer** OutBuffer)
+{
+	return CreateVertexBufferImpl<FPackedSkinnedVertex>(Device, SrcVertices, OutBuffer, D3D11_USAGE_DEFAULT, 0);
+}
@@ -1,8 +1,9 @@
 ﻿#include "pch.h"
 #include "PipelineStateObject.h"
+#include "PackedVertex.h"
 
 PipeLineStateObject::PipeLineStateObject(ID3D11Buffer* InVertexBuffer, ID3D11Buffer* InIndexBuffer, ID3D11ShaderResourceView* InSRV)
-	: Stride(sizeof(FVertexDynamic))
+	: Stride(PackedVertex::GetStaticVertexStride())
 	, Offset(0)
 	, VertexBuffer(InVertexBuffer)
 	, IndexBuffer(InIndexBuffer)
@@ -0,0 +1,142 @@
+﻿#include "pch.h"
+#include "RHICommandList.h"
+
+void FNullCommandBackend::Execute(const FRHICommandList& CommandList)
+{
+	// 리스트마다 바인딩 상태를 새로 추적 (D3D11 백엔드도 리스트 사이 상태를 가정하지 않음)
+	bool bVertexShaderBound = false;
+	bool bVertexBufferBound = false;
+	bool bIndexBufferBound = false;
+	uint32 NumUploadedBlocks = 0;
+	bool bBlocksUploaded = false;
+
+	int32 CommandIndex = 0;
+	CommandList.ForEach([&](const FRHICommandHeader& Header, const void* Payload)
+	{
+		++Stats.NumCommands;
+		++Stats.NumCommandsByType[static_cast<uint32>(Header.Type)];
+
+		switch (Header.Type)
+		{
+		case ERHICommand::SetShaders:
+		{
+			const FRHICmdSetShaders& Cmd = *static_cast<const FRHICmdSetShaders*>(Payload);
+			bVertexShaderBound = Cmd.VertexShader != nullptr;
+			break;
+		}
+		case ERHICommand::SetVertexBuffers:
+		{
+			const FRHICmdSetVertexBuffers& Cmd = *static_cast<const FRHICmdSetVertexBuffers*>(Payload);
+			if (Cmd.NumBuffers == 0 || Cmd.NumBuffers > FRHICmdSetVertexBuffers::MaxBuffers)
+			{
+				AddError("SetVertexBuffers: invalid buffer count", CommandIndex);
+			}
+			bVertexBufferBound = Cmd.NumBuffers > 0 && Cmd.Buffers[0] != nullptr;
+			break;
+		}
+		case ERHICommand::SetIndexBuffer:
+		{
+			const FRHICmdSetIndexBuffer& Cmd = *static_cast<const FRHICmdSetIndexBuffer*>(Payload);
+			bIndexBufferBound = Cmd.Buffer != nullptr;
+			break;
+		}
+		case ERHICommand::UpdateConstantBuffer:
+		{
+			const FRHICmdUpdateConstantBuffer& Cmd = *static_cast<const FRHICmdUpdateConstantBuffer*>(Payload);
+			if (!Cmd.Apply || Cmd.DataSize == 0)
+			{
+				AddError("UpdateConstantBuffer: missing data", CommandIndex);
+			}
+			++Stats.NumConstantBufferUpdates;
+			break;
+		}
+		case ERHICommand::UploadConstantBlocks:
+		{
+			const FRHICmdUploadConstantBlocks& Cmd = *static_cast<const FRHICmdUploadConstantBlocks*>(Payload);
+			if (!Cmd.Blocks || Cmd.NumBlocks == 0)
+			{
+				AddError("UploadConstantBlocks: empty upload", CommandIndex);
+			}
+			NumUploadedBlocks = Cmd.NumBlocks;
+			bBlocksUploaded = true;
+			++Stats.NumConstantBlockUploads;
+			break;
+		}
+		case ERHICommand::BindConstantBlocks:
+		{
+			const FObjectConstantDraw& Draw = static_cast<const FRHICmdBindConstantBlocks*>(Payload)->Draw;
+			if (!bBlocksUploaded)
+			{
+				AddError("BindConstantBlocks: no blocks uploaded", CommandIndex);
+				break;
+			}
+			for (uint32 Block : { Draw.Model, Draw.Color, Draw.SubUV, Draw.Emitter, Draw.Instancing })
+			{
+				if (Block != FObjectConstantDraw::None && Block >= NumUploadedBlocks)
+				{
+					AddError("BindConstantBlocks: block out of range", CommandIndex);
+					break;
+				}
+			}
+			break;
+		}
+		case ERHICommand::DrawIndexed:
+		{
+			const FRHICmdDrawIndexed& Cmd = *static_cast<const FRHICmdDrawIndexed*>(Payload);
+			if (!bVertexShaderBound || !bVertexBufferBound || !bIndexBufferBound)
+			{
+				AddError("DrawIndexed: missing shader or buffers", CommandIndex);
+			}
+			if (Cmd.IndexCount == 0)
+			{
+				AddError("DrawIndexed: zero indices", CommandIndex);
+			}
+			++Stats.NumDraws;
+			Stats.NumIndices += Cmd.IndexCount;
+			break;
+		}
+		case ERHICommand::DrawIndexedInstanced:
+		{
+			const FRHICmdDrawIndexedInstanced& Cmd = *static_cast<const FRHICmdDrawIndexedInstanced*>(Payload);
+			if (!bVertexShaderBound || !bVertexBufferBound || !bIndexBufferBound)
+			{
+				AddError("DrawIndexedInstanced: missing shader or buffers", CommandIndex);
+			}
+			if (Cmd.IndexCount == 0 || Cmd.InstanceCount == 0)
+			{
+				AddError("DrawIndexedInstanced: zero indices or instances", CommandIndex);
+			}
+			++Stats.NumDraws;
+			Stats.NumIndices += uint64(Cmd.IndexCount) * Cmd.InstanceCount;
+			break;
+		}
+		case ERHICommand::DrawInstanced:
+		{
+			const FRHICmdDrawInstanced& Cmd = *static_cast<const FRHICmdDrawInstanced*>(Payload);
+			if (!bVertexShaderBound)
+			{
+				AddError("DrawInstanced: missing shader", CommandIndex);
+			}
+			if (Cmd.VertexCount == 0 || Cmd.InstanceCount == 0)
+			{
+				AddError("DrawInstanced: zero vertices or instances", CommandIndex);
+			}
+			++Stats.NumDraws;
+			Stats.NumIndices += uint64(Cmd.VertexCount) * Cmd.InstanceCount;
+			break;
+		}
+		default:
+			break;
+		}
+		++CommandIndex;
+	});
+}
+
+void FNullCommandBackend::AddError(const char* Message, int32 CommandIndex)
+{
+	if (Stats.NumValidationErrors == 0)
+	{
+		Stats.FirstError = FString(Message) + " (command " + std::to_string(CommandIndex) + ")";
+	}
+	++Stats.NumValidationErrors;
+}
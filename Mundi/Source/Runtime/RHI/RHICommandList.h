@@ -0,0 +1,357 @@
+﻿#pragma once
+#include "ObjectConstantPacker.h"
+
+class D3D11RHI;
+
+// 렌더 명령 종류 (FRHICommandList에 기록되고 IRHICommandBackend가 재생)
+enum class ERHICommand : uint8
+{
+	SetShaders,
+	SetVertexBuffers,
+	SetIndexBuffer,
+	SetPrimitiveTopology,
+	SetShaderResources,
+	SetSamplers,
+	UpdateConstantBuffer,	// 타입이 정해진 RHI 상수 버퍼 (D3D11RHI::SetAndUpdateConstantBuffer)
+	UploadConstantBlocks,	// FObjectConstantPacker 블록을 상수 링에 올림
+	BindConstantBlocks,		// 마지막으로 올린 블록 기준 드로우별 상수 바인딩
+	DrawIndexed,
+	DrawIndexedInstanced,
+	DrawInstanced,
+
+	Count
+};
+
+enum class ERHIShaderStage : uint8
+{
+	Vertex,
+	Pixel,
+};
+
+struct FRHICommandHeader
+{
+	ERHICommand Type;
+	uint8 Padding = 0;
+	uint16 Size = 0;	// 헤더 포함 바이트 (다음 명령까지의 거리)
+	uint32 Padding1 = 0;
+};
+static_assert(sizeof(FRHICommandHeader) == 8, "Commands are 8-byte aligned");
+
+// --- 명령 페이로드 (헤더 바로 뒤에 그대로 복사되는 POD) ---
+
+struct FRHICmdSetShaders
+{
+	ID3D11VertexShader* VertexShader;
+	ID3D11PixelShader* PixelShader;
+	ID3D11InputLayout* InputLayout;
+};
+
+struct FRHICmdSetVertexBuffers
+{
+	static constexpr uint32 MaxBuffers = 2;		// 0 = 메시, 1 = 인스턴스
+	ID3D11Buffer* Buffers[MaxBuffers];
+	uint32 Strides[MaxBuffers];
+	uint32 Offsets[MaxBuffers];
+	uint32 NumBuffers;
+};
+
+struct FRHICmdSetIndexBuffer
+{
+	ID3D11Buffer* Buffer;
+	DXGI_FORMAT Format;
+};
+
+struct FRHICmdSetPrimitiveTopology
+{
+	D3D11_PRIMITIVE_TOPOLOGY Topology;
+};
+
+struct FRHICmdSetShaderResources
+{
+	static constexpr uint32 MaxViews = 4;
+	ID3D11ShaderResourceView* Views[MaxViews];
+	ERHIShaderStage Stage;
+	uint8 StartSlot;
+	uint8 NumViews;
+};
+
+struct FRHICmdSetSamplers
+{
+	static constexpr uint32 MaxSamplers = 4;
+	ID3D11SamplerState* Samplers[MaxSamplers];
+	ERHIShaderStage Stage;
+	uint8 StartSlot;
+	uint8 NumSamplers;
+};
+
+// 상수 데이터는 페이로드 뒤에 이어서 기록
+using FRHIConstantBufferApplyFunc = void(*)(D3D11RHI& RHIDevice, const void* Data);
+struct FRHICmdUpdateConstantBuffer
+{
+	FRHIConstantBufferApplyFunc Apply;
+	uint32 DataSize;
+};
+
+// D3D11 백엔드에서 정의 (D3D11CommandBackend.h) - 기록하는 쪽은 타입만 알면 됨
+template<typename T>
+struct TRHIConstantBufferApply
+{
+	static void Apply(D3D11RHI& RHIDevice, const void* Data);
+};
+
+// 블록 배열은 재생이 끝날 때까지 살아 있어야 함 (FMeshPassRecording이 명령 리스트와 함께 소유)
+struct FRHICmdUploadConstantBlocks
+{
+	const FObjectConstantBlock* Blocks;
+	uint32 NumBlocks;
+};
+
+struct FRHICmdBindConstantBlocks
+{
+	FObjectConstantDraw Draw;	// 마지막 UploadConstantBlocks 기준 블록 번호
+};
+
+struct FRHICmdDrawIndexed
+{
+	uint32 IndexCount;
+	uint32 StartIndex;
+	int32 BaseVertex;
+};
+
+struct FRHICmdDrawIndexedInstanced
+{
+	uint32 IndexCount;
+	uint32 InstanceCount;
+	uint32 StartIndex;
+	int32 BaseVertex;
+	uint32 StartInstance;
+};
+
+struct FRHICmdDrawInstanced
+{
+	uint32 VertexCount;
+	uint32 InstanceCount;
+	uint32 StartVertex;
+	uint32 StartInstance;
+};
+
+/**
+ * 렌더 명령 리스트
+ * - 패스가 상태 설정/버퍼 바인딩/상수 업데이트/드로우를 바이트 배열 하나에 순서대로 기록하고 백엔드가 재생
+ * - 기록은 D3D를 호출하지 않으므로 서로 다른 리스트는 여러 스레드에서 동시에 기록 가능
+ * - Reset은 용량을 유지하므로 프레임마다 같은 리스트를 재사용하면 할당이 없음
+ */
+class FRHICommandList
+{
+public:
+	void Reset()
+	{
+		NumBytes = 0;
+		NumCommands = 0;
+	}
+
+	void Reserve(uint32 Bytes) { Words.reserve((Bytes + 7) / 8); }
+
+	int32 Num() const { return NumCommands; }
+	bool IsEmpty() const { return NumCommands == 0; }
+	uint32 GetSizeBytes() const { return static_cast<uint32>(NumBytes); }
+
+	// --- 기록 ---
+	void SetShaders(ID3D11VertexShader* VertexShader, ID3D11PixelShader* PixelShader, ID3D11InputLayout* InputLayout)
+	{
+		Record(ERHICommand::SetShaders, FRHICmdSetShaders{ VertexShader, PixelShader, InputLayout });
+	}
+
+	void SetVertexBuffer(ID3D11Buffer* Buffer, uint32 Stride, uint32 Offset = 0)
+	{
+		FRHICmdSetVertexBuffers Cmd{};
+		Cmd.Buffers[0] = Buffer;
+		Cmd.Strides[0] = Stride;
+		Cmd.Offsets[0] = Offset;
+		Cmd.NumBuffers = 1;
+		Record(ERHICommand::SetVertexBuffers, Cmd);
+	}
+
+	void SetVertexBuffers(const FRHICmdSetVertexBuffers& Cmd)
+	{
+		Record(ERHICommand::SetVertexBuffers, Cmd);
+	}
+
+	void SetIndexBuffer(ID3D11Buffer* Buffer, DXGI_FORMAT Format)
+	{
+		Record(ERHICommand::SetIndexBuffer, FRHICmdSetIndexBuffer{ Buffer, Format });
+	}
+
+	void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology)
+	{
+		Record(ERHICommand::SetPrimitiveTopology, FRHICmdSetPrimitiveTopology{ Topology });
+	}
+
+	void SetShaderResources(ERHIShaderStage Stage, uint32 StartSlot, uint32 NumViews, ID3D11ShaderResourceView* const* Views)
+	{
+		FRHICmdSetShaderResources Cmd{};
+		Cmd.Stage = Stage;
+		Cmd.StartSlot = static_cast<uint8>(StartSlot);
+		Cmd.NumViews = static_cast<uint8>(std::min(NumViews, FRHICmdSetShaderResources::MaxViews));
+		for (uint32 Index = 0; Index < Cmd.NumViews; ++Index)
+		{
+			Cmd.Views[Index] = Views ? Views[Index] : nullptr;
+		}
+		Record(ERHICommand::SetShaderResources, Cmd);
+	}
+
+	void SetSamplers(ERHIShaderStage Stage, uint32 StartSlot, uint32 NumSamplers, ID3D11SamplerState* const* Samplers)
+	{
+		FRHICmdSetSamplers Cmd{};
+		Cmd.Stage = Stage;
+		Cmd.StartSlot = static_cast<uint8>(StartSlot);
+		Cmd.NumSamplers = static_cast<uint8>(std::min(NumSamplers, FRHICmdSetSamplers::MaxSamplers));
+		for (uint32 Index = 0; Index < Cmd.NumSamplers; ++Index)
+		{
+			Cmd.Samplers[Index] = Samplers ? Samplers[Index] : nullptr;
+		}
+		Record(ERHICommand::SetSamplers, Cmd);
+	}
+
+	template<typename T>
+	void UpdateConstantBuffer(const T& Data)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Constant buffer data is copied into the command list");
+		RecordWithData(ERHICommand::UpdateConstantBuffer,
+			FRHICmdUpdateConstantBuffer{ &TRHIConstantBufferApply<T>::Apply, static_cast<uint32>(sizeof(T)) }, &Data, sizeof(T));
+	}
+
+	void UploadConstantBlocks(const FObjectConstantBlock* Blocks, uint32 NumBlocks)
+	{
+		Record(ERHICommand::UploadConstantBlocks, FRHICmdUploadConstantBlocks{ Blocks, NumBlocks });
+	}
+
+	void BindConstantBlocks(const FObjectConstantDraw& Draw)
+	{
+		Record(ERHICommand::BindConstantBlocks, FRHICmdBindConstantBlocks{ Draw });
+	}
+
+	void DrawIndexed(uint32 IndexCount, uint32 StartIndex, int32 BaseVertex)
+	{
+		Record(ERHICommand::DrawIndexed, FRHICmdDrawIndexed{ IndexCount, StartIndex, BaseVertex });
+	}
+
+	void DrawIndexedInstanced(uint32 IndexCount, uint32 InstanceCount, uint32 StartIndex, int32 BaseVertex, uint32 StartInstance)
+	{
+		Record(ERHICommand::DrawIndexedInstanced, FRHICmdDrawIndexedInstanced{ IndexCount, InstanceCount, StartIndex, BaseVertex, StartInstance });
+	}
+
+	void DrawInstanced(uint32 VertexCount, uint32 InstanceCount, uint32 StartVertex, uint32 StartInstance)
+	{
+		Record(ERHICommand::DrawInstanced, FRHICmdDrawInstanced{ VertexCount, InstanceCount, StartVertex, StartInstance });
+	}
+
+	// --- 재생 ---
+	// Visitor(const FRHICommandHeader& Header, const void* Payload)를 기록 순서대로 호출
+	template<typename VisitorType>
+	void ForEach(VisitorType&& Visitor) const
+	{
+		const uint8* Cursor = reinterpret_cast<const uint8*>(Words.data());
+		const uint8* End = Cursor + NumBytes;
+		while (Cursor < End)
+		{
+			const FRHICommandHeader& Header = *reinterpret_cast<const FRHICommandHeader*>(Cursor);
+			Visitor(Header, Cursor + sizeof(FRHICommandHeader));
+			Cursor += Header.Size;
+		}
+	}
+
+	// UpdateConstantBuffer 페이로드 뒤의 상수 데이터
+	static const void* GetConstantData(const FRHICmdUpdateConstantBuffer& Cmd)
+	{
+		return reinterpret_cast<const uint8*>(&Cmd) + AlignUp(sizeof(FRHICmdUpdateConstantBuffer));
+	}
+
+private:
+	static constexpr size_t AlignUp(size_t Bytes) { return (Bytes + 7) & ~size_t(7); }
+
+	template<typename PayloadType>
+	void Record(ERHICommand Type, const PayloadType& Payload)
+	{
+		RecordWithData(Type, Payload, nullptr, 0);
+	}
+
+	template<typename PayloadType>
+	void RecordWithData(ERHICommand Type, const PayloadType& Payload, const void* ExtraData, size_t ExtraSize)
+	{
+		static_assert(std::is_trivially_copyable_v<PayloadType>, "Command payloads must be POD");
+		const size_t PayloadBytes = AlignUp(sizeof(PayloadType));
+		const size_t TotalBytes = sizeof(FRHICommandHeader) + PayloadBytes + AlignUp(ExtraSize);
+		assert(TotalBytes <= 0xFFFF);
+
+		// 크기만 늘리므로 Reset 뒤에는 기존 용량을 그대로 씀
+		const size_t Offset = NumBytes;
+		NumBytes += TotalBytes;
+		if (Words.size() < NumBytes / 8)
+		{
+			Words.resize(NumBytes / 8);
+		}
+		uint8* Dest = reinterpret_cast<uint8*>(Words.data()) + Offset;
+
+		FRHICommandHeader Header{};
+		Header.Type = Type;
+		Header.Size = static_cast<uint16>(TotalBytes);
+		std::memcpy(Dest, &Header, sizeof(Header));
+		std::memcpy(Dest + sizeof(Header), &Payload, sizeof(PayloadType));
+		if (ExtraSize > 0)
+		{
+			std::memcpy(Dest + sizeof(Header) + PayloadBytes, ExtraData, ExtraSize);
+		}
+		++NumCommands;
+	}
+
+	// 8바이트 단위 저장소 (헤더/페이로드를 제자리에서 읽음). NumBytes까지가 유효한 명령
+	TArray<uint64> Words;
+	size_t NumBytes = 0;
+	int32 NumCommands = 0;
+};
+
+// 명령 리스트 재생기
+class IRHICommandBackend
+{
+public:
+	virtual ~IRHICommandBackend() = default;
+
+	virtual void Execute(const FRHICommandList& CommandList) = 0;
+};
+
+// 재생 결과 통계 (널 백엔드가 채움)
+struct FRHICommandStats
+{
+	uint32 NumCommands = 0;
+	uint32 NumCommandsByType[static_cast<uint32>(ERHICommand::Count)] = {};
+	uint32 NumDraws = 0;
+	uint64 NumIndices = 0;				// 인스턴스 수를 곱한 인덱스/정점 수
+	uint32 NumConstantBufferUpdates = 0;	// 드로우별 Map/Unmap이 될 업데이트
+	uint32 NumConstantBlockUploads = 0;	// 링 업로드 (Map 1회)
+	uint32 NumValidationErrors = 0;
+	FString FirstError;
+
+	uint32 GetCount(ERHICommand Type) const { return NumCommandsByType[static_cast<uint32>(Type)]; }
+	// D3D11 백엔드에서 버퍼 Map이 되는 명령 수
+	uint32 GetNumBufferMaps() const { return NumConstantBufferUpdates + NumConstantBlockUploads; }
+};
+
+/**
+ * 널 백엔드: GPU 없이 명령을 세고 검증만 함 (헤드리스 벤치마크/테스트용)
+ * - 드로우 시점에 VS, 정점/인덱스 버퍼, 개수, 상수 블록 범위가 유효한지 확인
+ * - Execute를 여러 번 부르면 통계가 누적됨 (ResetStats로 초기화)
+ */
+class FNullCommandBackend : public IRHICommandBackend
+{
+public:
+	void Execute(const FRHICommandList& CommandList) override;
+
+	const FRHICommandStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FRHICommandStats(); }
+
+private:
+	void AddError(const char* Message, int32 CommandIndex);
+
+	FRHICommandStats Stats;
+};
@@ -277,7 +277,16 @@ void FViewportClient::MouseButtonDown(FViewport* Viewport, int32 X, int32 Y, int
 			return;
 		}
 		Camera->SetWorld(World);
-		PickedComponent = URenderManager::GetInstance().GetRenderer()->GetPrimitiveCollided(static_cast<int>(ViewportMousePos.X), static_cast<int>(ViewportMousePos.Y));
+		URenderer* Renderer = URenderManager::GetInstance().GetRenderer();
+		if (Renderer->GetRHIDevice()->IsDeferredRecording())
+		{
+			// 렌더 스레드 모드: ID 버퍼를 게임 스레드에서 읽을 수 없으므로 월드 BVH + 메시 BVH로 CPU 레이 피킹
+			PickedComponent = CPickingSystem::PerformViewportComponentPicking(Camera, ViewportMousePos, ViewportSize, ViewportOffset, PickingAspectRatio, Viewport);
+		}
+		else
+		{
+			PickedComponent = Renderer->GetPrimitiveCollided(static_cast<int>(ViewportMousePos.X), static_cast<int>(ViewportMousePos.Y));
+		}
 		// PickedActor = CPickingSystem::PerformViewportPicking(AllActors, Camera, ViewportMousePos, ViewportSize, ViewportOffset, PickingAspectRatio,  Viewport);
 
 
@@ -0,0 +1,60 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+// 게임 스레드/렌더 스레드 프레임 시간 (UGameEngine/UEditorEngine::MainLoop이 채움)
+// 렌더 스레드 모드가 꺼져 있으면 렌더 스레드 항목은 게임 스레드에서 바로 실행한 오버레이 + Present 시간 (에디터는 Present를 나누지 않아 0)
+struct FFrameTimingStats
+{
+	bool bRenderThread = false;		// 렌더 스레드 모드 (게임 스레드는 지연 컨텍스트에 기록, 렌더 스레드가 실행 + Present)
+	uint64 FrameNumber = 0;
+
+	float FrameMS = 0.0f;			// 프레임 간격
+
+	// 게임 스레드
+	float GameTickMS = 0.0f;		// 월드 Tick (렌더 스레드의 이전 프레임 실행과 겹치는 구간)
+	float GameWaitMS = 0.0f;		// 렌더 스레드가 이전 프레임을 끝낼 때까지 기다린 시간 (펜스)
+	float GameRenderMS = 0.0f;		// 씬 렌더링 명령 기록(렌더 스레드 모드) 또는 제출 + 오버레이 통계 수집
+
+	// 렌더 스레드 (RenderFrameNumber 프레임 기준. 렌더 스레드 모드에서는 FrameNumber - 1, GameWaitMS가 기다린 프레임)
+	uint64 RenderFrameNumber = 0;
+	float RenderThreadMS = 0.0f;	// 명령 리스트 실행 + 오버레이 + Present (GPU가 밀려 있으면 Present에서 막힘)
+	float RenderIdleMS = 0.0f;		// 다음 프레임을 기다린 시간
+
+	float OverlapPercent = 0.0f;	// 렌더 스레드 작업 중 게임 스레드 Tick과 겹친 비율
+
+	void CalculateStats()
+	{
+		const float Hidden = RenderThreadMS - GameWaitMS;
+		OverlapPercent = bRenderThread && RenderThreadMS > 0.0f ? (std::max(Hidden, 0.0f) / RenderThreadMS) * 100.0f : 0.0f;
+	}
+};
+
+// 프레임 시간 통계 전역 매니저 (싱글톤)
+// UStatsOverlayD2D에서 접근할 수 있도록 마지막 프레임의 통계 제공
+class FFrameTimingStatManager
+{
+public:
+	static FFrameTimingStatManager& GetInstance()
+	{
+		static FFrameTimingStatManager Instance;
+		return Instance;
+	}
+
+	void UpdateStats(const FFrameTimingStats& InStats)
+	{
+		CurrentStats = InStats;
+	}
+
+	const FFrameTimingStats& GetStats() const
+	{
+		return CurrentStats;
+	}
+
+private:
+	FFrameTimingStatManager() = default;
+	~FFrameTimingStatManager() = default;
+	FFrameTimingStatManager(const FFrameTimingStatManager&) = delete;
+	FFrameTimingStatManager& operator=(const FFrameTimingStatManager&) = delete;
+
+	FFrameTimingStats CurrentStats;
+};
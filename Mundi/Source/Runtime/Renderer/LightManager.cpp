@@ -29,6 +29,7 @@ void FLightManager::Initialize(D3D11RHI* RHIDevice, uint32 InShadowAtlasSize2D,
 	ShadowAtlasSize2D = InShadowAtlasSize2D;
 	AtlasSizeCube = InAtlasSizeCube;
 	CubeArrayCount = InCubeArrayCount;
+	ShadowAtlasAllocator2D.Initialize(ShadowAtlasSize2D);
 
 	// --- 1. Structured Buffers (t17, t18) ---
 	if (!PointLightBuffer)
@@ -276,6 +277,9 @@ void FLightManager::Release()
 		VSMShadowAtlasTexture2D->Release();
 		VSMShadowAtlasTexture2D = nullptr;
 	}
+
+	ShadowCasterCache.Release();
+	ShadowAtlasAllocator2D.Reset();
 }
 
 void FLightManager::UpdateLightBuffer(D3D11RHI* RHIDevice)
@@ -534,42 +538,8 @@ bool FLightManager::GetCachedShadowCubeSliceIndex(ULightComponent* Light, int32&
 // 단순한 아틀라스 로직
 void FLightManager::AllocateAtlasRegions2D(TArray<FShadowRenderRequest>& InOutRequests2D)
 {
-	// 요청 정렬 (가장 큰 것부터)
-	InOutRequests2D.Sort(std::greater<FShadowRenderRequest>());
-
-	// 동적 패킹(Shelf Algorithm)
-	uint32 CurrentAtlasX = 0;
-	uint32 CurrentAtlasY = 0;
-	uint32 CurrentShelfMaxHeight = 0;
-
-	for (FShadowRenderRequest& Request : InOutRequests2D)
-	{
-		if (CurrentAtlasX + Request.Size > ShadowAtlasSize2D)
-		{
-			CurrentAtlasY += CurrentShelfMaxHeight;
-			CurrentAtlasX = 0;
-			CurrentShelfMaxHeight = 0;
-		}
-		if (CurrentAtlasY + Request.Size > ShadowAtlasSize2D)
-		{
-			Request.Size = 0; // 꽉 참 (렌더링 실패)
-			//UE_LOG("그림자 맵 아틀라스가 가득차서 더 이상 그림자를 추가할 수 없습니다.");
-			continue;
-		}
-
-		Request.AtlasViewportOffset = FVector2D((float)CurrentAtlasX, (float)CurrentAtlasY);
-
-		// Pass 2 데이터 (UV) 저장
-		Request.AtlasScaleOffset = FVector4(
-			Request.Size / (float)ShadowAtlasSize2D,    // ScaleX
-			Request.Size / (float)ShadowAtlasSize2D,    // ScaleY
-			CurrentAtlasX / (float)ShadowAtlasSize2D,   // OffsetX
-			CurrentAtlasY / (float)ShadowAtlasSize2D    // OffsetY
-		);
-
-		CurrentAtlasX += Request.Size;
-		CurrentShelfMaxHeight = FMath::Max(CurrentShelfMaxHeight, Request.Size);
-	}
+	// 영구 버디 할당: 이전 프레임 위치 유지, 중요도로 해상도 조절, 꽉 차면 버리기 전에 해상도를 낮춤
+	ShadowAtlasAllocator2D.Allocate(InOutRequests2D);
 }
 
 void FLightManager::AllocateAtlasCubeSlices(TArray<FShadowRenderRequest>& InOutRequestsCube)
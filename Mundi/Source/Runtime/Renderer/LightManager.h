@@ -1,4 +1,6 @@
 ﻿#pragma once
+#include "ShadowCasterCache.h"
+#include "ShadowAtlasAllocator.h"
 #define CASCADED_MAX 8
 
 class UAmbientLightComponent;
@@ -34,11 +36,12 @@ struct FShadowMapData // 112 bytes
 
 struct FShadowRenderRequest
 {
-    ULightComponent* LightOwner;
+    ULightComponent* LightOwner = nullptr;
     FMatrix ViewMatrix;
     FMatrix ProjectionMatrix;
     FVector WorldLocation;
-    float Radius;
+    float Radius = 0.0f; // Point/Spot 감쇠 반경 (캐스터 컬링, VSM 거리 정규화)
+    float ScreenImportance = 1.0f; // 0~1, 화면에서 차지하는 비율 (2D 아틀라스 해상도/우선순위)
     uint32 Size;
     int32 SubViewIndex; // Point(0~5), CSM(0~N), Spot(0)
     int32 AssignedSliceIndex = -1; // Cube Atlas Slice Index
@@ -158,6 +161,11 @@ public:
     void AllocateAtlasRegions2D(TArray<FShadowRenderRequest>& InOutRequests2D);
     void AllocateAtlasCubeSlices(TArray<FShadowRenderRequest>& InOutRequestsCube);
 
+    // 정적 캐스터 섀도우 캐시 (섀도우 패스 사이에 유지)
+    FShadowCasterCache& GetShadowCasterCache() { return ShadowCasterCache; }
+    // 마지막 AllocateAtlasRegions2D 결과
+    const FShadowAtlasAllocStats& GetShadowAtlasAllocStats2D() const { return ShadowAtlasAllocator2D.GetStats(); }
+
     TArray<UAmbientLightComponent*> GetAmbientLightList() { return AmbientLightList; }
     TArray<UDirectionalLightComponent*> GetDirectionalLightList() { return DIrectionalLightList; }
     TArray<UPointLightComponent*> GetPointLightList() { return PointLightList; }
@@ -187,6 +195,8 @@ private:
     ID3D11DepthStencilView* ShadowAtlasDSV2D = nullptr;
     ID3D11ShaderResourceView* ShadowAtlasSRV2D = nullptr; // t9
     uint32 ShadowAtlasSize2D = 8192;
+    // 2D 아틀라스 영역 할당 (라이트 서브뷰별 블록을 프레임 사이에 유지)
+    FShadowAtlasAllocator ShadowAtlasAllocator2D;
 
     // Atlas 2: 큐브맵 아틀라스 (Point Light용)
     ID3D11Texture2D* ShadowAtlasTextureCube = nullptr; // TextureCubeArray 리소스
@@ -209,6 +219,9 @@ private:
     // Key: 라이트, Value: 할당된 큐브맵 슬라이스 인덱스
     TMap<ULightComponent*, int32> ShadowDataCacheCube;
 
+    // 라이트 서브뷰별 정적 캐스터 깊이 (Spot/Point)
+    FShadowCasterCache ShadowCasterCache;
+
 
     //structured buffer
     ID3D11Buffer* PointLightBuffer = nullptr;
@@ -0,0 +1,170 @@
+﻿#include "pch.h"
+#include "MeshAutoInstancing.h"
+#include "MeshDrawStats.h"
+#include "D3D11RHI.h"
+#include "PlatformTime.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+
+FMeshAutoInstancing::~FMeshAutoInstancing()
+{
+	Release();
+}
+
+bool FMeshAutoInstancing::CanInstance(const FMeshBatchElement& Batch)
+{
+	// 파티클 인스턴싱, GPU 스키닝, SubUV/빌보드 정렬처럼 드로우마다 다른 상태를 쓰는 배치는 제외
+	return Batch.InstancingVertexShader && Batch.InstancingPixelShader &&
+		!Batch.bInstancedDraw && !Batch.bAutoInstanced &&
+		Batch.VertexBuffer && Batch.IndexBuffer && Batch.VertexStride > 0 && Batch.IndexCount > 0 &&
+		!Batch.GPUSkinMatrixSRV && !Batch.GPUSkinNormalMatrixSRV &&
+		Batch.SubImages_Horizontal <= 1 && Batch.SubImages_Vertical <= 1 &&
+		Batch.ScreenAlignment == EScreenAlignment::None;
+}
+
+bool FMeshAutoInstancing::CanMerge(const FMeshBatchElement& A, const FMeshBatchElement& B)
+{
+	return CanInstance(B) &&
+		A.VertexShader == B.VertexShader &&
+		A.PixelShader == B.PixelShader &&
+		A.InstancingVertexShader == B.InstancingVertexShader &&
+		A.InstancingPixelShader == B.InstancingPixelShader &&
+		A.Material == B.Material &&
+		A.InstanceShaderResourceView == B.InstanceShaderResourceView &&
+		A.VertexBuffer == B.VertexBuffer &&
+		A.IndexBuffer == B.IndexBuffer &&
+		A.VertexStride == B.VertexStride &&
+		A.PrimitiveTopology == B.PrimitiveTopology &&
+		A.IndexCount == B.IndexCount &&
+		A.StartIndex == B.StartIndex &&
+		A.BaseVertexIndex == B.BaseVertexIndex &&
+		A.SortPriority == B.SortPriority;
+}
+
+void FMeshAutoInstancing::MergeBatches(TArray<FMeshBatchElement>& InOutBatches, FMeshDrawStats& OutStats)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Instances.Empty();
+	InstanceSourceBatches.Empty();
+	MergedBatches.Empty();
+	MergedBatches.reserve(InOutBatches.size());
+
+	const int32 NumBatches = InOutBatches.Num();
+	OutStats.NumBatches += NumBatches;
+
+	// 1. 연속 구간 찾기 (정렬 키에 인덱스 범위까지 들어 있어 같은 메시 섹션은 붙어 있음)
+	int32 Begin = 0;
+	while (Begin < NumBatches)
+	{
+		const FMeshBatchElement& First = InOutBatches[Begin];
+		int32 End = Begin + 1;
+		if (CanInstance(First))
+		{
+			while (End < NumBatches && CanMerge(First, InOutBatches[End]))
+			{
+				++End;
+			}
+		}
+
+		const int32 RunLength = End - Begin;
+		if (RunLength >= MinInstancesPerDraw)
+		{
+			FMeshBatchElement Merged = First;
+			Merged.VertexShader = First.InstancingVertexShader;
+			Merged.PixelShader = First.InstancingPixelShader;
+			Merged.InputLayout = First.InstancingInputLayout;
+			Merged.bAutoInstanced = true;
+			Merged.InstanceStart = static_cast<uint32>(InstanceSourceBatches.Num());
+			Merged.InstanceCount = static_cast<uint32>(RunLength);
+			MergedBatches.Add(Merged);
+
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				InstanceSourceBatches.Add(Index);
+			}
+
+			++OutStats.NumInstancedDraws;
+			OutStats.NumInstances += static_cast<uint32>(RunLength);
+			OutStats.MaxInstancesPerDraw = std::max(OutStats.MaxInstancesPerDraw, static_cast<uint32>(RunLength));
+		}
+		else
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				MergedBatches.Add(InOutBatches[Index]);
+			}
+		}
+		Begin = End;
+	}
+
+	// 2. 인스턴스 데이터 (노멀 행렬 역행렬 계산이 대부분이라 병렬로)
+	const int32 NumInstances = InstanceSourceBatches.Num();
+	Instances.SetNum(NumInstances);
+	ParallelFor(NumInstances, [&](int32 InstanceIndex)
+	{
+		const FMeshBatchElement& Source = InOutBatches[InstanceSourceBatches[InstanceIndex]];
+		FMeshInstanceData& Instance = Instances[InstanceIndex];
+		Instance.WorldMatrix = Source.WorldMatrix;
+		Instance.WorldInverseTranspose = Source.WorldMatrix.InverseAffine().Transpose();
+		Instance.Color = Source.InstanceColor;
+		Instance.ObjectID = Source.ObjectID;
+	}, 256);
+
+	InOutBatches.swap(MergedBatches);
+	MergedBatches.Empty();
+
+	OutStats.NumDrawCalls += InOutBatches.Num();
+	OutStats.MergeTimeMS += static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+	OutStats.CalculateStats();
+}
+
+bool FMeshAutoInstancing::UploadAndBind(D3D11RHI* RHIDevice)
+{
+	if (!RHIDevice || Instances.IsEmpty())
+	{
+		return false;
+	}
+
+	// 모자라면 2배로 키움 (DYNAMIC + WRITE_DISCARD라 같은 프레임의 다른 뷰가 다시 써도 안전)
+	const uint32 NumInstances = static_cast<uint32>(Instances.Num());
+	if (NumInstances > Capacity)
+	{
+		Release();
+
+		uint32 NewCapacity = 1024;
+		while (NewCapacity < NumInstances)
+		{
+			NewCapacity *= 2;
+		}
+
+		if (FAILED(RHIDevice->CreateStructuredBuffer(sizeof(FMeshInstanceData), NewCapacity, nullptr, &InstanceBuffer)) ||
+			FAILED(RHIDevice->CreateStructuredBufferSRV(InstanceBuffer, &InstanceSRV)))
+		{
+			UE_LOG("[MeshAutoInstancing] 인스턴스 버퍼 생성 실패 (%u instances)", NewCapacity);
+			Release();
+			return false;
+		}
+		Capacity = NewCapacity;
+	}
+
+	RHIDevice->UpdateStructuredBuffer(InstanceBuffer, Instances.data(), NumInstances * sizeof(FMeshInstanceData));
+	RHIDevice->GetDeviceContext()->VSSetShaderResources(InstanceDataSlot, 1, &InstanceSRV);
+	return true;
+}
+
+void FMeshAutoInstancing::Unbind(D3D11RHI* RHIDevice)
+{
+	if (!RHIDevice)
+	{
+		return;
+	}
+	ID3D11ShaderResourceView* NullSRV = nullptr;
+	RHIDevice->GetDeviceContext()->VSSetShaderResources(InstanceDataSlot, 1, &NullSRV);
+}
+
+void FMeshAutoInstancing::Release()
+{
+	if (InstanceSRV) { InstanceSRV->Release(); InstanceSRV = nullptr; }
+	if (InstanceBuffer) { InstanceBuffer->Release(); InstanceBuffer = nullptr; }
+	Capacity = 0;
+}
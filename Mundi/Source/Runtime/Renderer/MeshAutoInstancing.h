@@ -0,0 +1,58 @@
+﻿#pragma once
+#include "MeshBatchElement.h"
+
+class D3D11RHI;
+struct FMeshDrawStats;
+
+// UberLit.hlsl의 FInstanceData와 정확히 일치 (StructuredBuffer, t15)
+struct FMeshInstanceData
+{
+	FMatrix WorldMatrix;
+	FMatrix WorldInverseTranspose;
+	FLinearColor Color;
+	uint32 ObjectID = 0;
+	uint32 Padding[3] = {};
+};
+static_assert(sizeof(FMeshInstanceData) == 160, "FMeshInstanceData must match FInstanceData in UberLit.hlsl");
+
+// 자동 GPU 인스턴싱
+// - 정렬된 배치 리스트에서 셰이더/머티리얼/버퍼/인덱스 범위가 같은 배치가 이어지면 DrawIndexedInstanced 하나로 합침
+// - 대상은 InstancingVertexShader가 채워진 배치만 (USE_INSTANCING을 지원하는 셰이더의 스태틱 메시)
+// - 인스턴스별 월드/노멀 행렬, 색상, ObjectID는 프레임 인스턴스 버퍼에 쓰고 드로우마다 시작 위치만 b9로 넘김
+// - URenderer가 소유해 버퍼를 뷰/프레임 사이에 재사용 (모자라면 2배로 키움)
+class FMeshAutoInstancing
+{
+public:
+	static constexpr uint32 InstanceDataSlot = 15;		// t15 (VS)
+	static constexpr int32 MinInstancesPerDraw = 2;
+
+	FMeshAutoInstancing() = default;
+	~FMeshAutoInstancing();
+
+	// 합칠 수 있는 연속 구간을 bAutoInstanced 배치 하나로 바꾸고 인스턴스 데이터를 채움 (이전 호출의 데이터는 버림)
+	// InOutBatches는 FMeshBatchSorter(Opaque 키)로 정렬된 상태여야 함
+	void MergeBatches(TArray<FMeshBatchElement>& InOutBatches, FMeshDrawStats& OutStats);
+
+	// MergeBatches로 채운 인스턴스 데이터를 올리고 t15에 바인딩 (인스턴스가 없으면 아무것도 하지 않음)
+	bool UploadAndBind(D3D11RHI* RHIDevice);
+	void Unbind(D3D11RHI* RHIDevice);
+
+	const TArray<FMeshInstanceData>& GetInstances() const { return Instances; }
+
+	void Release();
+
+	// 두 배치를 인스턴스 하나씩으로 합칠 수 있는지 (A는 구간의 첫 배치)
+	static bool CanMerge(const FMeshBatchElement& A, const FMeshBatchElement& B);
+
+private:
+	static bool CanInstance(const FMeshBatchElement& Batch);
+
+	ID3D11Buffer* InstanceBuffer = nullptr;
+	ID3D11ShaderResourceView* InstanceSRV = nullptr;
+	uint32 Capacity = 0;
+
+	// 프레임 임시 버퍼 (재사용)
+	TArray<FMeshInstanceData> Instances;
+	TArray<int32> InstanceSourceBatches;	// 인스턴스 → 원래 배치 인덱스
+	TArray<FMeshBatchElement> MergedBatches;
+};
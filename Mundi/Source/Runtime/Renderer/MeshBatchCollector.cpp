@@ -0,0 +1,177 @@
+﻿#include "pch.h"
+#include "MeshBatchCollector.h"
+#include "MeshComponent.h"
+#include "Shader.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <cstring>
+
+void FMeshBatchCollector::Collect(const TArray<UMeshComponent*>& Components, const FSceneView* View,
+	TArray<FMeshBatchElement>& OutBatches, TArray<int32>* OutComponentOffsets)
+{
+	const int32 NumComponents = Components.Num();
+	NumSerialFallbacks = 0;
+
+	// 1. 게임 스레드 준비 (즉시 컨텍스트 사용)
+	for (UMeshComponent* Component : Components)
+	{
+		if (Component)
+		{
+			Component->PrepareMeshBatches(View);
+		}
+	}
+
+	if (OutComponentOffsets)
+	{
+		OutComponentOffsets->SetNum(NumComponents + 1);
+		(*OutComponentOffsets)[0] = OutBatches.Num();
+	}
+
+	// 적으면 직렬 (기존 경로와 동일)
+	if (NumComponents < MinParallelComponents || FTaskGraph::GetInstance().GetNumWorkers() == 0)
+	{
+		for (int32 Index = 0; Index < NumComponents; ++Index)
+		{
+			if (Components[Index])
+			{
+				Components[Index]->CollectMeshBatches(OutBatches, View);
+			}
+			if (OutComponentOffsets)
+			{
+				(*OutComponentOffsets)[Index + 1] = OutBatches.Num();
+			}
+		}
+		return;
+	}
+
+	// 2. 묶음별 병렬 수집
+	const int32 NumChunks = (NumComponents + ComponentsPerChunk - 1) / ComponentsPerChunk;
+	if (ChunkBatches.Num() < NumChunks)
+	{
+		ChunkBatches.SetNum(NumChunks);
+	}
+	BatchCounts.SetNum(NumComponents);
+
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		TArray<FMeshBatchElement>& Batches = ChunkBatches[Chunk];
+		Batches.Empty();
+
+		const int32 Begin = Chunk * ComponentsPerChunk;
+		const int32 End = std::min(Begin + ComponentsPerChunk, NumComponents);
+
+		// 호출 스레드도 묶음을 맡으므로 끝나면 되돌림
+		UShader::SetVariantCompileAllowed(false);
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			UMeshComponent* Component = Components[Index];
+			if (!Component)
+			{
+				BatchCounts[Index] = 0;
+				continue;
+			}
+
+			const int32 First = Batches.Num();
+			const uint32 MissedBefore = UShader::GetNumMissedVariants();
+			Component->CollectMeshBatches(Batches, View);
+			if (UShader::GetNumMissedVariants() != MissedBefore)
+			{
+				// 셰이더가 빠진 배치를 그대로 쓰면 직렬 결과와 달라지므로 버리고 게임 스레드에서 다시
+				Batches.SetNum(First);
+				BatchCounts[Index] = -1;
+			}
+			else
+			{
+				BatchCounts[Index] = Batches.Num() - First;
+			}
+		}
+		UShader::SetVariantCompileAllowed(true);
+	});
+
+	// 3. 합치기
+	bool bHasFallback = false;
+	for (int32 Index = 0; Index < NumComponents && !bHasFallback; ++Index)
+	{
+		bHasFallback = BatchCounts[Index] < 0;
+	}
+
+	if (!bHasFallback)
+	{
+		// 묶음 크기의 prefix sum으로 자리를 잡고 병렬 복사
+		const int32 Base = OutBatches.Num();
+		TArray<int32> ChunkOffsets;
+		ChunkOffsets.SetNum(NumChunks + 1);
+		ChunkOffsets[0] = Base;
+		for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+		{
+			ChunkOffsets[Chunk + 1] = ChunkOffsets[Chunk] + ChunkBatches[Chunk].Num();
+		}
+		OutBatches.SetNum(ChunkOffsets[NumChunks]);
+
+		ParallelFor(NumChunks, [&](int32 Chunk)
+		{
+			const TArray<FMeshBatchElement>& Batches = ChunkBatches[Chunk];
+			std::copy(Batches.begin(), Batches.end(), OutBatches.begin() + ChunkOffsets[Chunk]);
+
+			if (OutComponentOffsets)
+			{
+				int32 Offset = ChunkOffsets[Chunk];
+				const int32 Begin = Chunk * ComponentsPerChunk;
+				const int32 End = std::min(Begin + ComponentsPerChunk, NumComponents);
+				for (int32 Index = Begin; Index < End; ++Index)
+				{
+					Offset += BatchCounts[Index];
+					(*OutComponentOffsets)[Index + 1] = Offset;
+				}
+			}
+		});
+		return;
+	}
+
+	// 놓친 셰이더 변형이 있으면 (처음 보는 머티리얼/뷰 모드 조합) 컴포넌트 순서대로 이어 붙이면서 그 자리에서 직렬 수집
+	for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+	{
+		const TArray<FMeshBatchElement>& Batches = ChunkBatches[Chunk];
+		int32 Read = 0;
+
+		const int32 Begin = Chunk * ComponentsPerChunk;
+		const int32 End = std::min(Begin + ComponentsPerChunk, NumComponents);
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			if (BatchCounts[Index] < 0)
+			{
+				Components[Index]->CollectMeshBatches(OutBatches, View);
+				++NumSerialFallbacks;
+			}
+			else
+			{
+				OutBatches.insert(OutBatches.end(), Batches.begin() + Read, Batches.begin() + Read + BatchCounts[Index]);
+				Read += BatchCounts[Index];
+			}
+
+			if (OutComponentOffsets)
+			{
+				(*OutComponentOffsets)[Index + 1] = OutBatches.Num();
+			}
+		}
+	}
+}
+
+bool FMeshBatchCollector::IsSameBatch(const FMeshBatchElement& A, const FMeshBatchElement& B)
+{
+	return A.VertexShader == B.VertexShader && A.PixelShader == B.PixelShader && A.InputLayout == B.InputLayout &&
+		A.Material == B.Material && A.VertexBuffer == B.VertexBuffer && A.IndexBuffer == B.IndexBuffer &&
+		A.PrimitiveTopology == B.PrimitiveTopology &&
+		A.IndexCount == B.IndexCount && A.StartIndex == B.StartIndex && A.BaseVertexIndex == B.BaseVertexIndex && A.VertexStride == B.VertexStride &&
+		std::memcmp(&A.WorldMatrix, &B.WorldMatrix, sizeof(FMatrix)) == 0 &&
+		A.ObjectID == B.ObjectID && A.InstanceShaderResourceView == B.InstanceShaderResourceView &&
+		A.InstanceColor.R == B.InstanceColor.R && A.InstanceColor.G == B.InstanceColor.G &&
+		A.InstanceColor.B == B.InstanceColor.B && A.InstanceColor.A == B.InstanceColor.A &&
+		A.GPUSkinMatrixSRV == B.GPUSkinMatrixSRV && A.GPUSkinNormalMatrixSRV == B.GPUSkinNormalMatrixSRV &&
+		A.SubImages_Horizontal == B.SubImages_Horizontal && A.SubImages_Vertical == B.SubImages_Vertical &&
+		A.SubUV_InterpMethod == B.SubUV_InterpMethod && A.ScreenAlignment == B.ScreenAlignment &&
+		A.SortPriority == B.SortPriority && A.bIsDepthWrite == B.bIsDepthWrite &&
+		A.bInstancedDraw == B.bInstancedDraw && A.InstanceVertexBuffer == B.InstanceVertexBuffer &&
+		A.InstanceStride == B.InstanceStride && A.InstanceCount == B.InstanceCount && A.InstanceStart == B.InstanceStart &&
+		A.InstancingVertexShader == B.InstancingVertexShader && A.InstancingPixelShader == B.InstancingPixelShader &&
+		A.InstancingInputLayout == B.InstancingInputLayout && A.bAutoInstanced == B.bAutoInstanced;
+}
@@ -0,0 +1,37 @@
+﻿#pragma once
+#include "MeshBatchElement.h"
+
+class UMeshComponent;
+class FSceneView;
+
+// 메시 컴포넌트 목록의 CollectMeshBatches를 ParallelFor로 나눠 실행
+// - 컴포넌트를 ComponentsPerChunk개씩 묶어 묶음마다 자기 출력 배열에 모은 뒤, 묶음 순서대로 이어 붙임 → 직렬 수집과 같은 순서
+// - 수집 전에 게임 스레드에서 PrepareMeshBatches를 차례로 호출 (스키닝 버퍼 업로드처럼 즉시 컨텍스트를 쓰는 일)
+// - 워커에서는 셰이더 변형을 컴파일하지 않음. 없는 변형을 만난 컴포넌트는 출력을 버리고 합칠 때 게임 스레드에서 다시 수집
+// - 컴포넌트가 적으면 ParallelFor 비용이 더 커서 직렬로 수집
+// - URenderer가 소유해 묶음별 배열을 프레임 사이에 재사용
+class FMeshBatchCollector
+{
+public:
+	static constexpr int32 ComponentsPerChunk = 128;
+	static constexpr int32 MinParallelComponents = 512;
+
+	FMeshBatchCollector() = default;
+
+	// OutBatches 뒤에 이어 붙임. OutComponentOffsets가 있으면 컴포넌트 i의 배치는
+	// OutBatches[(*OutComponentOffsets)[i], (*OutComponentOffsets)[i + 1]) (크기 Num + 1)
+	void Collect(const TArray<UMeshComponent*>& Components, const FSceneView* View,
+		TArray<FMeshBatchElement>& OutBatches, TArray<int32>* OutComponentOffsets = nullptr);
+
+	// 마지막 Collect에서 게임 스레드로 넘어간 컴포넌트 수
+	int32 GetNumSerialFallbacks() const { return NumSerialFallbacks; }
+
+	// 정렬 키를 제외한 드로우 상태가 모두 같은지 (병렬/직렬 결과 비교용)
+	static bool IsSameBatch(const FMeshBatchElement& A, const FMeshBatchElement& B);
+
+private:
+	// 묶음별 출력. BatchCounts[i] < 0 이면 게임 스레드에서 다시 수집해야 하는 컴포넌트
+	TArray<TArray<FMeshBatchElement>> ChunkBatches;
+	TArray<int32> BatchCounts;
+	int32 NumSerialFallbacks = 0;
+};
@@ -88,6 +88,17 @@ struct FMeshBatchElement
 	uint32 InstanceCount = 0;
 	uint32 InstanceStart = 0;
 
+	// --- 5. 자동 인스턴싱 (FMeshAutoInstancing) ---
+	// 같은 상태의 배치와 합칠 수 있으면 USE_INSTANCING 셰이더 변형을 채움 (nullptr이면 합치지 않음)
+	ID3D11VertexShader* InstancingVertexShader = nullptr;
+	ID3D11PixelShader* InstancingPixelShader = nullptr;
+	ID3D11InputLayout* InstancingInputLayout = nullptr;
+	// 합쳐진 배치: 프레임 인스턴스 버퍼(t15)의 [InstanceStart, InstanceStart + InstanceCount)를 그림
+	bool bAutoInstanced = false;
+
+	// --- 6. 64비트 정렬 키 (FMeshBatchSorter::AssignKeys가 채움) ---
+	uint64 SortKey = 0;
+
 	// --- 기본 생성자 ---
 	FMeshBatchElement() = default;
 
@@ -95,6 +106,7 @@ struct FMeshBatchElement
 	 * @brief FMeshBatchElement 정렬을 위한 'less than' 연산자입니다.
 	 * TArray::Sort()가 A < B 를 비교하기 위해 이 함수를 호출합니다.
 	 * GPU 상태 변경을 최소화하는 순서로 정렬 키를 비교합니다.
+	 * 렌더 패스는 FMeshBatchSorter(SortKey + radix sort)를 쓰고, 이 비교는 벤치마크 기준으로 남겨 둡니다.
 	 */
 	bool operator<(const FMeshBatchElement& B) const
 	{
@@ -116,6 +128,12 @@ struct FMeshBatchElement
 		if (A.VertexStride != B.VertexStride) return A.VertexStride < B.VertexStride;
 		if (A.PrimitiveTopology != B.PrimitiveTopology) return A.PrimitiveTopology < B.PrimitiveTopology;
 
+		// 4순위: 드로우 범위 (같은 메시 섹션끼리 붙어 있어야 자동 인스턴싱으로 합쳐짐)
+		if (A.StartIndex != B.StartIndex) return A.StartIndex < B.StartIndex;
+		if (A.IndexCount != B.IndexCount) return A.IndexCount < B.IndexCount;
+		if (A.BaseVertexIndex != B.BaseVertexIndex) return A.BaseVertexIndex < B.BaseVertexIndex;
+		if (A.InstancingVertexShader != B.InstancingVertexShader) return A.InstancingVertexShader < B.InstancingVertexShader;
+
 		// 모든 키가 동일하면 순서가 중요하지 않으므로 false 반환 (Stable Sort 보장)
 		return false;
 	}
@@ -0,0 +1,270 @@
+﻿#include "pch.h"
+#include "MeshBatchSort.h"
+#include "Hash.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <cstring>
+
+namespace
+{
+	constexpr uint32 PriorityBits = 8;
+	constexpr uint32 ProgramBits = 12;
+	constexpr uint32 MaterialBits = 14;
+	constexpr uint32 OpaqueGeometryBits = 16;
+	constexpr uint32 OpaqueDepthBits = 14;
+	constexpr uint32 TranslucentDepthBits = 16;
+	constexpr uint32 TranslucentGeometryBits = 14;
+
+	constexpr uint32 GatherGrainSize = 1024;
+
+	constexpr uint64 MaxValue(uint32 Bits) { return (1ull << Bits) - 1; }
+
+	// 뷰 공간 Z (양수일수록 멀다). float 비트는 양수에서 단조 증가하므로 상위 비트가 로그 분포 버킷
+	uint32 QuantizeDepth(const FMeshBatchElement& Batch, const FMatrix& ViewMatrix, uint32 Bits)
+	{
+		const FMatrix& World = Batch.WorldMatrix;
+		const float ViewZ = World.M[3][0] * ViewMatrix.M[0][2] + World.M[3][1] * ViewMatrix.M[1][2] + World.M[3][2] * ViewMatrix.M[2][2] + ViewMatrix.M[3][2];
+		const float Depth = ViewZ > 0.0f ? ViewZ : 0.0f;
+
+		uint32 DepthBits;
+		std::memcpy(&DepthBits, &Depth, sizeof(DepthBits));
+		// 부호 비트(0)를 빼고 지수 8비트 + 가수 상위 비트
+		return (DepthBits >> (31 - Bits)) & static_cast<uint32>(MaxValue(Bits));
+	}
+
+	uint64 MakeProgramKey(const FMeshBatchElement& Batch)
+	{
+		return HashCombine(reinterpret_cast<uint64>(Batch.VertexShader), reinterpret_cast<uint64>(Batch.PixelShader));
+	}
+
+	uint64 MakeMaterialKey(const FMeshBatchElement& Batch)
+	{
+		return HashCombine(reinterpret_cast<uint64>(Batch.Material), reinterpret_cast<uint64>(Batch.InstanceShaderResourceView));
+	}
+
+	// 자동 인스턴싱(FMeshAutoInstancing)이 합치려면 같은 섹션이 붙어 있어야 하므로 인덱스 범위와 인스턴싱 셰이더까지 포함
+	uint64 MakeGeometryKey(const FMeshBatchElement& Batch)
+	{
+		uint64 Key = HashCombine(reinterpret_cast<uint64>(Batch.VertexBuffer), reinterpret_cast<uint64>(Batch.IndexBuffer));
+		Key = HashCombine(Key, (static_cast<uint64>(Batch.VertexStride) << 32) | static_cast<uint64>(Batch.PrimitiveTopology));
+		Key = HashCombine(Key, (static_cast<uint64>(Batch.StartIndex) << 32) | Batch.IndexCount);
+		Key = HashCombine(Key, Batch.BaseVertexIndex);
+		return HashCombine(Key, reinterpret_cast<uint64>(Batch.InstancingVertexShader));
+	}
+
+	uint64 MakePriority(const FMeshBatchElement& Batch)
+	{
+		// 우선순위가 없는(-1) 배치가 가장 먼저, 나머지는 값 순서
+		return Batch.SortPriority < 0 ? 0 : std::min<uint64>(static_cast<uint64>(Batch.SortPriority) + 1, MaxValue(PriorityBits));
+	}
+}
+
+uint32 FMeshBatchSorter::FindOrAddId(TFlatMap<uint64, uint32>& Ids, uint64 Key, uint32 MaxId)
+{
+	if (const uint32* Id = Ids.Find(Key))
+	{
+		return *Id;
+	}
+	const uint32 NewId = std::min(static_cast<uint32>(Ids.Num()), MaxId);
+	Ids.Add(Key, NewId);
+	return NewId;
+}
+
+void FMeshBatchSorter::AssignKeys(TArray<FMeshBatchElement>& InOutBatches, EMeshSortMode Mode, const FMatrix& ViewMatrix)
+{
+	ProgramIds.Reset();
+	MaterialIds.Reset();
+	GeometryIds.Reset();
+
+	const uint32 GeometryBits = (Mode == EMeshSortMode::Translucent) ? TranslucentGeometryBits : OpaqueGeometryBits;
+
+	// 같은 컴포넌트의 섹션은 연달아 수집되므로 직전 배치와 같으면 조회를 건너뜀
+	uint64 LastProgramKey = 0, LastMaterialKey = 0, LastGeometryKey = 0;
+	uint32 ProgramId = 0, MaterialId = 0, GeometryId = 0;
+	bool bHasLast = false;
+
+	for (FMeshBatchElement& Batch : InOutBatches)
+	{
+		if (Mode == EMeshSortMode::Shadow)
+		{
+			// DepthOnly_VS의 스키닝/비스키닝 변형만 바뀜
+			ProgramId = Batch.GPUSkinMatrixSRV ? 1 : 0;
+			MaterialId = 0;
+		}
+		else
+		{
+			const uint64 ProgramKey = MakeProgramKey(Batch);
+			if (!bHasLast || ProgramKey != LastProgramKey)
+			{
+				ProgramId = FindOrAddId(ProgramIds, ProgramKey, static_cast<uint32>(MaxValue(ProgramBits)));
+				LastProgramKey = ProgramKey;
+			}
+			const uint64 MaterialKey = MakeMaterialKey(Batch);
+			if (!bHasLast || MaterialKey != LastMaterialKey)
+			{
+				MaterialId = FindOrAddId(MaterialIds, MaterialKey, static_cast<uint32>(MaxValue(MaterialBits)));
+				LastMaterialKey = MaterialKey;
+			}
+		}
+
+		const uint64 GeometryKey = MakeGeometryKey(Batch);
+		if (!bHasLast || GeometryKey != LastGeometryKey)
+		{
+			GeometryId = FindOrAddId(GeometryIds, GeometryKey, static_cast<uint32>(MaxValue(GeometryBits)));
+			LastGeometryKey = GeometryKey;
+		}
+		bHasLast = true;
+
+		const uint64 Priority = MakePriority(Batch);
+		if (Mode == EMeshSortMode::Translucent)
+		{
+			const uint64 FarToNear = MaxValue(TranslucentDepthBits) - QuantizeDepth(Batch, ViewMatrix, TranslucentDepthBits);
+			Batch.SortKey = (Priority << 56) | (FarToNear << 40) | (static_cast<uint64>(ProgramId) << 28) |
+				(static_cast<uint64>(MaterialId) << 14) | GeometryId;
+		}
+		else
+		{
+			const uint64 NearToFar = QuantizeDepth(Batch, ViewMatrix, OpaqueDepthBits);
+			Batch.SortKey = (Priority << 56) | (static_cast<uint64>(ProgramId) << 44) | (static_cast<uint64>(MaterialId) << 30) |
+				(static_cast<uint64>(GeometryId) << 14) | NearToFar;
+		}
+	}
+}
+
+void FMeshBatchSorter::Sort(TArray<FMeshBatchElement>& InOutBatches)
+{
+	const int32 NumBatches = InOutBatches.Num();
+	if (NumBatches < 2)
+	{
+		return;
+	}
+
+	Entries.SetNum(NumBatches);
+	for (int32 Index = 0; Index < NumBatches; ++Index)
+	{
+		Entries[Index].Key = InOutBatches[Index].SortKey;
+		Entries[Index].Index = static_cast<uint32>(Index);
+	}
+
+	RadixSort(Entries, EntryScratch);
+
+	// 이미 정렬돼 있으면 재배열 생략
+	bool bIdentity = true;
+	for (int32 Index = 0; Index < NumBatches && bIdentity; ++Index)
+	{
+		bIdentity = (Entries[Index].Index == static_cast<uint32>(Index));
+	}
+	if (bIdentity)
+	{
+		return;
+	}
+
+	// 큰 구조체는 정렬 중에 옮기지 않고 마지막에 한 번만 모음
+	SortedBatches.SetNum(NumBatches);
+	ParallelFor(NumBatches, [&](int32 Index)
+	{
+		SortedBatches[Index] = InOutBatches[Entries[Index].Index];
+	}, GatherGrainSize);
+	InOutBatches.swap(SortedBatches);
+}
+
+void FMeshBatchSorter::RadixSort(TArray<FMeshBatchSortEntry>& InOutEntries, TArray<FMeshBatchSortEntry>& Scratch)
+{
+	const int32 N = InOutEntries.Num();
+	if (N < 2)
+	{
+		return;
+	}
+
+	// 작은 리스트는 패스 8번보다 비교 정렬이 쌈 (인덱스로 동률을 깨서 안정 정렬과 같은 결과)
+	if (N <= 256)
+	{
+		std::sort(InOutEntries.begin(), InOutEntries.end(), [](const FMeshBatchSortEntry& A, const FMeshBatchSortEntry& B)
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Index < B.Index;
+		});
+		return;
+	}
+
+	Scratch.SetNum(N);
+	const int32 NumChunks = (N + RadixGrainSize - 1) / RadixGrainSize;
+
+	TArray<uint32> Offsets;
+	Offsets.resize(size_t(NumChunks) * RadixBuckets);
+
+	FMeshBatchSortEntry* Src = InOutEntries.data();
+	FMeshBatchSortEntry* Dst = Scratch.data();
+	for (int32 Shift = 0; Shift < 64; Shift += RadixBits)
+	{
+		std::fill(Offsets.begin(), Offsets.end(), 0u);
+		ParallelFor(NumChunks, [&](int32 Chunk)
+		{
+			uint32* Histogram = &Offsets[size_t(Chunk) * RadixBuckets];
+			const int32 End = std::min(N, (Chunk + 1) * RadixGrainSize);
+			for (int32 i = Chunk * RadixGrainSize; i < End; ++i)
+			{
+				++Histogram[(Src[i].Key >> Shift) & (RadixBuckets - 1)];
+			}
+		});
+
+		// 모든 키가 한 버킷이면 이 자릿수는 건너뜀 (우선순위/프로그램 비트는 대부분 같음)
+		uint32 Running = 0;
+		bool bSingleBucket = false;
+		for (int32 Bucket = 0; Bucket < RadixBuckets; ++Bucket)
+		{
+			uint32 BucketCount = 0;
+			for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+			{
+				uint32& Slot = Offsets[size_t(Chunk) * RadixBuckets + Bucket];
+				const uint32 Count = Slot;
+				Slot = Running;
+				Running += Count;
+				BucketCount += Count;
+			}
+			bSingleBucket |= (BucketCount == uint32(N));
+		}
+		if (bSingleBucket)
+		{
+			continue;
+		}
+
+		ParallelFor(NumChunks, [&](int32 Chunk)
+		{
+			uint32* ChunkOffsets = &Offsets[size_t(Chunk) * RadixBuckets];
+			const int32 End = std::min(N, (Chunk + 1) * RadixGrainSize);
+			for (int32 i = Chunk * RadixGrainSize; i < End; ++i)
+			{
+				Dst[ChunkOffsets[(Src[i].Key >> Shift) & (RadixBuckets - 1)]++] = Src[i];
+			}
+		});
+		std::swap(Src, Dst);
+	}
+
+	if (Src != InOutEntries.data())
+	{
+		std::copy(Src, Src + N, InOutEntries.data());
+	}
+}
+
+FMeshBatchStateChanges FMeshBatchSorter::CountStateChanges(const TArray<FMeshBatchElement>& Batches)
+{
+	FMeshBatchStateChanges Changes;
+	const FMeshBatchElement* Prev = nullptr;
+	for (const FMeshBatchElement& Batch : Batches)
+	{
+		if (!Prev || Batch.VertexShader != Prev->VertexShader || Batch.PixelShader != Prev->PixelShader)
+		{
+			++Changes.Shader;
+		}
+		if (!Prev || Batch.Material != Prev->Material || Batch.InstanceShaderResourceView != Prev->InstanceShaderResourceView)
+		{
+			++Changes.Material;
+		}
+		if (!Prev || Batch.VertexBuffer != Prev->VertexBuffer || Batch.IndexBuffer != Prev->IndexBuffer ||
+			Batch.VertexStride != Prev->VertexStride || Batch.PrimitiveTopology != Prev->PrimitiveTopology)
+		{
+			++Changes.Geometry;
+		}
+		Prev = &Batch;
+	}
+	return Changes;
+}
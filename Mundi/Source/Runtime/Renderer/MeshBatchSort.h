@@ -0,0 +1,71 @@
+﻿#pragma once
+#include "MeshBatchElement.h"
+
+// 정렬 키 구성 방식
+enum class EMeshSortMode : uint8
+{
+	Opaque,			// 상태 우선, 같은 상태 안에서 앞→뒤
+	Translucent,	// 뒤→앞 우선, 같은 깊이 구간 안에서 상태
+	Shadow,			// 스키닝 여부 + 지오메트리 (섀도우 패스는 셰이더/머티리얼이 고정)
+};
+
+// 정렬 키 (인덱스는 원래 배치 위치)
+struct FMeshBatchSortEntry
+{
+	uint64 Key = 0;
+	uint32 Index = 0;
+};
+
+// 상태 변경 횟수 (DrawMeshBatches의 캐싱 기준과 같음)
+struct FMeshBatchStateChanges
+{
+	uint32 Shader = 0;		// VS/PS
+	uint32 Material = 0;	// 머티리얼 또는 인스턴스 SRV
+	uint32 Geometry = 0;	// VB/IB/스트라이드/토폴로지
+
+	uint32 GetTotal() const { return Shader + Material + Geometry; }
+};
+
+// FMeshBatchElement 리스트 정렬 (64비트 키 + 병렬 LSD radix sort)
+// - 수집 직후 AssignKeys로 배치마다 키를 채우고 Sort로 (키, 인덱스) 쌍만 정렬한 뒤 배치를 한 번에 재배열
+// - 셰이더/머티리얼/지오메트리는 포인터 대신 이번 호출에서 처음 본 순서로 붙인 작은 ID (비트가 모자라면 마지막 ID로 묶음)
+// - 키 레이아웃 (상위 → 하위)
+//   Opaque:      Priority 8 | Program 12 | Material 14 | Geometry 16 | Depth 14 (앞→뒤)
+//   Translucent: Priority 8 | ~Depth 16 (뒤→앞) | Program 12 | Material 14 | Geometry 14
+//   Shadow:      Priority 8 | Skinned 12 | 0 14 | Geometry 16 | Depth 14
+// - Depth는 뷰 공간 Z(월드 행렬 이동 성분) float 비트의 상위 비트 (로그 분포 버킷)
+class FMeshBatchSorter
+{
+public:
+	FMeshBatchSorter() = default;
+
+	static constexpr int32 RadixBits = 8;
+	static constexpr int32 RadixBuckets = 1 << RadixBits;
+	static constexpr int32 RadixGrainSize = 2048;
+
+	void AssignKeys(TArray<FMeshBatchElement>& InOutBatches, EMeshSortMode Mode, const FMatrix& ViewMatrix);
+	// SortKey 기준으로 안정 정렬
+	void Sort(TArray<FMeshBatchElement>& InOutBatches);
+	void AssignKeysAndSort(TArray<FMeshBatchElement>& InOutBatches, EMeshSortMode Mode, const FMatrix& ViewMatrix)
+	{
+		AssignKeys(InOutBatches, Mode, ViewMatrix);
+		Sort(InOutBatches);
+	}
+
+	// 청크별 히스토그램(병렬) → 버킷-청크 순 접두합 → 청크별 분산(병렬). 모든 키가 한 버킷인 자릿수는 건너뜀
+	static void RadixSort(TArray<FMeshBatchSortEntry>& InOutEntries, TArray<FMeshBatchSortEntry>& Scratch);
+
+	static FMeshBatchStateChanges CountStateChanges(const TArray<FMeshBatchElement>& Batches);
+
+private:
+	static uint32 FindOrAddId(TFlatMap<uint64, uint32>& Ids, uint64 Key, uint32 MaxId);
+
+	TFlatMap<uint64, uint32> ProgramIds;
+	TFlatMap<uint64, uint32> MaterialIds;
+	TFlatMap<uint64, uint32> GeometryIds;
+
+	// 재사용 버퍼
+	TArray<FMeshBatchSortEntry> Entries;
+	TArray<FMeshBatchSortEntry> EntryScratch;
+	TArray<FMeshBatchElement> SortedBatches;
+};
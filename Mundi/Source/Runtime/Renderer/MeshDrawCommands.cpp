@@ -0,0 +1,229 @@
+﻿#include "pch.h"
+#include "MeshDrawCommands.h"
+#include "Material.h"
+#include "Texture.h"
+#include "ConstantBufferType.h"
+
+void FMeshPassRecording::Reset()
+{
+	Commands.Reset();
+	NumDraws = 0;
+}
+
+void FMeshPassRecording::Record(const TArray<FMeshBatchElement>& Batches, const FMeshDrawRecordContext& Context)
+{
+	Reset();
+	if (Batches.IsEmpty())
+	{
+		return;
+	}
+
+	// 배치당 명령 2~6개 (대부분은 상수 + 드로우)
+	Commands.Reserve(static_cast<uint32>(Batches.Num()) * 96);
+
+	// PS 리소스 초기화
+	ID3D11ShaderResourceView* NullSRVs[2] = { nullptr, nullptr };
+	Commands.SetShaderResources(ERHIShaderStage::Pixel, 0, 2, NullSRVs);
+	ID3D11SamplerState* NullSamplers[2] = { nullptr, nullptr };
+	Commands.SetSamplers(ERHIShaderStage::Pixel, 0, 2, NullSamplers);
+	Commands.UpdateConstantBuffer(FPixelConstBufferType{});
+
+	// 현재 GPU 상태 캐싱용 변수
+	ID3D11VertexShader* CurrentVertexShader = nullptr;
+	ID3D11PixelShader* CurrentPixelShader = nullptr;
+	UMaterialInterface* CurrentMaterial = nullptr;
+	ID3D11ShaderResourceView* CurrentInstanceSRV = nullptr;
+	ID3D11Buffer* CurrentVertexBuffer = nullptr;
+	ID3D11Buffer* CurrentIndexBuffer = nullptr;
+	UINT CurrentVertexStride = 0;
+	D3D11_PRIMITIVE_TOPOLOGY CurrentTopology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	// GPU 스키닝 (t12, t13)
+	ID3D11ShaderResourceView* CurrentSkinMatrixSRV = nullptr;
+	ID3D11ShaderResourceView* CurrentSkinNormalMatrixSRV = nullptr;
+	Commands.SetShaderResources(ERHIShaderStage::Vertex, 12, 2, NullSRVs);
+
+	// 드로우별 상수(모델/색상/SubUV/이미터/인스턴싱)를 한 번에 채워 두고, 재생 때 링 버퍼에 한 번만 올림
+	if (Context.bUseConstantBlocks)
+	{
+		Constants.Pack(Batches);
+		Commands.UploadConstantBlocks(Constants.GetBlocks().data(), static_cast<uint32>(Constants.GetBlocks().Num()));
+	}
+
+	for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+	{
+		const FMeshBatchElement& Batch = Batches[BatchIndex];
+
+		// --- 필수 요소 유효성 검사 ---
+		const bool bMissingShaders = (!Batch.VertexShader || !Batch.PixelShader);
+		const bool bMissingGeometry = (!Batch.VertexBuffer || !Batch.IndexBuffer || Batch.VertexStride == 0);
+		const bool bInvalidInstancing = Batch.bInstancedDraw && Batch.InstanceCount == 0;
+		if (bMissingShaders || bMissingGeometry || bInvalidInstancing)
+		{
+			continue;
+		}
+
+		// 1. 셰이더 상태 변경
+		if (Batch.VertexShader != CurrentVertexShader || Batch.PixelShader != CurrentPixelShader)
+		{
+			Commands.SetShaders(Batch.VertexShader, Batch.PixelShader, Batch.InputLayout);
+			CurrentVertexShader = Batch.VertexShader;
+			CurrentPixelShader = Batch.PixelShader;
+		}
+
+		// 2. 픽셀 상태 (텍스처, 샘플러, 재질 CBuffer)
+		// 'Material' 또는 'Instance SRV' 둘 중 하나라도 바뀌면 모든 픽셀 리소스를 다시 바인딩
+		if (Batch.Material != CurrentMaterial || Batch.InstanceShaderResourceView != CurrentInstanceSRV)
+		{
+			ID3D11ShaderResourceView* DiffuseTextureSRV = nullptr; // t0
+			ID3D11ShaderResourceView* NormalTextureSRV = nullptr;  // t1
+			FPixelConstBufferType PixelConst{};
+
+			if (Batch.Material)
+			{
+				PixelConst.Material = Batch.Material->GetMaterialInfo();
+				PixelConst.bHasMaterial = true;
+			}
+			else
+			{
+				PixelConst.Material = FMaterialInfo();
+				PixelConst.bHasMaterial = false;
+				PixelConst.bHasDiffuseTexture = false;
+				PixelConst.bHasNormalTexture = false;
+			}
+
+			// 1순위: 인스턴스 텍스처 (빌보드)
+			if (Batch.InstanceShaderResourceView)
+			{
+				DiffuseTextureSRV = Batch.InstanceShaderResourceView;
+				PixelConst.bHasDiffuseTexture = true;
+				PixelConst.bHasNormalTexture = false;
+			}
+			// 2순위: 머티리얼 텍스처 (스태틱 메시)
+			else if (Batch.Material)
+			{
+				const FMaterialInfo& MaterialInfo = Batch.Material->GetMaterialInfo();
+				if (!MaterialInfo.DiffuseTextureFileName.empty())
+				{
+					if (UTexture* TextureData = Batch.Material->GetTexture(EMaterialTextureSlot::Diffuse))
+					{
+						DiffuseTextureSRV = TextureData->GetShaderResourceView();
+						PixelConst.bHasDiffuseTexture = (DiffuseTextureSRV != nullptr);
+					}
+				}
+				if (!MaterialInfo.NormalTextureFileName.empty())
+				{
+					if (UTexture* TextureData = Batch.Material->GetTexture(EMaterialTextureSlot::Normal))
+					{
+						NormalTextureSRV = TextureData->GetShaderResourceView();
+						PixelConst.bHasNormalTexture = (NormalTextureSRV != nullptr);
+					}
+				}
+			}
+
+			ID3D11ShaderResourceView* Srvs[2] = { DiffuseTextureSRV, NormalTextureSRV };
+			Commands.SetShaderResources(ERHIShaderStage::Pixel, 0, 2, Srvs);
+
+			ID3D11SamplerState* Samplers[4] = { Context.DefaultSampler, Context.DefaultSampler, Context.ShadowSampler, Context.VSMSampler };
+			Commands.SetSamplers(ERHIShaderStage::Pixel, 0, 4, Samplers);
+
+			Commands.UpdateConstantBuffer(PixelConst);
+
+			CurrentMaterial = Batch.Material;
+			CurrentInstanceSRV = Batch.InstanceShaderResourceView;
+		}
+
+		if (Batch.GPUSkinMatrixSRV != CurrentSkinMatrixSRV || Batch.GPUSkinNormalMatrixSRV != CurrentSkinNormalMatrixSRV)
+		{
+			ID3D11ShaderResourceView* SkinSRVs[2] = { Batch.GPUSkinMatrixSRV, Batch.GPUSkinNormalMatrixSRV };
+			Commands.SetShaderResources(ERHIShaderStage::Vertex, 12, 2, SkinSRVs);
+			CurrentSkinMatrixSRV = Batch.GPUSkinMatrixSRV;
+			CurrentSkinNormalMatrixSRV = Batch.GPUSkinNormalMatrixSRV;
+		}
+
+		// 3. IA 상태 변경
+		if (Batch.VertexBuffer != CurrentVertexBuffer ||
+			Batch.IndexBuffer != CurrentIndexBuffer ||
+			Batch.VertexStride != CurrentVertexStride ||
+			Batch.PrimitiveTopology != CurrentTopology)
+		{
+			if (Batch.bInstancedDraw)
+			{
+				// 두 개의 VB: 0 = mesh, 1 = instance
+				FRHICmdSetVertexBuffers VertexBuffers{};
+				VertexBuffers.Buffers[0] = Batch.VertexBuffer;
+				VertexBuffers.Buffers[1] = Batch.InstanceVertexBuffer;
+				VertexBuffers.Strides[0] = Batch.VertexStride;
+				VertexBuffers.Strides[1] = Batch.InstanceStride;
+				VertexBuffers.Offsets[1] = Batch.InstanceStart * Batch.InstanceStride;
+				VertexBuffers.NumBuffers = 2;
+				Commands.SetVertexBuffers(VertexBuffers);
+			}
+			else
+			{
+				Commands.SetVertexBuffer(Batch.VertexBuffer, Batch.VertexStride);
+			}
+			Commands.SetIndexBuffer(Batch.IndexBuffer, DXGI_FORMAT_R32_UINT);
+			Commands.SetPrimitiveTopology(Batch.PrimitiveTopology);
+
+			CurrentVertexBuffer = Batch.VertexBuffer;
+			CurrentIndexBuffer = Batch.IndexBuffer;
+			CurrentVertexStride = Batch.VertexStride;
+			CurrentTopology = Batch.PrimitiveTopology;
+		}
+
+		// 4. 오브젝트별 상수
+		if (Context.bUseConstantBlocks)
+		{
+			Commands.BindConstantBlocks(Constants.GetDraws()[BatchIndex]);
+		}
+		else
+		{
+			// 자동 인스턴싱 배치는 행렬/색상/ID를 인스턴스 버퍼(t15)에서 읽으므로 시작 위치만 넘김
+			if (Batch.bAutoInstanced)
+			{
+				FInstancingBufferType InstancingBuffer{};
+				InstancingBuffer.InstanceOffset = Batch.InstanceStart;
+				Commands.UpdateConstantBuffer(InstancingBuffer);
+			}
+			else
+			{
+				Commands.UpdateConstantBuffer(ModelBufferType(Batch.WorldMatrix, Batch.WorldMatrix.InverseAffine().Transpose()));
+				Commands.UpdateConstantBuffer(ColorBufferType(Batch.InstanceColor, Batch.ObjectID));
+			}
+
+			// SubUV / 이미터 파라미터 (파티클에서만 필요)
+			FSubUVBufferType SubUVBuffer{};
+			if (Batch.SubImages_Horizontal > 1 || Batch.SubImages_Vertical > 1)
+			{
+				SubUVBuffer.SubImages_Horizontal = Batch.SubImages_Horizontal;
+				SubUVBuffer.SubImages_Vertical = Batch.SubImages_Vertical;
+				SubUVBuffer.InterpMethod = Batch.SubUV_InterpMethod;
+				SubUVBuffer.Padding0 = 0.0f;
+			}
+			Commands.UpdateConstantBuffer(SubUVBuffer);
+
+			if (Batch.ScreenAlignment != EScreenAlignment::None)
+			{
+				FParticleEmitterType ParticleEmitterType;
+				ParticleEmitterType.ScreenAlignment = static_cast<uint32>(Batch.ScreenAlignment);
+				Commands.UpdateConstantBuffer(ParticleEmitterType);
+			}
+		}
+
+		// 5. 드로우
+		if (Batch.bInstancedDraw)
+		{
+			Commands.DrawIndexedInstanced(Batch.IndexCount, Batch.InstanceCount, Batch.StartIndex, Batch.BaseVertexIndex, Batch.InstanceStart);
+		}
+		else if (Batch.bAutoInstanced)
+		{
+			// SV_InstanceID는 StartInstanceLocation을 더하지 않으므로 시작 위치는 b9 InstanceOffset으로 전달
+			Commands.DrawIndexedInstanced(Batch.IndexCount, Batch.InstanceCount, Batch.StartIndex, Batch.BaseVertexIndex, 0);
+		}
+		else
+		{
+			Commands.DrawIndexed(Batch.IndexCount, Batch.StartIndex, Batch.BaseVertexIndex);
+		}
+		++NumDraws;
+	}
+}
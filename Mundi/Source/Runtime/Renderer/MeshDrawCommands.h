@@ -0,0 +1,35 @@
+﻿#pragma once
+#include "RHICommandList.h"
+
+// 메시 패스 기록에 필요한 렌더러 상태 (기록 스레드는 RHI를 직접 건드리지 않음)
+struct FMeshDrawRecordContext
+{
+	ID3D11SamplerState* DefaultSampler = nullptr;
+	ID3D11SamplerState* ShadowSampler = nullptr;
+	ID3D11SamplerState* VSMSampler = nullptr;
+
+	// 드로우별 상수를 블록으로 묶어 링에 한 번 올림 (false면 드로우마다 UpdateConstantBuffer)
+	bool bUseConstantBlocks = false;
+};
+
+/**
+ * 메시 배치 리스트 하나를 명령 리스트로 기록한 결과 (DrawMeshBatches = Record + 백엔드 Execute)
+ * - 셰이더/머티리얼/스킨 SRV/IA 상태가 바뀔 때만 명령을 남기는 기존 캐싱을 그대로 기록
+ * - 상수 블록을 쓰면 블록 배열도 여기서 소유하므로 재생이 끝날 때까지 살아 있어야 함
+ * - 서로 다른 FMeshPassRecording은 동시에 기록 가능 (배치/머티리얼은 읽기만 함)
+ * - URenderer가 몇 개를 소유하고 프레임마다 재사용 (Reset은 용량 유지)
+ */
+class FMeshPassRecording
+{
+public:
+	void Record(const TArray<FMeshBatchElement>& Batches, const FMeshDrawRecordContext& Context);
+	void Reset();
+
+	const FRHICommandList& GetCommands() const { return Commands; }
+	int32 GetNumDraws() const { return NumDraws; }
+
+private:
+	FRHICommandList Commands;
+	FObjectConstantPacker Constants;
+	int32 NumDraws = 0;
+};
@@ -0,0 +1,83 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+// 불투명 패스 메시 드로우 통계 (FSceneRenderer::RenderOpaquePass가 채움)
+struct FMeshDrawStats
+{
+	uint32 NumBatches = 0;			// 수집된 FMeshBatchElement 수 (합치기 전 드로우 수)
+	uint32 NumDrawCalls = 0;		// 자동 인스턴싱 후 실제 드로우 수
+	uint32 NumInstancedDraws = 0;	// 그중 자동 인스턴싱 드로우
+	uint32 NumInstances = 0;		// 자동 인스턴싱 드로우로 그린 인스턴스 합
+	uint32 MaxInstancesPerDraw = 0;
+	float ReductionPercent = 0.0f;	// 줄어든 드로우 비율
+
+	// CPU 시간 (ms)
+	float MergeTimeMS = 0.0f;		// 배치 합치기 + 인스턴스 데이터 채우기
+	float UploadTimeMS = 0.0f;		// 인스턴스 버퍼 업로드
+
+	void Reset()
+	{
+		*this = FMeshDrawStats();
+	}
+
+	void CalculateStats()
+	{
+		ReductionPercent = NumBatches > 0 ? (static_cast<float>(NumBatches - NumDrawCalls) / static_cast<float>(NumBatches)) * 100.0f : 0.0f;
+	}
+};
+
+// 프레임 단위 버퍼 업로드 통계 (URenderer::EndFrame이 채움)
+struct FFrameUploadStats
+{
+	uint32 NumBufferMaps = 0;				// D3D11RHI를 거친 Map 호출 수 (모든 패스)
+	uint32 NumObjectConstantUploads = 0;	// 드로우별 상수 링 업로드 (DrawMeshBatches 호출당 1회)
+	uint32 NumObjectConstantDraws = 0;		// 링 블록 오프셋으로 그린 드로우 수
+	uint32 ObjectConstantBytes = 0;
+	bool bObjectConstantRingSupported = false;	// false면 항상 드로우마다 상수 버퍼 Map/Unmap
+};
+
+// 메시 드로우 통계 전역 매니저 (싱글톤)
+// UStatsOverlayD2D에서 접근할 수 있도록 마지막으로 그린 뷰의 통계 제공
+class FMeshDrawStatManager
+{
+public:
+	static FMeshDrawStatManager& GetInstance()
+	{
+		static FMeshDrawStatManager Instance;
+		return Instance;
+	}
+
+	void UpdateStats(const FMeshDrawStats& InStats)
+	{
+		CurrentStats = InStats;
+	}
+
+	const FMeshDrawStats& GetStats() const
+	{
+		return CurrentStats;
+	}
+
+	void UpdateFrameUploadStats(const FFrameUploadStats& InStats)
+	{
+		FrameUploadStats = InStats;
+	}
+
+	const FFrameUploadStats& GetFrameUploadStats() const
+	{
+		return FrameUploadStats;
+	}
+
+	void ResetStats()
+	{
+		CurrentStats.Reset();
+	}
+
+private:
+	FMeshDrawStatManager() = default;
+	~FMeshDrawStatManager() = default;
+	FMeshDrawStatManager(const FMeshDrawStatManager&) = delete;
+	FMeshDrawStatManager& operator=(const FMeshDrawStatManager&) = delete;
+
+	FMeshDrawStats CurrentStats;
+	FFrameUploadStats FrameUploadStats;
+};
@@ -0,0 +1,105 @@
+﻿#include "pch.h"
+#include "MeshLOD.h"
+#include "SceneView.h"
+#include "RenderSettings.h"
+#include "AABB.h"
+
+float MeshLOD::ComputeScreenSize(const FSceneView* View, const FAABB& WorldBounds)
+{
+    const float Radius = WorldBounds.GetHalfExtent().Size();
+    const FMatrix& Projection = View->ProjectionMatrix;
+    const float ScreenMultiple = std::max(0.5f * Projection.M[0][0], 0.5f * Projection.M[1][1]);
+
+    if (View->ProjectionMode == ECameraProjectionMode::Orthographic)
+    {
+        return 2.0f * ScreenMultiple * Radius;
+    }
+
+    const float Distance = (WorldBounds.GetCenter() - View->ViewLocation).Size();
+    return 2.0f * ScreenMultiple * Radius / std::max(1.0f, Distance);
+}
+
+int32 MeshLOD::SelectLOD(const FSceneView* View, const FAABB& WorldBounds, const TArray<FMeshLOD>& LODs, int32 CurrentLOD)
+{
+    const int32 NumLODs = static_cast<int32>(LODs.size()) + 1;
+    if (NumLODs == 1 || !View)
+    {
+        return 0;
+    }
+
+    float PixelErrorThreshold = 1.0f;
+    float Hysteresis = 0.0f;
+    if (View->RenderSettings)
+    {
+        const int32 ForcedLOD = View->RenderSettings->GetForcedLOD();
+        if (ForcedLOD >= 0)
+        {
+            return std::min(ForcedLOD, NumLODs - 1);
+        }
+        PixelErrorThreshold = View->RenderSettings->GetLODPixelError();
+        Hysteresis = View->RenderSettings->GetLODHysteresis();
+    }
+
+    const float ViewHeight = static_cast<float>(std::max(View->ViewRect.Height(), 1u));
+    const float PixelsPerDiagonal = ComputeScreenSize(View, WorldBounds) * ViewHeight;
+    auto GetPixelError = [&](int32 LOD)
+    {
+        return LOD == 0 ? 0.0f : LODs[LOD - 1].RelativeError * PixelsPerDiagonal;
+    };
+
+    CurrentLOD = std::clamp(CurrentLOD, 0, NumLODs - 1);
+
+    // 현재 LOD가 허용치를 넘으면 세밀한 쪽으로
+    if (GetPixelError(CurrentLOD) > PixelErrorThreshold * (1.0f + Hysteresis))
+    {
+        int32 LOD = CurrentLOD;
+        while (LOD > 0 && GetPixelError(LOD) > PixelErrorThreshold)
+        {
+            --LOD;
+        }
+        return LOD;
+    }
+
+    // 여유가 충분하면 거친 쪽으로
+    int32 LOD = CurrentLOD;
+    while (LOD + 1 < NumLODs && GetPixelError(LOD + 1) <= PixelErrorThreshold * (1.0f - Hysteresis))
+    {
+        ++LOD;
+    }
+    return LOD;
+}
+
+void MeshLOD::GetSectionRange(const TArray<FGroupInfo>& Groups, uint32 NumBaseIndices, const TArray<FMeshLOD>& LODs,
+    int32 LODIndex, uint32 SectionIndex, uint32& OutStartIndex, uint32& OutIndexCount)
+{
+    if (LODIndex <= 0 || LODIndex > static_cast<int32>(LODs.size()))
+    {
+        if (Groups.empty())
+        {
+            OutStartIndex = 0;
+            OutIndexCount = NumBaseIndices;
+        }
+        else
+        {
+            OutStartIndex = Groups[SectionIndex].StartIndex;
+            OutIndexCount = Groups[SectionIndex].IndexCount;
+        }
+        return;
+    }
+
+    uint32 LODBaseIndex = NumBaseIndices;
+    for (int32 i = 0; i < LODIndex - 1; ++i)
+    {
+        LODBaseIndex += static_cast<uint32>(LODs[i].Indices.size());
+    }
+
+    const FMeshLOD& LOD = LODs[LODIndex - 1];
+    if (SectionIndex >= LOD.Sections.size())
+    {
+        OutStartIndex = LODBaseIndex;
+        OutIndexCount = 0;
+        return;
+    }
+    OutStartIndex = LODBaseIndex + LOD.Sections[SectionIndex].StartIndex;
+    OutIndexCount = LOD.Sections[SectionIndex].IndexCount;
+}
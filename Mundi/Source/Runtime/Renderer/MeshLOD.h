@@ -0,0 +1,30 @@
+﻿#pragma once
+
+class FSceneView;
+struct FAABB;
+struct FGroupInfo;
+struct FMeshLOD;
+
+/**
+ * 런타임 LOD 선택 (UStaticMeshComponent / USkinnedMeshComponent 공용)
+ *
+ * - 화면 크기: 바운드 구의 투영 지름 / 뷰 높이 (UE의 ComputeBoundsScreenSize와 같은 정의)
+ * - LOD k의 픽셀 오차 = RelativeError(대각선 대비) * 화면 크기 * 뷰 높이(픽셀)
+ *   → URenderSettings의 LODPixelError 이하인 가장 거친 LOD 선택
+ * - 경계에서 깜빡이지 않도록 더 거친 LOD로는 허용치의 (1 - Hysteresis)배 이하일 때만,
+ *   더 세밀한 LOD로는 현재 LOD 오차가 (1 + Hysteresis)배를 넘을 때만 전환
+ */
+namespace MeshLOD
+{
+    float ComputeScreenSize(const FSceneView* View, const FAABB& WorldBounds);
+
+    /** @return 0(원본) ~ LODs.size() */
+    int32 SelectLOD(const FSceneView* View, const FAABB& WorldBounds, const TArray<FMeshLOD>& LODs, int32 CurrentLOD);
+
+    /**
+     * GPU 인덱스 버퍼(LOD0 뒤로 LOD1, LOD2... 이어붙임) 기준 섹션 범위
+     * 그룹이 없으면 SectionIndex 0이 전체 범위
+     */
+    void GetSectionRange(const TArray<FGroupInfo>& Groups, uint32 NumBaseIndices, const TArray<FMeshLOD>& LODs,
+        int32 LODIndex, uint32 SectionIndex, uint32& OutStartIndex, uint32& OutIndexCount);
+}
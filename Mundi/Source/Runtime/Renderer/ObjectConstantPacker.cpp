@@ -0,0 +1,90 @@
+﻿#include "pch.h"
+#include "ObjectConstantPacker.h"
+#include "ConstantBufferType.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+
+namespace
+{
+	template<typename T>
+	void WriteBlock(FObjectConstantBlock& Block, const T& Data)
+	{
+		static_assert(sizeof(T) <= sizeof(FObjectConstantBlock), "Constant buffer type does not fit in one block");
+		std::memcpy(Block.Data, &Data, sizeof(T));
+	}
+}
+
+uint32 FObjectConstantPacker::CountBlocks(const FMeshBatchElement& Batch)
+{
+	// DrawMeshBatches가 드로우마다 올리던 상수와 같은 구성
+	uint32 NumBlocks = Batch.bAutoInstanced ? 1 : 2;
+	if (Batch.SubImages_Horizontal > 1 || Batch.SubImages_Vertical > 1)
+	{
+		++NumBlocks;
+	}
+	if (Batch.ScreenAlignment != EScreenAlignment::None)
+	{
+		++NumBlocks;
+	}
+	return NumBlocks;
+}
+
+void FObjectConstantPacker::Pack(const TArray<FMeshBatchElement>& Batches)
+{
+	const int32 NumBatches = Batches.Num();
+
+	// 1. 배치별 첫 블록 (0번은 기본 SubUV)
+	FirstBlocks.SetNum(NumBatches);
+	uint32 NumBlocks = 1;
+	for (int32 Index = 0; Index < NumBatches; ++Index)
+	{
+		FirstBlocks[Index] = NumBlocks;
+		NumBlocks += CountBlocks(Batches[Index]);
+	}
+
+	Blocks.SetNum(NumBlocks);
+	Draws.SetNum(NumBatches);
+	WriteBlock(Blocks[DefaultSubUVBlock], FSubUVBufferType{});
+
+	// 2. 블록 채우기 (배치마다 쓰는 범위가 겹치지 않음)
+	ParallelFor(NumBatches, [&](int32 Index)
+	{
+		const FMeshBatchElement& Batch = Batches[Index];
+		FObjectConstantDraw& Draw = Draws[Index];
+		Draw = FObjectConstantDraw();
+
+		uint32 Block = FirstBlocks[Index];
+		if (Batch.bAutoInstanced)
+		{
+			// 행렬/색상/ID는 인스턴스 버퍼(t15)에서 읽으므로 시작 위치만
+			FInstancingBufferType InstancingBuffer{};
+			InstancingBuffer.InstanceOffset = Batch.InstanceStart;
+			Draw.Instancing = Block;
+			WriteBlock(Blocks[Block++], InstancingBuffer);
+		}
+		else
+		{
+			Draw.Model = Block;
+			WriteBlock(Blocks[Block++], ModelBufferType(Batch.WorldMatrix, Batch.WorldMatrix.InverseAffine().Transpose()));
+			Draw.Color = Block;
+			WriteBlock(Blocks[Block++], ColorBufferType(Batch.InstanceColor, Batch.ObjectID));
+		}
+
+		if (Batch.SubImages_Horizontal > 1 || Batch.SubImages_Vertical > 1)
+		{
+			FSubUVBufferType SubUVBuffer{};
+			SubUVBuffer.SubImages_Horizontal = Batch.SubImages_Horizontal;
+			SubUVBuffer.SubImages_Vertical = Batch.SubImages_Vertical;
+			SubUVBuffer.InterpMethod = Batch.SubUV_InterpMethod;
+			Draw.SubUV = Block;
+			WriteBlock(Blocks[Block++], SubUVBuffer);
+		}
+
+		if (Batch.ScreenAlignment != EScreenAlignment::None)
+		{
+			FParticleEmitterType ParticleEmitterType{};
+			ParticleEmitterType.ScreenAlignment = static_cast<uint32>(Batch.ScreenAlignment);
+			Draw.Emitter = Block;
+			WriteBlock(Blocks[Block++], ParticleEmitterType);
+		}
+	}, 256);
+}
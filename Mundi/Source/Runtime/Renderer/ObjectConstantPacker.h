@@ -0,0 +1,59 @@
+﻿#pragma once
+#include "MeshBatchElement.h"
+
+// 상수 버퍼 뷰 하나 (VSSetConstantBuffers1의 오프셋/크기는 16 상수 = 256바이트 단위)
+struct alignas(16) FObjectConstantBlock
+{
+	uint8 Data[256];
+};
+
+// 드로우 하나가 바인딩할 블록 번호 (FObjectConstantPacker 결과 안의 인덱스)
+struct FObjectConstantDraw
+{
+	static constexpr uint32 None = ~0u;
+
+	uint32 Model = None;		// b0 VS  ModelBufferType
+	uint32 Color = None;		// b3 VS/PS  ColorBufferType
+	uint32 SubUV = 0;			// b2 VS/PS  FSubUVBufferType (0번은 기본값 공용 블록)
+	uint32 Emitter = None;		// b3 VS  FParticleEmitterType (Color의 VS 바인딩을 덮어씀)
+	uint32 Instancing = None;	// b9 VS  FInstancingBufferType (자동 인스턴싱 드로우)
+
+	// 아직 링 블록이 바인딩되지 않은 상태 (FObjectConstantRing::BindDraw의 시작값)
+	static FObjectConstantDraw Unbound()
+	{
+		FObjectConstantDraw Draw;
+		Draw.SubUV = None;
+		return Draw;
+	}
+};
+
+// 패스의 드로우별 상수(모델/색상/SubUV/이미터/인스턴싱)를 블록 배열 하나로 채움
+// - D3D 없이 동작 (블록 배치 규칙과 내용은 GetBlockAs로 확인 가능)
+// - 블록 수 접두합은 순차, 채우기(노멀 행렬 역행렬이 대부분)는 ParallelFor
+class FObjectConstantPacker
+{
+public:
+	static constexpr uint32 BlockSize = sizeof(FObjectConstantBlock);
+	static constexpr uint32 ConstantsPerBlock = BlockSize / 16;
+	static constexpr uint32 DefaultSubUVBlock = 0;
+
+	void Pack(const TArray<FMeshBatchElement>& Batches);
+
+	const TArray<FObjectConstantBlock>& GetBlocks() const { return Blocks; }
+	const TArray<FObjectConstantDraw>& GetDraws() const { return Draws; }
+
+	template<typename T>
+	const T& GetBlockAs(uint32 BlockIndex) const
+	{
+		static_assert(sizeof(T) <= BlockSize, "Constant buffer type does not fit in one block");
+		return *reinterpret_cast<const T*>(Blocks[BlockIndex].Data);
+	}
+
+	// 배치 하나가 새로 쓰는 블록 수 (기본 SubUV 블록 제외)
+	static uint32 CountBlocks(const FMeshBatchElement& Batch);
+
+private:
+	TArray<FObjectConstantBlock> Blocks;
+	TArray<FObjectConstantDraw> Draws;
+	TArray<uint32> FirstBlocks;		// 배치 → 첫 블록
+};
@@ -0,0 +1,150 @@
+﻿#include "pch.h"
+#include "ObjectConstantRing.h"
+#include "D3D11RHI.h"
+#include <d3d11_1.h>
+
+FObjectConstantRing::~FObjectConstantRing()
+{
+	Release();
+}
+
+bool FObjectConstantRing::IsSupported(D3D11RHI* RHIDevice)
+{
+	if (bChecked)
+	{
+		return bSupported;
+	}
+	bChecked = true;
+
+	if (!RHIDevice || !RHIDevice->GetDevice() || !RHIDevice->GetDeviceContext())
+	{
+		return false;
+	}
+
+	D3D11_FEATURE_DATA_D3D11_OPTIONS Options = {};
+	if (FAILED(RHIDevice->GetDevice()->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &Options, sizeof(Options))) ||
+		!Options.ConstantBufferOffsetting)
+	{
+		UE_LOG("[ObjectConstantRing] 상수 버퍼 오프셋 미지원 → 드로우별 상수 버퍼 업데이트 사용");
+		return false;
+	}
+	if (FAILED(RHIDevice->GetDeviceContext()->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&Context1))))
+	{
+		Context1 = nullptr;
+		return false;
+	}
+
+	bNoOverwrite = Options.MapNoOverwriteOnDynamicConstantBuffer != FALSE;
+	bSupported = true;
+	return true;
+}
+
+bool FObjectConstantRing::Upload(D3D11RHI* RHIDevice, const FObjectConstantBlock* Blocks, uint32 NumBlocks, uint32& OutBaseBlock)
+{
+	if (!Blocks || NumBlocks == 0 || !IsSupported(RHIDevice))
+	{
+		return false;
+	}
+
+	if (NumBlocks > Cursor.CapacityBlocks)
+	{
+		if (RingBuffer) { RingBuffer->Release(); RingBuffer = nullptr; }
+
+		const uint32 NewCapacity = FObjectConstantRingCursor::GrowCapacity(Cursor.CapacityBlocks, InitialBlockCapacity, NumBlocks);
+
+		D3D11_BUFFER_DESC Desc = {};
+		Desc.Usage = D3D11_USAGE_DYNAMIC;
+		Desc.ByteWidth = NewCapacity * FObjectConstantPacker::BlockSize;
+		Desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		Desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		if (FAILED(RHIDevice->GetDevice()->CreateBuffer(&Desc, nullptr, &RingBuffer)))
+		{
+			UE_LOG("[ObjectConstantRing] 링 버퍼 생성 실패 (%u blocks)", NewCapacity);
+			RingBuffer = nullptr;
+			Cursor.Reset(0);
+			return false;
+		}
+		Cursor.Reset(NewCapacity);
+	}
+
+	uint32 BaseBlock = 0;
+	const bool bDiscard = Cursor.Reserve(NumBlocks, bNoOverwrite, RHIDevice->IsDeferredRecording(), RHIDevice->GetNumFinishedRecordings(), BaseBlock);
+
+	D3D11_MAPPED_SUBRESOURCE Mapped;
+	if (FAILED(RHIDevice->GetDeviceContext()->Map(RingBuffer, 0, bDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &Mapped)))
+	{
+		Cursor.Invalidate();
+		return false;
+	}
+	RHIDevice->CountBufferMap();
+
+	const uint32 Bytes = NumBlocks * FObjectConstantPacker::BlockSize;
+	std::memcpy(static_cast<uint8*>(Mapped.pData) + size_t(BaseBlock) * FObjectConstantPacker::BlockSize, Blocks, Bytes);
+	RHIDevice->GetDeviceContext()->Unmap(RingBuffer, 0);
+
+	OutBaseBlock = BaseBlock;
+
+	++FrameUploads;
+	FrameBytes += Bytes;
+	return true;
+}
+
+void FObjectConstantRing::BindDraw(const FObjectConstantDraw& Draw, uint32 BaseBlock, FObjectConstantDraw& InOutBound)
+{
+	auto Bind = [this](bool bVS, bool bPS, UINT Slot, uint32 AbsoluteBlock)
+	{
+		const UINT NumConstants = FObjectConstantPacker::ConstantsPerBlock;
+		const UINT FirstConstant = AbsoluteBlock * NumConstants;
+		if (bVS) { Context1->VSSetConstantBuffers1(Slot, 1, &RingBuffer, &FirstConstant, &NumConstants); }
+		if (bPS) { Context1->PSSetConstantBuffers1(Slot, 1, &RingBuffer, &FirstConstant, &NumConstants); }
+	};
+
+	// 자동 인스턴싱 드로우는 b0/b3을 읽지 않으므로 이전 바인딩을 그대로 둠
+	if (Draw.Model != FObjectConstantDraw::None && BaseBlock + Draw.Model != InOutBound.Model)
+	{
+		InOutBound.Model = BaseBlock + Draw.Model;
+		Bind(true, false, ModelBufferTypeSlot, InOutBound.Model);
+	}
+
+	if (Draw.Color != FObjectConstantDraw::None && BaseBlock + Draw.Color != InOutBound.Color)
+	{
+		InOutBound.Color = BaseBlock + Draw.Color;
+		Bind(false, true, ColorBufferTypeSlot, InOutBound.Color);
+	}
+
+	const uint32 VSSlot3 = Draw.Emitter != FObjectConstantDraw::None ? Draw.Emitter : Draw.Color;
+	if (VSSlot3 != FObjectConstantDraw::None && BaseBlock + VSSlot3 != InOutBound.Emitter)
+	{
+		InOutBound.Emitter = BaseBlock + VSSlot3;
+		Bind(true, false, FParticleEmitterTypeSlot, InOutBound.Emitter);
+	}
+
+	if (BaseBlock + Draw.SubUV != InOutBound.SubUV)
+	{
+		InOutBound.SubUV = BaseBlock + Draw.SubUV;
+		Bind(true, true, FSubUVBufferTypeSlot, InOutBound.SubUV);
+	}
+
+	if (Draw.Instancing != FObjectConstantDraw::None && BaseBlock + Draw.Instancing != InOutBound.Instancing)
+	{
+		InOutBound.Instancing = BaseBlock + Draw.Instancing;
+		Bind(true, false, FInstancingBufferTypeSlot, InOutBound.Instancing);
+	}
+}
+
+void FObjectConstantRing::RestoreDefaultBindings(D3D11RHI* RHIDevice)
+{
+	RHIDevice->SetConstantBuffer(ModelBufferType());
+	RHIDevice->SetConstantBuffer(FSubUVBufferType());
+	RHIDevice->SetConstantBuffer(ColorBufferType());
+	RHIDevice->SetConstantBuffer(FInstancingBufferType());
+}
+
+void FObjectConstantRing::Release()
+{
+	if (RingBuffer) { RingBuffer->Release(); RingBuffer = nullptr; }
+	if (Context1) { Context1->Release(); Context1 = nullptr; }
+	Cursor = FObjectConstantRingCursor();
+	bChecked = false;
+	bSupported = false;
+}
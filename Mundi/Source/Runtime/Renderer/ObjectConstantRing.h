@@ -0,0 +1,108 @@
+﻿#pragma once
+#include "ObjectConstantPacker.h"
+
+class D3D11RHI;
+struct ID3D11DeviceContext1;
+
+// 링 안의 쓰기 위치와 Map 방식 (D3D 없이 동작하므로 FObjectConstantRing과 따로 검사 가능)
+// - 앞선 업로드 뒤에 이어서 쓸 수 있으면 NO_OVERWRITE, 끝에 닿거나 새 지연 기록이 시작되면 0번부터 DISCARD
+// - 위치는 블록(256바이트 = 16 상수) 단위라 VSSetConstantBuffers1의 오프셋 규칙을 항상 만족
+struct FObjectConstantRingCursor
+{
+	uint32 CapacityBlocks = 0;
+	uint32 CursorBlock = 0;
+	uint64 RecordingIndex = ~0ull;	// 마지막으로 Map한 지연 기록 (D3D11RHI::GetNumFinishedRecordings)
+
+	// 용량이 바뀐 새 버퍼는 DISCARD로 시작
+	void Reset(uint32 NewCapacityBlocks)
+	{
+		CapacityBlocks = NewCapacityBlocks;
+		CursorBlock = NewCapacityBlocks;
+	}
+
+	// Map이 실패해 버퍼 내용을 알 수 없으면 다음 업로드를 DISCARD로
+	void Invalidate() { CursorBlock = CapacityBlocks; }
+
+	// NumBlocks(<= CapacityBlocks)를 쓸 위치를 잡고 커서를 옮김. DISCARD로 Map해야 하면 true
+	// bNoOverwrite: 장치가 동적 상수 버퍼 NO_OVERWRITE를 지원하는지
+	// bDeferred: 지연 컨텍스트 기록 중 (명령 리스트마다 첫 Map이 DISCARD여야 함)
+	bool Reserve(uint32 NumBlocks, bool bNoOverwrite, bool bDeferred, uint64 NumFinishedRecordings, uint32& OutBaseBlock)
+	{
+		bool bNewRecording = false;
+		if (bDeferred && RecordingIndex != NumFinishedRecordings)
+		{
+			RecordingIndex = NumFinishedRecordings;
+			bNewRecording = true;
+		}
+
+		// 앞선 패스가 쓴 블록은 GPU가 아직 읽을 수 있으므로 이어서 쓰고, 끝에 닿으면 버퍼를 통째로 교체
+		const bool bDiscard = !bNoOverwrite || bNewRecording || CursorBlock + NumBlocks > CapacityBlocks;
+		if (bDiscard)
+		{
+			CursorBlock = 0;
+		}
+		OutBaseBlock = CursorBlock;
+		CursorBlock += NumBlocks;
+		return bDiscard;
+	}
+
+	// NumBlocks 이상이 되도록 2배씩 키운 용량
+	static uint32 GrowCapacity(uint32 CurrentBlocks, uint32 MinBlocks, uint32 NumBlocks)
+	{
+		uint32 NewCapacity = std::max(CurrentBlocks, MinBlocks);
+		while (NewCapacity < NumBlocks)
+		{
+			NewCapacity *= 2;
+		}
+		return NewCapacity;
+	}
+};
+
+// 드로우별 Map/Unmap 대신 패스마다 한 번 올리는 동적 상수 버퍼 링
+// - FObjectConstantPacker가 채운 블록을 이어서 쓰고(NO_OVERWRITE) 끝에 닿거나 새 지연 기록이 시작되면 처음부터 다시 씀(DISCARD)
+// - 드로우는 VS/PSSetConstantBuffers1로 자기 블록 오프셋만 바인딩 (셰이더 변경 없음)
+// - D3D11.1 상수 버퍼 오프셋을 지원하지 않는 장치면 IsSupported()가 false → 기존 드로우별 업데이트 사용
+// - URenderer가 소유해 뷰/프레임 사이에 재사용 (모자라면 2배로 키움)
+class FObjectConstantRing
+{
+public:
+	static constexpr uint32 InitialBlockCapacity = 4096;	// 1MB
+
+	FObjectConstantRing() = default;
+	~FObjectConstantRing();
+
+	bool IsSupported(D3D11RHI* RHIDevice);
+
+	// 성공하면 OutBaseBlock에 이번 업로드의 링 안 시작 블록
+	// 블록 배열은 명령 리스트(FMeshPassRecording)가 소유하고 D3D11 백엔드가 재생 중에 올림
+	bool Upload(D3D11RHI* RHIDevice, const FObjectConstantBlock* Blocks, uint32 NumBlocks, uint32& OutBaseBlock);
+
+	// 바뀐 슬롯만 다시 바인딩. InOutBound는 링 기준 절대 블록 번호 (패스 시작 때 Unbound())
+	// b3은 VS(Color 또는 Emitter)와 PS(Color)가 다를 수 있어 InOutBound.Emitter에 VS b3, Color에 PS b3을 기록
+	void BindDraw(const FObjectConstantDraw& Draw, uint32 BaseBlock, FObjectConstantDraw& InOutBound);
+
+	// b0/b2/b3/b9를 RHI의 전용 상수 버퍼로 되돌림 (이후 UpdateConstantBuffer만 쓰는 코드용)
+	void RestoreDefaultBindings(D3D11RHI* RHIDevice);
+
+	// 프레임 통계 (URenderer::EndFrame에서 읽고 초기화)
+	uint32 GetFrameUploads() const { return FrameUploads; }
+	uint32 GetFrameDraws() const { return FrameDraws; }
+	uint32 GetFrameBytes() const { return FrameBytes; }
+	void AddFrameDraws(uint32 Count) { FrameDraws += Count; }
+	void ResetFrameStats() { FrameUploads = FrameDraws = FrameBytes = 0; }
+
+	void Release();
+
+private:
+	ID3D11Buffer* RingBuffer = nullptr;
+	ID3D11DeviceContext1* Context1 = nullptr;
+	FObjectConstantRingCursor Cursor;
+
+	bool bChecked = false;
+	bool bSupported = false;
+	bool bNoOverwrite = false;	// 동적 상수 버퍼 MAP_WRITE_NO_OVERWRITE 지원
+
+	uint32 FrameUploads = 0;
+	uint32 FrameDraws = 0;
+	uint32 FrameBytes = 0;
+};
@@ -0,0 +1,76 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+// CPU 소프트웨어 오클루전 컬링 통계 (FOcclusionCullingManagerCPU가 채움)
+struct FOcclusionStats
+{
+	// 깊이 버퍼 해상도
+	uint32 GridWidth = 0;
+	uint32 GridHeight = 0;
+
+	// 오클루더
+	uint32 NumOccluders = 0;
+	uint32 NumOccluderTriangles = 0;	// 선택된 오클루더 LOD의 삼각형 수
+	uint32 NumRasterizedTriangles = 0;	// 백페이스/화면 밖 제거, 근평면 클리핑 후 실제로 그린 삼각형 수
+
+	// 오클루디
+	uint32 NumTested = 0;
+	uint32 NumOccluded = 0;
+	float CulledPercent = 0.0f;
+
+	// CPU 시간 (ms)
+	float SetupTimeMS = 0.0f;		// 정점 변환 + 클리핑 + 타일 비닝
+	float RasterTimeMS = 0.0f;		// 타일 병렬 래스터화
+	float HZBTimeMS = 0.0f;
+	float TestTimeMS = 0.0f;
+
+	void Reset()
+	{
+		*this = FOcclusionStats();
+	}
+
+	void CalculateStats()
+	{
+		CulledPercent = NumTested > 0 ? (static_cast<float>(NumOccluded) / static_cast<float>(NumTested)) * 100.0f : 0.0f;
+	}
+
+	float GetTotalTimeMS() const
+	{
+		return SetupTimeMS + RasterTimeMS + HZBTimeMS + TestTimeMS;
+	}
+};
+
+// 오클루전 통계 전역 매니저 (싱글톤)
+// UStatsOverlayD2D에서 접근할 수 있도록 마지막으로 그린 뷰의 통계 제공
+class FOcclusionStatManager
+{
+public:
+	static FOcclusionStatManager& GetInstance()
+	{
+		static FOcclusionStatManager Instance;
+		return Instance;
+	}
+
+	void UpdateStats(const FOcclusionStats& InStats)
+	{
+		CurrentStats = InStats;
+	}
+
+	const FOcclusionStats& GetStats() const
+	{
+		return CurrentStats;
+	}
+
+	void ResetStats()
+	{
+		CurrentStats.Reset();
+	}
+
+private:
+	FOcclusionStatManager() = default;
+	~FOcclusionStatManager() = default;
+	FOcclusionStatManager(const FOcclusionStatManager&) = delete;
+	FOcclusionStatManager& operator=(const FOcclusionStatManager&) = delete;
+
+	FOcclusionStats CurrentStats;
+};
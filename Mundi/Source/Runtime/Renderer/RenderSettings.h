@@ -36,10 +36,49 @@ public:
     void SetTileSize(uint32 Value) { TileSize = Value; }
     uint32 GetTileSize() const { return TileSize; }
 
+    // 클러스터 컬링: SF_TileCulling이 켜져 있을 때 타일을 깊이 슬라이스로 나눔 (원근 투영만)
+    void SetClusteredLightCulling(bool bEnable) { bClusteredLightCulling = bEnable; }
+    bool IsClusteredLightCulling() const { return bClusteredLightCulling; }
+
+    void SetClusterSliceCount(uint32 Value) { ClusterSliceCount = Value; }
+    uint32 GetClusterSliceCount() const { return ClusterSliceCount; }
+
     // 그림자 안티 에일리어싱
     void SetShadowAATechnique(EShadowAATechnique In) { ShadowAATechnique = In; }
     EShadowAATechnique GetShadowAATechnique() const { return ShadowAATechnique; }
 
+    // 정적 캐스터 섀도우 캐시 (Spot/Point, PCF 2D 아틀라스와 큐브맵)
+    void SetStaticShadowCaching(bool bEnable) { bStaticShadowCaching = bEnable; }
+    bool IsStaticShadowCaching() const { return bStaticShadowCaching; }
+
+    // 메시 LOD (MeshLOD::SelectLOD)
+    void SetLODPixelError(float Value) { LODPixelError = Value; }
+    float GetLODPixelError() const { return LODPixelError; }
+
+    void SetLODHysteresis(float Value) { LODHysteresis = Value; }
+    float GetLODHysteresis() const { return LODHysteresis; }
+
+    void SetForcedLOD(int32 Value) { ForcedLOD = Value; }
+    int32 GetForcedLOD() const { return ForcedLOD; }
+
+    // 자동 인스턴싱: 같은 상태의 스태틱 메시 드로우를 DrawIndexedInstanced로 합침 (FMeshAutoInstancing)
+    void SetAutoInstancing(bool bEnable) { bAutoInstancing = bEnable; }
+    bool IsAutoInstancing() const { return bAutoInstancing; }
+
+    // 드로우별 상수를 패스마다 링 버퍼 하나로 올림 (FObjectConstantRing, 끄면 드로우마다 Map/Unmap)
+    void SetObjectConstantRing(bool bEnable) { bObjectConstantRing = bEnable; }
+    bool IsObjectConstantRing() const { return bObjectConstantRing; }
+
+    // CPU 오클루전 컬링 (FSceneRenderer::PerformOcclusionCulling)
+    void SetOcclusionGridWidth(int32 Value) { OcclusionGridWidth = Value; }
+    int32 GetOcclusionGridWidth() const { return OcclusionGridWidth; }
+
+    void SetOccluderMinScreenSize(float Value) { OccluderMinScreenSize = Value; }
+    float GetOccluderMinScreenSize() const { return OccluderMinScreenSize; }
+
+    void SetOccluderTriangleBudget(uint32 Value) { OccluderTriangleBudget = Value; }
+    uint32 GetOccluderTriangleBudget() const { return OccluderTriangleBudget; }
+
 private:
     EEngineShowFlags ShowFlags = EEngineShowFlags::SF_DefaultEnabled;
     EViewMode ViewMode = EViewMode::VMI_Lit_Phong;
@@ -52,7 +91,22 @@ private:
 
     // Tile-based light culling
     uint32 TileSize = 16;                   // 타일 크기 (픽셀, 기본값: 16)
+    bool bClusteredLightCulling = false;    // 3D 클러스터 (타일 x 지수 깊이 슬라이스)
+    uint32 ClusterSliceCount = 24;          // 근평면~원평면 지수 분할 수
 
     // 그림자 안티 에일리어싱
     EShadowAATechnique ShadowAATechnique = EShadowAATechnique::PCF; // 기본값 PCF
+    bool bStaticShadowCaching = true;       // 정적 캐스터 깊이를 라이트별로 캐시하고 동적 캐스터만 매 프레임 그림
+
+    // 메시 LOD
+    float LODPixelError = 1.0f;             // 허용 화면 오차 (픽셀)
+    float LODHysteresis = 0.15f;            // LOD 전환 경계의 여유 비율
+    int32 ForcedLOD = -1;                   // 0 이상이면 모든 메시에 강제 (디버그용)
+    bool bAutoInstancing = true;            // 불투명 패스에서 같은 메시/머티리얼 드로우를 인스턴싱으로 합침
+    bool bObjectConstantRing = true;        // 드로우별 상수 링 버퍼 (D3D11.1 상수 버퍼 오프셋 필요)
+
+    // CPU 오클루전 컬링
+    int32 OcclusionGridWidth = 256;         // 깊이 버퍼 가로 해상도 (세로는 뷰 비율)
+    float OccluderMinScreenSize = 0.1f;     // 화면 크기(MeshLOD::ComputeScreenSize)가 이 이상이면 자동으로 오클루더
+    uint32 OccluderTriangleBudget = 100000; // 프레임당 오클루더 삼각형 상한
 };
@@ -0,0 +1,179 @@
+﻿#include "pch.h"
+#include "RenderThread.h"
+#include "PlatformTime.h"
+
+FRenderThread::~FRenderThread()
+{
+	Stop();
+}
+
+void FRenderThread::Start()
+{
+	if (IsRunning())
+	{
+		return;
+	}
+
+	// 타이머 초기화는 게임 스레드에서 먼저 끝내 둠
+	FPlatformTime::Cycles64();
+
+	bStopRequested.store(false);
+	bRunning.store(true, std::memory_order_release);
+	Thread = std::thread(&FRenderThread::ThreadMain, this);
+}
+
+void FRenderThread::Stop()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		bStopRequested.store(true);
+	}
+	WorkCondition.notify_one();
+
+	// 렌더 스레드는 큐를 다 비운 뒤에 종료
+	if (Thread.joinable())
+	{
+		Thread.join();
+	}
+	bRunning.store(false, std::memory_order_release);
+}
+
+double FRenderThread::EnqueueFrame(uint64 FrameNumber, std::function<void()> Work)
+{
+	if (!IsRunning())
+	{
+		const uint64 WorkStart = FPlatformTime::Cycles64();
+		if (Work)
+		{
+			Work();
+		}
+		EnqueuedFrame.store(FrameNumber, std::memory_order_relaxed);
+		CompleteFrame(FRenderFrameTiming{ FrameNumber, FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - WorkStart), 0.0 });
+		return 0.0;
+	}
+
+	// 앞선 프레임이 MaxFramesInFlight개 밀려 있으면 게임 스레드를 묶어 둠 (큐가 넘치지 않게)
+	double WaitMS = 0.0;
+	if (FrameNumber > MaxFramesInFlight)
+	{
+		WaitMS = WaitForFrame(FrameNumber - MaxFramesInFlight);
+	}
+
+	FRenderFrame Frame;
+	Frame.FrameNumber = FrameNumber;
+	Frame.Work = std::move(Work);
+	while (!Queue.Enqueue(std::move(Frame)))
+	{
+		std::this_thread::yield();
+	}
+	EnqueuedFrame.store(FrameNumber, std::memory_order_relaxed);
+
+	// 렌더 스레드가 조건을 확인한 뒤 잠들기 직전에 알림이 지나가지 않도록 락을 잡고 깨움
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+	}
+	WorkCondition.notify_one();
+	return WaitMS;
+}
+
+double FRenderThread::WaitForFrame(uint64 FrameNumber)
+{
+	if (GetCompletedFrame() >= FrameNumber)
+	{
+		return 0.0;
+	}
+
+	const uint64 WaitStart = FPlatformTime::Cycles64();
+	{
+		auto IsCompleted = [this, FrameNumber]
+		{
+			return CompletedFrame.load(std::memory_order_acquire) >= FrameNumber || !IsRunning();
+		};
+
+		std::unique_lock<std::mutex> Lock(Mutex);
+		if (!WaitPump)
+		{
+			CompletedCondition.wait(Lock, IsCompleted);
+		}
+		else
+		{
+			// 락을 놓고 펌프 (펌프가 부른 창 프로시저가 오래 걸려도 렌더 스레드는 프레임을 끝낼 수 있게)
+			while (!CompletedCondition.wait_for(Lock, std::chrono::milliseconds(WaitPumpIntervalMS), IsCompleted))
+			{
+				Lock.unlock();
+				WaitPump();
+				Lock.lock();
+			}
+		}
+	}
+	return FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - WaitStart);
+}
+
+void FRenderThread::Flush()
+{
+	WaitForFrame(EnqueuedFrame.load(std::memory_order_relaxed));
+}
+
+bool FRenderThread::GetFrameTiming(uint64 FrameNumber, FRenderFrameTiming& OutTiming) const
+{
+	if (FrameNumber == 0)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> Lock(Mutex);
+	const FRenderFrameTiming& Timing = FrameTimings[FrameNumber % NumFrameTimings];
+	if (Timing.FrameNumber != FrameNumber)
+	{
+		return false;
+	}
+	OutTiming = Timing;
+	return true;
+}
+
+void FRenderThread::CompleteFrame(const FRenderFrameTiming& Timing)
+{
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		FrameTimings[Timing.FrameNumber % NumFrameTimings] = Timing;
+		CompletedFrame.store(Timing.FrameNumber, std::memory_order_release);
+	}
+	CompletedCondition.notify_all();
+}
+
+void FRenderThread::ThreadMain()
+{
+	while (true)
+	{
+		FRenderFrame Frame;
+		const uint64 IdleStart = FPlatformTime::Cycles64();
+		{
+			std::unique_lock<std::mutex> Lock(Mutex);
+			WorkCondition.wait(Lock, [this, &Frame]
+			{
+				return Queue.Dequeue(Frame) || bStopRequested.load();
+			});
+		}
+
+		// 종료 요청이 왔고 남은 프레임도 없음
+		if (Frame.FrameNumber == 0)
+		{
+			break;
+		}
+
+		const uint64 WorkStart = FPlatformTime::Cycles64();
+		if (Frame.Work)
+		{
+			Frame.Work();
+		}
+		const uint64 WorkEnd = FPlatformTime::Cycles64();
+
+		CompleteFrame(FRenderFrameTiming{ Frame.FrameNumber,
+			FPlatformTime::ToMilliseconds(WorkEnd - WorkStart), FPlatformTime::ToMilliseconds(WorkStart - IdleStart) });
+	}
+}
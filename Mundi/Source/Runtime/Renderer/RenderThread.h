@@ -0,0 +1,90 @@
+﻿#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// 렌더 스레드가 실행할 한 프레임 분량의 작업
+struct FRenderFrame
+{
+	uint64 FrameNumber = 0;
+	std::function<void()> Work;
+};
+
+// 렌더 스레드가 끝낸 프레임 하나의 작업/대기 시간
+struct FRenderFrameTiming
+{
+	uint64 FrameNumber = 0;
+	double WorkMS = 0.0;	// 프레임 작업 (명령 리스트 실행 + 오버레이 + Present)
+	double IdleMS = 0.0;	// 이 프레임이 들어오기를 기다린 시간
+};
+
+// 게임 스레드가 넘긴 프레임 작업을 순서대로 실행하는 전용 스레드 (UGameEngine 렌더 스레드 모드)
+// - 게임 스레드(생산자 1) → 렌더 스레드(소비자 1) SPSC 큐, 동시에 MaxFramesInFlight 프레임까지만 쌓임
+// - 펜스: WaitForFrame(N)은 N번 프레임 작업이 끝날 때까지 게임 스레드를 재움
+// - 프레임 작업은 게임 스레드가 기록을 끝낸 명령 리스트 실행 + 오버레이 + Present. 즉시 컨텍스트는 렌더 스레드만 사용
+// - 범위: 씬 수집/컬링/정렬/명령 기록은 여전히 게임 스레드(Render)에서 UObject를 직접 읽음.
+//   씬 프록시 스냅샷을 떠서 그 작업까지 렌더 스레드로 옮기는 것은 하지 않았음 (겹치는 건 GPU 제출 + Present뿐)
+// - 게임 스레드가 창 스레드이므로 기다리는 동안 WaitPump(메시지 펌프)를 돌림
+//   (Present가 창 스레드로 메시지를 보내고 응답을 기다릴 수 있어 그냥 재우면 교착)
+// - Start() 전이나 Stop() 후에는 EnqueueFrame이 호출 스레드에서 바로 실행 (직렬 모드와 같은 동작)
+class FRenderThread
+{
+public:
+	static constexpr uint32 MaxFramesInFlight = 1;
+	static constexpr uint32 WaitPumpIntervalMS = 1;
+
+	FRenderThread() = default;
+	~FRenderThread();
+
+	FRenderThread(const FRenderThread&) = delete;
+	FRenderThread& operator=(const FRenderThread&) = delete;
+
+	void Start();
+	// 남은 프레임을 모두 실행한 뒤 스레드 종료
+	void Stop();
+	bool IsRunning() const { return bRunning.load(std::memory_order_acquire); }
+
+	// [게임 스레드] 기다리는 동안 WaitPumpIntervalMS마다 호출. 펌프 안에서 이 객체를 다시 기다리면 안 됨
+	void SetWaitPump(std::function<void()> InWaitPump) { WaitPump = std::move(InWaitPump); }
+
+	// [게임 스레드] 이미 MaxFramesInFlight 프레임이 밀려 있으면 가장 오래된 프레임이 끝날 때까지 대기. 기다린 시간(ms) 반환
+	// FrameNumber는 1부터 단조 증가
+	double EnqueueFrame(uint64 FrameNumber, std::function<void()> Work);
+
+	// [게임 스레드] FrameNumber번 프레임 작업이 끝날 때까지 대기. 기다린 시간(ms) 반환
+	double WaitForFrame(uint64 FrameNumber);
+	// [게임 스레드] 넘긴 프레임을 모두 끝낼 때까지 대기 (리사이즈/종료 전)
+	void Flush();
+
+	uint64 GetCompletedFrame() const { return CompletedFrame.load(std::memory_order_acquire); }
+
+	// FrameNumber번 프레임의 작업/대기 시간. 아직 끝나지 않았거나 이미 덮어쓴 프레임이면 false
+	// EnqueueFrame(N)이 돌아온 뒤 N - MaxFramesInFlight번은 항상 읽을 수 있음 (렌더 스레드가 N을 끝내도 다른 칸에 씀)
+	bool GetFrameTiming(uint64 FrameNumber, FRenderFrameTiming& OutTiming) const;
+
+private:
+	static constexpr uint32 NumFrameTimings = MaxFramesInFlight + 1;
+
+	void ThreadMain();
+	void CompleteFrame(const FRenderFrameTiming& Timing);
+
+	std::thread Thread;
+	TQueue<FRenderFrame, EQueueMode::Spsc> Queue{ MaxFramesInFlight };
+	std::function<void()> WaitPump;
+
+	// 큐가 빈 렌더 스레드 / 펜스를 기다리는 게임 스레드 깨우기
+	mutable std::mutex Mutex;
+	std::condition_variable WorkCondition;
+	std::condition_variable CompletedCondition;
+
+	std::atomic<uint64> EnqueuedFrame{ 0 };
+	std::atomic<uint64> CompletedFrame{ 0 };
+	std::atomic<bool> bStopRequested{ false };
+	std::atomic<bool> bRunning{ false };
+
+	// FrameNumber % NumFrameTimings 칸에 기록 (Mutex 보호, CompletedFrame과 함께 갱신)
+	FRenderFrameTiming FrameTimings[NumFrameTimings];
+};
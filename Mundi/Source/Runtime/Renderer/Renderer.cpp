@@ -31,12 +31,28 @@
 #include "DecalStatManager.h"
 #include "SceneRenderer.h"
 #include "SceneView.h"
+#include "MeshAutoInstancing.h"
+#include "MeshBatchSort.h"
+#include "MeshBatchCollector.h"
+#include "ObjectConstantRing.h"
+#include "MeshDrawStats.h"
+#include "MeshDrawCommands.h"
+#include "D3D11CommandBackend.h"
 
 #include <Windows.h>
 #include "DirectionalLightComponent.h"
 URenderer::URenderer(D3D11RHI* InDevice) : RHIDevice(InDevice)
 {
 	InitializeLineBatch();
+	MeshAutoInstancing = std::make_unique<FMeshAutoInstancing>();
+	MeshBatchSorter = std::make_unique<FMeshBatchSorter>();
+	MeshBatchCollector = std::make_unique<FMeshBatchCollector>();
+	ObjectConstantRing = std::make_unique<FObjectConstantRing>();
+	for (std::unique_ptr<FMeshPassRecording>& Recording : MeshPassRecordings)
+	{
+		Recording = std::make_unique<FMeshPassRecording>();
+	}
+	CommandBackend = std::make_unique<FD3D11CommandBackend>(RHIDevice, ObjectConstantRing.get());
 }
 
 URenderer::~URenderer()
@@ -62,9 +78,24 @@ void URenderer::BeginFrame()
 
 void URenderer::EndFrame()
 {
+	FinishFrame();
 	RHIDevice->Present();
 }
 
+void URenderer::FinishFrame()
+{
+	// 이번 프레임 버퍼 업로드 통계 확정 (오버레이는 Present 안에서 그림)
+	FFrameUploadStats UploadStats;
+	UploadStats.NumBufferMaps = RHIDevice->GetFrameBufferMapCount();
+	UploadStats.bObjectConstantRingSupported = ObjectConstantRing->IsSupported(RHIDevice);
+	UploadStats.NumObjectConstantUploads = ObjectConstantRing->GetFrameUploads();
+	UploadStats.NumObjectConstantDraws = ObjectConstantRing->GetFrameDraws();
+	UploadStats.ObjectConstantBytes = ObjectConstantRing->GetFrameBytes();
+	FMeshDrawStatManager::GetInstance().UpdateFrameUploadStats(UploadStats);
+	RHIDevice->ResetFrameBufferMapCount();
+	ObjectConstantRing->ResetFrameStats();
+}
+
 void URenderer::RenderSceneForView(UWorld* World, FSceneView* View, FViewport* Viewport)
 {
 	// 씬을 그리는 FSceneRenderer 를 생성합니다.
@@ -80,6 +111,13 @@ UPrimitiveComponent* URenderer::GetPrimitiveCollided(int MouseX, int MouseY) con
    //******비동기 방식으로 무조건 바꿔야함****************
 	uint32 PickedId = 0;
 
+	// 스테이징 버퍼 읽기는 즉시 컨텍스트에서만 가능
+	// 렌더 스레드 모드에서는 호출하는 쪽이 CPickingSystem::PerformViewportComponentPicking (CPU 레이 피킹)을 사용
+	if (RHIDevice->IsDeferredRecording())
+	{
+		return nullptr;
+	}
+
 	ID3D11DeviceContext* DeviceContext = RHIDevice->GetDeviceContext();
 	//스테이징 버퍼를 가져와야 하는데 이걸 Device 추상 클래스가 Getter로 가지고 있는게 좋은 설계가 아닌 것 같아서 일단 캐스팅함
 
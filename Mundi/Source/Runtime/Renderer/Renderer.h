@@ -12,6 +12,12 @@ class UBillboardComponent;
 class UPrimitiveComponent;
 class UCameraComponent;
 class FSceneView;
+class FMeshAutoInstancing;
+class FMeshBatchSorter;
+class FMeshBatchCollector;
+class FObjectConstantRing;
+class FMeshPassRecording;
+class FD3D11CommandBackend;
 
 struct FMaterialSlot;
 
@@ -27,6 +33,8 @@ public:
 
 	void BeginFrame();
 	void EndFrame();
+	// EndFrame에서 Present를 뺀 부분 (프레임 통계 확정). Present를 렌더 스레드로 넘길 때 사용
+	void FinishFrame();
 
 	// Viewport size for current draw context (used by overlay/gizmo scaling)
 	void SetCurrentViewportSize(uint32 InWidth, uint32 InHeight) { CurrentViewportWidth = InWidth; CurrentViewportHeight = InHeight; }
@@ -46,6 +54,20 @@ public:
 
 	D3D11RHI* GetRHIDevice() { return RHIDevice; }
 
+	// 불투명 패스 자동 인스턴싱 (인스턴스 버퍼를 뷰/프레임 사이에 재사용)
+	FMeshAutoInstancing* GetMeshAutoInstancing() { return MeshAutoInstancing.get(); }
+	// 배치 리스트 정렬 (키/정렬 임시 버퍼를 패스 사이에 재사용)
+	FMeshBatchSorter* GetMeshBatchSorter() { return MeshBatchSorter.get(); }
+	// 메시 배치 병렬 수집 (묶음별 출력 배열을 패스 사이에 재사용)
+	FMeshBatchCollector* GetMeshBatchCollector() { return MeshBatchCollector.get(); }
+	// DrawMeshBatches의 드로우별 상수 링 버퍼
+	FObjectConstantRing* GetObjectConstantRing() { return ObjectConstantRing.get(); }
+	// 메시 패스 명령 리스트 (동시에 기록할 수 있는 패스 수만큼, 프레임마다 재사용)
+	static constexpr int32 NumMeshPassRecordings = 2;
+	FMeshPassRecording* GetMeshPassRecording(int32 Index) { return MeshPassRecordings[Index].get(); }
+	// 명령 리스트를 즉시 컨텍스트에 재생
+	FD3D11CommandBackend* GetCommandBackend() { return CommandBackend.get(); }
+
 	void SetCurrentCamera(ACameraActor* InCamera) { CurrentCamera = InCamera; }
 	ACameraActor* GetCurrentCamera() const { return CurrentCamera; }
 
@@ -66,6 +88,13 @@ private:
 
 	void InitializeLineBatch();
 
+	std::unique_ptr<FMeshAutoInstancing> MeshAutoInstancing;
+	std::unique_ptr<FMeshBatchSorter> MeshBatchSorter;
+	std::unique_ptr<FMeshBatchCollector> MeshBatchCollector;
+	std::unique_ptr<FObjectConstantRing> ObjectConstantRing;
+	std::unique_ptr<FMeshPassRecording> MeshPassRecordings[NumMeshPassRecordings];
+	std::unique_ptr<FD3D11CommandBackend> CommandBackend;
+
 	// 이전 drawCall에서 이미 썼던 RnderState면, 다시 Set 하지 않기 위해 만든 변수들
 	EViewMode PreViewModeIndex = EViewMode::VMI_Wireframe; // RSSetState, UpdateColorConstantBuffers
 	//UMaterial* PreUMaterial = nullptr; // SRV, UpdatePixelConstantBuffers
@@ -25,6 +25,7 @@
 #include "TextRenderComponent.h"
 #include "OBB.h"
 #include "BoundingSphere.h"
+#include "Hash.h"
 #include "HeightFogComponent.h"
 #include "Gizmo/GizmoArrowComponent.h"
 #include "Gizmo/GizmoRotateComponent.h"
@@ -39,6 +40,9 @@
 #include "SceneView.h"
 #include "Shader.h"
 #include "ResourceManager.h"
+#include "PackedVertex.h"
+#include "StaticMesh.h"
+#include "MeshLOD.h"
 #include "../RHI/ConstantBufferType.h"
 #include <chrono>
 #include "TileLightCuller.h"
@@ -52,6 +56,15 @@
 #include "SkinningStats.h"
 #include "StatsOverlayD2D.h"
 #include "Source/Runtime/Engine/Particle/ParticleStats.h"
+#include "MeshAutoInstancing.h"
+#include "MeshBatchSort.h"
+#include "MeshBatchCollector.h"
+#include "ObjectConstantRing.h"
+#include "MeshDrawStats.h"
+#include "MeshDrawCommands.h"
+#include "D3D11CommandBackend.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include "PlatformTime.h"
 
 FSceneRenderer::FSceneRenderer(UWorld* InWorld, FSceneView* InView, URenderer* InOwnerRenderer)
 	: World(InWorld)
@@ -59,7 +72,7 @@ FSceneRenderer::FSceneRenderer(UWorld* InWorld, FSceneView* InView, URenderer* I
 	, OwnerRenderer(InOwnerRenderer)
 	, RHIDevice(InOwnerRenderer->GetRHIDevice())
 {
-	//OcclusionCPU = std::make_unique<FOcclusionCullingManagerCPU>();
+	OcclusionCPU = std::make_unique<FOcclusionCullingManagerCPU>();
 
 	// 타일 라이트 컬러 초기화
 	TileLightCuller = std::make_unique<FTileLightCuller>();
@@ -92,6 +105,7 @@ void FSceneRenderer::Render()
     // (Background is cleared per-path when binding scene color)
     // 렌더링할 대상 수집 (Cull + Gather)
     GatherVisibleProxies();
+	PerformOcclusionCulling();
 
 	TIME_PROFILE(ShadowMapPass)
 	RenderShadowMaps();
@@ -247,18 +261,7 @@ void FSceneRenderer::RenderShadowMaps()
     FLightManager* LightManager = World->GetLightManager();
 	if (!LightManager) return;
 
-	// 2. 그림자 캐스터(Caster) 메시 수집
-	TArray<FMeshBatchElement> ShadowMeshBatches;
-	for (UMeshComponent* MeshComponent : Proxies.Meshes)
-	{
-		if (MeshComponent && MeshComponent->IsCastShadows() && MeshComponent->IsVisible())
-		{
-			MeshComponent->CollectMeshBatches(ShadowMeshBatches, View);
-		}
-	}
-
 	// NOTE: 카메라 오버라이드 기능을 항상 활성화 하기 위해서 그림자를 그릴 곳이 없어도 함수 실행
-	//if (ShadowMeshBatches.IsEmpty()) return;
 
 	// 섀도우 맵을 DSV로 사용하기 전에 SRV 슬롯에서 해제
 	ID3D11ShaderResourceView* nullSRVs[2] = { nullptr, nullptr };
@@ -332,8 +335,30 @@ void FSceneRenderer::RenderShadowMaps()
 		return;
 	}
 
+	// 2. 그림자 캐스터(Caster) 메시 수집 (한 번) - 섀도우 뷰마다 이 목록을 컬링해서 그림
+	FShadowCasterCache& CasterCache = LightManager->GetShadowCasterCache();
+	CasterCache.BeginPass();
+	GatherShadowCasters(CasterCache);
+
+	FShadowStats ShadowStats = FShadowStatManager::GetInstance().GetStats();
+	ShadowStats.NumShadowCasters = ShadowCasters.Num();
+	for (const FShadowCaster& Caster : ShadowCasters)
+	{
+		ShadowStats.NumStaticShadowCasters += Caster.bStatic ? 1 : 0;
+	}
+
+	const bool bStaticShadowCaching = World->GetRenderSettings().IsStaticShadowCaching();
+	TArray<int32> ViewCasters;
+
 	// 2D 아틀라스 할당
 	LightManager->AllocateAtlasRegions2D(Requests2D);
+	const FShadowAtlasAllocStats& AtlasStats = LightManager->GetShadowAtlasAllocStats2D();
+	ShadowStats.AtlasRegions2D = AtlasStats.NumAllocated;
+	ShadowStats.AtlasDegraded2D = AtlasStats.NumDegraded;
+	ShadowStats.AtlasDropped2D = AtlasStats.NumDropped;
+	ShadowStats.AtlasRelocated2D = AtlasStats.NumRelocated;
+	ShadowStats.AtlasUsedPercent2D = AtlasStats.UsedPercent;
+	ShadowStats.AtlasFragmentation2D = AtlasStats.Fragmentation;
 	// 2.2. 큐브맵 슬라이스 할당 (Allocate only)
 	LightManager->AllocateAtlasCubeSlices(RequestsCube); // FLightManager가 RequestsCube의 AssignedSliceIndex와 Size 업데이트
 
@@ -371,18 +396,28 @@ void FSceneRenderer::RenderShadowMaps()
 			RHIDevice->RSSetState(ERasterizerMode::Shadows);
 			RHIDevice->OMSetDepthStencilState(EComparisonFunc::LessEqual);
 
+			// VSM은 깊이 외에 모멘트 RT도 채워야 하므로 2D 아틀라스는 캐시하지 않음
+			const bool bCache2D = bStaticShadowCaching && ShadowAAType != EShadowAATechnique::VSM;
+
 			for (FShadowRenderRequest& Request : Requests2D)
 			{
-				// 뷰포트 설정
-				D3D11_VIEWPORT ShadowVP = { Request.AtlasViewportOffset.X, Request.AtlasViewportOffset.Y, static_cast<FLOAT>(Request.Size), static_cast<FLOAT>(Request.Size), 0.0f, 1.0f };
-				RHIDevice->GetDeviceContext()->RSSetViewports(1, &ShadowVP);
-
-				// 뎁스 패스 렌더링
-				RenderShadowDepthPass(Request, ShadowMeshBatches);
-
 				FShadowMapData Data;
 				if (Request.Size > 0) // 렌더링 성공
 				{
+					// 뷰포트 설정
+					D3D11_VIEWPORT ShadowVP = { Request.AtlasViewportOffset.X, Request.AtlasViewportOffset.Y, static_cast<FLOAT>(Request.Size), static_cast<FLOAT>(Request.Size), 0.0f, 1.0f };
+					RHIDevice->GetDeviceContext()->RSSetViewports(1, &ShadowVP);
+
+					// 스포트/캐스케이드 절두체와 겹치는 캐스터만
+					ViewCasters.Empty();
+					QueryShadowCasters(CreateFrustumFromViewProjection(Request.ViewMatrix * Request.ProjectionMatrix), ViewCasters);
+
+					// 캐스케이드는 카메라를 따라 매 프레임 다시 맞춰지므로 캐시해도 적중하지 않음 → Spot만 캐시
+					const bool bCacheView = bCache2D && Cast<USpotLightComponent>(Request.LightOwner) != nullptr;
+
+					// 뎁스 패스 렌더링
+					RenderShadowView(Request, ViewCasters, AtlasDSV2D, ShadowVP, bCacheView, CasterCache, ShadowStats);
+
 					Data.ShadowViewProjMatrix = Request.ViewMatrix * Request.ProjectionMatrix * BiasMatrix;
 					Data.AtlasScaleOffset = Request.AtlasScaleOffset;
 					Data.ShadowBias = Request.LightOwner->GetShadowBias();
@@ -412,6 +447,10 @@ void FSceneRenderer::RenderShadowMaps()
 			D3D11_VIEWPORT ShadowVP = { 0.0f, 0.0f, (float)AtlasSizeCube, (float)AtlasSizeCube, 0.0f, 1.0f };
 			RHIDevice->GetDeviceContext()->RSSetViewports(1, &ShadowVP);
 
+			// 라이트 반경 구로 한 번 쿼리하고 면마다 면 절두체로 다시 거름 (요청은 라이트마다 6면이 연속)
+			ULightComponent* SphereQueryLight = nullptr;
+			TArray<int32> LightCasters;
+
 			// 이제 RequestsCube 배열을 직접 순회
 			for (FShadowRenderRequest& Request : RequestsCube) // 레퍼런스 유지
 			{
@@ -436,14 +475,32 @@ void FSceneRenderer::RenderShadowMaps()
 				ID3D11DepthStencilView* FaceDSV = LightManager->GetShadowCubeFaceDSV(SliceIndex, FaceIndex);
 				if (FaceDSV)
 				{
+					if (Request.LightOwner != SphereQueryLight)
+					{
+						SphereQueryLight = Request.LightOwner;
+						LightCasters.Empty();
+						QueryShadowCasters(FBoundingSphere(Request.WorldLocation, Request.Radius), LightCasters);
+					}
+
+					ViewCasters.Empty();
+					FilterShadowCastersByFrustum(CreateFrustumFromViewProjection(Request.ViewMatrix * Request.ProjectionMatrix), ShadowCasters, LightCasters, ViewCasters);
+
 					RHIDevice->OMSetCustomRenderTargets(0, nullptr, FaceDSV);
 					RHIDevice->GetDeviceContext()->ClearDepthStencilView(FaceDSV, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-					RenderShadowDepthPass(Request, ShadowMeshBatches);
+					RenderShadowView(Request, ViewCasters, FaceDSV, ShadowVP, bStaticShadowCaching, CasterCache, ShadowStats);
 				}
 			}
 		}
 	}
 
+	// 이번 패스에 쓰이지 않은 캐시 항목 정리 + 캐스터/캐시 통계
+	CasterCache.EndPass();
+	ShadowStats.NumCacheEntries = CasterCache.GetNumEntries();
+	ShadowStats.StaticCacheMemoryMB = CasterCache.GetMemoryMB();
+	ShadowStats.CalculateCacheHitRate();
+	ShadowStats.CalculateTotal();
+	FShadowStatManager::GetInstance().UpdateStats(ShadowStats);
+
 	// --- 3. RHI 상태 복구 ---
 	RHIDevice->RSSetState(ERasterizerMode::Solid);
 	ID3D11RenderTargetView* nullRTV = nullptr;
@@ -575,6 +632,212 @@ void FSceneRenderer::RenderShadowDepthPass(FShadowRenderRequest& ShadowRequest,
 	}
 }
 
+namespace
+{
+	/** @brief 정지 판정용 캐스터 상태: 배치별 월드 행렬, 버퍼, 인덱스 범위 (이동 외에 메시 교체/LOD 전환도 변경으로 봄) */
+	uint64 HashShadowCasterState(const UMeshComponent* Component, const TArray<FMeshBatchElement>& Batches, int32 FirstBatch, int32 NumBatches)
+	{
+		uint64 StateHash = reinterpret_cast<uint64>(Component);
+		for (int32 BatchIndex = FirstBatch; BatchIndex < FirstBatch + NumBatches; ++BatchIndex)
+		{
+			const FMeshBatchElement& Batch = Batches[BatchIndex];
+			StateHash = HashCombine(StateHash, reinterpret_cast<uint64>(Batch.VertexBuffer));
+			StateHash = HashCombine(StateHash, reinterpret_cast<uint64>(Batch.IndexBuffer));
+			StateHash = HashCombine(StateHash, (static_cast<uint64>(Batch.StartIndex) << 32) | Batch.IndexCount);
+			StateHash = HashCombine(StateHash, Batch.BaseVertexIndex);
+
+			const uint32* MatrixBits = reinterpret_cast<const uint32*>(&Batch.WorldMatrix);
+			for (int32 Word = 0; Word < 16; Word += 2)
+			{
+				StateHash = HashCombine(StateHash, (static_cast<uint64>(MatrixBits[Word]) << 32) | MatrixBits[Word + 1]);
+			}
+		}
+		return StateHash;
+	}
+}
+
+void FSceneRenderer::GatherShadowCasters(FShadowCasterCache& CasterCache)
+{
+	ShadowCasters.Empty();
+	ShadowCasterBatches.Empty();
+	ShadowCasterIndices.clear();
+	ShadowCasterIndices.reserve(Proxies.Meshes.Num());
+
+	ShadowCasterCandidates.Empty();
+	for (UMeshComponent* MeshComponent : Proxies.Meshes)
+	{
+		if (MeshComponent && MeshComponent->IsCastShadows() && MeshComponent->IsVisible())
+		{
+			ShadowCasterCandidates.Add(MeshComponent);
+		}
+	}
+
+	// 배치 수집은 병렬, 캐스터 등록(정지 판정)은 후보 순서대로
+	OwnerRenderer->GetMeshBatchCollector()->Collect(ShadowCasterCandidates, View, ShadowCasterBatches, &ShadowCasterBatchOffsets);
+
+	for (int32 CandidateIndex = 0; CandidateIndex < ShadowCasterCandidates.Num(); ++CandidateIndex)
+	{
+		UMeshComponent* MeshComponent = ShadowCasterCandidates[CandidateIndex];
+
+		FShadowCaster Caster;
+		Caster.Component = MeshComponent;
+		Caster.FirstBatch = ShadowCasterBatchOffsets[CandidateIndex];
+		Caster.NumBatches = ShadowCasterBatchOffsets[CandidateIndex + 1] - Caster.FirstBatch;
+		if (Caster.NumBatches == 0)
+		{
+			continue;
+		}
+		Caster.Bounds = MeshComponent->GetWorldAABB();
+		Caster.StateHash = HashShadowCasterState(MeshComponent, ShadowCasterBatches, Caster.FirstBatch, Caster.NumBatches);
+
+		// 스켈레탈 메시는 애니메이션으로 정점이 바뀌므로 항상 동적
+		const bool bCanBeStatic = !MeshComponent->IsA(USkinnedMeshComponent::StaticClass());
+		Caster.bStatic = CasterCache.UpdateCasterMobility(MeshComponent, Caster.StateHash, bCanBeStatic);
+
+		const int32 CasterIndex = ShadowCasters.Add(Caster);
+		ShadowCasterIndices[MeshComponent] = CasterIndex;
+	}
+}
+
+void FSceneRenderer::QueryShadowCasters(const FFrustum& InFrustum, TArray<int32>& OutCasters)
+{
+	UWorldPartitionManager* Partition = World->GetPartitionManager();
+	QueryShadowCasterIndices(Partition ? Partition->GetBVH() : nullptr, InFrustum,
+		ShadowCasters, ShadowCasterIndices, ShadowQueryResults, OutCasters);
+}
+
+void FSceneRenderer::QueryShadowCasters(const FBoundingSphere& InSphere, TArray<int32>& OutCasters)
+{
+	UWorldPartitionManager* Partition = World->GetPartitionManager();
+	QueryShadowCasterIndices(Partition ? Partition->GetBVH() : nullptr, InSphere,
+		ShadowCasters, ShadowCasterIndices, ShadowQueryResults, OutCasters);
+}
+
+void FSceneRenderer::RenderShadowView(FShadowRenderRequest& Request, const TArray<int32>& InViewCasters, ID3D11DepthStencilView* TargetDSV,
+	const D3D11_VIEWPORT& TargetViewport, bool bAllowCache, FShadowCasterCache& CasterCache, FShadowStats& InOutStats)
+{
+	InOutStats.NumShadowViews++;
+	InOutStats.NumCasterViewPairsTotal += ShadowCasters.Num();
+	InOutStats.NumCasterViewPairsVisible += InViewCasters.Num();
+
+	uint32 NumStaticInView = 0;
+	const uint64 StaticCasterHash = HashStaticShadowCasters(ShadowCasters, InViewCasters, NumStaticInView);
+
+	// 섀도우 뷰마다 라이트 기준 앞→뒤 + 지오메트리 순으로 정렬
+	FMeshBatchSorter* BatchSorter = OwnerRenderer->GetMeshBatchSorter();
+	auto SortViewBatches = [&]()
+	{
+		BatchSorter->AssignKeysAndSort(ShadowViewBatches, EMeshSortMode::Shadow, Request.ViewMatrix);
+	};
+
+	FStaticShadowCacheEntry* CacheEntry = nullptr;
+	if (bAllowCache && NumStaticInView > 0)
+	{
+		CacheEntry = CasterCache.FindOrCreateEntry(RHIDevice, Request.LightOwner, Request.SubViewIndex, static_cast<uint32>(TargetViewport.Width));
+	}
+
+	// 캐시를 쓰지 않으면 이번 뷰의 캐스터 전부를 그대로 그림
+	if (!CacheEntry)
+	{
+		ShadowViewBatches.Empty();
+		for (int32 CasterIndex : InViewCasters)
+		{
+			const FShadowCaster& Caster = ShadowCasters[CasterIndex];
+			ShadowViewBatches.insert(ShadowViewBatches.end(), ShadowCasterBatches.begin() + Caster.FirstBatch, ShadowCasterBatches.begin() + Caster.FirstBatch + Caster.NumBatches);
+		}
+		InOutStats.NumCastersRendered += InViewCasters.Num();
+		if (!ShadowViewBatches.IsEmpty())
+		{
+			SortViewBatches();
+			RenderShadowDepthPass(Request, ShadowViewBatches);
+		}
+		return;
+	}
+
+	if (FShadowCasterCache::IsEntryUpToDate(*CacheEntry, Request, StaticCasterHash))
+	{
+		InOutStats.CacheHits++;
+		InOutStats.NumCastersFromCache += NumStaticInView;
+	}
+	else
+	{
+		InOutStats.CacheMisses++;
+		InOutStats.NumCastersRendered += NumStaticInView;
+
+		// 라이트나 범위 안 정적 캐스터가 바뀜 → 캐시 텍스처에 정적 캐스터만 다시 그림
+		ShadowViewBatches.Empty();
+		for (int32 CasterIndex : InViewCasters)
+		{
+			const FShadowCaster& Caster = ShadowCasters[CasterIndex];
+			if (Caster.bStatic)
+			{
+				ShadowViewBatches.insert(ShadowViewBatches.end(), ShadowCasterBatches.begin() + Caster.FirstBatch, ShadowCasterBatches.begin() + Caster.FirstBatch + Caster.NumBatches);
+			}
+		}
+
+		D3D11_VIEWPORT CacheVP = { 0.0f, 0.0f, static_cast<FLOAT>(CacheEntry->Size), static_cast<FLOAT>(CacheEntry->Size), 0.0f, 1.0f };
+		RHIDevice->OMSetCustomRenderTargets(0, nullptr, CacheEntry->DSV);
+		RHIDevice->GetDeviceContext()->ClearDepthStencilView(CacheEntry->DSV, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+		RHIDevice->GetDeviceContext()->RSSetViewports(1, &CacheVP);
+		SortViewBatches();
+		RenderShadowDepthPass(Request, ShadowViewBatches);
+
+		FShadowCasterCache::MarkEntryUpToDate(*CacheEntry, Request, StaticCasterHash);
+
+		RHIDevice->OMSetCustomRenderTargets(0, nullptr, TargetDSV);
+		RHIDevice->GetDeviceContext()->RSSetViewports(1, &TargetViewport);
+	}
+
+	// 정적 깊이를 대상 영역에 합성한 뒤 동적 캐스터를 그 위에 그림
+	CompositeStaticShadowCache(*CacheEntry, TargetViewport);
+
+	ShadowViewBatches.Empty();
+	uint32 NumDynamicInView = 0;
+	for (int32 CasterIndex : InViewCasters)
+	{
+		const FShadowCaster& Caster = ShadowCasters[CasterIndex];
+		if (!Caster.bStatic)
+		{
+			ShadowViewBatches.insert(ShadowViewBatches.end(), ShadowCasterBatches.begin() + Caster.FirstBatch, ShadowCasterBatches.begin() + Caster.FirstBatch + Caster.NumBatches);
+			++NumDynamicInView;
+		}
+	}
+	InOutStats.NumCastersRendered += NumDynamicInView;
+	if (!ShadowViewBatches.IsEmpty())
+	{
+		SortViewBatches();
+		RenderShadowDepthPass(Request, ShadowViewBatches);
+	}
+}
+
+void FSceneRenderer::CompositeStaticShadowCache(const FStaticShadowCacheEntry& Entry, const D3D11_VIEWPORT& TargetViewport)
+{
+	UShader* FullScreenTriangleVS = UResourceManager::GetInstance().Load<UShader>("Shaders/Utility/FullScreenTriangle_VS.hlsl");
+	UShader* CompositePS = UResourceManager::GetInstance().Load<UShader>("Shaders/Shadows/StaticShadowComposite_PS.hlsl");
+	if (!FullScreenTriangleVS || !FullScreenTriangleVS->GetVertexShader() || !CompositePS || !CompositePS->GetPixelShader())
+	{
+		UE_LOG("정적 섀도우 캐시 합성 셰이더 없음!\n");
+		return;
+	}
+
+	// TexCoord가 대상 영역 안에서 0~1이 되도록 (캐시와 대상은 같은 해상도)
+	FViewportConstants ViewportCB;
+	ViewportCB.ViewportRect = FVector4(0.0f, 0.0f, TargetViewport.Width, TargetViewport.Height);
+	ViewportCB.ScreenSize = FVector4(TargetViewport.Width, TargetViewport.Height, 1.0f / TargetViewport.Width, 1.0f / TargetViewport.Height);
+	RHIDevice->SetAndUpdateConstantBuffer(ViewportCB);
+
+	// 캐시 깊이에는 이미 섀도우 래스터라이저 바이어스가 들어 있으므로 바이어스 없이 그대로 씀
+	RHIDevice->RSSetState(ERasterizerMode::Solid);
+	RHIDevice->PrepareShader(FullScreenTriangleVS, CompositePS);
+	ID3D11ShaderResourceView* CacheSRV = Entry.SRV;
+	RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 1, &CacheSRV);
+	RHIDevice->DrawFullScreenQuad();
+
+	// 다음 갱신 때 캐시를 DSV로 바인딩할 수 있도록 해제, 섀도우 상태 복구
+	ID3D11ShaderResourceView* NullSRV = nullptr;
+	RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 1, &NullSRV);
+	RHIDevice->RSSetState(ERasterizerMode::Shadows);
+}
 
 //====================================================================================
 // Private 헬퍼 함수 구현
@@ -863,6 +1126,11 @@ void FSceneRenderer::PerformTileLightCulling()
 	UINT ViewportWidth = static_cast<UINT>(View->ViewRect.Width());
 	UINT ViewportHeight = static_cast<UINT>(View->ViewRect.Height());
 
+	// 클러스터 모드는 SV_POSITION.w를 뷰 깊이로 쓰므로 원근 투영에서만 (직교 투영은 2D 타일)
+	const bool bPerspective = View->ProjectionMatrix.M[2][3] != 0.0f;
+	const bool bClustered = bTileCullingEnabled && bPerspective && RenderSettings.IsClusteredLightCulling();
+	TileLightCuller->SetClusterSliceCount(bClustered ? RenderSettings.GetClusterSliceCount() : 0);
+
 	// 타일 컬링이 활성화된 경우에만 컬링 수행
 	if (bTileCullingEnabled)
 	{
@@ -895,6 +1163,9 @@ void FSceneRenderer::PerformTileLightCulling()
 	TileCullingBuffer.bUseTileCulling = bTileCullingEnabled ? 1 : 0;  // ShowFlag에 따라 설정
 	TileCullingBuffer.ViewportStartX = View->ViewRect.MinX;  // ShowFlag에 따라 설정
 	TileCullingBuffer.ViewportStartY = View->ViewRect.MinY;  // ShowFlag에 따라 설정
+	TileCullingBuffer.ClusterSliceCount = bClustered ? TileLightCuller->GetClusterSliceCount() : 0;
+	TileCullingBuffer.ClusterDepthScale = TileLightCuller->GetClusterDepthScale();
+	TileCullingBuffer.ClusterDepthBias = TileLightCuller->GetClusterDepthBias();
 
 	RHIDevice->SetAndUpdateConstantBuffer(TileCullingBuffer);
 
@@ -929,15 +1200,142 @@ void FSceneRenderer::PerformFrustumCulling()
 	//}
 }
 
-void FSceneRenderer::RenderOpaquePass(EViewMode InRenderViewMode)
+void FSceneRenderer::PerformOcclusionCulling()
 {
-	// --- 1. 수집 (Collect) ---
-	MeshBatchElements.Empty();
+	OpaqueMeshes = Proxies.Meshes;
+
+	// 와이어프레임은 가려진 메시까지 보여야 하므로 컬링하지 않음
+	const URenderSettings& RenderSettings = World->GetRenderSettings();
+	if (!OcclusionCPU || Proxies.Meshes.IsEmpty() ||
+		!RenderSettings.IsShowFlagEnabled(EEngineShowFlags::SF_OcclusionCulling) ||
+		View->RenderSettings->GetViewMode() == EViewMode::VMI_Wireframe)
+	{
+		FOcclusionStatManager::GetInstance().ResetStats();
+		return;
+	}
+
+	// 깊이 버퍼: 가로는 설정값, 세로는 뷰 비율
+	const uint32 ViewWidth = std::max(View->ViewRect.Width(), 1u);
+	const uint32 ViewHeight = std::max(View->ViewRect.Height(), 1u);
+	const int32 GridWidth = RenderSettings.GetOcclusionGridWidth();
+	const int32 GridHeight = std::clamp(static_cast<int32>(static_cast<float>(GridWidth) * ViewHeight / ViewWidth + 0.5f), 16, GridWidth);
+	OcclusionCPU->Initialize(GridWidth, GridHeight);
+
+	const FMatrix ViewProj = View->ViewMatrix * View->ProjectionMatrix;
+
+	// --- 1. 오클루더 선택: bForceOccluder 먼저, 나머지는 화면에서 큰 순서로 삼각형 예산까지 ---
+	struct FOccluderCandidate
+	{
+		UStaticMeshComponent* Component;
+		float ScreenSize;
+		bool bForced;
+	};
+	TArray<FOccluderCandidate> OccluderCandidates;
 	for (UMeshComponent* MeshComponent : Proxies.Meshes)
 	{
-		MeshComponent->CollectMeshBatches(MeshBatchElements, View);
+		UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(MeshComponent);
+		if (!StaticMeshComponent || !StaticMeshComponent->IsUsedAsOccluder())
+		{
+			continue;
+		}
+		UStaticMesh* StaticMesh = StaticMeshComponent->GetStaticMesh();
+		if (!StaticMesh || !StaticMesh->GetStaticMeshAsset())
+		{
+			continue;
+		}
+
+		const float ScreenSize = MeshLOD::ComputeScreenSize(View, StaticMeshComponent->GetWorldAABB());
+		const bool bForced = StaticMeshComponent->IsForceOccluder();
+		if (bForced || ScreenSize >= RenderSettings.GetOccluderMinScreenSize())
+		{
+			OccluderCandidates.Add({ StaticMeshComponent, ScreenSize, bForced });
+		}
+	}
+	std::sort(OccluderCandidates.begin(), OccluderCandidates.end(), [](const FOccluderCandidate& A, const FOccluderCandidate& B)
+		{
+			return A.bForced != B.bForced ? A.bForced : A.ScreenSize > B.ScreenSize;
+		});
+
+	// 오클루더는 깊이 버퍼 픽셀 기준 오차가 반 픽셀 이하인 가장 거친 LOD로 그림
+	// (QEM LOD는 원본 바깥으로 튀어나올 수 있어 그 이상 거칠면 실제로 보이는 물체를 가릴 수 있음)
+	constexpr float OccluderLODPixelError = 0.5f;
+
+	TArray<FOccluderMesh> Occluders;
+	uint32 NumOccluderTriangles = 0;
+	for (const FOccluderCandidate& Candidate : OccluderCandidates)
+	{
+		const FStaticMesh* Mesh = Candidate.Component->GetStaticMesh()->GetStaticMeshAsset();
+		const float PixelsPerDiagonal = Candidate.ScreenSize * static_cast<float>(GridHeight);
+
+		const TArray<uint32>* Indices = &Mesh->Indices;
+		for (int32 LOD = static_cast<int32>(Mesh->LODs.size()); LOD >= 1; --LOD)
+		{
+			const FMeshLOD& LODData = Mesh->LODs[LOD - 1];
+			if (!LODData.Indices.empty() && LODData.RelativeError * PixelsPerDiagonal <= OccluderLODPixelError)
+			{
+				Indices = &LODData.Indices;
+				break;
+			}
+		}
+
+		const uint32 NumTriangles = static_cast<uint32>(Indices->size() / 3);
+		if (NumTriangles == 0 || NumOccluderTriangles + NumTriangles > RenderSettings.GetOccluderTriangleBudget())
+		{
+			continue;
+		}
+		NumOccluderTriangles += NumTriangles;
+
+		const FMatrix WorldMatrix = Candidate.Component->GetWorldMatrix();
+		FOccluderMesh Occluder;
+		Occluder.Vertices = Mesh->Vertices.data();
+		Occluder.Indices = Indices->data();
+		Occluder.NumIndices = static_cast<uint32>(Indices->size());
+		Occluder.WorldViewProj = WorldMatrix * ViewProj;
+		Occluder.WorldView = WorldMatrix * View->ViewMatrix;
+		Occluders.Add(Occluder);
+	}
+
+	// --- 2. 오클루디: 수집된 모든 메시 (오클루더 자신은 자기 표면보다 앞에 있을 수 없으므로 스스로를 가리지 않음) ---
+	TArray<FCandidateDrawable> Candidates;
+	Candidates.Reserve(Proxies.Meshes.Num());
+	for (int32 Index = 0; Index < Proxies.Meshes.Num(); ++Index)
+	{
+		FCandidateDrawable Candidate;
+		Candidate.ActorIndex = static_cast<uint32>(Index);
+		Candidate.Bound = Proxies.Meshes[Index]->GetWorldAABB();
+		Candidate.WorldViewProj = ViewProj;
+		Candidate.WorldView = View->ViewMatrix;
+		Candidate.NearClip = View->NearClip;
+		Candidate.FarClip = View->FarClip;
+		Candidates.Add(Candidate);
+	}
+
+	// --- 3. 래스터화 → HZB → 판정 ---
+	OcclusionCPU->RasterizeOccluders(Occluders, View->NearClip, View->FarClip);
+	OcclusionCPU->BuildHZB();
+
+	TArray<uint8_t> VisibleFlags(Candidates.size(), 1);
+	OcclusionCPU->TestOcclusion(Candidates, VisibleFlags);
+
+	OpaqueMeshes.Empty();
+	for (int32 Index = 0; Index < Proxies.Meshes.Num(); ++Index)
+	{
+		if (VisibleFlags[Index])
+		{
+			OpaqueMeshes.Add(Proxies.Meshes[Index]);
+		}
 	}
 
+	FOcclusionStatManager::GetInstance().UpdateStats(OcclusionCPU->GetStats());
+}
+
+void FSceneRenderer::RenderOpaquePass(EViewMode InRenderViewMode)
+{
+	// --- 1. 수집 (Collect) ---
+	MeshBatchElements.Empty();
+	// 메시는 컴포넌트 묶음별로 병렬 수집 (결과 순서는 OpaqueMeshes 순서 그대로)
+	OwnerRenderer->GetMeshBatchCollector()->Collect(OpaqueMeshes, View, MeshBatchElements);
+
 	for (UBillboardComponent* BillboardComponent : Proxies.Billboards)
 	{
 		BillboardComponent->CollectMeshBatches(MeshBatchElements, View);
@@ -950,13 +1348,40 @@ void FSceneRenderer::RenderOpaquePass(EViewMode InRenderViewMode)
 	}
 
 	// --- 2. 정렬 (Sort) ---
-	MeshBatchElements.Sort();
+	// 상태 키 + 앞→뒤 깊이로 64비트 키를 만들어 radix sort
+	FMeshBatchSorter* BatchSorter = OwnerRenderer->GetMeshBatchSorter();
+	BatchSorter->AssignKeysAndSort(MeshBatchElements, EMeshSortMode::Opaque, View->ViewMatrix);
+
+	// --- 3. 자동 인스턴싱 (같은 상태가 이어지는 스태틱 메시 배치 합치기) ---
+	FMeshDrawStats DrawStats;
+	FMeshAutoInstancing* AutoInstancing = OwnerRenderer->GetMeshAutoInstancing();
+	bool bInstanceDataBound = false;
+	if (AutoInstancing && World->GetRenderSettings().IsAutoInstancing())
+	{
+		AutoInstancing->MergeBatches(MeshBatchElements, DrawStats);
 
-	// --- 3. 그리기 (Draw) ---
+		const uint64 UploadStartCycles = FPlatformTime::Cycles64();
+		bInstanceDataBound = AutoInstancing->UploadAndBind(RHIDevice);
+		DrawStats.UploadTimeMS = static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - UploadStartCycles));
+	}
+	else
+	{
+		DrawStats.NumBatches = MeshBatchElements.Num();
+		DrawStats.NumDrawCalls = MeshBatchElements.Num();
+		DrawStats.CalculateStats();
+	}
+	FMeshDrawStatManager::GetInstance().UpdateStats(DrawStats);
+
+	// --- 4. 그리기 (Draw) ---
 	{
 		GPU_TIME_PROFILE("GPUSkinning")
 		DrawMeshBatches(MeshBatchElements, true);
 	}
+
+	if (bInstanceDataBound)
+	{
+		AutoInstancing->Unbind(RHIDevice);
+	}
 }
 
 void FSceneRenderer::RenderParticlePass()
@@ -1027,19 +1452,30 @@ void FSceneRenderer::RenderParticlePass()
 
 	FParticleStatManager::GetInstance().AddDrawCalls(SpriteParticleBatchElements.Num());
 	FParticleStatManager::GetInstance().AddDrawCalls(MeshParticleBatchElements.Num());
-	SpriteParticleBatchElements.Sort();
+	FMeshBatchSorter* BatchSorter = OwnerRenderer->GetMeshBatchSorter();
+	BatchSorter->AssignKeysAndSort(SpriteParticleBatchElements, EMeshSortMode::Translucent, View->ViewMatrix);
+	BatchSorter->AssignKeysAndSort(MeshParticleBatchElements, EMeshSortMode::Opaque, View->ViewMatrix);
+
+	// 스프라이트/메시 리스트는 서로 독립이므로 동시에 기록하고, 깊이 상태를 바꿔 가며 순서대로 재생
+	const FMeshDrawRecordContext RecordContext = GetMeshDrawRecordContext();
+	const TArray<FMeshBatchElement>* ParticleLists[2] = { &SpriteParticleBatchElements, &MeshParticleBatchElements };
+	ParallelFor(2, [&](int32 ListIndex)
+	{
+		OwnerRenderer->GetMeshPassRecording(ListIndex)->Record(*ParticleLists[ListIndex], RecordContext);
+	});
+
 	if (!SpriteParticleBatchElements.IsEmpty())
 	{
 		RHIDevice->OMSetDepthStencilState(EComparisonFunc::LessEqualReadOnly);
-		DrawMeshBatches(SpriteParticleBatchElements, true);
+		OwnerRenderer->GetCommandBackend()->Execute(OwnerRenderer->GetMeshPassRecording(0)->GetCommands());
 	}
-	
-	MeshParticleBatchElements.Sort();
 	if (!MeshParticleBatchElements.IsEmpty())
 	{
 		RHIDevice->OMSetDepthStencilState(EComparisonFunc::LessEqual);
-		DrawMeshBatches(MeshParticleBatchElements, true);
+		OwnerRenderer->GetCommandBackend()->Execute(OwnerRenderer->GetMeshPassRecording(1)->GetCommands());
 	}
+	SpriteParticleBatchElements.Empty();
+	MeshParticleBatchElements.Empty();
 
 	// Renderer 복구
 	ID3D11ShaderResourceView* NullSRV[1] = { nullptr };
@@ -1089,6 +1525,10 @@ void FSceneRenderer::RenderDecalPass()
 	RHIDevice->OMSetDepthStencilState(EComparisonFunc::LessEqualReadOnly); // 깊이 쓰기 OFF
 	RHIDevice->OMSetBlendState(true);
 
+	// 데칼마다 새로 할당하지 않도록 패스 단위로 버퍼 재사용
+	TArray<UPrimitiveComponent*> TargetPrimitives;
+	TArray<UPrimitiveComponent*> IntersectedStaticMeshComponents;
+
 	for (UDecalComponent* Decal : Proxies.Decals)
 	{
 		if (!Decal || !Decal->GetDecalTexture())
@@ -1097,11 +1537,12 @@ void FSceneRenderer::RenderDecalPass()
 		}
 
 		// Decal이 그려질 Primitives
-		TArray<UPrimitiveComponent*> TargetPrimitives;
+		TargetPrimitives.clear();
 
 		// 1. Decal의 World AABB와 충돌한 모든 StaticMeshComponent 쿼리
 		const FOBB DecalOBB = Decal->GetWorldOBB();
-		TArray<UPrimitiveComponent*> IntersectedStaticMeshComponents = BVH->QueryIntersectedComponents(DecalOBB);
+		IntersectedStaticMeshComponents.clear();
+		BVH->QueryIntersectedComponents(DecalOBB, IntersectedStaticMeshComponents);
 
 		// 2. 충돌한 모든 visible Actor의 PrimitiveComponent를 TargetPrimitives에 추가
 		// Actor에 기본으로 붙어있는 TextRenderComponent, BoundingBoxComponent는 decal 적용 안되게 하기 위해,
@@ -1140,8 +1581,10 @@ void FSceneRenderer::RenderDecalPass()
 			BatchElement.InputLayout = ShaderVariant->InputLayout;
 			BatchElement.VertexShader = ShaderVariant->VertexShader;
 			BatchElement.PixelShader = ShaderVariant->PixelShader;
-			BatchElement.VertexStride = sizeof(FVertexDynamic);
+			BatchElement.VertexStride = PackedVertex::GetStaticVertexStride();
 		}
+		// 셰이더/머티리얼은 데칼마다 고정이라 대상 메시의 버퍼 기준으로 묶임
+		OwnerRenderer->GetMeshBatchSorter()->AssignKeysAndSort(MeshBatchElements, EMeshSortMode::Opaque, View->ViewMatrix);
 		DrawMeshBatches(MeshBatchElements, true);
 
 		// --- 데칼 렌더 시간 측정 종료 및 결과 저장 ---
@@ -1433,268 +1876,36 @@ void FSceneRenderer::RenderFinalOverlayLines()
     OwnerRenderer->EndLineBatchAlwaysOnTop(FMatrix::Identity());
 }
 
-// 수집한 Batch 그리기
+// 수집한 Batch 그리기 (명령 리스트에 기록한 뒤 즉시 컨텍스트에 재생)
 void FSceneRenderer::DrawMeshBatches(TArray<FMeshBatchElement>& InMeshBatches, bool bClearListAfterDraw)
 {
 	if (InMeshBatches.IsEmpty()) return;
-	constexpr UINT ParticleInstanceDataSlot = 14;
-
-	// RHI 상태 초기 설정 (Opaque Pass 기본값)
-	// RHIDevice->OMSetDepthStencilState(EComparisonFunc::LessEqual); // 깊이 쓰기 ON
-
-	// PS 리소스 초기화
-	ID3D11ShaderResourceView* nullSRVs[2] = { nullptr, nullptr };
-	RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 2, nullSRVs);
-	ID3D11SamplerState* nullSamplers[2] = { nullptr, nullptr };
-	RHIDevice->GetDeviceContext()->PSSetSamplers(0, 2, nullSamplers);
-	FPixelConstBufferType DefaultPixelConst{};
-	RHIDevice->SetAndUpdateConstantBuffer(DefaultPixelConst);
-
-	// 현재 GPU 상태 캐싱용 변수 (UStaticMesh* 대신 실제 GPU 리소스로 변경)
-	ID3D11VertexShader* CurrentVertexShader = nullptr;
-	ID3D11PixelShader* CurrentPixelShader = nullptr;
-	UMaterialInterface* CurrentMaterial = nullptr;
-	ID3D11ShaderResourceView* CurrentInstanceSRV = nullptr; // [추가] Instance SRV 캐시
-	ID3D11Buffer* CurrentVertexBuffer = nullptr;
-	ID3D11Buffer* CurrentIndexBuffer = nullptr;
-	UINT CurrentVertexStride = 0;
-	D3D11_PRIMITIVE_TOPOLOGY CurrentTopology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
-	// GPU 스키닝
-	ID3D11ShaderResourceView* CurrentSkinMatrixSRV = nullptr;
-	ID3D11ShaderResourceView* CurrentSkinNormalMatrixSRV = nullptr;
-	RHIDevice->GetDeviceContext()->VSSetShaderResources(12, 2, nullSRVs);
-	ID3D11ShaderResourceView* CurrentInstancingSRV = nullptr;
-
-	// 기본 샘플러 미리 가져오기 (루프 내 반복 호출 방지)
-	ID3D11SamplerState* DefaultSampler = RHIDevice->GetSamplerState(RHI_Sampler_Index::Default);
-	// Shadow PCF용 샘플러 추가
-	ID3D11SamplerState* ShadowSampler = RHIDevice->GetSamplerState(RHI_Sampler_Index::Shadow);
-	ID3D11SamplerState* VSMSampler = RHIDevice->GetSamplerState(RHI_Sampler_Index::VSM);
-
-	// 정렬된 리스트 순회
-	for (const FMeshBatchElement& Batch : InMeshBatches)
-	{
-		// --- 필수 요소 유효성 검사 ---
-		const bool bMissingShaders = (!Batch.VertexShader || !Batch.PixelShader);
-		const bool bNeedsGeometryBuffers = (!Batch.VertexBuffer || !Batch.IndexBuffer || Batch.VertexStride == 0) ||
-			(Batch.bInstancedDraw && (!Batch.InstanceVertexBuffer || Batch.InstanceStride == 0));
-		const bool bMissingGeometry = bNeedsGeometryBuffers && (!Batch.VertexBuffer || !Batch.IndexBuffer || Batch.VertexStride == 0);
-		const bool bInvalidInstancing = Batch.bInstancedDraw && Batch.InstanceCount == 0;
-		if (bMissingShaders || bMissingGeometry || bInvalidInstancing)
-		{
-			continue;
-		}
-
-		// 1. 셰이더 상태 변경
-		if (Batch.VertexShader != CurrentVertexShader || Batch.PixelShader != CurrentPixelShader)
-		{
-			RHIDevice->GetDeviceContext()->IASetInputLayout(Batch.InputLayout);
-			RHIDevice->GetDeviceContext()->VSSetShader(Batch.VertexShader, nullptr, 0);
-
-			RHIDevice->GetDeviceContext()->PSSetShader(Batch.PixelShader, nullptr, 0);
-
-			CurrentVertexShader = Batch.VertexShader;
-			CurrentPixelShader = Batch.PixelShader;
-		}
-
-		// --- 2. 픽셀 상태 (텍스처, 샘플러, 재질CBuffer) 변경 (캐싱됨) ---
-		//
-		// 'Material' 또는 'Instance SRV' 둘 중 하나라도 바뀌면
-		// 모든 픽셀 리소스를 다시 바인딩해야 합니다.
-		if (Batch.Material != CurrentMaterial || Batch.InstanceShaderResourceView != CurrentInstanceSRV)
-		{
-			ID3D11ShaderResourceView* DiffuseTextureSRV = nullptr; // t0
-			ID3D11ShaderResourceView* NormalTextureSRV = nullptr;  // t1
-			FPixelConstBufferType PixelConst{};
-
-			if (Batch.Material)
-			{
-				PixelConst.Material = Batch.Material->GetMaterialInfo();
-				PixelConst.bHasMaterial = true;
-			}
-			else
-			{
-				FMaterialInfo DefaultMaterialInfo;
-				PixelConst.Material = DefaultMaterialInfo;
-				PixelConst.bHasMaterial = false;
-				PixelConst.bHasDiffuseTexture = false;
-				PixelConst.bHasNormalTexture = false;
-			}
-
-			// 1순위: 인스턴스 텍스처 (빌보드)
-			if (Batch.InstanceShaderResourceView)
-			{
-				DiffuseTextureSRV = Batch.InstanceShaderResourceView;
-				PixelConst.bHasDiffuseTexture = true;
-				PixelConst.bHasNormalTexture = false;
-			}
-			// 2순위: 머티리얼 텍스처 (스태틱 메시)
-			else if (Batch.Material)
-			{
-				const FMaterialInfo& MaterialInfo = Batch.Material->GetMaterialInfo();
-				/*UE_LOG("[SceneRenderer] Material: %s, DiffuseTexture: %s",
-					   Batch.Material->GetName().c_str(),
-					   MaterialInfo.DiffuseTextureFileName.c_str());*/
-
-				if (!MaterialInfo.DiffuseTextureFileName.empty())
-				{
-					if (UTexture* TextureData = Batch.Material->GetTexture(EMaterialTextureSlot::Diffuse))
-					{
-						DiffuseTextureSRV = TextureData->GetShaderResourceView();
-						PixelConst.bHasDiffuseTexture = (DiffuseTextureSRV != nullptr);
-						// UE_LOG("[SceneRenderer] Diffuse SRV: %s", DiffuseTextureSRV ? "Valid" : "NULL");
-					}
-					else
-					{
-						//UE_LOG("[SceneRenderer] Failed to get Diffuse texture!");
-					}
-				}
-				if (!MaterialInfo.NormalTextureFileName.empty())
-				{
-					if (UTexture* TextureData = Batch.Material->GetTexture(EMaterialTextureSlot::Normal))
-					{
-						NormalTextureSRV = TextureData->GetShaderResourceView();
-						PixelConst.bHasNormalTexture = (NormalTextureSRV != nullptr);
-					}
-				}
-			}
-			
-			// --- RHI 상태 업데이트 ---
-			// 1. 텍스처(SRV) 바인딩
-			ID3D11ShaderResourceView* Srvs[2] = { DiffuseTextureSRV, NormalTextureSRV };
-			RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 2, Srvs);
-
-			// 2. 샘플러 바인딩
-			ID3D11SamplerState* Samplers[4] = { DefaultSampler, DefaultSampler, ShadowSampler, VSMSampler };
-			RHIDevice->GetDeviceContext()->PSSetSamplers(0, 4, Samplers);			
-
-			// 3. 재질 CBuffer 바인딩
-			RHIDevice->SetAndUpdateConstantBuffer(PixelConst);
-
-			// --- 캐시 업데이트 ---
-			CurrentMaterial = Batch.Material;
-			CurrentInstanceSRV = Batch.InstanceShaderResourceView;
-		}
-
-		if (Batch.GPUSkinMatrixSRV != CurrentSkinMatrixSRV || Batch.GPUSkinNormalMatrixSRV != CurrentSkinNormalMatrixSRV)
-		{
-			// t12, t13
-			ID3D11ShaderResourceView* SkinSRVs[2] = {Batch.GPUSkinMatrixSRV, Batch.GPUSkinNormalMatrixSRV};
 
-			RHIDevice->GetDeviceContext()->VSSetShaderResources(12, 2, SkinSRVs);
-
-			CurrentSkinMatrixSRV = Batch.GPUSkinMatrixSRV;
-			CurrentSkinNormalMatrixSRV = Batch.GPUSkinNormalMatrixSRV;
-		}
-
-		if (CurrentInstancingSRV)
-		{
-			ID3D11ShaderResourceView* SRV = nullptr;
-			RHIDevice->GetDeviceContext()->VSSetShaderResources(ParticleInstanceDataSlot, 1, &SRV);
-			CurrentInstancingSRV = nullptr;
-		}
-
-		// 3. IA (Input Assembler) 상태 변경
-		if (Batch.VertexBuffer != CurrentVertexBuffer ||
-			Batch.IndexBuffer != CurrentIndexBuffer ||
-			Batch.VertexStride != CurrentVertexStride ||
-			Batch.PrimitiveTopology != CurrentTopology)
-		{
-			if (Batch.bInstancedDraw)
-			{
-				// 두 개의 VB: 0 = mesh, 1 = instance
-				ID3D11Buffer* vbs[2] = { Batch.VertexBuffer, Batch.InstanceVertexBuffer };
-				UINT strides[2] = { Batch.VertexStride, Batch.InstanceStride };
-				UINT offsets[2] = { 0, Batch.InstanceStart * Batch.InstanceStride }; // InstanceStart 오프셋
-
-				RHIDevice->GetDeviceContext()->IASetVertexBuffers(0, 2, vbs, strides, offsets);
-
-				DXGI_FORMAT IndexFormat = Batch.IndexBuffer ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_UNKNOWN;
-				RHIDevice->GetDeviceContext()->IASetIndexBuffer(Batch.IndexBuffer, IndexFormat, 0);
-				RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(Batch.PrimitiveTopology);
-			}
-			else
-			{
-				// 기존 non-instanced path
-				UINT stride = Batch.VertexStride;
-				UINT offset = 0;
-				RHIDevice->GetDeviceContext()->IASetVertexBuffers(0, 1, &Batch.VertexBuffer, &stride, &offset);
-				DXGI_FORMAT IndexFormat = Batch.IndexBuffer ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_UNKNOWN;
-				RHIDevice->GetDeviceContext()->IASetIndexBuffer(Batch.IndexBuffer, IndexFormat, 0);
-				RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(Batch.PrimitiveTopology);
-			}
-
-			// 현재 IA 상태 캐싱
-			CurrentVertexBuffer = Batch.VertexBuffer;
-			CurrentIndexBuffer = Batch.IndexBuffer;
-			CurrentVertexStride = Batch.VertexStride;
-			CurrentTopology = Batch.PrimitiveTopology;
-		}
-
-		// 4. 오브젝트별 상수 버퍼 설정 (매번 변경)
-		RHIDevice->SetAndUpdateConstantBuffer(ModelBufferType(Batch.WorldMatrix, Batch.WorldMatrix.InverseAffine().Transpose()));
-		RHIDevice->SetAndUpdateConstantBuffer(ColorBufferType(Batch.InstanceColor, Batch.ObjectID));
-
-		// SubUV 파라미터 설정 (파티클에서만 필요)
-		if (Batch.SubImages_Horizontal > 1 || Batch.SubImages_Vertical > 1)
-		{
-			FSubUVBufferType SubUVBuffer;
-			SubUVBuffer.SubImages_Horizontal = Batch.SubImages_Horizontal;
-			SubUVBuffer.SubImages_Vertical = Batch.SubImages_Vertical;
-			SubUVBuffer.InterpMethod = Batch.SubUV_InterpMethod;
-			SubUVBuffer.Padding0 = 0.0f;
-			RHIDevice->SetAndUpdateConstantBuffer(SubUVBuffer);
-
-			// static int32 DebugCounter = 0;
-			// if (DebugCounter++ % 60 == 0)
-			// {
-			// 	UE_LOG("SubUV Constant Buffer: H=%d, V=%d, InterpMethod=%d",
-			// 		SubUVBuffer.SubImages_Horizontal, SubUVBuffer.SubImages_Vertical, SubUVBuffer.InterpMethod);
-			// }
-		}
-		else
-		{
-			FSubUVBufferType SubUVBuffer;
-			RHIDevice->SetAndUpdateConstantBuffer(SubUVBuffer);
-		}
-
-		if (Batch.ScreenAlignment != EScreenAlignment::None)
-		{
-			FParticleEmitterType ParticleEmitterType;
-			ParticleEmitterType.ScreenAlignment = static_cast<uint32>(Batch.ScreenAlignment);
-			RHIDevice->SetAndUpdateConstantBuffer(ParticleEmitterType);
-		}
-		
-		if (Batch.bInstancedDraw)
-		{
-			if (Batch.IndexBuffer && Batch.VertexBuffer && Batch.VertexStride > 0)
-			{
-				RHIDevice->GetDeviceContext()->DrawIndexedInstanced(Batch.IndexCount, Batch.InstanceCount, Batch.StartIndex, Batch.BaseVertexIndex, Batch.InstanceStart);
-			}
-			else
-			{
-				RHIDevice->GetDeviceContext()->DrawInstanced(Batch.IndexCount, Batch.InstanceCount, 0, Batch.InstanceStart);
-			}
-		}
-		else
-		{
-			RHIDevice->GetDeviceContext()->DrawIndexed(Batch.IndexCount, Batch.StartIndex, Batch.BaseVertexIndex);
-		}
-	}
+	FMeshPassRecording* Recording = OwnerRenderer->GetMeshPassRecording(0);
+	Recording->Record(InMeshBatches, GetMeshDrawRecordContext());
+	OwnerRenderer->GetCommandBackend()->Execute(Recording->GetCommands());
 
 	// 루프 종료 후 리스트 비우기 (옵션)
 	if (bClearListAfterDraw)
 	{
 		InMeshBatches.Empty();
-		if (CurrentInstancingSRV)
-		{
-			ID3D11ShaderResourceView* SRV = nullptr;
-			RHIDevice->GetDeviceContext()->VSSetShaderResources(ParticleInstanceDataSlot, 1, &SRV);
-			CurrentInstancingSRV = nullptr;
-		}
 	}
 }
 
+FMeshDrawRecordContext FSceneRenderer::GetMeshDrawRecordContext() const
+{
+	FMeshDrawRecordContext Context;
+	Context.DefaultSampler = RHIDevice->GetSamplerState(RHI_Sampler_Index::Default);
+	// Shadow PCF / VSM 샘플러
+	Context.ShadowSampler = RHIDevice->GetSamplerState(RHI_Sampler_Index::Shadow);
+	Context.VSMSampler = RHIDevice->GetSamplerState(RHI_Sampler_Index::VSM);
+
+	// 상수 버퍼 오프셋을 지원하지 않거나 꺼져 있으면 기존처럼 드로우마다 Map/Unmap
+	FObjectConstantRing* ConstantRing = OwnerRenderer->GetObjectConstantRing();
+	Context.bUseConstantBlocks = ConstantRing && World->GetRenderSettings().IsObjectConstantRing() && ConstantRing->IsSupported(RHIDevice);
+	return Context;
+}
+
 void FSceneRenderer::ApplyScreenEffectsPass()
 {
 	if (!World->GetRenderSettings().IsShowFlagEnabled(EEngineShowFlags::SF_FXAA))
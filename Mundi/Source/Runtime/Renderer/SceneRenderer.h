@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "Frustum.h"
+#include "AABB.h"
+#include "ShadowCasterSelection.h"
 
 // TODO : Post Processing 떼어내기, 전방선언으로라든지...
 #include "PostProcessing/FadeInOutPass.h"
@@ -24,6 +26,7 @@ class UDirectionalLightComponent;
 class UPointLightComponent;
 class USpotLightComponent;
 struct FMeshBatchElement;
+struct FMeshDrawRecordContext;
 class UMeshComponent;
 class UBillboardComponent;
 class UTextRenderComponent;
@@ -32,8 +35,11 @@ class FSceneView;
 class FTileLightCuller;
 class ULineComponent;
 class UParticleSystemComponent;
+class FOcclusionCullingManagerCPU;
 
 struct FCandidateDrawable;
+struct FShadowStats;
+struct FBoundingSphere;
 
 // 렌더링할 대상들의 집합을 담는 구조체
 struct FVisibleRenderProxySet
@@ -90,6 +96,19 @@ private:
 	void RenderShadowMaps();
 	void RenderShadowDepthPass(FShadowRenderRequest& ShadowRequest, const TArray<FMeshBatchElement>& InShadowBatches);
 
+	/** @brief 섀도우 캐스터 메시를 한 번 수집해 배치 범위, 월드 바운드, 정적 여부를 기록합니다. */
+	void GatherShadowCasters(FShadowCasterCache& CasterCache);
+	/** @brief 섀도우 뷰 볼륨과 겹치는 캐스터 인덱스를 모읍니다. (BVH 쿼리, BVH가 없으면 바운드 전수 검사) */
+	void QueryShadowCasters(const FFrustum& InFrustum, TArray<int32>& OutCasters);
+	void QueryShadowCasters(const FBoundingSphere& InSphere, TArray<int32>& OutCasters);
+	/**
+	 * @brief 섀도우 뷰 하나를 그립니다. 대상 DSV/뷰포트는 호출부에서 바인딩하고 비워 둔 상태여야 합니다.
+	 * bAllowCache면 정적 캐스터는 캐시(변경 시에만 다시 그림)에서 합성하고 동적 캐스터만 그 위에 그립니다.
+	 */
+	void RenderShadowView(FShadowRenderRequest& Request, const TArray<int32>& InViewCasters, ID3D11DepthStencilView* TargetDSV,
+		const D3D11_VIEWPORT& TargetViewport, bool bAllowCache, FShadowCasterCache& CasterCache, FShadowStats& InOutStats);
+	void CompositeStaticShadowCache(const FStaticShadowCacheEntry& Entry, const D3D11_VIEWPORT& TargetViewport);
+
 	/** @brief 렌더링에 필요한 포인터들이 유효한지 확인합니다. */
 	bool IsValid() const;
 
@@ -102,6 +121,9 @@ private:
 	/** @brief 씬을 순회하며 컬링을 통과한 모든 렌더링 대상을 수집합니다. */
 	void GatherVisibleProxies();
 
+	/** @brief 큰 스태틱 메시를 CPU 깊이 버퍼에 래스터화하고 가려진 메시를 OpaqueMeshes에서 제외합니다. */
+	void PerformOcclusionCulling();
+
 	/** @brief 타일 기반 라이트 컬링을 수행하고 Structured Buffer를 업데이트합니다. */
 	void PerformTileLightCulling();
 
@@ -109,6 +131,7 @@ private:
 	void RenderOpaquePass(EViewMode InRenderViewMode);
 
 	void DrawMeshBatches(TArray<FMeshBatchElement>& InMeshBatches, bool bClearListAfterDraw);
+	FMeshDrawRecordContext GetMeshDrawRecordContext() const;
 
 	void RenderParticlePass();
 	void RenderDecalPass();
@@ -149,9 +172,24 @@ private:
 	// 컬링을 거친 가시성 목록, NOTE: 추후 컴포넌트 단위로 수정
 	TArray<UPrimitiveComponent*> PotentiallyVisibleComponents;
 
+	// 오클루전 컬링을 통과한 메시 (가려진 메시도 그림자는 드리우므로 그림자 패스는 Proxies.Meshes 전체 사용)
+	TArray<UMeshComponent*> OpaqueMeshes;
+
+	// CPU 소프트웨어 오클루전 컬링 (깊이 버퍼를 매 프레임 이번 뷰의 오클루더로 새로 그리므로 씬 렌더러와 수명이 같음)
+	std::unique_ptr<FOcclusionCullingManagerCPU> OcclusionCPU;
+
 	// 각 패스에서 수집된 드로우 콜 정보 리스트
 	TArray<FMeshBatchElement> MeshBatchElements;
 
+	// 섀도우 캐스터 (RenderShadowMaps에서 한 번 수집, 뷰마다 인덱스로 컬링)
+	TArray<FShadowCaster> ShadowCasters;
+	TArray<FMeshBatchElement> ShadowCasterBatches;
+	TArray<UMeshComponent*> ShadowCasterCandidates;	// 그림자를 드리우는 보이는 메시 (FMeshBatchCollector 입력)
+	TArray<int32> ShadowCasterBatchOffsets;		// 후보 i의 배치는 ShadowCasterBatches[Offsets[i], Offsets[i + 1])
+	TMap<UPrimitiveComponent*, int32> ShadowCasterIndices;
+	TArray<UPrimitiveComponent*> ShadowQueryResults;
+	TArray<FMeshBatchElement> ShadowViewBatches;
+
 	// 타일 기반 라이트 컬링 시스템 (매 프레임 생성되고 소멸되어서 스마트 포인터로 설정)
 	std::unique_ptr<FTileLightCuller> TileLightCuller;
 
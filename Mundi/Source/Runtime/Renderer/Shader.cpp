@@ -1,9 +1,27 @@
 ﻿#include "pch.h"
 #include "Shader.h"
 #include "Hash.h"
+#include "PackedVertex.h"
 
 IMPLEMENT_CLASS(UShader)
 
+namespace
+{
+	// 변형 맵은 게임 스레드에서만 바뀌고, 컴파일 금지 구간의 스레드는 읽기만 함
+	thread_local bool GVariantCompileAllowed = true;
+	thread_local uint32 GNumMissedVariants = 0;
+}
+
+void UShader::SetVariantCompileAllowed(bool bAllowed)
+{
+	GVariantCompileAllowed = bAllowed;
+}
+
+uint32 UShader::GetNumMissedVariants()
+{
+	return GNumMissedVariants;
+}
+
 // 컴파일 로직을 처리하는 비공개 헬퍼 함수
 static bool CompileShaderInternal(
 	const FWideString& InFilePath,
@@ -149,6 +167,17 @@ bool UShader::Load(const FString& InShaderPath, ID3D11Device* InDevice, const TA
  */
 FShaderVariant* UShader::GetOrCompileShaderVariant(const TArray<FShaderMacro>& InMacros)
 {
+	// 병렬 수집 중인 워커: 찾기만 하고 컴파일은 호출부가 게임 스레드에서 다시 시도
+	if (!GVariantCompileAllowed)
+	{
+		if (FShaderVariant* Found = ShaderVariantMap.Find(GenerateShaderKey(InMacros)))
+		{
+			return Found;
+		}
+		++GNumMissedVariants;
+		return nullptr;
+	}
+
 	ID3D11Device* InDevice = GEngine.GetRHIDevice()->GetDevice();
 
 	// 이 UShader 객체가 어떤 파일인지 알아야 컴파일 가능
@@ -340,8 +369,10 @@ void UShader::CreateInputLayout(ID3D11Device* Device, const FString& InShaderPat
 
 	if (HasMacro(InOutVariant.SourceMacros, "USE_GPU_SKINNING"))
 	{
-		descArray.Add({"BLENDINDICES", 0, DXGI_FORMAT_R32G32B32A32_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0});
-		descArray.Add({"BLENDWEIGHT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0});
+		// FPackedSkinnedVertex: uint16 인덱스 + unorm8 가중치 (셰이더에서는 똑같이 uint4 / float4)
+		const bool bPacked = PackedVertex::IsEnabled();
+		descArray.Add({"BLENDINDICES", 0, bPacked ? DXGI_FORMAT_R16G16B16A16_UINT : DXGI_FORMAT_R32G32B32A32_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0});
+		descArray.Add({"BLENDWEIGHT", 0, bPacked ? DXGI_FORMAT_R8G8B8A8_UNORM : DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0});
 	}
 	
 	const D3D11_INPUT_ELEMENT_DESC* layout = descArray.data();
@@ -543,6 +574,7 @@ void UShader::ParseIncludeFiles(const FString& ShaderPath)
 {
 	// 이미 파싱된 파일 목록 초기화
 	IncludedFiles.clear();
+	bSupportsInstancing = false;
 
 	// 파싱할 파일 큐
 	TArray<FString> FilesToParse;
@@ -591,6 +623,12 @@ void UShader::ParseIncludeFiles(const FString& ShaderPath)
 			}
 			Line = Line.substr(FirstNonSpace);
 
+			// 자동 인스턴싱 변형 지원 여부 (UberLit.hlsl의 #ifndef USE_INSTANCING 등)
+			if (Line[0] == '#' && Line.find("USE_INSTANCING") != FString::npos)
+			{
+				bSupportsInstancing = true;
+			}
+
 			// #include 지시문 찾기
 			if (Line.compare(0, 8, "#include") == 0)
 			{
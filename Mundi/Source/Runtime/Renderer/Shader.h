@@ -65,6 +65,14 @@ public:
 	//const TArray<FShaderMacro>& GetMacros() const { return Macros; }
 
 	static bool HasMacro(const TArray<FShaderMacro>& InMacros, const FString& InMacroName);
+
+	// 소스(또는 include)가 USE_INSTANCING 변형을 지원하는지 (자동 인스턴싱 대상 판정)
+	bool SupportsInstancing() const { return bSupportsInstancing; }
+
+	// 이 스레드에서 변형 컴파일 금지 (병렬 메시 배치 수집 구간, FMeshBatchCollector가 설정)
+	// 금지 중에는 GetOrCompileShaderVariant가 이미 있는 변형만 돌려주고, 없으면 nullptr + 놓친 횟수 증가
+	static void SetVariantCompileAllowed(bool bAllowed);
+	static uint32 GetNumMissedVariants();
 	
 protected:
 	virtual ~UShader();
@@ -77,6 +85,9 @@ private:
 	TArray<FString> IncludedFiles;
 	TMap<FString, std::filesystem::file_time_type> IncludedFileTimestamps;
 
+	// ParseIncludeFiles에서 소스를 읽으며 함께 판정
+	bool bSupportsInstancing = false;
+
 	void CreateInputLayout(ID3D11Device* Device, const FString& InShaderPath, FShaderVariant& InOutVariant);
 	void ReleaseResources();
 
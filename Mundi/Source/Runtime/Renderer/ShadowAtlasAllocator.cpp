@@ -0,0 +1,597 @@
+﻿#include "pch.h"
+#include "ShadowAtlasAllocator.h"
+#include "LightManager.h"
+#include <algorithm>
+
+namespace
+{
+	// 블록 원점 키 (Y 우선이라 작은 키가 아틀라스 위쪽/왼쪽)
+	inline uint32 MakeBlockKey(uint32 X, uint32 Y) { return (Y << 16) | X; }
+	inline uint32 GetBlockX(uint32 Key) { return Key & 0xFFFFu; }
+	inline uint32 GetBlockY(uint32 Key) { return Key >> 16; }
+
+	inline uint32 FloorPowerOfTwo(uint32 Value)
+	{
+		uint32 Result = 1;
+		while (Result * 2 <= Value && Result < (1u << 30))
+		{
+			Result *= 2;
+		}
+		return Value > 0 ? Result : 0;
+	}
+
+	int32 FindFreeBlock(const TArray<uint32>& FreeList, uint32 Key)
+	{
+		for (int32 Index = 0; Index < FreeList.Num(); ++Index)
+		{
+			if (FreeList[Index] == Key)
+			{
+				return Index;
+			}
+		}
+		return -1;
+	}
+
+	void RemoveFreeBlockAt(TArray<uint32>& FreeList, int32 Index)
+	{
+		FreeList[Index] = FreeList[FreeList.Num() - 1];
+		FreeList.pop_back();
+	}
+}
+
+void FShadowAtlasAllocator::Initialize(uint32 InAtlasSize, uint32 InMinBlockSize)
+{
+	TextureSize = InAtlasSize;
+	AtlasSize = FloorPowerOfTwo(FMath::Min(InAtlasSize, 1u << 15));	// 키가 좌표당 16비트
+	MinBlockSize = FMath::Max(FMath::Min(FloorPowerOfTwo(InMinBlockSize), AtlasSize), 1u);
+
+	MaxLevel = 0;
+	while (AtlasSize > 0 && GetBlockSize(MaxLevel + 1) >= MinBlockSize)
+	{
+		++MaxLevel;
+	}
+
+	Reset();
+}
+
+void FShadowAtlasAllocator::Reset()
+{
+	FreeLists.SetNum(MaxLevel + 1);
+	for (TArray<uint32>& FreeList : FreeLists)
+	{
+		FreeList.Empty();
+	}
+	if (AtlasSize > 0)
+	{
+		FreeLists[0].Add(MakeBlockKey(0, 0));
+	}
+
+	Records.clear();
+	FragmentedFrames = 0;
+	Items.Empty();
+	ItemOrder.Empty();
+	Stats = FShadowAtlasAllocStats();
+}
+
+int32 FShadowAtlasAllocator::GetLevelForSize(uint32 Size) const
+{
+	int32 Level = 0;
+	while (Level < MaxLevel && GetBlockSize(Level + 1) >= Size)
+	{
+		++Level;
+	}
+	return Level;
+}
+
+void FShadowAtlasAllocator::Allocate(TArray<FShadowRenderRequest>& InOutRequests)
+{
+	Stats = FShadowAtlasAllocStats();
+	Stats.NumRequests = InOutRequests.Num();
+	++FrameIndex;
+	Items.Empty();
+
+	if (AtlasSize == 0)
+	{
+		for (FShadowRenderRequest& Request : InOutRequests)
+		{
+			Request.Size = 0;
+		}
+		Stats.NumDropped = InOutRequests.Num();
+		return;
+	}
+
+	// 1. 서브뷰 기록 확보 (배열 크기를 먼저 정해 두고 아래에서 포인터를 잡음)
+	for (const FShadowRenderRequest& Request : InOutRequests)
+	{
+		if (Request.LightOwner && Request.Size > 0 && Request.SubViewIndex >= 0)
+		{
+			TArray<FAtlasRecord>& LightRecords = Records[Request.LightOwner];
+			if (LightRecords.Num() <= Request.SubViewIndex)
+			{
+				LightRecords.SetNum(Request.SubViewIndex + 1);
+			}
+		}
+	}
+
+	// 2. 요청별 원하는 단계 (중요도 → 해상도, 히스테리시스)
+	for (int32 RequestIndex = 0; RequestIndex < InOutRequests.Num(); ++RequestIndex)
+	{
+		FShadowRenderRequest& Request = InOutRequests[RequestIndex];
+		if (!Request.LightOwner || Request.Size == 0 || Request.SubViewIndex < 0)
+		{
+			Request.Size = 0;
+			continue;
+		}
+
+		FAtlasRecord& Record = Records[Request.LightOwner][Request.SubViewIndex];
+		if (Record.LastFrame == FrameIndex)
+		{
+			// 같은 서브뷰 중복 요청
+			Request.Size = 0;
+			continue;
+		}
+		Record.LastFrame = FrameIndex;
+
+		FFrameItem Item;
+		Item.RequestIndex = RequestIndex;
+		Item.Record = &Record;
+		Item.Priority = FMath::Clamp(Request.ScreenImportance, 0.0f, 1.0f);
+
+		// 중요도가 절반으로 줄 때마다 해상도 한 단계 (1 ~ 0.5: 원래 크기)
+		int32 Shift = 0;
+		while (Shift < MaxImportanceShift && Item.Priority < 0.5f / static_cast<float>(1 << Shift))
+		{
+			++Shift;
+		}
+		Item.ScaledSize = FMath::Max(Request.Size >> Shift, FMath::Min(Request.Size, MinBlockSize));
+
+		const int32 DesiredLevel = GetLevelForSize(Item.ScaledSize);
+		Item.bNew = Record.Level < 0;
+		Item.PrevKey = Record.Key;
+		Item.PrevLevel = Record.Level;
+
+		if (Item.bNew || DesiredLevel == Record.Level)
+		{
+			Record.PendingLevel = -1;
+			Record.PendingFrames = 0;
+			Item.WantedLevel = DesiredLevel;
+		}
+		else
+		{
+			// 중요도가 경계에서 흔들릴 때 블록이 매 프레임 바뀌지 않도록 일정 프레임 유지된 변화만 반영
+			if (Record.PendingLevel == DesiredLevel)
+			{
+				++Record.PendingFrames;
+			}
+			else
+			{
+				Record.PendingLevel = DesiredLevel;
+				Record.PendingFrames = 1;
+			}
+			Item.WantedLevel = Record.PendingFrames >= ResizeDelayFrames ? DesiredLevel : Record.Level;
+		}
+		Item.TargetLevel = Item.WantedLevel;
+		Items.Add(Item);
+	}
+
+	// 3. 이번에 요청되지 않은 서브뷰의 블록 반환 (제거된 라이트 포인터도 여기서 정리)
+	for (auto It = Records.begin(); It != Records.end();)
+	{
+		bool bAnyUsed = false;
+		for (FAtlasRecord& Record : It->second)
+		{
+			if (Record.LastFrame == FrameIndex)
+			{
+				bAnyUsed = true;
+			}
+			else if (Record.Level >= 0)
+			{
+				FreeBlock(Record.Level, Record.Key);
+				Record.Level = -1;
+				Record.PendingLevel = -1;
+				Record.PendingFrames = 0;
+			}
+		}
+
+		if (!bAnyUsed)
+		{
+			It = Records.erase(It);
+		}
+		else
+		{
+			++It;
+		}
+	}
+
+	// 4. 면적 예산: 넘치면 중요도가 낮은 요청부터 한 단계씩 줄임 (한 바퀴 안에서 맞으면 멈춤)
+	const uint64 AtlasArea = GetBlockArea(0);
+	uint64 TotalArea = 0;
+	for (const FFrameItem& Item : Items)
+	{
+		TotalArea += GetBlockArea(Item.TargetLevel);
+	}
+	if (TotalArea > AtlasArea)
+	{
+		ItemOrder.SetNum(Items.Num());
+		for (int32 Index = 0; Index < Items.Num(); ++Index)
+		{
+			ItemOrder[Index] = Index;
+		}
+		std::stable_sort(ItemOrder.begin(), ItemOrder.end(), [this](int32 A, int32 B)
+		{
+			if (Items[A].Priority != Items[B].Priority)
+			{
+				return Items[A].Priority < Items[B].Priority;
+			}
+			return Items[A].TargetLevel < Items[B].TargetLevel;
+		});
+
+		bool bChanged = true;
+		while (TotalArea > AtlasArea && bChanged)
+		{
+			bChanged = false;
+			for (int32 Index : ItemOrder)
+			{
+				FFrameItem& Item = Items[Index];
+				if (Item.TargetLevel < MaxLevel)
+				{
+					TotalArea -= GetBlockArea(Item.TargetLevel) - GetBlockArea(Item.TargetLevel + 1);
+					++Item.TargetLevel;
+					bChanged = true;
+					if (TotalArea <= AtlasArea)
+					{
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	// 이후 배치 순서: 큰 블록 먼저, 같은 크기면 중요도 높은 순 (버디 할당은 큰 것부터 넣으면 면적만 맞으면 다 들어감)
+	ItemOrder.SetNum(Items.Num());
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		ItemOrder[Index] = Index;
+	}
+	std::stable_sort(ItemOrder.begin(), ItemOrder.end(), [this](int32 A, int32 B)
+	{
+		if (Items[A].TargetLevel != Items[B].TargetLevel)
+		{
+			return Items[A].TargetLevel < Items[B].TargetLevel;
+		}
+		return Items[A].Priority > Items[B].Priority;
+	});
+
+	// 5. 기존 블록 축소 (같은 원점 유지, 남는 부분은 빈 블록으로)
+	for (FFrameItem& Item : Items)
+	{
+		FAtlasRecord& Record = *Item.Record;
+		if (!Item.bNew && Item.TargetLevel > Record.Level)
+		{
+			ShrinkBlock(Record.Level, Record.Key, Item.TargetLevel);
+			Record.Level = Item.TargetLevel;
+		}
+	}
+
+	// 6. 기존 블록 확대 (제자리 → 다른 곳으로 이동 → 실패하면 지금 블록 유지)
+	for (int32 Index : ItemOrder)
+	{
+		FFrameItem& Item = Items[Index];
+		FAtlasRecord& Record = *Item.Record;
+		if (Item.bNew || Item.TargetLevel >= Record.Level)
+		{
+			continue;
+		}
+
+		if (TryGrowInPlace(Record.Level, Record.Key, Item.TargetLevel))
+		{
+			Record.Level = Item.TargetLevel;
+			continue;
+		}
+
+		uint32 NewKey = 0;
+		if (AllocBlock(Item.TargetLevel, NewKey))
+		{
+			FreeBlock(Record.Level, Record.Key);
+			Record.Key = NewKey;
+			Record.Level = Item.TargetLevel;
+		}
+	}
+
+	// 7. 새 요청 배치 (원하는 크기가 없으면 한 단계씩 작게)
+	bool bNeedRepack = false;
+	for (int32 Index : ItemOrder)
+	{
+		FFrameItem& Item = Items[Index];
+		if (!Item.bNew)
+		{
+			continue;
+		}
+
+		FAtlasRecord& Record = *Item.Record;
+		for (int32 Level = Item.TargetLevel; Level <= MaxLevel; ++Level)
+		{
+			uint32 Key = 0;
+			if (AllocBlock(Level, Key))
+			{
+				Record.Key = Key;
+				Record.Level = Level;
+				break;
+			}
+		}
+		bNeedRepack |= Record.Level < 0;
+	}
+
+	// 8. 면적은 맞는데 단편화로 예산 단계보다 작게 받은 요청이 계속 남아 있거나 최소 블록도 못 넣었으면
+	//    예산 단계 그대로 전체를 다시 배치 (모든 위치가 바뀌므로 드물게만)
+	bool bFragmented = false;
+	for (const FFrameItem& Item : Items)
+	{
+		bFragmented |= Item.Record->Level > Item.TargetLevel;
+	}
+	FragmentedFrames = bFragmented ? FragmentedFrames + 1 : 0;
+
+	if (bNeedRepack || FragmentedFrames >= ResizeDelayFrames)
+	{
+		Repack();
+		Stats.NumRepacks = 1;
+		FragmentedFrames = 0;
+	}
+
+	// 9. 결과 기록
+	const float AtlasTextureSize = static_cast<float>(TextureSize);
+	uint64 UsedArea = 0;
+	for (const FFrameItem& Item : Items)
+	{
+		FShadowRenderRequest& Request = InOutRequests[Item.RequestIndex];
+		const FAtlasRecord& Record = *Item.Record;
+		if (Record.Level < 0)
+		{
+			Request.Size = 0; // 꽉 참 (렌더링 실패)
+			++Stats.NumDropped;
+			continue;
+		}
+
+		const uint32 X = GetBlockX(Record.Key);
+		const uint32 Y = GetBlockY(Record.Key);
+		Request.Size = FMath::Min(Item.ScaledSize, GetBlockSize(Record.Level));
+		Request.AtlasViewportOffset = FVector2D(static_cast<float>(X), static_cast<float>(Y));
+
+		// Pass 2 데이터 (UV) 저장
+		Request.AtlasScaleOffset = FVector4(
+			Request.Size / AtlasTextureSize,    // ScaleX
+			Request.Size / AtlasTextureSize,    // ScaleY
+			X / AtlasTextureSize,               // OffsetX
+			Y / AtlasTextureSize                // OffsetY
+		);
+
+		++Stats.NumAllocated;
+		UsedArea += GetBlockArea(Record.Level);
+		if (Item.bNew)
+		{
+			++Stats.NumNew;
+		}
+		else
+		{
+			Stats.NumResized += Record.Level != Item.PrevLevel ? 1 : 0;
+			Stats.NumRelocated += Record.Key != Item.PrevKey ? 1 : 0;
+		}
+		Stats.NumDegraded += Record.Level > Item.WantedLevel ? 1 : 0;
+	}
+
+	Stats.UsedPercent = static_cast<float>(static_cast<double>(UsedArea) / static_cast<double>(AtlasArea) * 100.0);
+	UpdateFreeSpaceStats();
+}
+
+bool FShadowAtlasAllocator::AllocBlock(int32 Level, uint32& OutKey)
+{
+	TArray<uint32>& FreeList = FreeLists[Level];
+	if (!FreeList.IsEmpty())
+	{
+		// 가장 위/왼쪽 블록 (빈 공간을 한쪽으로 모아 큰 블록이 남도록)
+		int32 BestIndex = 0;
+		for (int32 Index = 1; Index < FreeList.Num(); ++Index)
+		{
+			if (FreeList[Index] < FreeList[BestIndex])
+			{
+				BestIndex = Index;
+			}
+		}
+		OutKey = FreeList[BestIndex];
+		RemoveFreeBlockAt(FreeList, BestIndex);
+		return true;
+	}
+
+	if (Level == 0)
+	{
+		return false;
+	}
+
+	// 한 단계 큰 블록을 4분할해 왼쪽 위를 쓰고 나머지 셋은 빈 블록으로
+	uint32 ParentKey = 0;
+	if (!AllocBlock(Level - 1, ParentKey))
+	{
+		return false;
+	}
+
+	const uint32 Size = GetBlockSize(Level);
+	const uint32 X = GetBlockX(ParentKey);
+	const uint32 Y = GetBlockY(ParentKey);
+	FreeList.Add(MakeBlockKey(X + Size, Y));
+	FreeList.Add(MakeBlockKey(X, Y + Size));
+	FreeList.Add(MakeBlockKey(X + Size, Y + Size));
+	OutKey = ParentKey;
+	return true;
+}
+
+void FShadowAtlasAllocator::FreeBlock(int32 Level, uint32 Key)
+{
+	// 형제 셋이 모두 비어 있으면 부모로 합치고 위로 반복
+	while (Level > 0)
+	{
+		const uint32 Size = GetBlockSize(Level);
+		const uint32 ParentMask = ~(Size * 2 - 1);
+		const uint32 ParentX = GetBlockX(Key) & ParentMask;
+		const uint32 ParentY = GetBlockY(Key) & ParentMask;
+		const uint32 Children[4] = {
+			MakeBlockKey(ParentX, ParentY),
+			MakeBlockKey(ParentX + Size, ParentY),
+			MakeBlockKey(ParentX, ParentY + Size),
+			MakeBlockKey(ParentX + Size, ParentY + Size)
+		};
+
+		TArray<uint32>& FreeList = FreeLists[Level];
+		bool bAllSiblingsFree = true;
+		for (uint32 Child : Children)
+		{
+			if (Child != Key && FindFreeBlock(FreeList, Child) < 0)
+			{
+				bAllSiblingsFree = false;
+				break;
+			}
+		}
+		if (!bAllSiblingsFree)
+		{
+			break;
+		}
+
+		for (uint32 Child : Children)
+		{
+			if (Child != Key)
+			{
+				RemoveFreeBlockAt(FreeList, FindFreeBlock(FreeList, Child));
+			}
+		}
+		Key = Children[0];
+		--Level;
+	}
+
+	FreeLists[Level].Add(Key);
+}
+
+void FShadowAtlasAllocator::ShrinkBlock(int32 Level, uint32 Key, int32 NewLevel)
+{
+	const uint32 X = GetBlockX(Key);
+	const uint32 Y = GetBlockY(Key);
+	for (int32 ChildLevel = Level + 1; ChildLevel <= NewLevel; ++ChildLevel)
+	{
+		const uint32 Size = GetBlockSize(ChildLevel);
+		FreeLists[ChildLevel].Add(MakeBlockKey(X + Size, Y));
+		FreeLists[ChildLevel].Add(MakeBlockKey(X, Y + Size));
+		FreeLists[ChildLevel].Add(MakeBlockKey(X + Size, Y + Size));
+	}
+}
+
+bool FShadowAtlasAllocator::TryGrowInPlace(int32 Level, uint32 Key, int32 NewLevel)
+{
+	const uint32 X = GetBlockX(Key);
+	const uint32 Y = GetBlockY(Key);
+
+	// 각 단계에서 이 블록이 부모의 왼쪽 위이고 나머지 형제가 통째로 비어 있어야 함
+	for (int32 ChildLevel = Level; ChildLevel > NewLevel; --ChildLevel)
+	{
+		const uint32 Size = GetBlockSize(ChildLevel);
+		if ((X & (Size * 2 - 1)) != 0 || (Y & (Size * 2 - 1)) != 0)
+		{
+			return false;
+		}
+
+		const TArray<uint32>& FreeList = FreeLists[ChildLevel];
+		if (FindFreeBlock(FreeList, MakeBlockKey(X + Size, Y)) < 0 ||
+			FindFreeBlock(FreeList, MakeBlockKey(X, Y + Size)) < 0 ||
+			FindFreeBlock(FreeList, MakeBlockKey(X + Size, Y + Size)) < 0)
+		{
+			return false;
+		}
+	}
+
+	for (int32 ChildLevel = Level; ChildLevel > NewLevel; --ChildLevel)
+	{
+		const uint32 Size = GetBlockSize(ChildLevel);
+		TakeFreeBlock(ChildLevel, MakeBlockKey(X + Size, Y));
+		TakeFreeBlock(ChildLevel, MakeBlockKey(X, Y + Size));
+		TakeFreeBlock(ChildLevel, MakeBlockKey(X + Size, Y + Size));
+	}
+	return true;
+}
+
+bool FShadowAtlasAllocator::TakeFreeBlock(int32 Level, uint32 Key)
+{
+	TArray<uint32>& FreeList = FreeLists[Level];
+	const int32 Index = FindFreeBlock(FreeList, Key);
+	if (Index < 0)
+	{
+		return false;
+	}
+	RemoveFreeBlockAt(FreeList, Index);
+	return true;
+}
+
+void FShadowAtlasAllocator::Repack()
+{
+	for (TArray<uint32>& FreeList : FreeLists)
+	{
+		FreeList.Empty();
+	}
+	FreeLists[0].Add(MakeBlockKey(0, 0));
+
+	// ItemOrder는 (큰 블록, 높은 중요도) 순. 예산을 맞췄으므로 최소 단계로도 넘칠 때만 뒤쪽이 빠짐
+	for (int32 Index : ItemOrder)
+	{
+		FAtlasRecord& Record = *Items[Index].Record;
+		Record.Level = -1;
+
+		uint32 Key = 0;
+		if (AllocBlock(Items[Index].TargetLevel, Key))
+		{
+			Record.Key = Key;
+			Record.Level = Items[Index].TargetLevel;
+		}
+	}
+}
+
+void FShadowAtlasAllocator::UpdateFreeSpaceStats()
+{
+	uint64 FreeArea = 0;
+	uint64 LargestFreeArea = 0;
+	for (int32 Level = 0; Level <= MaxLevel; ++Level)
+	{
+		const uint64 BlockArea = GetBlockArea(Level);
+		FreeArea += BlockArea * FreeLists[Level].Num();
+		if (LargestFreeArea == 0 && !FreeLists[Level].IsEmpty())
+		{
+			LargestFreeArea = BlockArea;
+		}
+	}
+	Stats.Fragmentation = FreeArea > 0 ? 1.0f - static_cast<float>(static_cast<double>(LargestFreeArea) / static_cast<double>(FreeArea)) : 0.0f;
+}
+
+float FShadowAtlasAllocator::ComputeScreenImportance(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, const FVector& Center, float Radius)
+{
+	if (Radius <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	const FVector ViewCenter = ViewMatrix.TransformPosition(Center);
+
+	// 직교 투영: 화면 높이의 절반 = 1 / M[1][1]
+	if (ProjectionMatrix.M[3][3] != 0.0f)
+	{
+		return FMath::Clamp(Radius * ProjectionMatrix.M[1][1], 0.0f, 1.0f);
+	}
+
+	// 카메라가 구 안이면 화면 전체, 구 전체가 카메라 뒤면 0
+	if (ViewCenter.SizeSquared() <= Radius * Radius)
+	{
+		return 1.0f;
+	}
+	if (ViewCenter.Z + Radius <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// 투영된 반지름 / 화면 높이의 절반 (중심이 카메라 옆/뒤쪽이면 깊이를 반지름으로 눌러 크게 봄)
+	const float Depth = FMath::Max(ViewCenter.Z, Radius);
+	return FMath::Clamp(Radius * ProjectionMatrix.M[1][1] / Depth, 0.0f, 1.0f);
+}
@@ -0,0 +1,110 @@
+﻿#pragma once
+
+class ULightComponent;
+struct FShadowRenderRequest;
+
+// 한 번의 Allocate 결과
+struct FShadowAtlasAllocStats
+{
+	uint32 NumRequests = 0;
+	uint32 NumAllocated = 0;		// 영역을 받은 요청
+	uint32 NumNew = 0;				// 새로 배치된 요청 (지난 할당에 없던 서브뷰)
+	uint32 NumResized = 0;			// 중요도 변화로 블록 크기가 바뀐 요청
+	uint32 NumRelocated = 0;		// 기존 요청 중 위치가 바뀐 요청 (크기 변경, 재배치 포함)
+	uint32 NumDegraded = 0;			// 원하는 크기보다 작은 블록을 받은 요청
+	uint32 NumDropped = 0;			// 최소 블록도 받지 못한 요청 (Size = 0)
+	uint32 NumRepacks = 0;			// 단편화로 전체를 다시 배치한 횟수 (0 또는 1)
+	float UsedPercent = 0.0f;		// 할당된 블록 면적 / 아틀라스 면적
+	float Fragmentation = 0.0f;		// 1 - 가장 큰 빈 블록 / 전체 빈 면적
+};
+
+// 2D 섀도우 아틀라스 영구 할당기 (쿼드트리 버디)
+// - 아틀라스를 2의 거듭제곱 정사각 블록으로 4분할해 나감. 블록은 (라이트, 서브뷰)마다 프레임 사이에 유지
+// - 해상도: 요청 크기 x 화면 중요도를 2의 거듭제곱 단계로 (ResizeDelayFrames 동안 같은 단계를 원할 때만 바꿈)
+//   축소는 블록 안 왼쪽 위 자식으로, 확대는 가능하면 같은 원점에서 형제 블록을 합쳐 위치를 유지
+// - 공간이 모자라면 중요도가 낮은 요청부터 한 단계씩 줄여 총 면적을 맞추고 (버리지 않음)
+//   단편화로 못 넣거나 예산보다 작게 받은 상태가 이어지면 전체를 크기순으로 다시 배치. 최소 블록도 못 받을 때만 버림
+class FShadowAtlasAllocator
+{
+public:
+	FShadowAtlasAllocator() = default;
+
+	static constexpr uint32 ResizeDelayFrames = 15;
+	static constexpr int32 MaxImportanceShift = 3;	// 중요도로 줄이는 최대 단계 (1/8)
+
+	// InAtlasSize는 2의 거듭제곱으로 내림
+	void Initialize(uint32 InAtlasSize, uint32 InMinBlockSize = 128);
+	// 모든 블록 해제
+	void Reset();
+
+	// 요청마다 Size / AtlasViewportOffset / AtlasScaleOffset을 채움 (실패 시 Size = 0). 요청 순서는 바꾸지 않음
+	void Allocate(TArray<FShadowRenderRequest>& InOutRequests);
+
+	const FShadowAtlasAllocStats& GetStats() const { return Stats; }
+	uint32 GetAtlasSize() const { return AtlasSize; }
+
+	// 뷰에서 구(라이트 범위)가 차지하는 화면 높이 비율 (0~1, 카메라가 구 안이면 1)
+	static float ComputeScreenImportance(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, const FVector& Center, float Radius);
+
+private:
+	friend struct FShadowAtlasAllocatorTestAccess;
+
+	struct FAtlasRecord
+	{
+		uint32 Key = 0;				// 블록 원점 (Y << 16 | X)
+		int32 Level = -1;			// -1: 블록 없음
+		int32 PendingLevel = -1;	// 바꾸려고 기다리는 단계
+		uint32 PendingFrames = 0;
+		uint64 LastFrame = 0;
+	};
+
+	struct FFrameItem
+	{
+		int32 RequestIndex = -1;
+		FAtlasRecord* Record = nullptr;
+		uint32 ScaledSize = 0;		// 중요도를 반영한 렌더 크기 (블록보다 작을 수 있음)
+		int32 WantedLevel = 0;		// 히스테리시스 반영 후 원하는 단계
+		int32 TargetLevel = 0;		// 면적 예산 반영 후 단계
+		float Priority = 0.0f;
+		bool bNew = false;
+		uint32 PrevKey = 0;
+		int32 PrevLevel = -1;
+	};
+
+	uint32 GetBlockSize(int32 Level) const { return AtlasSize >> Level; }
+	uint64 GetBlockArea(int32 Level) const { return static_cast<uint64>(GetBlockSize(Level)) * GetBlockSize(Level); }
+	// 이 크기를 담는 가장 작은 블록의 단계
+	int32 GetLevelForSize(uint32 Size) const;
+
+	bool AllocBlock(int32 Level, uint32& OutKey);
+	void FreeBlock(int32 Level, uint32 Key);
+	// 같은 원점의 더 작은 블록으로 (나머지는 빈 블록으로 돌려줌)
+	void ShrinkBlock(int32 Level, uint32 Key, int32 NewLevel);
+	// 같은 원점에서 형제 블록들이 비어 있으면 합쳐서 키움
+	bool TryGrowInPlace(int32 Level, uint32 Key, int32 NewLevel);
+	bool TakeFreeBlock(int32 Level, uint32 Key);
+
+	// 모든 블록을 풀고 Items를 (큰 블록, 높은 중요도) 순으로 다시 배치
+	void Repack();
+
+	void UpdateFreeSpaceStats();
+
+	uint32 TextureSize = 0;	// 실제 텍스처 크기 (UV 계산)
+	uint32 AtlasSize = 0;	// 할당 영역 (TextureSize를 2의 거듭제곱으로 내림)
+	uint32 MinBlockSize = 128;
+	int32 MaxLevel = 0;		// 가장 작은 블록 단계
+
+	// 단계별 빈 블록 (원점 키)
+	TArray<TArray<uint32>> FreeLists;
+
+	// Key: 라이트, Value: 서브뷰 인덱스별 기록 (Spot 1개, CSM 캐스케이드 수만큼)
+	TMap<ULightComponent*, TArray<FAtlasRecord>> Records;
+	uint64 FrameIndex = 0;
+	uint32 FragmentedFrames = 0;	// 단편화로 예산보다 작게 받은 요청이 이어진 프레임 수
+
+	// 프레임 임시 버퍼 (재사용)
+	TArray<FFrameItem> Items;
+	TArray<int32> ItemOrder;
+
+	FShadowAtlasAllocStats Stats;
+};
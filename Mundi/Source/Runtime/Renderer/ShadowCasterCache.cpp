@@ -0,0 +1,216 @@
+﻿#include "pch.h"
+#include "ShadowCasterCache.h"
+#include "LightManager.h"
+#include "D3D11RHI.h"
+
+FShadowCasterCache::~FShadowCasterCache()
+{
+	Release();
+}
+
+void FShadowCasterCache::EndPass()
+{
+	for (auto It = Entries.begin(); It != Entries.end();)
+	{
+		TArray<FStaticShadowCacheEntry>& LightEntries = It->second;
+		bool bAnyUsed = false;
+		for (FStaticShadowCacheEntry& Entry : LightEntries)
+		{
+			if (Entry.LastUsedPass == PassIndex)
+			{
+				bAnyUsed = true;
+			}
+			else if (Entry.Texture)
+			{
+				ReleaseEntryResources(Entry);
+			}
+		}
+
+		// 제거된 라이트의 포인터가 남지 않도록 이번 패스에 그리지 않은 라이트는 통째로 지움
+		if (!bAnyUsed)
+		{
+			It = Entries.erase(It);
+		}
+		else
+		{
+			++It;
+		}
+	}
+
+	for (auto It = CasterMobility.begin(); It != CasterMobility.end();)
+	{
+		if (It->second.LastSeenPass != PassIndex)
+		{
+			It = CasterMobility.erase(It);
+		}
+		else
+		{
+			++It;
+		}
+	}
+}
+
+bool FShadowCasterCache::UpdateCasterMobility(UMeshComponent* Component, uint64 StateHash, bool bCanBeStatic)
+{
+	auto Result = CasterMobility.try_emplace(Component);
+	FCasterMobility& Mobility = Result.first->second;
+
+	if (Result.second || Mobility.StateHash != StateHash)
+	{
+		Mobility.StateHash = StateHash;
+		Mobility.UnchangedPasses = 0;
+	}
+	else if (Mobility.LastSeenPass != PassIndex)
+	{
+		++Mobility.UnchangedPasses;
+	}
+	Mobility.LastSeenPass = PassIndex;
+
+	return bCanBeStatic && Mobility.UnchangedPasses >= StaticPassThreshold;
+}
+
+FStaticShadowCacheEntry* FShadowCasterCache::FindOrCreateEntry(D3D11RHI* RHIDevice, ULightComponent* Light, int32 SubViewIndex, uint32 Size)
+{
+	if (!RHIDevice || !Light || SubViewIndex < 0 || Size == 0)
+	{
+		return nullptr;
+	}
+
+	TArray<FStaticShadowCacheEntry>& LightEntries = Entries[Light];
+	if (LightEntries.Num() <= SubViewIndex)
+	{
+		LightEntries.SetNum(SubViewIndex + 1);
+	}
+
+	FStaticShadowCacheEntry& Entry = LightEntries[SubViewIndex];
+	if (Entry.Size != Size || !Entry.Texture)
+	{
+		ReleaseEntryResources(Entry);
+		if (!CreateEntryResources(RHIDevice, Size, Entry))
+		{
+			return nullptr;
+		}
+	}
+	Entry.LastUsedPass = PassIndex;
+	return &Entry;
+}
+
+bool FShadowCasterCache::IsEntryUpToDate(const FStaticShadowCacheEntry& Entry, const FShadowRenderRequest& Request, uint64 StaticCasterHash)
+{
+	const FVector4 LocationRadius(Request.WorldLocation.X, Request.WorldLocation.Y, Request.WorldLocation.Z, Request.Radius);
+	return Entry.bValid &&
+		Entry.StaticCasterHash == StaticCasterHash &&
+		std::memcmp(&Entry.ViewMatrix, &Request.ViewMatrix, sizeof(FMatrix)) == 0 &&
+		std::memcmp(&Entry.ProjectionMatrix, &Request.ProjectionMatrix, sizeof(FMatrix)) == 0 &&
+		std::memcmp(&Entry.LocationRadius, &LocationRadius, sizeof(FVector4)) == 0;
+}
+
+void FShadowCasterCache::MarkEntryUpToDate(FStaticShadowCacheEntry& Entry, const FShadowRenderRequest& Request, uint64 StaticCasterHash)
+{
+	Entry.ViewMatrix = Request.ViewMatrix;
+	Entry.ProjectionMatrix = Request.ProjectionMatrix;
+	Entry.LocationRadius = FVector4(Request.WorldLocation.X, Request.WorldLocation.Y, Request.WorldLocation.Z, Request.Radius);
+	Entry.StaticCasterHash = StaticCasterHash;
+	Entry.bValid = true;
+}
+
+uint32 FShadowCasterCache::GetNumEntries() const
+{
+	uint32 Count = 0;
+	for (const auto& Pair : Entries)
+	{
+		for (const FStaticShadowCacheEntry& Entry : Pair.second)
+		{
+			if (Entry.Texture)
+			{
+				++Count;
+			}
+		}
+	}
+	return Count;
+}
+
+float FShadowCasterCache::GetMemoryMB() const
+{
+	// DXGI_FORMAT_R24G8_TYPELESS = 4 bytes per pixel
+	uint64 Bytes = 0;
+	for (const auto& Pair : Entries)
+	{
+		for (const FStaticShadowCacheEntry& Entry : Pair.second)
+		{
+			if (Entry.Texture)
+			{
+				Bytes += (uint64)Entry.Size * Entry.Size * 4;
+			}
+		}
+	}
+	return (float)Bytes / (1024.0f * 1024.0f);
+}
+
+void FShadowCasterCache::Release()
+{
+	for (auto& Pair : Entries)
+	{
+		for (FStaticShadowCacheEntry& Entry : Pair.second)
+		{
+			ReleaseEntryResources(Entry);
+		}
+	}
+	Entries.clear();
+	CasterMobility.clear();
+}
+
+bool FShadowCasterCache::CreateEntryResources(D3D11RHI* RHIDevice, uint32 Size, FStaticShadowCacheEntry& OutEntry)
+{
+	ID3D11Device* Device = RHIDevice->GetDevice();
+
+	// 섀도우 아틀라스와 같은 포맷 (DSV로 그리고 SRV로 읽어 아틀라스에 합성)
+	D3D11_TEXTURE2D_DESC TexDesc = {};
+	TexDesc.Width = Size;
+	TexDesc.Height = Size;
+	TexDesc.MipLevels = 1;
+	TexDesc.ArraySize = 1;
+	TexDesc.Format = DXGI_FORMAT_R24G8_TYPELESS;
+	TexDesc.SampleDesc.Count = 1;
+	TexDesc.Usage = D3D11_USAGE_DEFAULT;
+	TexDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE;
+
+	HRESULT hr = Device->CreateTexture2D(&TexDesc, nullptr, &OutEntry.Texture);
+	if (FAILED(hr))
+	{
+		UE_LOG("[ShadowCasterCache] 정적 섀도우 캐시 텍스처 생성 실패 (%u x %u)", Size, Size);
+		OutEntry.Texture = nullptr;
+		return false;
+	}
+
+	D3D11_DEPTH_STENCIL_VIEW_DESC DSVDesc = {};
+	DSVDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+	DSVDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+	DSVDesc.Texture2D.MipSlice = 0;
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc = {};
+	SRVDesc.Format = DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
+	SRVDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+	SRVDesc.Texture2D.MipLevels = 1;
+
+	if (FAILED(Device->CreateDepthStencilView(OutEntry.Texture, &DSVDesc, &OutEntry.DSV)) ||
+		FAILED(Device->CreateShaderResourceView(OutEntry.Texture, &SRVDesc, &OutEntry.SRV)))
+	{
+		UE_LOG("[ShadowCasterCache] 정적 섀도우 캐시 뷰 생성 실패");
+		ReleaseEntryResources(OutEntry);
+		return false;
+	}
+
+	OutEntry.Size = Size;
+	OutEntry.bValid = false;
+	return true;
+}
+
+void FShadowCasterCache::ReleaseEntryResources(FStaticShadowCacheEntry& Entry)
+{
+	if (Entry.SRV) { Entry.SRV->Release(); Entry.SRV = nullptr; }
+	if (Entry.DSV) { Entry.DSV->Release(); Entry.DSV = nullptr; }
+	if (Entry.Texture) { Entry.Texture->Release(); Entry.Texture = nullptr; }
+	Entry.Size = 0;
+	Entry.bValid = false;
+}
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+class UMeshComponent;
+class ULightComponent;
+class D3D11RHI;
+struct FShadowRenderRequest;
+
+// 섀도우 뷰(라이트 서브뷰) 하나의 정적 캐스터 깊이
+struct FStaticShadowCacheEntry
+{
+	ID3D11Texture2D* Texture = nullptr;
+	ID3D11DepthStencilView* DSV = nullptr;
+	ID3D11ShaderResourceView* SRV = nullptr;
+	uint32 Size = 0;
+
+	// 마지막으로 그렸을 때의 라이트 뷰와 정적 캐스터 (하나라도 다르면 다시 그림)
+	FMatrix ViewMatrix;
+	FMatrix ProjectionMatrix;
+	FVector4 LocationRadius;
+	uint64 StaticCasterHash = 0;
+	bool bValid = false;
+
+	uint64 LastUsedPass = 0;
+};
+
+// 라이트별 정적 섀도우 깊이 캐시 + 캐스터 정지 판정
+// - FLightManager가 소유해 섀도우 패스(FSceneRenderer::RenderShadowMaps 호출) 사이에 유지
+// - 정적 캐스터: 스켈레탈이 아니고 StaticPassThreshold 패스 동안 StateHash가 그대로인 메시
+// - 항목은 라이트 뷰 행렬과 범위 안 정적 캐스터 집합의 해시가 같을 때만 재사용
+class FShadowCasterCache
+{
+public:
+	FShadowCasterCache() = default;
+	~FShadowCasterCache();
+
+	static constexpr uint32 StaticPassThreshold = 8;
+
+	void BeginPass() { ++PassIndex; }
+	// 이번 패스에 쓰이지 않은 캐시 항목과 캐스터 기록 정리
+	void EndPass();
+
+	// 캐스터의 이번 상태를 기록하고 정적 여부 반환 (bCanBeStatic == false면 항상 동적)
+	bool UpdateCasterMobility(UMeshComponent* Component, uint64 StateHash, bool bCanBeStatic);
+
+	// 라이트 서브뷰의 캐시 항목 (없거나 크기가 바뀌었으면 텍스처를 새로 만들고 무효 상태로 반환)
+	FStaticShadowCacheEntry* FindOrCreateEntry(D3D11RHI* RHIDevice, ULightComponent* Light, int32 SubViewIndex, uint32 Size);
+
+	static bool IsEntryUpToDate(const FStaticShadowCacheEntry& Entry, const FShadowRenderRequest& Request, uint64 StaticCasterHash);
+	static void MarkEntryUpToDate(FStaticShadowCacheEntry& Entry, const FShadowRenderRequest& Request, uint64 StaticCasterHash);
+
+	uint32 GetNumEntries() const;
+	float GetMemoryMB() const;
+
+	void Release();
+
+private:
+	static bool CreateEntryResources(D3D11RHI* RHIDevice, uint32 Size, FStaticShadowCacheEntry& OutEntry);
+	static void ReleaseEntryResources(FStaticShadowCacheEntry& Entry);
+
+	struct FCasterMobility
+	{
+		uint64 StateHash = 0;
+		uint32 UnchangedPasses = 0;
+		uint64 LastSeenPass = 0;
+	};
+
+	// Key: 라이트, Value: 서브뷰 인덱스별 항목 (Spot 1개, Point 6면)
+	TMap<ULightComponent*, TArray<FStaticShadowCacheEntry>> Entries;
+	TMap<UMeshComponent*, FCasterMobility> CasterMobility;
+	uint64 PassIndex = 0;
+};
@@ -0,0 +1,83 @@
+﻿#include "pch.h"
+#include "ShadowCasterSelection.h"
+#include "BVHierarchy.h"
+#include "BoundingSphere.h"
+#include "Collision.h"
+#include "Hash.h"
+
+namespace
+{
+	template<typename TVolume, typename TBoundsTest>
+	void QueryShadowCasterIndicesImpl(const FBVHierarchy* BVH, const TVolume& InVolume, TBoundsTest BoundsTest,
+		const TArray<FShadowCaster>& Casters, const TMap<UPrimitiveComponent*, int32>& CasterIndices,
+		TArray<UPrimitiveComponent*>& QueryResults, TArray<int32>& OutCasters)
+	{
+		if (!BVH)
+		{
+			for (int32 CasterIndex = 0; CasterIndex < Casters.Num(); ++CasterIndex)
+			{
+				if (BoundsTest(InVolume, Casters[CasterIndex].Bounds))
+				{
+					OutCasters.Add(CasterIndex);
+				}
+			}
+			return;
+		}
+
+		// 리빌드 전에 추가된 컴포넌트도 BVH 쿼리가 직접 검사해서 돌려줌
+		QueryResults.Empty();
+		BVH->QueryIntersectedComponents(InVolume, QueryResults);
+		for (UPrimitiveComponent* Component : QueryResults)
+		{
+			// BVH에는 그림자를 드리우지 않거나 보이지 않는 프리미티브도 있으므로 이번 캐스터 목록으로 거름
+			if (const int32* CasterIndex = CasterIndices.Find(Component))
+			{
+				OutCasters.Add(*CasterIndex);
+			}
+		}
+	}
+}
+
+void QueryShadowCasterIndices(const FBVHierarchy* BVH, const FFrustum& InFrustum,
+	const TArray<FShadowCaster>& Casters, const TMap<UPrimitiveComponent*, int32>& CasterIndices,
+	TArray<UPrimitiveComponent*>& QueryResults, TArray<int32>& OutCasters)
+{
+	QueryShadowCasterIndicesImpl(BVH, InFrustum,
+		[](const FFrustum& Frustum, const FAABB& Bounds) { return IsAABBVisible(Frustum, Bounds); },
+		Casters, CasterIndices, QueryResults, OutCasters);
+}
+
+void QueryShadowCasterIndices(const FBVHierarchy* BVH, const FBoundingSphere& InSphere,
+	const TArray<FShadowCaster>& Casters, const TMap<UPrimitiveComponent*, int32>& CasterIndices,
+	TArray<UPrimitiveComponent*>& QueryResults, TArray<int32>& OutCasters)
+{
+	QueryShadowCasterIndicesImpl(BVH, InSphere,
+		[](const FBoundingSphere& Sphere, const FAABB& Bounds) { return Collision::Intersects(Bounds, Sphere); },
+		Casters, CasterIndices, QueryResults, OutCasters);
+}
+
+void FilterShadowCastersByFrustum(const FFrustum& InFrustum, const TArray<FShadowCaster>& Casters, const TArray<int32>& InCasters, TArray<int32>& OutCasters)
+{
+	for (int32 CasterIndex : InCasters)
+	{
+		if (IsAABBVisible(InFrustum, Casters[CasterIndex].Bounds))
+		{
+			OutCasters.Add(CasterIndex);
+		}
+	}
+}
+
+uint64 HashStaticShadowCasters(const TArray<FShadowCaster>& Casters, const TArray<int32>& ViewCasters, uint32& OutNumStatic)
+{
+	uint64 StaticCasterSum = 0;
+	OutNumStatic = 0;
+	for (int32 CasterIndex : ViewCasters)
+	{
+		if (Casters[CasterIndex].bStatic)
+		{
+			StaticCasterSum += Casters[CasterIndex].StateHash;
+			++OutNumStatic;
+		}
+	}
+	return HashCombine(StaticCasterSum, OutNumStatic);
+}
@@ -0,0 +1,39 @@
+﻿#pragma once
+#include "Frustum.h"
+#include "AABB.h"
+
+class UMeshComponent;
+class UPrimitiveComponent;
+class FBVHierarchy;
+struct FBoundingSphere;
+
+// 섀도우 패스의 캐스터 하나
+// 배치는 RenderShadowMaps가 한 번만 수집한 ShadowCasterBatches의 [FirstBatch, FirstBatch + NumBatches)
+struct FShadowCaster
+{
+	UMeshComponent* Component = nullptr;
+	FAABB Bounds;
+	int32 FirstBatch = 0;
+	int32 NumBatches = 0;
+	uint64 StateHash = 0;	// 컴포넌트 + 배치별 월드 행렬/버퍼/인덱스 범위
+	bool bStatic = false;
+};
+
+// 섀도우 뷰별 캐스터 선택 (FSceneRenderer::RenderShadowMaps, Tests/ShadowCasterSelectionTests.cpp)
+// - 스포트/캐스케이드: 뷰 절두체로 BVH 쿼리
+// - 포인트: 라이트 반경 구로 한 번 쿼리한 뒤 면마다 절두체로 거름
+// - 결과는 이번 패스의 캐스터 인덱스 (CasterIndices)
+
+/** @brief BVH 쿼리 결과를 캐스터 인덱스로 바꿔 OutCasters 뒤에 붙임 (BVH가 없으면 모든 캐스터를 바운드로 검사) */
+void QueryShadowCasterIndices(const FBVHierarchy* BVH, const FFrustum& InFrustum,
+	const TArray<FShadowCaster>& Casters, const TMap<UPrimitiveComponent*, int32>& CasterIndices,
+	TArray<UPrimitiveComponent*>& QueryResults, TArray<int32>& OutCasters);
+void QueryShadowCasterIndices(const FBVHierarchy* BVH, const FBoundingSphere& InSphere,
+	const TArray<FShadowCaster>& Casters, const TMap<UPrimitiveComponent*, int32>& CasterIndices,
+	TArray<UPrimitiveComponent*>& QueryResults, TArray<int32>& OutCasters);
+
+/** @brief InCasters 중 절두체와 겹치는 캐스터만 (포인트 라이트: 반경 구로 한 번 쿼리한 결과를 면마다 거름) */
+void FilterShadowCastersByFrustum(const FFrustum& InFrustum, const TArray<FShadowCaster>& Casters, const TArray<int32>& InCasters, TArray<int32>& OutCasters);
+
+/** @brief 뷰 안 정적 캐스터 집합의 캐시 키 (쿼리 순서와 무관하도록 StateHash를 합산하고 개수와 섞음) */
+uint64 HashStaticShadowCasters(const TArray<FShadowCaster>& Casters, const TArray<int32>& ViewCasters, uint32& OutNumStatic);
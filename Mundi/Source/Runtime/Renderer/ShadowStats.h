@@ -21,6 +21,30 @@ struct FShadowStats
 	float ShadowAtlasCubeMemoryMB = 0.0f;
 	float TotalShadowMemoryMB = 0.0f;
 
+	// 2D 아틀라스 할당 (FLightManager::AllocateAtlasRegions2D)
+	uint32 AtlasRegions2D = 0;				// 영역을 받은 2D 요청
+	uint32 AtlasDegraded2D = 0;				// 공간 부족으로 해상도를 낮춘 요청
+	uint32 AtlasDropped2D = 0;				// 영역을 받지 못한 요청
+	uint32 AtlasRelocated2D = 0;			// 지난 프레임과 위치가 달라진 요청
+	float AtlasUsedPercent2D = 0.0f;
+	float AtlasFragmentation2D = 0.0f;		// 1 - 가장 큰 빈 블록 / 전체 빈 면적
+
+	// 섀도우 뷰별 캐스터 컬링 (FSceneRenderer::RenderShadowMaps)
+	uint32 NumShadowViews = 0;				// 그린 섀도우 뷰 (2D 요청 + 큐브 면)
+	uint32 NumShadowCasters = 0;			// 섀도우 캐스팅 메시 (뷰 컬링 전)
+	uint32 NumStaticShadowCasters = 0;		// 그중 정적으로 판정된 메시
+	uint32 NumCasterViewPairsTotal = 0;		// 컬링 없이 그렸다면: 뷰 수 x 캐스터 수
+	uint32 NumCasterViewPairsVisible = 0;	// 뷰 볼륨과 겹친 (뷰, 캐스터) 쌍
+	uint32 NumCastersRendered = 0;			// 실제로 그린 (뷰, 캐스터) 쌍 (캐시 갱신 포함)
+	uint32 NumCastersFromCache = 0;			// 캐시로 대신한 정적 (뷰, 캐스터) 쌍
+
+	// 정적 섀도우 캐시 (뷰 단위)
+	uint32 CacheHits = 0;
+	uint32 CacheMisses = 0;
+	float CacheHitRate = 0.0f;				// %
+	uint32 NumCacheEntries = 0;
+	float StaticCacheMemoryMB = 0.0f;
+
 	// 모든 통계를 0으로 리셋
 	void Reset()
 	{
@@ -34,13 +58,38 @@ struct FShadowStats
 		ShadowAtlas2DMemoryMB = 0.0f;
 		ShadowAtlasCubeMemoryMB = 0.0f;
 		TotalShadowMemoryMB = 0.0f;
+		AtlasRegions2D = 0;
+		AtlasDegraded2D = 0;
+		AtlasDropped2D = 0;
+		AtlasRelocated2D = 0;
+		AtlasUsedPercent2D = 0.0f;
+		AtlasFragmentation2D = 0.0f;
+		NumShadowViews = 0;
+		NumShadowCasters = 0;
+		NumStaticShadowCasters = 0;
+		NumCasterViewPairsTotal = 0;
+		NumCasterViewPairsVisible = 0;
+		NumCastersRendered = 0;
+		NumCastersFromCache = 0;
+		CacheHits = 0;
+		CacheMisses = 0;
+		CacheHitRate = 0.0f;
+		NumCacheEntries = 0;
+		StaticCacheMemoryMB = 0.0f;
 	}
 
 	// 전체 섀도우 캐스팅 라이트 수 계산
 	void CalculateTotal()
 	{
 		TotalShadowCastingLights = ShadowCastingPointLights + ShadowCastingSpotLights + ShadowCastingDirectionalLights;
-		TotalShadowMemoryMB = ShadowAtlas2DMemoryMB + ShadowAtlasCubeMemoryMB;
+		TotalShadowMemoryMB = ShadowAtlas2DMemoryMB + ShadowAtlasCubeMemoryMB + StaticCacheMemoryMB;
+	}
+
+	// 캐시 적중률 (캐시를 시도한 뷰 기준)
+	void CalculateCacheHitRate()
+	{
+		const uint32 Lookups = CacheHits + CacheMisses;
+		CacheHitRate = Lookups > 0 ? (static_cast<float>(CacheHits) / static_cast<float>(Lookups)) * 100.0f : 0.0f;
 	}
 
 	// 메모리 계산 (2D 아틀라스)
@@ -10,24 +10,32 @@ struct FTileCullingStats
 	uint32 TileCountY = 0;
 	uint32 TotalTileCount = 0;
 
+	// 클러스터 모드 (0: 2D 타일, 그 외: 타일당 깊이 슬라이스 수)
+	uint32 ClusterSliceCount = 0;
+	uint32 TotalClusterCount = 0;
+
 	// 라이트 개수
 	uint32 TotalPointLights = 0;
 	uint32 TotalSpotLights = 0;
 	uint32 TotalLights = 0;
 
-	// 타일당 라이트 통계
+	// 칸(타일 또는 클러스터)당 라이트 통계
 	uint32 MinLightsPerTile = 0;
 	uint32 MaxLightsPerTile = 0;
 	float AvgLightsPerTile = 0.0f;
 
 	// 컬링 효율성 메트릭
 	float CullingEfficiency = 0.0f; // 컬링된 라이트 비율 (%)
-	uint32 TotalLightTests = 0;     // 전체 라이트-타일 테스트 수
+	uint32 TotalLightTests = 0;     // 전체 라이트-칸 쌍 수 (컬링이 없다면 해야 할 테스트 수)
 	uint32 TotalLightsPassed = 0;   // 컬링을 통과한 라이트 수
 
 	// 성능 메트릭
 	float ComputeShaderTimeMS = 0.0f;
-	uint32 LightIndexBufferSizeBytes = 0;
+	float CPUCullTimeMS = 0.0f;             // 라이트 셋업 + 타일 래스터화 + 목록 압축
+	float LightSetupTimeMS = 0.0f;          // 라이트별 뷰 공간 바운드 / 화면 사각형
+	float BinningTimeMS = 0.0f;             // 타일 행 병렬 판정 + 행 안 정렬
+	float CompactTimeMS = 0.0f;             // 행 결과를 그리드 + 인덱스 목록으로 합침
+	uint32 LightIndexBufferSizeBytes = 0;   // 이번 프레임 업로드 크기 (그리드 + 인덱스)
 
 	// 시각화 모드
 	enum class EVisualizationMode : uint8
@@ -47,6 +55,8 @@ struct FTileCullingStats
 		TileCountX = 0;
 		TileCountY = 0;
 		TotalTileCount = 0;
+		ClusterSliceCount = 0;
+		TotalClusterCount = 0;
 		TotalPointLights = 0;
 		TotalSpotLights = 0;
 		TotalLights = 0;
@@ -57,6 +67,10 @@ struct FTileCullingStats
 		TotalLightTests = 0;
 		TotalLightsPassed = 0;
 		ComputeShaderTimeMS = 0.0f;
+		CPUCullTimeMS = 0.0f;
+		LightSetupTimeMS = 0.0f;
+		BinningTimeMS = 0.0f;
+		CompactTimeMS = 0.0f;
 		LightIndexBufferSizeBytes = 0;
 	}
 
@@ -65,10 +79,11 @@ struct FTileCullingStats
 	{
 		TotalLights = TotalPointLights + TotalSpotLights;
 		TotalTileCount = TileCountX * TileCountY;
+		TotalClusterCount = TotalTileCount * (ClusterSliceCount > 0 ? ClusterSliceCount : 1);
 
-		if (TotalTileCount > 0)
+		if (TotalClusterCount > 0)
 		{
-			AvgLightsPerTile = static_cast<float>(TotalLightsPassed) / static_cast<float>(TotalTileCount);
+			AvgLightsPerTile = static_cast<float>(TotalLightsPassed) / static_cast<float>(TotalClusterCount);
 		}
 
 		if (TotalLightTests > 0)
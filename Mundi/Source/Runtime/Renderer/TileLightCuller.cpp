@@ -1,6 +1,62 @@
 ﻿#include "pch.h"
 #include "TileLightCuller.h"
+#include "PlatformTime.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
 #include <algorithm>
+#include <xmmintrin.h>
+
+namespace
+{
+	// 행 벡터 규약 (p' = p * M)
+	FVector TransformPositionRowVector(const FMatrix& M, const FVector& P)
+	{
+		return FVector(
+			P.X * M.M[0][0] + P.Y * M.M[1][0] + P.Z * M.M[2][0] + M.M[3][0],
+			P.X * M.M[0][1] + P.Y * M.M[1][1] + P.Z * M.M[2][1] + M.M[3][1],
+			P.X * M.M[0][2] + P.Y * M.M[1][2] + P.Z * M.M[2][2] + M.M[3][2]);
+	}
+
+	FVector4 GetMatrixColumn(const FMatrix& M, int32 Column)
+	{
+		return FVector4(M.M[0][Column], M.M[1][Column], M.M[2][Column], M.M[3][Column]);
+	}
+
+	FVector4 NormalizePlane(float X, float Y, float Z, float W)
+	{
+		const float Length = std::sqrt(X * X + Y * Y + Z * Z);
+		const float InvLength = Length > 1e-8f ? 1.0f / Length : 0.0f;
+		return FVector4(X * InvLength, Y * InvLength, Z * InvLength, W * InvLength);
+	}
+
+	// 원뿔(꼭짓점, 축, 높이, 반각)을 감싸는 최소 구
+	// 반각 45도 이하: 밑면 원과 꼭짓점을 지나는 구 / 초과: 밑면 원을 대원으로 하는 구
+	void GetSpotLightBoundingSphere(const FSpotLightInfo& Light, FVector& OutCenter, float& OutRadius)
+	{
+		const float Range = Light.AttenuationRadius;
+		const float HalfAngle = DegreesToRadians(std::clamp(Light.OuterConeAngle, 0.0f, 90.0f));
+		const FVector Direction = Light.Direction.GetSafeNormal();
+
+		// 거의 반구이면 라이트 전체 구와 차이가 없음
+		if (HalfAngle >= DegreesToRadians(89.0f))
+		{
+			OutCenter = Light.Position;
+			OutRadius = Range;
+			return;
+		}
+
+		const float CosAngle = std::cos(HalfAngle);
+		if (HalfAngle <= PI * 0.25f)
+		{
+			OutRadius = Range / (2.0f * CosAngle);
+			OutCenter = Light.Position + Direction * OutRadius;
+		}
+		else
+		{
+			OutRadius = Range * std::sin(HalfAngle);
+			OutCenter = Light.Position + Direction * (Range * CosAngle);
+		}
+	}
+}
 
 FTileLightCuller::FTileLightCuller()
 	: RHI(nullptr)
@@ -8,8 +64,13 @@ FTileLightCuller::FTileLightCuller()
 	, TileCountX(0)
 	, TileCountY(0)
 	, TotalTileCount(0)
+	, NumSlices(1)
+	, NearSliceDepth(5.0f)
+	, ClusterDepthScale(0.0f)
+	, ClusterDepthBias(0.0f)
 	, LightIndexBuffer(nullptr)
 	, LightIndexBufferSRV(nullptr)
+	, LightIndexBufferCapacity(0)
 {
 }
 
@@ -23,7 +84,7 @@ void FTileLightCuller::Initialize(D3D11RHI* InRHI, UINT InTileSize)
 	RHI = InRHI;
 	TileSize = InTileSize;
 
-	// 초기화는 CullLights에서 뷰포트 크기를 알게 되면 수행
+	// 버퍼는 첫 업로드에서 필요한 크기를 알게 되면 생성
 }
 
 void FTileLightCuller::CullLights(
@@ -36,6 +97,22 @@ void FTileLightCuller::CullLights(
 	UINT ViewportWidth,
 	UINT ViewportHeight)
 {
+	BuildTileLightLists(PointLights, SpotLights, ViewMatrix, ProjMatrix, NearPlane, FarPlane, ViewportWidth, ViewportHeight);
+	UploadToGPU();
+}
+
+void FTileLightCuller::BuildTileLightLists(
+	const TArray<FPointLightInfo>& PointLights,
+	const TArray<FSpotLightInfo>& SpotLights,
+	const FMatrix& ViewMatrix,
+	const FMatrix& ProjMatrix,
+	float NearPlane,
+	float FarPlane,
+	UINT ViewportWidth,
+	UINT ViewportHeight)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
 	// 타일 그리드 계산
 	TileCountX = (ViewportWidth + TileSize - 1) / TileSize;
 	TileCountY = (ViewportHeight + TileSize - 1) / TileSize;
@@ -46,354 +123,485 @@ void FTileLightCuller::CullLights(
 	Stats.TileCountX = TileCountX;
 	Stats.TileCountY = TileCountY;
 	Stats.TotalTileCount = TotalTileCount;
+	Stats.ClusterSliceCount = GetClusterSliceCount();
 	Stats.TotalPointLights = PointLights.Num();
 	Stats.TotalSpotLights = SpotLights.Num();
 	Stats.TotalLights = PointLights.Num() + SpotLights.Num();
 
-	// 타일 라이트 인덱스 버퍼 크기 재조정
-	UINT RequiredSize = TotalTileCount * MaxLightsPerTile;
-	if (TileLightIndices.Num() != RequiredSize)
+	TileLightData.Empty();
+	if (TotalTileCount == 0)
 	{
-		TileLightIndices.SetNum(RequiredSize);
+		return;
 	}
 
-	// 버퍼 초기화 (모든 타일의 라이트 개수를 0으로)
-	memset(TileLightIndices.GetData(), 0, RequiredSize * sizeof(uint32));
-
-	// Inverse View-Projection 행렬 계산
-	FMatrix InvViewProj = ProjMatrix.InversePerspectiveProjection() * ViewMatrix.InverseAffine();
+	const float Width = static_cast<float>(ViewportWidth);
+	const float Height = static_cast<float>(ViewportHeight);
+	BuildTilePlanes(ProjMatrix, Width, Height);
+	if (NumSlices > 1)
+	{
+		BuildClusterSlices(ProjMatrix, NearPlane, FarPlane, Width, Height);
+	}
 
-	// 각 타일에 대해 컬링 수행
-	Stats.MinLightsPerTile = UINT_MAX;
-	Stats.MaxLightsPerTile = 0;
-	uint32 TotalLightsAcrossAllTiles = 0;
+	// 1) 라이트마다 뷰 공간 바운딩 구와 타일 사각형 (Point 먼저, 그다음 Spot - 타일 목록 순서도 동일)
+	const int32 NumPointLights = PointLights.Num();
+	const int32 NumLights = NumPointLights + SpotLights.Num();
+	LightBounds.SetNum(NumLights);
 
-	for (UINT TileY = 0; TileY < TileCountY; ++TileY)
+	ParallelFor(NumLights, [&](int32 LightIndex)
 	{
-		for (UINT TileX = 0; TileX < TileCountX; ++TileX)
+		FVector Center;
+		float Radius;
+		uint32 PackedIndex;
+
+		if (LightIndex < NumPointLights)
+		{
+			const FPointLightInfo& Light = PointLights[LightIndex];
+			Center = Light.Position;
+			Radius = Light.AttenuationRadius;
+			PackedIndex = static_cast<uint32>(LightIndex);
+		}
+		else
 		{
-			UINT TileIndex = TileY * TileCountX + TileX;
-			UINT TileDataOffset = TileIndex * MaxLightsPerTile;
+			const int32 SpotIndex = LightIndex - NumPointLights;
+			GetSpotLightBoundingSphere(SpotLights[SpotIndex], Center, Radius);
+			PackedIndex = (1u << 16) | static_cast<uint32>(SpotIndex);
+		}
 
-			// 타일 프러스텀 생성
-			FFrustum Frustum = CreateTileFrustum(TileX, TileY, InvViewProj, NearPlane, FarPlane);
+		const FVector ViewCenter = TransformPositionRowVector(ViewMatrix, Center);
+		ComputeLightBounds(ViewCenter, Radius, PackedIndex, ProjMatrix, NearPlane, FarPlane, Width, Height, LightBounds[LightIndex]);
+	}, 64);
 
-			uint32 LightCount = 0;
+	const uint64 SetupEndCycles = FPlatformTime::Cycles64();
 
-			// Point Light 테스트
-			for (int32 i = 0; i < PointLights.Num() && LightCount < MaxLightsPerTile - 1; ++i)
-			{
-				Stats.TotalLightTests++;
+	// 2) 타일 행마다 독립적으로 래스터화 + 행 안에서 칸 순으로 정렬
+	if (RowBins.Num() < static_cast<int32>(TileCountY))
+	{
+		RowBins.SetNum(TileCountY);
+	}
 
-				if (TestPointLightAgainstFrustum(PointLights[i], Frustum, ViewMatrix))
-				{
-					// 라이트 인덱스 저장 (상위 16비트: 타입(0=Point), 하위 16비트: 인덱스)
-					TileLightIndices[TileDataOffset + 1 + LightCount] = i;
-					LightCount++;
-					Stats.TotalLightsPassed++;
-				}
-			}
+	ParallelFor(static_cast<int32>(TileCountY), [&](int32 TileY)
+	{
+		BinRow(TileY, RowBins[TileY]);
+	}, 1);
 
-			// Spot Light 테스트
-			for (int32 i = 0; i < SpotLights.Num() && LightCount < MaxLightsPerTile - 1; ++i)
-			{
-				Stats.TotalLightTests++;
+	const uint64 BinEndCycles = FPlatformTime::Cycles64();
 
-				if (TestSpotLightAgainstFrustum(SpotLights[i], Frustum, ViewMatrix))
-				{
-					// 라이트 인덱스 저장 (상위 16비트: 타입(1=Spot), 하위 16비트: 인덱스)
-					TileLightIndices[TileDataOffset + 1 + LightCount] = (1 << 16) | i;
-					LightCount++;
-					Stats.TotalLightsPassed++;
-				}
-			}
+	// 3) 행 결과를 하나의 목록으로 합침: 그리드(Offset, Count) 뒤에 인덱스가 이어짐
+	TArray<uint32> RowOffsets;
+	RowOffsets.SetNum(TileCountY);
 
-			// 첫 번째 요소에 라이트 개수 저장
-			TileLightIndices[TileDataOffset] = LightCount;
+	const uint32 CellsPerRow = TileCountX * NumSlices;
+	const uint32 TotalCellCount = TotalTileCount * NumSlices;
+	const uint32 GridSize = TotalCellCount * 2;
+	uint32 NumIndices = 0;
+	Stats.MinLightsPerTile = UINT_MAX;
+	Stats.MaxLightsPerTile = 0;
+	for (UINT TileY = 0; TileY < TileCountY; ++TileY)
+	{
+		const FRowBin& Bin = RowBins[TileY];
+		RowOffsets[TileY] = GridSize + NumIndices;
+		NumIndices += static_cast<uint32>(Bin.SortedIndices.Num());
+		Stats.MinLightsPerTile = FMath::Min(Stats.MinLightsPerTile, Bin.MinCount);
+		Stats.MaxLightsPerTile = FMath::Max(Stats.MaxLightsPerTile, Bin.MaxCount);
+	}
 
-			// 통계 업데이트
-			Stats.MinLightsPerTile = FMath::Min(Stats.MinLightsPerTile, LightCount);
-			Stats.MaxLightsPerTile = FMath::Max(Stats.MaxLightsPerTile, LightCount);
-			TotalLightsAcrossAllTiles += LightCount;
+	TileLightData.SetNum(GridSize + NumIndices);
+	uint32* Data = TileLightData.GetData();
+
+	ParallelFor(static_cast<int32>(TileCountY), [&](int32 TileY)
+	{
+		const FRowBin& Bin = RowBins[TileY];
+		const uint32 RowOffset = RowOffsets[TileY];
+		uint32* Grid = Data + static_cast<size_t>(TileY) * CellsPerRow * 2;
+
+		for (uint32 Cell = 0; Cell < CellsPerRow; ++Cell)
+		{
+			Grid[Cell * 2] = RowOffset + Bin.TileOffsets[Cell];
+			Grid[Cell * 2 + 1] = Bin.TileCounts[Cell];
 		}
-	}
 
-	// 평균 계산
-	if (TotalTileCount > 0)
+		if (!Bin.SortedIndices.IsEmpty())
+		{
+			memcpy(Data + RowOffset, Bin.SortedIndices.GetData(), Bin.SortedIndices.Num() * sizeof(uint32));
+		}
+	}, 8);
+
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+
+	// 통계: 테스트 수는 컬링 없이 모든 칸에 모든 라이트를 적용했을 때 기준
+	Stats.TotalLightTests = static_cast<uint32>(NumLights) * TotalCellCount;
+	Stats.TotalLightsPassed = NumIndices;
+	Stats.CalculateStats();
+	Stats.LightIndexBufferSizeBytes = static_cast<uint32>(TileLightData.Num() * sizeof(uint32));
+	Stats.LightSetupTimeMS = static_cast<float>(FPlatformTime::ToMilliseconds(SetupEndCycles - StartCycles));
+	Stats.BinningTimeMS = static_cast<float>(FPlatformTime::ToMilliseconds(BinEndCycles - SetupEndCycles));
+	Stats.CompactTimeMS = static_cast<float>(FPlatformTime::ToMilliseconds(EndCycles - BinEndCycles));
+	Stats.CPUCullTimeMS = static_cast<float>(FPlatformTime::ToMilliseconds(EndCycles - StartCycles));
+}
+
+void FTileLightCuller::ComputeLightBounds(
+	const FVector& ViewCenter,
+	float Radius,
+	uint32 PackedIndex,
+	const FMatrix& ProjMatrix,
+	float NearPlane,
+	float FarPlane,
+	float ViewportWidth,
+	float ViewportHeight,
+	FLightScreenBounds& OutBounds) const
+{
+	OutBounds.CenterX = ViewCenter.X;
+	OutBounds.CenterY = ViewCenter.Y;
+	OutBounds.CenterZ = ViewCenter.Z;
+	OutBounds.Radius = Radius;
+	OutBounds.PackedIndex = PackedIndex;
+	OutBounds.MinSlice = 0;
+	OutBounds.MaxSlice = 0;
+	OutBounds.bVisible = false;
+
+	// 깊이 범위 밖 (뷰 공간 z = 카메라 앞 방향 거리)
+	if (Radius <= 0.0f || ViewCenter.Z + Radius < NearPlane || ViewCenter.Z - Radius > FarPlane)
 	{
-		Stats.AvgLightsPerTile = static_cast<float>(TotalLightsAcrossAllTiles) / static_cast<float>(TotalTileCount);
+		return;
 	}
 
-	// 컬링 효율성 계산
-	Stats.CalculateStats();
+	// 근평면 앞쪽을 잘라낸 뷰 공간 AABB의 8개 꼭짓점을 투영 → 화면 사각형
+	const float MinZ = FMath::Max(ViewCenter.Z - Radius, NearPlane);
+	const float MaxZ = FMath::Min(ViewCenter.Z + Radius, FarPlane);
 
-	// GPU 버퍼 생성 또는 업데이트
-	if (!LightIndexBuffer)
+	float NdcMinX = FLT_MAX, NdcMinY = FLT_MAX;
+	float NdcMaxX = -FLT_MAX, NdcMaxY = -FLT_MAX;
+	for (int32 Corner = 0; Corner < 8; ++Corner)
 	{
-		// 버퍼 생성
-		HRESULT hr = RHI->CreateStructuredBuffer(
-			sizeof(uint32),
-			RequiredSize,
-			TileLightIndices.GetData(),
-			&LightIndexBuffer
-		);
-
-		if (SUCCEEDED(hr))
+		const float X = ViewCenter.X + ((Corner & 1) ? Radius : -Radius);
+		const float Y = ViewCenter.Y + ((Corner & 2) ? Radius : -Radius);
+		const float Z = (Corner & 4) ? MaxZ : MinZ;
+
+		const float ClipX = X * ProjMatrix.M[0][0] + Y * ProjMatrix.M[1][0] + Z * ProjMatrix.M[2][0] + ProjMatrix.M[3][0];
+		const float ClipY = X * ProjMatrix.M[0][1] + Y * ProjMatrix.M[1][1] + Z * ProjMatrix.M[2][1] + ProjMatrix.M[3][1];
+		const float ClipW = X * ProjMatrix.M[0][3] + Y * ProjMatrix.M[1][3] + Z * ProjMatrix.M[2][3] + ProjMatrix.M[3][3];
+
+		// 카메라 평면에 걸치면 사각형을 믿을 수 없으므로 화면 전체
+		if (ClipW <= KINDA_SMALL_NUMBER)
 		{
-			// SRV 생성
-			RHI->CreateStructuredBufferSRV(LightIndexBuffer, &LightIndexBufferSRV);
+			NdcMinX = NdcMinY = -1.0f;
+			NdcMaxX = NdcMaxY = 1.0f;
+			break;
 		}
 
-		Stats.LightIndexBufferSizeBytes = RequiredSize * sizeof(uint32);
-	}
-	else
-	{
-		// 기존 버퍼 업데이트
-		RHI->UpdateStructuredBuffer(
-			LightIndexBuffer,
-			TileLightIndices.GetData(),
-			RequiredSize * sizeof(uint32)
-		);
+		const float InvW = 1.0f / ClipW;
+		NdcMinX = FMath::Min(NdcMinX, ClipX * InvW);
+		NdcMaxX = FMath::Max(NdcMaxX, ClipX * InvW);
+		NdcMinY = FMath::Min(NdcMinY, ClipY * InvW);
+		NdcMaxY = FMath::Max(NdcMaxY, ClipY * InvW);
 	}
-}
 
-FFrustum FTileLightCuller::CreateTileFrustum(
-	UINT TileX,
-	UINT TileY,
-	const FMatrix& InvViewProj,
-	float NearPlane,
-	float FarPlane)
-{
-	FFrustum Frustum;
-
-	// 타일의 NDC 좌표 계산
-	// NDC: [-1, 1] 범위, 왼쪽 아래가 (-1, -1), 오른쪽 위가 (1, 1)
-	// 주의: DirectX는 Y축이 위쪽이 양수
-
-	float TileMinX = static_cast<float>(TileX * TileSize);
-	float TileMaxX = static_cast<float>((TileX + 1) * TileSize);
-	float TileMinY = static_cast<float>(TileY * TileSize);
-	float TileMaxY = static_cast<float>((TileY + 1) * TileSize);
-
-	// 뷰포트 크기
-	float ViewportWidth = static_cast<float>(TileCountX * TileSize);
-	float ViewportHeight = static_cast<float>(TileCountY * TileSize);
-
-	// Screen Space -> NDC
-	float NDC_MinX = (TileMinX / ViewportWidth) * 2.0f - 1.0f;
-	float NDC_MaxX = (TileMaxX / ViewportWidth) * 2.0f - 1.0f;
-	float NDC_MinY = 1.0f - (TileMaxY / ViewportHeight) * 2.0f; // Y축 반전
-	float NDC_MaxY = 1.0f - (TileMinY / ViewportHeight) * 2.0f;
-
-	// 8개의 프러스텀 코너 (NDC 공간)
-	FVector4 FrustumCorners[8];
-
-	// Near plane corners
-	FrustumCorners[0] = FVector4(NDC_MinX, NDC_MinY, 0.0f, 1.0f);
-	FrustumCorners[1] = FVector4(NDC_MaxX, NDC_MinY, 0.0f, 1.0f);
-	FrustumCorners[2] = FVector4(NDC_MaxX, NDC_MaxY, 0.0f, 1.0f);
-	FrustumCorners[3] = FVector4(NDC_MinX, NDC_MaxY, 0.0f, 1.0f);
-
-	// Far plane corners
-	FrustumCorners[4] = FVector4(NDC_MinX, NDC_MinY, 1.0f, 1.0f);
-	FrustumCorners[5] = FVector4(NDC_MaxX, NDC_MinY, 1.0f, 1.0f);
-	FrustumCorners[6] = FVector4(NDC_MaxX, NDC_MaxY, 1.0f, 1.0f);
-	FrustumCorners[7] = FVector4(NDC_MinX, NDC_MaxY, 1.0f, 1.0f);
-
-	// NDC -> World Space 변환
-	FVector WorldCorners[8];
-	for (int i = 0; i < 8; ++i)
+	// NDC → 픽셀 (Y축 반전)
+	const float MinPixelX = (NdcMinX * 0.5f + 0.5f) * ViewportWidth;
+	const float MaxPixelX = (NdcMaxX * 0.5f + 0.5f) * ViewportWidth;
+	const float MinPixelY = (0.5f - NdcMaxY * 0.5f) * ViewportHeight;
+	const float MaxPixelY = (0.5f - NdcMinY * 0.5f) * ViewportHeight;
+
+	if (MaxPixelX < 0.0f || MinPixelX >= ViewportWidth || MaxPixelY < 0.0f || MinPixelY >= ViewportHeight)
 	{
-		FVector4 WorldPos = FrustumCorners[i] * InvViewProj;
-		WorldPos /= WorldPos.W; // Perspective divide
-		WorldCorners[i] = FVector(WorldPos.X, WorldPos.Y, WorldPos.Z);
+		return;
 	}
 
-	// 프러스텀 평면 생성 (외향 법선)
-	// 평면 방정식: Normal · P + Distance = 0
+	const float InvTileSize = 1.0f / static_cast<float>(TileSize);
+	OutBounds.MinTileX = static_cast<int32>(FMath::Max(MinPixelX, 0.0f) * InvTileSize);
+	OutBounds.MinTileY = static_cast<int32>(FMath::Max(MinPixelY, 0.0f) * InvTileSize);
+	OutBounds.MaxTileX = FMath::Min(static_cast<int32>(FMath::Min(MaxPixelX, ViewportWidth) * InvTileSize), static_cast<int32>(TileCountX) - 1);
+	OutBounds.MaxTileY = FMath::Min(static_cast<int32>(FMath::Min(MaxPixelY, ViewportHeight) * InvTileSize), static_cast<int32>(TileCountY) - 1);
 
-	// Left plane (점: 0, 3, 7)
+	// 슬라이스 범위 (log/pow 경계 반올림 차이를 감안해 한 칸씩 넓힘, 실제 판정은 클러스터 AABB)
+	if (NumSlices > 1)
 	{
-		FVector Edge1 = WorldCorners[3] - WorldCorners[0];
-		FVector Edge2 = WorldCorners[7] - WorldCorners[0];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.LeftFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.LeftFace.Distance = -FVector::Dot(Normal, WorldCorners[0]);
+		OutBounds.MinSlice = FMath::Max(GetSliceForDepth(MinZ) - 1, 0);
+		OutBounds.MaxSlice = FMath::Min(GetSliceForDepth(MaxZ) + 1, static_cast<int32>(NumSlices) - 1);
 	}
+	OutBounds.bVisible = true;
+}
 
-	// Right plane (점: 1, 5, 6)
+void FTileLightCuller::BuildTilePlanes(const FMatrix& ProjMatrix, float ViewportWidth, float ViewportHeight)
+{
+	// 클립 공간 x >= a * w  ⇔  dot(Col0 - a * Col3, (p, 1)) >= 0 (뷰 공간 평면을 투영 행렬 열로 바로 구함)
+	const FVector4 Col0 = GetMatrixColumn(ProjMatrix, 0);
+	const FVector4 Col1 = GetMatrixColumn(ProjMatrix, 1);
+	const FVector4 Col3 = GetMatrixColumn(ProjMatrix, 3);
+	const float TileSizeF = static_cast<float>(TileSize);
+
+	const int32 PaddedCount = static_cast<int32>(TileCountX) + 3;
+	TArray<float>* ColumnArrays[] = { &LeftNX, &LeftNY, &LeftNZ, &LeftD, &RightNX, &RightNY, &RightNZ, &RightD };
+	for (TArray<float>* Array : ColumnArrays)
 	{
-		FVector Edge1 = WorldCorners[5] - WorldCorners[1];
-		FVector Edge2 = WorldCorners[6] - WorldCorners[1];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.RightFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.RightFace.Distance = -FVector::Dot(Normal, WorldCorners[1]);
+		Array->SetNum(PaddedCount);
+		std::fill(Array->begin(), Array->end(), 0.0f);
 	}
 
-	// Bottom plane (점: 0, 1, 5)
+	for (UINT TileX = 0; TileX < TileCountX; ++TileX)
 	{
-		FVector Edge1 = WorldCorners[1] - WorldCorners[0];
-		FVector Edge2 = WorldCorners[5] - WorldCorners[0];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.BottomFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.BottomFace.Distance = -FVector::Dot(Normal, WorldCorners[0]);
+		const float NdcMinX = 2.0f * (TileX * TileSizeF) / ViewportWidth - 1.0f;
+		const float NdcMaxX = 2.0f * ((TileX + 1) * TileSizeF) / ViewportWidth - 1.0f;
+
+		const FVector4 Left = NormalizePlane(
+			Col0.X - NdcMinX * Col3.X, Col0.Y - NdcMinX * Col3.Y, Col0.Z - NdcMinX * Col3.Z, Col0.W - NdcMinX * Col3.W);
+		const FVector4 Right = NormalizePlane(
+			NdcMaxX * Col3.X - Col0.X, NdcMaxX * Col3.Y - Col0.Y, NdcMaxX * Col3.Z - Col0.Z, NdcMaxX * Col3.W - Col0.W);
+
+		LeftNX[TileX] = Left.X; LeftNY[TileX] = Left.Y; LeftNZ[TileX] = Left.Z; LeftD[TileX] = Left.W;
+		RightNX[TileX] = Right.X; RightNY[TileX] = Right.Y; RightNZ[TileX] = Right.Z; RightD[TileX] = Right.W;
 	}
 
-	// Top plane (점: 2, 3, 7)
+	TopPlanes.SetNum(TileCountY);
+	BottomPlanes.SetNum(TileCountY);
+	for (UINT TileY = 0; TileY < TileCountY; ++TileY)
 	{
-		FVector Edge1 = WorldCorners[3] - WorldCorners[2];
-		FVector Edge2 = WorldCorners[7] - WorldCorners[2];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.TopFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.TopFace.Distance = -FVector::Dot(Normal, WorldCorners[2]);
+		// 픽셀 Y는 아래로 증가, NDC Y는 위로 증가
+		const float NdcMaxY = 1.0f - 2.0f * (TileY * TileSizeF) / ViewportHeight;
+		const float NdcMinY = 1.0f - 2.0f * ((TileY + 1) * TileSizeF) / ViewportHeight;
+
+		TopPlanes[TileY] = NormalizePlane(
+			NdcMaxY * Col3.X - Col1.X, NdcMaxY * Col3.Y - Col1.Y, NdcMaxY * Col3.Z - Col1.Z, NdcMaxY * Col3.W - Col1.W);
+		BottomPlanes[TileY] = NormalizePlane(
+			Col1.X - NdcMinY * Col3.X, Col1.Y - NdcMinY * Col3.Y, Col1.Z - NdcMinY * Col3.Z, Col1.W - NdcMinY * Col3.W);
 	}
+}
 
-	// Near plane (점: 0, 1, 2)
+void FTileLightCuller::BuildClusterSlices(const FMatrix& ProjMatrix, float NearPlane, float FarPlane, float ViewportWidth, float ViewportHeight)
+{
+	// 슬라이스 0 = [Near, NearSliceDepth], 나머지는 NearSliceDepth~Far 지수 분할 (먼 곳일수록 두꺼움)
+	// Near부터 바로 지수 분할하면 근평면이 작을 때 카메라 앞 몇 미터에 슬라이스 절반이 몰림
+	const float SafeNear = FMath::Max(NearPlane, 1e-3f);
+	const float SafeFar = FMath::Max(FarPlane, SafeNear * 4.0f);
+	const float SplitDepth = std::clamp(NearSliceDepth, SafeNear * 2.0f, SafeFar * 0.5f);
+	const float LogRatio = std::log(SafeFar / SplitDepth);
+	const float NumExpSlices = static_cast<float>(NumSlices - 1);
+
+	// floor(log(z) * Scale + Bias): z = SplitDepth에서 1, z = Far에서 NumSlices (SplitDepth보다 가까우면 0으로 clamp)
+	ClusterDepthScale = NumExpSlices / LogRatio;
+	ClusterDepthBias = 1.0f - ClusterDepthScale * std::log(SplitDepth);
+
+	SliceDepths.SetNum(NumSlices + 1);
+	SliceDepths[0] = SafeNear;
+	for (UINT Slice = 1; Slice < NumSlices; ++Slice)
 	{
-		FVector Edge1 = WorldCorners[1] - WorldCorners[0];
-		FVector Edge2 = WorldCorners[2] - WorldCorners[0];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.NearFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.NearFace.Distance = -FVector::Dot(Normal, WorldCorners[0]);
+		SliceDepths[Slice] = SplitDepth * std::exp(LogRatio * static_cast<float>(Slice - 1) / NumExpSlices);
 	}
+	SliceDepths[NumSlices] = SafeFar;
+
+	// 원근 투영 (clip.w = z): ndc.x = P00 * x / z + P20  →  x / z = (ndc.x - P20) / P00
+	const float TileSizeF = static_cast<float>(TileSize);
+	const float InvScaleX = 1.0f / ProjMatrix.M[0][0];
+	const float InvScaleY = 1.0f / ProjMatrix.M[1][1];
 
-	// Far plane (점: 4, 6, 5)
+	ColumnMinSlope.SetNum(TileCountX);
+	ColumnMaxSlope.SetNum(TileCountX);
+	for (UINT TileX = 0; TileX < TileCountX; ++TileX)
 	{
-		FVector Edge1 = WorldCorners[6] - WorldCorners[4];
-		FVector Edge2 = WorldCorners[5] - WorldCorners[4];
-		FVector Normal = FVector::Cross(Edge1, Edge2).GetSafeNormal();
-		Frustum.FarFace.Normal = FVector4(Normal.X, Normal.Y, Normal.Z, 0.0f);
-		Frustum.FarFace.Distance = -FVector::Dot(Normal, WorldCorners[4]);
+		const float NdcMinX = 2.0f * (TileX * TileSizeF) / ViewportWidth - 1.0f;
+		const float NdcMaxX = 2.0f * ((TileX + 1) * TileSizeF) / ViewportWidth - 1.0f;
+		ColumnMinSlope[TileX] = (NdcMinX - ProjMatrix.M[2][0]) * InvScaleX;
+		ColumnMaxSlope[TileX] = (NdcMaxX - ProjMatrix.M[2][0]) * InvScaleX;
 	}
 
-	return Frustum;
+	RowMinSlope.SetNum(TileCountY);
+	RowMaxSlope.SetNum(TileCountY);
+	for (UINT TileY = 0; TileY < TileCountY; ++TileY)
+	{
+		const float NdcMaxY = 1.0f - 2.0f * (TileY * TileSizeF) / ViewportHeight;
+		const float NdcMinY = 1.0f - 2.0f * ((TileY + 1) * TileSizeF) / ViewportHeight;
+		RowMinSlope[TileY] = (NdcMinY - ProjMatrix.M[2][1]) * InvScaleY;
+		RowMaxSlope[TileY] = (NdcMaxY - ProjMatrix.M[2][1]) * InvScaleY;
+	}
 }
 
-bool FTileLightCuller::TestPointLightAgainstFrustum(
-	const FPointLightInfo& Light,
-	const FFrustum& Frustum,
-	const FMatrix& ViewMatrix)
+int32 FTileLightCuller::GetSliceForDepth(float ViewDepth) const
 {
-	// Point Light는 구체로 근사
-	FVector LightPos = Light.Position;
-	float Radius = Light.AttenuationRadius;
+	// 셰이더의 CalculateLightGridIndex와 같은 식
+	const float Slice = std::floor(std::log(FMath::Max(ViewDepth, 1e-4f)) * ClusterDepthScale + ClusterDepthBias);
+	return std::clamp(static_cast<int32>(Slice), 0, static_cast<int32>(NumSlices) - 1);
+}
 
-	return SphereIntersectsFrustum(LightPos, Radius, Frustum);
+bool FTileLightCuller::SphereIntersectsTileRow(const FLightScreenBounds& Light, int32 TileY) const
+{
+	const FVector4& Top = TopPlanes[TileY];
+	const FVector4& Bottom = BottomPlanes[TileY];
+	const float NegRadius = -Light.Radius;
+	return Top.X * Light.CenterX + Top.Y * Light.CenterY + Top.Z * Light.CenterZ + Top.W >= NegRadius &&
+		Bottom.X * Light.CenterX + Bottom.Y * Light.CenterY + Bottom.Z * Light.CenterZ + Bottom.W >= NegRadius;
 }
 
-bool FTileLightCuller::TestSpotLightAgainstFrustum(
-	const FSpotLightInfo& Light,
-	const FFrustum& Frustum,
-	const FMatrix& ViewMatrix)
+bool FTileLightCuller::SphereIntersectsTileColumn(const FLightScreenBounds& Light, int32 TileX) const
 {
-	FVector LightPos = Light.Position;
-	float Radius = Light.AttenuationRadius;
+	// BinRow의 SSE 경로와 같은 연산 순서
+	const float NegRadius = -Light.Radius;
+	const float LeftDist = (LeftNX[TileX] * Light.CenterX + LeftNY[TileX] * Light.CenterY) + (LeftNZ[TileX] * Light.CenterZ + LeftD[TileX]);
+	const float RightDist = (RightNX[TileX] * Light.CenterX + RightNY[TileX] * Light.CenterY) + (RightNZ[TileX] * Light.CenterZ + RightD[TileX]);
+	return LeftDist >= NegRadius && RightDist >= NegRadius;
+}
 
-	// Spot Light도 구체로 근사
-	return SphereIntersectsFrustum(LightPos, Radius, Frustum);
+bool FTileLightCuller::SphereIntersectsClusterBox(const FLightScreenBounds& Light, int32 TileX, int32 TileY, int32 Slice) const
+{
+	// 클러스터(타일 절두체 ∩ 깊이 슬라이스)를 감싸는 뷰 공간 AABB와 구의 거리
+	const float NearZ = SliceDepths[Slice];
+	const float FarZ = SliceDepths[Slice + 1];
+
+	const float MinSlopeX = ColumnMinSlope[TileX], MaxSlopeX = ColumnMaxSlope[TileX];
+	const float MinSlopeY = RowMinSlope[TileY], MaxSlopeY = RowMaxSlope[TileY];
+	const float MinX = MinSlopeX * (MinSlopeX < 0.0f ? FarZ : NearZ);
+	const float MaxX = MaxSlopeX * (MaxSlopeX > 0.0f ? FarZ : NearZ);
+	const float MinY = MinSlopeY * (MinSlopeY < 0.0f ? FarZ : NearZ);
+	const float MaxY = MaxSlopeY * (MaxSlopeY > 0.0f ? FarZ : NearZ);
+
+	const float DX = Light.CenterX - std::clamp(Light.CenterX, MinX, MaxX);
+	const float DY = Light.CenterY - std::clamp(Light.CenterY, MinY, MaxY);
+	const float DZ = Light.CenterZ - std::clamp(Light.CenterZ, NearZ, FarZ);
+	return DX * DX + DY * DY + DZ * DZ <= Light.Radius * Light.Radius;
 }
 
-bool FTileLightCuller::SphereIntersectsFrustum(
-	const FVector& Center,
-	float Radius,
-	const FFrustum& Frustum)
+void FTileLightCuller::BinRow(int32 TileY, FRowBin& Bin) const
 {
-	// 구체가 모든 평면의 앞쪽(양수)에 있으면 프러스텀 내부
-	// 하나라도 뒤쪽(음수)에 있고 거리가 반지름보다 크면 외부
-
-	// 6개 평면 각각에 대해 테스트
-	const FPlane* Planes[6] = {
-		&Frustum.LeftFace,
-		&Frustum.RightFace,
-		&Frustum.TopFace,
-		&Frustum.BottomFace,
-		&Frustum.NearFace,
-		&Frustum.FarFace
-	};
-
-	for (int i = 0; i < 6; ++i)
+	const uint32 CellsPerRow = TileCountX * NumSlices;
+	Bin.TileCounts.SetNum(CellsPerRow);
+	Bin.TileOffsets.SetNum(CellsPerRow);
+	std::fill(Bin.TileCounts.begin(), Bin.TileCounts.end(), 0u);
+	Bin.EntryCells.Empty();
+	Bin.EntryIndices.Empty();
+
+	for (const FLightScreenBounds& Light : LightBounds)
 	{
-		// 평면 방정식: Normal · P + Distance = 0
-		// 점 P에서 평면까지의 부호 있는 거리 = Normal · P + Distance
-		FVector Normal3D(Planes[i]->Normal.X, Planes[i]->Normal.Y, Planes[i]->Normal.Z);
-		float SignedDistance = FVector::Dot(Normal3D, Center) + Planes[i]->Distance;
+		if (!Light.bVisible || TileY < Light.MinTileY || TileY > Light.MaxTileY)
+		{
+			continue;
+		}
 
-		// 구체가 평면 뒤쪽에 완전히 있으면 교차하지 않음
-		if (SignedDistance < -Radius)
+		// 행 평면 2개는 스칼라로 먼저 (행 전체가 탈락하면 열 검사 생략)
+		if (!SphereIntersectsTileRow(Light, TileY))
 		{
-			return false;
+			continue;
 		}
-	}
 
-	return true;
-}
+		// 열 평면은 4타일씩 SSE로 (구가 평면 바깥으로 반지름 이상 벗어나지 않으면 통과 - 보수적)
+		const __m128 CenterX = _mm_set1_ps(Light.CenterX);
+		const __m128 CenterY = _mm_set1_ps(Light.CenterY);
+		const __m128 CenterZ = _mm_set1_ps(Light.CenterZ);
+		const __m128 NegRadius4 = _mm_set1_ps(-Light.Radius);
 
-bool FTileLightCuller::ConeIntersectsFrustum(
-	const FVector& Apex,
-	const FVector& Direction,
-	float Height,
-	float CosHalfAngle,
-	const FFrustum& Frustum)
-{
-	// 원뿔-프러스텀 교차 테스트
-	float SinHalfAngle = sqrt(1.0f - CosHalfAngle * CosHalfAngle);
+		for (int32 TileX = Light.MinTileX; TileX <= Light.MaxTileX; TileX += 4)
+		{
+			const __m128 LeftDist = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&LeftNX[TileX]), CenterX), _mm_mul_ps(_mm_loadu_ps(&LeftNY[TileX]), CenterY)),
+				_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&LeftNZ[TileX]), CenterZ), _mm_loadu_ps(&LeftD[TileX])));
+			const __m128 RightDist = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&RightNX[TileX]), CenterX), _mm_mul_ps(_mm_loadu_ps(&RightNY[TileX]), CenterY)),
+				_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&RightNZ[TileX]), CenterZ), _mm_loadu_ps(&RightD[TileX])));
+
+			int32 Mask = _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(LeftDist, NegRadius4), _mm_cmpge_ps(RightDist, NegRadius4)));
+
+			// 사각형 밖의 레인 제외
+			const int32 NumValid = Light.MaxTileX - TileX + 1;
+			if (NumValid < 4)
+			{
+				Mask &= (1 << NumValid) - 1;
+			}
 
-	// 원뿔 밑면의 반지름
-	float BaseRadius = Height * SinHalfAngle;
+			for (int32 Lane = 0; Mask != 0; ++Lane, Mask >>= 1)
+			{
+				if (!(Mask & 1))
+				{
+					continue;
+				}
 
-	// 경계 구체의 중심은 원뿔 축을 따라 이동
-	float K = (CosHalfAngle > 0.707f) ? 0.5f : (0.5f + 0.5f * SinHalfAngle);
-	FVector SphereCenter = Apex + Direction * (Height * K);
+				const int32 HitTileX = TileX + Lane;
+				if (NumSlices == 1)
+				{
+					Bin.EntryCells.Add(static_cast<uint32>(HitTileX));
+					Bin.EntryIndices.Add(Light.PackedIndex);
+					++Bin.TileCounts[HitTileX];
+					continue;
+				}
 
-	// 경계 구체의 반지름 (원뿔의 꼭지점과 밑면 가장자리를 모두 포함)
-	float SphereRadius;
-	if (CosHalfAngle > 0.707f) // 각도가 45도 이하 (좁은 원뿔)
-	{
-		// 좁은 원뿔: 밑면 중심에서 가장자리까지의 거리
-		SphereRadius = sqrt(BaseRadius * BaseRadius + (Height * 0.5f) * (Height * 0.5f));
+				// 클러스터: 구의 깊이 범위에 걸친 슬라이스만 AABB로 다시 판정
+				for (int32 Slice = Light.MinSlice; Slice <= Light.MaxSlice; ++Slice)
+				{
+					if (SphereIntersectsClusterBox(Light, HitTileX, TileY, Slice))
+					{
+						const uint32 Cell = static_cast<uint32>(HitTileX) * NumSlices + static_cast<uint32>(Slice);
+						Bin.EntryCells.Add(Cell);
+						Bin.EntryIndices.Add(Light.PackedIndex);
+						++Bin.TileCounts[Cell];
+					}
+				}
+			}
+		}
 	}
-	else // 각도가 45도 이상 (넓은 원뿔)
+
+	// 카운팅 정렬로 칸 순 배치 (라이트 순서로 추가했으므로 칸 안에서는 원래 순서 유지)
+	uint32 Running = 0;
+	Bin.MinCount = UINT_MAX;
+	Bin.MaxCount = 0;
+	for (uint32 Cell = 0; Cell < CellsPerRow; ++Cell)
 	{
-		// 넓은 원뿔: 더 보수적인 반지름 사용
-		SphereRadius = Height * 0.866f; // sqrt(3)/2 ≈ 0.866
+		const uint32 Count = Bin.TileCounts[Cell];
+		Bin.TileOffsets[Cell] = Running;
+		Running += Count;
+		Bin.MinCount = FMath::Min(Bin.MinCount, Count);
+		Bin.MaxCount = FMath::Max(Bin.MaxCount, Count);
 	}
 
-	// 2. 경계 구체가 프러스텀과 교차하는지 먼저 테스트 (빠른 거부)
-	if (!SphereIntersectsFrustum(SphereCenter, SphereRadius, Frustum))
+	Bin.SortedIndices.SetNum(static_cast<int32>(Running));
+	TArray<uint32>& Cursor = Bin.TileCounts;	// 개수는 이미 Offsets에 반영됐으므로 쓰기 위치로 재사용
+	for (uint32 Cell = 0; Cell < CellsPerRow; ++Cell)
+	{
+		Cursor[Cell] = Bin.TileOffsets[Cell];
+	}
+	for (int32 Entry = 0; Entry < Bin.EntryCells.Num(); ++Entry)
 	{
-		return false;
+		Bin.SortedIndices[Cursor[Bin.EntryCells[Entry]]++] = Bin.EntryIndices[Entry];
 	}
+	for (uint32 Cell = 0; Cell < CellsPerRow; ++Cell)
+	{
+		Cursor[Cell] -= Bin.TileOffsets[Cell];
+	}
+}
 
-	// 3. 추가 정밀 테스트: 원뿔 끝점(밑면 중심)도 체크
-	FVector ConeEnd = Apex + Direction * Height;
-
-	// 6개 평면 각각에 대해 테스트
-	const FPlane* Planes[6] = {
-		&Frustum.LeftFace,
-		&Frustum.RightFace,
-		&Frustum.TopFace,
-		&Frustum.BottomFace,
-		&Frustum.NearFace,
-		&Frustum.FarFace
-	};
-
-	// 원뿔의 꼭지점과 끝점이 모두 같은 평면 뒤쪽에 있는지 확인
-	for (int i = 0; i < 6; ++i)
+void FTileLightCuller::UploadToGPU()
+{
+	if (!RHI || TileLightData.IsEmpty())
 	{
-		FVector Normal3D(Planes[i]->Normal.X, Planes[i]->Normal.Y, Planes[i]->Normal.Z);
+		return;
+	}
+
+	const uint32 RequiredCount = static_cast<uint32>(TileLightData.Num());
 
-		float ApexDistance = FVector::Dot(Normal3D, Apex) + Planes[i]->Distance;
-		float EndDistance = FVector::Dot(Normal3D, ConeEnd) + Planes[i]->Distance;
+	// 해상도나 라이트 수가 늘어 용량이 부족할 때만 다시 생성 (조금씩 늘 때마다 만들지 않도록 여유분)
+	if (!LightIndexBuffer || RequiredCount > LightIndexBufferCapacity)
+	{
+		if (LightIndexBufferSRV)
+		{
+			LightIndexBufferSRV->Release();
+			LightIndexBufferSRV = nullptr;
+		}
+		if (LightIndexBuffer)
+		{
+			LightIndexBuffer->Release();
+			LightIndexBuffer = nullptr;
+		}
+		LightIndexBufferCapacity = 0;
 
-		// 두 점이 모두 평면 뒤쪽에 있고, 밑면 반지름보다 멀리 있으면 완전히 외부
-		if (ApexDistance < -BaseRadius && EndDistance < -BaseRadius)
+		const uint32 NewCapacity = FMath::Max(RequiredCount + RequiredCount / 2, 1024u);
+		HRESULT hr = RHI->CreateStructuredBuffer(sizeof(uint32), NewCapacity, nullptr, &LightIndexBuffer);
+		if (FAILED(hr))
 		{
-			return false;
+			LightIndexBuffer = nullptr;
+			return;
 		}
+
+		RHI->CreateStructuredBufferSRV(LightIndexBuffer, &LightIndexBufferSRV);
+		LightIndexBufferCapacity = NewCapacity;
 	}
 
-	// 모든 테스트를 통과하면 교차한다고 판단
-	return true;
+	RHI->UpdateStructuredBuffer(LightIndexBuffer, TileLightData.GetData(), RequiredCount * sizeof(uint32));
 }
 
 ID3D11ShaderResourceView* FTileLightCuller::GetLightIndexBufferSRV()
@@ -415,5 +623,6 @@ void FTileLightCuller::Release()
 		LightIndexBuffer = nullptr;
 	}
 
-	TileLightIndices.Empty();
+	LightIndexBufferCapacity = 0;
+	TileLightData.Empty();
 }
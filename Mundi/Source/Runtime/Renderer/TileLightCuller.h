@@ -2,10 +2,14 @@
 #include "LightManager.h"
 #include "TileCullingStats.h"
 #include "D3D11RHI.h"
-#include "Frustum.h"
 
 // 타일 기반 라이트 컬링을 CPU에서 수행하는 클래스
-// Conservative(near, far) frustum 방식으로 각 타일에 영향을 주는 라이트를 계산
+// 1) 라이트마다 한 번: 뷰 공간 바운딩 구 → 깊이 범위 검사 + 화면 타일 사각형 (+ 클러스터 모드면 슬라이스 범위)
+// 2) 타일 행 단위 병렬 래스터화: 사각형 안의 타일만 타일 측면 평면으로 보수적 판정 (열 방향 SSE 4타일씩)
+//    클러스터 모드는 통과한 타일을 지수 깊이 슬라이스로 나눠 구-클러스터 AABB로 다시 판정
+// 3) 결과는 가변 길이 목록으로 압축해 한 버퍼로 업로드 (칸 = 타일, 클러스터 모드면 TileIndex * SliceCount + Slice)
+//    [0, 2 * 칸 수)                       : 칸마다 (Offset, Count)
+//    [2 * 칸 수, ...)                     : 라이트 인덱스 (상위 16비트: 타입(0=Point, 1=Spot), 하위 16비트: 인덱스)
 class FTileLightCuller
 {
 public:
@@ -15,7 +19,7 @@ public:
 	// 초기화 (Structured Buffer 생성)
 	void Initialize(D3D11RHI* InRHI, UINT InTileSize = 16);
 
-	// 타일 컬링 수행 (매 프레임 호출)
+	// 타일 컬링 수행 + GPU 버퍼 업로드 (매 프레임 호출)
 	void CullLights(
 		const TArray<FPointLightInfo>& PointLights,
 		const TArray<FSpotLightInfo>& SpotLights,
@@ -27,9 +31,37 @@ public:
 		UINT ViewportHeight
 	);
 
+	// GPU 업로드 없이 타일 목록만 생성 (Tests/TileLightCullerTests.cpp, RHI 불필요)
+	void BuildTileLightLists(
+		const TArray<FPointLightInfo>& PointLights,
+		const TArray<FSpotLightInfo>& SpotLights,
+		const FMatrix& ViewMatrix,
+		const FMatrix& ProjMatrix,
+		float NearPlane,
+		float FarPlane,
+		UINT ViewportWidth,
+		UINT ViewportHeight
+	);
+
+	// 0 또는 1: 2D 타일, 2 이상: 타일당 깊이 슬라이스 수
+	// 첫 슬라이스는 [근평면, InNearSliceDepth], 나머지는 InNearSliceDepth~원평면을 지수 분할
+	// 클러스터 모드는 뷰 깊이 = 클립 w인 원근 투영을 가정
+	void SetClusterSliceCount(uint32 InSliceCount, float InNearSliceDepth = 5.0f)
+	{
+		NumSlices = InSliceCount > 1 ? InSliceCount : 1;
+		NearSliceDepth = InNearSliceDepth;
+	}
+	uint32 GetClusterSliceCount() const { return NumSlices > 1 ? NumSlices : 0; }
+	// 셰이더 슬라이스 계산: floor(log(뷰 깊이) * Scale + Bias) (마지막 BuildTileLightLists 기준)
+	float GetClusterDepthScale() const { return ClusterDepthScale; }
+	float GetClusterDepthBias() const { return ClusterDepthBias; }
+
 	// 컬링 결과를 Structured Buffer에 업데이트하고 SRV 반환
 	ID3D11ShaderResourceView* GetLightIndexBufferSRV();
 
+	// 압축된 결과 (그리드 + 인덱스, 위 레이아웃)
+	const TArray<uint32>& GetTileLightData() const { return TileLightData; }
+
 	// 통계 정보 반환
 	const FTileCullingStats& GetStats() const { return Stats; }
 
@@ -37,30 +69,50 @@ public:
 	void Release();
 
 private:
-	// 타일 프러스텀 생성 (Conservative near/far 방식)
-	FFrustum CreateTileFrustum(
-		UINT TileX,
-		UINT TileY,
-		const FMatrix& InvViewProj,
-		float NearPlane,
-		float FarPlane
-	);
-
-	// 라이트가 타일 프러스텀과 교차하는지 테스트
-	bool TestPointLightAgainstFrustum(const FPointLightInfo& Light, const FFrustum& Frustum, const FMatrix& ViewMatrix);
-	bool TestSpotLightAgainstFrustum(const FSpotLightInfo& Light, const FFrustum& Frustum, const FMatrix& ViewMatrix);
-
-	// 구체와 프러스텀 교차 테스트
-	bool SphereIntersectsFrustum(const FVector& Center, float Radius, const FFrustum& Frustum);
-
-	// 원뿔과 프러스텀 교차 테스트 (SpotLight용)
-	bool ConeIntersectsFrustum(
-		const FVector& Apex,           // 원뿔 꼭지점 (라이트 위치)
-		const FVector& Direction,      // 원뿔 방향 (정규화됨)
-		float Height,                  // 원뿔 높이 (AttenuationRadius)
-		float CosHalfAngle,            // cos(OuterConeAngle / 2)
-		const FFrustum& Frustum
-	);
+	// Tests/TileLightCullerTests.cpp: SSE/클러스터 목록과 스칼라 판정식 전수 비교
+	friend struct FTileLightCullerTestAccess;
+
+	// 라이트 하나의 화면/뷰 공간 바운드 (라이트당 한 번 계산)
+	struct FLightScreenBounds
+	{
+		float CenterX, CenterY, CenterZ;	// 뷰 공간 바운딩 구 중심
+		float Radius;
+		int32 MinTileX, MinTileY, MaxTileX, MaxTileY;
+		int32 MinSlice, MaxSlice;
+		uint32 PackedIndex;
+		bool bVisible;
+	};
+
+	// 타일 행 하나의 결과 (행끼리 독립적으로 채운 뒤 합침)
+	struct FRowBin
+	{
+		TArray<uint32> TileCounts;		// 행 안 칸(타일 X * 슬라이스 수 + 슬라이스)별 라이트 수
+		TArray<uint32> TileOffsets;		// 행 안 칸별 목록 시작 (SortedIndices 기준)
+		TArray<uint32> EntryCells;		// 통과한 (칸, 라이트) 쌍 - 라이트 순서대로 추가
+		TArray<uint32> EntryIndices;
+		TArray<uint32> SortedIndices;	// 타일 순으로 정렬된 PackedIndex (타일 안에서는 라이트 순서 유지)
+		uint32 MinCount = 0;
+		uint32 MaxCount = 0;
+	};
+
+	// 바운딩 구 → 깊이 범위 검사, 화면 사각형 (투영 행렬로 뷰 공간 AABB 꼭짓점 투영)
+	void ComputeLightBounds(const FVector& ViewCenter, float Radius, uint32 PackedIndex, const FMatrix& ProjMatrix,
+		float NearPlane, float FarPlane, float ViewportWidth, float ViewportHeight, FLightScreenBounds& OutBounds) const;
+
+	// 타일 열/행 경계 평면 (뷰 공간, 안쪽이 양수, 법선 정규화)
+	void BuildTilePlanes(const FMatrix& ProjMatrix, float ViewportWidth, float ViewportHeight);
+	// 슬라이스 경계 깊이와 타일 경계의 x/z, y/z 기울기 (클러스터 AABB용)
+	void BuildClusterSlices(const FMatrix& ProjMatrix, float NearPlane, float FarPlane, float ViewportWidth, float ViewportHeight);
+	int32 GetSliceForDepth(float ViewDepth) const;
+
+	// 빠른 경로와 전수 검사가 같은 산술로 판정하도록 공유
+	bool SphereIntersectsTileRow(const FLightScreenBounds& Light, int32 TileY) const;
+	bool SphereIntersectsTileColumn(const FLightScreenBounds& Light, int32 TileX) const;
+	bool SphereIntersectsClusterBox(const FLightScreenBounds& Light, int32 TileX, int32 TileY, int32 Slice) const;
+
+	void BinRow(int32 TileY, FRowBin& Bin) const;
+
+	void UploadToGPU();
 
 private:
 	D3D11RHI* RHI;
@@ -70,18 +122,33 @@ private:
 	UINT TileCountX;        // 가로 타일 개수
 	UINT TileCountY;        // 세로 타일 개수
 	UINT TotalTileCount;    // 전체 타일 개수
-
-	// 타일당 최대 라이트 개수 (보수적으로 설정)
-	static constexpr UINT MaxLightsPerTile = 256;
-
-	// 타일별 라이트 인덱스 저장
-	// [TileIndex * MaxLightsPerTile] 위치에 라이트 개수 저장
-	// [TileIndex * MaxLightsPerTile + 1 ~ ...] 위치에 라이트 인덱스 저장
-	TArray<uint32> TileLightIndices;
-
-	// GPU 리소스
+	UINT NumSlices;         // 타일당 깊이 슬라이스 (1: 2D 타일)
+	float NearSliceDepth;   // 첫 슬라이스의 끝 깊이
+
+	// 클러스터 깊이 분할
+	float ClusterDepthScale;
+	float ClusterDepthBias;
+	TArray<float> SliceDepths;		// NumSlices + 1개 경계
+	TArray<float> ColumnMinSlope, ColumnMaxSlope;	// 타일 열의 x / z 범위
+	TArray<float> RowMinSlope, RowMaxSlope;			// 타일 행의 y / z 범위
+
+	// 열 평면 SoA (SSE로 4열씩 읽으므로 TileCountX + 3까지 채움)
+	TArray<float> LeftNX, LeftNY, LeftNZ, LeftD;
+	TArray<float> RightNX, RightNY, RightNZ, RightD;
+	// 행 평면 (행마다 스칼라 2개)
+	TArray<FVector4> TopPlanes;
+	TArray<FVector4> BottomPlanes;
+
+	TArray<FLightScreenBounds> LightBounds;
+	TArray<FRowBin> RowBins;
+
+	// 업로드할 압축 데이터 (그리드 + 인덱스)
+	TArray<uint32> TileLightData;
+
+	// GPU 리소스 (부족할 때만 다시 생성)
 	ID3D11Buffer* LightIndexBuffer;
 	ID3D11ShaderResourceView* LightIndexBufferSRV;
+	uint32 LightIndexBufferCapacity;
 
 	// 통계
 	FTileCullingStats Stats;
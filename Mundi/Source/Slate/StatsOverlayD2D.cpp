@@ -7,10 +7,14 @@
 #include "StatsOverlayD2D.h"
 #include "UIManager.h"
 #include "MemoryManager.h"
+#include "AllocationCounter.h"
 #include "Picking.h"
 #include "PlatformTime.h"
 #include "DecalStatManager.h"
 #include "TileCullingStats.h"
+#include "OcclusionStats.h"
+#include "MeshDrawStats.h"
+#include "FrameTimingStats.h"
 #include "LightStats.h"
 #include "ShadowStats.h"
 #include "SkinningStats.h"
@@ -174,39 +178,30 @@ static void DrawTextBlock(
 
 void UStatsOverlayD2D::Draw()
 {
-	if (!bInitialized || (!bShowFPS && !bShowMemory && !bShowPicking && !bShowDecal && !bShowTileCulling && !bShowLights && !bShowShadow && !bShowSkinning) || !SwapChain)
-	{
-		return;
-	}
+	DrawFrame(CaptureFrame());
+}
 
-	if (!D2DContext || !TextFormat)
-	{
-		return;
-	}
+void UStatsOverlayD2D::AddPanel(FStatsOverlayFrame& Frame, const wchar_t* Text, const D2D1_RECT_F& Rect, ID2D1SolidColorBrush* TextBrush)
+{
+	FStatsOverlayPanel& Panel = Frame.Panels.emplace_back();
+	Panel.Text = Text ? Text : L"";
+	Panel.Rect = Rect;
+	Panel.TextBrush = TextBrush;
+}
 
-	IDXGISurface* Surface = nullptr;
-	if (FAILED(SwapChain->GetBuffer(0, __uuidof(IDXGISurface), (void**)&Surface)))
+FStatsOverlayFrame UStatsOverlayD2D::CaptureFrame()
+{
+	FStatsOverlayFrame Frame;
+	if (!bInitialized || (!bShowFPS && !bShowMemory && !bShowAlloc && !bShowPicking && !bShowDecal && !bShowTileCulling && !bShowLights && !bShowShadow && !bShowSkinning && !bShowOcclusion && !bShowDraw && !bShowThreads) || !SwapChain)
 	{
-		return;
+		return Frame;
 	}
 
-	D2D1_BITMAP_PROPERTIES1 BmpProps = {};
-	BmpProps.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
-	BmpProps.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
-	BmpProps.dpiX = 96.0f;
-	BmpProps.dpiY = 96.0f;
-	BmpProps.bitmapOptions = D2D1_BITMAP_OPTIONS_TARGET | D2D1_BITMAP_OPTIONS_CANNOT_DRAW;
-
-	ID2D1Bitmap1* TargetBmp = nullptr;
-	if (FAILED(D2DContext->CreateBitmapFromDxgiSurface(Surface, &BmpProps, &TargetBmp)))
+	if (!D2DContext || !TextFormat)
 	{
-		SafeRelease(Surface);
-		return;
+		return Frame;
 	}
 
-	D2DContext->SetTarget(TargetBmp);
-
-	D2DContext->BeginDraw();
 	const float Margin = 12.0f;
 	const float Space = 8.0f;   // 패널간의 간격
 	const float PanelWidth = 250.0f;
@@ -223,7 +218,7 @@ void UStatsOverlayD2D::Draw()
 		swprintf_s(Buf, L"FPS: %.1f\nFrame time: %.2f ms", Fps, Ms);
 
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + PanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushYellow);
+		AddPanel(Frame, Buf, rc, BrushYellow);
 
 		NextY += PanelHeight + Space;
 	}
@@ -239,7 +234,7 @@ void UStatsOverlayD2D::Draw()
 
 		const float PickPanelHeight = 96.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + PickPanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushSkyBlue);
+		AddPanel(Frame, Buf, rc, BrushSkyBlue);
 
 		NextY += PickPanelHeight + Space;
 	}
@@ -252,11 +247,40 @@ void UStatsOverlayD2D::Draw()
 		swprintf_s(Buf, L"Memory: %.1f MB\nAllocs: %u", Mb, FMemoryManager::TotalAllocationCount);
 
 		D2D1_RECT_F Rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + PanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, Rc, BrushBlack, BrushLightGreen);
+		AddPanel(Frame, Buf, Rc, BrushLightGreen);
 
 		NextY += PanelHeight + Space;
 	}
 
+	if (bShowAlloc)
+	{
+		const FAllocationFrameStats& AllocStats = FAllocationCounter::GetLastFrameStats();
+
+		wchar_t Buf[384];
+		int32 Length = swprintf_s(Buf, L"[Heap Alloc / Frame]\nNew: %u  Delete: %u\nBytes: %.1f KB\nAvg(%d): %.1f (%.1f KB)\nPeak: %u",
+			AllocStats.NumAllocations,
+			AllocStats.NumFrees,
+			AllocStats.AllocatedBytes / 1024.0,
+			FAllocationCounter::AverageFrameCount,
+			AllocStats.AverageAllocations,
+			AllocStats.AverageBytes / 1024.0f,
+			AllocStats.PeakAllocations);
+
+		// ALLOC MARK로 저장한 기준과 비교
+		if (AllocStats.MarkedAverageAllocations >= 0.0f && Length > 0)
+		{
+			swprintf_s(Buf + Length, 384 - Length, L"\nMarked: %.1f -> %+.1f",
+				AllocStats.MarkedAverageAllocations,
+				AllocStats.AverageAllocations - AllocStats.MarkedAverageAllocations);
+		}
+
+		constexpr float AllocPanelHeight = 120.0f;
+		D2D1_RECT_F Rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + AllocPanelHeight);
+		AddPanel(Frame, Buf, Rc, BrushLightGreen);
+
+		NextY += AllocPanelHeight + Space;
+	}
+
 	if (bShowDecal)
 	{
 		// 1. FDecalStatManager로부터 통계 데이터를 가져옵니다.
@@ -280,7 +304,7 @@ void UStatsOverlayD2D::Draw()
 		const float decalPanelHeight = 140.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + decalPanelHeight);
 
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushOrange);
+		AddPanel(Frame, Buf, rc, BrushOrange);
 
 		NextY += decalPanelHeight + Space;
 	}
@@ -290,10 +314,12 @@ void UStatsOverlayD2D::Draw()
 		const FTileCullingStats& TileStats = FTileCullingStatManager::GetInstance().GetStats();
 
 		wchar_t Buf[512];
-		swprintf_s(Buf, L"[Tile Culling Stats]\nTiles: %u x %u (%u)\nLights: %u (P:%u S:%u)\nMin/Avg/Max: %u / %.1f / %u\nCulling Eff: %.1f%%\nBuffer: %u KB",
+		swprintf_s(Buf, L"[Tile Culling Stats]\nTiles: %u x %u (%u)\nSlices: %u (Clusters: %u)\nLights: %u (P:%u S:%u)\nMin/Avg/Max: %u / %.1f / %u\nCulling Eff: %.1f%%\nCPU Cull: %.3f ms\n  Setup/Bin/Pack: %.2f / %.2f / %.2f\nBuffer: %u KB",
 			TileStats.TileCountX,
 			TileStats.TileCountY,
 			TileStats.TotalTileCount,
+			TileStats.ClusterSliceCount,
+			TileStats.TotalClusterCount,
 			TileStats.TotalLights,
 			TileStats.TotalPointLights,
 			TileStats.TotalSpotLights,
@@ -301,11 +327,15 @@ void UStatsOverlayD2D::Draw()
 			TileStats.AvgLightsPerTile,
 			TileStats.MaxLightsPerTile,
 			TileStats.CullingEfficiency,
+			TileStats.CPUCullTimeMS,
+			TileStats.LightSetupTimeMS,
+			TileStats.BinningTimeMS,
+			TileStats.CompactTimeMS,
 			TileStats.LightIndexBufferSizeBytes / 1024);
 
-		const float tilePanelHeight = 160.0f;
+		const float tilePanelHeight = 220.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + tilePanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushCyan);
+		AddPanel(Frame, Buf, rc, BrushCyan);
 
 		NextY += tilePanelHeight + Space;
 	}
@@ -324,7 +354,7 @@ void UStatsOverlayD2D::Draw()
 
 		const float lightPanelHeight = 140.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + lightPanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushViolet);
+		AddPanel(Frame, Buf, rc, BrushViolet);
 
 		NextY += lightPanelHeight + Space;
 	}
@@ -333,8 +363,9 @@ void UStatsOverlayD2D::Draw()
 	{
 		const FShadowStats& ShadowStats = FShadowStatManager::GetInstance().GetStats();
 
-		wchar_t Buf[512];
-		swprintf_s(Buf, L"[Shadow Stats]\nShadow Lights: %u\n  Point: %u\n  Spot: %u\n  Directional: %u\n\nAtlas 2D: %u x %u (%.1f MB)\nAtlas Cube: %u x %u x %u (%.1f MB)\n\nTotal Memory: %.1f MB",
+		wchar_t Buf[1024];
+		swprintf_s(Buf, L"[Shadow Stats]\nShadow Lights: %u\n  Point: %u\n  Spot: %u\n  Directional: %u\n\nAtlas 2D: %u x %u (%.1f MB)\n  Regions: %u (Degraded %u, Dropped %u, Moved %u)\n  Used: %.1f%%, Fragmentation: %.2f\nAtlas Cube: %u x %u x %u (%.1f MB)\n\n"
+			L"Shadow Views: %u\nCasters: %u (Static %u)\nCaster/View: %u / %u\n  Drawn: %u\n  From Cache: %u\nCache Hit/Miss: %u / %u (%.1f%%)\nCache: %u entries (%.1f MB)\n\nTotal Memory: %.1f MB",
 			ShadowStats.TotalShadowCastingLights,
 			ShadowStats.ShadowCastingPointLights,
 			ShadowStats.ShadowCastingSpotLights,
@@ -342,20 +373,38 @@ void UStatsOverlayD2D::Draw()
 			ShadowStats.ShadowAtlas2DSize,
 			ShadowStats.ShadowAtlas2DSize,
 			ShadowStats.ShadowAtlas2DMemoryMB,
+			ShadowStats.AtlasRegions2D,
+			ShadowStats.AtlasDegraded2D,
+			ShadowStats.AtlasDropped2D,
+			ShadowStats.AtlasRelocated2D,
+			ShadowStats.AtlasUsedPercent2D,
+			ShadowStats.AtlasFragmentation2D,
 			ShadowStats.ShadowAtlasCubeSize,
 			ShadowStats.ShadowAtlasCubeSize,
 			ShadowStats.ShadowCubeArrayCount,
 			ShadowStats.ShadowAtlasCubeMemoryMB,
+			ShadowStats.NumShadowViews,
+			ShadowStats.NumShadowCasters,
+			ShadowStats.NumStaticShadowCasters,
+			ShadowStats.NumCasterViewPairsVisible,
+			ShadowStats.NumCasterViewPairsTotal,
+			ShadowStats.NumCastersRendered,
+			ShadowStats.NumCastersFromCache,
+			ShadowStats.CacheHits,
+			ShadowStats.CacheMisses,
+			ShadowStats.CacheHitRate,
+			ShadowStats.NumCacheEntries,
+			ShadowStats.StaticCacheMemoryMB,
 			ShadowStats.TotalShadowMemoryMB);
 
-		const float shadowPanelHeight = 260.0f;
+		const float shadowPanelHeight = 440.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + shadowPanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushDeepPink);
+		AddPanel(Frame, Buf, rc, BrushDeepPink);
 
 		NextY += shadowPanelHeight + Space;
 
 		rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + 40);
-		DrawTextBlock(D2DContext, TextFormat, FScopeCycleCounter::GetTimeProfile("ShadowMapPass").GetConstWChar_tWithKey("ShadowMapPass"), rc, BrushBlack, BrushDeepPink);
+		AddPanel(Frame, FScopeCycleCounter::GetTimeProfile("ShadowMapPass").GetConstWChar_tWithKey("ShadowMapPass"), rc, BrushDeepPink);
 
 		NextY += shadowPanelHeight + Space;
 	}
@@ -395,7 +444,7 @@ void UStatsOverlayD2D::Draw()
 
 		const float SkinningPanelHeight = 180.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth + 50.0f, NextY + SkinningPanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushDeepPink);
+		AddPanel(Frame, Buf, rc, BrushDeepPink);
 		NextY += SkinningPanelHeight + Space;		
 	}
 	
@@ -427,15 +476,132 @@ void UStatsOverlayD2D::Draw()
 
 		constexpr float ParticlePanelHeight = 160.0f;
 		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth + 50.0f, NextY + ParticlePanelHeight);
-		DrawTextBlock(D2DContext, TextFormat, Buf, rc, BrushBlack, BrushCyan);
+		AddPanel(Frame, Buf, rc, BrushCyan);
 		NextY += ParticlePanelHeight + Space;		
 	}
-	D2DContext->EndDraw();
-	D2DContext->SetTarget(nullptr);
+
+	if (bShowOcclusion)
+	{
+		const FOcclusionStats& OcclusionStats = FOcclusionStatManager::GetInstance().GetStats();
+
+		wchar_t Buf[512];
+		swprintf_s(Buf, L"[Occlusion Stats]\nGrid: %u x %u\nOccluders: %u (%u tris)\nRasterized Tris: %u\nCulled: %u / %u (%.1f%%)\n"
+			L"[Times (ms)]\n Setup: %.3f\n Raster: %.3f\n HZB: %.3f\n Test: %.3f",
+			OcclusionStats.GridWidth,
+			OcclusionStats.GridHeight,
+			OcclusionStats.NumOccluders,
+			OcclusionStats.NumOccluderTriangles,
+			OcclusionStats.NumRasterizedTriangles,
+			OcclusionStats.NumOccluded,
+			OcclusionStats.NumTested,
+			OcclusionStats.CulledPercent,
+			OcclusionStats.SetupTimeMS,
+			OcclusionStats.RasterTimeMS,
+			OcclusionStats.HZBTimeMS,
+			OcclusionStats.TestTimeMS);
+
+		constexpr float OcclusionPanelHeight = 200.0f;
+		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + OcclusionPanelHeight);
+		AddPanel(Frame, Buf, rc, BrushLightGreen);
+		NextY += OcclusionPanelHeight + Space;
+	}
+
+	if (bShowDraw)
+	{
+		const FMeshDrawStats& DrawStats = FMeshDrawStatManager::GetInstance().GetStats();
+		const FFrameUploadStats& UploadStats = FMeshDrawStatManager::GetInstance().GetFrameUploadStats();
+
+		wchar_t Buf[768];
+		swprintf_s(Buf, L"[Draw Stats (Opaque)]\nMesh Batches: %u\nDraw Calls: %u (-%.1f%%)\nInstanced Draws: %u\nInstances: %u (max %u)\n"
+			L"[Times (ms)]\n Merge: %.3f\n Upload: %.3f\n"
+			L"[Buffer Uploads (Frame)]\nMap Calls: %u\nConstant Ring: %s\n Uploads: %u, Draws: %u (%.1f KB)",
+			DrawStats.NumBatches,
+			DrawStats.NumDrawCalls,
+			DrawStats.ReductionPercent,
+			DrawStats.NumInstancedDraws,
+			DrawStats.NumInstances,
+			DrawStats.MaxInstancesPerDraw,
+			DrawStats.MergeTimeMS,
+			DrawStats.UploadTimeMS,
+			UploadStats.NumBufferMaps,
+			UploadStats.bObjectConstantRingSupported ? L"Supported" : L"Unsupported",
+			UploadStats.NumObjectConstantUploads,
+			UploadStats.NumObjectConstantDraws,
+			UploadStats.ObjectConstantBytes / 1024.0f);
+
+		constexpr float DrawPanelHeight = 250.0f;
+		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + DrawPanelHeight);
+		AddPanel(Frame, Buf, rc, BrushOrange);
+		NextY += DrawPanelHeight + Space;
+	}
+
+	if (bShowThreads)
+	{
+		const FFrameTimingStats& TimingStats = FFrameTimingStatManager::GetInstance().GetStats();
+
+		wchar_t Buf[512];
+		swprintf_s(Buf, L"[Thread Stats]\nRender Thread: %s\nFrame: %.3f ms\n"
+			L"[Game Thread (ms)]\n Tick: %.3f\n Wait: %.3f\n Render: %.3f\n"
+			L"[Render Thread (ms, frame %llu)]\n Execute+Present: %.3f\n Idle: %.3f\n Overlap: %.1f%%",
+			TimingStats.bRenderThread ? L"On" : L"Off",
+			TimingStats.FrameMS,
+			TimingStats.GameTickMS,
+			TimingStats.GameWaitMS,
+			TimingStats.GameRenderMS,
+			static_cast<unsigned long long>(TimingStats.RenderFrameNumber),
+			TimingStats.RenderThreadMS,
+			TimingStats.RenderIdleMS,
+			TimingStats.OverlapPercent);
+
+		constexpr float ThreadsPanelHeight = 250.0f;
+		D2D1_RECT_F rc = D2D1::RectF(Margin, NextY, Margin + PanelWidth, NextY + ThreadsPanelHeight);
+		AddPanel(Frame, Buf, rc, BrushSkyBlue);
+		NextY += ThreadsPanelHeight + Space;
+	}
 
 	FParticleStatManager::GetInstance().ResetStats();
 	FScopeCycleCounter::TimeProfileInit();
 
+	return Frame;
+}
+
+void UStatsOverlayD2D::DrawFrame(const FStatsOverlayFrame& Frame)
+{
+	if (Frame.Panels.empty() || !bInitialized || !SwapChain || !D2DContext || !TextFormat)
+	{
+		return;
+	}
+
+	IDXGISurface* Surface = nullptr;
+	if (FAILED(SwapChain->GetBuffer(0, __uuidof(IDXGISurface), (void**)&Surface)))
+	{
+		return;
+	}
+
+	D2D1_BITMAP_PROPERTIES1 BmpProps = {};
+	BmpProps.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+	BmpProps.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+	BmpProps.dpiX = 96.0f;
+	BmpProps.dpiY = 96.0f;
+	BmpProps.bitmapOptions = D2D1_BITMAP_OPTIONS_TARGET | D2D1_BITMAP_OPTIONS_CANNOT_DRAW;
+
+	ID2D1Bitmap1* TargetBmp = nullptr;
+	if (FAILED(D2DContext->CreateBitmapFromDxgiSurface(Surface, &BmpProps, &TargetBmp)))
+	{
+		SafeRelease(Surface);
+		return;
+	}
+
+	D2DContext->SetTarget(TargetBmp);
+
+	D2DContext->BeginDraw();
+	for (const FStatsOverlayPanel& Panel : Frame.Panels)
+	{
+		DrawTextBlock(D2DContext, TextFormat, Panel.Text.c_str(), Panel.Rect, BrushBlack, Panel.TextBrush);
+	}
+	D2DContext->EndDraw();
+	D2DContext->SetTarget(nullptr);
+
 	SafeRelease(TargetBmp);
 	SafeRelease(Surface);
 }
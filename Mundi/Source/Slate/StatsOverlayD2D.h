@@ -2,6 +2,20 @@
 #include <d2d1_1.h>
 #include <dwrite.h>
 
+// 오버레이 패널 하나 (배경은 공통 반투명 검정)
+struct FStatsOverlayPanel
+{
+    FWideString Text;
+    D2D1_RECT_F Rect = {};
+    ID2D1SolidColorBrush* TextBrush = nullptr;
+};
+
+// 한 프레임 분량의 오버레이. 게임 스레드에서 통계를 읽어 만들고, 렌더 스레드 모드에서는 렌더 스레드가 그림
+struct FStatsOverlayFrame
+{
+    TArray<FStatsOverlayPanel> Panels;
+};
+
 class UStatsOverlayD2D
 {
 public:
@@ -9,10 +23,16 @@ public:
 
     void Initialize(ID3D11Device* device, ID3D11DeviceContext* context, IDXGISwapChain* swapChain);
 	void Shutdown();
+    // CaptureFrame + DrawFrame (직렬)
     void Draw();
+    // [게임 스레드] 통계를 읽어 패널 문자열을 만들고 프레임 통계(파티클/사이클 카운터)를 초기화
+    FStatsOverlayFrame CaptureFrame();
+    // [즉시 컨텍스트를 쓰는 스레드] 백버퍼에 그림 (D2D가 내부에서 즉시 컨텍스트를 씀)
+    void DrawFrame(const FStatsOverlayFrame& Frame);
 
     void SetShowFPS(bool b) { bShowFPS = b; }
     void SetShowMemory(bool b) { bShowMemory = b; }
+    void SetShowAlloc(bool b) { bShowAlloc = b; }
     void SetShowPicking(bool b)  { bShowPicking = b; }
     void SetShowDecal(bool b)  { bShowDecal = b; }
     void SetShowTileCulling(bool b)  { bShowTileCulling = b; }
@@ -20,8 +40,12 @@ public:
     void SetShowShadow(bool b) { bShowShadow = b; }
     void SetShowSkinning(bool b) { bShowSkinning = b; }
     void SetShowParticle(bool b) { bShowParticle = b; }
+    void SetShowOcclusion(bool b) { bShowOcclusion = b; }
+    void SetShowDraw(bool b) { bShowDraw = b; }
+    void SetShowThreads(bool b) { bShowThreads = b; }
     void ToggleFPS() { bShowFPS = !bShowFPS; }
     void ToggleMemory() { bShowMemory = !bShowMemory; }
+    void ToggleAlloc() { bShowAlloc = !bShowAlloc; }
     void TogglePicking() { bShowPicking = !bShowPicking; }
     void ToggleDecal() { bShowDecal = !bShowDecal; }
     void ToggleTileCulling() { bShowTileCulling = !bShowTileCulling; }
@@ -29,8 +53,12 @@ public:
     void ToggleShadow() { bShowShadow = !bShowShadow; }
     void ToggleSkinning() { bShowSkinning = !bShowSkinning; }
     void ToggleParticle() { bShowParticle = !bShowParticle; }
+    void ToggleOcclusion() { bShowOcclusion = !bShowOcclusion; }
+    void ToggleDraw() { bShowDraw = !bShowDraw; }
+    void ToggleThreads() { bShowThreads = !bShowThreads; }
     bool IsFPSVisible() const { return bShowFPS; }
     bool IsMemoryVisible() const { return bShowMemory; }
+    bool IsAllocVisible() const { return bShowAlloc; }
     bool IsPickingVisible() const { return bShowPicking; }
     bool IsDecalVisible() const { return bShowDecal; }
     bool IsTileCullingVisible() const { return bShowTileCulling; }
@@ -38,6 +66,9 @@ public:
     bool IsShadowVisible() const { return bShowShadow; }
     bool IsSkinningVisible() const { return bShowSkinning; }
     bool IsParticleVisible() const { return bShowParticle; }
+    bool IsOcclusionVisible() const { return bShowOcclusion; }
+    bool IsDrawVisible() const { return bShowDraw; }
+    bool IsThreadsVisible() const { return bShowThreads; }
 
 private:
     UStatsOverlayD2D() = default;
@@ -47,11 +78,13 @@ private:
 
     void EnsureInitialized();
     void ReleaseD2DResources();
+    static void AddPanel(FStatsOverlayFrame& Frame, const wchar_t* Text, const D2D1_RECT_F& Rect, ID2D1SolidColorBrush* TextBrush);
 
 private:
     bool bInitialized = false;
     bool bShowFPS = true;
     bool bShowMemory = false;
+    bool bShowAlloc = false;
     bool bShowPicking = false;
     bool bShowDecal = false;
     bool bShowTileCulling = false;
@@ -59,6 +92,9 @@ private:
     bool bShowLights = false;
     bool bShowSkinning = false;
     bool bShowParticle = false;
+    bool bShowOcclusion = false;
+    bool bShowDraw = false;
+    bool bShowThreads = false;
 
     ID3D11Device* D3DDevice = nullptr;
     ID3D11DeviceContext* D3DContext = nullptr;
@@ -4,6 +4,12 @@
 #include "GlobalConsole.h"
 #include "StatsOverlayD2D.h"
 #include "USlateManager.h"
+#include "StaticMesh.h"
+#include "SkeletalMesh.h"
+#include "MeshOptimizer.h"
+#include "AllocationCounter.h"
+#include "ObjManager.h"
+#include "PlatformTime.h"
 #include <windows.h>
 #include <cstdarg>
 #include <cctype>
@@ -60,12 +66,26 @@ void UConsoleWidget::Initialize()
 	HelpCommandList.Add("STAT");
 	HelpCommandList.Add("STAT FPS");
 	HelpCommandList.Add("STAT MEMORY");
+	HelpCommandList.Add("STAT ALLOC");
 	HelpCommandList.Add("STAT PICKING");
 	HelpCommandList.Add("STAT DECAL");
 	HelpCommandList.Add("STAT ALL");
 	HelpCommandList.Add("STAT NONE");
 	HelpCommandList.Add("STAT LIGHT");
 	HelpCommandList.Add("STAT SHADOW");
+	HelpCommandList.Add("STAT DRAW");
+	HelpCommandList.Add("STAT THREADS");
+	HelpCommandList.Add("MESH STATS");
+	HelpCommandList.Add("MESH LOD AUTO");
+	HelpCommandList.Add("MESH LOD 0");
+	HelpCommandList.Add("MESH INSTANCING ON");
+	HelpCommandList.Add("MESH INSTANCING OFF");
+	HelpCommandList.Add("MESH CONSTANT RING ON");
+	HelpCommandList.Add("MESH CONSTANT RING OFF");
+	HelpCommandList.Add("ALLOC MARK");
+	HelpCommandList.Add("ALLOC CLEAR");
+	HelpCommandList.Add("ASSET STARTUP REPORT");
+	HelpCommandList.Add("ASSET PRELOAD ALL");
 
 	// Add welcome messages
 	AddLog("=== Console Widget Initialized ===");
@@ -337,10 +357,13 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		AddLog("STAT commands:");
 		AddLog("- STAT FPS");
 		AddLog("- STAT MEMORY");
+		AddLog("- STAT ALLOC");
 		AddLog("- STAT PICKING");
 		AddLog("- STAT DECAL");
 		AddLog("- STAT ALL");
 		AddLog("- STAT LIGHT");
+		AddLog("- STAT OCCLUSION");
+		AddLog("- STAT THREADS");
 		AddLog("- STAT NONE");
 	}
 	else if (Stricmp(command_line, "STAT FPS") == 0)
@@ -353,6 +376,17 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		UStatsOverlayD2D::Get().ToggleMemory();
 		AddLog("STAT MEMORY TOGGLED");
 	}
+	else if (Stricmp(command_line, "STAT ALLOC") == 0)
+	{
+		// 패널과 함께 전역 operator new 카운터도 켜고 끔 (꺼져 있으면 세지 않음)
+		UStatsOverlayD2D::Get().ToggleAlloc();
+		FAllocationCounter::SetEnabled(UStatsOverlayD2D::Get().IsAllocVisible());
+		AddLog("STAT ALLOC TOGGLED");
+		if (!FAllocationCounter::IsCompiledIn())
+		{
+			AddLog("STAT ALLOC: operator new is not replaced in this build (USE_ALLOCATION_STATS), counts stay 0");
+		}
+	}
 	else if (Stricmp(command_line, "STAT PICKING") == 0)
 	{
 		UStatsOverlayD2D::Get().TogglePicking();
@@ -368,24 +402,150 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 		UStatsOverlayD2D::Get().ToggleTileCulling();
 		AddLog("STAT LIGHT TOGGLED");
 	}
+	else if (Stricmp(command_line, "STAT OCCLUSION") == 0)
+	{
+		UStatsOverlayD2D::Get().ToggleOcclusion();
+		AddLog("STAT OCCLUSION TOGGLED");
+	}
+	else if (Stricmp(command_line, "STAT DRAW") == 0)
+	{
+		UStatsOverlayD2D::Get().ToggleDraw();
+		AddLog("STAT DRAW TOGGLED");
+	}
+	else if (Stricmp(command_line, "STAT THREADS") == 0)
+	{
+		UStatsOverlayD2D::Get().ToggleThreads();
+		AddLog("STAT THREADS TOGGLED");
+	}
 	else if (Stricmp(command_line, "STAT ALL") == 0)
 	{
 		UStatsOverlayD2D::Get().SetShowFPS(true);
 		UStatsOverlayD2D::Get().SetShowMemory(true);
+		UStatsOverlayD2D::Get().SetShowAlloc(true);
+		FAllocationCounter::SetEnabled(true);
 		UStatsOverlayD2D::Get().SetShowPicking(true);
 		UStatsOverlayD2D::Get().SetShowDecal(true);
 		UStatsOverlayD2D::Get().SetShowTileCulling(true);
+		UStatsOverlayD2D::Get().SetShowOcclusion(true);
+		UStatsOverlayD2D::Get().SetShowDraw(true);
+		UStatsOverlayD2D::Get().SetShowThreads(true);
 		AddLog("STAT: ON");
 	}
 	else if (Stricmp(command_line, "STAT NONE") == 0)
 	{
 		UStatsOverlayD2D::Get().SetShowFPS(false);
 		UStatsOverlayD2D::Get().SetShowMemory(false);
+		UStatsOverlayD2D::Get().SetShowAlloc(false);
+		FAllocationCounter::SetEnabled(false);
 		UStatsOverlayD2D::Get().SetShowPicking(false);
 		UStatsOverlayD2D::Get().SetShowDecal(false);
 		UStatsOverlayD2D::Get().SetShowTileCulling(false);
+		UStatsOverlayD2D::Get().SetShowOcclusion(false);
+		UStatsOverlayD2D::Get().SetShowDraw(false);
+		UStatsOverlayD2D::Get().SetShowThreads(false);
 		AddLog("STAT: OFF");
 	}
+	else if (Stricmp(command_line, "MESH STATS") == 0)
+	{
+		// 로드된 메시의 정점 캐시 효율 (FIFO 16 기준)
+		int32 NumMeshes = 0;
+		for (UStaticMesh* StaticMesh : UResourceManager::GetInstance().GetAll<UStaticMesh>())
+		{
+			const FStaticMesh* Mesh = StaticMesh ? StaticMesh->GetStaticMeshAsset() : nullptr;
+			if (!Mesh || Mesh->Indices.empty())
+			{
+				continue;
+			}
+			const MeshOptimizer::FVertexCacheStats Stats = MeshOptimizer::AnalyzeVertexCache(
+				Mesh->Indices.data(), static_cast<uint32>(Mesh->Indices.size()), static_cast<uint32>(Mesh->Vertices.size()));
+			AddLog("[Static] %s: %u tris, ACMR %.3f, ATVR %.3f", StaticMesh->GetFilePath().c_str(), Stats.NumTriangles, Stats.ACMR, Stats.ATVR);
+			AddMeshLODLog(Mesh->LODs, Stats.NumTriangles);
+			++NumMeshes;
+		}
+		for (USkeletalMesh* SkeletalMesh : UResourceManager::GetInstance().GetAll<USkeletalMesh>())
+		{
+			const FSkeletalMeshData* Mesh = SkeletalMesh ? SkeletalMesh->GetSkeletalMeshData() : nullptr;
+			if (!Mesh || Mesh->Indices.empty())
+			{
+				continue;
+			}
+			const MeshOptimizer::FVertexCacheStats Stats = MeshOptimizer::AnalyzeVertexCache(
+				Mesh->Indices.data(), static_cast<uint32>(Mesh->Indices.size()), static_cast<uint32>(Mesh->Vertices.size()));
+			AddLog("[Skeletal] %s: %u tris, ACMR %.3f, ATVR %.3f", SkeletalMesh->GetFilePath().c_str(), Stats.NumTriangles, Stats.ACMR, Stats.ATVR);
+			AddMeshLODLog(Mesh->LODs, Stats.NumTriangles);
+			++NumMeshes;
+		}
+		AddLog("MESH STATS: %d meshes", NumMeshes);
+	}
+	else if (Stricmp(command_line, "MESH LOD AUTO") == 0)
+	{
+		GWorld->GetRenderSettings().SetForcedLOD(-1);
+		AddLog("MESH LOD: AUTO");
+	}
+	else if (Strnicmp(command_line, "MESH LOD ", 9) == 0 && std::isdigit(static_cast<unsigned char>(command_line[9])))
+	{
+		const int32 ForcedLOD = std::atoi(command_line + 9);
+		GWorld->GetRenderSettings().SetForcedLOD(ForcedLOD);
+		AddLog("MESH LOD: FORCED %d", ForcedLOD);
+	}
+	else if (Stricmp(command_line, "MESH INSTANCING ON") == 0)
+	{
+		GWorld->GetRenderSettings().SetAutoInstancing(true);
+		AddLog("MESH INSTANCING: ON");
+	}
+	else if (Stricmp(command_line, "MESH INSTANCING OFF") == 0)
+	{
+		GWorld->GetRenderSettings().SetAutoInstancing(false);
+		AddLog("MESH INSTANCING: OFF");
+	}
+	else if (Stricmp(command_line, "MESH CONSTANT RING ON") == 0)
+	{
+		GWorld->GetRenderSettings().SetObjectConstantRing(true);
+		AddLog("MESH CONSTANT RING: ON");
+	}
+	else if (Stricmp(command_line, "MESH CONSTANT RING OFF") == 0)
+	{
+		GWorld->GetRenderSettings().SetObjectConstantRing(false);
+		AddLog("MESH CONSTANT RING: OFF");
+	}
+	else if (Stricmp(command_line, "ALLOC MARK") == 0)
+	{
+		// 현재 STAT ALLOC 평균을 기준으로 저장 → 설정을 바꾼 뒤 패널에서 차이 확인
+		if (!FAllocationCounter::IsEnabled())
+		{
+			AddLog("ALLOC MARK: turn on STAT ALLOC first");
+		}
+		else
+		{
+			FAllocationCounter::MarkBaseline();
+			const FAllocationFrameStats& AllocStats = FAllocationCounter::GetLastFrameStats();
+			AddLog("ALLOC MARK: %.1f allocs/frame, %.1f KB/frame", AllocStats.MarkedAverageAllocations, AllocStats.MarkedAverageBytes / 1024.0f);
+		}
+	}
+	else if (Stricmp(command_line, "ALLOC CLEAR") == 0)
+	{
+		FAllocationCounter::ClearBaseline();
+		AddLog("ALLOC CLEAR");
+	}
+	else if (Stricmp(command_line, "ASSET STARTUP REPORT") == 0)
+	{
+		// 레벨이 참조한 에셋만 로드한 상태의 시작 비용. ASSET PRELOAD ALL 후 다시 실행하면 변경 전(Data 전체 로드)과 비교
+		const FAssetStartupReport Report = FAssetRegistry::GetInstance().GetStartupReport();
+		const double MB = 1024.0 * 1024.0;
+		AddLog("ASSET STARTUP REPORT: startup %.1f ms (registry %.1f ms)", Report.StartupMS, Report.RegistryMS);
+		AddLog("    meshes+textures loaded: %d/%d (%.1f%%), %.1f/%.1f MB on disk", Report.NumLoaded, Report.NumAssets,
+			Report.NumAssets > 0 ? 100.0 * Report.NumLoaded / Report.NumAssets : 0.0,
+			static_cast<double>(Report.LoadedBytes) / MB, static_cast<double>(Report.LibraryBytes) / MB);
+		AddLog("    working set %.1f MB (peak %.1f MB), private %.1f MB", static_cast<double>(Report.WorkingSetBytes) / MB,
+			static_cast<double>(Report.PeakWorkingSetBytes) / MB, static_cast<double>(Report.PrivateBytes) / MB);
+	}
+	else if (Stricmp(command_line, "ASSET PRELOAD ALL") == 0)
+	{
+		// 변경 전 시작 경로 (Data 아래 모든 메시/텍스처 로드) 재현
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		FObjManager::Preload();
+		AddLog("ASSET PRELOAD ALL: %.1f ms. Run ASSET STARTUP REPORT to compare memory", FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+	}
 	else
 	{
 		AddLog("Unknown command: '%s'", command_line);
@@ -394,6 +554,17 @@ void UConsoleWidget::ExecCommand(const char* command_line)
 	ScrollToBottom = true;
 }
 
+void UConsoleWidget::AddMeshLODLog(const TArray<FMeshLOD>& LODs, uint32 NumBaseTriangles)
+{
+	// 삼각형 감소율 대비 기하 오차 (바운드 대각선 대비)
+	for (size_t LOD = 0; LOD < LODs.size(); ++LOD)
+	{
+		const uint32 NumTriangles = static_cast<uint32>(LODs[LOD].Indices.size() / 3);
+		AddLog("    LOD%zu: %u tris (%.1f%%), error %.4f%%", LOD + 1, NumTriangles,
+			NumBaseTriangles > 0 ? 100.0f * NumTriangles / NumBaseTriangles : 0.0f, LODs[LOD].RelativeError * 100.0f);
+	}
+}
+
 // Static helper methods
 int UConsoleWidget::Stricmp(const char* s1, const char* s2)
 {
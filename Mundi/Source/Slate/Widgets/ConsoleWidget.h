@@ -46,6 +46,7 @@ private:
 	std::mutex LogMutex;
 
 	// Helper methods
+	void AddMeshLODLog(const TArray<FMeshLOD>& LODs, uint32 NumBaseTriangles);
 	static int TextEditCallbackStub(ImGuiInputTextCallbackData* data);
 	int TextEditCallback(ImGuiInputTextCallbackData* data);
 
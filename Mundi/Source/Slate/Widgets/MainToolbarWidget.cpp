@@ -3,6 +3,7 @@
 #include "ImGui/imgui.h"
 #include "Level.h"
 #include "JsonSerializer.h"
+#include "AssetRegistry.h"
 #include "SelectionManager.h"
 #include "CameraActor.h"
 #include "EditorEngine.h"
@@ -640,6 +641,8 @@ void UMainToolbarWidget::OnLoadScene()
         JSON LevelJsonData;
         if (FJsonSerializer::LoadJsonFromFile(LevelJsonData, SelectedPath))
         {
+            // 레벨이 참조하는 메시/텍스처를 먼저 비동기 요청 (역직렬화 중 Load는 진행 중인 요청에 합류)
+            FAssetRegistry::GetInstance().PrefetchLevelAssets(LevelJsonData);
             NewLevel->Serialize(true, LevelJsonData);
             EditorINI["LastUsedLevel"] = WideToUTF8(fs::relative(SelectedPath));
         }
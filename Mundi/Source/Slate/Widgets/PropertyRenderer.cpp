@@ -341,7 +341,7 @@ void UPropertyRenderer::CacheResources()
 	// 1. 스태틱 메시
 	if (CachedStaticMeshPaths.IsEmpty() && CachedStaticMeshItems.IsEmpty())
 	{
-		CachedStaticMeshPaths = ResMgr.GetAllFilePaths<UStaticMesh>();
+		CachedStaticMeshPaths = ResMgr.GetAllAssetPaths<UStaticMesh>();
 		for (const FString& path : CachedStaticMeshPaths)
 		{
 			// 파일명만 추출해서 표시
@@ -354,7 +354,7 @@ void UPropertyRenderer::CacheResources()
 
 	if (CachedSkeletalMeshPaths.IsEmpty() && CachedSkeletalMeshItems.IsEmpty())
 	{
-		CachedSkeletalMeshPaths = ResMgr.GetAllFilePaths<USkeletalMesh>();
+		CachedSkeletalMeshPaths = ResMgr.GetAllAssetPaths<USkeletalMesh>();
 		for (const FString& path : CachedSkeletalMeshPaths)
 		{
 			// 파일명만 추출해서 표시
@@ -390,7 +390,7 @@ void UPropertyRenderer::CacheResources()
 	// 4. 텍스처
 	if (CachedTexturePaths.IsEmpty() && CachedTextureItems.IsEmpty())
 	{
-		CachedTexturePaths = ResMgr.GetAllFilePaths<UTexture>();
+		CachedTexturePaths = ResMgr.GetAllAssetPaths<UTexture>();
 		CachedTextureItems.Add("None");
 		for (const FString& path : CachedTexturePaths)
 		{
@@ -1748,7 +1748,8 @@ bool UPropertyRenderer::RenderTextureSelectionCombo(const char* Label, UTexture*
 			if (i > 0)
 			{
 				TexturePath = CachedTexturePaths[i - 1];
-				previewTexture = UResourceManager::GetInstance().Load<UTexture>(TexturePath);
+				// 미리보기는 비동기로 요청하고 완료된 것만 표시 (목록을 처음 열 때 전체를 동기 로드하지 않도록)
+				previewTexture = UResourceManager::GetInstance().LoadAsync<UTexture>(TexturePath, EAsyncLoadPriority::Low).Get();
 			}
 
 			FString SelectableID = FString("##Selectable_") + TexturePath + std::to_string(i) + Label; // Label을 추가하여 ID 고유성 보장
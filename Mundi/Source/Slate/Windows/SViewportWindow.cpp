@@ -1413,6 +1413,8 @@ void SViewportWindow::RenderShowFlagDropdownMenu()
 				UStatsOverlayD2D::Get().SetShowLights(false);
 				UStatsOverlayD2D::Get().SetShowShadow(false);
 				UStatsOverlayD2D::Get().SetShowSkinning(false);
+				UStatsOverlayD2D::Get().SetShowOcclusion(false);
+				UStatsOverlayD2D::Get().SetShowDraw(false);
 			}
 
 			if (ImGui::IsItemHovered())
@@ -1522,6 +1524,26 @@ void SViewportWindow::RenderShowFlagDropdownMenu()
 				ImGui::SetTooltip("파티클 통계를 표시합니다.");
 			}
 
+			bool bOcclusionStats = UStatsOverlayD2D::Get().IsOcclusionVisible();
+			if (ImGui::Checkbox(" OCCLUSION", &bOcclusionStats))
+			{
+				UStatsOverlayD2D::Get().ToggleOcclusion();
+			}
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("CPU 오클루전 컬링 통계를 표시합니다. (래스터화 시간, 컬링 비율)");
+			}
+
+			bool bDrawStats = UStatsOverlayD2D::Get().IsDrawVisible();
+			if (ImGui::Checkbox(" DRAW", &bDrawStats))
+			{
+				UStatsOverlayD2D::Get().ToggleDraw();
+			}
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("불투명 패스 드로우 콜 통계를 표시합니다. (자동 인스턴싱으로 줄어든 드로우 수)");
+			}
+
 			ImGui::EndMenu();
 		}
 
@@ -1754,6 +1776,19 @@ void SViewportWindow::RenderShowFlagDropdownMenu()
 			ImGui::SetTooltip("Depth of Field 효과를 적용합니다.");
 		}
 
+		// CPU 오클루전 컬링
+		bool bOcclusionCulling = RenderSettings.IsShowFlagEnabled(EEngineShowFlags::SF_OcclusionCulling);
+		if (ImGui::Checkbox("##OcclusionCulling", &bOcclusionCulling))
+		{
+			RenderSettings.ToggleShowFlag(EEngineShowFlags::SF_OcclusionCulling);
+		}
+		ImGui::SameLine();
+		ImGui::Text(" 오클루전 컬링");
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::SetTooltip("큰 스태틱 메시를 CPU 깊이 버퍼에 그려 가려진 메시를 그리지 않습니다.");
+		}
+
 		// FXAA (Anti-Aliasing)
 		bool bFXAA = RenderSettings.IsShowFlagEnabled(EEngineShowFlags::SF_FXAA);
 		if (ImGui::Checkbox("##FXAA", &bFXAA))
@@ -1799,6 +1834,24 @@ void SViewportWindow::RenderShowFlagDropdownMenu()
 				ImGui::SetTooltip("타일 컬링 결과를 화면에 색상으로 시각화합니다.");
 			}
 
+			// 클러스터 컬링 (타일 x 깊이 슬라이스)
+			bool bClustered = RenderSettings.IsClusteredLightCulling();
+			if (ImGui::Checkbox(" 클러스터 컬링", &bClustered))
+			{
+				RenderSettings.SetClusteredLightCulling(bClustered);
+			}
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("타일을 깊이 방향으로 지수 분할해 라이트를 배정합니다. (원근 투영만, 직교 뷰는 2D 타일)");
+			}
+
+			int ClusterSlices = static_cast<int>(RenderSettings.GetClusterSliceCount());
+			ImGui::SetNextItemWidth(100);
+			if (ImGui::SliderInt(" 깊이 슬라이스", &ClusterSlices, 4, 64))
+			{
+				RenderSettings.SetClusterSliceCount(static_cast<uint32>(ClusterSlices));
+			}
+
 			ImGui::Separator();
 
 			// 타일 크기 입력
@@ -1881,6 +1934,18 @@ void SViewportWindow::RenderShowFlagDropdownMenu()
 				RenderSettings.SetShadowAATechnique(static_cast<EShadowAATechnique>(techniqueInt));
 			}
 
+			ImGui::Separator();
+
+			bool bStaticShadowCaching = RenderSettings.IsStaticShadowCaching();
+			if (ImGui::Checkbox(" 정적 그림자 캐시", &bStaticShadowCaching))
+			{
+				RenderSettings.SetStaticShadowCaching(bStaticShadowCaching);
+			}
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("움직이지 않는 메시의 그림자 깊이를 라이트별로 보관해 재사용합니다. (Spot/Point, VSM에서는 Point만)");
+			}
+
 			ImGui::EndMenu();
 		}
 		if (ImGui::IsItemHovered())
@@ -0,0 +1,187 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "AllocationCounter.h"
+#include "InlineArray.h"
+
+// FAllocationCounter (STAT ALLOC) / TInlineArray 할당 수 검사
+// - AllocationCounter.cpp의 전역 operator new/delete 교체가 이 실행 파일에도 그대로 적용됨
+// - 꺼져 있으면 세지 않음, 정렬 지정 new/delete 짝, 프레임 경계(EndFrame)와 평균/기준(MARK)
+// - TInlineArray는 N개까지 할당 0회, 넘으면 힙으로 한 번 옮김 (TArray와 비교)
+
+namespace
+{
+    struct alignas(64) FAlignedBlock
+    {
+        float Values[16];
+    };
+
+    // new/delete 짝을 컴파일러가 지우지 못하도록 포인터를 밖으로 흘림
+    void* volatile GEscapedPointer = nullptr;
+
+    template<typename T>
+    T* Escape(T* Pointer)
+    {
+        GEscapedPointer = Pointer;
+        return Pointer;
+    }
+
+    // Body 실행 동안의 할당/해제 수
+    template<typename BodyType>
+    TPair<uint64, uint64> CountAllocations(BodyType&& Body)
+    {
+        const uint64 StartAllocations = FAllocationCounter::GetNumAllocations();
+        const uint64 StartFrees = FAllocationCounter::GetNumFrees();
+        Body();
+        return { FAllocationCounter::GetNumAllocations() - StartAllocations, FAllocationCounter::GetNumFrees() - StartFrees };
+    }
+
+    void TestDisabledDoesNotCount()
+    {
+        FAllocationCounter::SetEnabled(false);
+        const TPair<uint64, uint64> Counts = CountAllocations([]
+        {
+            TArray<int32> Values;
+            for (int32 Index = 0; Index < 100; ++Index)
+            {
+                Values.Add(Index);
+            }
+        });
+        TEST_CHECK(Counts.first == 0 && Counts.second == 0);
+    }
+
+    void TestOperatorNewVariants()
+    {
+        FAllocationCounter::SetEnabled(true);
+
+        const uint64 StartBytes = FAllocationCounter::GetNumBytes();
+        TPair<uint64, uint64> Counts = CountAllocations([]
+        {
+            int32* Single = Escape(new int32(7));
+            int32* Many = Escape(new int32[100]);
+            delete Single;
+            delete[] Many;
+        });
+        TEST_CHECK(Counts.first == 2 && Counts.second == 2);
+        TEST_CHECK(FAllocationCounter::GetNumBytes() - StartBytes == sizeof(int32) * 101);
+
+        // 정렬 지정 new는 정렬 지정 delete로 (짝이 안 맞으면 Windows에서 힙 손상)
+        Counts = CountAllocations([]
+        {
+            FAlignedBlock* Block = Escape(new FAlignedBlock());
+            TEST_CHECK(reinterpret_cast<uintptr_t>(Block) % alignof(FAlignedBlock) == 0);
+            delete Block;
+
+            std::vector<FAlignedBlock> Blocks(3);
+            TEST_CHECK(reinterpret_cast<uintptr_t>(Blocks.data()) % alignof(FAlignedBlock) == 0);
+        });
+        TEST_CHECK(Counts.first == 2 && Counts.second == 2);
+
+        Counts = CountAllocations([]
+        {
+            int32* Value = Escape(new (std::nothrow) int32(1));
+            delete Value;
+            delete static_cast<int32*>(nullptr);
+        });
+        TEST_CHECK(Counts.first == 1 && Counts.second == 1);
+    }
+
+    void TestInlineArrayAllocations()
+    {
+        FAllocationCounter::SetEnabled(true);
+
+        // 변경 전 BVH 순회 스택과 같은 TArray: 처음 몇 번의 push에서 재할당
+        TPair<uint64, uint64> Counts = CountAllocations([]
+        {
+            TArray<int32> Stack;
+            for (int32 Index = 0; Index < 8; ++Index)
+            {
+                Stack.push_back(Index);
+            }
+        });
+        TEST_CHECK(Counts.first >= 1 && Counts.first == Counts.second);
+
+        Counts = CountAllocations([]
+        {
+            TInlineArray<int32, 8> Stack;
+            for (int32 Index = 0; Index < 8; ++Index)
+            {
+                Stack.push_back(Index);
+            }
+            TEST_CHECK(Stack.Num() == 8 && Stack.back() == 7);
+        });
+        TEST_CHECK(Counts.first == 0 && Counts.second == 0);
+
+        // N을 넘으면 힙으로 한 번 옮기고, 2배씩 늘려 16개까지는 추가 할당 없음
+        Counts = CountAllocations([]
+        {
+            TInlineArray<int32, 8> Stack;
+            for (int32 Index = 0; Index < 16; ++Index)
+            {
+                Stack.push_back(Index);
+            }
+            for (int32 Index = 0; Index < 16; ++Index)
+            {
+                TEST_CHECK(Stack[Index] == Index);
+            }
+        });
+        TEST_CHECK(Counts.first == 1 && Counts.second == 1);
+    }
+
+    void TestFrameStats()
+    {
+        std::vector<int32*> Live;
+        Live.reserve(1000);
+
+        // 다시 켜면 꺼져 있던 동안의 할당이 첫 프레임에 섞이지 않음
+        FAllocationCounter::SetEnabled(false);
+        delete Escape(new int32(0));
+        FAllocationCounter::SetEnabled(true);
+
+        auto AllocateFrame = [&Live](int32 Count)
+        {
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                Live.push_back(Escape(new int32(Index)));
+            }
+        };
+
+        AllocateFrame(10);
+        FAllocationCounter::EndFrame(1);
+        TEST_CHECK(FAllocationCounter::GetLastFrameStats().NumAllocations == 10);
+        TEST_CHECK(FAllocationCounter::GetLastFrameStats().AllocatedBytes == 10 * sizeof(int32));
+
+        AllocateFrame(30);
+        FAllocationCounter::EndFrame(2);
+        const FAllocationFrameStats& Stats = FAllocationCounter::GetLastFrameStats();
+        TEST_CHECK(Stats.FrameNumber == 2 && Stats.NumAllocations == 30);
+        TEST_CHECK(Stats.AverageAllocations == 20.0f && Stats.PeakAllocations == 30);
+        TEST_CHECK(Stats.MarkedAverageAllocations < 0.0f);
+
+        // 기준 저장 후 할당이 줄어든 프레임
+        FAllocationCounter::MarkBaseline();
+        FAllocationCounter::EndFrame(3);
+        TEST_CHECK(FAllocationCounter::GetLastFrameStats().NumAllocations == 0);
+        TEST_CHECK(FAllocationCounter::GetLastFrameStats().MarkedAverageAllocations == 20.0f);
+        TEST_CHECK(FAllocationCounter::GetLastFrameStats().AverageAllocations < 20.0f);
+
+        for (int32* Value : Live)
+        {
+            delete Value;
+        }
+        FAllocationCounter::EndFrame(4);
+        TEST_CHECK(FAllocationCounter::GetLastFrameStats().NumFrees == 40);
+
+        FAllocationCounter::ClearBaseline();
+        TEST_CHECK(FAllocationCounter::GetLastFrameStats().MarkedAverageAllocations < 0.0f);
+        FAllocationCounter::SetEnabled(false);
+    }
+}
+
+int main()
+{
+    TestDisabledDoesNotCount();
+    TestOperatorNewVariants();
+    TestInlineArrayAllocations();
+    TestFrameStats();
+    return MundiTest::Finish("AllocationCounterTests");
+}
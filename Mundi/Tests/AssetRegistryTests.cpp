@@ -0,0 +1,306 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "AssetRegistry.h"
+#include "ResourceManager.h"
+#include "JsonSerializer.h"
+
+// FAssetRegistry (레벨 참조 기반 온디맨드 로드) 검사
+// - 임시 폴더에 Data/를 만들고 작업 디렉토리를 옮겨 실행 (GDataDir/GCacheDir는 엔진과 같은 상대 경로)
+// - UResourceManager는 Shim/ResourceManager.h 대역: LoadAsync 요청만 기록
+// - 레벨 JSON이 참조한 에셋 + 의존성(.obj → .mtl → 텍스처)이 정확히 로드 대상이 되고 나머지는 요청되지 않음
+// - 매니페스트 증분 갱신: .mtl이 바뀌면 그 .obj를 다시 스캔, 삭제된 파일은 빠짐
+// - --bench: 변경 전(Data 아래 메시/텍스처 전체 읽기)과 현재(레지스트리 갱신 + 레벨이 쓰는 것만 읽기)의 시간/상주 바이트
+
+const FString GDataDir = "Data";
+const FString GCacheDir = "DerivedDataCache";
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    FAssetRegistry& Registry = FAssetRegistry::GetInstance();
+
+    void WriteFile(const fs::path& Path, const std::string& Contents)
+    {
+        fs::create_directories(Path.parent_path());
+        std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+        File << Contents;
+    }
+
+    /** 테스트마다 빈 작업 디렉토리 (끝나면 원래 디렉토리로 돌아가고 지움) */
+    class FScopedWorkingDirectory
+    {
+    public:
+        explicit FScopedWorkingDirectory(const char* Name)
+            : Previous(fs::current_path())
+            , Root(fs::temp_directory_path() / Name)
+        {
+            std::error_code Ec;
+            fs::remove_all(Root, Ec);
+            fs::create_directories(Root);
+            fs::current_path(Root);
+        }
+
+        ~FScopedWorkingDirectory()
+        {
+            std::error_code Ec;
+            fs::current_path(Previous, Ec);
+            fs::remove_all(Root, Ec);
+        }
+
+    private:
+        fs::path Previous;
+        fs::path Root;
+    };
+
+    /**
+     * Data/
+     *   Model/Chair/chair.obj  → chair.mtl → chair_d.png (map_Kd), chair_n.png (map_Bump)
+     *   Model/Table/table.obj  (mtl 없음)
+     *   Model/Unused/unused.obj → unused.mtl → unused_d.png
+     *   Model/Hero/hero.fbx
+     *   Textures/sky.dds, Textures/unused.png
+     *   Audio/wind.wav, readme.txt (레지스트리 대상 아님)
+     */
+    void WriteSampleLibrary()
+    {
+        WriteFile("Data/Model/Chair/chair.obj", "mtllib chair.mtl\nv 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+        WriteFile("Data/Model/Chair/chair.mtl", "newmtl Wood\nmap_Kd chair_d.png\nmap_Bump -bm 1.0 chair_n.png\n");
+        WriteFile("Data/Model/Chair/chair_d.png", std::string(64, 'd'));
+        WriteFile("Data/Model/Chair/chair_n.png", std::string(64, 'n'));
+        WriteFile("Data/Model/Table/table.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+        WriteFile("Data/Model/Unused/unused.obj", "mtllib unused.mtl\nf 1 2 3\n");
+        WriteFile("Data/Model/Unused/unused.mtl", "newmtl Unused\nmap_Kd unused_d.png\n");
+        WriteFile("Data/Model/Unused/unused_d.png", std::string(32, 'u'));
+        WriteFile("Data/Model/Hero/hero.fbx", std::string(16, 'f'));
+        WriteFile("Data/Textures/sky.dds", std::string(128, 's'));
+        WriteFile("Data/Textures/unused.png", std::string(32, 'x'));
+        WriteFile("Data/Audio/wind.wav", std::string(16, 'w'));
+        WriteFile("Data/readme.txt", "not an asset");
+    }
+
+    /** 에디터가 저장하는 레벨처럼 경로가 속성 값으로 흩어진 JSON (역슬래시 경로, 경로가 아닌 문자열 포함) */
+    JSON MakeLevelJson()
+    {
+        JSON Chair = JSON::Make(JSON::Class::Object);
+        Chair["Name"] = "Chair_0";
+        Chair["StaticMesh"] = "Data\\Model\\Chair\\chair.obj";
+
+        JSON Sky = JSON::Make(JSON::Class::Object);
+        Sky["Name"] = "SkySphere";
+        Sky["Texture"] = "Data/Textures/sky.dds";
+
+        JSON Wind = JSON::Make(JSON::Class::Object);
+        Wind["Sound"] = "Data/Audio/wind.wav";
+        Wind["Missing"] = "Data/Model/Missing/missing.obj";
+
+        JSON Actors = JSON::Make(JSON::Class::Array);
+        Actors.append(Chair);
+        Actors.append(Sky);
+        Actors.append(Wind);
+
+        JSON Level = JSON::Make(JSON::Class::Object);
+        Level["Version"] = 2;
+        Level["Actors"] = Actors;
+        return Level;
+    }
+
+    const UResourceManager::FRequest* FindRequest(const FString& Path)
+    {
+        for (const UResourceManager::FRequest& Request : RESOURCE.Requests)
+        {
+            if (Request.Path == Path)
+            {
+                return &Request;
+            }
+        }
+        return nullptr;
+    }
+
+    // ──────────────────────────────────────────────
+    // 검사
+    // ──────────────────────────────────────────────
+
+    void TestLevelReferencesResolveToLoadSet()
+    {
+        FScopedWorkingDirectory WorkingDirectory("MundiAssetRegistryTest");
+        WriteSampleLibrary();
+        RESOURCE.Reset();
+        Registry.Initialize();
+
+        // .mtl 포함, readme.txt 제외
+        TEST_CHECK(Registry.Num() == 12);
+        TEST_CHECK(Registry.Find("Data/readme.txt") == nullptr);
+        TEST_CHECK(fs::exists("DerivedDataCache/AssetRegistry.json"));
+
+        const FAssetData* Chair = Registry.Find("Data\\Model\\Chair\\chair.obj");
+        TEST_CHECK(Chair && Chair->Type == EResourceType::StaticMesh);
+        TEST_CHECK(Chair && Chair->Dependencies == TArray<FString>({ "Data/Model/Chair/chair.mtl", "Data/Model/Chair/chair_d.png", "Data/Model/Chair/chair_n.png" }));
+        TEST_CHECK(Chair && Chair->LinearTextures == TArray<FString>({ "Data/Model/Chair/chair_n.png" }));
+
+        // 스태틱 메시 목록에는 .fbx도 포함 (정렬됨)
+        TEST_CHECK(Registry.GetAssetPaths(EResourceType::StaticMesh) == TArray<FString>({
+            "Data/Model/Chair/chair.obj", "Data/Model/Hero/hero.fbx", "Data/Model/Table/table.obj", "Data/Model/Unused/unused.obj" }));
+
+        // 레벨이 참조한 것 + 의존성만, 의존성이 먼저
+        const JSON Level = MakeLevelJson();
+        TArray<FString> LevelAssets;
+        Registry.CollectLevelAssets(Level, LevelAssets);
+        TEST_CHECK(LevelAssets == TArray<FString>({
+            "Data/Model/Chair/chair.mtl", "Data/Model/Chair/chair_d.png", "Data/Model/Chair/chair_n.png",
+            "Data/Model/Chair/chair.obj", "Data/Textures/sky.dds", "Data/Audio/wind.wav" }));
+
+        // 프리페치는 워커 단계가 있는 메시/텍스처만. 직접 참조는 High, 의존성은 Normal, 노멀맵은 linear
+        TEST_CHECK(Registry.PrefetchLevelAssets(Level) == 4);
+        TEST_CHECK(RESOURCE.Requests.Num() == 4);
+        const UResourceManager::FRequest* MeshRequest = FindRequest("Data/Model/Chair/chair.obj");
+        const UResourceManager::FRequest* DiffuseRequest = FindRequest("Data/Model/Chair/chair_d.png");
+        const UResourceManager::FRequest* NormalRequest = FindRequest("Data/Model/Chair/chair_n.png");
+        const UResourceManager::FRequest* SkyRequest = FindRequest("Data/Textures/sky.dds");
+        TEST_CHECK(MeshRequest && !MeshRequest->bTexture && MeshRequest->Priority == EAsyncLoadPriority::High);
+        TEST_CHECK(DiffuseRequest && DiffuseRequest->bTexture && DiffuseRequest->Priority == EAsyncLoadPriority::Normal && DiffuseRequest->bSRGB);
+        TEST_CHECK(NormalRequest && NormalRequest->bTexture && NormalRequest->Priority == EAsyncLoadPriority::Normal && !NormalRequest->bSRGB);
+        TEST_CHECK(SkyRequest && SkyRequest->bTexture && SkyRequest->Priority == EAsyncLoadPriority::High && SkyRequest->bSRGB);
+        TEST_CHECK(!FindRequest("Data/Model/Unused/unused.obj") && !FindRequest("Data/Textures/unused.png"));
+
+        // 시작 보고: 메시(.obj)/텍스처만 세고, 로드된 것의 원본 크기 합
+        RESOURCE.MarkLoaded("Data/Model/Chair/chair.obj");
+        RESOURCE.MarkLoaded("Data/Textures/sky.dds");
+        const FAssetStartupReport Report = Registry.GetStartupReport();
+        TEST_CHECK(Report.NumAssets == 8);
+        TEST_CHECK(Report.NumLoaded == 2);
+        TEST_CHECK(Report.LoadedBytes == Registry.Find("Data/Model/Chair/chair.obj")->Size + 128);
+
+        // 프리페치를 끄면 요청 없음
+        RESOURCE.Reset();
+        Registry.SetPrefetchEnabled(false);
+        TEST_CHECK(Registry.PrefetchLevelAssets(Level) == 0 && RESOURCE.Requests.IsEmpty());
+        Registry.SetPrefetchEnabled(true);
+    }
+
+    void TestIncrementalRefresh()
+    {
+        FScopedWorkingDirectory WorkingDirectory("MundiAssetRegistryRefreshTest");
+        WriteSampleLibrary();
+        Registry.Initialize();
+
+        // .mtl만 바뀌어도 .obj 의존성이 갱신됨 (크기가 달라 변경으로 감지)
+        WriteFile("Data/Model/Chair/chair_d2.png", std::string(64, 'e'));
+        WriteFile("Data/Model/Chair/chair.mtl", "newmtl Wood\nmap_Kd chair_d2.png\n");
+        fs::remove("Data/Model/Table/table.obj");
+        Registry.Initialize();
+
+        const FAssetData* Chair = Registry.Find("Data/Model/Chair/chair.obj");
+        TEST_CHECK(Chair && Chair->Dependencies == TArray<FString>({ "Data/Model/Chair/chair.mtl", "Data/Model/Chair/chair_d2.png" }));
+        TEST_CHECK(Chair && Chair->LinearTextures.IsEmpty());
+        TEST_CHECK(Registry.Find("Data/Model/Table/table.obj") == nullptr);
+
+        // 매니페스트를 다시 읽어도 같은 의존성 (파일이 그대로면 재스캔 없이 매니페스트 값 사용)
+        Registry.Initialize();
+        Chair = Registry.Find("Data/Model/Chair/chair.obj");
+        TEST_CHECK(Chair && Chair->Dependencies.Num() == 2);
+
+        TArray<FString> LevelAssets;
+        Registry.CollectLevelAssets(MakeLevelJson(), LevelAssets);
+        TEST_CHECK(LevelAssets.Contains("Data/Model/Chair/chair_d2.png"));
+        TEST_CHECK(!LevelAssets.Contains("Data/Model/Chair/chair_d.png"));
+    }
+
+    // ──────────────────────────────────────────────
+    // 벤치마크
+    // ──────────────────────────────────────────────
+
+    uint64 ReadWholeFile(const FString& Path, TArray<TArray<uint8>>& Resident)
+    {
+        std::ifstream File(Path, std::ios::binary | std::ios::ate);
+        TArray<uint8>& Bytes = Resident.emplace_back(static_cast<size_t>(File.tellg()));
+        File.seekg(0);
+        File.read(reinterpret_cast<char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+        return Bytes.size();
+    }
+
+    void RunStartupBenchmark()
+    {
+        FScopedWorkingDirectory WorkingDirectory("MundiAssetRegistryBench");
+
+        // 메시 400개 (각 .obj 48KB + .mtl + 텍스처 2장 128KB), 레벨은 그중 12개만 씀
+        const int32 NumMeshes = 400;
+        const int32 NumLevelMeshes = 12;
+        JSON Actors = JSON::Make(JSON::Class::Array);
+        for (int32 Index = 0; Index < NumMeshes; ++Index)
+        {
+            const std::string Name = "mesh" + std::to_string(Index);
+            const fs::path Dir = fs::path("Data/Model") / Name;
+            WriteFile(Dir / (Name + ".obj"), "mtllib " + Name + ".mtl\n" + std::string(48 * 1024, 'v'));
+            WriteFile(Dir / (Name + ".mtl"), "newmtl M\nmap_Kd " + Name + "_d.png\nmap_Bump " + Name + "_n.png\n");
+            WriteFile(Dir / (Name + "_d.png"), std::string(128 * 1024, 'd'));
+            WriteFile(Dir / (Name + "_n.png"), std::string(128 * 1024, 'n'));
+            if (Index < NumLevelMeshes)
+            {
+                JSON Actor = JSON::Make(JSON::Class::Object);
+                Actor["StaticMesh"] = (Dir / (Name + ".obj")).string();
+                Actors.append(Actor);
+            }
+        }
+        JSON Level = JSON::Make(JSON::Class::Object);
+        Level["Actors"] = Actors;
+
+        // 1. 변경 전: 시작할 때 Data 아래 메시/텍스처를 모두 읽음
+        TArray<TArray<uint8>> PreloadResident;
+        uint64 PreloadBytes = 0;
+        MundiTest::FTimer PreloadTimer;
+        for (const fs::directory_entry& Entry : fs::recursive_directory_iterator("Data"))
+        {
+            const FString Extension = Entry.path().extension().string();
+            if (Extension == ".obj" || Extension == ".png")
+            {
+                PreloadBytes += ReadWholeFile(Entry.path().string(), PreloadResident);
+            }
+        }
+        const double PreloadMS = PreloadTimer.ElapsedMS();
+        PreloadResident.clear();
+
+        // 2. 현재: 레지스트리 갱신 (매니페스트 없음 / 있음) + 레벨이 쓰는 에셋만 읽음
+        MundiTest::FTimer ColdTimer;
+        Registry.Initialize();
+        const double ColdRegistryMS = ColdTimer.ElapsedMS();
+
+        MundiTest::FTimer WarmTimer;
+        Registry.Initialize();
+        const double WarmRegistryMS = WarmTimer.ElapsedMS();
+
+        TArray<TArray<uint8>> OnDemandResident;
+        uint64 OnDemandBytes = 0;
+        MundiTest::FTimer OnDemandTimer;
+        TArray<FString> LevelAssets;
+        Registry.CollectLevelAssets(Level, LevelAssets);
+        for (const FString& Path : LevelAssets)
+        {
+            if (Registry.Find(Path)->Type != EResourceType::None)
+            {
+                OnDemandBytes += ReadWholeFile(Path, OnDemandResident);
+            }
+        }
+        const double OnDemandMS = OnDemandTimer.ElapsedMS();
+
+        const double MB = 1024.0 * 1024.0;
+        std::printf("[Asset Startup Bench] %d meshes (+2 textures each), level uses %d\n", NumMeshes, NumLevelMeshes);
+        std::printf("  before: preload all       : %8.2f ms, %7.1f MB resident\n", PreloadMS, PreloadBytes / MB);
+        std::printf("  after: registry cold scan : %8.2f ms\n", ColdRegistryMS);
+        std::printf("  after: registry manifest  : %8.2f ms\n", WarmRegistryMS);
+        std::printf("  after: level assets       : %8.2f ms, %7.1f MB resident (%d files)\n", OnDemandMS, OnDemandBytes / MB, OnDemandResident.Num());
+        TEST_CHECK(OnDemandResident.Num() == NumLevelMeshes * 3);
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestLevelReferencesResolveToLoadSet();
+    TestIncrementalRefresh();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunStartupBenchmark();
+    }
+    return MundiTest::Finish("AssetRegistryTests");
+}
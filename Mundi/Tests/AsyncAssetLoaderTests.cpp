@@ -0,0 +1,513 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "AsyncAssetLoader.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <atomic>
+#include <thread>
+
+// FAsyncAssetLoader (UResourceManager::LoadAsync) 검사
+// - 텍스처 대역(FStubTexture): 워커 Payload에서 파일 읽기 + 디코딩(RLE 풀기 + 밉 체인), 게임 스레드 Finalize는 업로드 복사만
+//   실제 UTexture는 DirectXTex/D3D11이 필요해 리눅스에서 빌드하지 않음. 두 단계의 분리와 스케줄링만 같은 방식으로 검사
+// - Payload는 워커, Finalize/콜백은 게임 스레드. 결과가 직렬 로드와 같음
+// - 같은 경로 요청 합치기, 우선순위 순 Finalize, 시간 예산(최소 1개), 실패 전달, Wait/Flush, CancelAll
+// - --bench: 변경 전(게임 스레드에서 읽기 + 디코딩 + 업로드)과 현재(워커 디코딩 + 게임 스레드 업로드)의 게임 스레드 시간
+
+// 로더는 포인터만 다룸. 엔진의 UResourceBase(UObject) 대신 테스트용 리소스 기반 클래스
+class UResourceBase
+{
+public:
+    virtual ~UResourceBase() = default;
+};
+
+namespace
+{
+    FTaskGraph& TaskGraph = FTaskGraph::GetInstance();
+
+    // ──────────────────────────────────────────────
+    // 텍스처 대역
+    // ──────────────────────────────────────────────
+
+    constexpr uint32 StubTextureMagic = 0x58455453; // 'STEX'
+
+    struct FStubTextureHeader
+    {
+        uint32 Magic = StubTextureMagic;
+        uint32 Width = 0;
+        uint32 Height = 0;
+        uint32 NumRuns = 0;
+    };
+
+    struct FStubTextureRun
+    {
+        uint32 Count;
+        uint32 Color;
+    };
+
+    /** 가로 줄무늬 + 잡음 (런 길이가 짧아 디코딩 비용이 픽셀 수에 비례) */
+    void WriteStubTexture(const FString& Path, uint32 Width, uint32 Height, uint32 Seed)
+    {
+        TArray<FStubTextureRun> Runs;
+        uint32 State = Seed * 747796405u + 2891336453u;
+        uint32 Remaining = Width * Height;
+        while (Remaining > 0)
+        {
+            State = State * 1664525u + 1013904223u;
+            const uint32 Count = std::min<uint32>(Remaining, 1 + ((State >> 24) & 15));
+            Runs.Add({ Count, State | 0xFF000000u });
+            Remaining -= Count;
+        }
+
+        FStubTextureHeader Header;
+        Header.Width = Width;
+        Header.Height = Height;
+        Header.NumRuns = static_cast<uint32>(Runs.size());
+        std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+        File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+        File.write(reinterpret_cast<const char*>(Runs.data()), static_cast<std::streamsize>(sizeof(FStubTextureRun) * Runs.size()));
+    }
+
+    /** 디코딩 결과: RGBA8 밉 체인 (DirectX::ScratchImage 역할) */
+    struct FDecodedImage
+    {
+        uint32 Width = 0;
+        uint32 Height = 0;
+        TArray<TArray<uint32>> Mips;
+    };
+
+    uint32 AverageColor(uint32 A, uint32 B, uint32 C, uint32 D)
+    {
+        uint32 Result = 0;
+        for (uint32 Shift = 0; Shift < 32; Shift += 8)
+        {
+            const uint32 Sum = ((A >> Shift) & 0xFF) + ((B >> Shift) & 0xFF) + ((C >> Shift) & 0xFF) + ((D >> Shift) & 0xFF);
+            Result |= ((Sum + 2) / 4) << Shift;
+        }
+        return Result;
+    }
+
+    bool DecodeStubTexture(const FString& Path, FDecodedImage& OutImage)
+    {
+        std::ifstream File(Path, std::ios::binary);
+        FStubTextureHeader Header;
+        if (!File.read(reinterpret_cast<char*>(&Header), sizeof(Header)) || Header.Magic != StubTextureMagic)
+        {
+            return false;
+        }
+        TArray<FStubTextureRun> Runs(Header.NumRuns);
+        if (!File.read(reinterpret_cast<char*>(Runs.data()), static_cast<std::streamsize>(sizeof(FStubTextureRun) * Runs.size())))
+        {
+            return false;
+        }
+
+        OutImage.Width = Header.Width;
+        OutImage.Height = Header.Height;
+        OutImage.Mips.clear();
+        TArray<uint32>& Mip0 = OutImage.Mips.emplace_back();
+        Mip0.reserve(static_cast<size_t>(Header.Width) * Header.Height);
+        for (const FStubTextureRun& Run : Runs)
+        {
+            Mip0.insert(Mip0.end(), Run.Count, Run.Color);
+        }
+        if (Mip0.size() != static_cast<size_t>(Header.Width) * Header.Height)
+        {
+            return false;
+        }
+
+        // 2x2 박스 필터 밉 체인
+        uint32 Width = Header.Width;
+        uint32 Height = Header.Height;
+        while (Width > 1 && Height > 1)
+        {
+            const TArray<uint32>& Source = OutImage.Mips.back();
+            TArray<uint32> Mip((Width / 2) * (Height / 2));
+            for (uint32 Y = 0; Y < Height / 2; ++Y)
+            {
+                for (uint32 X = 0; X < Width / 2; ++X)
+                {
+                    const uint32* Row0 = &Source[(2 * Y) * Width + 2 * X];
+                    const uint32* Row1 = Row0 + Width;
+                    Mip[Y * (Width / 2) + X] = AverageColor(Row0[0], Row0[1], Row1[0], Row1[1]);
+                }
+            }
+            OutImage.Mips.push_back(std::move(Mip));
+            Width /= 2;
+            Height /= 2;
+        }
+        return true;
+    }
+
+    /** UTexture 대역: LoadAsyncPayload/FinalizeAsyncLoad와 같은 두 단계 */
+    class FStubTexture : public UResourceBase
+    {
+    public:
+        bool LoadAsyncPayload(const FString& InFilePath)
+        {
+            PayloadThread = std::this_thread::get_id();
+            return DecodeStubTexture(InFilePath, PendingImage);
+        }
+
+        /** CreateTextureEx 대역: 디코딩된 밉을 "GPU 메모리"로 복사하고 디코딩 결과는 버림 */
+        bool FinalizeAsyncLoad()
+        {
+            FinalizeThread = std::this_thread::get_id();
+            if (PendingImage.Mips.empty())
+            {
+                return false;
+            }
+            GpuMemory.clear();
+            for (const TArray<uint32>& Mip : PendingImage.Mips)
+            {
+                GpuMemory.insert(GpuMemory.end(), Mip.begin(), Mip.end());
+            }
+            Width = PendingImage.Width;
+            Height = PendingImage.Height;
+            NumMips = static_cast<uint32>(PendingImage.Mips.size());
+            PendingImage = FDecodedImage();
+            return true;
+        }
+
+        uint64 Checksum() const
+        {
+            uint64 Hash = 1469598103934665603ull;
+            for (uint32 Texel : GpuMemory)
+            {
+                Hash = (Hash ^ Texel) * 1099511628211ull;
+            }
+            return Hash;
+        }
+
+        uint32 Width = 0;
+        uint32 Height = 0;
+        uint32 NumMips = 0;
+        TArray<uint32> GpuMemory;
+        std::thread::id PayloadThread;
+        std::thread::id FinalizeThread;
+
+    private:
+        FDecodedImage PendingImage;
+    };
+
+    FString TempTexturePath(int32 Index)
+    {
+        std::error_code Ec;
+        return (std::filesystem::temp_directory_path(Ec) / ("MundiAsyncLoadTest" + std::to_string(Index) + ".stex")).string();
+    }
+
+    /** UResourceManager::LoadAsync가 텍스처에 만드는 요청과 같은 모양 (Finalize 실패 시 객체 삭제) */
+    std::shared_ptr<FAsyncLoadRequest> MakeTextureRequest(const FString& Path, EAsyncLoadPriority Priority, std::atomic<int32>* NumFinalizeFailures = nullptr)
+    {
+        std::shared_ptr<FAsyncLoadRequest> Request = std::make_shared<FAsyncLoadRequest>();
+        Request->Path = Path;
+        Request->TypeIndex = 1;
+        Request->Priority.store(Priority);
+
+        FStubTexture* Texture = new FStubTexture();
+        Request->LoadPayload = [Texture, Path]() { return Texture->LoadAsyncPayload(Path); };
+        Request->Finalize = [Texture, NumFinalizeFailures](bool bPayloadSucceeded) -> UResourceBase*
+        {
+            if (bPayloadSucceeded && Texture->FinalizeAsyncLoad())
+            {
+                return Texture;
+            }
+            if (NumFinalizeFailures)
+            {
+                NumFinalizeFailures->fetch_add(1);
+            }
+            delete Texture;
+            return nullptr;
+        };
+        return Request;
+    }
+
+    void WaitForPayloads(const TArray<std::shared_ptr<FAsyncLoadRequest>>& Requests)
+    {
+        for (const std::shared_ptr<FAsyncLoadRequest>& Request : Requests)
+        {
+            while (Request->State.load(std::memory_order_acquire) != EAsyncLoadState::PendingFinalize)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // ──────────────────────────────────────────────
+    // 검사
+    // ──────────────────────────────────────────────
+
+    void TestWorkerPayloadGameThreadFinalize()
+    {
+        const int32 NumTextures = 24;
+        TArray<FString> Paths;
+        for (int32 Index = 0; Index < NumTextures; ++Index)
+        {
+            Paths.Add(TempTexturePath(Index));
+            WriteStubTexture(Paths.back(), 64 << (Index % 3), 64, Index);
+        }
+
+        FAsyncAssetLoader Loader;
+        TArray<std::shared_ptr<FAsyncLoadRequest>> Requests;
+        std::atomic<int32> NumCallbacks{ 0 };
+        for (const FString& Path : Paths)
+        {
+            std::shared_ptr<FAsyncLoadRequest> Request = MakeTextureRequest(Path, EAsyncLoadPriority::Normal);
+            Loader.Enqueue(Request);
+            Loader.AddCallback(Request, [&NumCallbacks](UResourceBase* Resource) { NumCallbacks.fetch_add(Resource ? 1 : 0); });
+            Requests.Add(Request);
+        }
+        TEST_CHECK(Loader.GetNumInFlight() == NumTextures);
+
+        // 게임 루프처럼 예산 안에서만 Finalize (게임 스레드는 Payload를 가져가지 않음)
+        const std::thread::id GameThread = std::this_thread::get_id();
+        while (Loader.GetNumInFlight() > 0)
+        {
+            Loader.ProcessCompleted(1.0);
+            std::this_thread::yield();
+        }
+        TEST_CHECK(NumCallbacks.load() == NumTextures);
+
+        for (int32 Index = 0; Index < NumTextures; ++Index)
+        {
+            TEST_CHECK(Requests[Index]->State.load() == EAsyncLoadState::Succeeded);
+            FStubTexture* Texture = static_cast<FStubTexture*>(Requests[Index]->Result);
+            TEST_CHECK(Texture && Texture->FinalizeThread == GameThread && Texture->PayloadThread != GameThread);
+
+            // 같은 파일을 게임 스레드에서 직렬로 읽은 결과와 같음
+            FStubTexture Serial;
+            TEST_CHECK(Serial.LoadAsyncPayload(Paths[Index]) && Serial.FinalizeAsyncLoad());
+            TEST_CHECK(Texture && Texture->Width == Serial.Width && Texture->NumMips == Serial.NumMips && Texture->Checksum() == Serial.Checksum());
+            delete Texture;
+        }
+
+        std::error_code Ec;
+        for (const FString& Path : Paths)
+        {
+            std::filesystem::remove(Path, Ec);
+        }
+    }
+
+    void TestPriorityBudgetAndMerge()
+    {
+        TArray<FString> Paths;
+        for (int32 Index = 0; Index < 6; ++Index)
+        {
+            Paths.Add(TempTexturePath(100 + Index));
+            WriteStubTexture(Paths.back(), 32, 32, Index);
+        }
+
+        FAsyncAssetLoader Loader;
+        TArray<std::shared_ptr<FAsyncLoadRequest>> Requests;
+        TArray<int32> FinalizeOrder;
+        for (int32 Index = 0; Index < 6; ++Index)
+        {
+            // 0,1: Low / 2,3: Normal / 4,5: High (등록 역순으로 우선순위가 높음)
+            const EAsyncLoadPriority Priority = Index < 2 ? EAsyncLoadPriority::Low : (Index < 4 ? EAsyncLoadPriority::Normal : EAsyncLoadPriority::High);
+            std::shared_ptr<FAsyncLoadRequest> Request = MakeTextureRequest(Paths[Index], Priority);
+            Loader.Enqueue(Request);
+            Loader.AddCallback(Request, [&FinalizeOrder, Index](UResourceBase*) { FinalizeOrder.Add(Index); });
+            Requests.Add(Request);
+        }
+
+        // 같은 타입/경로는 진행 중인 요청을 그대로 돌려주고, 더 높은 우선순위로만 승격
+        std::shared_ptr<FAsyncLoadRequest> Duplicate = Loader.FindInFlight(1, Paths[0]);
+        TEST_CHECK(Duplicate == Requests[0]);
+        TEST_CHECK(Loader.FindInFlight(2, Paths[0]) == nullptr);
+        int32 NumDuplicateCallbacks = 0;
+        Loader.AddCallback(Duplicate, [&NumDuplicateCallbacks](UResourceBase*) { ++NumDuplicateCallbacks; });
+        Loader.RaisePriority(Requests[1], EAsyncLoadPriority::High);
+        Loader.RaisePriority(Requests[5], EAsyncLoadPriority::Low);
+        TEST_CHECK(Requests[1]->Priority.load() == EAsyncLoadPriority::High);
+        TEST_CHECK(Requests[5]->Priority.load() == EAsyncLoadPriority::High);
+
+        WaitForPayloads(Requests);
+
+        // 예산 0이어도 한 번에 최소 1개
+        TEST_CHECK(Loader.ProcessCompleted(0.0) == 1);
+        TEST_CHECK(Loader.ProcessCompleted(1000.0) == 5);
+        TEST_CHECK(Loader.GetNumInFlight() == 0);
+        TEST_CHECK(NumDuplicateCallbacks == 1);
+
+        // High(1 승격, 4, 5) → Normal(2, 3) → Low(0). 같은 우선순위 안의 순서는 Payload 완료 순
+        TEST_CHECK(FinalizeOrder.Num() == 6);
+        if (FinalizeOrder.Num() == 6)
+        {
+            TSet<int32> HighGroup(FinalizeOrder.begin(), FinalizeOrder.begin() + 3);
+            TSet<int32> NormalGroup(FinalizeOrder.begin() + 3, FinalizeOrder.begin() + 5);
+            TEST_CHECK(HighGroup == TSet<int32>({ 1, 4, 5 }));
+            TEST_CHECK(NormalGroup == TSet<int32>({ 2, 3 }));
+            TEST_CHECK(FinalizeOrder[5] == 0);
+        }
+
+        // 완료된 요청에 붙인 콜백은 즉시 호출
+        int32 NumLateCallbacks = 0;
+        Loader.AddCallback(Requests[2], [&NumLateCallbacks](UResourceBase* Resource) { NumLateCallbacks += Resource ? 1 : 0; });
+        TEST_CHECK(NumLateCallbacks == 1);
+
+        for (const std::shared_ptr<FAsyncLoadRequest>& Request : Requests)
+        {
+            delete Request->Result;
+        }
+        std::error_code Ec;
+        for (const FString& Path : Paths)
+        {
+            std::filesystem::remove(Path, Ec);
+        }
+    }
+
+    void TestFailureWaitAndCancel()
+    {
+        const FString ValidPath = TempTexturePath(200);
+        WriteStubTexture(ValidPath, 32, 32, 7);
+
+        // Payload 실패는 Finalize(false)로 전달되고 객체는 Finalize에서 정리
+        {
+            FAsyncAssetLoader Loader;
+            std::atomic<int32> NumFinalizeFailures{ 0 };
+            std::shared_ptr<FAsyncLoadRequest> Missing = MakeTextureRequest(TempTexturePath(201) + ".missing", EAsyncLoadPriority::Normal, &NumFinalizeFailures);
+            bool bCallbackGotNull = false;
+            Loader.Enqueue(Missing);
+            Loader.AddCallback(Missing, [&bCallbackGotNull](UResourceBase* Resource) { bCallbackGotNull = (Resource == nullptr); });
+            Loader.Wait(Missing);
+            TEST_CHECK(Missing->State.load() == EAsyncLoadState::Failed);
+            TEST_CHECK(bCallbackGotNull && NumFinalizeFailures.load() == 1);
+            TEST_CHECK(Loader.GetNumInFlight() == 0);
+        }
+
+        // Flush: 모두 끝날 때까지 (Finalize 콜백에서 새로 올린 요청 포함)
+        {
+            FAsyncAssetLoader Loader;
+            std::shared_ptr<FAsyncLoadRequest> First = MakeTextureRequest(ValidPath, EAsyncLoadPriority::Low);
+            std::shared_ptr<FAsyncLoadRequest> Chained;
+            Loader.Enqueue(First);
+            Loader.AddCallback(First, [&Loader, &Chained, &ValidPath](UResourceBase*)
+            {
+                Chained = MakeTextureRequest(ValidPath, EAsyncLoadPriority::High);
+                Chained->TypeIndex = 2;
+                Loader.Enqueue(Chained);
+            });
+            Loader.Flush();
+            TEST_CHECK(First->State.load() == EAsyncLoadState::Succeeded);
+            TEST_CHECK(Chained && Chained->State.load() == EAsyncLoadState::Succeeded);
+            TEST_CHECK(Loader.GetNumInFlight() == 0);
+            delete First->Result;
+            if (Chained)
+            {
+                delete Chained->Result;
+            }
+        }
+
+        // CancelAll: 콜백 없이 실패 처리, 생성한 객체는 Finalize(false)에서 정리
+        {
+            FAsyncAssetLoader Loader;
+            std::atomic<int32> NumFinalizeFailures{ 0 };
+            TArray<std::shared_ptr<FAsyncLoadRequest>> Requests;
+            int32 NumCallbacks = 0;
+            for (int32 Index = 0; Index < 16; ++Index)
+            {
+                std::shared_ptr<FAsyncLoadRequest> Request = MakeTextureRequest(ValidPath, EAsyncLoadPriority::Normal, &NumFinalizeFailures);
+                Request->TypeIndex = static_cast<uint8>(10 + Index);
+                Loader.Enqueue(Request);
+                Loader.AddCallback(Request, [&NumCallbacks](UResourceBase*) { ++NumCallbacks; });
+                Requests.Add(Request);
+            }
+            Loader.CancelAll();
+            TEST_CHECK(NumCallbacks == 0 && NumFinalizeFailures.load() == 16);
+            TEST_CHECK(Loader.GetNumInFlight() == 0);
+            for (const std::shared_ptr<FAsyncLoadRequest>& Request : Requests)
+            {
+                TEST_CHECK(Request->State.load() == EAsyncLoadState::Failed);
+            }
+        }
+
+        std::error_code Ec;
+        std::filesystem::remove(ValidPath, Ec);
+    }
+
+    // ──────────────────────────────────────────────
+    // 벤치마크
+    // ──────────────────────────────────────────────
+
+    void RunLoadBenchmark()
+    {
+        const int32 NumTextures = 32;
+        const uint32 Size = 1024;
+        TArray<FString> Paths;
+        for (int32 Index = 0; Index < NumTextures; ++Index)
+        {
+            Paths.Add(TempTexturePath(300 + Index));
+            WriteStubTexture(Paths.back(), Size, Size, Index);
+        }
+
+        // 1. 변경 전: 게임 스레드에서 읽기 + 디코딩 + 업로드
+        MundiTest::FTimer LegacyTimer;
+        uint64 LegacyChecksum = 0;
+        for (const FString& Path : Paths)
+        {
+            FStubTexture Texture;
+            Texture.LoadAsyncPayload(Path);
+            Texture.FinalizeAsyncLoad();
+            LegacyChecksum ^= Texture.Checksum();
+        }
+        const double LegacyMS = LegacyTimer.ElapsedMS();
+
+        // 2. 현재: 워커 디코딩, 게임 스레드는 프레임마다 4ms 예산으로 Finalize만
+        FAsyncAssetLoader Loader;
+        TArray<std::shared_ptr<FAsyncLoadRequest>> Requests;
+        MundiTest::FTimer WallTimer;
+        for (const FString& Path : Paths)
+        {
+            Requests.Add(MakeTextureRequest(Path, EAsyncLoadPriority::Normal));
+            Loader.Enqueue(Requests.back());
+        }
+        double GameThreadMS = 0.0;
+        double WorstFrameMS = 0.0;
+        int32 NumFrames = 0;
+        while (Loader.GetNumInFlight() > 0)
+        {
+            MundiTest::FTimer FrameTimer;
+            Loader.ProcessCompleted(4.0);
+            const double FrameMS = FrameTimer.ElapsedMS();
+            GameThreadMS += FrameMS;
+            WorstFrameMS = std::max(WorstFrameMS, FrameMS);
+            ++NumFrames;
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        const double WallMS = WallTimer.ElapsedMS();
+
+        uint64 AsyncChecksum = 0;
+        for (const std::shared_ptr<FAsyncLoadRequest>& Request : Requests)
+        {
+            FStubTexture* Texture = static_cast<FStubTexture*>(Request->Result);
+            AsyncChecksum ^= Texture ? Texture->Checksum() : 0;
+            delete Texture;
+        }
+
+        std::printf("[Async Texture Load Bench] %d textures %ux%u (stub decode: RLE + mip chain), %d workers\n", NumTextures, Size, Size, TaskGraph.GetNumWorkers());
+        std::printf("  legacy game thread (read + decode + upload) : %8.2f ms\n", LegacyMS);
+        std::printf("  async game thread (upload only)            : %8.2f ms over %d frames, worst frame %.2f ms\n", GameThreadMS, NumFrames, WorstFrameMS);
+        std::printf("  async wall time                            : %8.2f ms\n", WallMS);
+        TEST_CHECK(LegacyChecksum == AsyncChecksum);
+
+        std::error_code Ec;
+        for (const FString& Path : Paths)
+        {
+            std::filesystem::remove(Path, Ec);
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TaskGraph.Initialize(4);
+
+    TestWorkerPayloadGameThreadFinalize();
+    TestPriorityBudgetAndMerge();
+    TestFailureWaitAndCancel();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunLoadBenchmark();
+    }
+
+    TaskGraph.Shutdown();
+    return MundiTest::Finish("AsyncAssetLoaderTests");
+}
@@ -0,0 +1,808 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "BVHierarchy.h"
+#include "AllocationCounter.h"
+#include "Actor.h"
+#include "Collision.h"
+#include "OBB.h"
+#include "BoundingSphere.h"
+#include "Picking.h"
+#include "Frustum.h"
+#include <random>
+
+// FBVHierarchy (월드 파티션 BVH) 검사
+// - 컴포넌트는 Shim/Actor.h 대역 (월드 AABB를 테스트가 직접 채움)
+// - AABB 쿼리: 결과가 전수 검사와 같고, 버퍼 재사용 오버로드는 힙 할당 0회
+// - 움직이는 프리미티브: 매 프레임 이동/추가/제거 → UpdateBatch(refit) → FlushRebuild(백그라운드 리빌드)
+//   백그라운드 빌드가 진행 중인 프레임을 포함해 AABB/레이 쿼리가 살아 있는 컴포넌트 전체의 선형 탐색과 같음
+// - 리빌드 중 추가: 트리에 아직 없는 컴포넌트도 AABB/OBB/구/절두체/레이 쿼리와 QueryFrustum이 바로 찾고,
+//   제거/슬롯 재사용 뒤에도 중복이나 제거된 컴포넌트가 없음
+// - --bench: 변경 전 순회(TArray 스택 + TSet + 값 반환)와 현재 오버로드의 쿼리당 힙 할당/시간
+//            갱신 경로 (2만 개 중 매 프레임 5천 개 이동, 120 프레임): 반영+refit / flush / 쿼리 시간
+
+// ──────────────────────────────────────────────
+// 엔진 링크 대역: BVHierarchy.cpp가 참조하지만 Collision.cpp/Picking.cpp는 컴포넌트 전체를 끌어옴
+// ──────────────────────────────────────────────
+
+namespace Collision
+{
+    bool Intersects(const FAABB& Aabb, const FOBB& Obb)
+    {
+        return FOBB(Aabb, FMatrix::Identity()).Intersects(Obb);
+    }
+
+    bool Intersects(const FAABB& Aabb, const FBoundingSphere& Sphere)
+    {
+        float Dist2 = 0.0f;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            const float Clamped = std::clamp(Sphere.Center[Axis], Aabb.Min[Axis], Aabb.Max[Axis]);
+            Dist2 += (Sphere.Center[Axis] - Clamped) * (Sphere.Center[Axis] - Clamped);
+        }
+        return Dist2 <= Sphere.Radius * Sphere.Radius;
+    }
+}
+
+// 테스트 액터: 컴포넌트 하나를 가짐
+struct FTestActor : public AActor
+{
+    UPrimitiveComponent* Component = nullptr;
+};
+
+namespace
+{
+    /** 레이-AABB 슬랩 검사 (시작점이 박스 안이면 0) */
+    bool RayBoxDistance(const FRay& Ray, const FAABB& Box, float& OutDistance)
+    {
+        float TMin = -FLT_MAX;
+        float TMax = FLT_MAX;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (std::abs(Ray.Direction[Axis]) < 1e-6f)
+            {
+                if (Ray.Origin[Axis] < Box.Min[Axis] || Ray.Origin[Axis] > Box.Max[Axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+            float T1 = (Box.Min[Axis] - Ray.Origin[Axis]) / Ray.Direction[Axis];
+            float T2 = (Box.Max[Axis] - Ray.Origin[Axis]) / Ray.Direction[Axis];
+            if (T1 > T2) std::swap(T1, T2);
+            TMin = std::max(TMin, T1);
+            TMax = std::min(TMax, T2);
+            if (TMin > TMax)
+            {
+                return false;
+            }
+        }
+        if (TMax < 0.0f)
+        {
+            return false;
+        }
+        OutDistance = std::max(TMin, 0.0f);
+        return true;
+    }
+}
+
+// 피킹 대역: 메시 대신 액터 컴포넌트의 월드 AABB와 교차
+bool CPickingSystem::CheckActorPicking(const AActor* Actor, const FRay& Ray, float& OutDistance)
+{
+    const FTestActor* TestActor = static_cast<const FTestActor*>(Actor);
+    return TestActor->Component && RayBoxDistance(Ray, TestActor->Component->WorldAABB, OutDistance);
+}
+
+struct FBVHierarchyTestAccess
+{
+    static const void* GetActiveTree(const FBVHierarchy& BVH)
+    {
+        return BVH.ActiveTree.get();
+    }
+
+    static bool IsInActiveTree(const FBVHierarchy& BVH, UPrimitiveComponent* Component)
+    {
+        const int32* FoundSlot = BVH.ComponentSlots.Find(Component);
+        if (!FoundSlot || !BVH.ActiveTree || *FoundSlot >= BVH.ActiveTree->SlotToItem.Num())
+        {
+            return false;
+        }
+        const int32 Item = BVH.ActiveTree->SlotToItem[*FoundSlot];
+        return Item >= 0 && BVH.ActiveTree->Items[Item] == Component;
+    }
+
+    static int32 GetNumSlotsOutsideTree(const FBVHierarchy& BVH)
+    {
+        return BVH.SlotsOutsideTree.Num();
+    }
+
+    static void ApplyBounds(FBVHierarchy& BVH, const TArray<UPrimitiveComponent*>& Components, const TArray<FAABB>& Bounds)
+    {
+        BVH.ApplyBounds(Components, Bounds);
+    }
+
+    // 변경 전 QueryIntersectedComponentsGeneric과 같은 할당 패턴 (힙 스택 + TSet 중복 제거 + 값 반환)
+    static TArray<UPrimitiveComponent*> LegacyQuery(const FBVHierarchy& BVH, const FAABB& InBound)
+    {
+        const FBVHierarchy::FLBVHTree& Tree = *BVH.ActiveTree;
+        TSet<UPrimitiveComponent*> IntersectedComponents;
+        TArray<int32> IdxStack;
+        IdxStack.push_back(0);
+        while (!IdxStack.empty())
+        {
+            const int32 Idx = IdxStack.back();
+            IdxStack.pop_back();
+            const FBVHierarchy::FLBVHNode& Node = Tree.Nodes[Idx];
+            if (!Node.Bounds.Intersects(InBound))
+                continue;
+            if (Node.IsLeaf())
+            {
+                for (int32 i = 0; i < Node.Count; ++i)
+                {
+                    UPrimitiveComponent* Component = Tree.Items[Node.First + i];
+                    if (Component && InBound.Intersects(Tree.ItemBounds[Node.First + i]))
+                    {
+                        IntersectedComponents.insert(Component);
+                    }
+                }
+            }
+            else
+            {
+                if (Node.Left >= 0) IdxStack.push_back(Node.Left);
+                if (Node.Right >= 0) IdxStack.push_back(Node.Right);
+            }
+        }
+        return IntersectedComponents.Array();
+    }
+};
+
+namespace
+{
+    /** 무작위 박스를 가진 컴포넌트 묶음 (UWorldPartitionManager와 같은 BVH 설정) */
+    struct FSyntheticScene
+    {
+        std::vector<UPrimitiveComponent> Storage;
+        TArray<UPrimitiveComponent*> Components;
+        TArray<FAABB> Bounds;
+
+        FSyntheticScene(int32 NumPrimitives, uint32 Seed)
+            : Storage(NumPrimitives)
+        {
+            std::mt19937 Rng(Seed);
+            std::uniform_real_distribution<float> Position(-500.0f, 500.0f);
+            std::uniform_real_distribution<float> HalfSize(0.5f, 4.0f);
+            for (UPrimitiveComponent& Component : Storage)
+            {
+                const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+                const FVector Half(HalfSize(Rng), HalfSize(Rng), HalfSize(Rng));
+                Component.WorldAABB = FAABB(Center - Half, Center + Half);
+                Components.Add(&Component);
+                Bounds.Add(Component.WorldAABB);
+            }
+        }
+    };
+
+    TArray<FAABB> MakeQueryBoxes(int32 NumQueries, uint32 Seed)
+    {
+        std::mt19937 Rng(Seed);
+        std::uniform_real_distribution<float> Position(-500.0f, 500.0f);
+        TArray<FAABB> QueryBoxes;
+        for (int32 q = 0; q < NumQueries; ++q)
+        {
+            const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+            QueryBoxes.Add(FAABB(Center - FVector(25.0f, 25.0f, 25.0f), Center + FVector(25.0f, 25.0f, 25.0f)));
+        }
+        return QueryBoxes;
+    }
+
+    // 순서와 무관한 집합 비교
+    bool SameSet(TArray<UPrimitiveComponent*> A, TArray<UPrimitiveComponent*> B)
+    {
+        std::sort(A.begin(), A.end());
+        std::sort(B.begin(), B.end());
+        return A == B;
+    }
+
+    TArray<UPrimitiveComponent*> BruteForceQuery(const FSyntheticScene& Scene, const FAABB& InBound)
+    {
+        TArray<UPrimitiveComponent*> Result;
+        for (int32 Index = 0; Index < Scene.Components.Num(); ++Index)
+        {
+            if (InBound.Intersects(Scene.Bounds[Index]))
+            {
+                Result.Add(Scene.Components[Index]);
+            }
+        }
+        return Result;
+    }
+
+    void TestQueryAllocations()
+    {
+        FSyntheticScene Scene(20000, 1234);
+        FBVHierarchy BVH(FAABB(), 0, 8, 1);
+        FBVHierarchyTestAccess::ApplyBounds(BVH, Scene.Components, Scene.Bounds);
+        BVH.FlushRebuild(true);
+
+        const TArray<FAABB> QueryBoxes = MakeQueryBoxes(256, 99);
+        TArray<UPrimitiveComponent*> Components;
+        for (const FAABB& QueryBox : QueryBoxes)
+        {
+            Components.clear();
+            BVH.QueryIntersectedComponents(QueryBox, Components);
+            TEST_CHECK(SameSet(Components, BruteForceQuery(Scene, QueryBox)));
+            TEST_CHECK(SameSet(Components, FBVHierarchyTestAccess::LegacyQuery(BVH, QueryBox)));
+        }
+
+        // 출력 버퍼가 이미 충분히 크면 순회 스택(TInlineArray)까지 힙을 쓰지 않음
+        Components.Reserve(Scene.Components.Num());
+        FAllocationCounter::SetEnabled(true);
+        const uint64 StartAllocations = FAllocationCounter::GetNumAllocations();
+        for (const FAABB& QueryBox : QueryBoxes)
+        {
+            Components.clear();
+            BVH.QueryIntersectedComponents(QueryBox, Components);
+        }
+        const uint64 ReuseAllocations = FAllocationCounter::GetNumAllocations() - StartAllocations;
+
+        // 값 반환은 결과 배열 하나만 (결과가 비면 0)
+        const uint64 ByValueStart = FAllocationCounter::GetNumAllocations();
+        for (const FAABB& QueryBox : QueryBoxes)
+        {
+            const TArray<UPrimitiveComponent*> Result = BVH.QueryIntersectedComponents(QueryBox);
+            TEST_CHECK(Result.Num() >= 0);
+        }
+        const uint64 ByValueAllocations = FAllocationCounter::GetNumAllocations() - ByValueStart;
+        FAllocationCounter::SetEnabled(false);
+
+        TEST_CHECK(ReuseAllocations == 0);
+        TEST_CHECK(ByValueAllocations <= uint64(QueryBoxes.Num()) * 8);
+    }
+
+    void RunAllocationBenchmark()
+    {
+        const int32 NumPrimitives = 20000;
+        FSyntheticScene Scene(NumPrimitives, 1234);
+        FBVHierarchy BVH(FAABB(), 0, 8, 1);
+        // 백그라운드 리빌드가 없어야 측정 구간의 할당이 쿼리 것만 남음
+        FBVHierarchyTestAccess::ApplyBounds(BVH, Scene.Components, Scene.Bounds);
+        BVH.FlushRebuild(true);
+
+        const TArray<FAABB> QueryBoxes = MakeQueryBoxes(4096, 4321);
+        const int32 NumQueries = QueryBoxes.Num();
+
+        FAllocationCounter::SetEnabled(true);
+
+        uint64 StartAllocations = FAllocationCounter::GetNumAllocations();
+        MundiTest::FTimer LegacyTimer;
+        size_t LegacyHits = 0;
+        for (const FAABB& QueryBox : QueryBoxes)
+        {
+            LegacyHits += FBVHierarchyTestAccess::LegacyQuery(BVH, QueryBox).size();
+        }
+        const double LegacyMS = LegacyTimer.ElapsedMS();
+        const uint64 LegacyAllocations = FAllocationCounter::GetNumAllocations() - StartAllocations;
+
+        StartAllocations = FAllocationCounter::GetNumAllocations();
+        MundiTest::FTimer ByValueTimer;
+        size_t ByValueHits = 0;
+        for (const FAABB& QueryBox : QueryBoxes)
+        {
+            ByValueHits += BVH.QueryIntersectedComponents(QueryBox).size();
+        }
+        const double ByValueMS = ByValueTimer.ElapsedMS();
+        const uint64 ByValueAllocations = FAllocationCounter::GetNumAllocations() - StartAllocations;
+
+        TArray<UPrimitiveComponent*> Components;
+        StartAllocations = FAllocationCounter::GetNumAllocations();
+        MundiTest::FTimer ReuseTimer;
+        size_t ReuseHits = 0;
+        for (const FAABB& QueryBox : QueryBoxes)
+        {
+            Components.clear();
+            BVH.QueryIntersectedComponents(QueryBox, Components);
+            ReuseHits += Components.size();
+        }
+        const double ReuseMS = ReuseTimer.ElapsedMS();
+        const uint64 ReuseAllocations = FAllocationCounter::GetNumAllocations() - StartAllocations;
+
+        FAllocationCounter::SetEnabled(false);
+
+        std::printf("[BVHierarchy Alloc Bench] %d primitives, %d AABB queries\n", NumPrimitives, NumQueries);
+        std::printf("  legacy (TArray stack + TSet) : %8llu allocs (%.2f/query), %.3f ms\n", (unsigned long long)LegacyAllocations, double(LegacyAllocations) / NumQueries, LegacyMS);
+        std::printf("  by value (inline stack)      : %8llu allocs (%.2f/query), %.3f ms\n", (unsigned long long)ByValueAllocations, double(ByValueAllocations) / NumQueries, ByValueMS);
+        std::printf("  reused output buffer         : %8llu allocs (%.2f/query), %.3f ms\n", (unsigned long long)ReuseAllocations, double(ReuseAllocations) / NumQueries, ReuseMS);
+        TEST_CHECK(LegacyHits == ByValueHits && ByValueHits == ReuseHits);
+    }
+
+    // ──────────────────────────────────────────────
+    // 움직이는 프리미티브 (refit + 백그라운드 리빌드)
+    // ──────────────────────────────────────────────
+
+    /** 액터 하나에 컴포넌트 하나, 일부는 처음에 월드 밖(추가 대기) */
+    struct FMovingScene
+    {
+        std::vector<FTestActor> Actors;
+        std::vector<UPrimitiveComponent> Storage;
+        TArray<FVector> Velocities;
+        TArray<bool> bInWorld;
+
+        FMovingScene(int32 NumPrimitives, uint32 Seed)
+            : Actors(NumPrimitives)
+            , Storage(NumPrimitives)
+        {
+            std::mt19937 Rng(Seed);
+            std::uniform_real_distribution<float> Position(-500.0f, 500.0f);
+            std::uniform_real_distribution<float> HalfSize(0.5f, 4.0f);
+            std::uniform_real_distribution<float> Velocity(-8.0f, 8.0f);
+            for (int32 Index = 0; Index < NumPrimitives; ++Index)
+            {
+                const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+                const FVector Half(HalfSize(Rng), HalfSize(Rng), HalfSize(Rng));
+                Storage[Index].WorldAABB = FAABB(Center - Half, Center + Half);
+                Storage[Index].Owner = &Actors[Index];
+                Actors[Index].Component = &Storage[Index];
+                Velocities.Add(FVector(Velocity(Rng), Velocity(Rng), Velocity(Rng)));
+                bInWorld.Add(false);
+            }
+        }
+    };
+
+    /** 살아 있는 컴포넌트 전체의 선형 탐색 (트리에 아직 없는 컴포넌트 포함) */
+    TArray<UPrimitiveComponent*> LinearQuery(FMovingScene& Scene, const FAABB& InBound)
+    {
+        TArray<UPrimitiveComponent*> Result;
+        for (size_t Index = 0; Index < Scene.Storage.size(); ++Index)
+        {
+            UPrimitiveComponent* Component = &Scene.Storage[Index];
+            if (Scene.bInWorld[Index] && InBound.Intersects(Component->WorldAABB))
+            {
+                Result.Add(Component);
+            }
+        }
+        return Result;
+    }
+
+    AActor* LinearRay(FMovingScene& Scene, const FRay& Ray, float& OutDistance)
+    {
+        AActor* Best = nullptr;
+        OutDistance = FLT_MAX;
+        for (size_t Index = 0; Index < Scene.Storage.size(); ++Index)
+        {
+            UPrimitiveComponent* Component = &Scene.Storage[Index];
+            float Distance;
+            if (Scene.bInWorld[Index] && RayBoxDistance(Ray, Component->WorldAABB, Distance) && Distance < OutDistance)
+            {
+                OutDistance = Distance;
+                Best = Component->GetOwner();
+            }
+        }
+        return Best;
+    }
+
+    void TestMovingPrimitives()
+    {
+        constexpr int32 NumPrimitives = 8000;    // 백그라운드 리빌드 기준(2048개) 이상
+        constexpr int32 NumInitial = 7000;
+        constexpr int32 NumMovingPerFrame = 1500;
+        constexpr int32 NumChurnPerFrame = 40;  // 10 프레임마다 추가/제거
+        constexpr int32 NumFrames = 120;
+
+        FMovingScene Scene(NumPrimitives, 77);
+        FBVHierarchy BVH(FAABB(), 0, 8, 1);
+
+        TArray<UPrimitiveComponent*> Initial;
+        for (int32 Index = 0; Index < NumInitial; ++Index)
+        {
+            Initial.Add(&Scene.Storage[Index]);
+            Scene.bInWorld[Index] = true;
+        }
+        BVH.BulkUpdate(Initial);
+
+        std::mt19937 Rng(5);
+        std::uniform_real_distribution<float> Position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> Direction(-1.0f, 1.0f);
+        std::uniform_int_distribution<int32> AnyPrimitive(0, NumPrimitives - 1);
+
+        TArray<UPrimitiveComponent*> Updates;
+        TArray<UPrimitiveComponent*> Result;
+        TArray<UPrimitiveComponent*> Removed;
+        int32 NumSwaps = 0;
+        int32 NumFramesWithRebuildInFlight = 0;
+        int32 NumQueryMismatches = 0;
+        int32 NumRayMismatches = 0;
+        int32 NumRayHits = 0;
+        int32 NumRemovedReturned = 0;
+        int32 NumFramesWithSlotsOutsideTree = 0;
+
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            Updates.clear();
+            for (int32 k = 0; k < NumMovingPerFrame; ++k)
+            {
+                const int32 Index = (Frame * NumMovingPerFrame + k) % NumPrimitives;
+                if (!Scene.bInWorld[Index])
+                {
+                    continue;
+                }
+                UPrimitiveComponent& Component = Scene.Storage[Index];
+                Component.WorldAABB.Min += Scene.Velocities[Index];
+                Component.WorldAABB.Max += Scene.Velocities[Index];
+                Updates.Add(&Component);
+            }
+
+            // 제거는 UpdateBatch가 bPendingDestroy를 보고 처리, 추가는 다음 리빌드에서 트리에 들어감 (그 전에는 직접 검사)
+            Removed.clear();
+            if (Frame % 10 == 5)
+            {
+                for (int32 k = 0; k < NumChurnPerFrame; ++k)
+                {
+                    const int32 Index = AnyPrimitive(Rng);
+                    UPrimitiveComponent& Component = Scene.Storage[Index];
+                    if (Scene.bInWorld[Index])
+                    {
+                        Component.bPendingDestroy = true;
+                        Scene.bInWorld[Index] = false;
+                        Removed.Add(&Component);
+                    }
+                    else
+                    {
+                        Component.bPendingDestroy = false;
+                        Scene.bInWorld[Index] = true;
+                    }
+                    Updates.Add(&Component);
+                }
+            }
+
+            BVH.UpdateBatch(Updates);
+            const void* TreeBefore = FBVHierarchyTestAccess::GetActiveTree(BVH);
+            BVH.FlushRebuild();
+            NumSwaps += FBVHierarchyTestAccess::GetActiveTree(BVH) != TreeBefore ? 1 : 0;
+            NumFramesWithRebuildInFlight += BVH.IsRebuildInFlight() ? 1 : 0;
+            NumFramesWithSlotsOutsideTree += FBVHierarchyTestAccess::GetNumSlotsOutsideTree(BVH) > 0 ? 1 : 0;
+
+            for (int32 q = 0; q < 16; ++q)
+            {
+                const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+                const FAABB QueryBox(Center - FVector(40.0f, 40.0f, 40.0f), Center + FVector(40.0f, 40.0f, 40.0f));
+                Result.clear();
+                BVH.QueryIntersectedComponents(QueryBox, Result);
+                NumQueryMismatches += SameSet(Result, LinearQuery(Scene, QueryBox)) ? 0 : 1;
+                for (UPrimitiveComponent* Component : Result)
+                {
+                    NumRemovedReturned += std::find(Removed.begin(), Removed.end(), Component) != Removed.end() ? 1 : 0;
+                }
+            }
+
+            // 월드 밖에서 안쪽으로 쏘는 레이 (시작점이 박스 안에 있지 않도록)
+            for (int32 r = 0; r < 8; ++r)
+            {
+                FRay Ray;
+                const FVector Target(Position(Rng) * 0.5f, Position(Rng) * 0.5f, Position(Rng) * 0.5f);
+                const FVector Offset = FVector(Direction(Rng), Direction(Rng), Direction(Rng)).GetNormalized() * 2000.0f;
+                Ray.Origin = Target + Offset;
+                Ray.Direction = (Target - Ray.Origin).GetNormalized();
+
+                AActor* HitActor = nullptr;
+                float HitDistance = FLT_MAX;
+                BVH.QueryRayClosest(Ray, HitActor, HitDistance);
+                float ExpectedDistance;
+                AActor* ExpectedActor = LinearRay(Scene, Ray, ExpectedDistance);
+                NumRayHits += ExpectedActor ? 1 : 0;
+                if (HitActor != ExpectedActor || (ExpectedActor && HitDistance != ExpectedDistance))
+                {
+                    ++NumRayMismatches;
+                }
+            }
+        }
+
+        std::printf("[BVHierarchy Moving] %d frames, %d tree swaps, %d frames with a rebuild in flight, %d ray hits, %d frames with components not yet in the tree\n",
+            NumFrames, NumSwaps, NumFramesWithRebuildInFlight, NumRayHits, NumFramesWithSlotsOutsideTree);
+        TEST_CHECK(NumQueryMismatches == 0);
+        TEST_CHECK(NumRayMismatches == 0);
+        TEST_CHECK(NumRemovedReturned == 0);
+        TEST_CHECK(NumSwaps > 2);
+        TEST_CHECK(NumFramesWithRebuildInFlight > 0);
+        TEST_CHECK(NumRayHits > 0);
+        TEST_CHECK(NumFramesWithSlotsOutsideTree > 0);
+
+        // 마지막 flush 뒤에는 살아 있는 컴포넌트가 모두 트리에 있고 전수 검사와 같음
+        BVH.FlushRebuild(true);
+        BVH.FlushRebuild(true);
+        bool bAllInTree = true;
+        for (size_t Index = 0; Index < Scene.Storage.size(); ++Index)
+        {
+            bAllInTree &= FBVHierarchyTestAccess::IsInActiveTree(BVH, &Scene.Storage[Index]) == Scene.bInWorld[Index];
+        }
+        TEST_CHECK(bAllInTree);
+        TEST_CHECK(FBVHierarchyTestAccess::GetNumSlotsOutsideTree(BVH) == 0);
+        TEST_CHECK(!BVH.IsRebuildInFlight());
+        for (int32 q = 0; q < 64; ++q)
+        {
+            const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+            const FAABB QueryBox(Center - FVector(40.0f, 40.0f, 40.0f), Center + FVector(40.0f, 40.0f, 40.0f));
+            Result.clear();
+            BVH.QueryIntersectedComponents(QueryBox, Result);
+            TEST_CHECK(SameSet(Result, LinearQuery(Scene, QueryBox)));
+        }
+        BVH.Clear();
+    }
+
+    // ──────────────────────────────────────────────
+    // 리빌드 중 추가된 컴포넌트
+    // ──────────────────────────────────────────────
+
+    /** AABB/OBB/구/절두체 쿼리를 살아 있는 컴포넌트 전체의 선형 탐색과 비교해 다른 결과 수를 셈 */
+    int32 CountQueryMismatches(FMovingScene& Scene, const FBVHierarchy& BVH, const FFrustum& Frustum, std::mt19937& Rng)
+    {
+        std::uniform_real_distribution<float> Position(-500.0f, 500.0f);
+        int32 NumMismatches = 0;
+        TArray<UPrimitiveComponent*> Result;
+        for (int32 q = 0; q < 16; ++q)
+        {
+            const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+            const FAABB QueryBox(Center - FVector(60.0f, 60.0f, 60.0f), Center + FVector(60.0f, 60.0f, 60.0f));
+            const FOBB QueryObb(QueryBox, FMatrix::Identity());
+            const FBoundingSphere QuerySphere(Center, 60.0f);
+
+            TArray<UPrimitiveComponent*> ExpectedBox;
+            TArray<UPrimitiveComponent*> ExpectedSphere;
+            for (size_t Index = 0; Index < Scene.Storage.size(); ++Index)
+            {
+                UPrimitiveComponent* Component = &Scene.Storage[Index];
+                if (!Scene.bInWorld[Index]) continue;
+                if (QueryBox.Intersects(Component->WorldAABB)) ExpectedBox.Add(Component);
+                if (Collision::Intersects(Component->WorldAABB, QuerySphere)) ExpectedSphere.Add(Component);
+            }
+
+            Result.clear();
+            BVH.QueryIntersectedComponents(QueryBox, Result);
+            NumMismatches += SameSet(Result, ExpectedBox) ? 0 : 1;
+            Result.clear();
+            BVH.QueryIntersectedComponents(QueryObb, Result);
+            NumMismatches += SameSet(Result, ExpectedBox) ? 0 : 1;
+            Result.clear();
+            BVH.QueryIntersectedComponents(QuerySphere, Result);
+            NumMismatches += SameSet(Result, ExpectedSphere) ? 0 : 1;
+        }
+
+        TArray<UPrimitiveComponent*> ExpectedFrustum;
+        for (size_t Index = 0; Index < Scene.Storage.size(); ++Index)
+        {
+            if (Scene.bInWorld[Index] && IsAABBVisible(Frustum, Scene.Storage[Index].WorldAABB))
+            {
+                ExpectedFrustum.Add(&Scene.Storage[Index]);
+            }
+        }
+        Result.clear();
+        BVH.QueryIntersectedComponents(Frustum, Result);
+        NumMismatches += SameSet(Result, ExpectedFrustum) ? 0 : 1;
+        return NumMismatches;
+    }
+
+    void TestComponentsAddedDuringRebuild()
+    {
+        constexpr int32 NumInitial = 3000;      // 백그라운드 리빌드 기준(2048개) 이상
+        constexpr int32 NumLate = 100;
+
+        FMovingScene Scene(NumInitial + NumLate, 91);
+        FBVHierarchy BVH(FAABB(), 0, 8, 1);
+        TArray<UPrimitiveComponent*> Initial;
+        for (int32 Index = 0; Index < NumInitial; ++Index)
+        {
+            Initial.Add(&Scene.Storage[Index]);
+            Scene.bInWorld[Index] = true;
+        }
+        BVH.BulkUpdate(Initial);
+
+        // 반은 백그라운드 빌드 스냅샷에 들어가고, 반은 빌드를 시작한 뒤에 추가됨
+        TArray<UPrimitiveComponent*> Updates;
+        for (int32 Index = NumInitial; Index < NumInitial + NumLate / 2; ++Index)
+        {
+            Updates.Add(&Scene.Storage[Index]);
+            Scene.bInWorld[Index] = true;
+        }
+        BVH.UpdateBatch(Updates);
+        BVH.FlushRebuild();
+        TEST_CHECK(BVH.IsRebuildInFlight());
+
+        Updates.clear();
+        for (int32 Index = NumInitial + NumLate / 2; Index < NumInitial + NumLate; ++Index)
+        {
+            Updates.Add(&Scene.Storage[Index]);
+            Scene.bInWorld[Index] = true;
+        }
+        BVH.UpdateBatch(Updates);
+        TEST_CHECK(FBVHierarchyTestAccess::GetNumSlotsOutsideTree(BVH) == NumLate);
+
+        // 뒤(-Z)에서 +Z를 보는 60도 절두체 (장면 일부만 덮음)
+        const FMatrix View = FMatrix::LookAtLH(FVector(0.0f, 0.0f, -800.0f), FVector(0.0f, 0.0f, 0.0f), FVector(0.0f, 1.0f, 0.0f));
+        const FMatrix Projection = FMatrix::PerspectiveFovLH(DegreesToRadians(60.0f), 1.0f, 1.0f, 1500.0f);
+        const FFrustum Frustum = CreateFrustumFromViewProjection(View * Projection);
+
+        std::mt19937 Rng(17);
+        int32 NumMismatches = CountQueryMismatches(Scene, BVH, Frustum, Rng);
+
+        // 새 컴포넌트마다 자기 박스로 쿼리하면 찾고, 중심을 향한 레이는 선형 탐색과 같은 액터를 맞힘
+        int32 NumLateMissed = 0;
+        int32 NumRayMismatches = 0;
+        int32 NumLateRayHits = 0;
+        int32 NumLateVisible = 0;
+        int32 NumCullMismatches = 0;
+        TArray<UPrimitiveComponent*> Result;
+        for (FTestActor& Actor : Scene.Actors)
+        {
+            Actor.bCulled = true;
+        }
+        BVH.QueryFrustum(Frustum);
+        for (int32 Index = NumInitial; Index < NumInitial + NumLate; ++Index)
+        {
+            UPrimitiveComponent* Component = &Scene.Storage[Index];
+            TEST_CHECK(!FBVHierarchyTestAccess::IsInActiveTree(BVH, Component));
+
+            Result.clear();
+            BVH.QueryIntersectedComponents(Component->WorldAABB, Result);
+            NumLateMissed += std::count(Result.begin(), Result.end(), Component) == 1 ? 0 : 1;
+
+            FRay Ray;
+            const FVector Target = Component->WorldAABB.GetCenter();
+            Ray.Origin = Target + FVector(0.0f, 0.0f, -2000.0f);
+            Ray.Direction = FVector(0.0f, 0.0f, 1.0f);
+            AActor* HitActor = nullptr;
+            float HitDistance = FLT_MAX;
+            BVH.QueryRayClosest(Ray, HitActor, HitDistance);
+            float ExpectedDistance;
+            AActor* ExpectedActor = LinearRay(Scene, Ray, ExpectedDistance);
+            NumRayMismatches += (HitActor != ExpectedActor || (ExpectedActor && HitDistance != ExpectedDistance)) ? 1 : 0;
+            NumLateRayHits += HitActor == &Scene.Actors[Index] ? 1 : 0;
+
+            const bool bVisible = IsAABBVisible(Frustum, Component->WorldAABB);
+            NumLateVisible += bVisible ? 1 : 0;
+            NumCullMismatches += Scene.Actors[Index].bCulled == bVisible ? 1 : 0;
+        }
+        std::printf("[BVHierarchy Late Adds] %d added during a rebuild, %d hit first by a ray, %d in the frustum\n",
+            NumLate, NumLateRayHits, NumLateVisible);
+        TEST_CHECK(NumLateMissed == 0);
+        TEST_CHECK(NumRayMismatches == 0);
+        TEST_CHECK(NumLateRayHits > 0);
+        TEST_CHECK(NumLateVisible > 0);
+        TEST_CHECK(NumCullMismatches == 0);
+
+        // 트리 밖 컴포넌트와 트리 안 컴포넌트를 제거하고, 빈 슬롯을 다른 컴포넌트가 재사용
+        Updates.clear();
+        for (int32 Index : { NumInitial + 3, NumInitial + 70, 10, 11 })
+        {
+            Scene.Storage[Index].bPendingDestroy = true;
+            Scene.bInWorld[Index] = false;
+            Updates.Add(&Scene.Storage[Index]);
+        }
+        BVH.UpdateBatch(Updates);
+        NumMismatches += CountQueryMismatches(Scene, BVH, Frustum, Rng);
+        TEST_CHECK(FBVHierarchyTestAccess::GetNumSlotsOutsideTree(BVH) == NumLate - 2);
+
+        Updates.clear();
+        for (int32 Index : { NumInitial + 3, 10 })
+        {
+            Scene.Storage[Index].bPendingDestroy = false;
+            Scene.bInWorld[Index] = true;
+            Updates.Add(&Scene.Storage[Index]);
+        }
+        BVH.UpdateBatch(Updates);
+        NumMismatches += CountQueryMismatches(Scene, BVH, Frustum, Rng);
+
+        // 기다려서 교체하면 스냅샷 이후 변경까지 동기 리빌드로 반영되어 모두 트리 안
+        // (교체 때 스냅샷 이후 추가분만 남기는 경로는 TestMovingPrimitives의 대기 없는 flush가 지남)
+        BVH.FlushRebuild(true);
+        NumMismatches += CountQueryMismatches(Scene, BVH, Frustum, Rng);
+        TEST_CHECK(NumMismatches == 0);
+        TEST_CHECK(FBVHierarchyTestAccess::GetNumSlotsOutsideTree(BVH) == 0);
+        bool bAllInTree = true;
+        for (size_t Index = 0; Index < Scene.Storage.size(); ++Index)
+        {
+            bAllInTree &= FBVHierarchyTestAccess::IsInActiveTree(BVH, &Scene.Storage[Index]) == Scene.bInWorld[Index];
+        }
+        TEST_CHECK(bAllInTree);
+        BVH.Clear();
+    }
+
+    /** 갱신 경로 시간 (합성 키: ApplyBounds와 AABB 쿼리는 컴포넌트를 역참조하지 않음) */
+    void RunUpdateBenchmark()
+    {
+        constexpr int32 N = 20000;
+        constexpr int32 M = 5000;
+        constexpr int32 NumFrames = 120;
+        constexpr int32 QueriesPerFrame = 64;
+
+        // UWorldPartitionManager와 같은 설정
+        FBVHierarchy BVH(FAABB(), 0, 8, 1);
+
+        std::mt19937 Rng(1234);
+        std::uniform_real_distribution<float> Position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> HalfSize(0.5f, 4.0f);
+        std::uniform_real_distribution<float> Velocity(-4.0f, 4.0f);
+
+        TArray<UPrimitiveComponent*> Keys;
+        TArray<FAABB> Boxes;
+        TArray<FVector> Velocities;
+        for (int32 i = 0; i < N; ++i)
+        {
+            Keys.Add(reinterpret_cast<UPrimitiveComponent*>(static_cast<uintptr_t>(i + 1) * 16));
+            const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+            const FVector Half(HalfSize(Rng), HalfSize(Rng), HalfSize(Rng));
+            Boxes.Add(FAABB(Center - Half, Center + Half));
+            Velocities.Add(FVector(Velocity(Rng), Velocity(Rng), Velocity(Rng)));
+        }
+
+        MundiTest::FTimer BuildTimer;
+        FBVHierarchyTestAccess::ApplyBounds(BVH, Keys, Boxes);
+        BVH.FlushRebuild(true);
+        const double InitialBuildMS = BuildTimer.ElapsedMS();
+
+        TArray<UPrimitiveComponent*> MovedKeys;
+        TArray<FAABB> MovedBoxes;
+        TArray<UPrimitiveComponent*> QueryResult;
+        double ApplyMS = 0.0;
+        double FlushMS = 0.0;
+        double QueryMS = 0.0;
+        int32 NumRebuilds = 0;
+        int32 NumQueriesDuringRebuild = 0;
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            // 매 프레임 다른 M개가 움직임 (N개를 돌아가며)
+            MovedKeys.clear();
+            MovedBoxes.clear();
+            for (int32 k = 0; k < M; ++k)
+            {
+                const int32 Index = static_cast<int32>((static_cast<int64>(Frame) * M + k) % N);
+                Boxes[Index].Min += Velocities[Index];
+                Boxes[Index].Max += Velocities[Index];
+                MovedKeys.Add(Keys[Index]);
+                MovedBoxes.Add(Boxes[Index]);
+            }
+
+            MundiTest::FTimer ApplyTimer;
+            FBVHierarchyTestAccess::ApplyBounds(BVH, MovedKeys, MovedBoxes);
+            ApplyMS += ApplyTimer.ElapsedMS();
+
+            const void* TreeBefore = FBVHierarchyTestAccess::GetActiveTree(BVH);
+            MundiTest::FTimer FlushTimer;
+            BVH.FlushRebuild();
+            FlushMS += FlushTimer.ElapsedMS();
+            NumRebuilds += FBVHierarchyTestAccess::GetActiveTree(BVH) != TreeBefore ? 1 : 0;
+
+            MundiTest::FTimer QueryTimer;
+            for (int32 q = 0; q < QueriesPerFrame; ++q)
+            {
+                const FVector Center(Position(Rng), Position(Rng), Position(Rng));
+                QueryResult.clear();
+                BVH.QueryIntersectedComponents(FAABB(Center - FVector(25.0f, 25.0f, 25.0f), Center + FVector(25.0f, 25.0f, 25.0f)), QueryResult);
+            }
+            QueryMS += QueryTimer.ElapsedMS();
+            NumQueriesDuringRebuild += BVH.IsRebuildInFlight() ? QueriesPerFrame : 0;
+        }
+        BVH.FlushRebuild(true);
+
+        std::printf("[BVHierarchy Update Bench] %d primitives, %d moving/frame, %d frames, %d workers\n",
+            N, M, NumFrames, FTaskGraph::GetInstance().GetNumWorkers());
+        std::printf("  initial build %.3f ms\n", InitialBuildMS);
+        std::printf("  per frame: apply+refit %.3f ms, flush %.3f ms, %d queries %.3f ms\n",
+            ApplyMS / NumFrames, FlushMS / NumFrames, QueriesPerFrame, QueryMS / NumFrames);
+        std::printf("  background rebuilds %d, queries during rebuild %d\n", NumRebuilds, NumQueriesDuringRebuild);
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestQueryAllocations();
+
+    FTaskGraph::GetInstance().Initialize(4);
+    TestMovingPrimitives();
+    TestComponentsAddedDuringRebuild();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunAllocationBenchmark();
+        RunUpdateBenchmark();
+    }
+
+    FTaskGraph::GetInstance().Shutdown();
+    return MundiTest::Finish("BVHierarchyTests");
+}
@@ -0,0 +1,328 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// TQueue 스레드 간 전달 모드 (Spsc/Mpsc/Mpmc/Spmc) 검사
+// - 단일 스레드: FIFO 순서, 용량(가득 차면 Enqueue 실패), Peek, Empty의 원소 소멸
+// - 다중 스레드: 모든 원소가 정확히 한 번 나오고, 생산자별 순서가 소비자마다 유지되는지
+// - --bench: 생산자/소비자 수별 처리량을 mutex + std::deque와 비교
+
+namespace
+{
+    // 값에 생산자 번호(상위 32비트)와 생산자 안 순번(하위 32비트)을 넣음
+    uint64 MakeItem(uint32 Producer, uint32 Sequence)
+    {
+        return (uint64(Producer) << 32) | Sequence;
+    }
+
+    // 살아 있는 개수를 세는 원소 (Empty/소멸자가 남은 원소를 모두 파괴하는지)
+    struct FTracked
+    {
+        static inline std::atomic<int32> NumAlive{ 0 };
+
+        int32 Value = 0;
+
+        FTracked() { ++NumAlive; }
+        explicit FTracked(int32 InValue) : Value(InValue) { ++NumAlive; }
+        FTracked(const FTracked& Other) : Value(Other.Value) { ++NumAlive; }
+        FTracked& operator=(const FTracked& Other) = default;
+        ~FTracked() { --NumAlive; }
+    };
+
+    template<EQueueMode Mode>
+    constexpr bool IsBounded()
+    {
+        return Mode != EQueueMode::Mpsc;
+    }
+
+    template<EQueueMode Mode>
+    void TestSingleThread()
+    {
+        using FQueue = TQueue<uint64, Mode>;
+        FQueue Queue = [] { if constexpr (IsBounded<Mode>()) { return FQueue(8); } else { return FQueue(); } }();
+
+        uint64 Value = 0;
+        TEST_CHECK(Queue.IsEmpty());
+        TEST_CHECK(!Queue.Dequeue(Value));
+
+        for (uint32 Index = 0; Index < 8; ++Index)
+        {
+            TEST_CHECK(Queue.Enqueue(MakeItem(0, Index)));
+        }
+        if constexpr (IsBounded<Mode>())
+        {
+            TEST_CHECK(!Queue.Enqueue(MakeItem(0, 8)));
+            TEST_CHECK(Queue.Num() == 8);
+        }
+        else
+        {
+            TEST_CHECK(Queue.Enqueue(MakeItem(0, 8)));
+        }
+
+        for (uint32 Index = 0; Index < 8; ++Index)
+        {
+            TEST_CHECK(Queue.Dequeue(Value) && Value == MakeItem(0, Index));
+        }
+        if constexpr (!IsBounded<Mode>())
+        {
+            TEST_CHECK(Queue.Dequeue(Value) && Value == MakeItem(0, 8));
+        }
+        TEST_CHECK(Queue.IsEmpty());
+
+        // 링을 여러 바퀴 돌아도 순서 유지
+        for (uint32 Index = 0; Index < 100; ++Index)
+        {
+            TEST_CHECK(Queue.Enqueue(Index));
+            TEST_CHECK(Queue.Enqueue(Index + 1000));
+            TEST_CHECK(Queue.Dequeue(Value) && Value == Index);
+            TEST_CHECK(Queue.Dequeue(Value) && Value == Index + 1000);
+        }
+
+        // 남은 원소 파괴
+        FTracked::NumAlive = 0;
+        {
+            using FTrackedQueue = TQueue<FTracked, Mode>;
+            FTrackedQueue TrackedQueue = [] { if constexpr (IsBounded<Mode>()) { return FTrackedQueue(16); } else { return FTrackedQueue(); } }();
+            for (int32 Index = 0; Index < 5; ++Index)
+            {
+                TrackedQueue.Enqueue(FTracked(Index));
+            }
+            TrackedQueue.Empty();
+            TEST_CHECK(TrackedQueue.IsEmpty());
+            for (int32 Index = 0; Index < 3; ++Index)
+            {
+                TrackedQueue.Enqueue(FTracked(Index));
+            }
+        }
+        TEST_CHECK(FTracked::NumAlive == 0);
+    }
+
+    void TestPeek()
+    {
+        TQueue<FString, EQueueMode::Mpsc> MpscQueue;
+        MpscQueue.Enqueue("a");
+        MpscQueue.Enqueue("b");
+        FString Value;
+        TEST_CHECK(MpscQueue.Peek(Value) && Value == "a");
+        TEST_CHECK(MpscQueue.Dequeue(Value) && Value == "a");
+        TEST_CHECK(MpscQueue.Peek(Value) && Value == "b");
+
+        TQueue<FString, EQueueMode::Spsc> SpscQueue(4);
+        SpscQueue.Enqueue("x");
+        TEST_CHECK(SpscQueue.Peek(Value) && Value == "x");
+        TEST_CHECK(SpscQueue.Num() == 1);
+    }
+
+    // 생산자 NumProducers개가 ItemsPerProducer개씩 넣고 소비자 NumConsumers개가 모두 꺼냄
+    // 소비자마다 생산자별로 마지막에 본 순번을 기록해 순서가 뒤집히지 않았는지 확인
+    template<EQueueMode Mode>
+    void TestConcurrent(uint32 NumProducers, uint32 NumConsumers, uint32 ItemsPerProducer, uint32 Capacity)
+    {
+        using FQueue = TQueue<uint64, Mode>;
+        FQueue Queue = [Capacity] { if constexpr (IsBounded<Mode>()) { return FQueue(Capacity); } else { return FQueue(); } }();
+
+        const uint64 TotalItems = uint64(NumProducers) * ItemsPerProducer;
+        std::atomic<uint64> NumConsumed{ 0 };
+        std::atomic<int32> NumOrderErrors{ 0 };
+        std::vector<std::atomic<uint8>> Seen(TotalItems);
+
+        std::vector<std::thread> Threads;
+        for (uint32 Producer = 0; Producer < NumProducers; ++Producer)
+        {
+            Threads.emplace_back([&, Producer]
+            {
+                for (uint32 Sequence = 0; Sequence < ItemsPerProducer; ++Sequence)
+                {
+                    while (!Queue.Enqueue(MakeItem(Producer, Sequence)))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (uint32 Consumer = 0; Consumer < NumConsumers; ++Consumer)
+        {
+            Threads.emplace_back([&]
+            {
+                std::vector<int64> LastSequence(NumProducers, -1);
+                uint64 Item = 0;
+                while (NumConsumed.load(std::memory_order_relaxed) < TotalItems)
+                {
+                    if (!Queue.Dequeue(Item))
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    NumConsumed.fetch_add(1, std::memory_order_relaxed);
+
+                    const uint32 Producer = uint32(Item >> 32);
+                    const uint32 Sequence = uint32(Item);
+                    if (Producer >= NumProducers || Sequence >= ItemsPerProducer || int64(Sequence) <= LastSequence[Producer])
+                    {
+                        ++NumOrderErrors;
+                        continue;
+                    }
+                    LastSequence[Producer] = Sequence;
+                    Seen[uint64(Producer) * ItemsPerProducer + Sequence].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (std::thread& Thread : Threads)
+        {
+            Thread.join();
+        }
+
+        uint64 NumExactlyOnce = 0;
+        for (const std::atomic<uint8>& Count : Seen)
+        {
+            NumExactlyOnce += Count.load() == 1 ? 1 : 0;
+        }
+
+        TEST_CHECK(NumOrderErrors == 0);
+        TEST_CHECK(NumExactlyOnce == TotalItems);
+        TEST_CHECK(Queue.IsEmpty());
+    }
+
+    // 처리량 기준선: 뮤텍스로 감싼 std::deque (예전 방식)
+    struct FLockedQueue
+    {
+        std::mutex Mutex;
+        std::deque<uint64> Items;
+
+        bool Enqueue(uint64 Item)
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            Items.push_back(Item);
+            return true;
+        }
+
+        bool Dequeue(uint64& OutItem)
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            if (Items.empty())
+            {
+                return false;
+            }
+            OutItem = Items.front();
+            Items.pop_front();
+            return true;
+        }
+    };
+
+    // 생산자/소비자가 바쁘게 돌며 TotalItems개를 전달하는 데 걸린 시간 → 초당 백만 개
+    template<typename QueueType>
+    double MeasureThroughput(QueueType& Queue, uint32 NumProducers, uint32 NumConsumers, uint32 ItemsPerProducer)
+    {
+        const uint64 TotalItems = uint64(NumProducers) * ItemsPerProducer;
+        std::atomic<uint64> NumConsumed{ 0 };
+        std::atomic<bool> bStart{ false };
+
+        std::vector<std::thread> Threads;
+        for (uint32 Producer = 0; Producer < NumProducers; ++Producer)
+        {
+            Threads.emplace_back([&, Producer]
+            {
+                while (!bStart.load(std::memory_order_acquire)) {}
+                for (uint32 Sequence = 0; Sequence < ItemsPerProducer; ++Sequence)
+                {
+                    while (!Queue.Enqueue(MakeItem(Producer, Sequence)))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (uint32 Consumer = 0; Consumer < NumConsumers; ++Consumer)
+        {
+            Threads.emplace_back([&]
+            {
+                while (!bStart.load(std::memory_order_acquire)) {}
+                uint64 Item = 0;
+                while (NumConsumed.load(std::memory_order_relaxed) < TotalItems)
+                {
+                    if (Queue.Dequeue(Item))
+                    {
+                        NumConsumed.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        MundiTest::FTimer Timer;
+        bStart.store(true, std::memory_order_release);
+        for (std::thread& Thread : Threads)
+        {
+            Thread.join();
+        }
+        return double(TotalItems) / (Timer.ElapsedMS() * 1000.0);
+    }
+
+    template<EQueueMode Mode>
+    void BenchMode(const char* ModeName, uint32 NumProducers, uint32 NumConsumers, uint32 ItemsPerProducer)
+    {
+        using FQueue = TQueue<uint64, Mode>;
+        FQueue Queue = [] { if constexpr (IsBounded<Mode>()) { return FQueue(1024); } else { return FQueue(); } }();
+        FLockedQueue LockedQueue;
+
+        const double QueueMops = MeasureThroughput(Queue, NumProducers, NumConsumers, ItemsPerProducer);
+        const double LockedMops = MeasureThroughput(LockedQueue, NumProducers, NumConsumers, ItemsPerProducer);
+        std::printf("  %-5s P%u C%u : TQueue %7.2f Mops/s | mutex+deque %7.2f Mops/s (x%.2f)\n",
+            ModeName, NumProducers, NumConsumers, QueueMops, LockedMops, LockedMops > 0.0 ? QueueMops / LockedMops : 0.0);
+    }
+
+    void RunBenchmarks()
+    {
+        const uint32 TotalItems = 2000000;
+        std::printf("[ConcurrentQueue Bench] %u items, hardware threads %u\n", TotalItems, std::thread::hardware_concurrency());
+
+        BenchMode<EQueueMode::Spsc>("Spsc", 1, 1, TotalItems);
+        for (uint32 NumProducers : { 2u, 4u, 8u })
+        {
+            BenchMode<EQueueMode::Mpsc>("Mpsc", NumProducers, 1, TotalItems / NumProducers);
+        }
+        for (uint32 NumConsumers : { 2u, 4u, 8u })
+        {
+            BenchMode<EQueueMode::Spmc>("Spmc", 1, NumConsumers, TotalItems);
+        }
+        for (uint32 NumThreads : { 2u, 4u, 8u })
+        {
+            BenchMode<EQueueMode::Mpmc>("Mpmc", NumThreads, NumThreads, TotalItems / NumThreads);
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestSingleThread<EQueueMode::Spsc>();
+    TestSingleThread<EQueueMode::Mpsc>();
+    TestSingleThread<EQueueMode::Mpmc>();
+    TestSingleThread<EQueueMode::Spmc>();
+    TestPeek();
+
+    // 작은 용량으로 가득 참/빔 경계를 자주 지나게 함
+    TestConcurrent<EQueueMode::Spsc>(1, 1, 200000, 64);
+    for (uint32 NumProducers : { 2u, 4u, 8u })
+    {
+        TestConcurrent<EQueueMode::Mpsc>(NumProducers, 1, 50000, 0);
+    }
+    for (uint32 NumConsumers : { 2u, 4u })
+    {
+        TestConcurrent<EQueueMode::Spmc>(1, NumConsumers, 100000, 64);
+    }
+    for (uint32 NumThreads : { 2u, 4u })
+    {
+        TestConcurrent<EQueueMode::Mpmc>(NumThreads, NumThreads, 50000, 64);
+    }
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunBenchmarks();
+    }
+    return MundiTest::Finish("ConcurrentQueueTests");
+}
@@ -0,0 +1,480 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "CookedMeshData.h"
+#include "MeshBVH.h"
+#include "PackedVertex.h"
+#include "WindowsBinReader.h"
+#include "WindowsBinWriter.h"
+
+// 쿠킹 컨테이너(.cooked) 스태틱 메시 검사
+// - 파일 맵핑은 Shim/windows.h (open + mmap)
+// - 정점 인코딩 세 가지(Full/Packed/Quantized) 왕복, 다른 인코딩 캐시 거부
+// - 손상된 섹션 테이블(2^64 근처로 넘치는 Offset, 잘린 파일) 거부
+// - 쿠킹된 메시 BVH: 다시 열었을 때 노드/삼각형 배열이 같음, ElementSize/버전/삼각형 수가 다르면 BVH만 버림
+// - --bench: 같은 메시를 변경 전 .bin(FWindowsBinReader + operator<<)과 .cooked로 읽는 시간 비교
+//            첫 피킹 지연 (BVH 지연 빌드 + 레이 하나 vs 쿠킹된 BVH 로드 + 레이 하나)
+
+namespace
+{
+    FString TempPath(const wchar_t* FileName)
+    {
+        std::error_code Ec;
+        return WideToUTF8((std::filesystem::temp_directory_path(Ec) / FileName).wstring());
+    }
+
+    /** 그룹 둘로 나뉜 격자 (Resolution x Resolution 사각형) */
+    FStaticMesh MakeGridMesh(int32 Resolution)
+    {
+        FStaticMesh Mesh;
+        Mesh.PathFileName = "Data/Model/TestGrid.obj";
+        Mesh.bHasMaterial = true;
+        for (int32 Y = 0; Y <= Resolution; ++Y)
+        {
+            for (int32 X = 0; X <= Resolution; ++X)
+            {
+                FNormalVertex Vertex{};
+                const float U = static_cast<float>(X) / Resolution;
+                const float V = static_cast<float>(Y) / Resolution;
+                Vertex.pos = FVector(U * 100.0f - 50.0f, V * 60.0f, std::sin(U * 6.0f) * 4.0f);
+                Vertex.normal = FVector(0.0f, 0.0f, 1.0f);
+                Vertex.tex = FVector2D(U, V);
+                Vertex.Tangent = FVector4(1.0f, 0.0f, 0.0f, 1.0f);
+                Vertex.color = FVector4(1.0f, 1.0f, 1.0f, 1.0f);
+                Mesh.Vertices.push_back(Vertex);
+            }
+        }
+        for (int32 Y = 0; Y < Resolution; ++Y)
+        {
+            for (int32 X = 0; X < Resolution; ++X)
+            {
+                const uint32 I0 = Y * (Resolution + 1) + X;
+                const uint32 I1 = I0 + 1;
+                const uint32 I2 = I0 + Resolution + 1;
+                const uint32 I3 = I2 + 1;
+                Mesh.Indices.insert(Mesh.Indices.end(), { I0, I2, I1, I1, I2, I3 });
+            }
+        }
+
+        const uint32 Half = static_cast<uint32>(Mesh.Indices.size()) / 6 / 2 * 6;
+        Mesh.GroupInfos.push_back({ 0, Half, "GridA" });
+        Mesh.GroupInfos.push_back({ Half, static_cast<uint32>(Mesh.Indices.size()) - Half, "GridB" });
+        return Mesh;
+    }
+
+    bool SameGroups(const FStaticMesh& A, const FStaticMesh& B)
+    {
+        if (A.GroupInfos.size() != B.GroupInfos.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < A.GroupInfos.size(); ++i)
+        {
+            const FGroupInfo& GroupA = A.GroupInfos[i];
+            const FGroupInfo& GroupB = B.GroupInfos[i];
+            if (GroupA.StartIndex != GroupB.StartIndex || GroupA.IndexCount != GroupB.IndexCount || GroupA.InitialMaterialName != GroupB.InitialMaterialName)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float MaxPositionError(const FStaticMesh& A, const FStaticMesh& B)
+    {
+        float MaxError = 0.0f;
+        for (size_t i = 0; i < A.Vertices.size(); ++i)
+        {
+            const FVector& PA = A.Vertices[i].pos;
+            const FVector& PB = B.Vertices[i].pos;
+            MaxError = std::max({ MaxError, std::abs(PA.X - PB.X), std::abs(PA.Y - PB.Y), std::abs(PA.Z - PB.Z) });
+        }
+        return MaxError;
+    }
+
+    void SetEncoding(bool bPacked, bool bQuantized)
+    {
+        PackedVertex::SetEnabled(bPacked);
+        PackedVertex::SetPositionQuantizationEnabled(bQuantized);
+    }
+
+    void TestRoundTrip()
+    {
+        const FStaticMesh Source = MakeGridMesh(32);
+        const FString CookedPath = TempPath(L"MundiCookedMeshTest.obj.cooked");
+
+        // 1) Full: 정점까지 비트 단위로 같음
+        SetEncoding(false, false);
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+        FStaticMesh Loaded;
+        TEST_CHECK(CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+        TEST_CHECK(Loaded.PathFileName == Source.PathFileName);
+        TEST_CHECK(Loaded.bHasMaterial == Source.bHasMaterial);
+        TEST_CHECK(Loaded.Indices == Source.Indices);
+        TEST_CHECK(SameGroups(Loaded, Source));
+        TEST_CHECK(Loaded.Vertices.size() == Source.Vertices.size()
+            && std::memcmp(Loaded.Vertices.data(), Source.Vertices.data(), sizeof(FNormalVertex) * Source.Vertices.size()) == 0);
+
+        // 설정이 바뀌면 이전 인코딩 캐시는 로드 실패 (호출부가 재생성)
+        SetEncoding(true, false);
+        FStaticMesh Rejected;
+        TEST_CHECK(!CookedMeshData::LoadStaticMesh(CookedPath, Rejected));
+
+        // 2) Packed: 위치는 float 그대로
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+        Loaded = FStaticMesh();
+        TEST_CHECK(CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+        TEST_CHECK(Loaded.Indices == Source.Indices && SameGroups(Loaded, Source));
+        TEST_CHECK(Loaded.Vertices.size() == Source.Vertices.size() && MaxPositionError(Loaded, Source) == 0.0f);
+
+        // 3) Quantized: 축마다 Extent / 65535의 절반 + float 오차
+        SetEncoding(true, true);
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+        Loaded = FStaticMesh();
+        TEST_CHECK(CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+        TEST_CHECK(Loaded.Indices == Source.Indices && SameGroups(Loaded, Source));
+        TEST_CHECK(Loaded.Vertices.size() == Source.Vertices.size() && MaxPositionError(Loaded, Source) <= 100.0f / 131070.0f + 1e-4f);
+
+        SetEncoding(false, false);
+        std::error_code Ec;
+        std::filesystem::remove(UTF8ToWide(CookedPath), Ec);
+    }
+
+    TArray<uint8> ReadFileBytes(const FString& Path)
+    {
+        std::ifstream File(Path, std::ios::binary);
+        return TArray<uint8>(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+    }
+
+    void WriteFileBytes(const FString& Path, const TArray<uint8>& Bytes)
+    {
+        std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+        File.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+    }
+
+    void TestCorruptFilesRejected()
+    {
+        SetEncoding(false, false);
+        const FStaticMesh Source = MakeGridMesh(8);
+        const FString CookedPath = TempPath(L"MundiCookedMeshCorrupt.obj.cooked");
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+        const TArray<uint8> Original = ReadFileBytes(CookedPath);
+        TEST_CHECK(Original.size() > sizeof(FCookedAssetHeader) + sizeof(FCookedSectionEntry));
+
+        FStaticMesh Loaded;
+
+        // Offset + 크기가 2^64를 넘겨 작은 값으로 돌아오는 섹션 (정렬은 유지)
+        TArray<uint8> Bytes = Original;
+        FCookedSectionEntry Entry;
+        std::memcpy(&Entry, Bytes.data() + sizeof(FCookedAssetHeader), sizeof(Entry));
+        Entry.Offset = ~uint64(0) - (CookedAsset::SectionAlignment - 1);
+        std::memcpy(Bytes.data() + sizeof(FCookedAssetHeader), &Entry, sizeof(Entry));
+        WriteFileBytes(CookedPath, Bytes);
+        TEST_CHECK(!CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+
+        // 잘린 파일 (헤더의 FileSize와 다름)
+        Bytes = Original;
+        Bytes.resize(Bytes.size() - 16);
+        WriteFileBytes(CookedPath, Bytes);
+        TEST_CHECK(!CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+
+        // 다른 에셋 종류
+        WriteFileBytes(CookedPath, Original);
+        FSkeletalMeshData WrongType;
+        TEST_CHECK(!CookedMeshData::LoadSkeletalMesh(CookedPath, WrongType));
+        TEST_CHECK(CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+
+        std::error_code Ec;
+        std::filesystem::remove(UTF8ToWide(CookedPath), Ec);
+    }
+
+    /** 섹션 테이블에서 Tag 항목의 파일 내 위치 (없으면 0) */
+    size_t FindSectionEntry(const TArray<uint8>& Bytes, uint32 Tag)
+    {
+        FCookedAssetHeader Header;
+        std::memcpy(&Header, Bytes.data(), sizeof(Header));
+        for (uint32 Index = 0; Index < Header.NumSections; ++Index)
+        {
+            const size_t EntryOffset = sizeof(FCookedAssetHeader) + Index * sizeof(FCookedSectionEntry);
+            FCookedSectionEntry Entry;
+            std::memcpy(&Entry, Bytes.data() + EntryOffset, sizeof(Entry));
+            if (Entry.Tag == Tag)
+            {
+                return EntryOffset;
+            }
+        }
+        return 0;
+    }
+
+    FRay MakeDownRay(float X, float Y)
+    {
+        FRay Ray;
+        Ray.Origin = FVector(X, Y, 50.0f);
+        Ray.Direction = FVector(0.0f, 0.0f, -1.0f);
+        return Ray;
+    }
+
+    void TestMeshBVHRoundTrip()
+    {
+        SetEncoding(false, false);
+        FStaticMesh Source = MakeGridMesh(48);
+        Source.MeshBVH = std::make_shared<FMeshBVH>();
+        Source.MeshBVH->Build(Source.Vertices, Source.Indices);
+        TEST_CHECK(!Source.MeshBVH->IsEmpty());
+
+        const FString CookedPath = TempPath(L"MundiCookedMeshBVH.obj.cooked");
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+
+        FStaticMesh Loaded;
+        TEST_CHECK(CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+        TEST_CHECK(Loaded.MeshBVH != nullptr);
+        if (Loaded.MeshBVH)
+        {
+            const TArray<FMeshBVHNode>& SourceNodes = Source.MeshBVH->GetNodes();
+            const TArray<FMeshBVHNode>& LoadedNodes = Loaded.MeshBVH->GetNodes();
+            TEST_CHECK(LoadedNodes.size() == SourceNodes.size()
+                && std::memcmp(LoadedNodes.data(), SourceNodes.data(), sizeof(FMeshBVHNode) * SourceNodes.size()) == 0);
+            TEST_CHECK(Loaded.MeshBVH->GetTriIndices() == Source.MeshBVH->GetTriIndices());
+            TEST_CHECK(Loaded.MeshBVH->GetMaxDepth() == Source.MeshBVH->GetMaxDepth());
+
+            // 같은 레이는 같은 삼각형/거리
+            for (int32 Step = 0; Step < 16; ++Step)
+            {
+                const FRay Ray = MakeDownRay(-45.0f + Step * 6.0f, 3.0f + Step * 3.5f);
+                FMeshRayHit SourceHit;
+                FMeshRayHit LoadedHit;
+                const bool bSourceHit = Source.MeshBVH->IntersectRay(Ray, Source.Vertices, Source.Indices, SourceHit);
+                const bool bLoadedHit = Loaded.MeshBVH->IntersectRay(Ray, Loaded.Vertices, Loaded.Indices, LoadedHit);
+                TEST_CHECK(bSourceHit && bLoadedHit);
+                TEST_CHECK(SourceHit.TriangleIndex == LoadedHit.TriangleIndex && SourceHit.Distance == LoadedHit.Distance);
+            }
+        }
+
+        // BVH 없이 쿠킹한 파일은 섹션 없음 → nullptr (호출부에서 지연 빌드)
+        FStaticMesh NoBVHSource = MakeGridMesh(8);
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(NoBVHSource, CookedPath));
+        Loaded = FStaticMesh();
+        TEST_CHECK(CookedMeshData::LoadStaticMesh(CookedPath, Loaded));
+        TEST_CHECK(Loaded.MeshBVH == nullptr);
+
+        std::error_code Ec;
+        std::filesystem::remove(UTF8ToWide(CookedPath), Ec);
+    }
+
+    /** BVH 섹션만 손상된 파일: 메시는 로드되고 BVH는 버려짐 */
+    void TestStaleMeshBVHRejected()
+    {
+        SetEncoding(false, false);
+        FStaticMesh Source = MakeGridMesh(16);
+        Source.MeshBVH = std::make_shared<FMeshBVH>();
+        Source.MeshBVH->Build(Source.Vertices, Source.Indices);
+
+        const FString CookedPath = TempPath(L"MundiCookedMeshBVHStale.obj.cooked");
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+        const TArray<uint8> Original = ReadFileBytes(CookedPath);
+
+        const size_t NodesEntryOffset = FindSectionEntry(Original, CookedAsset::MakeTag('B', 'V', 'H', 'N'));
+        const size_t MetaEntryOffset = FindSectionEntry(Original, CookedAsset::MakeTag('B', 'V', 'H', 'M'));
+        TEST_CHECK(NodesEntryOffset != 0 && MetaEntryOffset != 0);
+        if (NodesEntryOffset == 0 || MetaEntryOffset == 0)
+        {
+            return;
+        }
+
+        auto LoadPatched = [&](const TArray<uint8>& Bytes, FStaticMesh& OutMesh)
+        {
+            WriteFileBytes(CookedPath, Bytes);
+            OutMesh = FStaticMesh();
+            return CookedMeshData::LoadStaticMesh(CookedPath, OutMesh);
+        };
+
+        // 1) 노드 레이아웃이 바뀐 캐시 (ElementSize 불일치): 파일 범위는 그대로라 Open은 성공
+        TArray<uint8> Bytes = Original;
+        FCookedSectionEntry NodesEntry;
+        std::memcpy(&NodesEntry, Bytes.data() + NodesEntryOffset, sizeof(NodesEntry));
+        TEST_CHECK(NodesEntry.ElementSize == sizeof(FMeshBVHNode));
+        NodesEntry.ElementSize = sizeof(FMeshBVHNode) / 2;
+        std::memcpy(Bytes.data() + NodesEntryOffset, &NodesEntry, sizeof(NodesEntry));
+        {
+            WriteFileBytes(CookedPath, Bytes);
+            FCookedAssetFile File;
+            TEST_CHECK(File.Open(CookedPath, ECookedAssetType::StaticMesh));
+            TArray<FMeshBVHNode> Nodes;
+            TEST_CHECK(!File.ReadArray(NodesEntry.Tag, Nodes));
+        }
+        FStaticMesh Loaded;
+        TEST_CHECK(LoadPatched(Bytes, Loaded));
+        TEST_CHECK(Loaded.Indices == Source.Indices && Loaded.MeshBVH == nullptr);
+
+        // 2) 빌더 버전이 다름 (FCookedMeshBVHMeta::Version은 섹션 첫 4바이트)
+        FCookedSectionEntry MetaEntry;
+        std::memcpy(&MetaEntry, Original.data() + MetaEntryOffset, sizeof(MetaEntry));
+        Bytes = Original;
+        const uint32 StaleVersion = FMeshBVH::CookVersion + 1;
+        std::memcpy(Bytes.data() + MetaEntry.Offset, &StaleVersion, sizeof(StaleVersion));
+        TEST_CHECK(LoadPatched(Bytes, Loaded));
+        TEST_CHECK(Loaded.Indices == Source.Indices && Loaded.MeshBVH == nullptr);
+
+        // 3) 삼각형 수가 다름 (다른 메시에서 빌드된 BVH)
+        Bytes = Original;
+        const uint32 WrongTriangles = static_cast<uint32>(Source.Indices.size() / 3) - 1;
+        std::memcpy(Bytes.data() + MetaEntry.Offset + sizeof(uint32), &WrongTriangles, sizeof(WrongTriangles));
+        TEST_CHECK(LoadPatched(Bytes, Loaded));
+        TEST_CHECK(Loaded.Indices == Source.Indices && Loaded.MeshBVH == nullptr);
+
+        // 4) 범위를 벗어난 자식 노드 → InitFromCooked 실패
+        Bytes = Original;
+        FMeshBVHNode Root;
+        std::memcpy(&Root, Bytes.data() + NodesEntry.Offset, sizeof(Root));
+        TEST_CHECK(!Root.IsLeaf());
+        Root.LeftOrStart = 0x7FFFFFFFu;
+        std::memcpy(Bytes.data() + NodesEntry.Offset, &Root, sizeof(Root));
+        TEST_CHECK(LoadPatched(Bytes, Loaded));
+        TEST_CHECK(Loaded.Indices == Source.Indices && Loaded.MeshBVH == nullptr);
+
+        // 원본은 그대로 로드
+        TEST_CHECK(LoadPatched(Original, Loaded));
+        TEST_CHECK(Loaded.MeshBVH != nullptr);
+
+        std::error_code Ec;
+        std::filesystem::remove(UTF8ToWide(CookedPath), Ec);
+    }
+
+    /** 변경 전 .bin 캐시와 .cooked 읽기 비교 (.bin에는 LOD/BVH가 없으므로 둘 다 같은 내용) */
+    void RunLoadBenchmark()
+    {
+        SetEncoding(false, false);
+        const int32 NumIterations = 20;
+        const FStaticMesh Source = MakeGridMesh(400);
+        const FString BinPath = TempPath(L"MundiCookedLoadBench.obj.bin");
+        const FString CookedPath = TempPath(L"MundiCookedLoadBench.obj.cooked");
+
+        {
+            FWindowsBinWriter Writer(BinPath);
+            FStaticMesh Copy = Source;
+            Writer << Copy;
+            Writer.Close();
+        }
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+
+        std::error_code Ec;
+        const uint64 BinBytes = std::filesystem::file_size(UTF8ToWide(BinPath), Ec);
+        const uint64 CookedBytes = std::filesystem::file_size(UTF8ToWide(CookedPath), Ec);
+
+        FStaticMesh BinMesh;
+        FStaticMesh CookedMesh;
+        double BinMS = 0.0;
+        double CookedMS = 0.0;
+        bool bCookedLoaded = true;
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+        {
+            // 1. 변경 전: 스트림에서 필드/배열 단위로 읽기
+            BinMesh = FStaticMesh();
+            MundiTest::FTimer BinTimer;
+            {
+                FWindowsBinReader Reader(BinPath);
+                Reader << BinMesh;
+                Reader.Close();
+            }
+            BinMS += BinTimer.ElapsedMS();
+
+            // 2. 쿠킹 컨테이너 (두 번째 반복부터는 OS 파일 캐시에 올라간 상태)
+            CookedMesh = FStaticMesh();
+            MundiTest::FTimer CookedTimer;
+            bCookedLoaded &= CookedMeshData::LoadStaticMesh(CookedPath, CookedMesh);
+            CookedMS += CookedTimer.ElapsedMS();
+        }
+        BinMS /= NumIterations;
+        CookedMS /= NumIterations;
+
+        std::printf("[Cooked Load Bench] %d vertices, %d indices, %d iterations\n",
+            static_cast<int32>(Source.Vertices.size()), static_cast<int32>(Source.Indices.size()), NumIterations);
+        std::printf("  .bin    : %8.1f KB, %.3f ms\n", static_cast<double>(BinBytes) / 1024.0, BinMS);
+        std::printf("  .cooked : %8.1f KB, %.3f ms (x%.1f)\n", static_cast<double>(CookedBytes) / 1024.0, CookedMS, CookedMS > 0.0 ? BinMS / CookedMS : 0.0);
+
+        TEST_CHECK(bCookedLoaded);
+        TEST_CHECK(BinMesh.Indices == CookedMesh.Indices && SameGroups(BinMesh, CookedMesh));
+        TEST_CHECK(BinMesh.Vertices.size() == CookedMesh.Vertices.size()
+            && std::memcmp(BinMesh.Vertices.data(), CookedMesh.Vertices.data(), sizeof(FNormalVertex) * BinMesh.Vertices.size()) == 0);
+
+        std::filesystem::remove(UTF8ToWide(BinPath), Ec);
+        std::filesystem::remove(UTF8ToWide(CookedPath), Ec);
+    }
+    /**
+     * 첫 피킹 지연: 쿠킹된 BVH가 없으면 첫 레이 전에 BVH를 빌드해야 함
+     * 변경 전 = 메시 로드 + Build + 레이 하나, 변경 후 = BVH 포함 메시 로드(검증 포함) + 레이 하나
+     */
+    void RunFirstPickBenchmark()
+    {
+        SetEncoding(false, false);
+        const int32 NumIterations = 5;
+        FStaticMesh Source = MakeGridMesh(400);
+        Source.MeshBVH = std::make_shared<FMeshBVH>();
+        Source.MeshBVH->Build(Source.Vertices, Source.Indices);
+
+        const FString LazyPath = TempPath(L"MundiFirstPickLazy.obj.cooked");
+        const FString CookedPath = TempPath(L"MundiFirstPickCooked.obj.cooked");
+        {
+            FStaticMesh NoBVH = Source;
+            NoBVH.MeshBVH.reset();
+            TEST_CHECK(CookedMeshData::SaveStaticMesh(NoBVH, LazyPath));
+        }
+        TEST_CHECK(CookedMeshData::SaveStaticMesh(Source, CookedPath));
+
+        const FRay Ray = MakeDownRay(3.0f, 29.0f);
+        double LazyMS = 0.0;
+        double CookedMS = 0.0;
+        bool bSameHit = true;
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+        {
+            FMeshRayHit LazyHit;
+            MundiTest::FTimer LazyTimer;
+            {
+                FStaticMesh Mesh;
+                CookedMeshData::LoadStaticMesh(LazyPath, Mesh);
+                FMeshBVH BVH;
+                BVH.Build(Mesh.Vertices, Mesh.Indices);
+                BVH.IntersectRay(Ray, Mesh.Vertices, Mesh.Indices, LazyHit);
+            }
+            LazyMS += LazyTimer.ElapsedMS();
+
+            FMeshRayHit CookedHit;
+            MundiTest::FTimer CookedTimer;
+            {
+                FStaticMesh Mesh;
+                CookedMeshData::LoadStaticMesh(CookedPath, Mesh);
+                if (Mesh.MeshBVH)
+                {
+                    Mesh.MeshBVH->IntersectRay(Ray, Mesh.Vertices, Mesh.Indices, CookedHit);
+                }
+            }
+            CookedMS += CookedTimer.ElapsedMS();
+            bSameHit &= LazyHit.TriangleIndex == CookedHit.TriangleIndex && LazyHit.Distance == CookedHit.Distance;
+        }
+        LazyMS /= NumIterations;
+        CookedMS /= NumIterations;
+
+        std::printf("[First Pick Bench] %d triangles, %d iterations\n", static_cast<int32>(Source.Indices.size() / 3), NumIterations);
+        std::printf("  load + build + ray : %.3f ms\n", LazyMS);
+        std::printf("  load cooked + ray  : %.3f ms (x%.1f)\n", CookedMS, CookedMS > 0.0 ? LazyMS / CookedMS : 0.0);
+        TEST_CHECK(bSameHit);
+
+        std::error_code Ec;
+        std::filesystem::remove(UTF8ToWide(LazyPath), Ec);
+        std::filesystem::remove(UTF8ToWide(CookedPath), Ec);
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestRoundTrip();
+    TestCorruptFilesRejected();
+    TestMeshBVHRoundTrip();
+    TestStaleMeshBVHRejected();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunLoadBenchmark();
+        RunFirstPickBenchmark();
+    }
+    return MundiTest::Finish("CookedMeshDataTests");
+}
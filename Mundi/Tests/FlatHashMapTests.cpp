@@ -0,0 +1,320 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include <random>
+#include <unordered_map>
+
+// TFlatMap / TFlatSet 검사
+// - 무작위 Add/Remove/Find 연산을 std::unordered_map 기준과 비교 (삭제 시 swap-remove, backward-shift 경로 포함)
+// - 순회 중 erase(iterator), Reset 후 재사용, 문자열 키
+// - --bench: 1k/100k/1M 항목에서 insert/find(hit)/find(miss)/iterate/erase를 TMap/TSet과 비교
+
+namespace
+{
+    // 작은 키 범위로 같은 키의 재삽입/재삭제가 자주 일어나게 함
+    void TestRandomOpsAgainstReference(uint32 Seed, int32 NumOps, uint32 KeyRange)
+    {
+        std::mt19937 Rng(Seed);
+        std::uniform_int_distribution<uint32> KeyDist(0, KeyRange - 1);
+        std::uniform_int_distribution<int32> OpDist(0, 9);
+
+        TFlatMap<uint32, int32> Map;
+        TFlatSet<uint32> Set;
+        std::unordered_map<uint32, int32> Reference;
+
+        for (int32 Op = 0; Op < NumOps; ++Op)
+        {
+            const uint32 Key = KeyDist(Rng);
+            const int32 Kind = OpDist(Rng);
+            if (Kind < 4)
+            {
+                Map.Add(Key, Op);
+                Set.Add(Key);
+                Reference[Key] = Op;
+            }
+            else if (Kind < 7)
+            {
+                const bool bRemoved = Map.Remove(Key);
+                TEST_CHECK(bRemoved == (Reference.erase(Key) == 1));
+                TEST_CHECK(Set.Remove(Key) == bRemoved);
+            }
+            else
+            {
+                const int32* Found = Map.Find(Key);
+                auto It = Reference.find(Key);
+                TEST_CHECK((Found != nullptr) == (It != Reference.end()));
+                TEST_CHECK(!Found || *Found == It->second);
+                TEST_CHECK(Set.Contains(Key) == (It != Reference.end()));
+            }
+        }
+
+        TEST_CHECK(Map.Num() == int32(Reference.size()));
+        TEST_CHECK(Set.Num() == int32(Reference.size()));
+
+        // 순회는 모든 요소를 한 번씩
+        size_t NumVisited = 0;
+        for (const auto& Pair : Map)
+        {
+            auto It = Reference.find(Pair.first);
+            TEST_CHECK(It != Reference.end() && It->second == Pair.second);
+            ++NumVisited;
+        }
+        TEST_CHECK(NumVisited == Reference.size());
+        for (uint32 Key : Set)
+        {
+            TEST_CHECK(Reference.count(Key) == 1);
+        }
+    }
+
+    void TestIterateErase()
+    {
+        TFlatMap<int32, int32> Map;
+        for (int32 Index = 0; Index < 1000; ++Index)
+        {
+            Map.Add(Index, Index * 2);
+        }
+
+        // 짝수 키만 지움. erase가 돌려준 반복자로 계속 (swap-remove로 옮겨온 요소도 검사되어야 함)
+        for (auto It = Map.begin(); It != Map.end();)
+        {
+            if (It->first % 2 == 0)
+            {
+                It = Map.erase(It);
+            }
+            else
+            {
+                ++It;
+            }
+        }
+        TEST_CHECK(Map.Num() == 500);
+        for (int32 Index = 0; Index < 1000; ++Index)
+        {
+            TEST_CHECK(Map.Contains(Index) == (Index % 2 == 1));
+        }
+
+        // Reset은 용량을 유지하고 다시 채울 수 있어야 함
+        Map.Reset();
+        TEST_CHECK(Map.Num() == 0 && !Map.Contains(1));
+        Map.FindOrAdd(7) = 70;
+        TEST_CHECK(Map.FindRef(7) == 70 && Map.Num() == 1);
+    }
+
+    void TestStringKeys()
+    {
+        TFlatMap<FString, int32> Map;
+        for (int32 Index = 0; Index < 5000; ++Index)
+        {
+            Map.Add("Key_" + std::to_string(Index), Index);
+        }
+        for (int32 Index = 0; Index < 5000; Index += 3)
+        {
+            TEST_CHECK(Map.Remove("Key_" + std::to_string(Index)));
+        }
+        for (int32 Index = 0; Index < 5000; ++Index)
+        {
+            const int32* Found = Map.Find("Key_" + std::to_string(Index));
+            TEST_CHECK((Found != nullptr) == (Index % 3 != 0));
+            TEST_CHECK(!Found || *Found == Index);
+        }
+    }
+
+    // 최적화로 조회가 지워지지 않도록 결과를 흘려 보냄
+    volatile size_t GSink = 0;
+
+    // 벤치마크: 포인터 키 (엔진 hot path의 컴포넌트/리소스 포인터 키와 같은 형태)
+    struct FBenchTimes
+    {
+        double InsertMS = 0.0;
+        double FindHitMS = 0.0;
+        double FindMissMS = 0.0;
+        double IterateMS = 0.0;
+        double EraseMS = 0.0;
+    };
+
+    template<typename MapType>
+    FBenchTimes BenchMap(const std::vector<void*>& Keys, const std::vector<void*>& ShuffledKeys, const std::vector<void*>& MissKeys)
+    {
+        FBenchTimes Times;
+        MapType Map;
+        size_t Sink = 0;
+
+        MundiTest::FTimer Timer;
+        for (void* Key : Keys)
+        {
+            Map.Add(Key, 1.0f);
+        }
+        Times.InsertMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        for (void* Key : ShuffledKeys)
+        {
+            Sink += Map.Find(Key) != nullptr;
+        }
+        Times.FindHitMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        for (void* Key : MissKeys)
+        {
+            Sink += Map.Find(Key) != nullptr;
+        }
+        Times.FindMissMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        float Sum = 0.0f;
+        for (const auto& Pair : Map)
+        {
+            Sum += Pair.second;
+        }
+        Sink += size_t(Sum);
+        Times.IterateMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        for (void* Key : ShuffledKeys)
+        {
+            Map.Remove(Key);
+        }
+        Times.EraseMS = Timer.ElapsedMS();
+        GSink = Sink;
+        return Times;
+    }
+
+    template<typename SetType>
+    FBenchTimes BenchSet(const std::vector<void*>& Keys, const std::vector<void*>& ShuffledKeys, const std::vector<void*>& MissKeys)
+    {
+        FBenchTimes Times;
+        SetType Set;
+        size_t Sink = 0;
+
+        MundiTest::FTimer Timer;
+        for (void* Key : Keys)
+        {
+            Set.Add(Key);
+        }
+        Times.InsertMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        for (void* Key : ShuffledKeys)
+        {
+            Sink += Set.Contains(Key);
+        }
+        Times.FindHitMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        for (void* Key : MissKeys)
+        {
+            Sink += Set.Contains(Key);
+        }
+        Times.FindMissMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        for (void* Key : Set)
+        {
+            Sink += reinterpret_cast<size_t>(Key);
+        }
+        Times.IterateMS = Timer.ElapsedMS();
+
+        Timer = MundiTest::FTimer();
+        for (void* Key : ShuffledKeys)
+        {
+            Set.Remove(Key);
+        }
+        Times.EraseMS = Timer.ElapsedMS();
+        GSink = Sink;
+        return Times;
+    }
+
+    void PrintTimes(const char* Name, int32 Num, const FBenchTimes& Times, const FBenchTimes& Baseline)
+    {
+        auto NS = [Num](double MS) { return MS * 1e6 / Num; };
+        std::printf("  %-8s N=%-7d ns/op  insert %6.1f (x%.2f)  find hit %6.1f (x%.2f)  find miss %6.1f (x%.2f)  iterate %5.2f (x%.2f)  erase %6.1f (x%.2f)\n",
+            Name, Num,
+            NS(Times.InsertMS), Baseline.InsertMS / Times.InsertMS,
+            NS(Times.FindHitMS), Baseline.FindHitMS / Times.FindHitMS,
+            NS(Times.FindMissMS), Baseline.FindMissMS / Times.FindMissMS,
+            NS(Times.IterateMS), Baseline.IterateMS / Times.IterateMS,
+            NS(Times.EraseMS), Baseline.EraseMS / Times.EraseMS);
+    }
+
+    // 삽입은 주어진 순서, 조회/삭제는 섞은 순서로 네 컨테이너 측정
+    void RunBenchmark(const char* Label, const std::vector<void*>& Keys, std::vector<void*> MissKeys)
+    {
+        const int32 Num = int32(Keys.size());
+        std::vector<void*> ShuffledKeys = Keys;
+        std::mt19937 Rng(3);
+        std::shuffle(ShuffledKeys.begin(), ShuffledKeys.end(), Rng);
+        std::shuffle(MissKeys.begin(), MissKeys.end(), Rng);
+
+        // 1k는 한 번으로는 너무 짧아 타이머 해상도에 묻히므로 여러 번 돌린 최소값
+        const int32 NumRepeats = Num <= 1000 ? 50 : 3;
+        auto Best = [NumRepeats](auto&& Run)
+        {
+            FBenchTimes Result = Run();
+            for (int32 Repeat = 1; Repeat < NumRepeats; ++Repeat)
+            {
+                const FBenchTimes Times = Run();
+                Result.InsertMS = std::min(Result.InsertMS, Times.InsertMS);
+                Result.FindHitMS = std::min(Result.FindHitMS, Times.FindHitMS);
+                Result.FindMissMS = std::min(Result.FindMissMS, Times.FindMissMS);
+                Result.IterateMS = std::min(Result.IterateMS, Times.IterateMS);
+                Result.EraseMS = std::min(Result.EraseMS, Times.EraseMS);
+            }
+            return Result;
+        };
+
+        const FBenchTimes MapTimes = Best([&] { return BenchMap<TMap<void*, float>>(Keys, ShuffledKeys, MissKeys); });
+        const FBenchTimes FlatMapTimes = Best([&] { return BenchMap<TFlatMap<void*, float>>(Keys, ShuffledKeys, MissKeys); });
+        const FBenchTimes SetTimes = Best([&] { return BenchSet<TSet<void*>>(Keys, ShuffledKeys, MissKeys); });
+        const FBenchTimes FlatSetTimes = Best([&] { return BenchSet<TFlatSet<void*>>(Keys, ShuffledKeys, MissKeys); });
+
+        std::printf(" %s\n", Label);
+        PrintTimes("TMap", Num, MapTimes, MapTimes);
+        PrintTimes("TFlatMap", Num, FlatMapTimes, MapTimes);
+        PrintTimes("TSet", Num, SetTimes, SetTimes);
+        PrintTimes("TFlatSet", Num, FlatSetTimes, SetTimes);
+    }
+
+    void RunBenchmarks()
+    {
+        std::printf("[FlatHashMap Bench] ns/op, (xN) = speedup over TMap/TSet\n");
+        for (int32 Num : { 1000, 100000, 1000000 })
+        {
+            // 1) 실제 힙 주소를 할당 순서대로 삽입
+            //    std::hash<void*>는 항등 함수라 TMap/TSet은 주소가 가까운 키끼리 버킷도 가까움 → 캐시에 유리
+            //    TFlatMap은 해시를 섞으므로 이 이점이 없음
+            std::vector<std::unique_ptr<int32>> Storage(size_t(Num) * 2);
+            std::vector<void*> Keys(Num);
+            std::vector<void*> MissKeys(Num);
+            for (int32 Index = 0; Index < Num; ++Index)
+            {
+                Storage[size_t(Index) * 2] = std::make_unique<int32>(Index);
+                Storage[size_t(Index) * 2 + 1] = std::make_unique<int32>(Index);
+                Keys[Index] = Storage[size_t(Index) * 2].get();
+                MissKeys[Index] = Storage[size_t(Index) * 2 + 1].get();
+            }
+            RunBenchmark("heap address keys (allocation order)", Keys, MissKeys);
+
+            // 2) 주소 지역성이 없는 키 (오래 돌아 단편화된 힙, 해시된 ID 등)
+            std::mt19937_64 Rng(Num);
+            for (int32 Index = 0; Index < Num; ++Index)
+            {
+                Keys[Index] = reinterpret_cast<void*>(Rng() | 1);
+                MissKeys[Index] = reinterpret_cast<void*>(Rng() & ~uint64(1));
+            }
+            RunBenchmark("random 64-bit keys", Keys, MissKeys);
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestRandomOpsAgainstReference(1, 200000, 64);
+    TestRandomOpsAgainstReference(2, 200000, 5000);
+    TestRandomOpsAgainstReference(3, 500000, 1u << 30);
+    TestIterateErase();
+    TestStringKeys();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunBenchmarks();
+    }
+    return MundiTest::Finish("FlatHashMapTests");
+}
@@ -0,0 +1,391 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "MeshAutoInstancing.h"
+#include "MeshBatchSort.h"
+#include "MeshDrawStats.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <random>
+
+// 자동 GPU 인스턴싱(FMeshAutoInstancing) 검사
+// - 배치의 셰이더/머티리얼/버퍼는 가짜 포인터 값 (합치기와 정렬은 포인터를 비교만 함)
+// - 고정 배치: 같은 섹션 5개 → 인스턴싱 셰이더/입력 레이아웃으로 바뀐 드로우 하나 (InstanceStart/Count, 통계)
+//   한 개뿐인 구간, 인스턴싱 변형이 없는 배치, GPU 스키닝, 파티클 인스턴싱, SubUV, 빌보드 정렬,
+//   인스턴스 SRV/섹션이 다른 배치는 합쳐지지 않고 그대로 남음
+// - 인스턴스 데이터: 월드 행렬, 노멀 행렬(월드 x 노멀 행렬^T = 단위), 색상, ObjectID가 원래 배치와 같음
+// - 무작위 장면 (메시 3개 x 섹션 2개, 10%는 인스턴싱 불가): FMeshBatchSorter(Opaque)로 정렬 후 합치기
+//   모든 ObjectID가 정확히 한 번 (단독 드로우 또는 인스턴스), 합친 드로우의 인스턴스는 모두 그 드로우와 같은 상태,
+//   이웃한 드로우끼리 더 합칠 수 있는 경우가 없음, 드로우 수 = 상태 그룹 수 + 인스턴싱 불가 배치 수
+// - 직렬(TaskGraph 초기화 전)과 4 워커의 인스턴스 데이터가 같음
+// - RHI 없이 업로드하면 아무것도 바인딩하지 않고 false
+
+namespace
+{
+	template<typename T>
+	T* FakePointer(uintptr_t Value)
+	{
+		return reinterpret_cast<T*>(Value);
+	}
+
+	// 인스턴싱 가능한 스태틱 메시 섹션 (같은 Mesh/Section이면 합쳐질 수 있음)
+	FMeshBatchElement MakeStaticBatch(uint32 Mesh, uint32 Section, uint32 ObjectID, const FVector& Location)
+	{
+		FMeshBatchElement Batch;
+		Batch.VertexShader = FakePointer<ID3D11VertexShader>(0x100);
+		Batch.PixelShader = FakePointer<ID3D11PixelShader>(0x200);
+		Batch.InputLayout = FakePointer<ID3D11InputLayout>(0x300);
+		Batch.InstancingVertexShader = FakePointer<ID3D11VertexShader>(0x110);
+		Batch.InstancingPixelShader = FakePointer<ID3D11PixelShader>(0x210);
+		Batch.InstancingInputLayout = FakePointer<ID3D11InputLayout>(0x310);
+		Batch.Material = FakePointer<UMaterialInterface>(0x1000 + Mesh * 0x10);
+		Batch.VertexBuffer = FakePointer<ID3D11Buffer>(0x2000 + Mesh * 0x10);
+		Batch.IndexBuffer = FakePointer<ID3D11Buffer>(0x3000 + Mesh * 0x10);
+		Batch.VertexStride = 32;
+		Batch.StartIndex = Section * 600;
+		Batch.IndexCount = 600;
+		Batch.ObjectID = ObjectID;
+		Batch.WorldMatrix = FMatrix::Identity();
+		Batch.WorldMatrix.M[0][0] = 1.0f + 0.01f * static_cast<float>(ObjectID % 7);
+		Batch.WorldMatrix.M[1][1] = 2.0f;
+		Batch.WorldMatrix.M[3][0] = Location.X;
+		Batch.WorldMatrix.M[3][1] = Location.Y;
+		Batch.WorldMatrix.M[3][2] = Location.Z;
+		Batch.InstanceColor = FLinearColor(static_cast<float>(ObjectID % 3), 0.5f, 0.25f, 1.0f);
+		return Batch;
+	}
+
+	// 같은 상태로 합쳐져야 하는지 (FMeshAutoInstancing::CanMerge와 독립적으로 테스트가 정한 그룹 키)
+	struct FGroupKey
+	{
+		const void* Material;
+		const void* VertexBuffer;
+		uint32 StartIndex;
+
+		bool operator==(const FGroupKey& Other) const
+		{
+			return Material == Other.Material && VertexBuffer == Other.VertexBuffer && StartIndex == Other.StartIndex;
+		}
+	};
+
+	FGroupKey MakeGroupKey(const FMeshBatchElement& Batch)
+	{
+		return { Batch.Material, Batch.VertexBuffer, Batch.StartIndex };
+	}
+
+	bool IsIdentity(const FMatrix& Matrix, float Tolerance)
+	{
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			for (int32 Col = 0; Col < 4; ++Col)
+			{
+				if (std::abs(Matrix.M[Row][Col] - (Row == Col ? 1.0f : 0.0f)) > Tolerance)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool IsSameMatrix(const FMatrix& A, const FMatrix& B)
+	{
+		return std::memcmp(&A, &B, sizeof(FMatrix)) == 0;
+	}
+
+	/** 인스턴스가 원래 배치와 같은 데이터인지 (노멀 행렬은 월드 x 노멀^T = 단위) */
+	bool MatchesSource(const FMeshInstanceData& Instance, const FMeshBatchElement& Source)
+	{
+		return Instance.ObjectID == Source.ObjectID &&
+			IsSameMatrix(Instance.WorldMatrix, Source.WorldMatrix) &&
+			IsIdentity(Source.WorldMatrix * Instance.WorldInverseTranspose.Transpose(), 1e-4f) &&
+			Instance.Color.R == Source.InstanceColor.R && Instance.Color.G == Source.InstanceColor.G &&
+			Instance.Color.B == Source.InstanceColor.B && Instance.Color.A == Source.InstanceColor.A;
+	}
+
+	// ──────────────────────────────────────────────
+	// 고정 배치
+	// ──────────────────────────────────────────────
+
+	void TestFixtureRun()
+	{
+		TArray<FMeshBatchElement> Batches;
+		for (uint32 Index = 0; Index < 5; ++Index)
+		{
+			Batches.Add(MakeStaticBatch(0, 0, 10 + Index, FVector(100.0f * Index, 0.0f, 0.0f)));
+		}
+		const TArray<FMeshBatchElement> Sources = Batches;
+
+		FMeshAutoInstancing Instancing;
+		FMeshDrawStats Stats;
+		Instancing.MergeBatches(Batches, Stats);
+
+		TEST_CHECK(Batches.Num() == 1);
+		const FMeshBatchElement& Merged = Batches[0];
+		TEST_CHECK(Merged.bAutoInstanced);
+		TEST_CHECK(Merged.InstanceStart == 0);
+		TEST_CHECK(Merged.InstanceCount == 5);
+		TEST_CHECK(Merged.VertexShader == Sources[0].InstancingVertexShader);
+		TEST_CHECK(Merged.PixelShader == Sources[0].InstancingPixelShader);
+		TEST_CHECK(Merged.InputLayout == Sources[0].InstancingInputLayout);
+		TEST_CHECK(Merged.VertexBuffer == Sources[0].VertexBuffer && Merged.StartIndex == 0 && Merged.IndexCount == 600);
+
+		const TArray<FMeshInstanceData>& Instances = Instancing.GetInstances();
+		TEST_CHECK(Instances.Num() == 5);
+		for (int32 Index = 0; Index < Instances.Num() && Index < Sources.Num(); ++Index)
+		{
+			TEST_CHECK(MatchesSource(Instances[Index], Sources[Index]));
+		}
+
+		TEST_CHECK(Stats.NumBatches == 5);
+		TEST_CHECK(Stats.NumDrawCalls == 1);
+		TEST_CHECK(Stats.NumInstancedDraws == 1);
+		TEST_CHECK(Stats.NumInstances == 5);
+		TEST_CHECK(Stats.MaxInstancesPerDraw == 5);
+		TEST_CHECK(Stats.ReductionPercent == 80.0f);
+
+		// 다음 호출은 이전 인스턴스 데이터를 버림
+		Batches.Empty();
+		Batches.Add(MakeStaticBatch(1, 0, 1, FVector::Zero()));
+		Batches.Add(MakeStaticBatch(1, 0, 2, FVector::Zero()));
+		FMeshDrawStats SecondStats;
+		Instancing.MergeBatches(Batches, SecondStats);
+		TEST_CHECK(Instancing.GetInstances().Num() == 2);
+		TEST_CHECK(Batches.Num() == 1 && Batches[0].InstanceStart == 0 && Batches[0].InstanceCount == 2);
+	}
+
+	void TestFixtureNotMerged()
+	{
+		// 각 항목은 자기 앞의 배치와 같은 섹션이지만 합쳐지면 안 되는 배치 (앞 배치와 짝을 이룬 2개 구간)
+		struct FCase
+		{
+			const char* Name;
+			void (*Modify)(FMeshBatchElement&);
+		};
+		const FCase Cases[] = {
+			{ "no instancing variant", [](FMeshBatchElement& Batch) { Batch.InstancingVertexShader = nullptr; Batch.InstancingPixelShader = nullptr; } },
+			{ "gpu skinning", [](FMeshBatchElement& Batch) { Batch.GPUSkinMatrixSRV = FakePointer<ID3D11ShaderResourceView>(0x9000); } },
+			{ "particle instancing", [](FMeshBatchElement& Batch) { Batch.bInstancedDraw = true; Batch.InstanceCount = 16; } },
+			{ "sub uv", [](FMeshBatchElement& Batch) { Batch.SubImages_Horizontal = 4; } },
+			{ "billboard", [](FMeshBatchElement& Batch) { Batch.ScreenAlignment = EScreenAlignment::CameraFacing; } },
+			{ "instance srv", [](FMeshBatchElement& Batch) { Batch.InstanceShaderResourceView = FakePointer<ID3D11ShaderResourceView>(0x9100); } },
+			{ "other section", [](FMeshBatchElement& Batch) { Batch.StartIndex += 600; } },
+			{ "other material", [](FMeshBatchElement& Batch) { Batch.Material = FakePointer<UMaterialInterface>(0x9200); } },
+			{ "sort priority", [](FMeshBatchElement& Batch) { Batch.SortPriority = 3; } },
+		};
+
+		FMeshAutoInstancing Instancing;
+		for (const FCase& Case : Cases)
+		{
+			TArray<FMeshBatchElement> Batches;
+			Batches.Add(MakeStaticBatch(0, 0, 1, FVector::Zero()));
+			Batches.Add(MakeStaticBatch(0, 0, 2, FVector::Zero()));
+			Case.Modify(Batches[1]);
+			const TArray<FMeshBatchElement> Sources = Batches;
+
+			FMeshDrawStats Stats;
+			Instancing.MergeBatches(Batches, Stats);
+			const bool bUnchanged = Batches.Num() == 2 &&
+				!Batches[0].bAutoInstanced && !Batches[1].bAutoInstanced &&
+				Batches[0].VertexShader == Sources[0].VertexShader && Batches[1].VertexShader == Sources[1].VertexShader &&
+				Batches[0].ObjectID == 1 && Batches[1].ObjectID == 2 &&
+				Instancing.GetInstances().IsEmpty() && Stats.NumDrawCalls == 2 && Stats.NumInstancedDraws == 0;
+			if (!bUnchanged)
+			{
+				std::printf("  case '%s' was merged\n", Case.Name);
+			}
+			TEST_CHECK(bUnchanged);
+		}
+
+		// 한 개뿐인 구간은 원래 셰이더 그대로 (MinInstancesPerDraw)
+		TArray<FMeshBatchElement> Single;
+		Single.Add(MakeStaticBatch(0, 0, 1, FVector::Zero()));
+		FMeshDrawStats Stats;
+		Instancing.MergeBatches(Single, Stats);
+		TEST_CHECK(Single.Num() == 1 && !Single[0].bAutoInstanced);
+		TEST_CHECK(Single[0].VertexShader == FakePointer<ID3D11VertexShader>(0x100));
+
+		// 합칠 수 없는 배치가 구간을 끊음: A A X A A → 드로우 3개 (A 2개 x 2, X)
+		TArray<FMeshBatchElement> Split;
+		for (uint32 Index = 0; Index < 5; ++Index)
+		{
+			Split.Add(MakeStaticBatch(0, 0, Index, FVector::Zero()));
+		}
+		Split[2].InstancingVertexShader = nullptr;
+		FMeshDrawStats SplitStats;
+		Instancing.MergeBatches(Split, SplitStats);
+		TEST_CHECK(Split.Num() == 3);
+		TEST_CHECK(Split.Num() == 3 && Split[0].bAutoInstanced && !Split[1].bAutoInstanced && Split[2].bAutoInstanced);
+		TEST_CHECK(Split.Num() == 3 && Split[0].InstanceStart == 0 && Split[2].InstanceStart == 2 && Split[2].InstanceCount == 2);
+		TEST_CHECK(SplitStats.NumInstances == 4);
+
+		// RHI가 없으면 업로드/바인딩하지 않음
+		TEST_CHECK(!Instancing.UploadAndBind(nullptr));
+	}
+
+	// ──────────────────────────────────────────────
+	// 무작위 장면
+	// ──────────────────────────────────────────────
+
+	struct FRandomScene
+	{
+		TArray<FMeshBatchElement> Batches;
+		int32 NumNotInstanceable = 0;
+	};
+
+	FRandomScene MakeRandomScene(int32 NumBatches, uint32 Seed)
+	{
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> Position(-1000.0f, 1000.0f);
+		FRandomScene Scene;
+
+		// 컴포넌트마다 섹션 2개가 이어서 수집됨
+		for (int32 Index = 0; Index < NumBatches; Index += 2)
+		{
+			const uint32 Mesh = Rng() % 3;
+			const bool bInstanceable = Rng() % 10 != 0;
+			const FVector Location(Position(Rng), Position(Rng), Position(Rng));
+			for (uint32 Section = 0; Section < 2 && Index + static_cast<int32>(Section) < NumBatches; ++Section)
+			{
+				FMeshBatchElement Batch = MakeStaticBatch(Mesh, Section, static_cast<uint32>(Index) + Section + 1, Location);
+				if (!bInstanceable)
+				{
+					Batch.InstancingVertexShader = nullptr;
+					Batch.InstancingPixelShader = nullptr;
+					Batch.InstancingInputLayout = nullptr;
+					++Scene.NumNotInstanceable;
+				}
+				Scene.Batches.Add(Batch);
+			}
+		}
+		return Scene;
+	}
+
+	struct FMergeResult
+	{
+		TArray<FMeshBatchElement> Draws;
+		TArray<FMeshInstanceData> Instances;
+		FMeshDrawStats Stats;
+	};
+
+	FMergeResult SortAndMerge(const FRandomScene& Scene)
+	{
+		FMergeResult Result;
+		Result.Draws = Scene.Batches;
+
+		// RenderOpaquePass와 같은 순서: Opaque 키 정렬 → 합치기
+		FMeshBatchSorter Sorter;
+		Sorter.AssignKeysAndSort(Result.Draws, EMeshSortMode::Opaque, FMatrix::Identity());
+
+		FMeshAutoInstancing Instancing;
+		Instancing.MergeBatches(Result.Draws, Result.Stats);
+		Result.Instances = Instancing.GetInstances();
+		return Result;
+	}
+
+	void TestRandomScene(const FRandomScene& Scene, const FMergeResult& Result)
+	{
+		TMap<uint32, const FMeshBatchElement*> SourceByID;
+		for (const FMeshBatchElement& Batch : Scene.Batches)
+		{
+			SourceByID[Batch.ObjectID] = &Batch;
+		}
+
+		// 모든 ObjectID가 정확히 한 번, 인스턴스는 원래 배치 데이터와 같고 자기 드로우와 같은 상태
+		TMap<uint32, int32> SeenCount;
+		int32 NumBadInstances = 0;
+		int32 NumBadStates = 0;
+		uint32 NextInstance = 0;
+		for (const FMeshBatchElement& Draw : Result.Draws)
+		{
+			if (!Draw.bAutoInstanced)
+			{
+				++SeenCount[Draw.ObjectID];
+				continue;
+			}
+
+			// 인스턴스 구간은 빈틈 없이 이어짐
+			NumBadStates += Draw.InstanceStart != NextInstance ? 1 : 0;
+			NextInstance = Draw.InstanceStart + Draw.InstanceCount;
+			for (uint32 Instance = Draw.InstanceStart; Instance < Draw.InstanceStart + Draw.InstanceCount && Instance < static_cast<uint32>(Result.Instances.Num()); ++Instance)
+			{
+				const FMeshInstanceData& Data = Result.Instances[Instance];
+				++SeenCount[Data.ObjectID];
+				const FMeshBatchElement* const* Source = SourceByID.Find(Data.ObjectID);
+				if (!Source || !MatchesSource(Data, **Source))
+				{
+					++NumBadInstances;
+					continue;
+				}
+				NumBadStates += (MakeGroupKey(**Source) == MakeGroupKey(Draw) && (*Source)->InstancingVertexShader == Draw.VertexShader) ? 0 : 1;
+			}
+		}
+		TEST_CHECK(NextInstance == static_cast<uint32>(Result.Instances.Num()));
+
+		int32 NumMissingOrDuplicate = 0;
+		for (const FMeshBatchElement& Batch : Scene.Batches)
+		{
+			const int32* Count = SeenCount.Find(Batch.ObjectID);
+			NumMissingOrDuplicate += (!Count || *Count != 1) ? 1 : 0;
+		}
+		NumMissingOrDuplicate += SeenCount.Num() != Scene.Batches.Num() ? 1 : 0;
+
+		// 이웃한 드로우가 같은 그룹의 인스턴싱 가능 배치/드로우면 덜 합친 것
+		int32 NumMissedMerges = 0;
+		for (int32 Index = 1; Index < Result.Draws.Num(); ++Index)
+		{
+			const FMeshBatchElement& A = Result.Draws[Index - 1];
+			const FMeshBatchElement& B = Result.Draws[Index];
+			const bool bAInstanceable = A.bAutoInstanced || A.InstancingVertexShader;
+			const bool bBInstanceable = B.bAutoInstanced || B.InstancingVertexShader;
+			NumMissedMerges += (bAInstanceable && bBInstanceable && MakeGroupKey(A) == MakeGroupKey(B)) ? 1 : 0;
+		}
+
+		// 그룹(메시 3 x 섹션 2)마다 드로우 하나 + 인스턴싱 불가 배치는 각자 하나
+		const int32 ExpectedDraws = 6 + Scene.NumNotInstanceable;
+		std::printf("  %d batches -> %d draws (%u instanced draws, %u instances, %d not instanceable)\n",
+			Scene.Batches.Num(), Result.Draws.Num(), Result.Stats.NumInstancedDraws, Result.Stats.NumInstances, Scene.NumNotInstanceable);
+		TEST_CHECK(NumBadInstances == 0);
+		TEST_CHECK(NumBadStates == 0);
+		TEST_CHECK(NumMissingOrDuplicate == 0);
+		TEST_CHECK(NumMissedMerges == 0);
+		TEST_CHECK(Result.Draws.Num() == ExpectedDraws);
+		TEST_CHECK(Result.Stats.NumDrawCalls == static_cast<uint32>(ExpectedDraws));
+		TEST_CHECK(Result.Stats.NumInstancedDraws == 6);
+		TEST_CHECK(Result.Stats.NumInstances == static_cast<uint32>(Scene.Batches.Num() - Scene.NumNotInstanceable));
+	}
+
+	bool IsSameMergeResult(const FMergeResult& A, const FMergeResult& B)
+	{
+		if (A.Draws.Num() != B.Draws.Num() || A.Instances.Num() != B.Instances.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Draws.Num(); ++Index)
+		{
+			if (A.Draws[Index].ObjectID != B.Draws[Index].ObjectID || A.Draws[Index].InstanceStart != B.Draws[Index].InstanceStart ||
+				A.Draws[Index].InstanceCount != B.Draws[Index].InstanceCount)
+			{
+				return false;
+			}
+		}
+		return std::memcmp(A.Instances.data(), B.Instances.data(), sizeof(FMeshInstanceData) * A.Instances.Num()) == 0;
+	}
+}
+
+int main()
+{
+	TestFixtureRun();
+	TestFixtureNotMerged();
+
+	const FRandomScene Scene = MakeRandomScene(10000, 1234);
+	const FMergeResult Serial = SortAndMerge(Scene);
+	TestRandomScene(Scene, Serial);
+
+	FTaskGraph::GetInstance().Initialize(4);
+
+	const FMergeResult Parallel = SortAndMerge(Scene);
+	TestRandomScene(Scene, Parallel);
+	TEST_CHECK(IsSameMergeResult(Serial, Parallel));
+
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("MeshAutoInstancingTests");
+}
@@ -0,0 +1,455 @@
+#include "pch.h"
+#include "TestHarness.h"
+#include "MeshBVH.h"
+#include "Picking.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <random>
+
+// 메시 삼각형 BVH(FMeshBVH) 검사
+// - 울퉁불퉁한 구 + 내부 삼각형 더미(섞은 순서, 4만 삼각형)에 대해 모든 삼각형을 도는 브루트 포스와 비교
+//   · ClosestHit: 거리와 삼각형이 같음 (MaxDistance 제한 포함)
+//   · AnyHit: 히트 여부가 같고 돌려준 삼각형이 실제로 교차
+//   · 4레이 패킷(IntersectRays): 단일 레이와 같은 결과 (4의 배수가 아닌 개수, 병렬 경로 포함)
+// - 축 정렬 레이(방향 성분 0), 길이가 1이 아닌 방향, 빈 BVH
+// - 직렬 빌드와 워커 4개 병렬 빌드의 노드/삼각형 배열이 같음
+// - --bench: 100만 삼각형 빌드 시간과 단일 레이/패킷 초당 레이 수
+
+namespace
+{
+	struct FTestMesh
+	{
+		TArray<FNormalVertex> Vertices;
+		TArray<uint32> Indices;
+	};
+
+	FNormalVertex MakeVertex(const FVector& Position)
+	{
+		FNormalVertex Vertex{};
+		Vertex.pos = Position;
+		return Vertex;
+	}
+
+	/** 위도/경도 구 (반지름 1 근처) + 구 안쪽 임의 삼각형, 삼각형 순서를 섞음 */
+	FTestMesh MakeTestMesh(int32 Stacks, int32 Slices, int32 NumSoupTriangles, uint32 Seed)
+	{
+		constexpr float Pi = 3.14159265f;
+		FTestMesh Mesh;
+		for (int32 Stack = 0; Stack <= Stacks; ++Stack)
+		{
+			const float Phi = Pi * Stack / Stacks;
+			for (int32 Slice = 0; Slice <= Slices; ++Slice)
+			{
+				const float Theta = 2.0f * Pi * Slice / Slices;
+				const float Radius = 1.0f + 0.05f * std::sin(7.0f * Theta) * std::sin(5.0f * Phi);
+				Mesh.Vertices.push_back(MakeVertex(FVector(std::sin(Phi) * std::cos(Theta), std::sin(Phi) * std::sin(Theta), std::cos(Phi)) * Radius));
+			}
+		}
+		for (int32 Stack = 0; Stack < Stacks; ++Stack)
+		{
+			for (int32 Slice = 0; Slice < Slices; ++Slice)
+			{
+				const uint32 I0 = Stack * (Slices + 1) + Slice;
+				const uint32 I1 = I0 + 1;
+				const uint32 I2 = I0 + Slices + 1;
+				const uint32 I3 = I2 + 1;
+				Mesh.Indices.insert(Mesh.Indices.end(), { I0, I1, I2, I1, I3, I2 });
+			}
+		}
+
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> Inside(-0.6f, 0.6f);
+		std::uniform_real_distribution<float> Offset(-0.08f, 0.08f);
+		for (int32 Tri = 0; Tri < NumSoupTriangles; ++Tri)
+		{
+			const FVector Center(Inside(Rng), Inside(Rng), Inside(Rng));
+			const uint32 Base = static_cast<uint32>(Mesh.Vertices.size());
+			for (int32 Corner = 0; Corner < 3; ++Corner)
+			{
+				Mesh.Vertices.push_back(MakeVertex(Center + FVector(Offset(Rng), Offset(Rng), Offset(Rng))));
+			}
+			Mesh.Indices.insert(Mesh.Indices.end(), { Base, Base + 1, Base + 2 });
+		}
+
+		const uint32 NumTriangles = static_cast<uint32>(Mesh.Indices.size() / 3);
+		for (uint32 Tri = NumTriangles - 1; Tri > 0; --Tri)
+		{
+			const uint32 Other = std::uniform_int_distribution<uint32>(0, Tri)(Rng);
+			for (uint32 Corner = 0; Corner < 3; ++Corner)
+			{
+				std::swap(Mesh.Indices[Tri * 3 + Corner], Mesh.Indices[Other * 3 + Corner]);
+			}
+		}
+		return Mesh;
+	}
+
+	FVector RandomUnitVector(std::mt19937& Rng)
+	{
+		std::uniform_real_distribution<float> Signed(-1.0f, 1.0f);
+		while (true)
+		{
+			const FVector V(Signed(Rng), Signed(Rng), Signed(Rng));
+			const float Length = V.Size();
+			if (Length > 0.05f && Length <= 1.0f)
+			{
+				return V / Length;
+			}
+		}
+	}
+
+	/** 바깥 → 안, 안 → 바깥, 축 정렬, 빗나가는 레이와 길이가 1이 아닌 방향을 섞음 */
+	TArray<FRay> MakeRays(int32 NumRays, uint32 Seed)
+	{
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> Target(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> Inside(-0.5f, 0.5f);
+		std::uniform_int_distribution<int32> AxisDist(0, 5);
+
+		TArray<FRay> Rays;
+		for (int32 Index = 0; Index < NumRays; ++Index)
+		{
+			FRay Ray;
+			switch (Index % 5)
+			{
+			case 0:
+			case 1:
+			{
+				Ray.Origin = RandomUnitVector(Rng) * 3.0f;
+				Ray.Direction = (FVector(Target(Rng), Target(Rng), Target(Rng)) - Ray.Origin).GetNormalized();
+				break;
+			}
+			case 2:
+				Ray.Origin = FVector(Inside(Rng), Inside(Rng), Inside(Rng));
+				Ray.Direction = RandomUnitVector(Rng);
+				break;
+			case 3:
+			{
+				// 축 정렬: 나머지 두 성분이 정확히 0
+				const int32 Axis = AxisDist(Rng);
+				Ray.Origin = FVector(Inside(Rng), Inside(Rng), Inside(Rng));
+				Ray.Direction = FVector(0.0f, 0.0f, 0.0f);
+				Ray.Direction[Axis % 3] = Axis < 3 ? 1.0f : -1.0f;
+				break;
+			}
+			default:
+				// 구 밖에서 바깥쪽으로 (빗나감), 방향 길이 2.5
+				Ray.Origin = RandomUnitVector(Rng) * 2.0f;
+				Ray.Direction = (Ray.Origin.GetNormalized() + RandomUnitVector(Rng) * 0.3f).GetNormalized() * 2.5f;
+				break;
+			}
+			Rays.push_back(Ray);
+		}
+		return Rays;
+	}
+
+	struct FBruteForceHit
+	{
+		bool bHit = false;
+		float Distance = FLT_MAX;
+	};
+
+	bool IntersectTriangle(const FTestMesh& Mesh, const FRay& Ray, uint32 Triangle, float& OutT)
+	{
+		return IntersectRayTriangleMT(Ray, Mesh.Vertices[Mesh.Indices[Triangle * 3]].pos,
+			Mesh.Vertices[Mesh.Indices[Triangle * 3 + 1]].pos, Mesh.Vertices[Mesh.Indices[Triangle * 3 + 2]].pos, OutT);
+	}
+
+	FBruteForceHit BruteForce(const FTestMesh& Mesh, const FRay& Ray, float MaxDistance)
+	{
+		FBruteForceHit Result;
+		const uint32 NumTriangles = static_cast<uint32>(Mesh.Indices.size() / 3);
+		for (uint32 Tri = 0; Tri < NumTriangles; ++Tri)
+		{
+			float T;
+			if (IntersectTriangle(Mesh, Ray, Tri, T) && T < MaxDistance && T < Result.Distance)
+			{
+				Result.bHit = true;
+				Result.Distance = T;
+			}
+		}
+		return Result;
+	}
+
+	/** 같은 거리에서 겹치는 삼각형(공유 변)은 어느 쪽을 골라도 됨 → 돌려준 삼각형의 거리로 비교 */
+	bool MatchesClosest(const FTestMesh& Mesh, const FRay& Ray, const FBruteForceHit& Expected, const FMeshRayHit& Hit, float Tolerance)
+	{
+		if (Hit.bHit != Expected.bHit)
+		{
+			return false;
+		}
+		if (!Hit.bHit)
+		{
+			return true;
+		}
+		float TriangleT;
+		return std::abs(Hit.Distance - Expected.Distance) <= Tolerance * Expected.Distance
+			&& Hit.TriangleIndex < Mesh.Indices.size() / 3
+			&& IntersectTriangle(Mesh, Ray, Hit.TriangleIndex, TriangleT)
+			&& std::abs(TriangleT - Expected.Distance) <= Tolerance * Expected.Distance;
+	}
+
+	bool MatchesAny(const FTestMesh& Mesh, const FRay& Ray, const FBruteForceHit& Expected, const FMeshRayHit& Hit, float MaxDistance)
+	{
+		if (Hit.bHit != Expected.bHit)
+		{
+			return false;
+		}
+		float TriangleT;
+		return !Hit.bHit
+			|| (Hit.TriangleIndex < Mesh.Indices.size() / 3 && IntersectTriangle(Mesh, Ray, Hit.TriangleIndex, TriangleT)
+				&& TriangleT < MaxDistance * 1.0001f && Hit.Distance >= Expected.Distance * 0.9999f);
+	}
+
+	// ──────────────────────────────────────────────
+	// 검사
+	// ──────────────────────────────────────────────
+
+	void TestQueriesMatchBruteForce(const FTestMesh& Mesh, const FMeshBVH& BVH)
+	{
+		// 4의 배수가 아닌 개수 → 마지막 패킷은 레인 일부만 사용, 64패킷 이상이라 병렬 경로
+		const TArray<FRay> Rays = MakeRays(2003, 5);
+		const uint32 NumRays = static_cast<uint32>(Rays.size());
+
+		TArray<FBruteForceHit> Expected(NumRays);
+		int32 NumExpectedHits = 0;
+		for (uint32 i = 0; i < NumRays; ++i)
+		{
+			Expected[i] = BruteForce(Mesh, Rays[i], FLT_MAX);
+			NumExpectedHits += Expected[i].bHit ? 1 : 0;
+		}
+		// 레이 구성이 히트/미스를 모두 포함하는지
+		TEST_CHECK(NumExpectedHits > static_cast<int32>(NumRays) / 2);
+		TEST_CHECK(NumExpectedHits < static_cast<int32>(NumRays));
+
+		TArray<FMeshRayHit> PacketClosest(NumRays);
+		TArray<FMeshRayHit> PacketAny(NumRays);
+		BVH.IntersectRays(Rays.data(), NumRays, Mesh.Vertices, Mesh.Indices, PacketClosest.data(), EMeshRayQuery::ClosestHit);
+		BVH.IntersectRays(Rays.data(), NumRays, Mesh.Vertices, Mesh.Indices, PacketAny.data(), EMeshRayQuery::AnyHit);
+
+		int32 NumClosestMismatches = 0;
+		int32 NumAnyMismatches = 0;
+		int32 NumPacketClosestMismatches = 0;
+		int32 NumPacketAnyMismatches = 0;
+		int32 NumFloatMismatches = 0;
+		for (uint32 i = 0; i < NumRays; ++i)
+		{
+			FMeshRayHit Closest;
+			BVH.IntersectRay(Rays[i], Mesh.Vertices, Mesh.Indices, Closest, EMeshRayQuery::ClosestHit);
+			// 단일 레이는 브루트 포스와 같은 IntersectRayTriangleMT를 쓰므로 거리가 비트 단위로 같음
+			NumClosestMismatches += MatchesClosest(Mesh, Rays[i], Expected[i], Closest, 0.0f) ? 0 : 1;
+
+			FMeshRayHit Any;
+			BVH.IntersectRay(Rays[i], Mesh.Vertices, Mesh.Indices, Any, EMeshRayQuery::AnyHit);
+			NumAnyMismatches += MatchesAny(Mesh, Rays[i], Expected[i], Any, FLT_MAX) ? 0 : 1;
+
+			// 패킷은 SSE 연산 순서가 달라 거리에 반올림 차이가 날 수 있음
+			NumPacketClosestMismatches += MatchesClosest(Mesh, Rays[i], Expected[i], PacketClosest[i], 1e-4f) ? 0 : 1;
+			NumPacketAnyMismatches += MatchesAny(Mesh, Rays[i], Expected[i], PacketAny[i], FLT_MAX) ? 0 : 1;
+
+			float Distance = -1.0f;
+			const bool bHit = BVH.IntersectRay(Rays[i], Mesh.Vertices, Mesh.Indices, Distance);
+			NumFloatMismatches += (bHit == Expected[i].bHit && (!bHit || Distance == Expected[i].Distance)) ? 0 : 1;
+		}
+		TEST_CHECK(NumClosestMismatches == 0);
+		TEST_CHECK(NumAnyMismatches == 0);
+		TEST_CHECK(NumPacketClosestMismatches == 0);
+		TEST_CHECK(NumPacketAnyMismatches == 0);
+		TEST_CHECK(NumFloatMismatches == 0);
+	}
+
+	void TestMaxDistance(const FTestMesh& Mesh, const FMeshBVH& BVH)
+	{
+		// 한도보다 먼 삼각형은 무시 (구 바깥 3에서 쏜 레이는 대부분 한도 밖)
+		const TArray<FRay> Rays = MakeRays(401, 9);
+		const uint32 NumRays = static_cast<uint32>(Rays.size());
+		constexpr float MaxDistance = 1.2f;
+
+		TArray<FMeshRayHit> PacketClosest(NumRays);
+		TArray<FMeshRayHit> PacketAny(NumRays);
+		BVH.IntersectRays(Rays.data(), NumRays, Mesh.Vertices, Mesh.Indices, PacketClosest.data(), EMeshRayQuery::ClosestHit, MaxDistance);
+		BVH.IntersectRays(Rays.data(), NumRays, Mesh.Vertices, Mesh.Indices, PacketAny.data(), EMeshRayQuery::AnyHit, MaxDistance);
+
+		int32 NumMismatches = 0;
+		for (uint32 i = 0; i < NumRays; ++i)
+		{
+			const FBruteForceHit Expected = BruteForce(Mesh, Rays[i], MaxDistance);
+
+			FMeshRayHit Closest;
+			BVH.IntersectRay(Rays[i], Mesh.Vertices, Mesh.Indices, Closest, EMeshRayQuery::ClosestHit, MaxDistance);
+			FMeshRayHit Any;
+			BVH.IntersectRay(Rays[i], Mesh.Vertices, Mesh.Indices, Any, EMeshRayQuery::AnyHit, MaxDistance);
+
+			NumMismatches += MatchesClosest(Mesh, Rays[i], Expected, Closest, 0.0f) ? 0 : 1;
+			NumMismatches += MatchesAny(Mesh, Rays[i], Expected, Any, MaxDistance) ? 0 : 1;
+			NumMismatches += MatchesClosest(Mesh, Rays[i], Expected, PacketClosest[i], 1e-4f) ? 0 : 1;
+			NumMismatches += MatchesAny(Mesh, Rays[i], Expected, PacketAny[i], MaxDistance) ? 0 : 1;
+		}
+		TEST_CHECK(NumMismatches == 0);
+	}
+
+	void TestBuildIsDeterministic(const FMeshBVH& SerialBVH, const FMeshBVH& ParallelBVH)
+	{
+		const TArray<FMeshBVHNode>& SerialNodes = SerialBVH.GetNodes();
+		const TArray<FMeshBVHNode>& ParallelNodes = ParallelBVH.GetNodes();
+		TEST_CHECK(SerialNodes.size() == ParallelNodes.size());
+		TEST_CHECK(SerialNodes.size() == ParallelNodes.size()
+			&& std::memcmp(SerialNodes.data(), ParallelNodes.data(), SerialNodes.size() * sizeof(FMeshBVHNode)) == 0);
+		TEST_CHECK(SerialBVH.GetTriIndices() == ParallelBVH.GetTriIndices());
+		TEST_CHECK(SerialBVH.GetMaxDepth() == ParallelBVH.GetMaxDepth());
+	}
+
+	void TestTreeStructure(const FTestMesh& Mesh, const FMeshBVH& BVH)
+	{
+		const uint32 NumTriangles = static_cast<uint32>(Mesh.Indices.size() / 3);
+
+		// 삼각형 순서는 순열, 리프는 최대 8개, 자식 바운드는 부모 안
+		TArray<uint32> Sorted = BVH.GetTriIndices();
+		std::sort(Sorted.begin(), Sorted.end());
+		bool bPermutation = Sorted.size() == NumTriangles;
+		for (uint32 i = 0; bPermutation && i < NumTriangles; ++i)
+		{
+			bPermutation = Sorted[i] == i;
+		}
+		TEST_CHECK(bPermutation);
+
+		const TArray<FMeshBVHNode>& Nodes = BVH.GetNodes();
+		bool bValid = true;
+		uint32 NumLeafTriangles = 0;
+		for (const FMeshBVHNode& Node : Nodes)
+		{
+			if (Node.IsLeaf())
+			{
+				bValid &= Node.Count <= 8 && Node.LeftOrStart + Node.Count <= NumTriangles;
+				NumLeafTriangles += Node.Count;
+				continue;
+			}
+			bValid &= Node.LeftOrStart + 1 < Nodes.size();
+			for (uint32 Child = Node.LeftOrStart; bValid && Child <= Node.LeftOrStart + 1; ++Child)
+			{
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					bValid &= Nodes[Child].BoundsMin[Axis] >= Node.BoundsMin[Axis] && Nodes[Child].BoundsMax[Axis] <= Node.BoundsMax[Axis];
+				}
+			}
+		}
+		TEST_CHECK(bValid);
+		TEST_CHECK(NumLeafTriangles == NumTriangles);
+		TEST_CHECK(BVH.GetMaxDepth() < 64);
+	}
+
+	void TestEmpty()
+	{
+		FMeshBVH BVH;
+		const TArray<FNormalVertex> NoVertices;
+		const TArray<uint32> NoIndices;
+		BVH.Build(NoVertices, NoIndices);
+		TEST_CHECK(BVH.IsEmpty());
+
+		const TArray<FRay> Rays = MakeRays(5, 1);
+		FMeshRayHit Hit;
+		TEST_CHECK(!BVH.IntersectRay(Rays[0], NoVertices, NoIndices, Hit));
+
+		FMeshRayHit Hits[5];
+		Hits[2].bHit = true;
+		BVH.IntersectRays(Rays.data(), 5, NoVertices, NoIndices, Hits);
+		TEST_CHECK(std::none_of(std::begin(Hits), std::end(Hits), [](const FMeshRayHit& H) { return H.bHit; }));
+	}
+
+	// ──────────────────────────────────────────────
+	// 벤치마크
+	// ──────────────────────────────────────────────
+
+	double MRaysPerSecond(uint32 NumRays, double MS)
+	{
+		return MS > 0.0 ? NumRays / (MS * 1000.0) : 0.0;
+	}
+
+	/** 카메라 격자 레이 (원점 한 곳에서 Width x Width 픽셀로 퍼짐) */
+	TArray<FRay> MakeCameraRays(int32 Width)
+	{
+		TArray<FRay> Rays;
+		for (int32 Y = 0; Y < Width; ++Y)
+		{
+			for (int32 X = 0; X < Width; ++X)
+			{
+				FRay Ray;
+				Ray.Origin = FVector(-3.0f, 0.0f, 0.0f);
+				Ray.Direction = FVector(1.0f, (X + 0.5f) / Width * 0.8f - 0.4f, (Y + 0.5f) / Width * 0.8f - 0.4f).GetNormalized();
+				Rays.push_back(Ray);
+			}
+		}
+		return Rays;
+	}
+
+	void RunRayBenchmark()
+	{
+		const FTestMesh Mesh = MakeTestMesh(500, 1000, 0, 21);
+		const uint32 NumTriangles = static_cast<uint32>(Mesh.Indices.size() / 3);
+
+		FMeshBVH BVH;
+		MundiTest::FTimer BuildTimer;
+		BVH.Build(Mesh.Vertices, Mesh.Indices);
+		const double BuildMS = BuildTimer.ElapsedMS();
+
+		std::printf("MESH BVH BENCH (shuffled bumpy sphere, %u tris)\n", NumTriangles);
+		std::printf("  build: %.1f ms (%u nodes, depth %u, %d workers)\n", BuildMS, BVH.GetNumNodes(), BVH.GetMaxDepth(),
+			FTaskGraph::GetInstance().GetNumWorkers());
+
+		auto Measure = [&](const char* Label, const TArray<FRay>& Rays)
+		{
+			const uint32 NumRays = static_cast<uint32>(Rays.size());
+			TArray<FMeshRayHit> Hits(NumRays);
+
+			MundiTest::FTimer SingleTimer;
+			for (uint32 i = 0; i < NumRays; ++i)
+			{
+				BVH.IntersectRay(Rays[i], Mesh.Vertices, Mesh.Indices, Hits[i]);
+			}
+			const double SingleMS = SingleTimer.ElapsedMS();
+
+			// 패킷 4개씩 직접 호출 → 병렬 경로를 타지 않는 한 스레드 수치
+			MundiTest::FTimer PacketTimer;
+			for (uint32 i = 0; i < NumRays; i += 4)
+			{
+				BVH.IntersectRays(Rays.data() + i, std::min(4u, NumRays - i), Mesh.Vertices, Mesh.Indices, Hits.data() + i);
+			}
+			const double PacketMS = PacketTimer.ElapsedMS();
+
+			MundiTest::FTimer BatchTimer;
+			BVH.IntersectRays(Rays.data(), NumRays, Mesh.Vertices, Mesh.Indices, Hits.data());
+			const double BatchMS = BatchTimer.ElapsedMS();
+
+			std::printf("  %-13s closest hit: single %.2f Mrays/s, packet %.2f Mrays/s (1 thread), batch %.2f Mrays/s (parallel)\n",
+				Label, MRaysPerSecond(NumRays, SingleMS), MRaysPerSecond(NumRays, PacketMS), MRaysPerSecond(NumRays, BatchMS));
+		};
+
+		Measure("random rays", MakeRays(200000, 3));
+		Measure("camera grid", MakeCameraRays(512));
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	// 4만 삼각형: 병렬 서브트리 빌드(2 * 16384 이상) 경로를 탐
+	const FTestMesh Mesh = MakeTestMesh(120, 160, 1600, 7);
+
+	// TaskGraph가 돌기 전에는 ParallelFor가 호출 스레드에서 그대로 실행됨
+	FMeshBVH SerialBVH;
+	SerialBVH.Build(Mesh.Vertices, Mesh.Indices);
+
+	FTaskGraph::GetInstance().Initialize(4);
+	FMeshBVH BVH;
+	BVH.Build(Mesh.Vertices, Mesh.Indices);
+
+	TestBuildIsDeterministic(SerialBVH, BVH);
+	TestTreeStructure(Mesh, BVH);
+	TestEmpty();
+	TestQueriesMatchBruteForce(Mesh, BVH);
+	TestMaxDistance(Mesh, BVH);
+
+	if (MundiTest::HasArg(Argc, Argv, "--bench"))
+	{
+		RunRayBenchmark();
+	}
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("MeshBVHTests");
+}
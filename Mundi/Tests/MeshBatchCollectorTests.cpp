@@ -0,0 +1,321 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "MeshBatchCollector.h"
+#include "MeshComponent.h"
+#include "Shader.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <random>
+#include <thread>
+
+// FMeshBatchCollector (병렬 메시 배치 수집) 검사
+// - 컴포넌트 100(직렬 경로), 513(묶음 5개, 마지막 묶음 1개), 20000개에서 Collect 결과가
+//   컴포넌트마다 CollectMeshBatches를 차례로 부른 직렬 결과와 배치 순서/내용/컴포넌트별 오프셋까지 같음
+// - 빈 컴포넌트(nullptr), 배치 0개 컴포넌트, 이미 배치가 들어 있는 출력 배열에 이어 붙이기, 오프셋 없이 호출
+// - 없는 셰이더 변형: 워커는 컴파일하지 않고 그 컴포넌트의 일부 출력을 버린 뒤 게임 스레드에서 다시 수집 (결과는 같음)
+//   다음 Collect에서는 이미 컴파일된 변형이라 대체 수집 없음
+// - PrepareMeshBatches는 컴포넌트마다 한 번, Collect를 부른 스레드에서. 끝나면 호출 스레드의 변형 컴파일 금지가 풀림
+// - 워커 0개일 때는 513개도 직렬
+// - --bench: 20000개 직렬 vs 병렬 수집 시간 (테스트 컴포넌트라 엔진 컴포넌트보다 수집 비용이 작음)
+// 컴포넌트/셰이더 상태는 atomic 없이 읽으므로 MUNDI_TESTS_TSAN 빌드가 워커 쪽 쓰기를 잡음
+
+namespace
+{
+	template<typename T>
+	T* FakePointer(uint64 Tag, uint64 Index)
+	{
+		return reinterpret_cast<T*>((Tag << 40) | ((Index + 1) << 6));
+	}
+
+	/**
+	 * 스태틱/스킨드 메시 컴포넌트처럼 섹션마다 셰이더 변형을 찾아 배치를 하나씩 남기는 테스트 컴포넌트
+	 * 변형이 없으면 (워커에서 컴파일 금지) 셰이더가 빈 배치를 그대로 남김 → 수집기가 버려야 직렬 결과와 같아짐
+	 */
+	class FTestMeshComponent : public UMeshComponent
+	{
+	public:
+		void PrepareMeshBatches(const FSceneView* View) override
+		{
+			++NumPrepares;
+			PrepareThread = std::this_thread::get_id();
+		}
+
+		void CollectMeshBatches(TArray<FMeshBatchElement>& OutMeshBatchElements, const FSceneView* View) override
+		{
+			for (uint32 Section = 0; Section < NumSections; ++Section)
+			{
+				const FShaderVariant* Variant = Shader->GetOrCompileShaderVariant(VariantKey + Section);
+
+				FMeshBatchElement Batch;
+				Batch.VertexShader = Variant ? Variant->VertexShader : nullptr;
+				Batch.PixelShader = Variant ? Variant->PixelShader : nullptr;
+				Batch.VertexBuffer = FakePointer<ID3D11Buffer>(4, Mesh);
+				Batch.IndexBuffer = FakePointer<ID3D11Buffer>(5, Mesh);
+				Batch.VertexStride = 64;
+				Batch.StartIndex = Section * 300;
+				Batch.IndexCount = 300;
+				Batch.WorldMatrix = WorldMatrix;
+				Batch.ObjectID = ObjectID;
+				Batch.InstanceColor = FLinearColor(static_cast<float>(Section), 0.5f, 0.25f, 1.0f);
+				Batch.SortPriority = static_cast<int32>(Section);
+				OutMeshBatchElements.Add(Batch);
+			}
+		}
+
+		UShader* Shader = nullptr;
+		uint64 VariantKey = 0;
+		uint32 NumSections = 1;
+		uint32 Mesh = 0;
+		uint32 ObjectID = 0;
+		FMatrix WorldMatrix = FMatrix::Identity();
+
+		int32 NumPrepares = 0;
+		std::thread::id PrepareThread;
+	};
+
+	struct FTestScene
+	{
+		// 변형 키: 메시 종류 16개 × 섹션. MissingEvery마다 한 컴포넌트는 아직 컴파일하지 않은 키를 씀
+		UShader Shader;
+		TArray<FTestMeshComponent> Components;
+		TArray<UMeshComponent*> ComponentPointers;
+		int32 NumWithNewVariants = 0;
+	};
+
+	void MakeScene(FTestScene& Scene, int32 NumComponents, int32 MissingEvery, uint32 Seed)
+	{
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> PositionDist(-2000.0f, 2000.0f);
+
+		Scene.Components.SetNum(NumComponents);
+		Scene.ComponentPointers.SetNum(NumComponents);
+		for (int32 Index = 0; Index < NumComponents; ++Index)
+		{
+			FTestMeshComponent& Component = Scene.Components[Index];
+			Component.Shader = &Scene.Shader;
+			Component.Mesh = Rng() % 16;
+			Component.NumSections = Rng() % 4;		// 0 ~ 3 (0이면 배치 없음)
+			Component.VariantKey = uint64(Component.Mesh) * 8;
+			Component.ObjectID = static_cast<uint32>(Index + 1);
+			Component.WorldMatrix.M[3][0] = PositionDist(Rng);
+			Component.WorldMatrix.M[3][1] = PositionDist(Rng);
+			Component.WorldMatrix.M[3][2] = PositionDist(Rng);
+
+			// 가끔 빈 슬롯 (컴포넌트가 지워진 경우)
+			const bool bEmptySlot = Index % 97 == 50;
+			Scene.ComponentPointers[Index] = bEmptySlot ? nullptr : &Component;
+
+			if (MissingEvery > 0 && Index % MissingEvery == MissingEvery - 1 && Component.NumSections > 0 && !bEmptySlot)
+			{
+				// 컴포넌트마다 다른 새 변형 (처음 보는 머티리얼/뷰 모드 조합)
+				Component.VariantKey = 1000 + uint64(Index) * 8;
+				++Scene.NumWithNewVariants;
+			}
+		}
+
+		// 직렬 수집에서 쓰는 변형 중 새 변형이 아닌 것만 미리 컴파일
+		for (uint64 Key = 0; Key < 16 * 8; ++Key)
+		{
+			Scene.Shader.GetOrCompileShaderVariant(Key);
+		}
+	}
+
+	// 기존 방식: 컴포넌트마다 CollectMeshBatches를 공유 배열에 직접 (컴파일 허용)
+	void CollectSerial(const TArray<UMeshComponent*>& Components, TArray<FMeshBatchElement>& OutBatches, TArray<int32>& OutOffsets)
+	{
+		OutOffsets.SetNum(Components.Num() + 1);
+		OutOffsets[0] = OutBatches.Num();
+		for (int32 Index = 0; Index < Components.Num(); ++Index)
+		{
+			if (Components[Index])
+			{
+				Components[Index]->CollectMeshBatches(OutBatches, nullptr);
+			}
+			OutOffsets[Index + 1] = OutBatches.Num();
+		}
+	}
+
+	bool IsSameBatches(const TArray<FMeshBatchElement>& A, const TArray<FMeshBatchElement>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (!FMeshBatchCollector::IsSameBatch(A[Index], B[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool HasMissingShaders(const TArray<FMeshBatchElement>& Batches)
+	{
+		for (const FMeshBatchElement& Batch : Batches)
+		{
+			if (!Batch.VertexShader || !Batch.PixelShader)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// 프리픽스 배치 3개가 이미 들어 있는 출력 배열 (다른 패스가 먼저 모은 배치)
+	TArray<FMeshBatchElement> MakePrefix()
+	{
+		TArray<FMeshBatchElement> Prefix(3);
+		for (int32 Index = 0; Index < Prefix.Num(); ++Index)
+		{
+			Prefix[Index].ObjectID = 900000 + Index;
+			Prefix[Index].VertexShader = FakePointer<ID3D11VertexShader>(1, Index);
+			Prefix[Index].PixelShader = FakePointer<ID3D11PixelShader>(2, Index);
+		}
+		return Prefix;
+	}
+
+	// ──────────────────────────────────────────────
+	// 직렬 결과와 비교
+	// ──────────────────────────────────────────────
+
+	void TestMatchesSerial(int32 NumComponents)
+	{
+		FTestScene Scene;
+		MakeScene(Scene, NumComponents, 0, 1234 + NumComponents);
+
+		TArray<FMeshBatchElement> SerialBatches = MakePrefix();
+		TArray<int32> SerialOffsets;
+		CollectSerial(Scene.ComponentPointers, SerialBatches, SerialOffsets);
+		TEST_CHECK(!HasMissingShaders(SerialBatches));
+
+		FMeshBatchCollector Collector;
+		for (int32 Iteration = 0; Iteration < 3; ++Iteration)
+		{
+			TArray<FMeshBatchElement> Batches = MakePrefix();
+			TArray<int32> Offsets;
+			Collector.Collect(Scene.ComponentPointers, nullptr, Batches, &Offsets);
+			TEST_CHECK(IsSameBatches(SerialBatches, Batches));
+			TEST_CHECK(Offsets == SerialOffsets);
+			TEST_CHECK(Collector.GetNumSerialFallbacks() == 0);
+
+			// 오프셋 없이
+			TArray<FMeshBatchElement> NoOffsetBatches = MakePrefix();
+			Collector.Collect(Scene.ComponentPointers, nullptr, NoOffsetBatches);
+			TEST_CHECK(IsSameBatches(SerialBatches, NoOffsetBatches));
+		}
+
+		// Prepare는 Collect마다 컴포넌트당 한 번, 호출 스레드에서
+		bool bPreparedOnce = true;
+		bool bPreparedOnCaller = true;
+		for (int32 Index = 0; Index < NumComponents; ++Index)
+		{
+			const FTestMeshComponent& Component = Scene.Components[Index];
+			const int32 Expected = Scene.ComponentPointers[Index] ? 6 : 0;
+			bPreparedOnce &= Component.NumPrepares == Expected;
+			bPreparedOnCaller &= Expected == 0 || Component.PrepareThread == std::this_thread::get_id();
+		}
+		TEST_CHECK(bPreparedOnce);
+		TEST_CHECK(bPreparedOnCaller);
+
+		// 병렬 경로에서는 호출 스레드도 묶음을 맡으므로 끝나면 컴파일 금지가 풀려 있어야 함
+		const int32 NumVariantsBefore = Scene.Shader.GetNumVariants();
+		TEST_CHECK(Scene.Shader.GetOrCompileShaderVariant(999999) != nullptr);
+		TEST_CHECK(Scene.Shader.GetNumVariants() == NumVariantsBefore + 1);
+	}
+
+	void TestMissingVariantFallback(int32 NumComponents)
+	{
+		FTestScene Scene;
+		MakeScene(Scene, NumComponents, 37, 4321 + NumComponents);
+		TEST_CHECK(Scene.NumWithNewVariants > 0);
+
+		// 수집기가 먼저 돌아 새 변형을 처음 만남 (가짜 셰이더 포인터는 키로 정해지므로 직렬 기준을 나중에 모아도 같음)
+		FMeshBatchCollector Collector;
+		TArray<FMeshBatchElement> Batches = MakePrefix();
+		TArray<int32> Offsets;
+		Collector.Collect(Scene.ComponentPointers, nullptr, Batches, &Offsets);
+		TEST_CHECK(!HasMissingShaders(Batches));
+		// 직렬 경로(적은 컴포넌트, 워커 없음)는 게임 스레드에서 바로 컴파일하므로 대체 수집 없음
+		const bool bParallel = NumComponents >= FMeshBatchCollector::MinParallelComponents && FTaskGraph::GetInstance().GetNumWorkers() > 0;
+		TEST_CHECK(Collector.GetNumSerialFallbacks() == (bParallel ? Scene.NumWithNewVariants : 0));
+
+		TArray<FMeshBatchElement> SerialBatches = MakePrefix();
+		TArray<int32> SerialOffsets;
+		CollectSerial(Scene.ComponentPointers, SerialBatches, SerialOffsets);
+		TEST_CHECK(IsSameBatches(SerialBatches, Batches));
+		TEST_CHECK(Offsets == SerialOffsets);
+
+		// 게임 스레드에서 컴파일된 뒤에는 대체 수집 없이 같은 결과
+		TArray<FMeshBatchElement> WarmBatches = MakePrefix();
+		TArray<int32> WarmOffsets;
+		Collector.Collect(Scene.ComponentPointers, nullptr, WarmBatches, &WarmOffsets);
+		TEST_CHECK(Collector.GetNumSerialFallbacks() == 0);
+		TEST_CHECK(IsSameBatches(SerialBatches, WarmBatches));
+		TEST_CHECK(WarmOffsets == SerialOffsets);
+	}
+
+	void TestEmpty()
+	{
+		FMeshBatchCollector Collector;
+		TArray<UMeshComponent*> NoComponents;
+		TArray<FMeshBatchElement> Batches = MakePrefix();
+		TArray<int32> Offsets;
+		Collector.Collect(NoComponents, nullptr, Batches, &Offsets);
+		TEST_CHECK(Batches.Num() == 3);
+		TEST_CHECK(Offsets.Num() == 1 && Offsets[0] == 3);
+	}
+
+	void RunBenchmark()
+	{
+		constexpr int32 NumComponents = 20000;
+		constexpr int32 NumIterations = 20;
+		FTestScene Scene;
+		MakeScene(Scene, NumComponents, 0, 1234);
+
+		FMeshBatchCollector Collector;
+		TArray<FMeshBatchElement> Batches;
+		TArray<int32> Offsets;
+		double SerialMS = 0.0;
+		double ParallelMS = 0.0;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Batches.Empty();
+			MundiTest::FTimer SerialTimer;
+			CollectSerial(Scene.ComponentPointers, Batches, Offsets);
+			SerialMS += SerialTimer.ElapsedMS();
+
+			Batches.Empty();
+			MundiTest::FTimer ParallelTimer;
+			Collector.Collect(Scene.ComponentPointers, nullptr, Batches, &Offsets);
+			ParallelMS += ParallelTimer.ElapsedMS();
+		}
+		std::printf("[bench] collect %d components (%d batches, %d workers): serial %.3f ms, parallel %.3f ms\n",
+			NumComponents, Batches.Num(), FTaskGraph::GetInstance().GetNumWorkers(), SerialMS / NumIterations, ParallelMS / NumIterations);
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	// 워커 없이: 개수와 상관없이 직렬
+	TestEmpty();
+	TestMatchesSerial(513);
+	TestMissingVariantFallback(513);
+
+	FTaskGraph::GetInstance().Initialize(4);
+
+	TestMatchesSerial(100);
+	TestMatchesSerial(513);
+	TestMatchesSerial(20000);
+	TestMissingVariantFallback(100);
+	TestMissingVariantFallback(513);
+	TestMissingVariantFallback(20000);
+
+	if (MundiTest::HasArg(Argc, Argv, "--bench"))
+	{
+		RunBenchmark();
+	}
+
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("MeshBatchCollectorTests");
+}
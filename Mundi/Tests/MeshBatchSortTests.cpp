@@ -0,0 +1,389 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "MeshBatchSort.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <tuple>
+
+// 메시 배치 정렬(FMeshBatchSorter) 검사
+// - RadixSort: 무작위/동률이 많은/상위 바이트만 다른 키에서 std::stable_sort(Key)와 같은 (키, 인덱스) 순서
+//   (256개 이하 비교 정렬 경로, 청크 경계, 한 버킷 자릿수 건너뛰기 포함)
+// - Sort: 배치가 SortKey 순이고 같은 키끼리는 원래 순서 유지 (안정 정렬)
+// - 키: 우선순위가 가장 먼저, Opaque는 같은 상태 안에서 앞→뒤, Translucent는 뒤→앞
+// - 합성 장면(셰이더 24, 머티리얼 600, 메시 2000): 키 정렬은 셰이더/머티리얼 조합마다 바인딩 한 번,
+//   상태 변경 수가 기존 operator< 정렬보다 많지 않음
+//   인스턴스 SRV가 섞인 장면에서는 머티리얼 변경과 합계가 더 적음 (operator<는 SRV를 비교하지 않음)
+// - 직렬(TaskGraph 초기화 전)과 4 워커의 결과가 같음
+// - --bench: 같은 합성 장면 50k에서 기존 비교 정렬 vs 키 + radix sort 시간
+
+namespace
+{
+	template<typename T>
+	T* FakePointer(uint64 Tag, uint64 Index)
+	{
+		return reinterpret_cast<T*>((Tag << 40) | ((Index + 1) << 6));
+	}
+
+	// ──────────────────────────────────────────────
+	// RadixSort
+	// ──────────────────────────────────────────────
+
+	enum class EKeyPattern
+	{
+		Random,		// 64비트 전체 무작위
+		FewKeys,	// 키 16종 (동률이 많음)
+		HighByte,	// 최상위 바이트만 다름 (나머지 자릿수는 한 버킷)
+	};
+
+	TArray<FMeshBatchSortEntry> MakeEntries(int32 Num, EKeyPattern Pattern, uint32 Seed)
+	{
+		std::mt19937_64 Rng(Seed);
+		TArray<FMeshBatchSortEntry> Entries;
+		Entries.SetNum(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			uint64 Key = Rng();
+			if (Pattern == EKeyPattern::FewKeys)
+			{
+				Key = (Key % 16) * 0x0101010101010101ull;
+			}
+			else if (Pattern == EKeyPattern::HighByte)
+			{
+				Key = ((Key & 0xFF) << 56) | 0x00123456789ABCDEull;
+			}
+			Entries[Index].Key = Key;
+			Entries[Index].Index = static_cast<uint32>(Index);
+		}
+		return Entries;
+	}
+
+	bool IsSameEntries(const TArray<FMeshBatchSortEntry>& A, const TArray<FMeshBatchSortEntry>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (A[Index].Key != B[Index].Key || A[Index].Index != B[Index].Index)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void TestRadixSort()
+	{
+		const int32 Sizes[] = { 0, 1, 2, 255, 256, 257, FMeshBatchSorter::RadixGrainSize, FMeshBatchSorter::RadixGrainSize + 1, 5000, 100000 };
+		const EKeyPattern Patterns[] = { EKeyPattern::Random, EKeyPattern::FewKeys, EKeyPattern::HighByte };
+
+		TArray<FMeshBatchSortEntry> Scratch;
+		for (int32 Size : Sizes)
+		{
+			for (EKeyPattern Pattern : Patterns)
+			{
+				TArray<FMeshBatchSortEntry> Entries = MakeEntries(Size, Pattern, 1234u + static_cast<uint32>(Size));
+				TArray<FMeshBatchSortEntry> Expected = Entries;
+				std::stable_sort(Expected.begin(), Expected.end(), [](const FMeshBatchSortEntry& A, const FMeshBatchSortEntry& B)
+				{
+					return A.Key < B.Key;
+				});
+
+				FMeshBatchSorter::RadixSort(Entries, Scratch);
+				const bool bSame = IsSameEntries(Entries, Expected);
+				if (!bSame)
+				{
+					std::printf("  radix sort differs from std::stable_sort: %d entries, pattern %d\n", Size, static_cast<int32>(Pattern));
+				}
+				TEST_CHECK(bSame);
+			}
+		}
+	}
+
+	// ──────────────────────────────────────────────
+	// 배치 정렬
+	// ──────────────────────────────────────────────
+
+	// 셰이더 24, 머티리얼 600, 메시 2000 (메시당 섹션 1~3개, 섹션은 연달아 수집)
+	// NumInstanceSRVs > 0이면 컴포넌트 4개 중 하나가 인스턴스 SRV 중 하나를 씀 (메시 파티클 이미터)
+	TArray<FMeshBatchElement> MakeScene(int32 NumBatches, uint32 Seed, uint32 NumInstanceSRVs = 0)
+	{
+		constexpr int32 NumPrograms = 24;
+		constexpr int32 NumMaterials = 600;
+		constexpr int32 NumMeshes = 2000;
+
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> PositionDist(-2000.0f, 2000.0f);
+
+		TArray<FMeshBatchElement> Batches;
+		Batches.reserve(NumBatches);
+		while (Batches.Num() < NumBatches)
+		{
+			const uint32 Mesh = Rng() % NumMeshes;
+			const uint32 NumSections = 1 + Mesh % 3;
+			FMatrix World = FMatrix::Identity();
+			World.M[3][0] = PositionDist(Rng);
+			World.M[3][1] = PositionDist(Rng);
+			World.M[3][2] = PositionDist(Rng);
+			ID3D11ShaderResourceView* InstanceSRV = nullptr;
+			if (NumInstanceSRVs > 0 && Rng() % 4 == 0)
+			{
+				InstanceSRV = FakePointer<ID3D11ShaderResourceView>(6, Rng() % NumInstanceSRVs);
+			}
+
+			for (uint32 Section = 0; Section < NumSections && Batches.Num() < NumBatches; ++Section)
+			{
+				const uint32 Program = (Mesh * 7 + Section) % NumPrograms;
+				const uint32 Material = (Mesh * 3 + Section * 11) % NumMaterials;
+
+				FMeshBatchElement Batch;
+				Batch.VertexShader = FakePointer<ID3D11VertexShader>(1, Program);
+				Batch.PixelShader = FakePointer<ID3D11PixelShader>(2, Program);
+				Batch.Material = FakePointer<UMaterialInterface>(3, Material);
+				Batch.VertexBuffer = FakePointer<ID3D11Buffer>(4, Mesh);
+				Batch.IndexBuffer = FakePointer<ID3D11Buffer>(5, Mesh);
+				Batch.VertexStride = 64;
+				Batch.StartIndex = Section * 3000;
+				Batch.IndexCount = 3000;
+				Batch.WorldMatrix = World;
+				Batch.InstanceShaderResourceView = InstanceSRV;
+				Batch.ObjectID = static_cast<uint32>(Batches.Num());
+				Batches.Add(Batch);
+			}
+		}
+		return Batches;
+	}
+
+	/** SortKey 오름차순이고 같은 키는 ObjectID(원래 위치) 오름차순인지 */
+	bool IsStableSortedByKey(const TArray<FMeshBatchElement>& Batches)
+	{
+		for (int32 Index = 1; Index < Batches.Num(); ++Index)
+		{
+			const FMeshBatchElement& Prev = Batches[Index - 1];
+			const FMeshBatchElement& Batch = Batches[Index];
+			if (Prev.SortKey > Batch.SortKey || (Prev.SortKey == Batch.SortKey && Prev.ObjectID > Batch.ObjectID))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool IsPermutation(const TArray<FMeshBatchElement>& Batches)
+	{
+		TArray<uint8> Seen;
+		Seen.resize(Batches.Num(), 0);
+		for (const FMeshBatchElement& Batch : Batches)
+		{
+			if (Batch.ObjectID >= static_cast<uint32>(Batches.Num()) || Seen[Batch.ObjectID]++)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void TestSortStable()
+	{
+		// 같은 상태/위치의 배치가 많은 장면 (키가 같은 배치가 큰 덩어리로 생김)
+		for (int32 NumBatches : { 200, 20000 })
+		{
+			TArray<FMeshBatchElement> Batches;
+			for (int32 Index = 0; Index < NumBatches; ++Index)
+			{
+				FMeshBatchElement Batch;
+				Batch.VertexShader = FakePointer<ID3D11VertexShader>(1, Index % 3);
+				Batch.Material = FakePointer<UMaterialInterface>(3, (Index / 7) % 5);
+				Batch.VertexBuffer = FakePointer<ID3D11Buffer>(4, Index % 2);
+				Batch.WorldMatrix = FMatrix::Identity();
+				Batch.ObjectID = static_cast<uint32>(Index);
+				Batches.Add(Batch);
+			}
+
+			FMeshBatchSorter Sorter;
+			Sorter.AssignKeysAndSort(Batches, EMeshSortMode::Opaque, FMatrix::Identity());
+			TEST_CHECK(IsPermutation(Batches));
+			TEST_CHECK(IsStableSortedByKey(Batches));
+		}
+
+		// 합성 장면: std::stable_sort(SortKey)와 같은 순서
+		TArray<FMeshBatchElement> Batches = MakeScene(50000, 77);
+		FMeshBatchSorter Sorter;
+		Sorter.AssignKeys(Batches, EMeshSortMode::Opaque, FMatrix::Identity());
+		TArray<FMeshBatchElement> Expected = Batches;
+		std::stable_sort(Expected.begin(), Expected.end(), [](const FMeshBatchElement& A, const FMeshBatchElement& B)
+		{
+			return A.SortKey < B.SortKey;
+		});
+		Sorter.Sort(Batches);
+
+		bool bSameOrder = Batches.Num() == Expected.Num();
+		for (int32 Index = 0; Index < Batches.Num() && bSameOrder; ++Index)
+		{
+			bSameOrder = Batches[Index].ObjectID == Expected[Index].ObjectID;
+		}
+		TEST_CHECK(bSameOrder);
+		TEST_CHECK(IsPermutation(Batches));
+	}
+
+	void TestKeyOrder()
+	{
+		// 뷰 공간 Z = 월드 Z (항등 뷰)
+		auto MakeBatch = [](uint64 Program, float Depth, int32 Priority, uint32 ObjectID)
+		{
+			FMeshBatchElement Batch;
+			Batch.VertexShader = FakePointer<ID3D11VertexShader>(1, Program);
+			Batch.Material = FakePointer<UMaterialInterface>(3, 0);
+			Batch.WorldMatrix = FMatrix::Identity();
+			Batch.WorldMatrix.M[3][2] = Depth;
+			Batch.SortPriority = Priority;
+			Batch.ObjectID = ObjectID;
+			return Batch;
+		};
+
+		TArray<FMeshBatchElement> Opaque;
+		Opaque.Add(MakeBatch(0, 50.0f, 2, 0));
+		Opaque.Add(MakeBatch(0, 900.0f, -1, 1));
+		Opaque.Add(MakeBatch(1, 10.0f, -1, 2));
+		Opaque.Add(MakeBatch(0, 5.0f, -1, 3));
+		Opaque.Add(MakeBatch(1, 400.0f, -1, 4));
+
+		FMeshBatchSorter Sorter;
+		Sorter.AssignKeysAndSort(Opaque, EMeshSortMode::Opaque, FMatrix::Identity());
+		// 우선순위 없음(-1) → 프로그램 0 (앞→뒤), 프로그램 1 (앞→뒤) → 우선순위 2
+		const uint32 ExpectedOpaque[] = { 3, 1, 2, 4, 0 };
+		for (int32 Index = 0; Index < 5; ++Index)
+		{
+			TEST_CHECK(Opaque[Index].ObjectID == ExpectedOpaque[Index]);
+		}
+
+		TArray<FMeshBatchElement> Translucent;
+		Translucent.Add(MakeBatch(0, 10.0f, -1, 0));
+		Translucent.Add(MakeBatch(1, 300.0f, -1, 1));
+		Translucent.Add(MakeBatch(0, 1000.0f, -1, 2));
+		Translucent.Add(MakeBatch(1, 20.0f, -1, 3));
+		Sorter.AssignKeysAndSort(Translucent, EMeshSortMode::Translucent, FMatrix::Identity());
+		// 프로그램과 관계없이 뒤→앞
+		const uint32 ExpectedTranslucent[] = { 2, 1, 3, 0 };
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			TEST_CHECK(Translucent[Index].ObjectID == ExpectedTranslucent[Index]);
+		}
+	}
+
+	void TestStateChanges(uint32 NumInstanceSRVs)
+	{
+		const TArray<FMeshBatchElement> Source = MakeScene(50000, 1234, NumInstanceSRVs);
+
+		TArray<FMeshBatchElement> Comparison = Source;
+		Comparison.Sort();
+		const FMeshBatchStateChanges ComparisonChanges = FMeshBatchSorter::CountStateChanges(Comparison);
+
+		TArray<FMeshBatchElement> Radix = Source;
+		FMeshBatchSorter Sorter;
+		Sorter.AssignKeysAndSort(Radix, EMeshSortMode::Opaque, FMatrix::Identity());
+		const FMeshBatchStateChanges RadixChanges = FMeshBatchSorter::CountStateChanges(Radix);
+
+		std::printf("  state changes (shader/material/geometry), %u instance SRVs: comparison %u/%u/%u, radix %u/%u/%u\n",
+			NumInstanceSRVs, ComparisonChanges.Shader, ComparisonChanges.Material, ComparisonChanges.Geometry,
+			RadixChanges.Shader, RadixChanges.Material, RadixChanges.Geometry);
+		// 상태 우선 키라 (프로그램, 머티리얼, SRV) 조합마다 머티리얼 바인딩이 정확히 한 번
+		std::set<std::pair<const void*, const void*>> Programs;
+		std::set<std::tuple<const void*, const void*, const void*, const void*>> MaterialGroups;
+		for (const FMeshBatchElement& Batch : Source)
+		{
+			Programs.insert({ Batch.VertexShader, Batch.PixelShader });
+			MaterialGroups.insert({ Batch.VertexShader, Batch.PixelShader, Batch.Material, Batch.InstanceShaderResourceView });
+		}
+		TEST_CHECK(RadixChanges.Shader == static_cast<uint32>(Programs.size()));
+		TEST_CHECK(RadixChanges.Material == static_cast<uint32>(MaterialGroups.size()));
+		TEST_CHECK(RadixChanges.Shader <= ComparisonChanges.Shader);
+		TEST_CHECK(RadixChanges.Material <= ComparisonChanges.Material);
+		if (NumInstanceSRVs == 0)
+		{
+			TEST_CHECK(RadixChanges.Geometry <= ComparisonChanges.Geometry);
+		}
+		else
+		{
+			// operator<는 인스턴스 SRV를 비교하지 않아 같은 머티리얼 안에서 SRV가 섞임
+			// 키 정렬은 (머티리얼, SRV)로 묶으므로 지오메트리 변경은 늘지만 합계는 줄어듦
+			TEST_CHECK(RadixChanges.Material < ComparisonChanges.Material);
+			TEST_CHECK(RadixChanges.GetTotal() < ComparisonChanges.GetTotal());
+		}
+	}
+
+	TArray<uint32> SortSceneObjectIDs(int32 NumBatches, uint32 Seed)
+	{
+		TArray<FMeshBatchElement> Batches = MakeScene(NumBatches, Seed);
+		FMeshBatchSorter Sorter;
+		Sorter.AssignKeysAndSort(Batches, EMeshSortMode::Opaque, FMatrix::Identity());
+		TArray<uint32> ObjectIDs;
+		for (const FMeshBatchElement& Batch : Batches)
+		{
+			ObjectIDs.Add(Batch.ObjectID);
+		}
+		return ObjectIDs;
+	}
+
+	// ──────────────────────────────────────────────
+	// 벤치마크
+	// ──────────────────────────────────────────────
+
+	void RunBenchmark()
+	{
+		constexpr int32 NumBatches = 50000;
+		constexpr int32 NumIterations = 10;
+		const TArray<FMeshBatchElement> Source = MakeScene(NumBatches, 1234);
+
+		TArray<FMeshBatchElement> Batches;
+		FMeshBatchSorter Sorter;
+		double ComparisonMS = 0.0, AssignKeysMS = 0.0, RadixMS = 0.0;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Batches = Source;
+			MundiTest::FTimer Timer;
+			Batches.Sort();
+			ComparisonMS += Timer.ElapsedMS();
+
+			Batches = Source;
+			Timer = MundiTest::FTimer();
+			Sorter.AssignKeys(Batches, EMeshSortMode::Opaque, FMatrix::Identity());
+			AssignKeysMS += Timer.ElapsedMS();
+			Timer = MundiTest::FTimer();
+			Sorter.Sort(Batches);
+			RadixMS += Timer.ElapsedMS();
+		}
+
+		std::printf("[MeshBatchSort Bench] %d batches, %d iterations\n", NumBatches, NumIterations);
+		std::printf("  comparison sort %.3f ms\n", ComparisonMS / NumIterations);
+		std::printf("  radix: keys %.3f ms + sort %.3f ms = %.3f ms\n",
+			AssignKeysMS / NumIterations, RadixMS / NumIterations, (AssignKeysMS + RadixMS) / NumIterations);
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	TestRadixSort();
+	TestSortStable();
+	TestKeyOrder();
+	TestStateChanges(0);
+	TestStateChanges(8);
+	const TArray<uint32> SerialOrder = SortSceneObjectIDs(50000, 99);
+
+	FTaskGraph::GetInstance().Initialize(4);
+
+	TestRadixSort();
+	TestSortStable();
+	TEST_CHECK(SortSceneObjectIDs(50000, 99) == SerialOrder);
+
+	if (MundiTest::HasArg(Argc, Argv, "--bench"))
+	{
+		RunBenchmark();
+	}
+
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("MeshBatchSortTests");
+}
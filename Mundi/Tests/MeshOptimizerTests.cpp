@@ -0,0 +1,317 @@
+#include "pch.h"
+#include "TestHarness.h"
+#include "MeshOptimizer.h"
+#include <random>
+
+// 쿠킹 시점 메시 최적화(MeshOptimizer) 검사
+// - FIFO 캐시 시뮬레이터(AnalyzeVertexCache)의 ACMR/ATVR 값
+// - 그룹마다 삼각형 multiset(감김 방향 포함)이 최적화 전후로 같고, 그룹 경계를 넘지 않음
+// - 섞인 격자/행 순서 격자 모두 ACMR이 좋아짐
+// - 정점 페치 순서: 처음 참조 순서대로 번호가 매겨지고 참조되지 않는 정점은 제거
+// - 범위를 벗어난 인덱스가 있으면 손대지 않음
+// - --bench: 섞인 18만 삼각형 구의 최적화 시간과 ACMR/ATVR
+
+namespace
+{
+    /** 원래 정점 번호를 Id로 들고 다녀서 재배치 후에도 삼각형을 비교할 수 있게 함 */
+    struct FTestVertex
+    {
+        FVector Position;
+        uint32 Id = 0;
+    };
+
+    struct FTestMesh
+    {
+        TArray<FTestVertex> Vertices;
+        TArray<uint32> Indices;
+        TArray<FGroupInfo> Groups;
+    };
+
+    using FTriangleKey = std::array<uint32, 3>;
+
+    const FVector& GetPosition(const FTestVertex& Vertex)
+    {
+        return Vertex.Position;
+    }
+
+    /** 감김 방향은 유지하고 가장 작은 Id가 앞에 오도록 회전 */
+    FTriangleKey MakeTriangleKey(uint32 A, uint32 B, uint32 C)
+    {
+        if (B < A && B < C)
+        {
+            return { B, C, A };
+        }
+        if (C < A && C < B)
+        {
+            return { C, A, B };
+        }
+        return { A, B, C };
+    }
+
+    TArray<FTriangleKey> GroupTriangles(const FTestMesh& Mesh, const FGroupInfo& Group)
+    {
+        TArray<FTriangleKey> Triangles;
+        for (uint32 i = Group.StartIndex; i < Group.StartIndex + Group.IndexCount; i += 3)
+        {
+            Triangles.push_back(MakeTriangleKey(
+                Mesh.Vertices[Mesh.Indices[i]].Id, Mesh.Vertices[Mesh.Indices[i + 1]].Id, Mesh.Vertices[Mesh.Indices[i + 2]].Id));
+        }
+        std::sort(Triangles.begin(), Triangles.end());
+        return Triangles;
+    }
+
+    /** Resolution x Resolution 사각형 격자, 위/아래 절반을 그룹 둘로 나눔 */
+    FTestMesh MakeGrid(int32 Resolution)
+    {
+        FTestMesh Mesh;
+        for (int32 Y = 0; Y <= Resolution; ++Y)
+        {
+            for (int32 X = 0; X <= Resolution; ++X)
+            {
+                FTestVertex Vertex;
+                Vertex.Position = FVector(static_cast<float>(X), static_cast<float>(Y), 0.0f);
+                Vertex.Id = static_cast<uint32>(Mesh.Vertices.size());
+                Mesh.Vertices.push_back(Vertex);
+            }
+        }
+        for (int32 Y = 0; Y < Resolution; ++Y)
+        {
+            for (int32 X = 0; X < Resolution; ++X)
+            {
+                const uint32 I0 = Y * (Resolution + 1) + X;
+                const uint32 I1 = I0 + 1;
+                const uint32 I2 = I0 + Resolution + 1;
+                const uint32 I3 = I2 + 1;
+                Mesh.Indices.insert(Mesh.Indices.end(), { I0, I2, I1, I1, I2, I3 });
+            }
+        }
+
+        const uint32 Half = static_cast<uint32>(Mesh.Indices.size()) / 6 * 3;
+        FGroupInfo Top;
+        Top.StartIndex = 0;
+        Top.IndexCount = Half;
+        FGroupInfo Bottom;
+        Bottom.StartIndex = Half;
+        Bottom.IndexCount = static_cast<uint32>(Mesh.Indices.size()) - Half;
+        Mesh.Groups = { Top, Bottom };
+        return Mesh;
+    }
+
+    /** 위도/경도 구 (Stacks x Slices x 2 삼각형) */
+    FTestMesh MakeSphere(int32 Stacks, int32 Slices)
+    {
+        FTestMesh Mesh;
+        for (int32 Stack = 0; Stack <= Stacks; ++Stack)
+        {
+            const float Phi = 3.14159265f * Stack / Stacks;
+            for (int32 Slice = 0; Slice <= Slices; ++Slice)
+            {
+                const float Theta = 2.0f * 3.14159265f * Slice / Slices;
+                FTestVertex Vertex;
+                Vertex.Position = FVector(std::sin(Phi) * std::cos(Theta), std::sin(Phi) * std::sin(Theta), std::cos(Phi));
+                Vertex.Id = static_cast<uint32>(Mesh.Vertices.size());
+                Mesh.Vertices.push_back(Vertex);
+            }
+        }
+        for (int32 Stack = 0; Stack < Stacks; ++Stack)
+        {
+            for (int32 Slice = 0; Slice < Slices; ++Slice)
+            {
+                const uint32 I0 = Stack * (Slices + 1) + Slice;
+                const uint32 I1 = I0 + 1;
+                const uint32 I2 = I0 + Slices + 1;
+                const uint32 I3 = I2 + 1;
+                Mesh.Indices.insert(Mesh.Indices.end(), { I0, I1, I2, I1, I3, I2 });
+            }
+        }
+        FGroupInfo Group;
+        Group.IndexCount = static_cast<uint32>(Mesh.Indices.size());
+        Mesh.Groups = { Group };
+        return Mesh;
+    }
+
+    /** 그룹 범위 안에서만 삼각형 순서를 섞음 */
+    void ShuffleTriangles(FTestMesh& Mesh, uint32 Seed)
+    {
+        std::mt19937 Rng(Seed);
+        for (const FGroupInfo& Group : Mesh.Groups)
+        {
+            const uint32 NumTriangles = Group.IndexCount / 3;
+            for (uint32 Tri = NumTriangles - 1; Tri > 0; --Tri)
+            {
+                const uint32 Other = std::uniform_int_distribution<uint32>(0, Tri)(Rng);
+                for (uint32 Corner = 0; Corner < 3; ++Corner)
+                {
+                    std::swap(Mesh.Indices[Group.StartIndex + Tri * 3 + Corner], Mesh.Indices[Group.StartIndex + Other * 3 + Corner]);
+                }
+            }
+        }
+    }
+
+    MeshOptimizer::FVertexCacheStats Analyze(const FTestMesh& Mesh)
+    {
+        return MeshOptimizer::AnalyzeVertexCache(Mesh.Indices.data(), static_cast<uint32>(Mesh.Indices.size()), static_cast<uint32>(Mesh.Vertices.size()));
+    }
+
+    // ──────────────────────────────────────────────
+    // 검사
+    // ──────────────────────────────────────────────
+
+    void TestAnalyzeVertexCache()
+    {
+        // 삼각형 하나: 미스 3, 변을 공유하는 둘: 미스 4 → ACMR 2, ATVR 1
+        const uint32 One[] = { 0, 1, 2 };
+        const MeshOptimizer::FVertexCacheStats OneStats = MeshOptimizer::AnalyzeVertexCache(One, 3, 3);
+        TEST_CHECK(OneStats.NumCacheMisses == 3 && OneStats.ACMR == 3.0f && OneStats.ATVR == 1.0f);
+
+        const uint32 Quad[] = { 0, 1, 2, 2, 1, 3 };
+        const MeshOptimizer::FVertexCacheStats QuadStats = MeshOptimizer::AnalyzeVertexCache(Quad, 6, 4);
+        TEST_CHECK(QuadStats.NumTriangles == 2 && QuadStats.NumVertices == 4);
+        TEST_CHECK(QuadStats.ACMR == 2.0f && QuadStats.ATVR == 1.0f);
+
+        // 캐시 크기 3: 정점 0이 밀려난 뒤 다시 쓰이면 미스
+        const uint32 Evicted[] = { 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+        TEST_CHECK(MeshOptimizer::AnalyzeVertexCache(Evicted, 9, 6, 3).NumCacheMisses == 9);
+        TEST_CHECK(MeshOptimizer::AnalyzeVertexCache(Evicted, 9, 6, 6).NumCacheMisses == 6);
+
+        TEST_CHECK(MeshOptimizer::AnalyzeVertexCache(nullptr, 0, 0).NumTriangles == 0);
+    }
+
+    /** 최적화 전후 그룹별 삼각형 multiset 비교 + 정점 페치 순서 검사 */
+    void CheckOptimizedMesh(const FTestMesh& Before, const FTestMesh& After)
+    {
+        for (const FGroupInfo& Group : Before.Groups)
+        {
+            TEST_CHECK(GroupTriangles(Before, Group) == GroupTriangles(After, Group));
+        }
+        TEST_CHECK(Before.Indices.size() == After.Indices.size());
+
+        // 새 번호는 인덱스 버퍼에서 처음 등장하는 순서 (0, 1, 2, ...)
+        uint32 NextVertex = 0;
+        bool bFetchOrdered = true;
+        for (uint32 Index : After.Indices)
+        {
+            if (Index == NextVertex)
+            {
+                ++NextVertex;
+            }
+            else if (Index > NextVertex)
+            {
+                bFetchOrdered = false;
+            }
+        }
+        TEST_CHECK(bFetchOrdered);
+        TEST_CHECK(NextVertex == After.Vertices.size());
+    }
+
+    void TestShuffledGrid()
+    {
+        FTestMesh Mesh = MakeGrid(48);
+        ShuffleTriangles(Mesh, 3);
+        const FTestMesh Original = Mesh;
+        const MeshOptimizer::FVertexCacheStats Before = Analyze(Mesh);
+
+        MeshOptimizer::OptimizeMesh("ShuffledGrid", Mesh.Vertices, Mesh.Indices, Mesh.Groups, GetPosition);
+        const MeshOptimizer::FVertexCacheStats After = Analyze(Mesh);
+
+        CheckOptimizedMesh(Original, Mesh);
+        TEST_CHECK(After.NumTriangles == Before.NumTriangles);
+        TEST_CHECK(After.NumVertices == Before.NumVertices);
+        // 섞인 격자는 거의 매번 미스(~2.8), 최적화 후 격자의 이론 하한(0.5)에 가까워야 함
+        TEST_CHECK(Before.ACMR > 2.0f);
+        TEST_CHECK(After.ACMR < 0.9f);
+        TEST_CHECK(After.ATVR < Before.ATVR);
+    }
+
+    void TestRowMajorGrid()
+    {
+        // 행 너비(65 정점)가 캐시(16)보다 커서 행 순서로는 윗줄 정점을 다시 읽을 때마다 미스
+        FTestMesh Mesh = MakeGrid(64);
+        const FTestMesh Original = Mesh;
+        const MeshOptimizer::FVertexCacheStats Before = Analyze(Mesh);
+
+        MeshOptimizer::FSettings Settings;
+        Settings.bOptimizeOverdraw = false;
+        MeshOptimizer::OptimizeMesh("RowMajorGrid", Mesh.Vertices, Mesh.Indices, Mesh.Groups, GetPosition, Settings);
+        const MeshOptimizer::FVertexCacheStats After = Analyze(Mesh);
+
+        CheckOptimizedMesh(Original, Mesh);
+        TEST_CHECK(After.ACMR < Before.ACMR);
+    }
+
+    void TestUnreferencedVertices()
+    {
+        FTestMesh Mesh = MakeGrid(8);
+        // 어느 삼각형도 쓰지 않는 정점 둘
+        Mesh.Vertices.push_back({ FVector(100.0f, 0.0f, 0.0f), static_cast<uint32>(Mesh.Vertices.size()) });
+        Mesh.Vertices.push_back({ FVector(200.0f, 0.0f, 0.0f), static_cast<uint32>(Mesh.Vertices.size()) });
+        const FTestMesh Original = Mesh;
+
+        MeshOptimizer::OptimizeMesh("UnreferencedVertices", Mesh.Vertices, Mesh.Indices, Mesh.Groups, GetPosition);
+
+        CheckOptimizedMesh(Original, Mesh);
+        TEST_CHECK(Mesh.Vertices.size() == Original.Vertices.size() - 2);
+        TEST_CHECK(std::none_of(Mesh.Vertices.begin(), Mesh.Vertices.end(), [](const FTestVertex& Vertex) { return Vertex.Position.X >= 100.0f; }));
+    }
+
+    void TestOutOfRangeIndices()
+    {
+        FTestMesh Mesh = MakeGrid(4);
+        ShuffleTriangles(Mesh, 5);
+        Mesh.Indices[7] = static_cast<uint32>(Mesh.Vertices.size()) + 10;
+        const TArray<uint32> OriginalIndices = Mesh.Indices;
+
+        TArray<FVector> Positions;
+        for (const FTestVertex& Vertex : Mesh.Vertices)
+        {
+            Positions.push_back(Vertex.Position);
+        }
+        TArray<uint32> Remap;
+        const uint32 NumVertices = MeshOptimizer::OptimizeIndices(Mesh.Indices, Mesh.Groups, Positions, MeshOptimizer::FSettings(), Remap);
+
+        // 손상된 메시는 항등 매핑으로 그대로 둠
+        TEST_CHECK(NumVertices == Mesh.Vertices.size());
+        TEST_CHECK(Mesh.Indices == OriginalIndices);
+        bool bIdentity = Remap.size() == Mesh.Vertices.size();
+        for (uint32 v = 0; bIdentity && v < Remap.size(); ++v)
+        {
+            bIdentity = Remap[v] == v;
+        }
+        TEST_CHECK(bIdentity);
+    }
+
+    // ──────────────────────────────────────────────
+    // 벤치마크
+    // ──────────────────────────────────────────────
+
+    void RunOptimizeBenchmark()
+    {
+        FTestMesh Mesh = MakeSphere(300, 300);
+        ShuffleTriangles(Mesh, 9);
+        const MeshOptimizer::FVertexCacheStats Before = Analyze(Mesh);
+
+        MundiTest::FTimer Timer;
+        MeshOptimizer::OptimizeMesh("BenchSphere", Mesh.Vertices, Mesh.Indices, Mesh.Groups, GetPosition);
+        const double OptimizeMS = Timer.ElapsedMS();
+        const MeshOptimizer::FVertexCacheStats After = Analyze(Mesh);
+
+        std::printf("MESH OPTIMIZE BENCH (shuffled sphere, %u tris, %u vertices)\n", After.NumTriangles, After.NumVertices);
+        std::printf("  optimize: %.1f ms\n", OptimizeMS);
+        std::printf("  ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (FIFO 16)\n", Before.ACMR, After.ACMR, Before.ATVR, After.ATVR);
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestAnalyzeVertexCache();
+    TestShuffledGrid();
+    TestRowMajorGrid();
+    TestUnreferencedVertices();
+    TestOutOfRangeIndices();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunOptimizeBenchmark();
+    }
+    return MundiTest::Finish("MeshOptimizerTests");
+}
@@ -0,0 +1,492 @@
+#include "pch.h"
+#include "TestHarness.h"
+#include "MeshSimplifier.h"
+#include "MeshLOD.h"
+#include "SceneView.h"
+#include "RenderSettings.h"
+#include "AABB.h"
+
+// 쿠킹 시점 LOD 생성(MeshSimplifier)과 런타임 LOD 선택(MeshLOD) 검사
+// - 울퉁불퉁한 닫힌 구(그룹 둘): LOD마다 삼각형 수가 단조 감소, 오차는 단조 증가하고 상한 이내
+// - 저장된 RelativeError가 원본 정점 → LOD 면 최대 거리(브루트 포스)의 상한
+// - 섹션이 그룹 정점만 쓰고, 퇴화/뒤집힌 삼각형이 없음
+// - 평면 격자: 면적 유지, 열린 경계와 UV 이음새 정점은 모든 LOD에 남음
+// - SelectLOD: 투영 화면 크기별 기대 LOD, 히스테리시스 띠, 강제 LOD, 직교 투영
+// - --bench: 36만 삼각형 구의 LOD 생성 시간
+
+namespace
+{
+    struct FTestVertex
+    {
+        FVector Position;
+        FVector2D UV;
+    };
+
+    struct FTestMesh
+    {
+        TArray<FTestVertex> Vertices;
+        TArray<uint32> Indices;
+        TArray<FGroupInfo> Groups;
+    };
+
+    const FVector& GetPosition(const FTestVertex& Vertex)
+    {
+        return Vertex.Position;
+    }
+
+    FVector TriangleNormal(const FTestMesh& Mesh, uint32 A, uint32 B, uint32 C)
+    {
+        const FVector& PA = Mesh.Vertices[A].Position;
+        return FVector::Cross(Mesh.Vertices[B].Position - PA, Mesh.Vertices[C].Position - PA);
+    }
+
+    /**
+     * 반지름이 sin 파형으로 울퉁불퉁한 닫힌 구 (극점 하나씩, 경도 이음새 공유)
+     * 북반구/남반구 삼각형을 그룹 둘로 나누고 Cross(B - A, C - A)가 바깥을 보도록 감음 (엔진 규칙)
+     */
+    FTestMesh MakeBumpySphere(int32 Stacks, int32 Slices)
+    {
+        constexpr float Pi = 3.14159265f;
+        auto MakePosition = [](float Phi, float Theta)
+        {
+            const float Radius = 1.0f + 0.04f * std::sin(5.0f * Theta) * std::sin(4.0f * Phi);
+            return FVector(std::sin(Phi) * std::cos(Theta), std::sin(Phi) * std::sin(Theta), std::cos(Phi)) * Radius;
+        };
+
+        FTestMesh Mesh;
+        Mesh.Vertices.push_back({ MakePosition(0.0f, 0.0f), FVector2D(0.5f, 0.0f) });
+        for (int32 Stack = 1; Stack < Stacks; ++Stack)
+        {
+            for (int32 Slice = 0; Slice < Slices; ++Slice)
+            {
+                Mesh.Vertices.push_back({ MakePosition(Pi * Stack / Stacks, 2.0f * Pi * Slice / Slices), FVector2D(0.5f, 0.5f) });
+            }
+        }
+        const uint32 SouthPole = static_cast<uint32>(Mesh.Vertices.size());
+        Mesh.Vertices.push_back({ MakePosition(Pi, 0.0f), FVector2D(0.5f, 1.0f) });
+
+        auto Ring = [Slices](int32 Stack, int32 Slice)
+        {
+            return static_cast<uint32>(1 + (Stack - 1) * Slices + (Slice % Slices));
+        };
+
+        TArray<uint32> North;
+        TArray<uint32> South;
+        auto AddTriangle = [&](uint32 A, uint32 B, uint32 C)
+        {
+            const FVector Centroid = (Mesh.Vertices[A].Position + Mesh.Vertices[B].Position + Mesh.Vertices[C].Position) / 3.0f;
+            if (FVector::Dot(TriangleNormal(Mesh, A, B, C), Centroid) < 0.0f)
+            {
+                std::swap(B, C);
+            }
+            TArray<uint32>& Target = Centroid.Z >= 0.0f ? North : South;
+            Target.insert(Target.end(), { A, B, C });
+        };
+
+        for (int32 Slice = 0; Slice < Slices; ++Slice)
+        {
+            AddTriangle(0, Ring(1, Slice), Ring(1, Slice + 1));
+            AddTriangle(SouthPole, Ring(Stacks - 1, Slice), Ring(Stacks - 1, Slice + 1));
+        }
+        for (int32 Stack = 1; Stack < Stacks - 1; ++Stack)
+        {
+            for (int32 Slice = 0; Slice < Slices; ++Slice)
+            {
+                AddTriangle(Ring(Stack, Slice), Ring(Stack + 1, Slice), Ring(Stack, Slice + 1));
+                AddTriangle(Ring(Stack, Slice + 1), Ring(Stack + 1, Slice), Ring(Stack + 1, Slice + 1));
+            }
+        }
+
+        FGroupInfo NorthGroup;
+        NorthGroup.IndexCount = static_cast<uint32>(North.size());
+        FGroupInfo SouthGroup;
+        SouthGroup.StartIndex = NorthGroup.IndexCount;
+        SouthGroup.IndexCount = static_cast<uint32>(South.size());
+        Mesh.Indices = North;
+        Mesh.Indices.insert(Mesh.Indices.end(), South.begin(), South.end());
+        Mesh.Groups = { NorthGroup, SouthGroup };
+        return Mesh;
+    }
+
+    /**
+     * 평평한 Resolution x Resolution 격자 (열린 경계)
+     * SeamColumn 열은 같은 위치에 UV만 다른 정점을 하나 더 두고 오른쪽 사각형이 그쪽을 씀 (UV 이음새)
+     */
+    FTestMesh MakeFlatGridWithSeam(int32 Resolution, int32 SeamColumn)
+    {
+        FTestMesh Mesh;
+        TArray<uint32> Left((Resolution + 1) * (Resolution + 1));
+        TArray<uint32> Right((Resolution + 1) * (Resolution + 1));
+        for (int32 Y = 0; Y <= Resolution; ++Y)
+        {
+            for (int32 X = 0; X <= Resolution; ++X)
+            {
+                const int32 Cell = Y * (Resolution + 1) + X;
+                const FVector Position(static_cast<float>(X), static_cast<float>(Y), 0.0f);
+                Left[Cell] = Right[Cell] = static_cast<uint32>(Mesh.Vertices.size());
+                Mesh.Vertices.push_back({ Position, FVector2D(static_cast<float>(X) / Resolution, 0.0f) });
+                if (X == SeamColumn)
+                {
+                    Right[Cell] = static_cast<uint32>(Mesh.Vertices.size());
+                    Mesh.Vertices.push_back({ Position, FVector2D(static_cast<float>(X) / Resolution, 1.0f) });
+                }
+            }
+        }
+        for (int32 Y = 0; Y < Resolution; ++Y)
+        {
+            for (int32 X = 0; X < Resolution; ++X)
+            {
+                const TArray<uint32>& Side = X >= SeamColumn ? Right : Left;
+                const uint32 I0 = Side[Y * (Resolution + 1) + X];
+                const uint32 I1 = Side[Y * (Resolution + 1) + X + 1];
+                const uint32 I2 = Side[(Y + 1) * (Resolution + 1) + X];
+                const uint32 I3 = Side[(Y + 1) * (Resolution + 1) + X + 1];
+                Mesh.Indices.insert(Mesh.Indices.end(), { I0, I2, I1, I1, I2, I3 });
+            }
+        }
+        return Mesh;
+    }
+
+    float PointTriangleDistance(const FVector& P, const FVector& A, const FVector& B, const FVector& C)
+    {
+        // 삼각형 평면에 투영한 점이 안쪽이면 평면 거리, 아니면 세 변까지 거리 중 최소
+        const FVector Normal = FVector::Cross(B - A, C - A);
+        const float NormalLength = Normal.Size();
+        if (NormalLength > 0.0f)
+        {
+            const FVector N = Normal / NormalLength;
+            const FVector Projected = P - N * FVector::Dot(P - A, N);
+            const bool bInside = FVector::Dot(FVector::Cross(B - A, Projected - A), N) >= 0.0f
+                && FVector::Dot(FVector::Cross(C - B, Projected - B), N) >= 0.0f
+                && FVector::Dot(FVector::Cross(A - C, Projected - C), N) >= 0.0f;
+            if (bInside)
+            {
+                return std::abs(FVector::Dot(P - A, N));
+            }
+        }
+
+        auto SegmentDistance = [&P](const FVector& S0, const FVector& S1)
+        {
+            const FVector Segment = S1 - S0;
+            const float LengthSquared = FVector::Dot(Segment, Segment);
+            const float T = LengthSquared > 0.0f ? std::clamp(FVector::Dot(P - S0, Segment) / LengthSquared, 0.0f, 1.0f) : 0.0f;
+            return (P - (S0 + Segment * T)).Size();
+        };
+        return std::min({ SegmentDistance(A, B), SegmentDistance(B, C), SegmentDistance(C, A) });
+    }
+
+    float BoundsDiagonal(const FTestMesh& Mesh)
+    {
+        FVector Min = Mesh.Vertices[0].Position;
+        FVector Max = Min;
+        for (const FTestVertex& Vertex : Mesh.Vertices)
+        {
+            Min = Min.ComponentMin(Vertex.Position);
+            Max = Max.ComponentMax(Vertex.Position);
+        }
+        return (Max - Min).Size();
+    }
+
+    /** 원본 정점 → LOD 면 최대 거리 / 바운드 대각선 (브루트 포스) */
+    float MeasureRelativeError(const FTestMesh& Mesh, const FMeshLOD& LOD)
+    {
+        float MaxDistance = 0.0f;
+        for (const FTestVertex& Vertex : Mesh.Vertices)
+        {
+            float Nearest = FLT_MAX;
+            for (size_t i = 0; i < LOD.Indices.size() && Nearest > 0.0f; i += 3)
+            {
+                Nearest = std::min(Nearest, PointTriangleDistance(Vertex.Position,
+                    Mesh.Vertices[LOD.Indices[i]].Position, Mesh.Vertices[LOD.Indices[i + 1]].Position, Mesh.Vertices[LOD.Indices[i + 2]].Position));
+            }
+            MaxDistance = std::max(MaxDistance, Nearest);
+        }
+        return MaxDistance / BoundsDiagonal(Mesh);
+    }
+
+    TArray<uint8> ReferencedVertices(const TArray<uint32>& Indices, size_t NumVertices, uint32 Start, uint32 Count)
+    {
+        TArray<uint8> Referenced(NumVertices, 0);
+        for (uint32 i = Start; i < Start + Count; ++i)
+        {
+            Referenced[Indices[i]] = 1;
+        }
+        return Referenced;
+    }
+
+    // ──────────────────────────────────────────────
+    // 검사
+    // ──────────────────────────────────────────────
+
+    void TestSphereLODs()
+    {
+        const FTestMesh Mesh = MakeBumpySphere(40, 80);
+        const uint32 NumBaseTriangles = static_cast<uint32>(Mesh.Indices.size() / 3);
+
+        TArray<FMeshLOD> LODs;
+        MeshSimplifier::FSettings Settings;
+        MeshSimplifier::BuildLODs("BumpySphere", Mesh.Vertices, Mesh.Indices, Mesh.Groups, GetPosition, LODs, Settings);
+
+        TEST_CHECK(LODs.size() == Settings.NumLODs);
+
+        uint32 PreviousTriangles = NumBaseTriangles;
+        float PreviousError = 0.0f;
+        for (size_t LODIndex = 0; LODIndex < LODs.size(); ++LODIndex)
+        {
+            const FMeshLOD& LOD = LODs[LODIndex];
+            const uint32 NumTriangles = static_cast<uint32>(LOD.Indices.size() / 3);
+
+            // 삼각형 수는 목표(이전의 절반) 근처까지 단조 감소, 오차는 단조 증가하고 설정 상한 이내
+            TEST_CHECK(LOD.Indices.size() % 3 == 0);
+            TEST_CHECK(NumTriangles < PreviousTriangles);
+            TEST_CHECK(static_cast<float>(NumTriangles) <= static_cast<float>(PreviousTriangles) * 0.6f);
+            TEST_CHECK(LOD.RelativeError >= PreviousError);
+            TEST_CHECK(LOD.RelativeError <= Settings.MaxRelativeError);
+
+            // 섹션은 그룹 순서대로 이어져 있고, 각 섹션은 해당 그룹이 쓰던 정점만 참조
+            TEST_CHECK(LOD.Sections.size() == Mesh.Groups.size());
+            uint32 NextStart = 0;
+            bool bSectionsValid = true;
+            for (size_t SectionIndex = 0; SectionIndex < LOD.Sections.size(); ++SectionIndex)
+            {
+                const FMeshLODSection& Section = LOD.Sections[SectionIndex];
+                const FGroupInfo& Group = Mesh.Groups[SectionIndex];
+                bSectionsValid &= Section.StartIndex == NextStart && Section.IndexCount > 0 && Section.IndexCount % 3 == 0;
+                NextStart = Section.StartIndex + Section.IndexCount;
+
+                const TArray<uint8> GroupVertices = ReferencedVertices(Mesh.Indices, Mesh.Vertices.size(), Group.StartIndex, Group.IndexCount);
+                for (uint32 i = Section.StartIndex; i < Section.StartIndex + Section.IndexCount; ++i)
+                {
+                    bSectionsValid &= LOD.Indices[i] < Mesh.Vertices.size() && GroupVertices[LOD.Indices[i]];
+                }
+            }
+            TEST_CHECK(bSectionsValid);
+            TEST_CHECK(NextStart == LOD.Indices.size());
+
+            // 퇴화 삼각형 없음, 모두 바깥을 향함
+            int32 NumDegenerate = 0;
+            int32 NumFlipped = 0;
+            for (size_t i = 0; i < LOD.Indices.size(); i += 3)
+            {
+                const uint32 A = LOD.Indices[i], B = LOD.Indices[i + 1], C = LOD.Indices[i + 2];
+                if (A == B || B == C || A == C)
+                {
+                    ++NumDegenerate;
+                    continue;
+                }
+                const FVector Centroid = (Mesh.Vertices[A].Position + Mesh.Vertices[B].Position + Mesh.Vertices[C].Position) / 3.0f;
+                if (FVector::Dot(TriangleNormal(Mesh, A, B, C), Centroid) <= 0.0f)
+                {
+                    ++NumFlipped;
+                }
+            }
+            TEST_CHECK(NumDegenerate == 0);
+            TEST_CHECK(NumFlipped == 0);
+
+            // 저장된 오차는 원본 정점에서 LOD 면까지 최대 거리(단측 하우스도르프)의 상한
+            const float MeasuredError = MeasureRelativeError(Mesh, LOD);
+            TEST_CHECK(MeasuredError <= LOD.RelativeError * 1.001f + 1e-6f);
+            std::printf("  LOD%zu: %u tris, measured %.4f%%, reported %.4f%% of bounds\n",
+                LODIndex + 1, NumTriangles, MeasuredError * 100.0f, LOD.RelativeError * 100.0f);
+
+            PreviousTriangles = NumTriangles;
+            PreviousError = LOD.RelativeError;
+        }
+    }
+
+    void TestLockedBordersAndSeams()
+    {
+        constexpr int32 Resolution = 32;
+        constexpr int32 SeamColumn = 16;
+        const FTestMesh Mesh = MakeFlatGridWithSeam(Resolution, SeamColumn);
+
+        TArray<FMeshLOD> LODs;
+        MeshSimplifier::BuildLODs("FlatGrid", Mesh.Vertices, Mesh.Indices, Mesh.Groups, GetPosition, LODs);
+        TEST_CHECK(!LODs.empty());
+
+        for (const FMeshLOD& LOD : LODs)
+        {
+            // 평면 안에서만 붕괴하므로 면적이 그대로고 뒤집힌 삼각형이 없음 (실제 위치 오차 0)
+            // 저장된 RelativeError는 붕괴된 정점의 1-ring만 보는 상한이라 0보다 클 수 있음
+            float Area = 0.0f;
+            int32 NumFlipped = 0;
+            for (size_t i = 0; i < LOD.Indices.size(); i += 3)
+            {
+                const FVector Normal = TriangleNormal(Mesh, LOD.Indices[i], LOD.Indices[i + 1], LOD.Indices[i + 2]);
+                Area -= Normal.Z * 0.5f;
+                NumFlipped += Normal.Z >= 0.0f ? 1 : 0;
+            }
+            TEST_CHECK(std::abs(Area - Resolution * Resolution) < 1e-2f);
+            TEST_CHECK(NumFlipped == 0);
+            TEST_CHECK(MeasureRelativeError(Mesh, LOD) <= 1e-6f);
+            TEST_CHECK(LOD.Sections.size() == 1);
+
+            const TArray<uint8> Referenced = ReferencedVertices(LOD.Indices, Mesh.Vertices.size(), 0, static_cast<uint32>(LOD.Indices.size()));
+            int32 NumMissing = 0;
+            for (size_t v = 0; v < Mesh.Vertices.size(); ++v)
+            {
+                const FVector& P = Mesh.Vertices[v].Position;
+                const bool bBorder = P.X == 0.0f || P.Y == 0.0f || P.X == Resolution || P.Y == Resolution;
+                const bool bSeam = P.X == SeamColumn;
+                if ((bBorder || bSeam) && !Referenced[v])
+                {
+                    ++NumMissing;
+                }
+            }
+            TEST_CHECK(NumMissing == 0);
+        }
+    }
+
+    void TestDegenerateInput()
+    {
+        TArray<FMeshLOD> LODs;
+        const FTestMesh Sphere = MakeBumpySphere(8, 16);
+
+        // 범위를 벗어난 인덱스나 그룹이 있으면 LOD를 만들지 않음
+        FTestMesh Broken = Sphere;
+        Broken.Indices[4] = static_cast<uint32>(Broken.Vertices.size());
+        MeshSimplifier::BuildLODs("Broken", Broken.Vertices, Broken.Indices, Broken.Groups, GetPosition, LODs);
+        TEST_CHECK(LODs.empty());
+
+        FTestMesh BadGroup = Sphere;
+        BadGroup.Groups[1].IndexCount += 3;
+        MeshSimplifier::BuildLODs("BadGroup", BadGroup.Vertices, BadGroup.Indices, BadGroup.Groups, GetPosition, LODs);
+        TEST_CHECK(LODs.empty());
+
+        MeshSimplifier::FSettings NoLODs;
+        NoLODs.NumLODs = 0;
+        MeshSimplifier::BuildLODs("NoLODs", Sphere.Vertices, Sphere.Indices, Sphere.Groups, GetPosition, LODs, NoLODs);
+        TEST_CHECK(LODs.empty());
+    }
+
+    /** 90도 FOV, 정사각 1000픽셀 뷰 → ScreenSize = Radius / Distance */
+    FSceneView MakeView(URenderSettings* Settings, const FVector& Location)
+    {
+        FSceneView View;
+        View.ProjectionMatrix.M[0][0] = 1.0f;
+        View.ProjectionMatrix.M[1][1] = 1.0f;
+        View.ViewRect.MaxX = 1000;
+        View.ViewRect.MaxY = 1000;
+        View.ViewLocation = Location;
+        View.RenderSettings = Settings;
+        return View;
+    }
+
+    void TestSelectLOD()
+    {
+        // 반지름 5 (반 크기 3, 4, 0) → 대각선당 픽셀 = 5000 / 거리
+        const FAABB Bounds(FVector(-3.0f, -4.0f, 0.0f), FVector(3.0f, 4.0f, 0.0f));
+        TArray<FMeshLOD> LODs(3);
+        LODs[0].RelativeError = 0.001f;
+        LODs[1].RelativeError = 0.004f;
+        LODs[2].RelativeError = 0.016f;
+
+        URenderSettings Settings;
+        Settings.SetLODPixelError(1.0f);
+        Settings.SetLODHysteresis(0.15f);
+
+        auto Select = [&](float Distance, int32 CurrentLOD)
+        {
+            const FSceneView View = MakeView(&Settings, FVector(Distance, 0.0f, 0.0f));
+            return MeshLOD::SelectLOD(&View, Bounds, LODs, CurrentLOD);
+        };
+
+        const FSceneView Near = MakeView(&Settings, FVector(10.0f, 0.0f, 0.0f));
+        TEST_CHECK(std::abs(MeshLOD::ComputeScreenSize(&Near, Bounds) - 0.5f) < 1e-5f);
+
+        // 처음(LOD0)에서 허용치의 0.85배 이하인 가장 거친 LOD
+        TEST_CHECK(Select(0.5f, 0) == 0);      // 거리 1로 고정 → LOD1도 5px
+        TEST_CHECK(Select(10.0f, 0) == 1);     // 0.5 / 2 / 8 px
+        TEST_CHECK(Select(40.0f, 0) == 2);     // 0.125 / 0.5 / 2 px
+        TEST_CHECK(Select(100.0f, 0) == 3);    // 0.05 / 0.2 / 0.8 px
+        // 멀리 있어도 현재 LOD가 허용치 안이면 거친 쪽으로 계속 내려감
+        TEST_CHECK(Select(100.0f, 1) == 3);
+
+        // 히스테리시스: LOD1 오차 1.1px (1 ~ 1.15) → 유지, 1.25px → LOD0
+        TEST_CHECK(Select(5000.0f / 1100.0f, 1) == 1);
+        TEST_CHECK(Select(4.0f, 1) == 0);
+        // LOD2 오차 0.9px (0.85 ~ 1): LOD1에서는 내려가지 않고 LOD2에서는 유지
+        const float Distance09 = 5000.0f * 0.004f / 0.9f;
+        TEST_CHECK(Select(Distance09, 1) == 1);
+        TEST_CHECK(Select(Distance09, 2) == 2);
+
+        // 강제 LOD는 개수로 잘림, 뷰가 없거나 LOD가 없으면 0
+        Settings.SetForcedLOD(2);
+        TEST_CHECK(Select(0.5f, 0) == 2);
+        Settings.SetForcedLOD(9);
+        TEST_CHECK(Select(0.5f, 0) == 3);
+        Settings.SetForcedLOD(-1);
+        TEST_CHECK(MeshLOD::SelectLOD(nullptr, Bounds, LODs, 2) == 0);
+        TEST_CHECK(Select(100.0f, 0) == 3);
+        const TArray<FMeshLOD> NoLODs;
+        const FSceneView View = MakeView(&Settings, FVector(100.0f, 0.0f, 0.0f));
+        TEST_CHECK(MeshLOD::SelectLOD(&View, Bounds, NoLODs, 0) == 0);
+
+        // 직교 투영은 거리와 무관: M00 = 0.02 → 화면 크기 0.1 → 대각선당 100px
+        FSceneView Ortho = MakeView(&Settings, FVector(1000.0f, 0.0f, 0.0f));
+        Ortho.ProjectionMode = ECameraProjectionMode::Orthographic;
+        Ortho.ProjectionMatrix.M[0][0] = 0.02f;
+        Ortho.ProjectionMatrix.M[1][1] = 0.02f;
+        TEST_CHECK(std::abs(MeshLOD::ComputeScreenSize(&Ortho, Bounds) - 0.1f) < 1e-5f);
+        TEST_CHECK(MeshLOD::SelectLOD(&Ortho, Bounds, LODs, 0) == 2);   // 0.1 / 0.4 / 1.6 px
+    }
+
+    void TestSectionRange()
+    {
+        TArray<FGroupInfo> Groups(2);
+        Groups[0].IndexCount = 60;
+        Groups[1].StartIndex = 60;
+        Groups[1].IndexCount = 90;
+        TArray<FMeshLOD> LODs(2);
+        LODs[0].Indices.resize(75);
+        LODs[0].Sections = { { 0, 30 }, { 30, 45 } };
+        LODs[1].Indices.resize(36);
+        LODs[1].Sections = { { 0, 15 }, { 15, 21 } };
+
+        uint32 Start = 0;
+        uint32 Count = 0;
+        MeshLOD::GetSectionRange(Groups, 150, LODs, 0, 1, Start, Count);
+        TEST_CHECK(Start == 60 && Count == 90);
+        MeshLOD::GetSectionRange(Groups, 150, LODs, 1, 1, Start, Count);
+        TEST_CHECK(Start == 180 && Count == 45);
+        // LOD2는 LOD0(150) + LOD1(75) 뒤
+        MeshLOD::GetSectionRange(Groups, 150, LODs, 2, 0, Start, Count);
+        TEST_CHECK(Start == 225 && Count == 15);
+        MeshLOD::GetSectionRange(Groups, 150, LODs, 2, 5, Start, Count);
+        TEST_CHECK(Count == 0);
+        MeshLOD::GetSectionRange({}, 150, LODs, 0, 0, Start, Count);
+        TEST_CHECK(Start == 0 && Count == 150);
+    }
+
+    // ──────────────────────────────────────────────
+    // 벤치마크
+    // ──────────────────────────────────────────────
+
+    void RunSimplifyBenchmark()
+    {
+        const FTestMesh Mesh = MakeBumpySphere(300, 600);
+        TArray<FMeshLOD> LODs;
+
+        MundiTest::FTimer Timer;
+        MeshSimplifier::BuildLODs("BenchSphere", Mesh.Vertices, Mesh.Indices, Mesh.Groups, GetPosition, LODs);
+        const double SimplifyMS = Timer.ElapsedMS();
+
+        std::printf("MESH LOD BENCH (bumpy sphere, %zu tris, %zu vertices)\n", Mesh.Indices.size() / 3, Mesh.Vertices.size());
+        std::printf("  generate %zu LODs: %.1f ms\n", LODs.size(), SimplifyMS);
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestSphereLODs();
+    TestLockedBordersAndSeams();
+    TestDegenerateInput();
+    TestSelectLOD();
+    TestSectionRange();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunSimplifyBenchmark();
+    }
+    return MundiTest::Finish("MeshSimplifierTests");
+}
@@ -0,0 +1,479 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "ObjParser.h"
+#include "ObjManager.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <unordered_map>
+
+// ObjParser (메모리 맵 + 청크 병렬 .obj 파서, WeldCorners) 검사
+// - 기준: 변경 전 FObjImporter::LoadObjModel의 getline/stringstream 파서와 ConvertToStaticMesh의 unordered_map 병합 (아래 Legacy*)
+// - 작은 파일: 주석/빈 줄/앞 공백/면 뒤 주석/다각형/인덱스 형식 4가지/usemtl 그룹/마지막 mtllib/CRLF/마지막 줄 개행 없음
+// - 큰 파일(청크 3개): 청크 경계에 걸친 줄과 음수(상대) 인덱스, CRLF. 결과가 기준 파서와 비트 단위로 같음
+// - --bench: 같은 파일을 기준 파서와 현재 파서로 읽는 시간, 두 병합 시간
+
+namespace
+{
+    FTaskGraph& TaskGraph = FTaskGraph::GetInstance();
+
+    // ──────────────────────────────────────────────
+    // 변경 전 파서 (기준)
+    // 알 수 없는 줄마다 남기던 로그와, 정점이 2개 이하인 면에서 size() - 1이 언더플로되던 부분만 뺌
+    // 엔진은 Windows 텍스트 모드로 읽어 줄 끝 \r이 빠지므로 여기서도 getline 뒤에 \r을 지움
+    // 음수(상대) 인덱스는 처리하지 못함 → 상대 인덱스 파일은 같은 내용의 절대 인덱스 파일과 비교
+    // ──────────────────────────────────────────────
+
+    struct FLegacyFaceVertex
+    {
+        uint32 PositionIndex = 0;
+        uint32 TexCoordIndex = 0;
+        uint32 NormalIndex = 0;
+    };
+
+    FLegacyFaceVertex LegacyParseVertexDef(const FString& InVertexDef)
+    {
+        FLegacyFaceVertex Result;
+        std::stringstream ss(InVertexDef);
+        FString Part;
+        uint32 TempValue = 0;
+
+        if (std::getline(ss, Part, '/') && !Part.empty())
+        {
+            std::stringstream Conv(Part);
+            if (Conv >> TempValue) Result.PositionIndex = TempValue - 1;
+        }
+        if (std::getline(ss, Part, '/') && !Part.empty())
+        {
+            std::stringstream Conv(Part);
+            if (Conv >> TempValue) Result.TexCoordIndex = TempValue - 1;
+        }
+        if (std::getline(ss, Part, '/') && !Part.empty())
+        {
+            std::stringstream Conv(Part);
+            if (Conv >> TempValue) Result.NormalIndex = TempValue - 1;
+        }
+        return Result;
+    }
+
+    void LegacyParseObj(std::istream& FileIn, const FString& ObjDir, bool bIsRightHanded, FObjInfo& OutObjInfo, FString& OutMtlPath)
+    {
+        uint32 SubsetCount = 0;
+        uint32 VIndex = 0;
+        bool bHasTexcoord = false;
+        bool bHasNormal = false;
+
+        FString Line;
+        while (std::getline(FileIn, Line))
+        {
+            if (!Line.empty() && Line.back() == '\r') Line.pop_back();
+            if (Line.empty()) continue;
+            Line.erase(0, Line.find_first_not_of(" \t\n\r"));
+            if (Line.empty() || Line[0] == '#') continue;
+
+            if (Line.rfind("v ", 0) == 0)
+            {
+                std::stringstream wss(Line.substr(2));
+                float vx, vy, vz;
+                wss >> vx >> vy >> vz;
+                OutObjInfo.Positions.push_back(bIsRightHanded ? FVector(vx, -vy, vz) : FVector(vx, vy, vz));
+            }
+            else if (Line.rfind("vt ", 0) == 0)
+            {
+                std::stringstream wss(Line.substr(3));
+                float u, v;
+                wss >> u >> v;
+                OutObjInfo.TexCoords.push_back(FVector2D(u, 1.0f - v));
+                bHasTexcoord = true;
+            }
+            else if (Line.rfind("vn ", 0) == 0)
+            {
+                std::stringstream wss(Line.substr(3));
+                float nx, ny, nz;
+                wss >> nx >> ny >> nz;
+                OutObjInfo.Normals.push_back(bIsRightHanded ? FVector(nx, -ny, nz) : FVector(nx, ny, nz));
+                bHasNormal = true;
+            }
+            else if (Line.rfind("f ", 0) == 0)
+            {
+                std::stringstream wss(Line.substr(2));
+                FString VertexDef;
+                TArray<FLegacyFaceVertex> LineFaceVertices;
+                while (wss >> VertexDef)
+                {
+                    if (VertexDef[0] == '#') break;
+                    LineFaceVertices.push_back(LegacyParseVertexDef(VertexDef));
+                }
+
+                for (uint32 i = 1; i + 1 < LineFaceVertices.size(); ++i)
+                {
+                    const uint32 Order[3] = { 0, bIsRightHanded ? i + 1 : i, bIsRightHanded ? i : i + 1 };
+                    for (const uint32 k : Order)
+                    {
+                        OutObjInfo.PositionIndices.push_back(LineFaceVertices[k].PositionIndex);
+                        OutObjInfo.TexCoordIndices.push_back(LineFaceVertices[k].TexCoordIndex);
+                        OutObjInfo.NormalIndices.push_back(LineFaceVertices[k].NormalIndex);
+                    }
+                    VIndex += 3;
+                }
+            }
+            else if (Line.rfind("mtllib ", 0) == 0)
+            {
+                OutMtlPath = ObjDir + Line.substr(7);
+            }
+            else if (Line.rfind("usemtl ", 0) == 0)
+            {
+                OutObjInfo.MaterialNames.push_back(Line.substr(7));
+                OutObjInfo.GroupIndexStartArray.push_back(VIndex);
+                SubsetCount++;
+            }
+        }
+
+        if (SubsetCount == 0)
+        {
+            OutObjInfo.GroupIndexStartArray.push_back(0);
+        }
+        OutObjInfo.GroupIndexStartArray.push_back(VIndex);
+        if (OutObjInfo.GroupIndexStartArray.size() > 1 && OutObjInfo.GroupIndexStartArray[1] == 0)
+        {
+            OutObjInfo.GroupIndexStartArray.erase(OutObjInfo.GroupIndexStartArray.begin() + 1);
+        }
+
+        if (!bHasNormal)
+        {
+            OutObjInfo.Normals.push_back(FVector(0.0f, 0.0f, 0.0f));
+        }
+        if (!bHasTexcoord)
+        {
+            OutObjInfo.TexCoords.push_back(FVector2D(0.0f, 0.0f));
+        }
+    }
+
+    // 변경 전 ConvertToStaticMesh의 정점 병합 (unordered_map, 처음 등장 순서)
+    struct FLegacyVertexKey
+    {
+        uint32 PosIndex;
+        uint32 TexIndex;
+        uint32 NormalIndex;
+
+        bool operator==(const FLegacyVertexKey& Other) const
+        {
+            return PosIndex == Other.PosIndex && TexIndex == Other.TexIndex && NormalIndex == Other.NormalIndex;
+        }
+    };
+
+    struct FLegacyVertexKeyHash
+    {
+        size_t operator()(const FLegacyVertexKey& Key) const
+        {
+            return std::hash<uint32>()(Key.PosIndex) ^ (std::hash<uint32>()(Key.TexIndex) << 1) ^ (std::hash<uint32>()(Key.NormalIndex) << 2);
+        }
+    };
+
+    void LegacyWeld(const FObjInfo& ObjInfo, TArray<uint32>& OutCornerToVertex, TArray<uint32>& OutVertexToCorner)
+    {
+        std::unordered_map<FLegacyVertexKey, uint32, FLegacyVertexKeyHash> VertexMap;
+        const uint32 NumCorners = static_cast<uint32>(ObjInfo.PositionIndices.size());
+        for (uint32 Corner = 0; Corner < NumCorners; ++Corner)
+        {
+            const FLegacyVertexKey Key{ ObjInfo.PositionIndices[Corner], ObjInfo.TexCoordIndices[Corner], ObjInfo.NormalIndices[Corner] };
+            auto It = VertexMap.find(Key);
+            if (It != VertexMap.end())
+            {
+                OutCornerToVertex.push_back(It->second);
+            }
+            else
+            {
+                const uint32 NewIndex = static_cast<uint32>(OutVertexToCorner.size());
+                OutVertexToCorner.push_back(Corner);
+                OutCornerToVertex.push_back(NewIndex);
+                VertexMap[Key] = NewIndex;
+            }
+        }
+    }
+
+    // ──────────────────────────────────────────────
+    // 도우미
+    // ──────────────────────────────────────────────
+
+    struct FParsed
+    {
+        FObjInfo Info;
+        FString MtlPath;
+    };
+
+    FParsed ParseText(const std::string& Text, bool bIsRightHanded)
+    {
+        FParsed Result;
+        ObjParser::ParseObj(Text.data(), Text.size(), "Data/Model/", bIsRightHanded, Result.Info, Result.MtlPath);
+        return Result;
+    }
+
+    FParsed LegacyParseText(const std::string& Text, bool bIsRightHanded)
+    {
+        FParsed Result;
+        std::istringstream Stream(Text);
+        LegacyParseObj(Stream, "Data/Model/", bIsRightHanded, Result.Info, Result.MtlPath);
+        return Result;
+    }
+
+    template<typename T>
+    bool IsSameArray(const TArray<T>& A, const TArray<T>& B)
+    {
+        return A.size() == B.size() && (A.empty() || std::memcmp(A.data(), B.data(), sizeof(T) * A.size()) == 0);
+    }
+
+    bool IsSameParse(const FParsed& A, const FParsed& B)
+    {
+        return IsSameArray(A.Info.Positions, B.Info.Positions)
+            && IsSameArray(A.Info.TexCoords, B.Info.TexCoords)
+            && IsSameArray(A.Info.Normals, B.Info.Normals)
+            && IsSameArray(A.Info.PositionIndices, B.Info.PositionIndices)
+            && IsSameArray(A.Info.TexCoordIndices, B.Info.TexCoordIndices)
+            && IsSameArray(A.Info.NormalIndices, B.Info.NormalIndices)
+            && IsSameArray(A.Info.GroupIndexStartArray, B.Info.GroupIndexStartArray)
+            && A.Info.MaterialNames == B.Info.MaterialNames
+            && A.MtlPath == B.MtlPath;
+    }
+
+    std::string ToCRLF(const std::string& Text)
+    {
+        std::string Result;
+        Result.reserve(Text.size() + Text.size() / 16);
+        for (char Char : Text)
+        {
+            if (Char == '\n') Result.push_back('\r');
+            Result.push_back(Char);
+        }
+        return Result;
+    }
+
+    bool IsWeldSameAsLegacy(const FObjInfo& Info)
+    {
+        TArray<uint32> LegacyCornerToVertex;
+        TArray<uint32> LegacyVertexToCorner;
+        LegacyWeld(Info, LegacyCornerToVertex, LegacyVertexToCorner);
+
+        TArray<uint32> CornerToVertex;
+        TArray<uint32> VertexToCorner;
+        ObjParser::WeldCorners(Info.PositionIndices.data(), Info.TexCoordIndices.data(), Info.NormalIndices.data(),
+            static_cast<uint32>(Info.PositionIndices.size()), CornerToVertex, VertexToCorner);
+        return IsSameArray(LegacyCornerToVertex, CornerToVertex) && IsSameArray(LegacyVertexToCorner, VertexToCorner);
+    }
+
+    /**
+     * 블록 단위 합성 메시: 블록마다 v/vt/vn 512개씩 → 면 1024개 (삼각형/사각형, 인덱스 형식 4가지). 블록 하나가 약 80KB
+     * 면은 지금까지 나온 정점 중 최근 1024개 안에서 고르므로 청크 경계 뒤의 면이 경계 앞 정점을 참조함
+     * bRelative이면 같은 면을 음수 인덱스로 기록
+     */
+    std::string MakeLargeObj(int32 NumBlocks, bool bRelative)
+    {
+        std::string Text = "# synthetic mesh\nmtllib first.mtl\n";
+        uint32 State = 12345;
+        auto Next = [&State]() { State = State * 1664525u + 1013904223u; return State >> 8; };
+
+        char Buffer[128];
+        uint32 NumPositions = 0;
+        for (int32 Block = 0; Block < NumBlocks; ++Block)
+        {
+            for (int32 i = 0; i < 512; ++i)
+            {
+                std::snprintf(Buffer, sizeof(Buffer), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn %.6f %.6f %.6f\n",
+                    (Next() % 20000) / 100.0f - 100.0f, (Next() % 20000) / 100.0f - 100.0f, (Next() % 20000) / 100.0f - 100.0f,
+                    (Next() % 1000) / 1000.0f, (Next() % 1000) / 1000.0f,
+                    (Next() % 2000) / 1000.0f - 1.0f, (Next() % 2000) / 1000.0f - 1.0f, (Next() % 2000) / 1000.0f - 1.0f);
+                Text += Buffer;
+            }
+            NumPositions += 512;
+
+            if (Block % 3 == 0)
+            {
+                Text += "usemtl Material" + std::to_string(Block % 7) + "\n";
+            }
+            if (Block % 5 == 1)
+            {
+                Text += "\n  # block comment\ng Block" + std::to_string(Block) + "\ns off\n";
+            }
+
+            const uint32 Window = std::min<uint32>(NumPositions, 1024);
+            for (int32 FaceIndex = 0; FaceIndex < 1024; ++FaceIndex)
+            {
+                const int32 NumCorners = (Next() % 3 == 0) ? 4 : 3;
+                const int32 Format = Next() % 4;
+                Text += "f";
+                for (int32 c = 0; c < NumCorners; ++c)
+                {
+                    const uint32 Absolute = NumPositions - (Next() % Window);   // 1-based
+                    const int64 Index = bRelative ? -static_cast<int64>(NumPositions + 1 - Absolute) : static_cast<int64>(Absolute);
+                    const long long I = static_cast<long long>(Index);
+                    switch (Format)
+                    {
+                    case 0: std::snprintf(Buffer, sizeof(Buffer), " %lld", I); break;
+                    case 1: std::snprintf(Buffer, sizeof(Buffer), " %lld/%lld", I, I); break;
+                    case 2: std::snprintf(Buffer, sizeof(Buffer), " %lld//%lld", I, I); break;
+                    default: std::snprintf(Buffer, sizeof(Buffer), " %lld/%lld/%lld", I, I, I); break;
+                    }
+                    Text += Buffer;
+                }
+                Text += (FaceIndex % 97 == 0) ? " # inline comment\n" : "\n";
+            }
+        }
+        Text += "mtllib last.mtl\nf 1 2 3";    // 마지막 줄 개행 없음
+        return Text;
+    }
+
+    // ──────────────────────────────────────────────
+    // 검사
+    // ──────────────────────────────────────────────
+
+    void TestEdgeCases()
+    {
+        const std::string Text =
+            "# exported by test\n"
+            "mtllib  ignored_first.mtl\n"
+            "\n"
+            "   v 1.0 2.0 3.0\n"
+            "v -1.5 0.25 +4\n"
+            "v 0 0 0\n"
+            "v 1e-3 -2.5e2 7\n"
+            "v 5 6 7\n"
+            "vt 0.5 0.25\n"
+            "vt 1 0\n"
+            "vn 0 1 0\n"
+            "vn 0 0 -1\n"
+            "f 1 2 3\n"                     // 첫 usemtl 앞의 면 → 기본 그룹
+            "usemtl Wood\n"
+            "f 1/1 2/2 3/1 4/2\n"           // 사각형 → 팬 분할
+            "g ignored_group\n"
+            "o ignored_object\n"
+            "f 2//1 3//2 4//1 # comment after face\n"
+            "usemtl Metal\n"
+            "\t f 1/2/1 3/1/2 4/2/2 5/1/1 2/2/2\n"  // 오각형, 앞에 탭/공백
+            "f 5 4 3\n"
+            "mtllib materials.mtl\n"
+            "f 1/1/1 2/2/2 5/1/2";          // 개행 없이 끝남
+
+        for (const bool bIsRightHanded : { true, false })
+        {
+            const FParsed Parsed = ParseText(Text, bIsRightHanded);
+            TEST_CHECK(IsSameParse(Parsed, LegacyParseText(Text, bIsRightHanded)));
+
+            // CRLF 파일도 같은 결과 (머티리얼 이름/mtllib에 \r이 남지 않음)
+            const FParsed ParsedCRLF = ParseText(ToCRLF(Text), bIsRightHanded);
+            TEST_CHECK(IsSameParse(ParsedCRLF, Parsed));
+
+            TEST_CHECK(Parsed.Info.Positions.Num() == 5 && Parsed.Info.TexCoords.Num() == 2 && Parsed.Info.Normals.Num() == 2);
+            // 삼각형 1 + 2 + 1 + 3 + 1 + 1 = 9개
+            TEST_CHECK(Parsed.Info.PositionIndices.Num() == 27);
+            TEST_CHECK(Parsed.Info.MaterialNames == TArray<FString>({ "Wood", "Metal" }));
+            TEST_CHECK(Parsed.Info.GroupIndexStartArray == TArray<uint32>({ 3, 12, 27 }));  // 첫 usemtl 앞 면은 어느 그룹에도 속하지 않음 (기존 동작)
+            TEST_CHECK(ParsedCRLF.MtlPath == "Data/Model/materials.mtl");
+            TEST_CHECK(Parsed.Info.Positions[1].Y == (bIsRightHanded ? -0.25f : 0.25f) && Parsed.Info.Positions[1].Z == 4.0f);
+            TEST_CHECK(Parsed.Info.TexCoords[0].Y == 0.75f);
+            TEST_CHECK(IsWeldSameAsLegacy(Parsed.Info));
+        }
+
+        // 노멀/UV가 없으면 0번에 기본값 하나, usemtl이 없으면 그룹 하나
+        const FParsed Bare = ParseText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n", true);
+        TEST_CHECK(IsSameParse(Bare, LegacyParseText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n", true)));
+        TEST_CHECK(Bare.Info.Normals.Num() == 1 && Bare.Info.TexCoords.Num() == 1);
+        TEST_CHECK(Bare.Info.GroupIndexStartArray == TArray<uint32>({ 0, 3 }));
+
+        // 음수 인덱스는 직전 정점 기준
+        const FParsed Relative = ParseText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf -3 -2 -1\nv 0 0 1\nf -4 -1 -2\n", false);
+        TEST_CHECK(Relative.Info.PositionIndices == TArray<uint32>({ 0, 1, 2, 0, 3, 2 }));
+    }
+
+    void TestChunkBoundaries()
+    {
+        // 4MB 청크 최소 크기 기준으로 청크 3개
+        const std::string Absolute = MakeLargeObj(170, false);
+        const std::string Relative = MakeLargeObj(170, true);
+        TEST_CHECK(Absolute.size() >= 12u * 1024 * 1024);
+
+        const FParsed Legacy = LegacyParseText(Absolute, true);
+        const FParsed Parsed = ParseText(Absolute, true);
+        TEST_CHECK(IsSameParse(Parsed, Legacy));
+        TEST_CHECK(Parsed.MtlPath == "Data/Model/last.mtl");
+        TEST_CHECK(Parsed.Info.MaterialNames.Num() > 10);
+
+        // 청크 경계를 넘는 상대 인덱스도 절대 인덱스 파일과 같음
+        TEST_CHECK(IsSameParse(ParseText(Relative, true), Legacy));
+        TEST_CHECK(IsSameParse(ParseText(ToCRLF(Absolute), true), Legacy));
+
+        // 코너가 많으면 병렬 경로 (버킷 분할)로 병합
+        TEST_CHECK(Parsed.Info.PositionIndices.Num() > (1 << 16));
+        TEST_CHECK(IsWeldSameAsLegacy(Parsed.Info));
+    }
+
+    // ──────────────────────────────────────────────
+    // 벤치마크
+    // ──────────────────────────────────────────────
+
+    void RunParseBenchmark()
+    {
+        std::error_code Ec;
+        const FString FilePath = (std::filesystem::temp_directory_path(Ec) / "MundiObjParserBench.obj").string();
+        {
+            std::ofstream File(FilePath, std::ios::binary | std::ios::trunc);
+            File << MakeLargeObj(850, false);
+        }
+
+        // 1. 변경 전: std::ifstream + getline + stringstream, unordered_map 병합
+        FParsed Legacy;
+        MundiTest::FTimer LegacyParseTimer;
+        {
+            std::ifstream File(FilePath);
+            LegacyParseObj(File, "Data/Model/", true, Legacy.Info, Legacy.MtlPath);
+        }
+        const double LegacyParseMS = LegacyParseTimer.ElapsedMS();
+
+        TArray<uint32> LegacyCornerToVertex;
+        TArray<uint32> LegacyVertexToCorner;
+        MundiTest::FTimer LegacyWeldTimer;
+        LegacyWeld(Legacy.Info, LegacyCornerToVertex, LegacyVertexToCorner);
+        const double LegacyWeldMS = LegacyWeldTimer.ElapsedMS();
+
+        // 2. 현재: 메모리 맵 + ParseObj (열기/맵핑 포함), WeldCorners
+        FParsed Parsed;
+        uint64 FileBytes = 0;
+        MundiTest::FTimer ParseTimer;
+        {
+            ObjParser::FMappedFile File;
+            TEST_CHECK(File.Open(FilePath));
+            FileBytes = File.GetSize();
+            ObjParser::ParseObj(File.GetData(), File.GetSize(), "Data/Model/", true, Parsed.Info, Parsed.MtlPath);
+        }
+        const double ParseMS = ParseTimer.ElapsedMS();
+
+        TArray<uint32> CornerToVertex;
+        TArray<uint32> VertexToCorner;
+        MundiTest::FTimer WeldTimer;
+        ObjParser::WeldCorners(Parsed.Info.PositionIndices.data(), Parsed.Info.TexCoordIndices.data(), Parsed.Info.NormalIndices.data(),
+            static_cast<uint32>(Parsed.Info.PositionIndices.size()), CornerToVertex, VertexToCorner);
+        const double WeldMS = WeldTimer.ElapsedMS();
+
+        std::printf("[Obj Parse Bench] %.1f MB, %d positions, %d corners -> %d vertices, %d workers\n",
+            FileBytes / (1024.0 * 1024.0), Parsed.Info.Positions.Num(), Parsed.Info.PositionIndices.Num(), VertexToCorner.Num(), TaskGraph.GetNumWorkers());
+        std::printf("  parse: getline %9.1f ms, mapped parser %8.1f ms (x%.1f)\n", LegacyParseMS, ParseMS, LegacyParseMS / ParseMS);
+        std::printf("  weld : unordered_map %3.1f ms, WeldCorners %10.1f ms (x%.1f)\n", LegacyWeldMS, WeldMS, LegacyWeldMS / WeldMS);
+        TEST_CHECK(IsSameParse(Parsed, Legacy));
+        TEST_CHECK(IsSameArray(CornerToVertex, LegacyCornerToVertex) && IsSameArray(VertexToCorner, LegacyVertexToCorner));
+
+        std::filesystem::remove(FilePath, Ec);
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TaskGraph.Initialize(4);
+
+    TestEdgeCases();
+    TestChunkBoundaries();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunParseBenchmark();
+    }
+
+    TaskGraph.Shutdown();
+    return MundiTest::Finish("ObjParserTests");
+}
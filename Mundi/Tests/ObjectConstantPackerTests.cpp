@@ -0,0 +1,354 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "ObjectConstantRing.h"
+#include "ConstantBufferType.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <random>
+
+// 드로우별 상수 블록(FObjectConstantPacker)과 링 쓰기 위치(FObjectConstantRingCursor) 검사
+// - 블록은 256바이트(16 상수), 16바이트 정렬 → 링 안의 모든 바인딩 오프셋이 16 상수 배수 (VSSetConstantBuffers1 규칙)
+// - 고정 배치(일반/자동 인스턴싱/SubUV/빌보드): 배치별 블록 수, 0번 기본 SubUV 블록, 블록 내용이 원래 배치와 같음
+// - 무작위 배치 20k: 드로우마다 쓰는 블록이 겹치지 않고 빈틈 없이 이어짐, 내용 일치
+// - 링: 새 버퍼의 첫 업로드는 DISCARD, 자리가 있으면 NO_OVERWRITE로 이어 씀, 끝에 닿으면 0번부터 DISCARD
+//   NO_OVERWRITE 미지원 장치는 항상 DISCARD, 새 지연 기록의 첫 업로드는 자리가 있어도 DISCARD
+//   DISCARD 사이의 업로드 범위는 겹치지 않고 용량 안에 있음 (무작위 업로드 크기)
+// - 직렬(TaskGraph 초기화 전)과 4 워커의 블록 바이트가 같음
+
+namespace
+{
+	bool IsSameMatrix(const FMatrix& A, const FMatrix& B)
+	{
+		return std::memcmp(&A, &B, sizeof(FMatrix)) == 0;
+	}
+
+	bool IsSameColor(const FLinearColor& A, const FLinearColor& B)
+	{
+		return A.R == B.R && A.G == B.G && A.B == B.B && A.A == B.A;
+	}
+
+	FMeshBatchElement MakeBatch(uint32 ObjectID, float X)
+	{
+		FMeshBatchElement Batch;
+		Batch.WorldMatrix = FMatrix::Identity();
+		Batch.WorldMatrix.M[0][0] = 2.0f;
+		Batch.WorldMatrix.M[2][2] = 0.5f;
+		Batch.WorldMatrix.M[3][0] = X;
+		Batch.WorldMatrix.M[3][1] = 10.0f;
+		Batch.InstanceColor = FLinearColor(0.25f, 0.5f, static_cast<float>(ObjectID % 5), 1.0f);
+		Batch.ObjectID = ObjectID;
+		return Batch;
+	}
+
+	/** 드로우의 블록 내용이 원래 배치와 같은지 (DrawMeshBatches가 드로우마다 올리던 상수) */
+	bool MatchesBatch(const FObjectConstantPacker& Packer, const FObjectConstantDraw& Draw, const FMeshBatchElement& Batch)
+	{
+		bool bMatch = true;
+		if (Batch.bAutoInstanced)
+		{
+			bMatch &= Draw.Model == FObjectConstantDraw::None && Draw.Color == FObjectConstantDraw::None;
+			bMatch &= Draw.Instancing != FObjectConstantDraw::None &&
+				Packer.GetBlockAs<FInstancingBufferType>(Draw.Instancing).InstanceOffset == Batch.InstanceStart;
+		}
+		else
+		{
+			bMatch &= Draw.Instancing == FObjectConstantDraw::None;
+			if (Draw.Model == FObjectConstantDraw::None || Draw.Color == FObjectConstantDraw::None)
+			{
+				return false;
+			}
+			const ModelBufferType& Model = Packer.GetBlockAs<ModelBufferType>(Draw.Model);
+			bMatch &= IsSameMatrix(Model.Model, Batch.WorldMatrix);
+			bMatch &= IsSameMatrix(Model.ModelInverseTranspose, Batch.WorldMatrix.InverseAffine().Transpose());
+			const ColorBufferType& Color = Packer.GetBlockAs<ColorBufferType>(Draw.Color);
+			bMatch &= IsSameColor(Color.Color, Batch.InstanceColor) && Color.UUID == Batch.ObjectID;
+		}
+
+		if (Batch.SubImages_Horizontal > 1 || Batch.SubImages_Vertical > 1)
+		{
+			const FSubUVBufferType& SubUV = Packer.GetBlockAs<FSubUVBufferType>(Draw.SubUV);
+			bMatch &= Draw.SubUV != FObjectConstantPacker::DefaultSubUVBlock;
+			bMatch &= SubUV.SubImages_Horizontal == Batch.SubImages_Horizontal && SubUV.SubImages_Vertical == Batch.SubImages_Vertical &&
+				SubUV.InterpMethod == Batch.SubUV_InterpMethod;
+		}
+		else
+		{
+			bMatch &= Draw.SubUV == FObjectConstantPacker::DefaultSubUVBlock;
+		}
+
+		if (Batch.ScreenAlignment != EScreenAlignment::None)
+		{
+			bMatch &= Draw.Emitter != FObjectConstantDraw::None &&
+				Packer.GetBlockAs<FParticleEmitterType>(Draw.Emitter).ScreenAlignment == static_cast<uint32>(Batch.ScreenAlignment);
+		}
+		else
+		{
+			bMatch &= Draw.Emitter == FObjectConstantDraw::None;
+		}
+		return bMatch;
+	}
+
+	// ──────────────────────────────────────────────
+	// 블록 배치
+	// ──────────────────────────────────────────────
+
+	void TestBlockLayout()
+	{
+		static_assert(sizeof(FObjectConstantBlock) == 256, "One block must be one 256-byte constant buffer view");
+		static_assert(alignof(FObjectConstantBlock) == 16, "Blocks must keep 16-byte constant alignment");
+		// 드로우는 (링 블록 번호 x 16) 상수부터 16 상수를 바인딩 → 오프셋과 크기 모두 16 상수 배수
+		TEST_CHECK(FObjectConstantPacker::BlockSize == 256);
+		TEST_CHECK(FObjectConstantPacker::ConstantsPerBlock == 16);
+
+		FObjectConstantPacker Packer;
+		TArray<FMeshBatchElement> Batches;
+		Batches.Add(MakeBatch(1, 0.0f));
+		Packer.Pack(Batches);
+		TEST_CHECK(reinterpret_cast<uintptr_t>(Packer.GetBlocks().data()) % 16 == 0);
+		TEST_CHECK(Packer.GetBlocks().Num() == 3);
+
+	}
+
+	void TestFixtureBatches()
+	{
+		TArray<FMeshBatchElement> Batches;
+		Batches.Add(MakeBatch(1, 0.0f));						// 일반: Model + Color
+
+		FMeshBatchElement Instanced = MakeBatch(2, 5.0f);		// 자동 인스턴싱: Instancing만
+		Instanced.bAutoInstanced = true;
+		Instanced.InstanceStart = 37;
+		Instanced.InstanceCount = 4;
+		Batches.Add(Instanced);
+
+		FMeshBatchElement SubUV = MakeBatch(3, 10.0f);			// SubUV: + SubUV
+		SubUV.SubImages_Horizontal = 4;
+		SubUV.SubImages_Vertical = 2;
+		SubUV.SubUV_InterpMethod = 1;
+		Batches.Add(SubUV);
+
+		FMeshBatchElement Billboard = MakeBatch(4, 15.0f);		// 빌보드: + Emitter
+		Billboard.ScreenAlignment = EScreenAlignment::Velocity;
+		Batches.Add(Billboard);
+
+		FMeshBatchElement Both = SubUV;							// SubUV + 빌보드
+		Both.ObjectID = 5;
+		Both.ScreenAlignment = EScreenAlignment::CameraFacing;
+		Batches.Add(Both);
+
+		const uint32 ExpectedCounts[] = { 2, 1, 3, 3, 4 };
+		for (int32 Index = 0; Index < Batches.Num(); ++Index)
+		{
+			TEST_CHECK(FObjectConstantPacker::CountBlocks(Batches[Index]) == ExpectedCounts[Index]);
+		}
+
+		FObjectConstantPacker Packer;
+		Packer.Pack(Batches);
+		TEST_CHECK(Packer.GetBlocks().Num() == 1 + 2 + 1 + 3 + 3 + 4);
+		TEST_CHECK(Packer.GetDraws().Num() == Batches.Num());
+
+		// 0번은 기본 SubUV (0으로 채운 FSubUVBufferType)
+		const FSubUVBufferType& DefaultSubUV = Packer.GetBlockAs<FSubUVBufferType>(FObjectConstantPacker::DefaultSubUVBlock);
+		TEST_CHECK(DefaultSubUV.SubImages_Horizontal == 0 && DefaultSubUV.SubImages_Vertical == 0 && DefaultSubUV.InterpMethod == 0);
+
+		for (int32 Index = 0; Index < Batches.Num() && Index < Packer.GetDraws().Num(); ++Index)
+		{
+			TEST_CHECK(MatchesBatch(Packer, Packer.GetDraws()[Index], Batches[Index]));
+		}
+		// 드로우 순서대로 1번부터 빈틈 없이
+		TEST_CHECK(Packer.GetDraws().Num() == 5 && Packer.GetDraws()[0].Model == 1 && Packer.GetDraws()[1].Instancing == 3 &&
+			Packer.GetDraws()[4].Emitter == static_cast<uint32>(Packer.GetBlocks().Num() - 1));
+
+		// 다시 채우면 이전 결과를 버림
+		TArray<FMeshBatchElement> Single;
+		Single.Add(MakeBatch(9, 1.0f));
+		Packer.Pack(Single);
+		TEST_CHECK(Packer.GetBlocks().Num() == 3 && Packer.GetDraws().Num() == 1);
+		TEST_CHECK(Packer.GetDraws().Num() == 1 && MatchesBatch(Packer, Packer.GetDraws()[0], Single[0]));
+	}
+
+	TArray<FMeshBatchElement> MakeRandomBatches(int32 NumBatches, uint32 Seed)
+	{
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> Position(-1000.0f, 1000.0f);
+		TArray<FMeshBatchElement> Batches;
+		for (int32 Index = 0; Index < NumBatches; ++Index)
+		{
+			FMeshBatchElement Batch = MakeBatch(static_cast<uint32>(Index), Position(Rng));
+			Batch.WorldMatrix.M[1][1] = 1.0f + static_cast<float>(Rng() % 8);
+			const uint32 Kind = Rng() % 10;
+			if (Kind < 2)
+			{
+				Batch.bAutoInstanced = true;
+				Batch.InstanceStart = Rng() % 50000;
+			}
+			else if (Kind < 4)
+			{
+				Batch.SubImages_Horizontal = 1 + static_cast<int32>(Rng() % 8);
+				Batch.SubImages_Vertical = 2;
+			}
+			if (Rng() % 4 == 0)
+			{
+				Batch.ScreenAlignment = (Rng() % 2) ? EScreenAlignment::CameraFacing : EScreenAlignment::Velocity;
+			}
+			Batches.Add(Batch);
+		}
+		return Batches;
+	}
+
+	void TestRandomBatches(const TArray<FMeshBatchElement>& Batches, const FObjectConstantPacker& Packer)
+	{
+		const TArray<FObjectConstantDraw>& Draws = Packer.GetDraws();
+		TEST_CHECK(Draws.Num() == Batches.Num());
+
+		// 기본 SubUV를 뺀 모든 블록이 정확히 한 드로우의 것
+		TArray<uint32> Owners;
+		Owners.resize(Packer.GetBlocks().Num(), 0);
+		int32 NumBadDraws = 0;
+		int32 NumBadOwners = 0;
+		uint32 ExpectedBlocks = 1;
+		for (int32 Index = 0; Index < Draws.Num() && Index < Batches.Num(); ++Index)
+		{
+			const FObjectConstantDraw& Draw = Draws[Index];
+			NumBadDraws += MatchesBatch(Packer, Draw, Batches[Index]) ? 0 : 1;
+			ExpectedBlocks += FObjectConstantPacker::CountBlocks(Batches[Index]);
+			for (uint32 Block : { Draw.Model, Draw.Color, Draw.SubUV, Draw.Emitter, Draw.Instancing })
+			{
+				if (Block == FObjectConstantDraw::None || Block == FObjectConstantPacker::DefaultSubUVBlock)
+				{
+					continue;
+				}
+				if (Block >= Owners.size())
+				{
+					++NumBadOwners;
+					continue;
+				}
+				++Owners[Block];
+			}
+		}
+		for (size_t Block = 1; Block < Owners.size(); ++Block)
+		{
+			NumBadOwners += Owners[Block] != 1 ? 1 : 0;
+		}
+		TEST_CHECK(Packer.GetBlocks().Num() == static_cast<int32>(ExpectedBlocks));
+		TEST_CHECK(NumBadDraws == 0);
+		TEST_CHECK(NumBadOwners == 0);
+	}
+
+	// ──────────────────────────────────────────────
+	// 링 쓰기 위치
+	// ──────────────────────────────────────────────
+
+	void TestRingCursor()
+	{
+		constexpr uint32 Capacity = 100;
+		FObjectConstantRingCursor Cursor;
+		Cursor.Reset(Capacity);
+		uint32 Base = ~0u;
+
+		// 새 버퍼의 첫 업로드는 DISCARD, 이후는 이어서 NO_OVERWRITE
+		TEST_CHECK(Cursor.Reserve(30, true, false, 0, Base) && Base == 0);
+		TEST_CHECK(!Cursor.Reserve(30, true, false, 0, Base) && Base == 30);
+		TEST_CHECK(!Cursor.Reserve(40, true, false, 0, Base) && Base == 60);	// 끝에 딱 맞음
+		// 끝에 닿으면 0번부터 DISCARD
+		TEST_CHECK(Cursor.Reserve(1, true, false, 0, Base) && Base == 0);
+		TEST_CHECK(!Cursor.Reserve(90, true, false, 0, Base) && Base == 1);
+		TEST_CHECK(Cursor.Reserve(10, true, false, 0, Base) && Base == 0);	// 91 + 10 > 100
+
+		// NO_OVERWRITE를 지원하지 않으면 항상 DISCARD
+		TEST_CHECK(Cursor.Reserve(5, false, false, 0, Base) && Base == 0);
+		TEST_CHECK(Cursor.Reserve(5, false, false, 0, Base) && Base == 0);
+
+		// 지연 기록: 명령 리스트마다 첫 업로드는 자리가 있어도 DISCARD
+		Cursor.Reset(Capacity);
+		TEST_CHECK(Cursor.Reserve(10, true, true, 3, Base) && Base == 0);
+		TEST_CHECK(!Cursor.Reserve(10, true, true, 3, Base) && Base == 10);
+		TEST_CHECK(Cursor.Reserve(10, true, true, 4, Base) && Base == 0);	// 새 기록
+		TEST_CHECK(!Cursor.Reserve(10, true, true, 4, Base) && Base == 10);
+		// 즉시 컨텍스트는 기록 번호와 무관
+		TEST_CHECK(!Cursor.Reserve(10, true, false, 9, Base) && Base == 20);
+
+		// Map 실패 뒤에는 DISCARD
+		Cursor.Invalidate();
+		TEST_CHECK(Cursor.Reserve(10, true, false, 9, Base) && Base == 0);
+
+		TEST_CHECK(FObjectConstantRingCursor::GrowCapacity(0, FObjectConstantRing::InitialBlockCapacity, 10) == 4096);
+		TEST_CHECK(FObjectConstantRingCursor::GrowCapacity(4096, FObjectConstantRing::InitialBlockCapacity, 4097) == 8192);
+		TEST_CHECK(FObjectConstantRingCursor::GrowCapacity(8192, FObjectConstantRing::InitialBlockCapacity, 20000) == 32768);
+	}
+
+	void TestRingCursorRandom()
+	{
+		// 패스 업로드가 무작위 크기로 이어질 때, 마지막 DISCARD 뒤에 쓴 범위는 겹치지 않고 용량 안
+		// (GPU가 아직 읽을 수 있는 블록을 NO_OVERWRITE로 덮어쓰지 않음)
+		std::mt19937 Rng(42);
+		constexpr uint32 Capacity = 4096;
+		FObjectConstantRingCursor Cursor;
+		Cursor.Reset(Capacity);
+
+		TArray<uint8> Written;
+		Written.resize(Capacity, 0);
+		uint64 Recording = 0;
+		int32 NumOverlaps = 0;
+		int32 NumOutOfRange = 0;
+		int32 NumDiscards = 0;
+		int32 NumMissedRecordingDiscards = 0;
+		for (int32 Upload = 0; Upload < 20000; ++Upload)
+		{
+			const uint32 NumBlocks = 1 + Rng() % 700;
+			const bool bNewRecording = Rng() % 16 == 0;
+			Recording += bNewRecording ? 1 : 0;
+
+			uint32 Base = 0;
+			const bool bDiscard = Cursor.Reserve(NumBlocks, true, true, Recording, Base);
+			if (bDiscard)
+			{
+				++NumDiscards;
+				std::fill(Written.begin(), Written.end(), 0);
+			}
+			NumMissedRecordingDiscards += (bNewRecording && !bDiscard) ? 1 : 0;
+			if (Base + NumBlocks > Capacity)
+			{
+				++NumOutOfRange;
+				continue;
+			}
+			for (uint32 Block = Base; Block < Base + NumBlocks; ++Block)
+			{
+				NumOverlaps += Written[Block]++ ? 1 : 0;
+			}
+		}
+		TEST_CHECK(NumOverlaps == 0);
+		TEST_CHECK(NumOutOfRange == 0);
+		TEST_CHECK(NumMissedRecordingDiscards == 0);
+		// 대부분은 이어 쓰기 (평균 350블록이면 4096블록 링에 10번 남짓)
+		TEST_CHECK(NumDiscards < 20000 / 4);
+	}
+
+	bool IsSameBlocks(const FObjectConstantPacker& A, const FObjectConstantPacker& B)
+	{
+		return A.GetBlocks().Num() == B.GetBlocks().Num() &&
+			std::memcmp(A.GetBlocks().data(), B.GetBlocks().data(), sizeof(FObjectConstantBlock) * A.GetBlocks().Num()) == 0 &&
+			std::memcmp(A.GetDraws().data(), B.GetDraws().data(), sizeof(FObjectConstantDraw) * A.GetDraws().Num()) == 0;
+	}
+}
+
+int main()
+{
+	TestBlockLayout();
+	TestFixtureBatches();
+	TestRingCursor();
+	TestRingCursorRandom();
+
+	const TArray<FMeshBatchElement> Batches = MakeRandomBatches(20000, 1234);
+	FObjectConstantPacker SerialPacker;
+	SerialPacker.Pack(Batches);
+	TestRandomBatches(Batches, SerialPacker);
+
+	FTaskGraph::GetInstance().Initialize(4);
+
+	FObjectConstantPacker ParallelPacker;
+	ParallelPacker.Pack(Batches);
+	TestRandomBatches(Batches, ParallelPacker);
+	TEST_CHECK(IsSameBlocks(SerialPacker, ParallelPacker));
+
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("ObjectConstantPackerTests");
+}
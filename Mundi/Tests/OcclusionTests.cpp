@@ -0,0 +1,632 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "Occlusion.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <random>
+
+// CPU 소프트웨어 오클루전 컬링(FOcclusionCullingManagerCPU) 검사
+// - 래스터라이저 깊이: 픽셀마다 뷰 공간 레이 캐스트 기준값과 비교
+//   (변 위 픽셀은 덮어도/안 덮어도 되지만 기준보다 가까운 깊이는 절대 쓰지 않음)
+//   벽, 화면 밖까지 이어지는 바닥(가드 밴드 클리핑), 근평면을 가로지르는 삼각형, 뒷면 사각형
+// - HZB: 홀수 크기 레벨의 각 텍셀이 레벨0 영역 최댓값과 정확히 같고, 임의 사각형 샘플이 보수적
+// - 오클루디: 고정 박스(벽 뒤/앞/위로 삐져나옴/근평면/카메라 뒤/뒷면 뒤/바닥 아래)의 기대 판정,
+//   임의 박스 중 컬링된 것은 박스를 지나는 모든 픽셀 중심 레이에서 기준 오클루더 뒤에 있음 (잘못된 컬링 0개)
+// - 직렬(TaskGraph 초기화 전)과 4 워커 결과가 같음
+// - --bench: 건물 400개(30만 삼각형) 도시, 256x144 그리드, 오클루디 1만 개의 단계별 시간
+
+namespace
+{
+	// ──────────────────────────────────────────────
+	// 장면 구성
+	// ──────────────────────────────────────────────
+
+	constexpr float NearClip = 0.1f;
+	constexpr float FarClip = 100.0f;
+	constexpr float FovY = 60.0f * PI / 180.0f;
+
+	struct FTestCamera
+	{
+		FMatrix View;
+		FMatrix Proj;
+		FMatrix ViewProj;
+		int GridW;
+		int GridH;
+	};
+
+	FTestCamera MakeCamera(const FVector& Eye, const FVector& At, int GridW, int GridH)
+	{
+		FTestCamera Camera;
+		Camera.View = FMatrix::LookAtLH(Eye, At, FVector(0.0f, 0.0f, 1.0f));
+		Camera.Proj = FMatrix::PerspectiveFovLH(FovY, float(GridW) / float(GridH), NearClip, FarClip);
+		Camera.ViewProj = Camera.View * Camera.Proj;
+		Camera.GridW = GridW;
+		Camera.GridH = GridH;
+		return Camera;
+	}
+
+	FVector ToView(const FTestCamera& Camera, const FVector& P)
+	{
+		const FVector4 V = FVector4(P.X, P.Y, P.Z, 1.0f) * Camera.View;
+		return FVector(V.X, V.Y, V.Z);
+	}
+
+	// 월드 공간 삼각형 메시 (오클루더 하나)
+	struct FTestOccluder
+	{
+		TArray<FNormalVertex> Vertices;
+		TArray<uint32> Indices;
+	};
+
+	void AddTriangle(FTestOccluder& Mesh, const FVector& A, const FVector& B, const FVector& C)
+	{
+		const uint32 Base = uint32(Mesh.Vertices.size());
+		for (const FVector* P : { &A, &B, &C })
+		{
+			FNormalVertex Vertex{};
+			Vertex.pos = *P;
+			Mesh.Vertices.push_back(Vertex);
+		}
+		Mesh.Indices.insert(Mesh.Indices.end(), { Base, Base + 1, Base + 2 });
+	}
+
+	/** 카메라 기준 앞면(bFront) 또는 뒷면이 되도록 감은 사각형 P0-P1-P2-P3 */
+	void AddQuad(FTestOccluder& Mesh, const FTestCamera& Camera, const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, bool bFront)
+	{
+		// 뷰 공간 det(A, B, C) < 0 이면 D3D 앞면 (화면에서 시계 방향)
+		const FVector A = ToView(Camera, P0);
+		const float Det = FVector::Dot(A, FVector::Cross(ToView(Camera, P1), ToView(Camera, P2)));
+		if ((Det < 0.0f) == bFront)
+		{
+			AddTriangle(Mesh, P0, P1, P2);
+			AddTriangle(Mesh, P0, P2, P3);
+		}
+		else
+		{
+			AddTriangle(Mesh, P0, P2, P1);
+			AddTriangle(Mesh, P0, P3, P2);
+		}
+	}
+
+	/** 카메라는 원점에서 +X를 봄 */
+	TArray<FTestOccluder> MakeFixtureOccluders(const FTestCamera& Camera)
+	{
+		TArray<FTestOccluder> Occluders(4);
+
+		// 0) 정면 벽 (x = 10)
+		AddQuad(Occluders[0], Camera, FVector(10, -3, -2), FVector(10, 3, -2), FVector(10, 3, 2), FVector(10, -3, 2), true);
+
+		// 1) 바닥 (z = -1.5), 좌우로 화면 밖 멀리까지 → 가드 밴드 클리핑
+		AddQuad(Occluders[1], Camera, FVector(2, -60, -1.5f), FVector(40, -60, -1.5f), FVector(40, 60, -1.5f), FVector(2, 60, -1.5f), true);
+
+		// 2) 카메라 뒤에서 앞으로 이어지는 삼각형 → 근평면 클리핑
+		{
+			const FVector A(-2, 4, 0), B(6, 4, 3), C(6, 6, -1);
+			const float Det = FVector::Dot(ToView(Camera, A), FVector::Cross(ToView(Camera, B), ToView(Camera, C)));
+			Det < 0.0f ? AddTriangle(Occluders[2], A, B, C) : AddTriangle(Occluders[2], A, C, B);
+		}
+
+		// 3) 뒷면 사각형 (x = 8, 왼쪽): 깊이를 쓰면 안 됨
+		AddQuad(Occluders[3], Camera, FVector(8, -6, -1), FVector(8, -4, -1), FVector(8, -4, 1), FVector(8, -6, 1), false);
+		return Occluders;
+	}
+
+	TArray<FOccluderMesh> MakeOccluderMeshes(const TArray<FTestOccluder>& Occluders, const FTestCamera& Camera)
+	{
+		TArray<FOccluderMesh> Meshes;
+		for (const FTestOccluder& Occluder : Occluders)
+		{
+			FOccluderMesh Mesh;
+			Mesh.Vertices = Occluder.Vertices.data();
+			Mesh.Indices = Occluder.Indices.data();
+			Mesh.NumIndices = uint32(Occluder.Indices.size());
+			Mesh.WorldViewProj = Camera.ViewProj;
+			Mesh.WorldView = Camera.View;
+			Meshes.push_back(Mesh);
+		}
+		return Meshes;
+	}
+
+	FCandidateDrawable MakeCandidate(uint32 Index, const FAABB& Bound, const FTestCamera& Camera)
+	{
+		FCandidateDrawable Candidate;
+		Candidate.ActorIndex = Index;
+		Candidate.Bound = Bound;
+		Candidate.WorldViewProj = Camera.ViewProj;
+		Candidate.WorldView = Camera.View;
+		Candidate.NearClip = NearClip;
+		Candidate.FarClip = FarClip;
+		return Candidate;
+	}
+
+	// ──────────────────────────────────────────────
+	// 기준값: 뷰 공간 레이 캐스트
+	// ──────────────────────────────────────────────
+
+	struct FViewTriangle
+	{
+		FVector A, B, C;
+	};
+
+	/** 앞면 삼각형만 (뒷면은 래스터라이저도 그리지 않음) */
+	TArray<FViewTriangle> GatherFrontTriangles(const TArray<FTestOccluder>& Occluders, const FTestCamera& Camera)
+	{
+		TArray<FViewTriangle> Triangles;
+		for (const FTestOccluder& Occluder : Occluders)
+		{
+			for (size_t i = 0; i + 2 < Occluder.Indices.size(); i += 3)
+			{
+				FViewTriangle T{
+					ToView(Camera, Occluder.Vertices[Occluder.Indices[i]].pos),
+					ToView(Camera, Occluder.Vertices[Occluder.Indices[i + 1]].pos),
+					ToView(Camera, Occluder.Vertices[Occluder.Indices[i + 2]].pos) };
+				if (FVector::Dot(T.A, FVector::Cross(T.B, T.C)) < 0.0f)
+				{
+					Triangles.push_back(T);
+				}
+			}
+		}
+		return Triangles;
+	}
+
+	/**
+	 * 원점에서 Dir 방향 레이와 삼각형 교차 (무게중심 좌표가 -Tolerance까지 허용)
+	 * 반환값은 교차점의 뷰 공간 Z (없으면 FLT_MAX)
+	 */
+	float IntersectViewZ(const FViewTriangle& T, const FVector& Dir, float Tolerance)
+	{
+		const FVector E1 = T.B - T.A;
+		const FVector E2 = T.C - T.A;
+		const FVector P = FVector::Cross(Dir, E2);
+		const double Det = FVector::Dot(E1, P);
+		if (std::abs(Det) < 1e-12)
+		{
+			return FLT_MAX;
+		}
+		const double InvDet = 1.0 / Det;
+		const FVector S = FVector(0, 0, 0) - T.A;
+		const double U = FVector::Dot(S, P) * InvDet;
+		const FVector Q = FVector::Cross(S, E1);
+		const double V = FVector::Dot(Dir, Q) * InvDet;
+		if (U < -Tolerance || V < -Tolerance || U + V > 1.0 + Tolerance)
+		{
+			return FLT_MAX;
+		}
+		const double Dist = FVector::Dot(E2, Q) * InvDet;
+		return Dist > 0.0 ? float(Dist * Dir.Z) : FLT_MAX;
+	}
+
+	/** 근평면 뒤를 뺀 가장 가까운 교차의 선형 깊이 (없으면 1) */
+	float ReferenceDepth(const TArray<FViewTriangle>& Triangles, const FVector& Dir, float Tolerance)
+	{
+		float Nearest = FLT_MAX;
+		for (const FViewTriangle& T : Triangles)
+		{
+			const float ViewZ = IntersectViewZ(T, Dir, Tolerance);
+			if (ViewZ >= NearClip)
+			{
+				Nearest = std::min(Nearest, ViewZ);
+			}
+		}
+		return Nearest == FLT_MAX ? 1.0f : std::min(1.0f, (Nearest - NearClip) / (FarClip - NearClip));
+	}
+
+	FVector PixelRay(const FTestCamera& Camera, int X, int Y)
+	{
+		const float NdcX = (float(X) + 0.5f) / float(Camera.GridW) * 2.0f - 1.0f;
+		const float NdcY = (float(Y) + 0.5f) / float(Camera.GridH) * 2.0f - 1.0f;
+		return FVector(NdcX / Camera.Proj.M[0][0], NdcY / Camera.Proj.M[1][1], 1.0f);
+	}
+
+	float ReadDepth(const FOcclusionGrid& Grid, int X, int Y)
+	{
+		return Grid.SampleMaxRect(X, Y, X, Y, 0);
+	}
+
+	TArray<float> ReadLevel0(const FOcclusionGrid& Grid)
+	{
+		TArray<float> Depth;
+		for (int Y = 0; Y < Grid.GetHeight(); ++Y)
+		{
+			for (int X = 0; X < Grid.GetWidth(); ++X)
+			{
+				Depth.push_back(ReadDepth(Grid, X, Y));
+			}
+		}
+		return Depth;
+	}
+
+	// ──────────────────────────────────────────────
+	// 검사
+	// ──────────────────────────────────────────────
+
+	void TestRasterMatchesRayCast()
+	{
+		const FTestCamera Camera = MakeCamera(FVector(0, 0, 0), FVector(1, 0, 0), 128, 72);
+		const TArray<FTestOccluder> Occluders = MakeFixtureOccluders(Camera);
+
+		FOcclusionCullingManagerCPU Manager;
+		Manager.Initialize(Camera.GridW, Camera.GridH);
+		Manager.RasterizeOccluders(MakeOccluderMeshes(Occluders, Camera), NearClip, FarClip);
+		Manager.BuildHZB();
+		const FOcclusionGrid& Grid = Manager.GetGrid();
+		TEST_CHECK(Grid.GetWidth() == Camera.GridW && Grid.GetHeight() == Camera.GridH);
+		TEST_CHECK(Manager.GetStats().NumOccluderTriangles == 7);
+
+		// 변 근처(무게중심 1e-3 이내)는 덮어도/안 덮어도 됨, 그 밖은 기준과 같아야 함
+		constexpr float EdgeTolerance = 1e-3f;
+		constexpr float DepthTolerance = 2e-4f;
+		const TArray<FViewTriangle> Triangles = GatherFrontTriangles(Occluders, Camera);
+
+		int32 NumCovered = 0;
+		int32 NumBad = 0;
+		float MaxError = 0.0f;
+		for (int Y = 0; Y < Camera.GridH; ++Y)
+		{
+			for (int X = 0; X < Camera.GridW; ++X)
+			{
+				const FVector Dir = PixelRay(Camera, X, Y);
+				const float Nearest = ReferenceDepth(Triangles, Dir, EdgeTolerance);
+				const float Farthest = ReferenceDepth(Triangles, Dir, -EdgeTolerance);
+				const float Depth = ReadDepth(Grid, X, Y);
+
+				NumCovered += Depth < 1.0f ? 1 : 0;
+				if (Nearest == Farthest)
+				{
+					MaxError = std::max(MaxError, std::abs(Depth - Nearest));
+				}
+				if (Depth < Nearest - DepthTolerance || Depth > Farthest + DepthTolerance)
+				{
+					if (NumBad++ < 4)
+					{
+						std::printf("  pixel (%d, %d): raster %.6f, reference [%.6f, %.6f]\n", X, Y, Depth, Nearest, Farthest);
+					}
+				}
+			}
+		}
+		std::printf("[Occlusion Raster] %d/%d pixels covered, max depth error %.2e\n", NumCovered, Camera.GridW * Camera.GridH, MaxError);
+		TEST_CHECK(NumBad == 0);
+		TEST_CHECK(NumCovered > Camera.GridW * Camera.GridH / 4);
+		TEST_CHECK(Manager.GetStats().NumRasterizedTriangles >= 5);
+	}
+
+	void TestHZBIsConservative()
+	{
+		std::mt19937 Rng(7);
+		std::uniform_real_distribution<float> DepthDist(0.0f, 1.0f);
+
+		// 너비는 4의 배수로 올라감 (37 → 40), 높이 23은 그대로 → 홀수 크기 레벨이 생김
+		FOcclusionGrid Grid;
+		Grid.Initialize(37, 23);
+		TEST_CHECK(Grid.GetWidth() == 40 && Grid.GetHeight() == 23);
+		const int W = Grid.GetWidth();
+		const int H = Grid.GetHeight();
+		for (int Y = 0; Y < H; ++Y)
+		{
+			float* Row = Grid.GetDepthRow(Y);
+			for (int X = 0; X < W; ++X)
+			{
+				Row[X] = DepthDist(Rng);
+			}
+		}
+		TArray<float> Level0(size_t(W * H));
+		for (int Y = 0; Y < H; ++Y)
+		{
+			std::memcpy(&Level0[size_t(Y * W)], Grid.GetDepthRow(Y), sizeof(float) * W);
+		}
+		Grid.BuildHZB();
+
+		auto BruteMax = [&](int MinX, int MinY, int MaxX, int MaxY)
+			{
+				float Max = 0.0f;
+				for (int Y = MinY; Y <= MaxY; ++Y)
+				{
+					for (int X = MinX; X <= MaxX; ++X)
+					{
+						Max = std::max(Max, Level0[size_t(Y * W + X)]);
+					}
+				}
+				return Max;
+			};
+
+		// 40x23 → 20x12 → 10x6 → 5x3 → 3x2 → 2x1 → 1x1
+		TEST_CHECK(Grid.GetNumLevels() == 7);
+
+		// 각 레벨 텍셀 = 그 텍셀이 덮는 레벨0 영역의 최댓값 (마지막 줄/칸 포함)
+		bool bExact = true;
+		for (int Mip = 0; Mip < Grid.GetNumLevels(); ++Mip)
+		{
+			const int LevelW = (W + (1 << Mip) - 1) >> Mip;
+			const int LevelH = (H + (1 << Mip) - 1) >> Mip;
+			for (int TY = 0; TY < LevelH; ++TY)
+			{
+				for (int TX = 0; TX < LevelW; ++TX)
+				{
+					const int MinX = TX << Mip;
+					const int MinY = TY << Mip;
+					const int MaxX = std::min(W - 1, ((TX + 1) << Mip) - 1);
+					const int MaxY = std::min(H - 1, ((TY + 1) << Mip) - 1);
+					bExact &= Grid.CountTexels(MinX, MinY, MaxX, MaxY, Mip) == 1;
+					bExact &= Grid.SampleMaxRect(MinX, MinY, MaxX, MaxY, Mip) == BruteMax(MinX, MinY, MaxX, MaxY);
+				}
+			}
+		}
+		TEST_CHECK(bExact);
+		TEST_CHECK(Grid.SampleMaxRect(0, 0, W - 1, H - 1, Grid.GetNumLevels() - 1) == BruteMax(0, 0, W - 1, H - 1));
+
+		// 임의 사각형: 어느 레벨에서 읽어도 레벨0 최댓값 이상
+		std::uniform_int_distribution<int> XDist(0, W - 1);
+		std::uniform_int_distribution<int> YDist(0, H - 1);
+		bool bConservative = true;
+		for (int Iteration = 0; Iteration < 2000; ++Iteration)
+		{
+			int MinX = XDist(Rng), MaxX = XDist(Rng), MinY = YDist(Rng), MaxY = YDist(Rng);
+			if (MinX > MaxX) std::swap(MinX, MaxX);
+			if (MinY > MaxY) std::swap(MinY, MaxY);
+			const float Expected = BruteMax(MinX, MinY, MaxX, MaxY);
+			for (int Mip = 0; Mip < Grid.GetNumLevels(); ++Mip)
+			{
+				bConservative &= Grid.SampleMaxRect(MinX, MinY, MaxX, MaxY, Mip) >= Expected;
+			}
+			bConservative &= Grid.SampleMaxRect(MinX, MinY, MaxX, MaxY, 0) == Expected;
+		}
+		TEST_CHECK(bConservative);
+	}
+
+	/**
+	 * 픽셀 중심 레이 중 박스에 들어가는 지점이 기준 오클루더 깊이보다 가까운 것이 있으면 true
+	 * (그리드 해상도의 정답, 픽셀보다 좁게 삐져나온 부분은 래스터 오클루전이 원래 구분하지 못함)
+	 */
+	bool IsVisibleAtAnyPixel(const FAABB& Box, const TArray<FViewTriangle>& Triangles, const FTestCamera& Camera, const FVector& Eye)
+	{
+		for (int Y = 0; Y < Camera.GridH; ++Y)
+		{
+			for (int X = 0; X < Camera.GridW; ++X)
+			{
+				// 뷰 → 월드 방향 (View 회전의 전치), 뷰 Z = 1이라 레이 매개변수가 곧 뷰 Z
+				const FVector ViewDir = PixelRay(Camera, X, Y);
+				FVector Dir;
+				for (int Axis = 0; Axis < 3; ++Axis)
+				{
+					Dir[Axis] = ViewDir.X * Camera.View.M[Axis][0] + ViewDir.Y * Camera.View.M[Axis][1] + ViewDir.Z * Camera.View.M[Axis][2];
+				}
+
+				float Enter = NearClip;
+				float Exit = FarClip;
+				for (int Axis = 0; Axis < 3 && Enter <= Exit; ++Axis)
+				{
+					if (std::abs(Dir[Axis]) < 1e-8f)
+					{
+						if (Eye[Axis] < Box.Min[Axis] || Eye[Axis] > Box.Max[Axis])
+						{
+							Exit = -1.0f;
+						}
+						continue;
+					}
+					float T0 = (Box.Min[Axis] - Eye[Axis]) / Dir[Axis];
+					float T1 = (Box.Max[Axis] - Eye[Axis]) / Dir[Axis];
+					if (T0 > T1) std::swap(T0, T1);
+					Enter = std::max(Enter, T0);
+					Exit = std::min(Exit, T1);
+				}
+				if (Enter > Exit)
+				{
+					continue;
+				}
+
+				const float BoxDepth = (Enter - NearClip) / (FarClip - NearClip);
+				if (ReferenceDepth(Triangles, ViewDir, 1e-3f) > BoxDepth)
+				{
+					std::printf("  box (%.2f %.2f %.2f)-(%.2f %.2f %.2f) visible at pixel (%d, %d)\n",
+						Box.Min.X, Box.Min.Y, Box.Min.Z, Box.Max.X, Box.Max.Y, Box.Max.Z, X, Y);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void TestOccludees()
+	{
+		const FTestCamera Camera = MakeCamera(FVector(0, 0, 0), FVector(1, 0, 0), 128, 72);
+		const TArray<FTestOccluder> Occluders = MakeFixtureOccluders(Camera);
+
+		FOcclusionCullingManagerCPU Manager;
+		Manager.Initialize(Camera.GridW, Camera.GridH);
+		Manager.RasterizeOccluders(MakeOccluderMeshes(Occluders, Camera), NearClip, FarClip);
+		Manager.BuildHZB();
+
+		struct FFixture
+		{
+			const char* Name;
+			FAABB Bound;
+			bool bExpectVisible;
+		};
+		const FFixture Fixtures[] = {
+			{ "behind wall", FAABB(FVector(20, -1, -0.5f), FVector(22, 1, 0.5f)), false },
+			{ "in front of wall", FAABB(FVector(5, -1, -0.5f), FVector(6, 1, 0.5f)), true },
+			{ "peeks over wall", FAABB(FVector(20, -1, 1), FVector(22, 1, 6)), true },
+			{ "crosses near plane", FAABB(FVector(-1, -0.5f, -0.5f), FVector(1, 0.5f, 0.5f)), true },
+			{ "behind camera", FAABB(FVector(-10, -1, -1), FVector(-8, 1, 1)), true },
+			{ "behind back face", FAABB(FVector(16, -11, -0.5f), FVector(18, -9, 0.5f)), true },
+			{ "below floor", FAABB(FVector(20, 5, -4), FVector(22, 6, -3)), false },
+		};
+
+		TArray<FCandidateDrawable> Candidates;
+		for (uint32 Index = 0; Index < std::size(Fixtures); ++Index)
+		{
+			Candidates.push_back(MakeCandidate(Index, Fixtures[Index].Bound, Camera));
+		}
+		TArray<uint8_t> Visible;
+		Manager.TestOcclusion(Candidates, Visible);
+		TEST_CHECK(Visible.size() == std::size(Fixtures));
+		for (uint32 Index = 0; Index < std::size(Fixtures); ++Index)
+		{
+			if ((Visible[Index] != 0) != Fixtures[Index].bExpectVisible)
+			{
+				std::printf("  '%s': visible %d, expected %d\n", Fixtures[Index].Name, Visible[Index], Fixtures[Index].bExpectVisible ? 1 : 0);
+				TEST_CHECK(false);
+			}
+		}
+		// 근평면/카메라 뒤 박스는 판정하지 않음 (NumTested에서 빠짐)
+		TEST_CHECK(Manager.GetStats().NumTested == std::size(Fixtures) - 2);
+		TEST_CHECK(Manager.GetStats().NumOccluded == 2);
+
+		// 임의 박스: 컬링된 박스는 모든 픽셀 중심 레이에서 기준 오클루더 뒤에 있어야 함
+		const TArray<FViewTriangle> Triangles = GatherFrontTriangles(Occluders, Camera);
+		std::mt19937 Rng(11);
+		std::uniform_real_distribution<float> XDist(3.0f, 45.0f);
+		std::uniform_real_distribution<float> YDist(-25.0f, 25.0f);
+		std::uniform_real_distribution<float> ZDist(-6.0f, 4.0f);
+		std::uniform_real_distribution<float> SizeDist(0.05f, 3.0f);
+
+		TArray<FAABB> Boxes;
+		Candidates.clear();
+		for (uint32 Index = 0; Index < 3000; ++Index)
+		{
+			const FVector Min(XDist(Rng), YDist(Rng), ZDist(Rng));
+			Boxes.push_back(FAABB(Min, Min + FVector(SizeDist(Rng), SizeDist(Rng), SizeDist(Rng))));
+			Candidates.push_back(MakeCandidate(Index, Boxes.back(), Camera));
+		}
+		Visible.clear();
+		Manager.TestOcclusion(Candidates, Visible);
+
+		int32 NumCulled = 0;
+		int32 NumUnsafe = 0;
+		for (uint32 Index = 0; Index < Boxes.size(); ++Index)
+		{
+			if (Visible[Index] == 0)
+			{
+				++NumCulled;
+				NumUnsafe += IsVisibleAtAnyPixel(Boxes[Index], Triangles, Camera, FVector(0, 0, 0)) ? 1 : 0;
+			}
+		}
+		std::printf("[Occlusion Test] %d/%d random boxes culled, %d unsafe\n", NumCulled, int32(Boxes.size()), NumUnsafe);
+		TEST_CHECK(NumUnsafe == 0);
+		TEST_CHECK(NumCulled > 100);
+	}
+
+	// ──────────────────────────────────────────────
+	// 벤치마크: 도시 장면
+	// ──────────────────────────────────────────────
+
+	/** 각 면을 Divisions x Divisions로 나눈 박스 (바깥쪽이 앞면) */
+	void AddSubdividedBox(FTestOccluder& Mesh, const FVector& Min, const FVector& Max, int Divisions)
+	{
+		const FVector Center = (Min + Max) * 0.5f;
+		for (int Face = 0; Face < 6; ++Face)
+		{
+			const int Axis = Face / 2;
+			const int U = (Axis + 1) % 3;
+			const int V = (Axis + 2) % 3;
+			auto Corner = [&](int I, int J)
+				{
+					FVector P;
+					P[Axis] = (Face % 2) ? Max[Axis] : Min[Axis];
+					P[U] = Min[U] + (Max[U] - Min[U]) * float(I) / Divisions;
+					P[V] = Min[V] + (Max[V] - Min[V]) * float(J) / Divisions;
+					return P;
+				};
+			for (int I = 0; I < Divisions; ++I)
+			{
+				for (int J = 0; J < Divisions; ++J)
+				{
+					const FVector P0 = Corner(I, J), P1 = Corner(I + 1, J), P2 = Corner(I + 1, J + 1), P3 = Corner(I, J + 1);
+					// 면 법선이 중심 반대쪽을 향하게 감음 (월드 Z-up LH: 바깥에서 볼 때 시계 방향)
+					const FVector Normal = FVector::Cross(P1 - P0, P2 - P0);
+					if (FVector::Dot(Normal, P0 - Center) < 0.0f)
+					{
+						AddTriangle(Mesh, P0, P1, P2);
+						AddTriangle(Mesh, P0, P2, P3);
+					}
+					else
+					{
+						AddTriangle(Mesh, P0, P2, P1);
+						AddTriangle(Mesh, P0, P3, P2);
+					}
+				}
+			}
+		}
+	}
+
+	void RunBenchmark()
+	{
+		const FTestCamera Camera = MakeCamera(FVector(-5, 0, 1.7f), FVector(20, 3, 1.0f), 256, 144);
+		std::mt19937 Rng(3);
+		std::uniform_real_distribution<float> Height(3.0f, 20.0f);
+
+		TArray<FTestOccluder> Buildings(400);
+		for (int Index = 0; Index < 400; ++Index)
+		{
+			const float X = float(Index % 20) * 8.0f;
+			const float Y = float(Index / 20) * 8.0f - 80.0f;
+			AddSubdividedBox(Buildings[Index], FVector(X, Y, 0), FVector(X + 5, Y + 5, Height(Rng)), 8);
+		}
+		const TArray<FOccluderMesh> Meshes = MakeOccluderMeshes(Buildings, Camera);
+
+		std::uniform_real_distribution<float> XDist(0.0f, 160.0f);
+		std::uniform_real_distribution<float> YDist(-80.0f, 80.0f);
+		TArray<FCandidateDrawable> Candidates;
+		for (uint32 Index = 0; Index < 10000; ++Index)
+		{
+			const FVector Min(XDist(Rng), YDist(Rng), 0.0f);
+			Candidates.push_back(MakeCandidate(Index, FAABB(Min, Min + FVector(0.8f, 0.8f, 1.5f)), Camera));
+		}
+
+		FOcclusionCullingManagerCPU Manager;
+		Manager.Initialize(Camera.GridW, Camera.GridH);
+		TArray<uint8_t> Visible;
+
+		constexpr int NumIterations = 20;
+		double SetupMS = 0.0, RasterMS = 0.0, HZBMS = 0.0, TestMS = 0.0;
+		for (int Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Manager.RasterizeOccluders(Meshes, NearClip, FarClip);
+			Manager.BuildHZB();
+			Manager.TestOcclusion(Candidates, Visible);
+			const FOcclusionStats& Stats = Manager.GetStats();
+			SetupMS += Stats.SetupTimeMS;
+			RasterMS += Stats.RasterTimeMS;
+			HZBMS += Stats.HZBTimeMS;
+			TestMS += Stats.TestTimeMS;
+		}
+
+		const FOcclusionStats& Stats = Manager.GetStats();
+		std::printf("OCCLUSION BENCH (%u occluder tris, %u rasterized, %dx%d grid, %d workers)\n",
+			Stats.NumOccluderTriangles, Stats.NumRasterizedTriangles, Camera.GridW, Camera.GridH, FTaskGraph::GetInstance().GetNumWorkers());
+		std::printf("  setup %.3f ms, raster %.3f ms, HZB %.3f ms, test %.3f ms (%u tested, %.1f%% culled)\n",
+			SetupMS / NumIterations, RasterMS / NumIterations, HZBMS / NumIterations, TestMS / NumIterations,
+			Stats.NumTested, Stats.CulledPercent);
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	TestHZBIsConservative();
+	TestRasterMatchesRayCast();
+	TestOccludees();
+
+	// TaskGraph 초기화 전에는 ParallelFor가 호출 스레드에서 직렬로 돎
+	const FTestCamera Camera = MakeCamera(FVector(0, 0, 0), FVector(1, 0, 0), 128, 72);
+	const TArray<FTestOccluder> Occluders = MakeFixtureOccluders(Camera);
+	FOcclusionCullingManagerCPU SerialManager;
+	SerialManager.Initialize(Camera.GridW, Camera.GridH);
+	SerialManager.RasterizeOccluders(MakeOccluderMeshes(Occluders, Camera), NearClip, FarClip);
+	SerialManager.BuildHZB();
+
+	FTaskGraph::GetInstance().Initialize(4);
+
+	FOcclusionCullingManagerCPU ParallelManager;
+	ParallelManager.Initialize(Camera.GridW, Camera.GridH);
+	ParallelManager.RasterizeOccluders(MakeOccluderMeshes(Occluders, Camera), NearClip, FarClip);
+	ParallelManager.BuildHZB();
+	TEST_CHECK(ReadLevel0(SerialManager.GetGrid()) == ReadLevel0(ParallelManager.GetGrid()));
+	TestOccludees();
+
+	if (MundiTest::HasArg(Argc, Argv, "--bench"))
+	{
+		RunBenchmark();
+	}
+
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("OcclusionTests");
+}
@@ -0,0 +1,360 @@
+#include "pch.h"
+#include "TestHarness.h"
+#include "PackedVertex.h"
+#include <random>
+
+// 압축 정점 포맷(PackedVertex) 인코딩/디코딩 검사
+// - SNORM8/UNORM8: 끝값(-1, 0, 1)은 정확히, 나머지는 반 스텝 이내. -128은 -1로 디코딩
+// - half: 유한한 half 전부 왕복이 비트 단위로 같음, 임의 float는 가장 가까운 half로 (동률이면 짝수)
+// - 본 가중치: 합이 항상 255, 음수는 0, 모두 0이면 0
+// - 위치 양자화: 디코딩 오차가 축마다 Extent / 131070 이하 (헤더 주석의 보장)
+// - FPackedVertex / FPackedSkinnedVertex 왕복 오차와 stride (28 / 40 바이트)
+// - --bench: 100만 정점 인코딩/디코딩 시간과 정점 메모리 절감량
+
+namespace
+{
+    // 양자화 오차 위에 얹는 float 연산 오차 여유
+    constexpr float FloatSlack = 1e-6f;
+
+    // ──────────────────────────────────────────────
+    // 검사
+    // ──────────────────────────────────────────────
+
+    void TestSnormUnorm()
+    {
+        using namespace PackedVertex;
+
+        const FVector4 Ends = UnpackSnorm8x4(PackSnorm8x4(FVector4(-1.0f, 0.0f, 1.0f, -1.0f)));
+        TEST_CHECK(Ends.X == -1.0f && Ends.Y == 0.0f && Ends.Z == 1.0f && Ends.W == -1.0f);
+
+        // 범위 밖은 잘림, -128(0x80)은 -127과 같이 -1
+        const FVector4 Clamped = UnpackSnorm8x4(PackSnorm8x4(FVector4(-3.0f, 2.0f, 0.0f, 0.0f)));
+        TEST_CHECK(Clamped.X == -1.0f && Clamped.Y == 1.0f);
+        TEST_CHECK(UnpackSnorm8x4(0x80u).X == -1.0f);
+
+        const FVector4 UnormEnds = UnpackUnorm8x4(PackUnorm8x4(FVector4(0.0f, 1.0f, -0.5f, 2.0f)));
+        TEST_CHECK(UnormEnds.X == 0.0f && UnormEnds.Y == 1.0f && UnormEnds.Z == 0.0f && UnormEnds.W == 1.0f);
+
+        std::mt19937 Rng(7);
+        std::uniform_real_distribution<float> Signed(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> Unsigned(0.0f, 1.0f);
+        float MaxSnormError = 0.0f;
+        float MaxUnormError = 0.0f;
+        for (int32 Iter = 0; Iter < 100000; ++Iter)
+        {
+            const FVector4 S(Signed(Rng), Signed(Rng), Signed(Rng), Signed(Rng));
+            const FVector4 DS = UnpackSnorm8x4(PackSnorm8x4(S));
+            MaxSnormError = std::max({ MaxSnormError, std::abs(DS.X - S.X), std::abs(DS.Y - S.Y), std::abs(DS.Z - S.Z), std::abs(DS.W - S.W) });
+
+            const FVector4 U(Unsigned(Rng), Unsigned(Rng), Unsigned(Rng), Unsigned(Rng));
+            const FVector4 DU = UnpackUnorm8x4(PackUnorm8x4(U));
+            MaxUnormError = std::max({ MaxUnormError, std::abs(DU.X - U.X), std::abs(DU.Y - U.Y), std::abs(DU.Z - U.Z), std::abs(DU.W - U.W) });
+        }
+        TEST_CHECK(MaxSnormError <= 0.5f / 127.0f + FloatSlack);
+        TEST_CHECK(MaxUnormError <= 0.5f / 255.0f + FloatSlack);
+    }
+
+    void TestHalf()
+    {
+        using namespace PackedVertex;
+
+        // 유한한 half 65536 - 2048개 전부 (부호 0 포함) 왕복이 같은 비트
+        int32 NumMismatches = 0;
+        for (uint32 Half = 0; Half <= 0xFFFF; ++Half)
+        {
+            const uint32 Exponent = (Half >> 10) & 0x1F;
+            if (Exponent == 31)
+            {
+                continue;
+            }
+            if (FloatToHalf(HalfToFloat(static_cast<uint16>(Half))) != Half)
+            {
+                ++NumMismatches;
+            }
+        }
+        TEST_CHECK(NumMismatches == 0);
+
+        // 경계: 65504는 최대값, 65519.99는 65504로, 65520부터 inf. NaN은 NaN 유지
+        TEST_CHECK(FloatToHalf(65504.0f) == 0x7BFF);
+        TEST_CHECK(FloatToHalf(65519.99f) == 0x7BFF);
+        TEST_CHECK(FloatToHalf(65520.0f) == 0x7C00);
+        TEST_CHECK(FloatToHalf(-1e9f) == 0xFC00);
+        TEST_CHECK(FloatToHalf(std::numeric_limits<float>::infinity()) == 0x7C00);
+        TEST_CHECK(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+        // 동률은 짝수 쪽: 1 + 2^-11은 1(0x3C00), 1 + 3 * 2^-11은 1 + 2^-9(0x3C02)
+        TEST_CHECK(FloatToHalf(1.0f + 1.0f / 2048.0f) == 0x3C00);
+        TEST_CHECK(FloatToHalf(1.0f + 3.0f / 2048.0f) == 0x3C02);
+        // 비정규화 수: 최소값 2^-24, 그 절반(동률)은 0으로
+        TEST_CHECK(FloatToHalf(1.0f / 16777216.0f) == 0x0001);
+        TEST_CHECK(FloatToHalf(0.5f / 16777216.0f) == 0x0000);
+
+        // 임의 float는 가장 가까운 half: 이웃 half보다 멀지 않아야 함
+        std::mt19937 Rng(11);
+        std::uniform_real_distribution<float> Exponent(-26.0f, 16.0f);
+        std::uniform_int_distribution<int32> Sign(0, 1);
+        int32 NumNotNearest = 0;
+        for (int32 Iter = 0; Iter < 200000; ++Iter)
+        {
+            const float Value = std::exp2(Exponent(Rng)) * (Sign(Rng) ? -1.0f : 1.0f);
+            if (std::abs(Value) >= 65520.0f)
+            {
+                continue;
+            }
+            const uint16 Half = FloatToHalf(Value);
+            const float Error = std::abs(HalfToFloat(Half) - Value);
+            const uint16 Magnitude = Half & 0x7FFF;
+            const uint16 HalfSign = Half & 0x8000;
+            if (Magnitude < 0x7BFF && std::abs(HalfToFloat(HalfSign | (Magnitude + 1)) - Value) < Error)
+            {
+                ++NumNotNearest;
+            }
+            if (Magnitude > 0 && std::abs(HalfToFloat(HalfSign | (Magnitude - 1)) - Value) < Error)
+            {
+                ++NumNotNearest;
+            }
+        }
+        TEST_CHECK(NumNotNearest == 0);
+
+        const FVector2D UV = UnpackHalf2(PackHalf2(FVector2D(0.25f, -3.5f)));
+        TEST_CHECK(UV.X == 0.25f && UV.Y == -3.5f);
+    }
+
+    void TestBoneWeights()
+    {
+        using namespace PackedVertex;
+
+        auto Sum = [](uint32 Packed)
+        {
+            return (Packed & 0xFF) + ((Packed >> 8) & 0xFF) + ((Packed >> 16) & 0xFF) + (Packed >> 24);
+        };
+
+        const float Zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        TEST_CHECK(PackBoneWeights(Zero) == 0);
+        const float Negative[4] = { -1.0f, -0.5f, 0.0f, 0.0f };
+        TEST_CHECK(PackBoneWeights(Negative) == 0);
+
+        // 3등분: 85 * 3 = 255
+        const float Thirds[4] = { 1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f, 0.0f };
+        TEST_CHECK(PackBoneWeights(Thirds) == (85u | (85u << 8) | (85u << 16)));
+
+        // 음수는 0으로 보고 나머지로 정규화
+        const float Mixed[4] = { 0.5f, -0.25f, 0.5f, 0.0f };
+        const uint32 MixedPacked = PackBoneWeights(Mixed);
+        TEST_CHECK(((MixedPacked >> 8) & 0xFF) == 0);
+        TEST_CHECK(Sum(MixedPacked) == 255);
+
+        std::mt19937 Rng(13);
+        std::uniform_real_distribution<float> Weight(-0.2f, 1.0f);
+        int32 NumBadSums = 0;
+        float MaxError = 0.0f;
+        for (int32 Iter = 0; Iter < 100000; ++Iter)
+        {
+            float Weights[4] = { Weight(Rng), Weight(Rng), Weight(Rng), Weight(Rng) };
+            Weights[Iter % 4] = std::abs(Weights[Iter % 4]) + 0.01f;   // 양수 하나는 보장
+
+            const uint32 Packed = PackBoneWeights(Weights);
+            if (Sum(Packed) != 255)
+            {
+                ++NumBadSums;
+            }
+
+            float Total = 0.0f;
+            for (float W : Weights)
+            {
+                Total += std::max(W, 0.0f);
+            }
+            float Decoded[4];
+            UnpackBoneWeights(Packed, Decoded);
+            for (int32 i = 0; i < 4; ++i)
+            {
+                MaxError = std::max(MaxError, std::abs(Decoded[i] - std::max(Weights[i], 0.0f) / Total));
+            }
+        }
+        TEST_CHECK(NumBadSums == 0);
+        // 최대 잉여 배분은 내림 값에 최대 1을 더하므로 오차는 한 스텝 미만
+        TEST_CHECK(MaxError < 1.0f / 255.0f + FloatSlack);
+    }
+
+    void TestPositionQuantization()
+    {
+        using namespace PackedVertex;
+
+        // 바운드 끝값은 정확히
+        TEST_CHECK(DequantizePosition(QuantizePosition(-20.0f, -20.0f, 50.0f), -20.0f, 50.0f) == -20.0f);
+        TEST_CHECK(QuantizePosition(30.0f, -20.0f, 50.0f) == 65535);
+        // 납작한 축(Extent 0)은 Min으로 복원
+        TEST_CHECK(QuantizePosition(4.0f, 4.0f, 0.0f) == 0);
+        TEST_CHECK(DequantizePosition(0, 4.0f, 0.0f) == 4.0f);
+
+        struct FBounds { float Min; float Extent; };
+        const FBounds Cases[] = { { 0.0f, 1.0f }, { -50.0f, 100.0f }, { 1000.0f, 0.25f }, { -12000.0f, 24000.0f } };
+
+        std::mt19937 Rng(17);
+        for (const FBounds& Bounds : Cases)
+        {
+            std::uniform_real_distribution<float> Value(Bounds.Min, Bounds.Min + Bounds.Extent);
+            const float Bound = Bounds.Extent / 131070.0f + (std::abs(Bounds.Min) + Bounds.Extent) * FloatSlack;
+            float MaxError = 0.0f;
+            for (int32 Iter = 0; Iter < 100000; ++Iter)
+            {
+                const float Original = Value(Rng);
+                const float Decoded = DequantizePosition(QuantizePosition(Original, Bounds.Min, Bounds.Extent), Bounds.Min, Bounds.Extent);
+                MaxError = std::max(MaxError, std::abs(Decoded - Original));
+            }
+            TEST_CHECK(MaxError <= Bound);
+        }
+    }
+
+    FSkinnedVertex MakeSkinnedVertex(std::mt19937& Rng)
+    {
+        std::uniform_real_distribution<float> Signed(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> Unsigned(0.0f, 1.0f);
+        std::uniform_int_distribution<uint32> Bone(0, 1023);
+
+        FSkinnedVertex Vertex;
+        Vertex.Position = FVector(Signed(Rng) * 100.0f, Signed(Rng) * 100.0f, Signed(Rng) * 100.0f);
+        Vertex.Normal = FVector(Signed(Rng), Signed(Rng), Signed(Rng)).GetNormalized();
+        Vertex.UV = FVector2D(Unsigned(Rng) * 4.0f, Unsigned(Rng));
+        const FVector Tangent = FVector(Signed(Rng), Signed(Rng), Signed(Rng)).GetNormalized();
+        Vertex.Tangent = FVector4(Tangent.X, Tangent.Y, Tangent.Z, Signed(Rng) < 0.0f ? -1.0f : 1.0f);
+        Vertex.Color = FVector4(Unsigned(Rng), Unsigned(Rng), Unsigned(Rng), 1.0f);
+        float Total = 0.0f;
+        for (int32 i = 0; i < 4; ++i)
+        {
+            Vertex.BoneIndices[i] = Bone(Rng);
+            Vertex.BoneWeights[i] = Unsigned(Rng);
+            Total += Vertex.BoneWeights[i];
+        }
+        for (float& W : Vertex.BoneWeights)
+        {
+            W /= Total;
+        }
+        return Vertex;
+    }
+
+    void TestPackedVertexRoundTrip()
+    {
+        TEST_CHECK(sizeof(FPackedVertex) == 28);
+        TEST_CHECK(sizeof(FPackedSkinnedVertex) == 40);
+
+        PackedVertex::SetEnabled(false);
+        TEST_CHECK(PackedVertex::GetStaticVertexStride() == sizeof(FVertexDynamic));
+        TEST_CHECK(PackedVertex::GetSkinnedVertexStride() == sizeof(FSkinnedVertex));
+        PackedVertex::SetEnabled(true);
+        TEST_CHECK(PackedVertex::GetStaticVertexStride() == 28);
+        TEST_CHECK(PackedVertex::GetSkinnedVertexStride() == 40);
+        // 위치 양자화는 압축 포맷이 켜져 있을 때만 의미 있음
+        PackedVertex::SetPositionQuantizationEnabled(true);
+        TEST_CHECK(PackedVertex::IsPositionQuantizationEnabled());
+        PackedVertex::SetEnabled(false);
+        TEST_CHECK(!PackedVertex::IsPositionQuantizationEnabled());
+        PackedVertex::SetPositionQuantizationEnabled(false);
+
+        std::mt19937 Rng(19);
+        const float SnormStep = 0.5f / 127.0f + FloatSlack;
+        int32 NumBad = 0;
+        for (int32 Iter = 0; Iter < 20000; ++Iter)
+        {
+            const FSkinnedVertex Src = MakeSkinnedVertex(Rng);
+            FPackedSkinnedVertex Packed;
+            Packed.FillFrom(Src);
+            const FSkinnedVertex Decoded = Packed.Decode();
+
+            bool bOk = Decoded.Position == Src.Position;
+            bOk &= std::abs(Decoded.Normal.X - Src.Normal.X) <= SnormStep
+                && std::abs(Decoded.Normal.Y - Src.Normal.Y) <= SnormStep
+                && std::abs(Decoded.Normal.Z - Src.Normal.Z) <= SnormStep;
+            bOk &= std::abs(Decoded.Tangent.X - Src.Tangent.X) <= SnormStep
+                && std::abs(Decoded.Tangent.Y - Src.Tangent.Y) <= SnormStep
+                && std::abs(Decoded.Tangent.Z - Src.Tangent.Z) <= SnormStep
+                && Decoded.Tangent.W == Src.Tangent.W;
+            // half 상대 오차 2^-11 (UV는 0 ~ 4라 절대 오차 4 * 2^-11 이하)
+            bOk &= std::abs(Decoded.UV.X - Src.UV.X) <= 4.0f / 2048.0f && std::abs(Decoded.UV.Y - Src.UV.Y) <= 1.0f / 2048.0f;
+            bOk &= std::abs(Decoded.Color.X - Src.Color.X) <= 0.5f / 255.0f + FloatSlack && Decoded.Color.W == 1.0f;
+
+            float WeightSum = 0.0f;
+            for (int32 i = 0; i < 4; ++i)
+            {
+                bOk &= Decoded.BoneIndices[i] == Src.BoneIndices[i];
+                bOk &= std::abs(Decoded.BoneWeights[i] - Src.BoneWeights[i]) < 1.0f / 255.0f + FloatSlack;
+                WeightSum += Decoded.BoneWeights[i];
+            }
+            bOk &= std::abs(WeightSum - 1.0f) < 4.0f * FloatSlack;
+
+            if (!bOk)
+            {
+                ++NumBad;
+            }
+        }
+        TEST_CHECK(NumBad == 0);
+
+        // FMeshData 경로: 없는 속성은 기본값 (노멀 +Z, UV 0, 흰색)
+        FMeshData Mesh;
+        Mesh.Vertices.push_back(FVector(1.0f, 2.0f, 3.0f));
+        FPackedVertex FromMesh;
+        FromMesh.FillFrom(Mesh, 0);
+        const FNormalVertex Defaulted = FromMesh.Decode();
+        TEST_CHECK(Defaulted.pos == FVector(1.0f, 2.0f, 3.0f));
+        TEST_CHECK(Defaulted.normal == FVector(0.0f, 0.0f, 1.0f));
+        TEST_CHECK(Defaulted.tex.X == 0.0f && Defaulted.tex.Y == 0.0f);
+        TEST_CHECK(Defaulted.color.X == 1.0f && Defaulted.color.W == 1.0f);
+    }
+
+    // ──────────────────────────────────────────────
+    // 벤치마크
+    // ──────────────────────────────────────────────
+
+    void RunPackBenchmark()
+    {
+        constexpr int32 NumVertices = 1000000;
+        std::mt19937 Rng(23);
+        TArray<FSkinnedVertex> Source;
+        Source.reserve(NumVertices);
+        for (int32 Index = 0; Index < NumVertices; ++Index)
+        {
+            Source.push_back(MakeSkinnedVertex(Rng));
+        }
+
+        TArray<FPackedSkinnedVertex> Packed(NumVertices);
+        MundiTest::FTimer PackTimer;
+        for (int32 Index = 0; Index < NumVertices; ++Index)
+        {
+            Packed[Index].FillFrom(Source[Index]);
+        }
+        const double PackMS = PackTimer.ElapsedMS();
+
+        double Checksum = 0.0;
+        MundiTest::FTimer DecodeTimer;
+        for (int32 Index = 0; Index < NumVertices; ++Index)
+        {
+            Checksum += Packed[Index].Decode().BoneWeights[0];
+        }
+        const double DecodeMS = DecodeTimer.ElapsedMS();
+
+        const double FullMB = static_cast<double>(NumVertices) * sizeof(FSkinnedVertex) / (1024.0 * 1024.0);
+        const double PackedMB = static_cast<double>(NumVertices) * sizeof(FPackedSkinnedVertex) / (1024.0 * 1024.0);
+        const double StaticFullMB = static_cast<double>(NumVertices) * sizeof(FVertexDynamic) / (1024.0 * 1024.0);
+        const double StaticPackedMB = static_cast<double>(NumVertices) * sizeof(FPackedVertex) / (1024.0 * 1024.0);
+        std::printf("PACKED VERTEX BENCH (%d vertices)\n", NumVertices);
+        std::printf("  pack   : %.1f ms, decode: %.1f ms (checksum %.1f)\n", PackMS, DecodeMS, Checksum);
+        std::printf("  static : %.1f MB -> %.1f MB (%zu -> %zu bytes/vertex)\n",
+            StaticFullMB, StaticPackedMB, sizeof(FVertexDynamic), sizeof(FPackedVertex));
+        std::printf("  skinned: %.1f MB -> %.1f MB (%zu -> %zu bytes/vertex)\n",
+            FullMB, PackedMB, sizeof(FSkinnedVertex), sizeof(FPackedSkinnedVertex));
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestSnormUnorm();
+    TestHalf();
+    TestBoneWeights();
+    TestPositionQuantization();
+    TestPackedVertexRoundTrip();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunPackBenchmark();
+    }
+    return MundiTest::Finish("PackedVertexTests");
+}
@@ -0,0 +1,629 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "RHICommandList.h"
+#include "MeshDrawCommands.h"
+#include "ConstantBufferType.h"
+#include "Material.h"
+#include "Texture.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <random>
+
+// 렌더 명령 리스트(FRHICommandList), 널 백엔드(FNullCommandBackend), 메시 패스 기록(FMeshPassRecording) 검사
+// - 명령 종류마다 기록한 값이 재생(ForEach)에서 그대로 나옴, 상수 데이터는 페이로드 뒤, Reset 뒤 다시 기록해도 같음
+// - 널 백엔드 검증: 셰이더 없이(또는 VS가 nullptr) 드로우, 버퍼 없이 드로우, 인덱스/인스턴스 0,
+//   업로드 전 상수 블록 바인딩, 범위 밖 블록은 오류. 바인딩 상태는 리스트마다 새로 시작
+// - 합성 장면(셰이더 24, 텍스처 600, 메시 2000, 일부 스키닝/파티클/머티리얼/무효 배치)을 패스 4개로 기록
+//   무효 배치는 건너뛰고 검증 오류 없음, 상수 블록 경로는 패스마다 링 업로드 1회
+// - 직렬 기록과 4 워커 병렬 기록(패스마다 ParallelFor)의 재생 스트림이 같음 (블록 포인터는 블록 내용으로 비교)
+
+// D3D11 백엔드(D3D11CommandBackend.cpp)처럼 상수 버퍼 타입마다 Apply를 인스턴스화 (재생은 널/캡처 백엔드만 함)
+template<typename T>
+void TRHIConstantBufferApply<T>::Apply(D3D11RHI&, const void*)
+{
+}
+#define INSTANTIATE_CONSTANT_BUFFER_APPLY(TYPE) \
+template struct TRHIConstantBufferApply<TYPE>;
+CONSTANT_BUFFER_LIST(INSTANTIATE_CONSTANT_BUFFER_APPLY)
+
+namespace
+{
+	template<typename T>
+	T* FakePointer(uint64 Tag, uint64 Index)
+	{
+		return reinterpret_cast<T*>((Tag << 40) | ((Index + 1) << 6));
+	}
+
+	class FTestMaterial : public UMaterialInterface
+	{
+	public:
+		FTestMaterial(UTexture* InDiffuse, UTexture* InNormal)
+			: Diffuse(InDiffuse), Normal(InNormal)
+		{
+			Info.DiffuseTextureFileName = InDiffuse ? "Diffuse.dds" : "";
+			Info.NormalTextureFileName = InNormal ? "Normal.dds" : "";
+			Info.DiffuseColor = FVector(0.1f, 0.2f, 0.3f);
+		}
+
+		UTexture* GetTexture(EMaterialTextureSlot Slot) const override
+		{
+			return Slot == EMaterialTextureSlot::Diffuse ? Diffuse : (Slot == EMaterialTextureSlot::Normal ? Normal : nullptr);
+		}
+
+		const FMaterialInfo& GetMaterialInfo() const override { return Info; }
+
+	private:
+		UTexture* Diffuse;
+		UTexture* Normal;
+		FMaterialInfo Info;
+	};
+
+	/**
+	 * 재생 스트림을 명령 종류 + 필드 값 배열로 옮겨 적는 백엔드
+	 * 구조체 패딩은 비교하지 않고, 블록 업로드는 포인터 대신 블록 내용을 적음 (패스마다 블록 배열 주소가 다름)
+	 */
+	class FCaptureCommandBackend : public IRHICommandBackend
+	{
+	public:
+		void Execute(const FRHICommandList& CommandList) override
+		{
+			CommandList.ForEach([this](const FRHICommandHeader& Header, const void* Payload)
+			{
+				Add(static_cast<uint64>(Header.Type));
+				Add(Header.Size);
+				switch (Header.Type)
+				{
+				case ERHICommand::SetShaders:
+				{
+					const FRHICmdSetShaders& Cmd = *static_cast<const FRHICmdSetShaders*>(Payload);
+					Add(Cmd.VertexShader); Add(Cmd.PixelShader); Add(Cmd.InputLayout);
+					break;
+				}
+				case ERHICommand::SetVertexBuffers:
+				{
+					const FRHICmdSetVertexBuffers& Cmd = *static_cast<const FRHICmdSetVertexBuffers*>(Payload);
+					Add(Cmd.NumBuffers);
+					for (uint32 Index = 0; Index < Cmd.NumBuffers && Index < FRHICmdSetVertexBuffers::MaxBuffers; ++Index)
+					{
+						Add(Cmd.Buffers[Index]); Add(Cmd.Strides[Index]); Add(Cmd.Offsets[Index]);
+					}
+					break;
+				}
+				case ERHICommand::SetIndexBuffer:
+				{
+					const FRHICmdSetIndexBuffer& Cmd = *static_cast<const FRHICmdSetIndexBuffer*>(Payload);
+					Add(Cmd.Buffer); Add(static_cast<uint64>(Cmd.Format));
+					break;
+				}
+				case ERHICommand::SetPrimitiveTopology:
+					Add(static_cast<uint64>(static_cast<const FRHICmdSetPrimitiveTopology*>(Payload)->Topology));
+					break;
+				case ERHICommand::SetShaderResources:
+				{
+					const FRHICmdSetShaderResources& Cmd = *static_cast<const FRHICmdSetShaderResources*>(Payload);
+					Add(static_cast<uint64>(Cmd.Stage)); Add(Cmd.StartSlot); Add(Cmd.NumViews);
+					for (uint32 Index = 0; Index < Cmd.NumViews; ++Index)
+					{
+						Add(Cmd.Views[Index]);
+					}
+					break;
+				}
+				case ERHICommand::SetSamplers:
+				{
+					const FRHICmdSetSamplers& Cmd = *static_cast<const FRHICmdSetSamplers*>(Payload);
+					Add(static_cast<uint64>(Cmd.Stage)); Add(Cmd.StartSlot); Add(Cmd.NumSamplers);
+					for (uint32 Index = 0; Index < Cmd.NumSamplers; ++Index)
+					{
+						Add(Cmd.Samplers[Index]);
+					}
+					break;
+				}
+				case ERHICommand::UpdateConstantBuffer:
+				{
+					const FRHICmdUpdateConstantBuffer& Cmd = *static_cast<const FRHICmdUpdateConstantBuffer*>(Payload);
+					Add(reinterpret_cast<const void*>(Cmd.Apply)); Add(Cmd.DataSize);
+					AddBytes(FRHICommandList::GetConstantData(Cmd), Cmd.DataSize);
+					break;
+				}
+				case ERHICommand::UploadConstantBlocks:
+				{
+					const FRHICmdUploadConstantBlocks& Cmd = *static_cast<const FRHICmdUploadConstantBlocks*>(Payload);
+					Add(Cmd.NumBlocks);
+					AddBytes(Cmd.Blocks, sizeof(FObjectConstantBlock) * Cmd.NumBlocks);
+					break;
+				}
+				case ERHICommand::BindConstantBlocks:
+				{
+					const FObjectConstantDraw& Draw = static_cast<const FRHICmdBindConstantBlocks*>(Payload)->Draw;
+					Add(Draw.Model); Add(Draw.Color); Add(Draw.SubUV); Add(Draw.Emitter); Add(Draw.Instancing);
+					break;
+				}
+				case ERHICommand::DrawIndexed:
+				{
+					const FRHICmdDrawIndexed& Cmd = *static_cast<const FRHICmdDrawIndexed*>(Payload);
+					Add(Cmd.IndexCount); Add(Cmd.StartIndex); Add(static_cast<uint64>(Cmd.BaseVertex));
+					break;
+				}
+				case ERHICommand::DrawIndexedInstanced:
+				{
+					const FRHICmdDrawIndexedInstanced& Cmd = *static_cast<const FRHICmdDrawIndexedInstanced*>(Payload);
+					Add(Cmd.IndexCount); Add(Cmd.InstanceCount); Add(Cmd.StartIndex); Add(static_cast<uint64>(Cmd.BaseVertex)); Add(Cmd.StartInstance);
+					break;
+				}
+				case ERHICommand::DrawInstanced:
+				{
+					const FRHICmdDrawInstanced& Cmd = *static_cast<const FRHICmdDrawInstanced*>(Payload);
+					Add(Cmd.VertexCount); Add(Cmd.InstanceCount); Add(Cmd.StartVertex); Add(Cmd.StartInstance);
+					break;
+				}
+				default:
+					break;
+				}
+			});
+		}
+
+		const TArray<uint64>& GetStream() const { return Stream; }
+
+	private:
+		void Add(uint64 Value) { Stream.Add(Value); }
+		void Add(const void* Pointer) { Stream.Add(reinterpret_cast<uint64>(Pointer)); }
+
+		void AddBytes(const void* Data, size_t Size)
+		{
+			const uint8* Bytes = static_cast<const uint8*>(Data);
+			for (size_t Offset = 0; Offset < Size; Offset += 8)
+			{
+				uint64 Word = 0;
+				std::memcpy(&Word, Bytes + Offset, std::min<size_t>(8, Size - Offset));
+				Stream.Add(Word);
+			}
+		}
+
+		TArray<uint64> Stream;
+	};
+
+	FNullCommandBackend ExecuteNull(const FRHICommandList& CommandList)
+	{
+		FNullCommandBackend Backend;
+		Backend.Execute(CommandList);
+		return Backend;
+	}
+
+	bool StartsWith(const FString& Text, const char* Prefix)
+	{
+		return Text.rfind(Prefix, 0) == 0;
+	}
+
+	// ──────────────────────────────────────────────
+	// 명령 리스트
+	// ──────────────────────────────────────────────
+
+	void RecordEveryCommand(FRHICommandList& Commands, const FObjectConstantBlock* Blocks)
+	{
+		ID3D11ShaderResourceView* Views[3] = { FakePointer<ID3D11ShaderResourceView>(3, 0), nullptr, FakePointer<ID3D11ShaderResourceView>(3, 2) };
+		ID3D11SamplerState* Samplers[2] = { FakePointer<ID3D11SamplerState>(8, 0), FakePointer<ID3D11SamplerState>(8, 1) };
+		FRHICmdSetVertexBuffers VertexBuffers{};
+		VertexBuffers.Buffers[0] = FakePointer<ID3D11Buffer>(4, 0);
+		VertexBuffers.Buffers[1] = FakePointer<ID3D11Buffer>(4, 1);
+		VertexBuffers.Strides[0] = 64;
+		VertexBuffers.Strides[1] = 80;
+		VertexBuffers.Offsets[1] = 160;
+		VertexBuffers.NumBuffers = 2;
+		FObjectConstantDraw Draw;
+		Draw.Model = 1;
+		Draw.Color = 2;
+
+		FInstancingBufferType InstancingBuffer{};
+		InstancingBuffer.InstanceOffset = 1234;
+
+		Commands.SetShaders(FakePointer<ID3D11VertexShader>(1, 0), FakePointer<ID3D11PixelShader>(2, 0), FakePointer<ID3D11InputLayout>(9, 0));
+		Commands.SetVertexBuffers(VertexBuffers);
+		Commands.SetIndexBuffer(FakePointer<ID3D11Buffer>(5, 0), DXGI_FORMAT_R32_UINT);
+		Commands.SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		Commands.SetShaderResources(ERHIShaderStage::Pixel, 1, 3, Views);
+		Commands.SetSamplers(ERHIShaderStage::Vertex, 2, 2, Samplers);
+		Commands.UpdateConstantBuffer(InstancingBuffer);
+		Commands.UploadConstantBlocks(Blocks, 3);
+		Commands.BindConstantBlocks(Draw);
+		Commands.DrawIndexed(36, 6, -2);
+		Commands.DrawIndexedInstanced(36, 10, 0, 0, 5);
+		Commands.DrawInstanced(4, 100, 0, 0);
+	}
+
+	void TestRecordAndReplay()
+	{
+		FObjectConstantBlock Blocks[3] = {};
+		FRHICommandList Commands;
+		TEST_CHECK(Commands.IsEmpty());
+		RecordEveryCommand(Commands, Blocks);
+		TEST_CHECK(Commands.Num() == 12);
+		TEST_CHECK(Commands.GetSizeBytes() % 8 == 0);
+
+		const ERHICommand ExpectedTypes[] = {
+			ERHICommand::SetShaders, ERHICommand::SetVertexBuffers, ERHICommand::SetIndexBuffer, ERHICommand::SetPrimitiveTopology,
+			ERHICommand::SetShaderResources, ERHICommand::SetSamplers, ERHICommand::UpdateConstantBuffer, ERHICommand::UploadConstantBlocks,
+			ERHICommand::BindConstantBlocks, ERHICommand::DrawIndexed, ERHICommand::DrawIndexedInstanced, ERHICommand::DrawInstanced,
+		};
+		int32 Index = 0;
+		uint32 TotalBytes = 0;
+		bool bTypesMatch = true;
+		bool bPayloadsMatch = true;
+		Commands.ForEach([&](const FRHICommandHeader& Header, const void* Payload)
+		{
+			bTypesMatch &= Index < 12 && Header.Type == ExpectedTypes[Index];
+			TotalBytes += Header.Size;
+			switch (Header.Type)
+			{
+			case ERHICommand::SetVertexBuffers:
+			{
+				const FRHICmdSetVertexBuffers& Cmd = *static_cast<const FRHICmdSetVertexBuffers*>(Payload);
+				bPayloadsMatch &= Cmd.NumBuffers == 2 && Cmd.Strides[1] == 80 && Cmd.Offsets[1] == 160 && Cmd.Buffers[1] == FakePointer<ID3D11Buffer>(4, 1);
+				break;
+			}
+			case ERHICommand::SetShaderResources:
+			{
+				const FRHICmdSetShaderResources& Cmd = *static_cast<const FRHICmdSetShaderResources*>(Payload);
+				bPayloadsMatch &= Cmd.Stage == ERHIShaderStage::Pixel && Cmd.StartSlot == 1 && Cmd.NumViews == 3 &&
+					Cmd.Views[1] == nullptr && Cmd.Views[2] == FakePointer<ID3D11ShaderResourceView>(3, 2);
+				break;
+			}
+			case ERHICommand::UpdateConstantBuffer:
+			{
+				const FRHICmdUpdateConstantBuffer& Cmd = *static_cast<const FRHICmdUpdateConstantBuffer*>(Payload);
+				const FInstancingBufferType& Data = *static_cast<const FInstancingBufferType*>(FRHICommandList::GetConstantData(Cmd));
+				bPayloadsMatch &= Cmd.DataSize == sizeof(FInstancingBufferType) && Data.InstanceOffset == 1234 &&
+					Cmd.Apply == &TRHIConstantBufferApply<FInstancingBufferType>::Apply;
+				break;
+			}
+			case ERHICommand::UploadConstantBlocks:
+			{
+				const FRHICmdUploadConstantBlocks& Cmd = *static_cast<const FRHICmdUploadConstantBlocks*>(Payload);
+				bPayloadsMatch &= Cmd.Blocks == Blocks && Cmd.NumBlocks == 3;
+				break;
+			}
+			case ERHICommand::DrawIndexed:
+			{
+				const FRHICmdDrawIndexed& Cmd = *static_cast<const FRHICmdDrawIndexed*>(Payload);
+				bPayloadsMatch &= Cmd.IndexCount == 36 && Cmd.StartIndex == 6 && Cmd.BaseVertex == -2;
+				break;
+			}
+			case ERHICommand::DrawIndexedInstanced:
+			{
+				const FRHICmdDrawIndexedInstanced& Cmd = *static_cast<const FRHICmdDrawIndexedInstanced*>(Payload);
+				bPayloadsMatch &= Cmd.InstanceCount == 10 && Cmd.StartInstance == 5;
+				break;
+			}
+			default:
+				break;
+			}
+			++Index;
+		});
+		TEST_CHECK(Index == 12);
+		TEST_CHECK(bTypesMatch);
+		TEST_CHECK(bPayloadsMatch);
+		TEST_CHECK(TotalBytes == Commands.GetSizeBytes());
+
+		const FNullCommandBackend Backend = ExecuteNull(Commands);
+		TEST_CHECK(Backend.GetStats().NumValidationErrors == 0);
+		TEST_CHECK(Backend.GetStats().NumCommands == 12);
+		TEST_CHECK(Backend.GetStats().NumDraws == 3);
+		TEST_CHECK(Backend.GetStats().NumIndices == 36 + 36 * 10 + 4 * 100);
+		TEST_CHECK(Backend.GetStats().GetNumBufferMaps() == 2);
+
+		// Reset 뒤 같은 기록은 같은 스트림
+		FCaptureCommandBackend First;
+		First.Execute(Commands);
+		Commands.Reset();
+		TEST_CHECK(Commands.IsEmpty() && Commands.GetSizeBytes() == 0);
+		RecordEveryCommand(Commands, Blocks);
+		FCaptureCommandBackend Second;
+		Second.Execute(Commands);
+		TEST_CHECK(First.GetStream() == Second.GetStream());
+	}
+
+	void TestValidation()
+	{
+		ID3D11VertexShader* VertexShader = FakePointer<ID3D11VertexShader>(1, 0);
+		ID3D11PixelShader* PixelShader = FakePointer<ID3D11PixelShader>(2, 0);
+		ID3D11Buffer* VertexBuffer = FakePointer<ID3D11Buffer>(4, 0);
+		ID3D11Buffer* IndexBuffer = FakePointer<ID3D11Buffer>(5, 0);
+		FObjectConstantBlock Blocks[2] = {};
+
+		// 셰이더를 바인딩하지 않은 드로우
+		FRHICommandList NoShader;
+		NoShader.SetVertexBuffer(VertexBuffer, 64);
+		NoShader.SetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT);
+		NoShader.DrawIndexed(36, 0, 0);
+		FNullCommandBackend Backend = ExecuteNull(NoShader);
+		TEST_CHECK(Backend.GetStats().NumValidationErrors == 1);
+		TEST_CHECK(StartsWith(Backend.GetStats().FirstError, "DrawIndexed: missing shader or buffers (command 2)"));
+
+		// VS를 nullptr로 바인딩한 드로우 (인스턴스 드로우, 정점 드로우 포함)
+		FRHICommandList NullShader;
+		NullShader.SetShaders(nullptr, PixelShader, nullptr);
+		NullShader.SetVertexBuffer(VertexBuffer, 64);
+		NullShader.SetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT);
+		NullShader.DrawIndexed(36, 0, 0);
+		NullShader.DrawIndexedInstanced(36, 4, 0, 0, 0);
+		NullShader.DrawInstanced(4, 4, 0, 0);
+		TEST_CHECK(ExecuteNull(NullShader).GetStats().NumValidationErrors == 3);
+
+		// 버퍼 없이 드로우
+		FRHICommandList NoBuffers;
+		NoBuffers.SetShaders(VertexShader, PixelShader, nullptr);
+		NoBuffers.DrawIndexed(36, 0, 0);
+		TEST_CHECK(ExecuteNull(NoBuffers).GetStats().NumValidationErrors == 1);
+
+		// 유효한 드로우
+		FRHICommandList Valid;
+		Valid.SetShaders(VertexShader, PixelShader, nullptr);
+		Valid.SetVertexBuffer(VertexBuffer, 64);
+		Valid.SetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT);
+		Valid.DrawIndexed(36, 0, 0);
+		TEST_CHECK(ExecuteNull(Valid).GetStats().NumValidationErrors == 0);
+
+		// 바인딩 상태는 리스트 사이에 이어지지 않음 (같은 백엔드에서 차례로 재생해도 두 번째 리스트는 오류)
+		FRHICommandList DrawOnly;
+		DrawOnly.DrawIndexed(36, 0, 0);
+		FNullCommandBackend Sequence;
+		Sequence.Execute(Valid);
+		Sequence.Execute(DrawOnly);
+		TEST_CHECK(Sequence.GetStats().NumValidationErrors == 1);
+		TEST_CHECK(Sequence.GetStats().NumDraws == 2);
+
+		// 개수 0
+		FRHICommandList ZeroCounts = Valid;
+		ZeroCounts.DrawIndexed(0, 0, 0);
+		ZeroCounts.DrawIndexedInstanced(36, 0, 0, 0, 0);
+		ZeroCounts.DrawInstanced(0, 1, 0, 0);
+		TEST_CHECK(ExecuteNull(ZeroCounts).GetStats().NumValidationErrors == 3);
+
+		// 상수 블록: 업로드 전 바인딩, 범위 밖 블록, 빈 업로드
+		FObjectConstantDraw Draw;
+		Draw.Model = 1;
+		FRHICommandList BindBeforeUpload;
+		BindBeforeUpload.BindConstantBlocks(Draw);
+		TEST_CHECK(StartsWith(ExecuteNull(BindBeforeUpload).GetStats().FirstError, "BindConstantBlocks: no blocks uploaded"));
+
+		FRHICommandList OutOfRange;
+		OutOfRange.UploadConstantBlocks(Blocks, 2);
+		OutOfRange.BindConstantBlocks(Draw);
+		Draw.Color = 2;
+		OutOfRange.BindConstantBlocks(Draw);
+		const FNullCommandBackend OutOfRangeBackend = ExecuteNull(OutOfRange);
+		TEST_CHECK(OutOfRangeBackend.GetStats().NumValidationErrors == 1);
+		TEST_CHECK(StartsWith(OutOfRangeBackend.GetStats().FirstError, "BindConstantBlocks: block out of range (command 2)"));
+
+		FRHICommandList EmptyUpload;
+		EmptyUpload.UploadConstantBlocks(nullptr, 0);
+		TEST_CHECK(ExecuteNull(EmptyUpload).GetStats().NumValidationErrors == 1);
+	}
+
+	// ──────────────────────────────────────────────
+	// 메시 패스 기록
+	// ──────────────────────────────────────────────
+
+	struct FTestScene
+	{
+		TArray<UTexture> Textures;
+		TArray<FTestMaterial> Materials;
+		TArray<TArray<FMeshBatchElement>> PassBatches;
+		int32 NumInvalid = 0;
+	};
+
+	// 셰이더 24, 텍스처 600(인스턴스 SRV), 메시 2000, 일부는 스키닝/파티클/자동 인스턴싱/머티리얼, 일부는 무효
+	void MakeScene(FTestScene& Scene, int32 NumBatches, int32 NumPasses, uint32 Seed)
+	{
+		constexpr int32 NumPrograms = 24;
+		constexpr int32 NumTextures = 600;
+		constexpr int32 NumMeshes = 2000;
+
+		// 머티리얼이 텍스처를 가리키므로 먼저 크기를 고정
+		Scene.Textures.reserve(8);
+		Scene.Materials.reserve(4);
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Scene.Textures.emplace_back(FakePointer<ID3D11ShaderResourceView>(10, Index));
+		}
+		Scene.Materials.emplace_back(&Scene.Textures[0], &Scene.Textures[1]);
+		Scene.Materials.emplace_back(&Scene.Textures[2], nullptr);
+		Scene.Materials.emplace_back(nullptr, &Scene.Textures[3]);
+		Scene.Materials.emplace_back(nullptr, nullptr);
+
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> PositionDist(-2000.0f, 2000.0f);
+		Scene.PassBatches.SetNum(NumPasses);
+		for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
+		{
+			const uint32 Mesh = Rng() % NumMeshes;
+			const uint32 Program = Mesh % NumPrograms;
+
+			FMeshBatchElement Batch;
+			Batch.VertexShader = FakePointer<ID3D11VertexShader>(1, Program);
+			Batch.PixelShader = FakePointer<ID3D11PixelShader>(2, Program);
+			Batch.VertexBuffer = FakePointer<ID3D11Buffer>(4, Mesh);
+			Batch.IndexBuffer = FakePointer<ID3D11Buffer>(5, Mesh);
+			Batch.VertexStride = 64;
+			Batch.IndexCount = 3000;
+			Batch.WorldMatrix = FMatrix::Identity();
+			Batch.WorldMatrix.M[3][0] = PositionDist(Rng);
+			Batch.WorldMatrix.M[3][1] = PositionDist(Rng);
+			Batch.WorldMatrix.M[3][2] = PositionDist(Rng);
+			Batch.ObjectID = static_cast<uint32>(BatchIndex);
+			if (Mesh % 5 == 0)
+			{
+				Batch.Material = &Scene.Materials[Mesh % Scene.Materials.Num()];
+			}
+			else
+			{
+				Batch.InstanceShaderResourceView = FakePointer<ID3D11ShaderResourceView>(3, (Mesh * 3) % NumTextures);
+			}
+			if (Mesh % 10 == 0)
+			{
+				Batch.GPUSkinMatrixSRV = FakePointer<ID3D11ShaderResourceView>(6, Mesh);
+				Batch.GPUSkinNormalMatrixSRV = FakePointer<ID3D11ShaderResourceView>(7, Mesh);
+			}
+			if (Mesh % 17 == 0)
+			{
+				Batch.SubImages_Horizontal = 4;
+				Batch.SubImages_Vertical = 4;
+				Batch.ScreenAlignment = EScreenAlignment::CameraFacing;
+			}
+			if (Mesh % 23 == 0)
+			{
+				Batch.bInstancedDraw = true;
+				Batch.InstanceVertexBuffer = FakePointer<ID3D11Buffer>(11, Mesh);
+				Batch.InstanceStride = 80;
+				Batch.InstanceCount = 1 + Mesh % 50;
+			}
+			else if (Mesh % 7 == 0)
+			{
+				Batch.bAutoInstanced = true;
+				Batch.InstanceStart = Rng() % 10000;
+				Batch.InstanceCount = 2 + Rng() % 30;
+			}
+			// 기록이 건너뛰어야 하는 배치 (셰이더/지오메트리 누락, 인스턴스 0)
+			if (Mesh % 97 == 0)
+			{
+				const uint32 Kind = Rng() % 3;
+				if (Kind == 0) { Batch.VertexShader = nullptr; }
+				else if (Kind == 1) { Batch.IndexBuffer = nullptr; }
+				else { Batch.bInstancedDraw = true; Batch.InstanceCount = 0; }
+				++Scene.NumInvalid;
+			}
+			Scene.PassBatches[BatchIndex % NumPasses].Add(Batch);
+		}
+
+		// 상태 순으로 정렬된 리스트를 흉내 (메시 순서)
+		for (TArray<FMeshBatchElement>& Batches : Scene.PassBatches)
+		{
+			std::stable_sort(Batches.begin(), Batches.end(), [](const FMeshBatchElement& A, const FMeshBatchElement& B) { return A.VertexBuffer < B.VertexBuffer; });
+		}
+	}
+
+	FMeshDrawRecordContext MakeContext(bool bUseConstantBlocks)
+	{
+		FMeshDrawRecordContext Context;
+		Context.DefaultSampler = FakePointer<ID3D11SamplerState>(8, 0);
+		Context.ShadowSampler = FakePointer<ID3D11SamplerState>(8, 1);
+		Context.VSMSampler = FakePointer<ID3D11SamplerState>(8, 2);
+		Context.bUseConstantBlocks = bUseConstantBlocks;
+		return Context;
+	}
+
+	void TestRecordedPasses(const FTestScene& Scene)
+	{
+		int32 NumInvalidSeen = 0;
+		for (const TArray<FMeshBatchElement>& Batches : Scene.PassBatches)
+		{
+			FMeshPassRecording BlockRecording;
+			BlockRecording.Record(Batches, MakeContext(true));
+			FMeshPassRecording LegacyRecording;
+			LegacyRecording.Record(Batches, MakeContext(false));
+
+			int32 NumValid = 0;
+			for (const FMeshBatchElement& Batch : Batches)
+			{
+				const bool bValid = Batch.VertexShader && Batch.PixelShader && Batch.VertexBuffer && Batch.IndexBuffer && Batch.VertexStride > 0 &&
+					!(Batch.bInstancedDraw && Batch.InstanceCount == 0);
+				NumValid += bValid ? 1 : 0;
+			}
+			NumInvalidSeen += Batches.Num() - NumValid;
+
+			const FNullCommandBackend BlockBackend = ExecuteNull(BlockRecording.GetCommands());
+			const FNullCommandBackend LegacyBackend = ExecuteNull(LegacyRecording.GetCommands());
+			const FRHICommandStats& BlockStats = BlockBackend.GetStats();
+			const FRHICommandStats& LegacyStats = LegacyBackend.GetStats();
+			if (BlockStats.NumValidationErrors > 0 || LegacyStats.NumValidationErrors > 0)
+			{
+				std::printf("  validation error: %s%s\n", BlockStats.FirstError.c_str(), LegacyStats.FirstError.c_str());
+			}
+			TEST_CHECK(BlockStats.NumValidationErrors == 0);
+			TEST_CHECK(LegacyStats.NumValidationErrors == 0);
+			TEST_CHECK(BlockRecording.GetNumDraws() == NumValid);
+			TEST_CHECK(BlockStats.NumDraws == static_cast<uint32>(NumValid));
+			TEST_CHECK(LegacyStats.NumDraws == static_cast<uint32>(NumValid));
+
+			// 상수 블록 경로: 링 업로드 1회 + 드로우마다 바인딩, 드로우별 상수 업데이트는 없음
+			TEST_CHECK(BlockStats.NumConstantBlockUploads == 1);
+			TEST_CHECK(BlockStats.GetCount(ERHICommand::BindConstantBlocks) == static_cast<uint32>(NumValid));
+			TEST_CHECK(LegacyStats.GetCount(ERHICommand::BindConstantBlocks) == 0);
+			TEST_CHECK(BlockStats.NumConstantBufferUpdates + static_cast<uint32>(NumValid) * 2 <= LegacyStats.NumConstantBufferUpdates);
+			// 상태 명령은 두 경로가 같음
+			for (ERHICommand Type : { ERHICommand::SetShaders, ERHICommand::SetVertexBuffers, ERHICommand::SetShaderResources, ERHICommand::SetSamplers })
+			{
+				TEST_CHECK(BlockStats.GetCount(Type) == LegacyStats.GetCount(Type));
+			}
+		}
+		TEST_CHECK(NumInvalidSeen == Scene.NumInvalid && Scene.NumInvalid > 0);
+	}
+
+	struct FPassStreams
+	{
+		TArray<TArray<uint64>> Streams;
+		TArray<int32> NumDraws;
+	};
+
+	FPassStreams CaptureStreams(const TArray<FMeshPassRecording>& Recordings)
+	{
+		FPassStreams Result;
+		for (const FMeshPassRecording& Recording : Recordings)
+		{
+			FCaptureCommandBackend Capture;
+			Capture.Execute(Recording.GetCommands());
+			Result.Streams.Add(Capture.GetStream());
+			Result.NumDraws.Add(Recording.GetNumDraws());
+		}
+		return Result;
+	}
+
+	FPassStreams RecordSerial(const FTestScene& Scene, bool bUseConstantBlocks)
+	{
+		TArray<FMeshPassRecording> Recordings(Scene.PassBatches.Num());
+		const FMeshDrawRecordContext Context = MakeContext(bUseConstantBlocks);
+		for (int32 Pass = 0; Pass < Scene.PassBatches.Num(); ++Pass)
+		{
+			Recordings[Pass].Record(Scene.PassBatches[Pass], Context);
+		}
+		return CaptureStreams(Recordings);
+	}
+
+	FPassStreams RecordParallel(const FTestScene& Scene, bool bUseConstantBlocks)
+	{
+		TArray<FMeshPassRecording> Recordings(Scene.PassBatches.Num());
+		const FMeshDrawRecordContext Context = MakeContext(bUseConstantBlocks);
+		ParallelFor(Scene.PassBatches.Num(), [&](int32 Pass)
+		{
+			Recordings[Pass].Record(Scene.PassBatches[Pass], Context);
+		}, 1);
+		return CaptureStreams(Recordings);
+	}
+
+	bool IsSameStreams(const FPassStreams& A, const FPassStreams& B)
+	{
+		return A.Streams == B.Streams && A.NumDraws == B.NumDraws;
+	}
+}
+
+int main()
+{
+	TestRecordAndReplay();
+	TestValidation();
+
+	FTestScene Scene;
+	MakeScene(Scene, 20000, 4, 1234);
+	TestRecordedPasses(Scene);
+	const FPassStreams SerialBlocks = RecordSerial(Scene, true);
+	const FPassStreams SerialLegacy = RecordSerial(Scene, false);
+
+	FTaskGraph::GetInstance().Initialize(4);
+
+	// 같은 리스트를 여러 번 기록해도 (워커 배정이 바뀌어도) 같은 스트림
+	for (int32 Iteration = 0; Iteration < 3; ++Iteration)
+	{
+		TEST_CHECK(IsSameStreams(SerialBlocks, RecordParallel(Scene, true)));
+		TEST_CHECK(IsSameStreams(SerialLegacy, RecordParallel(Scene, false)));
+	}
+
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("RHICommandListTests");
+}
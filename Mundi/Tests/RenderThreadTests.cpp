@@ -0,0 +1,320 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "RenderThread.h"
+#include <atomic>
+#include <thread>
+
+// FRenderThread (UGameEngine 렌더 스레드 모드) 검사
+// - Start 전/Stop 후: EnqueueFrame이 호출 스레드에서 바로 실행되고 그 프레임이 끝난 것으로 기록
+// - 펜스: WaitForFrame(N)이 돌아오면 N번 프레임 작업의 쓰기가 보임, EnqueueFrame은 MaxFramesInFlight 넘게 쌓지 않음
+// - 프레임은 넘긴 순서대로 렌더 스레드 하나에서 실행
+// - 종료 순서: Stop(소멸자 포함)은 큐에 남은 프레임을 모두 실행한 뒤 돌아옴
+// - 대기 펌프: 프레임 작업이 펌프를 기다려도 WaitForFrame/Flush가 끝남
+// - 프레임 시간: EnqueueFrame(N) 뒤 N - MaxFramesInFlight번 시간이 그 프레임 번호로 남아 있음
+//   (렌더 스레드가 N을 끝내도 덮어쓰지 않음), 오래된 프레임은 false
+// 스레드 간 쓰기는 일부러 atomic 없이 펜스에만 기대므로 MUNDI_TESTS_TSAN 빌드에서 순서 보장도 같이 검사됨
+
+namespace
+{
+	void SleepMS(int32 Milliseconds)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(Milliseconds));
+	}
+
+	// 프레임 작업을 막아 두는 문 (테스트 스레드가 열 때까지 렌더 스레드가 기다림)
+	class FGate
+	{
+	public:
+		void Open() { bOpen.store(true, std::memory_order_release); }
+		void Wait() const
+		{
+			while (!bOpen.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+	private:
+		std::atomic<bool> bOpen{ false };
+	};
+
+	// ──────────────────────────────────────────────
+	// 스레드 없이
+	// ──────────────────────────────────────────────
+
+	void TestInlineWithoutThread()
+	{
+		FRenderThread RenderThread;
+		TEST_CHECK(!RenderThread.IsRunning());
+
+		std::thread::id WorkThread;
+		const double WaitMS = RenderThread.EnqueueFrame(1, [&WorkThread]() { WorkThread = std::this_thread::get_id(); });
+		TEST_CHECK(WaitMS == 0.0);
+		TEST_CHECK(WorkThread == std::this_thread::get_id());
+		TEST_CHECK(RenderThread.GetCompletedFrame() == 1);
+		TEST_CHECK(RenderThread.WaitForFrame(1) == 0.0);
+
+		FRenderFrameTiming Timing;
+		TEST_CHECK(RenderThread.GetFrameTiming(1, Timing));
+		TEST_CHECK(Timing.FrameNumber == 1 && Timing.IdleMS == 0.0);
+		TEST_CHECK(!RenderThread.GetFrameTiming(0, Timing));
+		TEST_CHECK(!RenderThread.GetFrameTiming(2, Timing));
+
+		// 작업 없는 프레임도 끝난 것으로 기록
+		RenderThread.EnqueueFrame(2, nullptr);
+		TEST_CHECK(RenderThread.GetCompletedFrame() == 2);
+		RenderThread.Flush();
+	}
+
+	// ──────────────────────────────────────────────
+	// 렌더 스레드
+	// ──────────────────────────────────────────────
+
+	void TestFence()
+	{
+		FRenderThread RenderThread;
+		RenderThread.Start();
+		TEST_CHECK(RenderThread.IsRunning());
+
+		// 펜스 뒤에는 렌더 스레드의 쓰기가 보임 (atomic 아님)
+		int32 Written = 0;
+		std::thread::id WorkThread;
+		RenderThread.EnqueueFrame(1, [&]()
+		{
+			SleepMS(20);
+			Written = 42;
+			WorkThread = std::this_thread::get_id();
+		});
+		const double WaitMS = RenderThread.WaitForFrame(1);
+		TEST_CHECK(Written == 42);
+		TEST_CHECK(WorkThread != std::this_thread::get_id());
+		TEST_CHECK(RenderThread.GetCompletedFrame() == 1);
+		TEST_CHECK(WaitMS > 0.0);
+		TEST_CHECK(RenderThread.WaitForFrame(1) == 0.0);
+
+		// MaxFramesInFlight = 1: 2번을 넘기려면 1번이 끝나야 함
+		static_assert(FRenderThread::MaxFramesInFlight == 1, "Backpressure check assumes one frame in flight");
+		FGate Gate;
+		std::atomic<bool> bFrame3Done{ false };
+		RenderThread.EnqueueFrame(2, [&Gate]() { Gate.Wait(); });
+		std::thread Opener([&Gate]()
+		{
+			SleepMS(20);
+			Gate.Open();
+		});
+		const double BackpressureMS = RenderThread.EnqueueFrame(3, [&bFrame3Done]() { bFrame3Done.store(true); });
+		TEST_CHECK(RenderThread.GetCompletedFrame() >= 2);
+		TEST_CHECK(BackpressureMS > 0.0);
+		Opener.join();
+
+		RenderThread.Flush();
+		TEST_CHECK(RenderThread.GetCompletedFrame() == 3);
+		TEST_CHECK(bFrame3Done.load());
+		RenderThread.Stop();
+		TEST_CHECK(!RenderThread.IsRunning());
+	}
+
+	void TestFrameOrder()
+	{
+		constexpr int32 NumFrames = 500;
+		FRenderThread RenderThread;
+		RenderThread.Start();
+
+		TArray<uint64> Executed;
+		std::thread::id FirstThread;
+		bool bSingleThread = true;
+		for (uint64 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			RenderThread.EnqueueFrame(Frame, [&, Frame]()
+			{
+				if (Executed.IsEmpty())
+				{
+					FirstThread = std::this_thread::get_id();
+				}
+				bSingleThread &= FirstThread == std::this_thread::get_id();
+				Executed.Add(Frame);
+			});
+		}
+		RenderThread.Flush();
+
+		bool bInOrder = Executed.Num() == NumFrames;
+		for (int32 Index = 0; bInOrder && Index < NumFrames; ++Index)
+		{
+			bInOrder = Executed[Index] == static_cast<uint64>(Index + 1);
+		}
+		TEST_CHECK(bInOrder);
+		TEST_CHECK(bSingleThread);
+		RenderThread.Stop();
+	}
+
+	void TestShutdownOrdering()
+	{
+		// Stop은 남은 프레임을 순서대로 모두 실행한 뒤 돌아옴
+		TArray<uint64> Executed;
+		{
+			FRenderThread RenderThread;
+			RenderThread.Start();
+			for (uint64 Frame = 1; Frame <= 20; ++Frame)
+			{
+				RenderThread.EnqueueFrame(Frame, [&Executed, Frame]()
+				{
+					SleepMS(1);
+					Executed.Add(Frame);
+				});
+			}
+			RenderThread.Stop();
+			TEST_CHECK(!RenderThread.IsRunning());
+			TEST_CHECK(RenderThread.GetCompletedFrame() == 20);
+			TEST_CHECK(Executed.Num() == 20);
+			TEST_CHECK(!Executed.IsEmpty() && Executed.back() == 20);
+
+			// Stop 뒤에는 호출 스레드에서 바로 실행, 다시 Start하면 스레드에서
+			std::thread::id WorkThread;
+			RenderThread.EnqueueFrame(21, [&WorkThread]() { WorkThread = std::this_thread::get_id(); });
+			TEST_CHECK(WorkThread == std::this_thread::get_id());
+			TEST_CHECK(RenderThread.GetCompletedFrame() == 21);
+
+			RenderThread.Start();
+			RenderThread.EnqueueFrame(22, [&WorkThread]() { WorkThread = std::this_thread::get_id(); });
+			RenderThread.WaitForFrame(22);
+			TEST_CHECK(WorkThread != std::this_thread::get_id());
+
+			// 소멸자도 Stop과 같음: 막혀 있던 프레임까지 끝내고 종료
+			RenderThread.EnqueueFrame(23, [&Executed]()
+			{
+				SleepMS(20);
+				Executed.Add(23);
+			});
+		}
+		TEST_CHECK(Executed.Num() == 21);
+		TEST_CHECK(!Executed.IsEmpty() && Executed.back() == 23);
+
+		// 마지막 프레임을 넘기자마자 Stop (렌더 스레드가 아직 꺼내지 않은 프레임이 큐에 남는 경우)
+		bool bAllExecuted = true;
+		for (int32 Iteration = 0; Iteration < 500; ++Iteration)
+		{
+			FRenderThread RenderThread;
+			RenderThread.Start();
+			int32 NumExecuted = 0;
+			for (uint64 Frame = 1; Frame <= 3; ++Frame)
+			{
+				RenderThread.EnqueueFrame(Frame, [&NumExecuted]() { ++NumExecuted; });
+			}
+			RenderThread.Stop();
+			bAllExecuted &= NumExecuted == 3 && RenderThread.GetCompletedFrame() == 3;
+		}
+		TEST_CHECK(bAllExecuted);
+
+		// 한 번도 Start하지 않은 스레드의 Stop/소멸
+		FRenderThread Idle;
+		Idle.Stop();
+		TEST_CHECK(!Idle.IsRunning());
+	}
+
+	void TestWaitPump()
+	{
+		// 렌더 스레드 작업이 게임 스레드 펌프를 기다리는 경우 (Present가 창 스레드 메시지를 기다리는 것과 같음)
+		FRenderThread RenderThread;
+		std::atomic<int32> NumPumps{ 0 };
+		std::thread::id PumpThread;
+		RenderThread.SetWaitPump([&]()
+		{
+			PumpThread = std::this_thread::get_id();
+			NumPumps.fetch_add(1);
+		});
+		RenderThread.Start();
+
+		for (uint64 Frame = 1; Frame <= 5; ++Frame)
+		{
+			const int32 PumpsBefore = NumPumps.load();
+			RenderThread.EnqueueFrame(Frame, [&NumPumps, PumpsBefore]()
+			{
+				while (NumPumps.load() <= PumpsBefore)
+				{
+					std::this_thread::yield();
+				}
+			});
+			RenderThread.WaitForFrame(Frame);
+		}
+		TEST_CHECK(RenderThread.GetCompletedFrame() == 5);
+		TEST_CHECK(NumPumps.load() >= 5);
+		TEST_CHECK(PumpThread == std::this_thread::get_id());
+
+		const int32 PumpsBefore = NumPumps.load();
+		RenderThread.EnqueueFrame(6, [&NumPumps, PumpsBefore]()
+		{
+			while (NumPumps.load() <= PumpsBefore)
+			{
+				std::this_thread::yield();
+			}
+		});
+		RenderThread.Flush();
+		TEST_CHECK(RenderThread.GetCompletedFrame() == 6);
+		RenderThread.Stop();
+	}
+
+	void TestFrameTiming()
+	{
+		FRenderThread RenderThread;
+		RenderThread.Start();
+
+		// UGameEngine::MainLoop처럼 EnqueueFrame(N) 뒤 N - 1번 시간을 읽음. 렌더 스레드는 그동안 N을 끝낼 수 있음
+		constexpr uint64 NumFrames = 200;
+		bool bTimingAvailable = true;
+		bool bFrameNumbersMatch = true;
+		bool bWorkMeasured = true;
+		for (uint64 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			const bool bSlowFrame = Frame % 50 == 0;
+			RenderThread.EnqueueFrame(Frame, [bSlowFrame]()
+			{
+				if (bSlowFrame)
+				{
+					SleepMS(10);
+				}
+			});
+			if (Frame <= FRenderThread::MaxFramesInFlight)
+			{
+				continue;
+			}
+
+			const uint64 TimedFrame = Frame - FRenderThread::MaxFramesInFlight;
+			FRenderFrameTiming Timing;
+			bTimingAvailable &= RenderThread.GetFrameTiming(TimedFrame, Timing);
+			bFrameNumbersMatch &= Timing.FrameNumber == TimedFrame;
+			if (TimedFrame % 50 == 0)
+			{
+				bWorkMeasured &= Timing.WorkMS >= 5.0;
+			}
+		}
+		TEST_CHECK(bTimingAvailable);
+		TEST_CHECK(bFrameNumbersMatch);
+		TEST_CHECK(bWorkMeasured);
+
+		// 끝난 뒤에도 최근 MaxFramesInFlight + 1 프레임은 남고, 그보다 오래된 프레임은 false
+		RenderThread.Flush();
+		FRenderFrameTiming Timing;
+		TEST_CHECK(RenderThread.GetFrameTiming(NumFrames, Timing) && Timing.FrameNumber == NumFrames);
+		TEST_CHECK(RenderThread.GetFrameTiming(NumFrames - 1, Timing) && Timing.FrameNumber == NumFrames - 1);
+		TEST_CHECK(!RenderThread.GetFrameTiming(NumFrames - 2, Timing));
+		TEST_CHECK(!RenderThread.GetFrameTiming(NumFrames + 1, Timing));
+
+		// 렌더 스레드가 다음 프레임을 기다린 시간
+		SleepMS(20);
+		RenderThread.EnqueueFrame(NumFrames + 1, nullptr);
+		RenderThread.Flush();
+		TEST_CHECK(RenderThread.GetFrameTiming(NumFrames + 1, Timing) && Timing.IdleMS >= 10.0);
+		RenderThread.Stop();
+	}
+}
+
+int main()
+{
+	TestInlineWithoutThread();
+	TestFence();
+	TestFrameOrder();
+	TestShutdownOrdering();
+	TestWaitPump();
+	TestFrameTiming();
+	return MundiTest::Finish("RenderThreadTests");
+}
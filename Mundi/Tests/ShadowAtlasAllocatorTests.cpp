@@ -0,0 +1,579 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "ShadowAtlasAllocator.h"
+#include "LightManager.h"
+#include "PlatformTime.h"
+#include <random>
+
+// 2D 섀도우 아틀라스 할당기(FShadowAtlasAllocator) 검사
+// - 매 프레임 불변식: 할당된 블록과 빈 블록이 겹치지 않고 아틀라스를 빈틈 없이 덮음 (블록은 크기에 정렬, 범위 안)
+//   요청 영역(AtlasViewportOffset, Size)은 자기 블록 안
+// - 고정 요청: 4096 블록 4개가 네 사분면, 다음 프레임에 위치 유지, 빠진 라이트 자리를 새 라이트가 씀,
+//   중요도 변화는 ResizeDelayFrames 프레임 뒤에만 블록에 반영되고 축소/확대는 같은 원점 유지,
+//   면적이 넘치면 중요도 낮은 요청부터 줄여 버리지 않음
+// - 처닝: 라이트가 생기고 사라지고 중요도가 흔들리는 600 프레임 (48 / 200 슬롯, 시드 3개)
+//   겹침 0, 버림 0, 단편화로 예산보다 작게 받은 상태가 ResizeDelayFrames 프레임 넘게 이어지지 않음,
+//   마지막 200 프레임의 평균 단편화(1 - 가장 큰 빈 블록 / 빈 면적) 상한
+// - 모두 해제: 처닝 뒤 빈 요청으로 Allocate하면 빈 블록이 루트 하나로 합쳐지고 라이트 기록이 비어 있음
+// - --bench: 같은 요청 시퀀스를 변경 전 셸프 패킹(매 프레임 크기순 정렬, 넘치면 버림)과 비교한 버림/이동 수와 할당 시간
+
+struct FShadowAtlasAllocatorTestAccess
+{
+	// 블록 하나 (원점, 한 변 길이)
+	struct FBlock
+	{
+		uint32 X = 0;
+		uint32 Y = 0;
+		uint32 Size = 0;
+	};
+
+	static void GetBlocks(const FShadowAtlasAllocator& Allocator, TArray<FBlock>& OutAllocated, TArray<FBlock>& OutFree)
+	{
+		OutAllocated.Empty();
+		OutFree.Empty();
+		for (const auto& Pair : Allocator.Records)
+		{
+			for (const FShadowAtlasAllocator::FAtlasRecord& Record : Pair.second)
+			{
+				if (Record.Level >= 0)
+				{
+					OutAllocated.Add({ Record.Key & 0xFFFFu, Record.Key >> 16, Allocator.GetBlockSize(Record.Level) });
+				}
+			}
+		}
+		for (int32 Level = 0; Level < Allocator.FreeLists.Num(); ++Level)
+		{
+			for (uint32 Key : Allocator.FreeLists[Level])
+			{
+				OutFree.Add({ Key & 0xFFFFu, Key >> 16, Allocator.GetBlockSize(Level) });
+			}
+		}
+	}
+
+	static const TArray<TArray<uint32>>& GetFreeLists(const FShadowAtlasAllocator& Allocator) { return Allocator.FreeLists; }
+	static size_t GetNumLightRecords(const FShadowAtlasAllocator& Allocator) { return Allocator.Records.size(); }
+	static uint32 GetFragmentedFrames(const FShadowAtlasAllocator& Allocator) { return Allocator.FragmentedFrames; }
+	static uint32 GetMinBlockSize(const FShadowAtlasAllocator& Allocator) { return Allocator.MinBlockSize; }
+};
+
+namespace
+{
+	using FBlock = FShadowAtlasAllocatorTestAccess::FBlock;
+
+	// 테스트용 라이트 키 (할당기는 키를 역참조하지 않음)
+	ULightComponent* MakeLightKey(uint32 Slot)
+	{
+		return reinterpret_cast<ULightComponent*>(static_cast<uintptr_t>(Slot + 1));
+	}
+
+	FShadowRenderRequest MakeRequest(uint32 Slot, uint32 Size, float Importance, int32 SubViewIndex = 0)
+	{
+		FShadowRenderRequest Request;
+		Request.LightOwner = MakeLightKey(Slot);
+		Request.Size = Size;
+		Request.SubViewIndex = SubViewIndex;
+		Request.ScreenImportance = Importance;
+		return Request;
+	}
+
+	struct FInvariantResult
+	{
+		int32 NumOverlaps = 0;			// 두 블록이 덮은 최소 블록 칸
+		int32 NumUncovered = 0;			// 어느 블록도 덮지 않은 최소 블록 칸
+		int32 NumBadBlocks = 0;			// 범위 밖 또는 크기에 정렬되지 않은 블록
+		int32 NumBadRequests = 0;		// 영역이 자기 블록 밖인 요청 (또는 할당된 요청 수와 블록 수가 다름)
+	};
+
+	/** 할당/빈 블록을 최소 블록 격자에 칠해 겹침과 빈틈을 셈 */
+	FInvariantResult CheckInvariants(const FShadowAtlasAllocator& Allocator, const TArray<FShadowRenderRequest>& Requests)
+	{
+		FInvariantResult Result;
+		const uint32 AtlasSize = Allocator.GetAtlasSize();
+		const uint32 Cell = FShadowAtlasAllocatorTestAccess::GetMinBlockSize(Allocator);
+		const uint32 GridSize = AtlasSize / Cell;
+
+		TArray<FBlock> Allocated;
+		TArray<FBlock> Free;
+		FShadowAtlasAllocatorTestAccess::GetBlocks(Allocator, Allocated, Free);
+
+		TArray<uint8> Coverage;
+		Coverage.SetNum(GridSize * GridSize);
+		std::fill(Coverage.begin(), Coverage.end(), uint8(0));
+		auto Paint = [&](const FBlock& Block)
+		{
+			if (Block.Size < Cell || Block.X % Block.Size != 0 || Block.Y % Block.Size != 0 ||
+				Block.X + Block.Size > AtlasSize || Block.Y + Block.Size > AtlasSize)
+			{
+				++Result.NumBadBlocks;
+				return;
+			}
+			for (uint32 Y = Block.Y / Cell; Y < (Block.Y + Block.Size) / Cell; ++Y)
+			{
+				for (uint32 X = Block.X / Cell; X < (Block.X + Block.Size) / Cell; ++X)
+				{
+					uint8& Count = Coverage[Y * GridSize + X];
+					Result.NumOverlaps += Count > 0 ? 1 : 0;
+					Count = uint8(std::min(Count + 1, 255));
+				}
+			}
+		};
+		for (const FBlock& Block : Allocated)
+		{
+			Paint(Block);
+		}
+		for (const FBlock& Block : Free)
+		{
+			Paint(Block);
+		}
+		for (uint8 Count : Coverage)
+		{
+			Result.NumUncovered += Count == 0 ? 1 : 0;
+		}
+
+		// 요청 영역은 할당된 블록 중 하나 안 (블록끼리 겹치지 않으므로 요청끼리도 겹치지 않음)
+		int32 NumAllocatedRequests = 0;
+		for (const FShadowRenderRequest& Request : Requests)
+		{
+			if (Request.Size == 0)
+			{
+				continue;
+			}
+			++NumAllocatedRequests;
+			const uint32 X = static_cast<uint32>(Request.AtlasViewportOffset.X);
+			const uint32 Y = static_cast<uint32>(Request.AtlasViewportOffset.Y);
+			const bool bInsideBlock = std::any_of(Allocated.begin(), Allocated.end(), [&](const FBlock& Block)
+			{
+				return X == Block.X && Y == Block.Y && Request.Size <= Block.Size;
+			});
+			Result.NumBadRequests += bInsideBlock ? 0 : 1;
+		}
+		Result.NumBadRequests += NumAllocatedRequests != Allocated.Num() ? 1 : 0;
+		return Result;
+	}
+
+	bool IsInvariantClean(const FInvariantResult& Result)
+	{
+		return Result.NumOverlaps == 0 && Result.NumUncovered == 0 && Result.NumBadBlocks == 0 && Result.NumBadRequests == 0;
+	}
+
+	// (X, Y) 원점에 할당된 블록의 크기 (없으면 0)
+	uint32 FindBlockSize(const FShadowAtlasAllocator& Allocator, uint32 X, uint32 Y)
+	{
+		TArray<FBlock> Allocated;
+		TArray<FBlock> Free;
+		FShadowAtlasAllocatorTestAccess::GetBlocks(Allocator, Allocated, Free);
+		for (const FBlock& Block : Allocated)
+		{
+			if (Block.X == X && Block.Y == Y)
+			{
+				return Block.Size;
+			}
+		}
+		return 0;
+	}
+
+	bool IsSingleFreeRoot(const FShadowAtlasAllocator& Allocator)
+	{
+		const TArray<TArray<uint32>>& FreeLists = FShadowAtlasAllocatorTestAccess::GetFreeLists(Allocator);
+		if (FreeLists.IsEmpty() || FreeLists[0].Num() != 1 || FreeLists[0][0] != 0)
+		{
+			return false;
+		}
+		for (int32 Level = 1; Level < FreeLists.Num(); ++Level)
+		{
+			if (!FreeLists[Level].IsEmpty())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// ──────────────────────────────────────────────
+	// 고정 요청
+	// ──────────────────────────────────────────────
+
+	void TestFixtureRequests()
+	{
+		FShadowAtlasAllocator Allocator;
+		Allocator.Initialize(8192);
+		TEST_CHECK(Allocator.GetAtlasSize() == 8192);
+		TEST_CHECK(IsSingleFreeRoot(Allocator));
+
+		// 4096 블록 4개는 위/왼쪽부터 네 사분면
+		TArray<FShadowRenderRequest> Requests;
+		for (uint32 Slot = 0; Slot < 4; ++Slot)
+		{
+			Requests.Add(MakeRequest(Slot, 4096, 1.0f));
+		}
+		Allocator.Allocate(Requests);
+		const float ExpectedX[4] = { 0.0f, 4096.0f, 0.0f, 4096.0f };
+		const float ExpectedY[4] = { 0.0f, 0.0f, 4096.0f, 4096.0f };
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			TEST_CHECK(Requests[Index].Size == 4096);
+			TEST_CHECK(Requests[Index].AtlasViewportOffset.X == ExpectedX[Index]);
+			TEST_CHECK(Requests[Index].AtlasViewportOffset.Y == ExpectedY[Index]);
+		}
+		TEST_CHECK(Allocator.GetStats().NumNew == 4);
+		TEST_CHECK(Allocator.GetStats().UsedPercent == 100.0f);
+		TEST_CHECK(IsInvariantClean(CheckInvariants(Allocator, Requests)));
+
+		// 같은 요청은 위치 유지
+		Allocator.Allocate(Requests);
+		TEST_CHECK(Allocator.GetStats().NumNew == 0);
+		TEST_CHECK(Allocator.GetStats().NumRelocated == 0);
+		TEST_CHECK(Requests[3].AtlasViewportOffset.X == 4096.0f && Requests[3].AtlasViewportOffset.Y == 4096.0f);
+
+		// 라이트 1이 빠지면 그 자리를 새 라이트 4가 받음 (나머지는 그대로)
+		Requests.Empty();
+		Requests.Add(MakeRequest(0, 4096, 1.0f));
+		Requests.Add(MakeRequest(2, 4096, 1.0f));
+		Requests.Add(MakeRequest(3, 4096, 1.0f));
+		Requests.Add(MakeRequest(4, 4096, 1.0f));
+		Allocator.Allocate(Requests);
+		TEST_CHECK(Allocator.GetStats().NumNew == 1);
+		TEST_CHECK(Allocator.GetStats().NumRelocated == 0);
+		TEST_CHECK(Requests[3].AtlasViewportOffset.X == 4096.0f && Requests[3].AtlasViewportOffset.Y == 0.0f);
+		TEST_CHECK(IsInvariantClean(CheckInvariants(Allocator, Requests)));
+
+		// 같은 서브뷰 중복 요청은 하나만 받음
+		Requests.Add(MakeRequest(4, 4096, 1.0f));
+		Allocator.Allocate(Requests);
+		TEST_CHECK(Requests[4].Size == 0);
+		TEST_CHECK(Allocator.GetStats().NumAllocated == 4);
+		Requests.pop_back();
+
+		// 요청은 매 프레임 새로 만듦 (Allocate가 Size를 렌더 크기로 덮어씀)
+		auto AllocateFrame = [&](float Importance0)
+		{
+			Requests.Empty();
+			Requests.Add(MakeRequest(0, 4096, Importance0));
+			Requests.Add(MakeRequest(2, 4096, 1.0f));
+			Requests.Add(MakeRequest(3, 4096, 1.0f));
+			Requests.Add(MakeRequest(4, 4096, 1.0f));
+			Allocator.Allocate(Requests);
+		};
+
+		// 라이트 0의 중요도가 0.3이면 렌더 크기는 바로 2048이지만 블록은 ResizeDelayFrames 프레임 동안 4096 유지
+		for (uint32 Frame = 1; Frame < FShadowAtlasAllocator::ResizeDelayFrames; ++Frame)
+		{
+			AllocateFrame(0.3f);
+			TEST_CHECK(Requests[0].Size == 2048);
+			TEST_CHECK(FindBlockSize(Allocator, 0, 0) == 4096);
+			TEST_CHECK(Allocator.GetStats().NumResized == 0);
+		}
+		AllocateFrame(0.3f);
+		TEST_CHECK(FindBlockSize(Allocator, 0, 0) == 2048);
+		TEST_CHECK(Requests[0].AtlasViewportOffset.X == 0.0f && Requests[0].AtlasViewportOffset.Y == 0.0f);
+		TEST_CHECK(Allocator.GetStats().NumResized == 1);
+		TEST_CHECK(Allocator.GetStats().NumRelocated == 0);
+		TEST_CHECK(IsInvariantClean(CheckInvariants(Allocator, Requests)));
+
+		// 중요도가 돌아오면 같은 지연 뒤 같은 원점에서 다시 키움 (형제 블록이 비어 있음)
+		for (uint32 Frame = 1; Frame < FShadowAtlasAllocator::ResizeDelayFrames; ++Frame)
+		{
+			AllocateFrame(1.0f);
+			TEST_CHECK(Requests[0].Size == 2048);
+		}
+		AllocateFrame(1.0f);
+		TEST_CHECK(Requests[0].Size == 4096);
+		TEST_CHECK(FindBlockSize(Allocator, 0, 0) == 4096);
+		TEST_CHECK(Requests[0].AtlasViewportOffset.X == 0.0f && Requests[0].AtlasViewportOffset.Y == 0.0f);
+		TEST_CHECK(Allocator.GetStats().NumRelocated == 0);
+		TEST_CHECK(IsInvariantClean(CheckInvariants(Allocator, Requests)));
+
+		// 경계에서 흔들리는 중요도는 블록을 바꾸지 않음
+		for (uint32 Frame = 0; Frame < 4 * FShadowAtlasAllocator::ResizeDelayFrames; ++Frame)
+		{
+			AllocateFrame(Frame % 2 == 0 ? 0.49f : 0.51f);
+			TEST_CHECK(Allocator.GetStats().NumResized == 0);
+		}
+
+		// 모두 해제하면 루트 하나로 합쳐짐
+		Requests.Empty();
+		Allocator.Allocate(Requests);
+		TEST_CHECK(IsSingleFreeRoot(Allocator));
+		TEST_CHECK(FShadowAtlasAllocatorTestAccess::GetNumLightRecords(Allocator) == 0);
+
+		// 2의 거듭제곱이 아닌 텍스처는 할당 영역을 내림, UV는 실제 텍스처 크기 기준
+		Allocator.Initialize(6000);
+		TEST_CHECK(Allocator.GetAtlasSize() == 4096);
+		Requests.Add(MakeRequest(0, 2048, 1.0f));
+		Requests.Add(MakeRequest(1, 2048, 1.0f));
+		Allocator.Allocate(Requests);
+		TEST_CHECK(Requests[1].AtlasViewportOffset.X == 2048.0f);
+		TEST_CHECK(Requests[1].AtlasScaleOffset.X == 2048.0f / 6000.0f);
+		TEST_CHECK(Requests[1].AtlasScaleOffset.Z == 2048.0f / 6000.0f);
+	}
+
+	void TestOversubscribedFixture()
+	{
+		// 4096 블록 8개 (면적 2배): 중요도가 낮은 넷부터, 그다음 높은 요청 순서대로 한 단계씩 줄여 면적을 맞춤
+		// (낮은 넷 → 80M, 높은 0번 → 68M, 높은 1번 → 56M <= 64M). 버리는 요청 없음
+		FShadowAtlasAllocator Allocator;
+		Allocator.Initialize(8192);
+		TArray<FShadowRenderRequest> Requests;
+		for (uint32 Slot = 0; Slot < 8; ++Slot)
+		{
+			Requests.Add(MakeRequest(Slot, 4096, Slot < 4 ? 1.0f : 0.6f));
+		}
+		Allocator.Allocate(Requests);
+		TEST_CHECK(Allocator.GetStats().NumDropped == 0);
+		TEST_CHECK(Allocator.GetStats().NumAllocated == 8);
+		TEST_CHECK(Allocator.GetStats().NumDegraded == 6);
+		TEST_CHECK(Allocator.GetStats().UsedPercent == 87.5f);
+		const uint32 ExpectedSize[8] = { 2048, 2048, 4096, 4096, 2048, 2048, 2048, 2048 };
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			TEST_CHECK(Requests[Index].Size == ExpectedSize[Index]);
+		}
+		TEST_CHECK(IsInvariantClean(CheckInvariants(Allocator, Requests)));
+	}
+
+	// ──────────────────────────────────────────────
+	// 처닝 시뮬레이션
+	// ──────────────────────────────────────────────
+
+	// 0번: 캐스케이드 4개 Directional (항상 켜짐), 나머지: Spot이 무작위로 켜지고 꺼지며 중요도가 바뀜
+	class FChurnScene
+	{
+	public:
+		FChurnScene(uint32 InMaxLights, uint32 Seed)
+			: MaxLights(InMaxLights), Rng(Seed), Unit(0.0f, 1.0f), Drift(0.0f, 0.03f)
+		{
+			Lights.SetNum(MaxLights);
+			Lights[0].bActive = true;
+			Lights[0].Size = 2048;
+			for (uint32 LightIndex = 1; LightIndex < MaxLights; ++LightIndex)
+			{
+				Lights[LightIndex].bActive = Unit(Rng) < 0.5f;
+				Lights[LightIndex].Size = SpotSizes[Rng() % 3];
+				Lights[LightIndex].Importance = Unit(Rng);
+			}
+		}
+
+		// 라이트 생성/제거와 중요도 변화 (가끔 카메라 컷처럼 크게 바뀜) 후 이번 프레임 요청
+		void Step(TArray<FShadowRenderRequest>& OutRequests)
+		{
+			for (uint32 LightIndex = 1; LightIndex < MaxLights; ++LightIndex)
+			{
+				FSimLight& Light = Lights[LightIndex];
+				if (!Light.bActive)
+				{
+					if (Unit(Rng) < 0.02f)
+					{
+						Light.bActive = true;
+						Light.Size = SpotSizes[Rng() % 3];
+						Light.Importance = Unit(Rng);
+					}
+					continue;
+				}
+
+				if (Unit(Rng) < 0.02f)
+				{
+					Light.bActive = false;
+					continue;
+				}
+				Light.Importance = Unit(Rng) < 0.005f ? Unit(Rng) : FMath::Clamp(Light.Importance + Drift(Rng), 0.0f, 1.0f);
+			}
+
+			OutRequests.Empty();
+			for (uint32 LightIndex = 0; LightIndex < MaxLights; ++LightIndex)
+			{
+				const FSimLight& Light = Lights[LightIndex];
+				if (!Light.bActive)
+				{
+					continue;
+				}
+
+				const uint32 NumViews = LightIndex == 0 ? NumCascades : 1;
+				for (uint32 SubView = 0; SubView < NumViews; ++SubView)
+				{
+					OutRequests.Add(MakeRequest(LightIndex, Light.Size, Light.Importance, static_cast<int32>(SubView)));
+				}
+			}
+		}
+
+	private:
+		struct FSimLight
+		{
+			bool bActive = false;
+			uint32 Size = 1024;
+			float Importance = 1.0f;
+		};
+
+		static constexpr uint32 SpotSizes[3] = { 512, 1024, 2048 };
+		static constexpr uint32 NumCascades = 4;
+
+		uint32 MaxLights;
+		std::mt19937 Rng;
+		std::uniform_real_distribution<float> Unit;
+		std::normal_distribution<float> Drift;
+		TArray<FSimLight> Lights;
+	};
+
+	void TestChurn(uint32 MaxLights, uint32 Seed, float MaxLateFragmentation)
+	{
+		constexpr uint32 NumFrames = 600;
+		constexpr uint32 LateFrames = 200;	// 단편화 평균은 처닝이 충분히 쌓인 마지막 구간만
+		FShadowAtlasAllocator Allocator;
+		Allocator.Initialize(8192);
+		FChurnScene Scene(MaxLights, Seed);
+
+		TArray<FShadowRenderRequest> Requests;
+		int32 NumBadFrames = 0;
+		uint64 NumRequests = 0;
+		uint64 NumDropped = 0;
+		uint32 NumRepacks = 0;
+		uint32 MaxFragmentedFrames = 0;
+		double LateFragmentationSum = 0.0;
+		for (uint32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Scene.Step(Requests);
+			Allocator.Allocate(Requests);
+
+			const FShadowAtlasAllocStats& Stats = Allocator.GetStats();
+			NumRequests += Requests.Num();
+			NumDropped += Stats.NumDropped;
+			NumRepacks += Stats.NumRepacks;
+			LateFragmentationSum += Frame >= NumFrames - LateFrames ? Stats.Fragmentation : 0.0f;
+			MaxFragmentedFrames = std::max(MaxFragmentedFrames, FShadowAtlasAllocatorTestAccess::GetFragmentedFrames(Allocator));
+
+			const FInvariantResult Invariants = CheckInvariants(Allocator, Requests);
+			if (!IsInvariantClean(Invariants))
+			{
+				if (NumBadFrames == 0)
+				{
+					std::printf("  frame %u: overlaps %d, uncovered %d, bad blocks %d, bad requests %d\n", Frame,
+						Invariants.NumOverlaps, Invariants.NumUncovered, Invariants.NumBadBlocks, Invariants.NumBadRequests);
+				}
+				++NumBadFrames;
+			}
+		}
+
+		const float LateFragmentation = static_cast<float>(LateFragmentationSum / LateFrames);
+		std::printf("  %u slots, seed %u: %llu requests, %llu dropped, %u repacks, late fragmentation avg %.3f, longest fragmented run %u frames\n",
+			MaxLights, Seed, static_cast<unsigned long long>(NumRequests), static_cast<unsigned long long>(NumDropped), NumRepacks,
+			LateFragmentation, MaxFragmentedFrames);
+		TEST_CHECK(NumBadFrames == 0);
+		TEST_CHECK(NumDropped == 0);
+		// 단편화로 예산보다 작게 받은 상태는 ResizeDelayFrames 프레임 안에 전체 재배치로 끝남
+		TEST_CHECK(MaxFragmentedFrames < FShadowAtlasAllocator::ResizeDelayFrames);
+		// Fragmentation = 1 - 가장 큰 빈 블록 / 빈 면적. 빈 공간이 여러 블록으로 나뉘는 것은 정상이라 0이 아니지만 쌓이지 않아야 함
+		TEST_CHECK(LateFragmentation <= MaxLateFragmentation);
+
+		// 모두 해제: 버디 병합으로 루트 블록 하나만 남음
+		Requests.Empty();
+		Allocator.Allocate(Requests);
+		TEST_CHECK(IsSingleFreeRoot(Allocator));
+		TEST_CHECK(FShadowAtlasAllocatorTestAccess::GetNumLightRecords(Allocator) == 0);
+		TEST_CHECK(Allocator.GetStats().Fragmentation == 0.0f);
+	}
+
+	// ──────────────────────────────────────────────
+	// 벤치마크
+	// ──────────────────────────────────────────────
+
+	// 요청마다 (라이트, 서브뷰) 키로 직전 프레임 영역과 비교해 크기가 그대로인데 위치만 바뀐 수
+	uint64 CountMoved(const TArray<FShadowRenderRequest>& Requests, TMap<uint64, FVector>& InOutPrev)
+	{
+		TMap<uint64, FVector> Regions;
+		uint64 Moved = 0;
+		for (const FShadowRenderRequest& Request : Requests)
+		{
+			if (Request.Size == 0)
+			{
+				continue;
+			}
+			const FVector Region(Request.AtlasViewportOffset.X, Request.AtlasViewportOffset.Y, static_cast<float>(Request.Size));
+			const uint64 Key = (static_cast<uint64>(reinterpret_cast<uintptr_t>(Request.LightOwner)) << 8) | static_cast<uint64>(Request.SubViewIndex);
+			if (const FVector* Prev = InOutPrev.Find(Key))
+			{
+				Moved += (Prev->Z == Region.Z && (Prev->X != Region.X || Prev->Y != Region.Y)) ? 1 : 0;
+			}
+			Regions[Key] = Region;
+		}
+		InOutPrev.swap(Regions);
+		return Moved;
+	}
+
+	void RunBenchmark()
+	{
+		std::printf("\n[bench] 8192 atlas, 600 frames: buddy allocator vs per-frame shelf packing\n");
+		for (uint32 MaxLights : { 16u, 48u, 200u })
+		{
+			constexpr uint32 NumFrames = 600;
+			FShadowAtlasAllocator Allocator;
+			Allocator.Initialize(8192);
+			FChurnScene Scene(MaxLights, 1234);
+
+			TArray<FShadowRenderRequest> Requests;
+			TArray<FShadowRenderRequest> ShelfRequests;
+			TMap<uint64, FVector> PrevRegions;
+			TMap<uint64, FVector> PrevShelfRegions;
+			uint64 NumDropped = 0, NumDegraded = 0, NumMoved = 0, ShelfDropped = 0, ShelfMoved = 0;
+			uint32 NumRepacks = 0;
+			uint64 TotalCycles = 0;
+			for (uint32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Scene.Step(Requests);
+				ShelfRequests = Requests;
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Allocator.Allocate(Requests);
+				TotalCycles += FPlatformTime::Cycles64() - StartCycles;
+
+				NumDropped += Allocator.GetStats().NumDropped;
+				NumDegraded += Allocator.GetStats().NumDegraded;
+				NumRepacks += Allocator.GetStats().NumRepacks;
+				NumMoved += CountMoved(Requests, PrevRegions);
+
+				// 변경 전: 중요도 없이 요청 크기 그대로 크기순 셸프 패킹
+				ShelfRequests.Sort(std::greater<FShadowRenderRequest>());
+				uint32 ShelfX = 0, ShelfY = 0, ShelfHeight = 0;
+				for (FShadowRenderRequest& Request : ShelfRequests)
+				{
+					if (ShelfX + Request.Size > 8192)
+					{
+						ShelfY += ShelfHeight;
+						ShelfX = 0;
+						ShelfHeight = 0;
+					}
+					if (ShelfY + Request.Size > 8192)
+					{
+						Request.Size = 0;
+						++ShelfDropped;
+						continue;
+					}
+					Request.AtlasViewportOffset = FVector2D(static_cast<float>(ShelfX), static_cast<float>(ShelfY));
+					ShelfX += Request.Size;
+					ShelfHeight = FMath::Max(ShelfHeight, Request.Size);
+				}
+				ShelfMoved += CountMoved(ShelfRequests, PrevShelfRegions);
+			}
+
+			std::printf("  %3u slots: buddy dropped %llu, degraded %llu, moved %llu, repacks %u, %.4f ms/frame | shelf dropped %llu, moved %llu\n",
+				MaxLights, static_cast<unsigned long long>(NumDropped), static_cast<unsigned long long>(NumDegraded),
+				static_cast<unsigned long long>(NumMoved), NumRepacks, FPlatformTime::ToMilliseconds(TotalCycles) / NumFrames,
+				static_cast<unsigned long long>(ShelfDropped), static_cast<unsigned long long>(ShelfMoved));
+		}
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	TestFixtureRequests();
+	TestOversubscribedFixture();
+	for (uint32 Seed : { 1234u, 7u, 99u })
+	{
+		TestChurn(48, Seed, 0.85f);
+		TestChurn(200, Seed, 0.92f);
+	}
+
+	if (MundiTest::HasArg(Argc, Argv, "--bench"))
+	{
+		RunBenchmark();
+	}
+	return MundiTest::Finish("ShadowAtlasAllocatorTests");
+}
@@ -0,0 +1,694 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "ShadowCasterSelection.h"
+#include "ShadowCasterCache.h"
+#include "LightManager.h"
+#include "BVHierarchy.h"
+#include "Actor.h"
+#include "Collision.h"
+#include "OBB.h"
+#include "BoundingSphere.h"
+#include "Picking.h"
+#include "Hash.h"
+#include <cfloat>
+#include <random>
+
+// 섀도우 캐스터 선택(ShadowCasterSelection)과 정적 섀도우 캐시 키(FShadowCasterCache) 검사
+// - 합성 캐스터 (월드 AABB를 테스트가 채운 컴포넌트, 20개 중 1개는 마지막 리빌드 뒤 추가되어 BVH 트리 밖): 스포트/캐스케이드 절두체와
+//   포인트 라이트 6면(반경 구 쿼리 후 면 절두체로 거름)의 선택이 전체 캐스터 전수 검사와 정확히 같음
+//   절두체 판정은 클립 공간 8꼭짓점 판정(CreateFrustumFromViewProjection과 독립)과도 맞음
+// - 고정 캐스터: 앞/뒤/원평면 너머/측면 평면 걸침/측면 밖, 트리 밖 캐스터 앞/뒤, BVH가 없을 때의 선택 결과
+// - 정지 판정: StaticPassThreshold 패스 동안 StateHash가 그대로일 때만 정적, 같은 패스 중복 호출은 세지 않음,
+//   해시가 바뀌면 처음부터, bCanBeStatic == false면 항상 동적, 패스에 없던 캐스터 기록은 EndPass에서 지움
+// - 캐시 키: 정적 캐스터 집합 해시는 순서와 무관하고 동적 캐스터를 무시함
+//   IsEntryUpToDate는 라이트 뷰/투영/위치/반경/정적 집합 중 하나라도 바뀌면 false
+// - 캐시 시나리오: 라이트 이동, 뷰 밖/안 정적 캐스터 이동, 재승격, 정적 → 동적 강등에서 적중 여부가
+//   마지막으로 그린 (라이트 행렬, 정적 캐스터 집합)을 직접 비교한 기대값과 같음
+
+class UMeshComponent : public UPrimitiveComponent
+{
+};
+
+// ──────────────────────────────────────────────
+// 엔진 링크 대역: BVHierarchy.cpp가 참조하지만 Collision.cpp/Picking.cpp는 컴포넌트 전체를 끌어옴
+// ──────────────────────────────────────────────
+
+namespace Collision
+{
+	bool Intersects(const FAABB& Aabb, const FOBB& Obb)
+	{
+		return FOBB(Aabb, FMatrix::Identity()).Intersects(Obb);
+	}
+
+	bool Intersects(const FAABB& Aabb, const FBoundingSphere& Sphere)
+	{
+		float Dist2 = 0.0f;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Clamped = std::clamp(Sphere.Center[Axis], Aabb.Min[Axis], Aabb.Max[Axis]);
+			Dist2 += (Sphere.Center[Axis] - Clamped) * (Sphere.Center[Axis] - Clamped);
+		}
+		return Dist2 <= Sphere.Radius * Sphere.Radius;
+	}
+}
+
+bool CPickingSystem::CheckActorPicking(const AActor*, const FRay&, float&)
+{
+	return false;
+}
+
+namespace
+{
+	// ──────────────────────────────────────────────
+	// 합성 장면
+	// ──────────────────────────────────────────────
+
+	// RenderShadowMaps가 패스마다 만드는 캐스터 목록과 같은 구조 (배치 대신 바운드 비트로 StateHash)
+	struct FTestScene
+	{
+		AActor Owner;	// UpdateBatch는 소유 액터가 없는 컴포넌트를 제거함
+		TArray<UMeshComponent*> Components;
+		TArray<UPrimitiveComponent*> TreeComponents;
+		TArray<UPrimitiveComponent*> LateComponents;	// 리빌드 뒤 UpdateBatch로 추가 (BVH 쿼리가 트리 밖에서 직접 검사)
+		FBVHierarchy BVH{ FAABB() };
+
+		TArray<FShadowCaster> Casters;
+		TMap<UPrimitiveComponent*, int32> CasterIndices;
+		TArray<UPrimitiveComponent*> QueryResults;
+
+		~FTestScene()
+		{
+			for (UMeshComponent* Component : Components)
+			{
+				delete Component;
+			}
+		}
+
+		UMeshComponent* AddComponent(const FAABB& Bounds, bool bInTree)
+		{
+			UMeshComponent* Component = new UMeshComponent();
+			Component->WorldAABB = Bounds;
+			Component->Owner = &Owner;
+			Components.Add(Component);
+			if (bInTree)
+			{
+				TreeComponents.Add(Component);
+			}
+			else
+			{
+				LateComponents.Add(Component);
+			}
+			return Component;
+		}
+
+		void RebuildBVH()
+		{
+			BVH.Clear();
+			BVH.BulkUpdate(TreeComponents);
+			BVH.UpdateBatch(LateComponents);
+		}
+
+		// GatherShadowCasters와 같은 목록 + 정지 판정 (CasterCache가 없으면 모두 동적)
+		void Gather(FShadowCasterCache* CasterCache = nullptr, const TSet<UMeshComponent*>* NeverStatic = nullptr)
+		{
+			if (CasterCache)
+			{
+				CasterCache->BeginPass();
+			}
+			Casters.Empty();
+			CasterIndices.clear();
+			for (UMeshComponent* Component : Components)
+			{
+				FShadowCaster Caster;
+				Caster.Component = Component;
+				Caster.NumBatches = 1;
+				Caster.Bounds = Component->GetWorldAABB();
+				Caster.StateHash = HashBounds(Component, Caster.Bounds);
+				if (CasterCache)
+				{
+					const bool bCanBeStatic = !NeverStatic || !NeverStatic->Contains(Component);
+					Caster.bStatic = CasterCache->UpdateCasterMobility(Component, Caster.StateHash, bCanBeStatic);
+				}
+
+				const int32 CasterIndex = Casters.Add(Caster);
+				CasterIndices[Component] = CasterIndex;
+			}
+			if (CasterCache)
+			{
+				CasterCache->EndPass();
+			}
+		}
+
+		// RenderShadowMaps와 같은 선택: 스포트/캐스케이드는 절두체 쿼리, 포인트는 반경 구 쿼리 후 면 절두체로 거름
+		void SelectViewCasters(const FShadowRenderRequest& Request, bool bPointLight, TArray<int32>& OutCasters)
+		{
+			OutCasters.Empty();
+			const FFrustum Frustum = CreateFrustumFromViewProjection(Request.ViewMatrix * Request.ProjectionMatrix);
+			if (bPointLight)
+			{
+				TArray<int32> LightCasters;
+				QueryShadowCasterIndices(&BVH, FBoundingSphere(Request.WorldLocation, Request.Radius),
+					Casters, CasterIndices, QueryResults, LightCasters);
+				FilterShadowCastersByFrustum(Frustum, Casters, LightCasters, OutCasters);
+			}
+			else
+			{
+				QueryShadowCasterIndices(&BVH, Frustum, Casters, CasterIndices, QueryResults, OutCasters);
+			}
+		}
+
+		static uint64 HashBounds(const UMeshComponent* Component, const FAABB& Bounds)
+		{
+			uint32 Bits[6];
+			std::memcpy(&Bits[0], &Bounds.Min, sizeof(float) * 3);
+			std::memcpy(&Bits[3], &Bounds.Max, sizeof(float) * 3);
+			uint64 Hash = reinterpret_cast<uintptr_t>(Component);
+			for (uint32 Value : Bits)
+			{
+				Hash = HashCombine(Hash, Value);
+			}
+			return Hash;
+		}
+	};
+
+	FAABB MakeBox(const FVector& Center, const FVector& HalfExtent)
+	{
+		return FAABB(Center - HalfExtent, Center + HalfExtent);
+	}
+
+	FAABB OffsetAABB(const FAABB& Bounds, const FVector& Offset)
+	{
+		return FAABB(Bounds.Min + Offset, Bounds.Max + Offset);
+	}
+
+	FShadowRenderRequest MakeSpotRequest(const FVector& Location, const FVector& Direction, float OuterConeDegrees, float Radius)
+	{
+		FShadowRenderRequest Request;
+		const FVector Up = std::abs(Direction.Z) > 0.99f ? FVector(1.0f, 0.0f, 0.0f) : FVector(0.0f, 0.0f, 1.0f);
+		Request.ViewMatrix = FMatrix::LookAtLH(Location, Location + Direction, Up);
+		Request.ProjectionMatrix = FMatrix::PerspectiveFovLH(DegreesToRadians(OuterConeDegrees * 2.0f), 1.0f, 0.5f, Radius);
+		Request.WorldLocation = Location;
+		Request.Radius = Radius;
+		Request.Size = 1024;
+		Request.SubViewIndex = 0;
+		return Request;
+	}
+
+	// 포인트 라이트 큐브 면 (90도, 면마다 SubViewIndex)
+	FShadowRenderRequest MakePointFaceRequest(const FVector& Location, float Radius, int32 Face)
+	{
+		static const FVector Directions[6] = {
+			FVector(1.0f, 0.0f, 0.0f), FVector(-1.0f, 0.0f, 0.0f), FVector(0.0f, 1.0f, 0.0f),
+			FVector(0.0f, -1.0f, 0.0f), FVector(0.0f, 0.0f, 1.0f), FVector(0.0f, 0.0f, -1.0f) };
+		const FVector Up = Face >= 4 ? FVector(1.0f, 0.0f, 0.0f) : FVector(0.0f, 0.0f, 1.0f);
+
+		FShadowRenderRequest Request;
+		Request.ViewMatrix = FMatrix::LookAtLH(Location, Location + Directions[Face], Up);
+		Request.ProjectionMatrix = FMatrix::PerspectiveFovLH(DegreesToRadians(90.0f), 1.0f, 0.1f, Radius);
+		Request.WorldLocation = Location;
+		Request.Radius = Radius;
+		Request.Size = 512;
+		Request.SubViewIndex = Face;
+		return Request;
+	}
+
+	// 디렉셔널 캐스케이드 (직교 투영, 라이트 방향 반대편에서 내려다봄)
+	FShadowRenderRequest MakeCascadeRequest(const FVector& Center, const FVector& Direction, float Extent, int32 Cascade)
+	{
+		FShadowRenderRequest Request;
+		const FVector Eye = Center - Direction * 3000.0f;
+		Request.ViewMatrix = FMatrix::LookAtLH(Eye, Center, FVector(1.0f, 0.0f, 0.0f));
+		Request.ProjectionMatrix = FMatrix::OrthoLH(Extent, Extent, 1.0f, 6000.0f);
+		Request.Size = 2048;
+		Request.SubViewIndex = Cascade;
+		return Request;
+	}
+
+	/**
+	 * @brief CreateFrustumFromViewProjection과 독립적인 판정: 8꼭짓점을 클립 공간으로 옮겨 한 클립 평면 밖에 모두 있으면 밖
+	 * @return 1 안/걸침, 0 밖, -1 평면 경계에 너무 가까워 판정하지 않음
+	 */
+	int32 ClassifyAABBInClipSpace(const FMatrix& ViewProjection, const FAABB& Bounds)
+	{
+		float PlaneMax[6] = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		float MaxAbsValue = 0.0f;
+		for (int32 Corner = 0; Corner < 8; ++Corner)
+		{
+			const FVector4 Point((Corner & 1) ? Bounds.Max.X : Bounds.Min.X, (Corner & 2) ? Bounds.Max.Y : Bounds.Min.Y, (Corner & 4) ? Bounds.Max.Z : Bounds.Min.Z, 1.0f);
+			const FVector4 Clip = Point * ViewProjection;
+
+			// D3D 클립 범위 -w <= x, y <= w, 0 <= z <= w (안쪽 >= 0)
+			const float Values[6] = { Clip.X + Clip.W, Clip.W - Clip.X, Clip.Y + Clip.W, Clip.W - Clip.Y, Clip.Z, Clip.W - Clip.Z };
+			for (int32 Plane = 0; Plane < 6; ++Plane)
+			{
+				PlaneMax[Plane] = std::max(PlaneMax[Plane], Values[Plane]);
+				MaxAbsValue = std::max(MaxAbsValue, std::abs(Values[Plane]));
+			}
+		}
+
+		const float Epsilon = 1e-4f * (MaxAbsValue + 1.0f);
+		bool bNearBoundary = false;
+		for (float Value : PlaneMax)
+		{
+			if (Value < -Epsilon)
+			{
+				return 0;
+			}
+			bNearBoundary |= Value <= Epsilon;
+		}
+		return bNearBoundary ? -1 : 1;
+	}
+
+	bool HasDuplicates(TArray<int32> Indices)
+	{
+		std::sort(Indices.begin(), Indices.end());
+		return std::adjacent_find(Indices.begin(), Indices.end()) != Indices.end();
+	}
+
+	// ──────────────────────────────────────────────
+	// 뷰별 선택 vs 전수 검사
+	// ──────────────────────────────────────────────
+
+	void TestSelectionMatchesBruteForce()
+	{
+		std::mt19937 Rng(1337);
+		std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+		auto Range = [&](float Min, float Max) { return Min + (Max - Min) * Unit(Rng); };
+
+		FTestScene Scene;
+		for (int32 Index = 0; Index < 2000; ++Index)
+		{
+			const FVector Center(Range(-1500.0f, 1500.0f), Range(-1500.0f, 1500.0f), Range(0.0f, 300.0f));
+			const FVector HalfExtent(Range(5.0f, 60.0f), Range(5.0f, 60.0f), Range(5.0f, 60.0f));
+			Scene.AddComponent(MakeBox(Center, HalfExtent), Index % 20 != 19);
+		}
+		Scene.RebuildBVH();
+		Scene.Gather();
+		TEST_CHECK(Scene.Casters.Num() == 2000);
+		TEST_CHECK(Scene.LateComponents.Num() == 100);
+
+		struct FView
+		{
+			FShadowRenderRequest Request;
+			bool bPointLight = false;
+		};
+		TArray<FView> Views;
+		for (int32 Light = 0; Light < 24; ++Light)
+		{
+			const FVector Direction = FVector(Range(-1.0f, 1.0f), Range(-1.0f, 1.0f), Range(-1.0f, -0.3f)).GetNormalized();
+			const FVector Location(Range(-1500.0f, 1500.0f), Range(-1500.0f, 1500.0f), Range(200.0f, 600.0f));
+			Views.Add({ MakeSpotRequest(Location, Direction, Range(15.0f, 60.0f), Range(300.0f, 1500.0f)), false });
+		}
+		for (int32 Light = 0; Light < 12; ++Light)
+		{
+			const FVector Location(Range(-1500.0f, 1500.0f), Range(-1500.0f, 1500.0f), Range(20.0f, 300.0f));
+			const float Radius = Range(100.0f, 800.0f);
+			for (int32 Face = 0; Face < 6; ++Face)
+			{
+				Views.Add({ MakePointFaceRequest(Location, Radius, Face), true });
+			}
+		}
+		const FVector SunDirection = FVector(0.3f, 0.2f, -1.0f).GetNormalized();
+		for (int32 Cascade = 0; Cascade < 4; ++Cascade)
+		{
+			Views.Add({ MakeCascadeRequest(FVector(Range(-500.0f, 500.0f), Range(-500.0f, 500.0f), 100.0f), SunDirection, 400.0f * float(1 << Cascade), Cascade), false });
+		}
+
+		int32 NumViewMismatches = 0;
+		int32 NumClipSpaceMismatches = 0;
+		int32 NumClipSpaceDecided = 0;
+		int32 NumDuplicateViews = 0;
+		int32 NumSelectedPairs = 0;
+		int32 NumSelectedOutsideTree = 0;
+		TArray<int32> Selected;
+		TArray<int32> Expected;
+		for (const FView& View : Views)
+		{
+			Scene.SelectViewCasters(View.Request, View.bPointLight, Selected);
+
+			const FMatrix ViewProjection = View.Request.ViewMatrix * View.Request.ProjectionMatrix;
+			const FFrustum Frustum = CreateFrustumFromViewProjection(ViewProjection);
+			const FBoundingSphere Sphere(View.Request.WorldLocation, View.Request.Radius);
+
+			Expected.Empty();
+			for (int32 CasterIndex = 0; CasterIndex < Scene.Casters.Num(); ++CasterIndex)
+			{
+				const FAABB& Bounds = Scene.Casters[CasterIndex].Bounds;
+				const bool bVisible = IsAABBVisible(Frustum, Bounds);
+				if (bVisible && (!View.bPointLight || Collision::Intersects(Bounds, Sphere)))
+				{
+					Expected.Add(CasterIndex);
+				}
+
+				const int32 ClipResult = ClassifyAABBInClipSpace(ViewProjection, Bounds);
+				if (ClipResult >= 0)
+				{
+					++NumClipSpaceDecided;
+					NumClipSpaceMismatches += (ClipResult == 1) != bVisible ? 1 : 0;
+				}
+			}
+
+			NumDuplicateViews += HasDuplicates(Selected) ? 1 : 0;
+			std::sort(Selected.begin(), Selected.end());
+			NumViewMismatches += Selected != Expected ? 1 : 0;
+			NumSelectedPairs += Selected.Num();
+			for (int32 CasterIndex : Selected)
+			{
+				NumSelectedOutsideTree += CasterIndex % 20 == 19 ? 1 : 0;
+			}
+		}
+
+		std::printf("  %d views, %d selected (caster, view) pairs, %d added after the last BVH rebuild, %d clip-space decisions\n",
+			Views.Num(), NumSelectedPairs, NumSelectedOutsideTree, NumClipSpaceDecided);
+		TEST_CHECK(NumViewMismatches == 0);
+		TEST_CHECK(NumClipSpaceMismatches == 0);
+		TEST_CHECK(NumClipSpaceDecided > Views.Num() * Scene.Casters.Num() / 2);
+		TEST_CHECK(NumDuplicateViews == 0);
+		// 검사가 빈 결과로 통과하지 않도록: 선택된 쌍이 있고 트리 밖 경로도 지남
+		TEST_CHECK(NumSelectedPairs > 1000);
+		TEST_CHECK(NumSelectedOutsideTree > 0);
+	}
+
+	// ──────────────────────────────────────────────
+	// 고정 캐스터
+	// ──────────────────────────────────────────────
+
+	void TestFixtureCasters()
+	{
+		// 원점에서 +X를 보는 90도 스포트 (near 0.5, far 100)
+		FTestScene Scene;
+		const FVector Half(1.0f, 1.0f, 1.0f);
+		Scene.AddComponent(MakeBox(FVector(50.0f, 0.0f, 0.0f), Half), true);		// 0 앞
+		Scene.AddComponent(MakeBox(FVector(-50.0f, 0.0f, 0.0f), Half), true);		// 1 뒤
+		Scene.AddComponent(MakeBox(FVector(150.0f, 0.0f, 0.0f), Half), true);		// 2 원평면 너머
+		Scene.AddComponent(MakeBox(FVector(50.0f, 50.0f, 0.0f), Half), true);		// 3 측면 평면(y = x)에 걸침
+		Scene.AddComponent(MakeBox(FVector(20.0f, 60.0f, 0.0f), Half), true);		// 4 측면 밖
+		Scene.AddComponent(MakeBox(FVector(30.0f, 0.0f, 10.0f), Half), false);		// 5 트리 밖, 앞
+		Scene.AddComponent(MakeBox(FVector(-30.0f, 0.0f, 0.0f), Half), false);		// 6 트리 밖, 뒤
+		Scene.RebuildBVH();
+		Scene.Gather();
+
+		TArray<int32> Selected;
+		Scene.SelectViewCasters(MakeSpotRequest(FVector::Zero(), FVector(1.0f, 0.0f, 0.0f), 45.0f, 100.0f), false, Selected);
+		std::sort(Selected.begin(), Selected.end());
+		TEST_CHECK((Selected == TArray<int32>{ 0, 3, 5 }));
+
+		// 반경 25 포인트 라이트 +X 면: 구 안이면서 면 절두체 안인 캐스터만 (0, 2, 3은 반경 밖)
+		Scene.SelectViewCasters(MakePointFaceRequest(FVector(10.0f, 0.0f, 0.0f), 25.0f, 0), true, Selected);
+		std::sort(Selected.begin(), Selected.end());
+		TEST_CHECK((Selected == TArray<int32>{ 5 }));
+
+		// -X 면: 뒤쪽 트리 밖 캐스터 6만 (1은 반경 밖)
+		Scene.SelectViewCasters(MakePointFaceRequest(FVector(10.0f, 0.0f, 0.0f), 25.0f, 1), true, Selected);
+		TEST_CHECK((Selected == TArray<int32>{ }));
+		Scene.SelectViewCasters(MakePointFaceRequest(FVector(-10.0f, 0.0f, 0.0f), 25.0f, 1), true, Selected);
+		TEST_CHECK((Selected == TArray<int32>{ 6 }));
+
+		// BVH가 없으면 모든 캐스터를 바운드로 검사
+		TArray<int32> NoBVH;
+		const FFrustum Frustum = CreateFrustumFromViewProjection(MakeSpotRequest(FVector::Zero(), FVector(1.0f, 0.0f, 0.0f), 45.0f, 100.0f).ViewMatrix *
+			MakeSpotRequest(FVector::Zero(), FVector(1.0f, 0.0f, 0.0f), 45.0f, 100.0f).ProjectionMatrix);
+		QueryShadowCasterIndices(nullptr, Frustum, Scene.Casters, Scene.CasterIndices, Scene.QueryResults, NoBVH);
+		std::sort(NoBVH.begin(), NoBVH.end());
+		TEST_CHECK((NoBVH == TArray<int32>{ 0, 3, 5 }));
+	}
+
+	// ──────────────────────────────────────────────
+	// 정지 판정 / 캐시 키
+	// ──────────────────────────────────────────────
+
+	void TestCasterMobility()
+	{
+		FShadowCasterCache Cache;
+		UMeshComponent A;
+		UMeshComponent B;
+		UMeshComponent C;
+
+		// 처음 본 패스는 0, 이후 바뀌지 않은 패스마다 1씩 → StaticPassThreshold 번째 다음 패스에서 정적
+		for (uint32 Pass = 0; Pass < FShadowCasterCache::StaticPassThreshold; ++Pass)
+		{
+			Cache.BeginPass();
+			TEST_CHECK(!Cache.UpdateCasterMobility(&A, 1, true));
+			// 같은 패스 안에서 다시 불러도 세지 않음 (여러 섀도우 뷰가 같은 캐스터를 봄)
+			TEST_CHECK(!Cache.UpdateCasterMobility(&A, 1, true));
+			TEST_CHECK(!Cache.UpdateCasterMobility(&B, 7, false));
+			TEST_CHECK(!Cache.UpdateCasterMobility(&C, 100 + Pass, true));
+			Cache.EndPass();
+		}
+		Cache.BeginPass();
+		TEST_CHECK(Cache.UpdateCasterMobility(&A, 1, true));
+		TEST_CHECK(!Cache.UpdateCasterMobility(&B, 7, false));
+		TEST_CHECK(!Cache.UpdateCasterMobility(&C, 200, true));
+		Cache.EndPass();
+
+		// 해시가 바뀌면 다시 처음부터
+		Cache.BeginPass();
+		TEST_CHECK(!Cache.UpdateCasterMobility(&A, 2, true));
+		Cache.EndPass();
+		for (uint32 Pass = 1; Pass < FShadowCasterCache::StaticPassThreshold; ++Pass)
+		{
+			Cache.BeginPass();
+			TEST_CHECK(!Cache.UpdateCasterMobility(&A, 2, true));
+			Cache.EndPass();
+		}
+		Cache.BeginPass();
+		TEST_CHECK(Cache.UpdateCasterMobility(&A, 2, true));
+		Cache.EndPass();
+
+		// 한 패스라도 빠지면 기록이 지워져 처음부터
+		Cache.BeginPass();
+		Cache.EndPass();
+		Cache.BeginPass();
+		TEST_CHECK(!Cache.UpdateCasterMobility(&A, 2, true));
+		Cache.EndPass();
+	}
+
+	void TestStaticCasterHash()
+	{
+		TArray<FShadowCaster> Casters(4);
+		for (int32 Index = 0; Index < Casters.Num(); ++Index)
+		{
+			Casters[Index].StateHash = 0x1000 + Index * 0x10;
+			Casters[Index].bStatic = Index != 2;
+		}
+
+		uint32 NumStatic = 0;
+		const uint64 Hash = HashStaticShadowCasters(Casters, TArray<int32>{ 0, 1, 2, 3 }, NumStatic);
+		TEST_CHECK(NumStatic == 3);
+
+		uint32 NumStaticReordered = 0;
+		TEST_CHECK(HashStaticShadowCasters(Casters, TArray<int32>{ 3, 2, 1, 0 }, NumStaticReordered) == Hash);
+		TEST_CHECK(NumStaticReordered == 3);
+
+		// 동적 캐스터는 키에 들어가지 않음
+		uint32 NumStaticOnly = 0;
+		TEST_CHECK(HashStaticShadowCasters(Casters, TArray<int32>{ 0, 1, 3 }, NumStaticOnly) == Hash);
+
+		// 정적 캐스터 하나가 빠지거나 상태가 바뀌면 다른 키
+		TEST_CHECK(HashStaticShadowCasters(Casters, TArray<int32>{ 0, 1 }, NumStatic) != Hash);
+		Casters[3].StateHash ^= 1;
+		TEST_CHECK(HashStaticShadowCasters(Casters, TArray<int32>{ 0, 1, 3 }, NumStatic) != Hash);
+	}
+
+	void TestEntryUpToDate()
+	{
+		const FShadowRenderRequest Request = MakeSpotRequest(FVector(0.0f, 0.0f, 500.0f), FVector(0.0f, 0.0f, -1.0f), 30.0f, 800.0f);
+		FStaticShadowCacheEntry Entry;
+		TEST_CHECK(!FShadowCasterCache::IsEntryUpToDate(Entry, Request, 42));
+
+		FShadowCasterCache::MarkEntryUpToDate(Entry, Request, 42);
+		TEST_CHECK(FShadowCasterCache::IsEntryUpToDate(Entry, Request, 42));
+		TEST_CHECK(!FShadowCasterCache::IsEntryUpToDate(Entry, Request, 43));
+
+		FShadowRenderRequest Changed = Request;
+		Changed.ViewMatrix.M[3][0] += 0.5f;
+		TEST_CHECK(!FShadowCasterCache::IsEntryUpToDate(Entry, Changed, 42));
+
+		Changed = Request;
+		Changed.ProjectionMatrix.M[0][0] *= 1.01f;
+		TEST_CHECK(!FShadowCasterCache::IsEntryUpToDate(Entry, Changed, 42));
+
+		Changed = Request;
+		Changed.WorldLocation.X += 1.0f;
+		TEST_CHECK(!FShadowCasterCache::IsEntryUpToDate(Entry, Changed, 42));
+
+		Changed = Request;
+		Changed.Radius += 1.0f;
+		TEST_CHECK(!FShadowCasterCache::IsEntryUpToDate(Entry, Changed, 42));
+
+		Entry.bValid = false;
+		TEST_CHECK(!FShadowCasterCache::IsEntryUpToDate(Entry, Request, 42));
+	}
+
+	// ──────────────────────────────────────────────
+	// 캐시 시나리오 (RenderShadowView와 같은 키)
+	// ──────────────────────────────────────────────
+
+	void TestCacheScenario()
+	{
+		std::mt19937 Rng(7);
+		std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+		auto Range = [&](float Min, float Max) { return Min + (Max - Min) * Unit(Rng); };
+
+		FTestScene Scene;
+		for (int32 Index = 0; Index < 600; ++Index)
+		{
+			const FVector Center(Range(-1500.0f, 1500.0f), Range(-1500.0f, 1500.0f), Range(0.0f, 300.0f));
+			Scene.AddComponent(MakeBox(Center, FVector(20.0f, 20.0f, 20.0f)), Index % 20 != 19);
+		}
+		Scene.RebuildBVH();
+
+		FShadowCasterCache CasterCache;
+		TSet<UMeshComponent*> NeverStatic;
+		FVector LightLocation(0.0f, 0.0f, 800.0f);
+		const FVector LightDirection = FVector(0.2f, 0.1f, -1.0f).GetNormalized();
+
+		FStaticShadowCacheEntry CacheEntry;
+		FShadowRenderRequest Request;
+		FShadowRenderRequest RenderedRequest;
+		TArray<int32> Selected;
+		TArray<std::pair<UMeshComponent*, uint64>> StaticSet;
+		TArray<std::pair<UMeshComponent*, uint64>> RenderedStaticSet;
+		bool bHasRendered = false;
+		int32 NumPasses = 0;
+		int32 NumFailures = 0;
+
+		// ExpectedHit: 1 적중, 0 다시 그림, -1 기대값 비교만
+		auto RunCachePass = [&](const char* CaseName, int32 ExpectedHit)
+		{
+			Scene.Gather(&CasterCache, &NeverStatic);
+			Request = MakeSpotRequest(LightLocation, LightDirection, 40.0f, 1200.0f);
+			Scene.SelectViewCasters(Request, false, Selected);
+
+			uint32 NumStatic = 0;
+			const uint64 StaticCasterHash = HashStaticShadowCasters(Scene.Casters, Selected, NumStatic);
+
+			// 정적 캐스터가 없으면 RenderShadowView는 캐시를 쓰지 않고, 쓰지 않은 항목은 EndPass에서 지워짐
+			bool bHit = false;
+			if (NumStatic == 0)
+			{
+				CacheEntry.bValid = false;
+			}
+			else
+			{
+				bHit = FShadowCasterCache::IsEntryUpToDate(CacheEntry, Request, StaticCasterHash);
+				if (!bHit)
+				{
+					FShadowCasterCache::MarkEntryUpToDate(CacheEntry, Request, StaticCasterHash);
+				}
+			}
+
+			StaticSet.Empty();
+			for (int32 CasterIndex : Selected)
+			{
+				if (Scene.Casters[CasterIndex].bStatic)
+				{
+					StaticSet.Add({ Scene.Casters[CasterIndex].Component, Scene.Casters[CasterIndex].StateHash });
+				}
+			}
+			std::sort(StaticSet.begin(), StaticSet.end());
+
+			const bool bSameLight = bHasRendered &&
+				std::memcmp(&RenderedRequest.ViewMatrix, &Request.ViewMatrix, sizeof(FMatrix)) == 0 &&
+				std::memcmp(&RenderedRequest.ProjectionMatrix, &Request.ProjectionMatrix, sizeof(FMatrix)) == 0 &&
+				RenderedRequest.WorldLocation == Request.WorldLocation && RenderedRequest.Radius == Request.Radius;
+			const bool bExpectedHit = NumStatic > 0 && bSameLight && StaticSet == RenderedStaticSet;
+			if (!bHit)
+			{
+				RenderedRequest = Request;
+				RenderedStaticSet = StaticSet;
+				bHasRendered = NumStatic > 0;
+			}
+
+			++NumPasses;
+			if (bHit != bExpectedHit || (ExpectedHit >= 0 && bHit != (ExpectedHit == 1)))
+			{
+				++NumFailures;
+				std::printf("  cache case '%s': hit %d, expected %d\n", CaseName, bHit ? 1 : 0, bExpectedHit ? 1 : 0);
+			}
+		};
+
+		// 이번 뷰에서 Offset만큼 옮겨도 안(bInside) 또는 밖에 확실히 남는 정적 캐스터
+		auto FindStaticCaster = [&](bool bInside, const FVector& Offset) -> UMeshComponent*
+		{
+			const FMatrix ViewProjection = Request.ViewMatrix * Request.ProjectionMatrix;
+			const int32 Wanted = bInside ? 1 : 0;
+			for (const FShadowCaster& Caster : Scene.Casters)
+			{
+				if (Caster.bStatic && !NeverStatic.Contains(Caster.Component) &&
+					ClassifyAABBInClipSpace(ViewProjection, Caster.Bounds) == Wanted &&
+					ClassifyAABBInClipSpace(ViewProjection, OffsetAABB(Caster.Bounds, Offset)) == Wanted)
+				{
+					return Caster.Component;
+				}
+			}
+			return nullptr;
+		};
+
+		auto MoveCaster = [&](UMeshComponent* Component, const FVector& Offset)
+		{
+			Component->WorldAABB = OffsetAABB(Component->WorldAABB, Offset);
+			Scene.RebuildBVH();
+		};
+
+		// 정지 판정이 끝나 첫 캐시가 그려질 때까지
+		for (uint32 Pass = 0; Pass <= FShadowCasterCache::StaticPassThreshold; ++Pass)
+		{
+			RunCachePass("warm-up", -1);
+		}
+		RunCachePass("unchanged", 1);
+
+		LightLocation.X += 25.0f;
+		RunCachePass("light move", 0);
+		RunCachePass("after light move", 1);
+
+		const FVector Offset(0.0f, 0.0f, 5.0f);
+		UMeshComponent* OutsideCaster = FindStaticCaster(false, Offset);
+		TEST_CHECK(OutsideCaster != nullptr);
+		if (OutsideCaster)
+		{
+			MoveCaster(OutsideCaster, Offset);
+			RunCachePass("static caster move outside view", 1);
+		}
+
+		UMeshComponent* InsideCaster = FindStaticCaster(true, Offset);
+		TEST_CHECK(InsideCaster != nullptr);
+		if (InsideCaster)
+		{
+			// 움직인 캐스터는 StaticPassThreshold 패스 동안 동적으로 그려지고 다시 정적이 되면 캐시에 들어감
+			MoveCaster(InsideCaster, Offset);
+			RunCachePass("static caster move in view", 0);
+			for (uint32 Pass = 1; Pass < FShadowCasterCache::StaticPassThreshold; ++Pass)
+			{
+				RunCachePass("moved caster while dynamic", 1);
+			}
+			RunCachePass("moved caster static again", 0);
+			RunCachePass("after re-promotion", 1);
+		}
+
+		// 움직이지 않아도 정적이 될 수 없게 된 캐스터 (스켈레탈로 교체 등)
+		UMeshComponent* DemotedCaster = FindStaticCaster(true, FVector::Zero());
+		TEST_CHECK(DemotedCaster != nullptr);
+		if (DemotedCaster)
+		{
+			NeverStatic.insert(DemotedCaster);
+			RunCachePass("static to dynamic demotion", 0);
+			RunCachePass("after demotion", 1);
+		}
+
+		std::printf("  %d cache passes, %d failures, %d static casters in the cache view\n", NumPasses, NumFailures, static_cast<int32>(RenderedStaticSet.Num()));
+		TEST_CHECK(NumFailures == 0);
+		TEST_CHECK(!RenderedStaticSet.IsEmpty());
+	}
+}
+
+int main()
+{
+	TestSelectionMatchesBruteForce();
+	TestFixtureCasters();
+	TestCasterMobility();
+	TestStaticCasterHash();
+	TestEntryUpToDate();
+	TestCacheScenario();
+	return MundiTest::Finish("ShadowCasterSelectionTests");
+}
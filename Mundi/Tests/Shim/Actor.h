@@ -0,0 +1,36 @@
+﻿#pragma once
+
+// 리눅스 테스트용 AActor / UPrimitiveComponent 대역
+// BVHierarchy.cpp 등 공간 분할 코드와 FMeshBatchCollector가 부르는 멤버만 있고, 테스트가 필드를 직접 채움
+struct FMeshBatchElement;
+class FSceneView;
+
+class AActor
+{
+public:
+    bool IsActorActive() { return bActorIsActive; }
+    void SetCulled(bool InCulled) { bCulled = InCulled; }
+    bool GetActorHiddenInEditor() const { return bHiddenInEditor; }
+
+    bool bActorIsActive = true;
+    bool bCulled = true;
+    bool bHiddenInEditor = false;
+};
+
+class UPrimitiveComponent
+{
+public:
+    virtual ~UPrimitiveComponent() = default;
+
+    virtual FAABB GetWorldAABB() const { return WorldAABB; }
+    // 엔진과 같이 Prepare는 게임 스레드에서, Collect는 워커에서도 불림 (테스트 컴포넌트가 재정의)
+    virtual void PrepareMeshBatches(const FSceneView* View) {}
+    virtual void CollectMeshBatches(TArray<FMeshBatchElement>& OutMeshBatchElements, const FSceneView* View) {}
+
+    AActor* GetOwner() const { return Owner; }
+    bool IsPendingDestroy() const { return bPendingDestroy; }
+
+    FAABB WorldAABB;
+    AActor* Owner = nullptr;
+    bool bPendingDestroy = false;
+};
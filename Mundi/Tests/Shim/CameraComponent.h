@@ -0,0 +1,24 @@
+﻿#pragma once
+
+// 리눅스 테스트용 UCameraComponent 대역 (Frustum.cpp의 CreateFrustumFromCamera가 읽는 값만)
+class UCameraComponent
+{
+public:
+    float GetFOV() const { return FieldOfView; }
+    float GetAspectRatio() const { return AspectRatio; }
+    float GetNearClip() const { return NearClip; }
+    float GetFarClip() const { return FarClip; }
+    FVector GetWorldLocation() const { return Location; }
+    FVector GetForward() const { return Forward; }
+    FVector GetRight() const { return Right; }
+    FVector GetUp() const { return Up; }
+
+    float FieldOfView = 90.0f;
+    float AspectRatio = 1.0f;
+    float NearClip = 0.1f;
+    float FarClip = 1000.0f;
+    FVector Location = FVector(0.0f, 0.0f, 0.0f);
+    FVector Forward = FVector(1.0f, 0.0f, 0.0f);
+    FVector Right = FVector(0.0f, 1.0f, 0.0f);
+    FVector Up = FVector(0.0f, 0.0f, 1.0f);
+};
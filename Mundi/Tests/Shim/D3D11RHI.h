@@ -0,0 +1,29 @@
+﻿#pragma once
+#include <d3d11.h>
+
+// 리눅스 테스트용 D3D11RHI.h 대역
+// 엔진 D3D11RHI는 디바이스/스왑체인/셰이더 리소스 전체를 끌어옴
+// TileLightCuller.cpp/MeshAutoInstancing.cpp(버퍼), ShadowCasterCache.cpp(디바이스)가 부르는 함수만 둠
+// 테스트는 RHI 없이(nullptr) 호출하므로 생성은 항상 실패로 돌려줌
+class D3D11RHI
+{
+public:
+    ID3D11Device* GetDevice() { return nullptr; }
+    ID3D11DeviceContext* GetDeviceContext() { return nullptr; }
+
+    HRESULT CreateStructuredBuffer(UINT InElementSize, UINT InElementCount, const void* InInitData, ID3D11Buffer** OutBuffer)
+    {
+        *OutBuffer = nullptr;
+        return E_FAIL;
+    }
+
+    HRESULT CreateStructuredBufferSRV(ID3D11Buffer* InBuffer, ID3D11ShaderResourceView** OutSRV)
+    {
+        *OutSRV = nullptr;
+        return E_FAIL;
+    }
+
+    void UpdateStructuredBuffer(ID3D11Buffer* InBuffer, const void* InData, UINT InDataSize)
+    {
+    }
+};
@@ -0,0 +1,3 @@
+﻿#pragma once
+
+// 리눅스 테스트용 InputManager.h 대역 (Picking.h가 include만 하고 선언은 쓰지 않음)
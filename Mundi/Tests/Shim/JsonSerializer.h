@@ -0,0 +1,304 @@
+﻿#pragma once
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+// 리눅스 테스트용 JsonSerializer.h 대역
+// 엔진의 json::JSON(ThirdParty)은 리눅스 트리에 없음. AssetRegistry.cpp가 쓰는 멤버만 같은 이름으로 구현
+// - 값: Null / Object / Array / String / Integral / Boolean (실수는 쓰지 않음)
+// - Load는 위 타입만 읽는 재귀 하강 파서, 출력은 들여쓰기 없는 한 줄
+
+namespace json
+{
+    class JSON
+    {
+    public:
+        enum class Class { Null, Object, Array, String, Floating, Integral, Boolean };
+
+        JSON() = default;
+        JSON(const std::string& Value) : Type(Class::String), String(Value) {}
+        JSON(const char* Value) : Type(Class::String), String(Value) {}
+        JSON(int Value) : Type(Class::Integral), Integer(Value) {}
+        JSON(long Value) : Type(Class::Integral), Integer(Value) {}
+        JSON(bool Value) : Type(Class::Boolean), Integer(Value ? 1 : 0) {}
+
+        static JSON Make(Class InType)
+        {
+            JSON Result;
+            Result.Type = InType;
+            return Result;
+        }
+
+        static JSON Load(const std::string& Text)
+        {
+            size_t Offset = 0;
+            return Parse(Text, Offset);
+        }
+
+        Class JSONType() const { return Type; }
+
+        std::string ToString() const { return Type == Class::String ? String : std::string(); }
+        long ToInt() const { return Type == Class::Integral ? Integer : 0; }
+
+        int size() const
+        {
+            if (Type == Class::Array) return static_cast<int>(Elements.size());
+            if (Type == Class::Object) return static_cast<int>(Members.size());
+            return -1;
+        }
+
+        void append(const JSON& Value)
+        {
+            Type = Class::Array;
+            Elements.push_back(Value);
+        }
+
+        JSON& operator[](const std::string& Key)
+        {
+            Type = Class::Object;
+            for (auto& Member : Members)
+            {
+                if (Member.first == Key)
+                {
+                    return Member.second;
+                }
+            }
+            Members.emplace_back(Key, JSON());
+            return Members.back().second;
+        }
+
+        bool hasKey(const std::string& Key) const
+        {
+            return FindMember(Key) != nullptr;
+        }
+
+        const JSON& at(const std::string& Key) const
+        {
+            const JSON* Member = FindMember(Key);
+            if (!Member)
+            {
+                throw std::out_of_range(Key);
+            }
+            return *Member;
+        }
+
+        const JSON& at(int Index) const { return Elements.at(Index); }
+
+        const std::vector<std::pair<std::string, JSON>>& ObjectRange() const { return Members; }
+
+        friend std::ostream& operator<<(std::ostream& Stream, const JSON& Value)
+        {
+            Value.Dump(Stream);
+            return Stream;
+        }
+
+    private:
+        const JSON* FindMember(const std::string& Key) const
+        {
+            for (const auto& Member : Members)
+            {
+                if (Member.first == Key)
+                {
+                    return &Member.second;
+                }
+            }
+            return nullptr;
+        }
+
+        static void DumpString(std::ostream& Stream, const std::string& Value)
+        {
+            Stream << '"';
+            for (char Char : Value)
+            {
+                if (Char == '"' || Char == '\\')
+                {
+                    Stream << '\\';
+                }
+                Stream << Char;
+            }
+            Stream << '"';
+        }
+
+        void Dump(std::ostream& Stream) const
+        {
+            switch (Type)
+            {
+            case Class::Object:
+            {
+                Stream << '{';
+                for (size_t Index = 0; Index < Members.size(); ++Index)
+                {
+                    Stream << (Index > 0 ? "," : "");
+                    DumpString(Stream, Members[Index].first);
+                    Stream << ':' << Members[Index].second;
+                }
+                Stream << '}';
+                break;
+            }
+            case Class::Array:
+                Stream << '[';
+                for (size_t Index = 0; Index < Elements.size(); ++Index)
+                {
+                    Stream << (Index > 0 ? "," : "") << Elements[Index];
+                }
+                Stream << ']';
+                break;
+            case Class::String:
+                DumpString(Stream, String);
+                break;
+            case Class::Integral:
+                Stream << Integer;
+                break;
+            case Class::Boolean:
+                Stream << (Integer ? "true" : "false");
+                break;
+            default:
+                Stream << "null";
+                break;
+            }
+        }
+
+        static void SkipSpace(const std::string& Text, size_t& Offset)
+        {
+            while (Offset < Text.size() && std::isspace(static_cast<unsigned char>(Text[Offset])))
+            {
+                ++Offset;
+            }
+        }
+
+        static std::string ParseString(const std::string& Text, size_t& Offset)
+        {
+            std::string Result;
+            ++Offset;   // '"'
+            while (Offset < Text.size() && Text[Offset] != '"')
+            {
+                if (Text[Offset] == '\\' && Offset + 1 < Text.size())
+                {
+                    ++Offset;
+                }
+                Result.push_back(Text[Offset++]);
+            }
+            if (Offset >= Text.size())
+            {
+                throw std::runtime_error("unterminated string");
+            }
+            ++Offset;
+            return Result;
+        }
+
+        static JSON Parse(const std::string& Text, size_t& Offset)
+        {
+            SkipSpace(Text, Offset);
+            if (Offset >= Text.size())
+            {
+                throw std::runtime_error("unexpected end");
+            }
+
+            const char Char = Text[Offset];
+            if (Char == '{')
+            {
+                JSON Result = Make(Class::Object);
+                ++Offset;
+                SkipSpace(Text, Offset);
+                while (Offset < Text.size() && Text[Offset] != '}')
+                {
+                    const std::string Key = ParseString(Text, Offset);
+                    SkipSpace(Text, Offset);
+                    ++Offset;   // ':'
+                    Result[Key] = Parse(Text, Offset);
+                    SkipSpace(Text, Offset);
+                    if (Offset < Text.size() && Text[Offset] == ',')
+                    {
+                        ++Offset;
+                        SkipSpace(Text, Offset);
+                    }
+                }
+                ++Offset;
+                return Result;
+            }
+            if (Char == '[')
+            {
+                JSON Result = Make(Class::Array);
+                ++Offset;
+                SkipSpace(Text, Offset);
+                while (Offset < Text.size() && Text[Offset] != ']')
+                {
+                    Result.append(Parse(Text, Offset));
+                    SkipSpace(Text, Offset);
+                    if (Offset < Text.size() && Text[Offset] == ',')
+                    {
+                        ++Offset;
+                    }
+                }
+                ++Offset;
+                return Result;
+            }
+            if (Char == '"')
+            {
+                return JSON(ParseString(Text, Offset));
+            }
+            if (Text.compare(Offset, 4, "true") == 0)
+            {
+                Offset += 4;
+                return JSON(true);
+            }
+            if (Text.compare(Offset, 5, "false") == 0)
+            {
+                Offset += 5;
+                return JSON(false);
+            }
+            if (Text.compare(Offset, 4, "null") == 0)
+            {
+                Offset += 4;
+                return JSON();
+            }
+
+            size_t Length = 0;
+            const long Value = std::stol(Text.substr(Offset, 32), &Length);
+            Offset += Length;
+            return JSON(Value);
+        }
+
+        Class Type = Class::Null;
+        std::string String;
+        long Integer = 0;
+        std::vector<JSON> Elements;
+        std::vector<std::pair<std::string, JSON>> Members;
+    };
+}
+
+using JSON = json::JSON;
+
+class FJsonSerializer
+{
+public:
+    static bool SaveJsonToFile(const JSON& InJsonData, const FWideString& InFilePath)
+    {
+        std::ofstream File{ std::filesystem::path(InFilePath) };
+        if (!File.is_open())
+        {
+            return false;
+        }
+        File << InJsonData << "\n";
+        return true;
+    }
+
+    static bool LoadJsonFromFile(JSON& OutJson, const FWideString& InFilePath)
+    {
+        try
+        {
+            std::ifstream File{ std::filesystem::path(InFilePath) };
+            if (!File.is_open())
+            {
+                return false;
+            }
+            const std::string FileContent((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+            OutJson = JSON::Load(FileContent);
+            return true;
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+};
@@ -0,0 +1,22 @@
+﻿#pragma once
+
+// 리눅스 테스트용 Material.h 대역 (MeshDrawCommands.cpp가 픽셀 상수와 텍스처를 읽음)
+// 엔진 UMaterialInterface는 UObject/셰이더/리소스 매니저를 끌어오므로 기록 코드가 부르는 함수만 둠
+// 테스트가 상속해 머티리얼 정보와 텍스처를 채움
+class UTexture;
+
+enum class EMaterialTextureSlot : uint8
+{
+    Diffuse = 0,
+    Normal,
+    Max
+};
+
+class UMaterialInterface
+{
+public:
+    virtual ~UMaterialInterface() = default;
+
+    virtual UTexture* GetTexture(EMaterialTextureSlot Slot) const = 0;
+    virtual const FMaterialInfo& GetMaterialInfo() const = 0;
+};
@@ -0,0 +1,7 @@
+﻿#pragma once
+#include "Actor.h"
+
+// 리눅스 테스트용 UMeshComponent 대역 (Actor.h 참고)
+class UMeshComponent : public UPrimitiveComponent
+{
+};
@@ -0,0 +1,13 @@
+﻿#pragma once
+
+// 리눅스 테스트용 URenderer 대역 (엔진 pch.h가 끌어오는 Renderer.h 대신, 디버그 드로우 호출만 받음)
+class URenderer
+{
+public:
+    void AddLines(const TArray<FVector>& StartPoints, const TArray<FVector>& EndPoints, const TArray<FVector4>& Colors)
+    {
+        NumLines += StartPoints.Num();
+    }
+
+    int32 NumLines = 0;
+};
@@ -0,0 +1,62 @@
+﻿#pragma once
+#include "AsyncAssetLoader.h"
+
+// 리눅스 테스트용 UResourceManager 대역 (AssetRegistry.cpp가 부르는 Get/LoadAsync만)
+// - 실제 로드 없이 요청을 기록 (경로, 타입, 우선순위, sRGB 인자)
+// - Get은 테스트가 MarkLoaded로 표시한 경로만 "로드됨"으로 돌려줌
+
+class UStaticMesh {};
+class UTexture {};
+
+class UResourceManager
+{
+public:
+    struct FRequest
+    {
+        FString Path;
+        bool bTexture = false;
+        EAsyncLoadPriority Priority = EAsyncLoadPriority::Normal;
+        bool bSRGB = true;
+    };
+
+    static UResourceManager& GetInstance()
+    {
+        static UResourceManager Instance;
+        return Instance;
+    }
+
+    template<typename T, typename... Args>
+    void LoadAsync(const FString& InFilePath, EAsyncLoadPriority Priority = EAsyncLoadPriority::Normal,
+        std::function<void(T*)> = nullptr, Args&&... InArgs)
+    {
+        FRequest Request;
+        Request.Path = InFilePath;
+        Request.bTexture = std::is_same_v<T, UTexture>;
+        Request.Priority = Priority;
+        if constexpr (sizeof...(Args) > 0)
+        {
+            Request.bSRGB = (static_cast<bool>(InArgs), ...);
+        }
+        Requests.push_back(Request);
+    }
+
+    template<typename T>
+    T* Get(const FString& InFilePath)
+    {
+        static T Loaded;
+        return LoadedPaths.count(InFilePath) ? &Loaded : nullptr;
+    }
+
+    void MarkLoaded(const FString& InFilePath) { LoadedPaths.insert(InFilePath); }
+
+    void Reset()
+    {
+        Requests.clear();
+        LoadedPaths.clear();
+    }
+
+    TArray<FRequest> Requests;
+    TSet<FString> LoadedPaths;
+};
+
+#define RESOURCE UResourceManager::GetInstance()
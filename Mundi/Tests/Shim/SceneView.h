@@ -0,0 +1,34 @@
+#pragma once
+#include "Frustum.h"
+
+// 리눅스 테스트용 SceneView.h 대역
+// 엔진 FSceneView는 카메라/뷰포트/포스트 프로세스까지 끌어오고 생성자가 SceneView.cpp에 있음
+// 렌더러 코드가 읽는 데이터 멤버만 같은 이름으로 두고 테스트가 직접 채움
+class URenderSettings;
+
+struct FViewportRect
+{
+    uint32 MinX = 0, MinY = 0, MaxX = 0, MaxY = 0;
+    uint32 Width() const { return MaxX - MinX; }
+    uint32 Height() const { return MaxY - MinY; }
+};
+
+class FSceneView
+{
+public:
+    FMatrix ViewMatrix{};
+    FMatrix ProjectionMatrix{};
+    FFrustum ViewFrustum{};
+    FVector ViewLocation{};
+    FQuat ViewRotation{};
+    FViewportRect ViewRect{};
+
+    URenderSettings* RenderSettings = nullptr;
+
+    ECameraProjectionMode ProjectionMode = ECameraProjectionMode::Perspective;
+    float NearClip = 0.0f;
+    float FarClip = 0.0f;
+    float FieldOfView = 0.0f;
+    float AspectRatio = 0.0f;
+    float ZoomFactor = 0.0f;
+};
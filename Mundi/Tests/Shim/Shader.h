@@ -0,0 +1,53 @@
+﻿#pragma once
+#include <d3d11.h>
+
+// 리눅스 테스트용 Shader.h 대역 (MeshBatchCollector.cpp는 변형 컴파일 금지/놓친 횟수만 씀)
+// 변형은 매크로 배열 대신 키 하나로 구분하고, 컴파일은 키에서 만든 가짜 셰이더 포인터를 맵에 넣는 것으로 대신함
+// 금지 중 동작은 엔진 UShader::GetOrCompileShaderVariant와 같음: 있는 변형만 돌려주고, 없으면 nullptr + 놓친 횟수 증가
+struct FShaderVariant
+{
+    ID3D11VertexShader* VertexShader = nullptr;
+    ID3D11PixelShader* PixelShader = nullptr;
+};
+
+class UShader
+{
+public:
+    FShaderVariant* GetOrCompileShaderVariant(uint64 Key)
+    {
+        if (FShaderVariant* Found = ShaderVariantMap.Find(Key))
+        {
+            return Found;
+        }
+        if (!IsVariantCompileAllowed())
+        {
+            ++NumMissedVariants();
+            return nullptr;
+        }
+
+        FShaderVariant& NewVariant = ShaderVariantMap[Key];
+        NewVariant.VertexShader = reinterpret_cast<ID3D11VertexShader*>(static_cast<uintptr_t>((Key << 8) | 0x10));
+        NewVariant.PixelShader = reinterpret_cast<ID3D11PixelShader*>(static_cast<uintptr_t>((Key << 8) | 0x20));
+        return &NewVariant;
+    }
+
+    int32 GetNumVariants() const { return ShaderVariantMap.Num(); }
+
+    static void SetVariantCompileAllowed(bool bAllowed) { IsVariantCompileAllowed() = bAllowed; }
+    static uint32 GetNumMissedVariants() { return NumMissedVariants(); }
+
+private:
+    static bool& IsVariantCompileAllowed()
+    {
+        thread_local bool bAllowed = true;
+        return bAllowed;
+    }
+
+    static uint32& NumMissedVariants()
+    {
+        thread_local uint32 NumMissed = 0;
+        return NumMissed;
+    }
+
+    TMap<uint64, FShaderVariant> ShaderVariantMap;
+};
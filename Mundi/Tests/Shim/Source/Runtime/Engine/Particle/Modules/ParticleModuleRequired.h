@@ -0,0 +1,14 @@
+﻿#pragma once
+
+// 리눅스 테스트용 ParticleModuleRequired.h 대역 (MeshBatchElement.h가 엔진 루트 기준 경로로 include)
+// 엔진 헤더는 파티클 모듈/시뮬레이션 컨텍스트/컴포넌트까지 끌어옴. 배치가 쓰는 EScreenAlignment만 같은 정의로 둠
+class UMaterialInterface;
+
+// 스크린 정렬 방식
+enum class EScreenAlignment : uint8
+{
+    CameraFacing,  // 카메라를 향함 (빌보드)
+    Velocity,      // 속도 방향
+
+    None
+};
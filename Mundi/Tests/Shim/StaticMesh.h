@@ -0,0 +1,6 @@
+﻿#pragma once
+#include "ResourceData.h"
+
+// 리눅스 테스트용 StaticMesh.h 대역 (ObjManager.h가 FMaterialInfo/FStaticMesh 때문에 include)
+// FStaticMesh는 VertexData.h(Shim/pch.h), UStaticMesh는 D3D11 리소스라 선언만
+class UStaticMesh;
@@ -0,0 +1,17 @@
+﻿#pragma once
+#include <d3d11.h>
+
+// 리눅스 테스트용 Texture.h 대역 (MeshDrawCommands.cpp는 SRV만 읽음)
+class UTexture
+{
+public:
+    explicit UTexture(ID3D11ShaderResourceView* InShaderResourceView = nullptr)
+        : ShaderResourceView(InShaderResourceView)
+    {
+    }
+
+    ID3D11ShaderResourceView* GetShaderResourceView() const { return ShaderResourceView; }
+
+private:
+    ID3D11ShaderResourceView* ShaderResourceView = nullptr;
+};
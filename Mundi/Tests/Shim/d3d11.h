@@ -0,0 +1,100 @@
+﻿#pragma once
+
+// 리눅스 테스트용 d3d11.h 대역 (Enums.h 등이 include만 함)
+// 엔진 헤더가 포인터/열거형으로만 쓰는 D3D11 타입이 필요해지면 여기에 선언만 추가 (테스트는 실제 디바이스를 만들지 않음)
+// 엔진 소스가 Release()를 부르는 타입만 빈 IUnknown을 상속해 정의
+// 리소스 생성 함수(ID3D11Device)는 컴파일만 되도록 두고 항상 실패 (테스트는 RHI 없이 호출해 생성 경로를 타지 않음)
+
+struct IUnknown
+{
+    unsigned long Release() { return 0; }
+};
+
+// ResourceData.h (FResourceData, FTextureData), TileLightCuller.cpp (라이트 인덱스 버퍼)
+struct ID3D11Resource : IUnknown {};
+struct ID3D11Buffer : ID3D11Resource {};
+struct ID3D11ShaderResourceView : IUnknown {};
+struct ID3D11BlendState;
+
+// MeshBatchElement.h (배치가 비교/정렬만 하는 셰이더와 입력 레이아웃), MeshAutoInstancing.cpp (인스턴스 SRV 바인딩)
+struct ID3D11VertexShader;
+struct ID3D11PixelShader;
+struct ID3D11InputLayout;
+
+// RHICommandList.h, MeshDrawCommands.cpp (기록만 하고 재생은 널 백엔드)
+struct ID3D11SamplerState;
+
+struct ID3D11DeviceContext : IUnknown
+{
+    void VSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) {}
+};
+
+// LightManager.h, ShadowCasterCache.h/.cpp (섀도우 캐시 텍스처)
+struct ID3D11Texture2D : ID3D11Resource {};
+struct ID3D11DepthStencilView : IUnknown {};
+struct ID3D11RenderTargetView;
+
+enum DXGI_FORMAT
+{
+    DXGI_FORMAT_R32_UINT = 42,
+    DXGI_FORMAT_R24G8_TYPELESS = 44,
+    DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+    DXGI_FORMAT_R24_UNORM_X8_TYPELESS = 46,
+};
+
+enum D3D11_USAGE { D3D11_USAGE_DEFAULT = 0 };
+enum D3D11_BIND_FLAG { D3D11_BIND_SHADER_RESOURCE = 0x8, D3D11_BIND_DEPTH_STENCIL = 0x40 };
+enum D3D11_DSV_DIMENSION { D3D11_DSV_DIMENSION_TEXTURE2D = 3 };
+enum D3D11_SRV_DIMENSION { D3D11_SRV_DIMENSION_TEXTURE2D = 4 };
+
+struct DXGI_SAMPLE_DESC
+{
+    UINT Count;
+    UINT Quality;
+};
+
+struct D3D11_TEXTURE2D_DESC
+{
+    UINT Width;
+    UINT Height;
+    UINT MipLevels;
+    UINT ArraySize;
+    DXGI_FORMAT Format;
+    DXGI_SAMPLE_DESC SampleDesc;
+    D3D11_USAGE Usage;
+    UINT BindFlags;
+    UINT CPUAccessFlags;
+    UINT MiscFlags;
+};
+
+struct D3D11_DEPTH_STENCIL_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_DSV_DIMENSION ViewDimension;
+    UINT Flags;
+    struct { UINT MipSlice; } Texture2D;
+};
+
+struct D3D11_SHADER_RESOURCE_VIEW_DESC
+{
+    DXGI_FORMAT Format;
+    D3D11_SRV_DIMENSION ViewDimension;
+    struct { UINT MostDetailedMip; UINT MipLevels; } Texture2D;
+};
+
+struct ID3D11Device : IUnknown
+{
+    HRESULT CreateTexture2D(const D3D11_TEXTURE2D_DESC*, const void*, ID3D11Texture2D**) { return E_FAIL; }
+    HRESULT CreateDepthStencilView(ID3D11Resource*, const D3D11_DEPTH_STENCIL_VIEW_DESC*, ID3D11DepthStencilView**) { return E_FAIL; }
+    HRESULT CreateShaderResourceView(ID3D11Resource*, const D3D11_SHADER_RESOURCE_VIEW_DESC*, ID3D11ShaderResourceView**) { return E_FAIL; }
+};
+
+enum D3D11_PRIMITIVE_TOPOLOGY
+{
+    D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+    D3D11_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+    D3D11_PRIMITIVE_TOPOLOGY_LINELIST = 2,
+    D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP = 3,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+};
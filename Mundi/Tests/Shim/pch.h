@@ -0,0 +1,91 @@
+﻿#pragma once
+
+// 리눅스 테스트 타깃용 pch.h (Tests/CMakeLists.txt가 include 경로 맨 앞에 둠)
+// 엔진 pch.h는 windows.h/D3D11/ImGui까지 끌어오므로, 테스트가 컴파일하는 엔진 소스가 쓰는 것만 채움
+// 같은 폴더의 다른 헤더(windows.h, d3d11.h, Actor.h 등)도 같은 방식으로 엔진/SDK 헤더를 대신함
+
+// Feature Flags (엔진 pch.h와 같은 이름)
+#define USE_ALLOCATION_STATS
+
+// Standard Library (MUST come before UEContainer.h)
+#include <vector>
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <unordered_map>
+#include <queue>
+#include <stack>
+#include <list>
+#include <deque>
+#include <string>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <iostream>
+#include <fstream>
+#include <utility>
+#include <filesystem>
+#include <sstream>
+#include <iterator>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <strings.h>
+#include <chrono>
+#include <immintrin.h>
+
+// glibc <cmath>의 M_E 등은 엔진 지역 변수 이름(M_A..M_F)과 겹침
+#undef M_E
+
+// libstdc++ <cmath>에는 std::fabsf/sqrtf 등이 없음 (MSVC STL에는 있음)
+namespace std
+{
+    using ::fabsf;
+    using ::sqrtf;
+}
+
+// Windows SDK 대체 (같은 폴더의 windows.h)
+#include <windows.h>
+
+// MSVC 보안 CRT
+template<size_t N, typename... ArgTypes>
+int sprintf_s(char (&Buffer)[N], const char* Format, ArgTypes... Args)
+{
+    return std::snprintf(Buffer, N, Format, Args...);
+}
+
+template<typename... ArgTypes>
+int sprintf_s(char* Buffer, size_t Size, const char* Format, ArgTypes... Args)
+{
+    return std::snprintf(Buffer, Size, Format, Args...);
+}
+
+template<typename... ArgTypes>
+int swprintf_s(wchar_t* Buffer, size_t Size, const wchar_t* Format, ArgTypes... Args)
+{
+    return std::swprintf(Buffer, Size, Format, Args...);
+}
+
+#define _countof(Array) (sizeof(Array) / sizeof((Array)[0]))
+#define _stricmp strcasecmp
+#define _strnicmp strncasecmp
+
+#include "UEContainer.h"
+#include "FlatHashMap.h"
+#include "PathUtils.h"
+
+#define UE_LOG(...) (std::printf(__VA_ARGS__), std::printf("\n"))
+
+// Core Project Headers
+#include "Enums.h"
+#include "Vector.h"
+#include "AABB.h"
+#include "ResourceData.h"
+#include "VertexData.h"
+#include "Renderer.h"
@@ -0,0 +1,40 @@
+﻿#pragma once
+
+// 리눅스 테스트용 psapi.h 대역 (AssetRegistry.cpp의 GetStartupReport)
+// /proc/self/status의 VmRSS/VmHWM/VmData를 워킹셋/최대 워킹셋/private 바이트 자리에 채움
+
+typedef struct _PROCESS_MEMORY_COUNTERS
+{
+    DWORD cb;
+    SIZE_T WorkingSetSize;
+    SIZE_T PeakWorkingSetSize;
+} PROCESS_MEMORY_COUNTERS;
+
+typedef struct _PROCESS_MEMORY_COUNTERS_EX
+{
+    DWORD cb;
+    SIZE_T WorkingSetSize;
+    SIZE_T PeakWorkingSetSize;
+    SIZE_T PrivateUsage;
+} PROCESS_MEMORY_COUNTERS_EX;
+
+inline HANDLE GetCurrentProcess()
+{
+    return nullptr;
+}
+
+inline BOOL GetProcessMemoryInfo(HANDLE, PROCESS_MEMORY_COUNTERS* Counters, DWORD Size)
+{
+    std::ifstream Status("/proc/self/status");
+    std::string Line;
+    PROCESS_MEMORY_COUNTERS_EX Result = {};
+    while (std::getline(Status, Line))
+    {
+        SIZE_T KiloBytes = 0;
+        if (std::sscanf(Line.c_str(), "VmRSS: %zu", &KiloBytes) == 1) Result.WorkingSetSize = KiloBytes * 1024;
+        else if (std::sscanf(Line.c_str(), "VmHWM: %zu", &KiloBytes) == 1) Result.PeakWorkingSetSize = KiloBytes * 1024;
+        else if (std::sscanf(Line.c_str(), "VmData: %zu", &KiloBytes) == 1) Result.PrivateUsage = KiloBytes * 1024;
+    }
+    std::memcpy(Counters, &Result, std::min<size_t>(Size, sizeof(Result)));
+    return TRUE;
+}
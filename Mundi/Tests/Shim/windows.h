@@ -0,0 +1,199 @@
+﻿#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 리눅스 테스트용 windows.h 대역
+// 테스트가 컴파일하는 엔진 소스가 부르는 Win32 API만 POSIX로 채움
+// - 문자열 변환은 바이트 단위 복사 (테스트 경로/이름은 ASCII만 씀)
+// - 파일 맵핑(CookedAsset.cpp)은 open + mmap
+
+typedef size_t SIZE_T;
+typedef int BOOL;
+typedef unsigned long DWORD;
+typedef long long LONGLONG;
+typedef void* HANDLE;
+typedef unsigned int UINT;
+typedef long HRESULT;
+
+#define IN
+#define OUT
+#define TRUE 1
+#define FALSE 0
+#define S_OK ((HRESULT)0L)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+// ──────────────────────────────────────────────
+// 문자열 인코딩 (UEContainer.h, PathUtils.h)
+// ──────────────────────────────────────────────
+
+#define CP_ACP 0
+#define CP_UTF8 65001
+
+namespace WindowsShim
+{
+    // SourceLength가 -1이면 널 문자까지 포함한 길이 (Win32와 같음)
+    template<typename SourceChar, typename DestChar>
+    int ConvertChars(const SourceChar* Source, int SourceLength, DestChar* Dest, int DestLength)
+    {
+        int Length = SourceLength;
+        if (Length < 0)
+        {
+            Length = 0;
+            while (Source[Length] != 0)
+            {
+                ++Length;
+            }
+            ++Length;
+        }
+        if (!Dest || DestLength == 0)
+        {
+            return Length;
+        }
+        if (DestLength < Length)
+        {
+            return 0;
+        }
+        for (int Index = 0; Index < Length; ++Index)
+        {
+            Dest[Index] = static_cast<DestChar>(static_cast<unsigned char>(Source[Index]));
+        }
+        return Length;
+    }
+}
+
+inline int MultiByteToWideChar(unsigned CodePage, DWORD Flags, const char* Source, int SourceLength, wchar_t* Dest, int DestLength)
+{
+    return WindowsShim::ConvertChars(Source, SourceLength, Dest, DestLength);
+}
+
+inline int WideCharToMultiByte(unsigned CodePage, DWORD Flags, const wchar_t* Source, int SourceLength, char* Dest, int DestLength, const char*, BOOL*)
+{
+    return WindowsShim::ConvertChars(Source, SourceLength, Dest, DestLength);
+}
+
+// ──────────────────────────────────────────────
+// 고해상도 타이머 (PlatformTime.h, 나노초 단위)
+// ──────────────────────────────────────────────
+
+union LARGE_INTEGER
+{
+    LONGLONG QuadPart;
+};
+
+inline BOOL QueryPerformanceFrequency(LARGE_INTEGER* Frequency)
+{
+    Frequency->QuadPart = 1000000000LL;
+    return TRUE;
+}
+
+inline BOOL QueryPerformanceCounter(LARGE_INTEGER* Counter)
+{
+    Counter->QuadPart = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return TRUE;
+}
+
+// ──────────────────────────────────────────────
+// 읽기 전용 파일 맵핑 (CookedAsset.cpp)
+// ──────────────────────────────────────────────
+
+#define GENERIC_READ 0x80000000u
+#define FILE_SHARE_READ 0x1u
+#define OPEN_EXISTING 3u
+#define FILE_ATTRIBUTE_NORMAL 0x80u
+#define FILE_FLAG_SEQUENTIAL_SCAN 0x08000000u
+#define PAGE_READONLY 0x02u
+#define FILE_MAP_READ 0x4u
+#define INVALID_HANDLE_VALUE (reinterpret_cast<HANDLE>(static_cast<intptr_t>(-1)))
+
+namespace WindowsShim
+{
+    /** 파일 핸들과 맵핑 핸들 모두 이 객체 (CloseHandle에서 fd를 닫음) */
+    struct FFileObject
+    {
+        int Descriptor = -1;
+        bool bMapping = false;
+    };
+
+    /** munmap에 길이가 필요하므로 뷰 주소 → 길이를 기억 */
+    inline std::mutex ViewMutex;
+    inline std::unordered_map<const void*, size_t> ViewSizes;
+
+    inline size_t GetDescriptorSize(int Descriptor)
+    {
+        struct stat Stat {};
+        return fstat(Descriptor, &Stat) == 0 ? static_cast<size_t>(Stat.st_size) : 0;
+    }
+}
+
+inline HANDLE CreateFileW(const wchar_t* FileName, DWORD, DWORD, void*, DWORD, DWORD, HANDLE)
+{
+    std::string NarrowName;
+    for (const wchar_t* Char = FileName; *Char; ++Char)
+    {
+        NarrowName.push_back(static_cast<char>(*Char));
+    }
+    const int Descriptor = open(NarrowName.c_str(), O_RDONLY);
+    if (Descriptor < 0)
+    {
+        return INVALID_HANDLE_VALUE;
+    }
+    return new WindowsShim::FFileObject{ Descriptor, false };
+}
+
+inline BOOL GetFileSizeEx(HANDLE File, LARGE_INTEGER* OutSize)
+{
+    OutSize->QuadPart = static_cast<LONGLONG>(WindowsShim::GetDescriptorSize(static_cast<WindowsShim::FFileObject*>(File)->Descriptor));
+    return TRUE;
+}
+
+inline HANDLE CreateFileMappingW(HANDLE File, void*, DWORD, DWORD, DWORD, const wchar_t*)
+{
+    const int Descriptor = dup(static_cast<WindowsShim::FFileObject*>(File)->Descriptor);
+    return Descriptor < 0 ? nullptr : new WindowsShim::FFileObject{ Descriptor, true };
+}
+
+inline void* MapViewOfFile(HANDLE Mapping, DWORD, DWORD, DWORD, SIZE_T)
+{
+    const int Descriptor = static_cast<WindowsShim::FFileObject*>(Mapping)->Descriptor;
+    const size_t Size = WindowsShim::GetDescriptorSize(Descriptor);
+    void* View = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+    if (View == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> Lock(WindowsShim::ViewMutex);
+    WindowsShim::ViewSizes[View] = Size;
+    return View;
+}
+
+inline BOOL UnmapViewOfFile(const void* View)
+{
+    size_t Size = 0;
+    {
+        std::lock_guard<std::mutex> Lock(WindowsShim::ViewMutex);
+        auto It = WindowsShim::ViewSizes.find(View);
+        if (It == WindowsShim::ViewSizes.end())
+        {
+            return FALSE;
+        }
+        Size = It->second;
+        WindowsShim::ViewSizes.erase(It);
+    }
+    return munmap(const_cast<void*>(View), Size) == 0;
+}
+
+inline BOOL CloseHandle(HANDLE Handle)
+{
+    WindowsShim::FFileObject* Object = static_cast<WindowsShim::FFileObject*>(Handle);
+    close(Object->Descriptor);
+    delete Object;
+    return TRUE;
+}
@@ -0,0 +1,271 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <atomic>
+
+// FTaskGraph / ParallelFor 검사
+// - Initialize 전 즉시 실행, 선행 작업/Then, 워커 안에서 작업을 만들고 기다리기(중첩), ParallelFor 범위 분할
+// - 워커 수 1/2/4/8로 다시 띄우며 같은 결과인지
+// - --bench: 작업 하나당 스케줄링 비용(Launch→완료), 의존성 사슬 지연, ParallelFor 워커 수별 확장성
+
+namespace
+{
+    FTaskGraph& TaskGraph = FTaskGraph::GetInstance();
+
+    void TestInlineBeforeInitialize()
+    {
+        int32 Value = 0;
+        FTaskHandle Handle = TaskGraph.Launch([&Value] { Value = 1; });
+        TEST_CHECK(Value == 1 && Handle.IsCompleted());
+
+        FTaskHandle Next = Handle.Then([&Value] { Value = 2; });
+        TEST_CHECK(Value == 2 && Next.IsCompleted());
+
+        int64 Sum = 0;
+        ParallelFor(1000, [&Sum](int32 Index) { Sum += Index; }, 16);
+        TEST_CHECK(Sum == 999 * 1000 / 2);
+    }
+
+    void TestDependencies()
+    {
+        for (int32 Repeat = 0; Repeat < 20; ++Repeat)
+        {
+            std::atomic<int32> Count{ 0 };
+            TArray<FTaskHandle> Handles;
+            for (int32 Index = 0; Index < 2000; ++Index)
+            {
+                Handles.Add(TaskGraph.Launch([&Count] { Count.fetch_add(1); }));
+            }
+
+            // 선행 작업이 모두 끝난 뒤에만 실행되어야 함
+            std::atomic<bool> bSawAll{ false };
+            FTaskHandle Join = TaskGraph.Launch([&] { bSawAll = Count.load() == 2000; }, Handles);
+            std::atomic<int32> ThenOrder{ 0 };
+            FTaskHandle Last = Join.Then([&] { ThenOrder = bSawAll ? 1 : -1; });
+            Last.Wait();
+
+            TEST_CHECK(bSawAll);
+            TEST_CHECK(ThenOrder == 1);
+            TEST_CHECK(Join.IsCompleted());
+        }
+
+        // 이미 끝난 작업을 선행으로 줘도 바로 실행
+        FTaskHandle Done = TaskGraph.Launch([] {});
+        Done.Wait();
+        std::atomic<bool> bRan{ false };
+        TaskGraph.Launch([&bRan] { bRan = true; }, { Done, FTaskHandle() }).Wait();
+        TEST_CHECK(bRan);
+    }
+
+    // 작업이 작업을 만들고 기다림 → 기다리는 워커가 다른 작업을 대신 실행해야 교착되지 않음
+    void TestNestedWait()
+    {
+        std::atomic<int32> Count{ 0 };
+        std::function<void(int32)> Recurse = [&](int32 Depth)
+        {
+            Count.fetch_add(1);
+            if (Depth < 12)
+            {
+                FTaskHandle Left = TaskGraph.Launch([&, Depth] { Recurse(Depth + 1); });
+                FTaskHandle Right = TaskGraph.Launch([&, Depth] { Recurse(Depth + 1); });
+                Left.Wait();
+                Right.Wait();
+            }
+        };
+        TaskGraph.Launch([&] { Recurse(0); }).Wait();
+        TEST_CHECK(Count == (1 << 13) - 1);
+
+        // 작업 안의 ParallelFor
+        std::atomic<int64> Sum{ 0 };
+        TArray<FTaskHandle> Handles;
+        for (int32 Outer = 0; Outer < 8; ++Outer)
+        {
+            Handles.Add(TaskGraph.Launch([&Sum]
+            {
+                ParallelFor(10000, [&Sum](int32 Index) { Sum.fetch_add(Index, std::memory_order_relaxed); }, 64);
+            }));
+        }
+        TaskGraph.WaitAll(Handles);
+        TEST_CHECK(Sum == 8ll * 9999 * 10000 / 2);
+    }
+
+    // 모든 인덱스를 정확히 한 번, 묶음은 GrainSize 경계로
+    void TestParallelForCoverage()
+    {
+        for (int32 Num : { 0, 1, 7, 1000, 1000003 })
+        {
+            for (int32 GrainSize : { 1, 64, 1024, 5000000 })
+            {
+                if (Num > 100000 && GrainSize == 1)
+                {
+                    continue;
+                }
+
+                std::vector<std::atomic<uint8>> Hits(Num);
+                std::atomic<int32> NumBadRanges{ 0 };
+                ParallelForRange(Num, [&](int32 Begin, int32 End)
+                {
+                    if (Begin % GrainSize != 0 || End - Begin > GrainSize || (End - Begin < GrainSize && End != Num))
+                    {
+                        NumBadRanges.fetch_add(1);
+                    }
+                    for (int32 Index = Begin; Index < End; ++Index)
+                    {
+                        Hits[Index].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }, GrainSize);
+
+                int32 NumExactlyOnce = 0;
+                for (const std::atomic<uint8>& Hit : Hits)
+                {
+                    NumExactlyOnce += Hit.load() == 1 ? 1 : 0;
+                }
+                TEST_CHECK(NumExactlyOnce == Num);
+                TEST_CHECK(NumBadRanges == 0);
+            }
+        }
+    }
+
+    // 벤치마크/확장성 측정용 계산 (원소마다 독립, 결과는 워커 수와 무관해야 함)
+    float ComputeElement(int32 Index, int32 Work)
+    {
+        float Value = float(Index);
+        for (int32 Step = 0; Step < Work; ++Step)
+        {
+            Value = Value * 0.999f + std::sqrt(Value + float(Step));
+        }
+        return Value;
+    }
+
+    void RunAllTests()
+    {
+        TestDependencies();
+        TestNestedWait();
+        TestParallelForCoverage();
+    }
+
+    // 워커 수를 바꿔 다시 띄워도 ParallelFor 결과가 직렬과 같은지
+    void TestScalingResults()
+    {
+        const int32 Num = 200000;
+        std::vector<float> Expected(Num);
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            Expected[Index] = ComputeElement(Index, 8);
+        }
+
+        for (int32 NumWorkers : { 1, 2, 4, 8 })
+        {
+            TaskGraph.Initialize(NumWorkers);
+            TEST_CHECK(TaskGraph.GetNumWorkers() == NumWorkers);
+
+            std::vector<float> Values(Num);
+            ParallelFor(Num, [&Values](int32 Index) { Values[Index] = ComputeElement(Index, 8); }, 512);
+            TEST_CHECK(std::memcmp(Values.data(), Expected.data(), sizeof(float) * Num) == 0);
+
+            RunAllTests();
+            TaskGraph.Shutdown();
+            TEST_CHECK(!TaskGraph.IsRunning());
+        }
+    }
+
+    // 빈 작업 NumTasks개를 Launch하고 WaitAll까지 걸린 시간 / 작업 수
+    double MeasureLaunchOverheadNS(int32 NumTasks, bool bFromWorker)
+    {
+        std::atomic<int32> Count{ 0 };
+        MundiTest::FTimer Timer;
+        auto LaunchAll = [&]
+        {
+            TArray<FTaskHandle> Handles;
+            Handles.Reserve(NumTasks);
+            for (int32 Index = 0; Index < NumTasks; ++Index)
+            {
+                Handles.Add(TaskGraph.Launch([&Count] { Count.fetch_add(1, std::memory_order_relaxed); }));
+            }
+            TaskGraph.WaitAll(Handles);
+        };
+
+        if (bFromWorker)
+        {
+            // 워커 안에서 올리면 자기 덱으로 (전역 큐를 거치지 않음)
+            TaskGraph.Launch(LaunchAll).Wait();
+        }
+        else
+        {
+            LaunchAll();
+        }
+        return Timer.ElapsedMS() * 1e6 / NumTasks;
+    }
+
+    // A→B→C… 사슬: 작업 하나가 끝나고 다음 작업이 시작되기까지의 지연
+    double MeasureChainLatencyNS(int32 Length)
+    {
+        MundiTest::FTimer Timer;
+        FTaskHandle Last = TaskGraph.Launch([] {});
+        for (int32 Index = 1; Index < Length; ++Index)
+        {
+            Last = Last.Then([] {});
+        }
+        Last.Wait();
+        return Timer.ElapsedMS() * 1e6 / Length;
+    }
+
+    void RunBenchmarks()
+    {
+        const uint32 HardwareThreads = std::thread::hardware_concurrency();
+        std::printf("[TaskGraph Bench] hardware threads %u\n", HardwareThreads);
+
+        // 1. 스케줄링 비용
+        TaskGraph.Initialize(std::max(1, int32(HardwareThreads) - 1));
+        MeasureLaunchOverheadNS(10000, false);
+        std::printf("  Launch+Wait (game thread -> global queue) : %7.1f ns/task\n", MeasureLaunchOverheadNS(100000, false));
+        std::printf("  Launch+Wait (worker -> own deque)         : %7.1f ns/task\n", MeasureLaunchOverheadNS(100000, true));
+        std::printf("  Then chain                                : %7.1f ns/link\n", MeasureChainLatencyNS(100000));
+        std::printf("  stolen tasks so far %llu\n", (unsigned long long)TaskGraph.GetNumStolenTasks());
+        TaskGraph.Shutdown();
+
+        // 2. ParallelFor 확장성 (워커 0 = Initialize 전 → 호출 스레드에서 직렬)
+        const int32 Num = 1 << 20;
+        std::vector<float> Values(Num);
+        for (int32 Work : { 4, 64 })
+        {
+            std::printf("  ParallelFor %d elements, %d steps/element\n", Num, Work);
+            double SerialMS = 0.0;
+            for (int32 NumWorkers : { 0, 1, 2, 4, 8 })
+            {
+                if (NumWorkers > 0)
+                {
+                    TaskGraph.Initialize(NumWorkers);
+                }
+                for (int32 GrainSize : { 64, 1024, 16384 })
+                {
+                    ParallelFor(Num, [&](int32 Index) { Values[Index] = ComputeElement(Index, Work); }, GrainSize);
+                    MundiTest::FTimer Timer;
+                    for (int32 Repeat = 0; Repeat < 3; ++Repeat)
+                    {
+                        ParallelFor(Num, [&](int32 Index) { Values[Index] = ComputeElement(Index, Work); }, GrainSize);
+                    }
+                    const double ElapsedMS = Timer.ElapsedMS() / 3.0;
+                    if (NumWorkers == 0 && GrainSize == 64)
+                    {
+                        SerialMS = ElapsedMS;
+                    }
+                    std::printf("    workers %d grain %5d : %8.2f ms (x%.2f)\n", NumWorkers, GrainSize, ElapsedMS, SerialMS / ElapsedMS);
+                }
+                TaskGraph.Shutdown();
+            }
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    TestInlineBeforeInitialize();
+    TestScalingResults();
+
+    if (MundiTest::HasArg(Argc, Argv, "--bench"))
+    {
+        RunBenchmarks();
+    }
+    return MundiTest::Finish("TaskGraphTests");
+}
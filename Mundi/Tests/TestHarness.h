@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// 리눅스 테스트 공용 도우미
+// - TEST_CHECK는 실패를 기록하고 계속 진행. main은 MundiTest::Finish()를 반환 (0이면 통과)
+// - 벤치마크는 인자에 --bench가 있을 때만 실행 (ctest는 정확성 검사만)
+namespace MundiTest
+{
+    inline int32 NumFailures = 0;
+
+    inline bool HasArg(int Argc, char** Argv, const char* Arg)
+    {
+        for (int Index = 1; Index < Argc; ++Index)
+        {
+            if (std::strcmp(Argv[Index], Arg) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline int Finish(const char* SuiteName)
+    {
+        if (NumFailures == 0)
+        {
+            std::printf("[%s] OK\n", SuiteName);
+            return 0;
+        }
+        std::printf("[%s] %d check(s) FAILED\n", SuiteName, NumFailures);
+        return 1;
+    }
+
+    // 벤치마크 구간 시간 (ms)
+    class FTimer
+    {
+    public:
+        FTimer() : Start(std::chrono::steady_clock::now()) {}
+
+        double ElapsedMS() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point Start;
+    };
+}
+
+#define TEST_CHECK(Cond) \
+    do \
+    { \
+        if (!(Cond)) \
+        { \
+            ++MundiTest::NumFailures; \
+            std::printf("[FAIL] %s:%d: %s\n", __FILE__, __LINE__, #Cond); \
+        } \
+    } while (0)
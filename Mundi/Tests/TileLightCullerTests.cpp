@@ -0,0 +1,630 @@
+﻿#include "pch.h"
+#include "TestHarness.h"
+#include "TileLightCuller.h"
+#include "Source/Runtime/Core/Async/TaskGraph.h"
+#include <numeric>
+#include <random>
+
+// 타일 라이트 컬링(FTileLightCuller) 검사
+// - 2D 타일: SSE 4타일 경로로 만든 타일 목록이 모든 타일 x 모든 라이트를 스칼라 판정식으로 다시 돈 목록과 정확히 같음
+//   (같은 라이트, 같은 순서. 타일 수가 4의 배수가 아닌 해상도, 화면 밖/카메라 뒤/원평면 너머 라이트 포함)
+// - 압축 레이아웃: 칸마다 (Offset, Count)가 빈틈 없이 이어지고 인덱스 영역 끝과 버퍼 끝이 같음
+// - 고정 라이트: 화면 중앙/근평면에 걸친 라이트는 중앙 타일에 있고, 카메라 뒤/원평면 너머/화면 밖 라이트는 어느 타일에도 없음
+// - 클러스터: 모든 클러스터 x 모든 라이트에 같은 판정식(타일 평면 + 클러스터 AABB)을 적용한 목록과 정확히 같음
+// - 클러스터 고정 라이트: 깊이 슬라이스 경계, 근평면에 걸친 라이트는 모든 타일의 슬라이스 0에만,
+//   벽(깊이 30) 뒤 라이트는 2D 중앙 타일에는 있지만 벽 깊이 슬라이스에는 없음
+// - 라이트 볼륨(구/원뿔) 안의 점은 셰이더와 같은 방식으로 찾은 클러스터 목록에 그 라이트가 있음 (보수성)
+// - 직렬(TaskGraph 초기화 전)과 4 워커 결과가 같음 (2D, 24 슬라이스 클러스터)
+// - --bench: 화면 안 무작위 라이트 1000개, 1080p / 4K, 2D 타일 / 24 슬라이스 클러스터의 컬링 시간과 버퍼 크기
+
+struct FTileLightCullerTestAccess
+{
+	// 타일 하나의 기대 목록: 가지치기(행 탈락)/SSE/정렬/압축 없이 라이트 순서대로 같은 판정식 적용
+	static TArray<uint32> ScalarTileList(const FTileLightCuller& Culler, int32 TileX, int32 TileY)
+	{
+		TArray<uint32> Expected;
+		for (const FTileLightCuller::FLightScreenBounds& Light : Culler.LightBounds)
+		{
+			if (Light.bVisible &&
+				TileX >= Light.MinTileX && TileX <= Light.MaxTileX && TileY >= Light.MinTileY && TileY <= Light.MaxTileY &&
+				Culler.SphereIntersectsTileRow(Light, TileY) &&
+				Culler.SphereIntersectsTileColumn(Light, TileX))
+			{
+				Expected.Add(Light.PackedIndex);
+			}
+		}
+		return Expected;
+	}
+
+	// 클러스터 하나의 기대 목록 (2D 판정식 + 클러스터 AABB, 슬라이스 범위 가지치기 없음)
+	static TArray<uint32> ScalarClusterList(const FTileLightCuller& Culler, int32 TileX, int32 TileY, int32 Slice)
+	{
+		TArray<uint32> Expected;
+		for (const FTileLightCuller::FLightScreenBounds& Light : Culler.LightBounds)
+		{
+			if (Light.bVisible &&
+				TileX >= Light.MinTileX && TileX <= Light.MaxTileX && TileY >= Light.MinTileY && TileY <= Light.MaxTileY &&
+				Culler.SphereIntersectsTileRow(Light, TileY) &&
+				Culler.SphereIntersectsTileColumn(Light, TileX) &&
+				Culler.SphereIntersectsClusterBox(Light, TileX, TileY, Slice))
+			{
+				Expected.Add(Light.PackedIndex);
+			}
+		}
+		return Expected;
+	}
+
+	static int32 GetSliceForDepth(const FTileLightCuller& Culler, float ViewDepth) { return Culler.GetSliceForDepth(ViewDepth); }
+	static const TArray<float>& GetSliceDepths(const FTileLightCuller& Culler) { return Culler.SliceDepths; }
+
+	static int32 GetTileCountX(const FTileLightCuller& Culler) { return static_cast<int32>(Culler.TileCountX); }
+	static int32 GetTileCountY(const FTileLightCuller& Culler) { return static_cast<int32>(Culler.TileCountY); }
+	static int32 GetNumSlices(const FTileLightCuller& Culler) { return static_cast<int32>(Culler.NumSlices); }
+};
+
+namespace
+{
+	// ──────────────────────────────────────────────
+	// 장면 구성 (원점에서 +Z를 보는 카메라, 뷰 공간 = 월드 공간)
+	// ──────────────────────────────────────────────
+
+	constexpr float NearPlane = 0.1f;
+	constexpr float FovY = 60.0f * PI / 180.0f;
+
+	struct FTestScene
+	{
+		TArray<FPointLightInfo> PointLights;
+		TArray<FSpotLightInfo> SpotLights;
+		FMatrix ViewMatrix = FMatrix::Identity();
+		FMatrix ProjMatrix;
+		float FarPlane = 0.0f;
+		uint32 Width = 0;
+		uint32 Height = 0;
+	};
+
+	FTestScene MakeEmptyScene(uint32 Width, uint32 Height, float FarPlane)
+	{
+		FTestScene Scene;
+		Scene.Width = Width;
+		Scene.Height = Height;
+		Scene.FarPlane = FarPlane;
+		Scene.ProjMatrix = FMatrix::PerspectiveFovLH(FovY, float(Width) / float(Height), NearPlane, FarPlane);
+		return Scene;
+	}
+
+	void AddPointLight(FTestScene& Scene, const FVector& Position, float Radius)
+	{
+		FPointLightInfo Light = {};
+		Light.Position = Position;
+		Light.AttenuationRadius = Radius;
+		Scene.PointLights.Add(Light);
+	}
+
+	void AddSpotLight(FTestScene& Scene, const FVector& Position, const FVector& Direction, float OuterConeAngle, float Radius)
+	{
+		FSpotLightInfo Light = {};
+		Light.Position = Position;
+		Light.Direction = Direction;
+		Light.OuterConeAngle = OuterConeAngle;
+		Light.InnerConeAngle = OuterConeAngle * 0.5f;
+		Light.AttenuationRadius = Radius;
+		Scene.SpotLights.Add(Light);
+	}
+
+	/**
+	 * 무작위 Point/Spot 라이트 (1/4은 Spot)
+	 * 깊이 [MinDepth, MaxDepth], 화면 가장자리 기준 ScreenSpread배 범위까지 (1보다 크면 일부는 화면 밖)
+	 */
+	FTestScene MakeRandomScene(uint32 NumLights, uint32 Width, uint32 Height, float FarPlane, uint32 Seed,
+		float MinDepth, float MaxDepth, float MinRange, float MaxRange, float ScreenSpread)
+	{
+		FTestScene Scene = MakeEmptyScene(Width, Height, FarPlane);
+		const float Aspect = float(Width) / float(Height);
+		const float TanHalfFov = std::tan(FovY * 0.5f);
+
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> Depth(MinDepth, MaxDepth);
+		std::uniform_real_distribution<float> Range(MinRange, MaxRange);
+		std::uniform_real_distribution<float> ConeAngle(10.0f, 85.0f);
+
+		for (uint32 Index = 0; Index < NumLights; ++Index)
+		{
+			const float Z = Depth(Rng);
+			const float Extent = FMath::Max(Z, 5.0f) * TanHalfFov * ScreenSpread;
+			const FVector Position(Unit(Rng) * Extent * Aspect, Unit(Rng) * Extent, Z);
+
+			if (Index % 4 == 3)
+			{
+				FVector Direction = FVector(Unit(Rng), Unit(Rng), Unit(Rng)).GetSafeNormal();
+				if (Direction.SizeSquared() < KINDA_SMALL_NUMBER)
+				{
+					Direction = FVector(0.0f, 0.0f, 1.0f);
+				}
+				AddSpotLight(Scene, Position, Direction, ConeAngle(Rng), Range(Rng));
+			}
+			else
+			{
+				AddPointLight(Scene, Position, Range(Rng));
+			}
+		}
+		return Scene;
+	}
+
+	void BuildLists(FTileLightCuller& Culler, const FTestScene& Scene, UINT TileSize, uint32 SliceCount)
+	{
+		Culler.Initialize(nullptr, TileSize);
+		Culler.SetClusterSliceCount(SliceCount);
+		Culler.BuildTileLightLists(Scene.PointLights, Scene.SpotLights, Scene.ViewMatrix, Scene.ProjMatrix,
+			NearPlane, Scene.FarPlane, Scene.Width, Scene.Height);
+	}
+
+	// 칸 하나의 목록 (압축 버퍼에서 복사)
+	TArray<uint32> GetCellList(const FTileLightCuller& Culler, uint32 Cell)
+	{
+		const TArray<uint32>& Data = Culler.GetTileLightData();
+		const uint32 Offset = Data[Cell * 2];
+		const uint32 Count = Data[Cell * 2 + 1];
+		return TArray<uint32>(Data.begin() + Offset, Data.begin() + Offset + Count);
+	}
+
+	uint32 GetCenterTile(const FTileLightCuller& Culler, const FTestScene& Scene, UINT TileSize)
+	{
+		return (Scene.Height / 2 / TileSize) * FTileLightCullerTestAccess::GetTileCountX(Culler) + Scene.Width / 2 / TileSize;
+	}
+
+	// 라이트 하나가 들어간 칸 수
+	uint32 CountCellsWithLight(const FTileLightCuller& Culler, uint32 PackedIndex)
+	{
+		const TArray<uint32>& Data = Culler.GetTileLightData();
+		const uint32 GridSize = Culler.GetStats().TotalClusterCount * 2;
+		return static_cast<uint32>(std::count(Data.begin() + GridSize, Data.end(), PackedIndex));
+	}
+
+	// ──────────────────────────────────────────────
+	// 검사
+	// ──────────────────────────────────────────────
+
+	/** 그리드의 (Offset, Count)가 인덱스 영역을 빈틈 없이 순서대로 덮음 */
+	void CheckCompactLayout(const FTileLightCuller& Culler)
+	{
+		const TArray<uint32>& Data = Culler.GetTileLightData();
+		const uint32 NumCells = static_cast<uint32>(FTileLightCullerTestAccess::GetTileCountX(Culler) * FTileLightCullerTestAccess::GetTileCountY(Culler) *
+			FTileLightCullerTestAccess::GetNumSlices(Culler));
+		TEST_CHECK(Culler.GetStats().TotalClusterCount == NumCells);
+
+		uint32 Expected = NumCells * 2;
+		bool bContiguous = true;
+		for (uint32 Cell = 0; Cell < NumCells; ++Cell)
+		{
+			bContiguous &= Data[Cell * 2] == Expected;
+			Expected += Data[Cell * 2 + 1];
+		}
+		TEST_CHECK(bContiguous);
+		TEST_CHECK(Expected == static_cast<uint32>(Data.Num()));
+		TEST_CHECK(Culler.GetStats().TotalLightsPassed == Expected - NumCells * 2);
+	}
+
+	void TestTileListsMatchScalar()
+	{
+		struct FCase
+		{
+			uint32 Width, Height;
+			UINT TileSize;
+		};
+		// 1000x563: 타일 63x36 (열 수가 4의 배수가 아니고 마지막 행/열이 잘린 타일)
+		const FCase Cases[] = { { 1280, 720, 16 }, { 1000, 563, 16 }, { 1920, 1080, 32 } };
+
+		for (const FCase& Case : Cases)
+		{
+			// 카메라 뒤, 화면 밖, 원평면 너머까지 섞음
+			const FTestScene Scene = MakeRandomScene(600, Case.Width, Case.Height, 500.0f, 1234, -20.0f, 520.0f, 1.0f, 25.0f, 1.3f);
+			FTileLightCuller Culler;
+			BuildLists(Culler, Scene, Case.TileSize, 0);
+			CheckCompactLayout(Culler);
+
+			const int32 TileCountX = FTileLightCullerTestAccess::GetTileCountX(Culler);
+			const int32 TileCountY = FTileLightCullerTestAccess::GetTileCountY(Culler);
+			TEST_CHECK(TileCountX == int32((Case.Width + Case.TileSize - 1) / Case.TileSize));
+			TEST_CHECK(TileCountY == int32((Case.Height + Case.TileSize - 1) / Case.TileSize));
+
+			uint32 NumMismatchedTiles = 0;
+			uint64 NumPairs = 0;
+			for (int32 TileY = 0; TileY < TileCountY; ++TileY)
+			{
+				for (int32 TileX = 0; TileX < TileCountX; ++TileX)
+				{
+					const TArray<uint32> Expected = FTileLightCullerTestAccess::ScalarTileList(Culler, TileX, TileY);
+					if (GetCellList(Culler, uint32(TileY * TileCountX + TileX)) != Expected)
+					{
+						++NumMismatchedTiles;
+					}
+					NumPairs += Expected.Num();
+				}
+			}
+			TEST_CHECK(NumMismatchedTiles == 0);
+			// 비교가 비어 있지 않음 (타일당 평균 라이트 수가 의미 있는 수준)
+			TEST_CHECK(NumPairs > uint64(TileCountX) * TileCountY);
+			if (NumMismatchedTiles != 0)
+			{
+				std::printf("  %ux%u tile %u: %u mismatched tiles\n", Case.Width, Case.Height, Case.TileSize, NumMismatchedTiles);
+			}
+		}
+	}
+
+	void TestFixtureLights()
+	{
+		constexpr UINT TileSize = 16;
+		FTestScene Scene = MakeEmptyScene(1280, 720, 500.0f);
+		AddPointLight(Scene, FVector(0.0f, 0.0f, 20.0f), 1.0f);		// 0: 화면 중앙
+		AddPointLight(Scene, FVector(0.0f, 0.0f, -10.0f), 2.0f);	// 1: 카메라 뒤
+		AddPointLight(Scene, FVector(0.0f, 0.0f, 520.0f), 5.0f);	// 2: 원평면 너머
+		AddPointLight(Scene, FVector(0.0f, 0.0f, 0.0f), 1.0f);		// 3: 근평면에 걸침 (화면 전체)
+		AddPointLight(Scene, FVector(-100.0f, 0.0f, 10.0f), 1.0f);	// 4: 화면 왼쪽 밖
+		AddSpotLight(Scene, FVector(0.0f, 0.0f, 10.0f), FVector(0.0f, 0.0f, 1.0f), 30.0f, 20.0f);	// Spot 0: 중앙을 비춤
+		AddSpotLight(Scene, FVector(0.0f, 0.0f, -30.0f), FVector(0.0f, 0.0f, -1.0f), 30.0f, 20.0f);	// Spot 1: 카메라 뒤에서 뒤를 비춤
+
+		FTileLightCuller Culler;
+		BuildLists(Culler, Scene, TileSize, 0);
+		CheckCompactLayout(Culler);
+
+		// 칸 목록은 Point → Spot 순서
+		const uint32 Spot0 = (1u << 16) | 0u;
+		const uint32 Spot1 = (1u << 16) | 1u;
+		const TArray<uint32> Center = GetCellList(Culler, GetCenterTile(Culler, Scene, TileSize));
+		TEST_CHECK(Center == (TArray<uint32>{ 0u, 3u, Spot0 }));
+
+		TEST_CHECK(CountCellsWithLight(Culler, 1u) == 0);
+		TEST_CHECK(CountCellsWithLight(Culler, 2u) == 0);
+		TEST_CHECK(CountCellsWithLight(Culler, 4u) == 0);
+		TEST_CHECK(CountCellsWithLight(Culler, Spot1) == 0);
+		TEST_CHECK(CountCellsWithLight(Culler, 3u) == Culler.GetStats().TotalTileCount);
+
+		// 반지름 1, 깊이 20: 화면에서 지름 약 2 / (2 * 20 * tan30) * 720 ≈ 62픽셀 → 중앙 주변 5x5 타일 안
+		const uint32 CenterCells = CountCellsWithLight(Culler, 0u);
+		TEST_CHECK(CenterCells >= 4 && CenterCells <= 25);
+		// 모서리 타일에는 화면 전체를 덮는 라이트만
+		TEST_CHECK(GetCellList(Culler, 0) == (TArray<uint32>{ 3u }));
+	}
+
+	// 칸 번호 (클러스터 모드: 타일 * 슬라이스 수 + 슬라이스)
+	uint32 GetCell(const FTileLightCuller& Culler, int32 TileX, int32 TileY, int32 Slice)
+	{
+		return uint32((TileY * FTileLightCullerTestAccess::GetTileCountX(Culler) + TileX) * FTileLightCullerTestAccess::GetNumSlices(Culler) + Slice);
+	}
+
+	// 라이트 하나가 슬라이스별로 몇 개 타일에 들어갔는지
+	TArray<uint32> GetSliceHistogram(const FTileLightCuller& Culler, uint32 PackedIndex)
+	{
+		const int32 NumSlices = FTileLightCullerTestAccess::GetNumSlices(Culler);
+		const uint32 NumTiles = Culler.GetStats().TotalTileCount;
+		TArray<uint32> Histogram(NumSlices, 0u);
+		for (uint32 Tile = 0; Tile < NumTiles; ++Tile)
+		{
+			for (int32 Slice = 0; Slice < NumSlices; ++Slice)
+			{
+				const TArray<uint32> List = GetCellList(Culler, Tile * NumSlices + Slice);
+				if (std::find(List.begin(), List.end(), PackedIndex) != List.end())
+				{
+					++Histogram[Slice];
+				}
+			}
+		}
+		return Histogram;
+	}
+
+	void TestClusterListsMatchBruteForce()
+	{
+		struct FCase
+		{
+			uint32 Width, Height;
+			UINT TileSize;
+			uint32 SliceCount;
+		};
+		const FCase Cases[] = { { 1280, 720, 16, 24 }, { 1000, 563, 32, 16 } };
+
+		for (const FCase& Case : Cases)
+		{
+			// 카메라 뒤, 화면 가장자리 밖, 원평면 너머까지 섞음
+			const FTestScene Scene = MakeRandomScene(256, Case.Width, Case.Height, 500.0f, 4321, -20.0f, 300.0f, 1.0f, 20.0f, 1.2f);
+			FTileLightCuller Culler;
+			BuildLists(Culler, Scene, Case.TileSize, Case.SliceCount);
+			CheckCompactLayout(Culler);
+			TEST_CHECK(FTileLightCullerTestAccess::GetNumSlices(Culler) == int32(Case.SliceCount));
+
+			const int32 TileCountX = FTileLightCullerTestAccess::GetTileCountX(Culler);
+			const int32 TileCountY = FTileLightCullerTestAccess::GetTileCountY(Culler);
+			const int32 NumSlices = int32(Case.SliceCount);
+
+			uint32 NumMismatchedClusters = 0;
+			uint64 NumPairs = 0;
+			for (int32 TileY = 0; TileY < TileCountY; ++TileY)
+			{
+				for (int32 TileX = 0; TileX < TileCountX; ++TileX)
+				{
+					for (int32 Slice = 0; Slice < NumSlices; ++Slice)
+					{
+						const TArray<uint32> Expected = FTileLightCullerTestAccess::ScalarClusterList(Culler, TileX, TileY, Slice);
+						if (GetCellList(Culler, GetCell(Culler, TileX, TileY, Slice)) != Expected)
+						{
+							++NumMismatchedClusters;
+						}
+						NumPairs += Expected.Num();
+					}
+				}
+			}
+			TEST_CHECK(NumMismatchedClusters == 0);
+			TEST_CHECK(NumPairs > uint64(TileCountX) * TileCountY);
+			if (NumMismatchedClusters != 0)
+			{
+				std::printf("  %ux%u, %u slices: %u mismatched clusters\n", Case.Width, Case.Height, Case.SliceCount, NumMismatchedClusters);
+			}
+		}
+	}
+
+	void TestClusterSlices()
+	{
+		// 슬라이스 0 = [Near, 5], 1..23 = 5~500 지수 분할
+		FTileLightCuller Culler;
+		BuildLists(Culler, MakeEmptyScene(1280, 720, 500.0f), 16, 24);
+
+		const TArray<float>& SliceDepths = FTileLightCullerTestAccess::GetSliceDepths(Culler);
+		TEST_CHECK(SliceDepths.Num() == 25);
+		TEST_CHECK(SliceDepths[0] == NearPlane);
+		TEST_CHECK(std::fabs(SliceDepths[1] - 5.0f) < 1e-4f);
+		TEST_CHECK(SliceDepths[24] == 500.0f);
+
+		TEST_CHECK(FTileLightCullerTestAccess::GetSliceForDepth(Culler, 1.0f) == 0);
+		TEST_CHECK(FTileLightCullerTestAccess::GetSliceForDepth(Culler, 4.9f) == 0);
+		TEST_CHECK(FTileLightCullerTestAccess::GetSliceForDepth(Culler, 5.1f) == 1);
+		TEST_CHECK(FTileLightCullerTestAccess::GetSliceForDepth(Culler, 499.0f) == 23);
+		TEST_CHECK(FTileLightCullerTestAccess::GetSliceForDepth(Culler, 1000.0f) == 23);
+
+		// 셰이더 식 floor(log(z) * Scale + Bias)이 각 슬라이스 가운데(기하 평균) 깊이에서 그 슬라이스
+		bool bShaderSlicesMatch = true;
+		for (int32 Slice = 1; Slice < 24; ++Slice)
+		{
+			const float MidDepth = std::sqrt(SliceDepths[Slice] * SliceDepths[Slice + 1]);
+			const float ShaderSlice = std::floor(std::log(MidDepth) * Culler.GetClusterDepthScale() + Culler.GetClusterDepthBias());
+			bShaderSlicesMatch &= int32(ShaderSlice) == Slice;
+			bShaderSlicesMatch &= FTileLightCullerTestAccess::GetSliceForDepth(Culler, MidDepth) == Slice;
+		}
+		TEST_CHECK(bShaderSlicesMatch);
+	}
+
+	void TestClusterFixtureLights()
+	{
+		// 깊이 30의 벽이 화면 전체를 가리고, 벽 뒤(깊이 70~90)에 라이트가 모여 있는 복도
+		constexpr UINT TileSize = 16;
+		constexpr float WallDepth = 30.0f;
+		FTestScene Scene = MakeEmptyScene(1280, 720, 500.0f);
+		AddPointLight(Scene, FVector(0.0f, 0.0f, 0.0f), 1.0f);			// 0: 근평면에 걸침
+		AddPointLight(Scene, FVector(0.0f, 0.0f, WallDepth), 1.0f);		// 1: 벽 위 중앙
+		for (int32 Row = -1; Row <= 1; ++Row)							// 2..16: 벽 뒤 5x3
+		{
+			for (int32 Column = -2; Column <= 2; ++Column)
+			{
+				AddPointLight(Scene, FVector(Column * 25.0f, Row * 18.0f, 80.0f), 10.0f);
+			}
+		}
+		constexpr uint32 BehindWallCenter = 2 + 7;						// (0, 0, 80)
+
+		FTileLightCuller Culler;
+		BuildLists(Culler, Scene, TileSize, 0);
+		const TArray<uint32> Center2D = GetCellList(Culler, GetCenterTile(Culler, Scene, TileSize));
+		TEST_CHECK(std::find(Center2D.begin(), Center2D.end(), BehindWallCenter) != Center2D.end());
+		const float AvgLightsPerTile2D = Culler.GetStats().AvgLightsPerTile;
+
+		BuildLists(Culler, Scene, TileSize, 24);
+		CheckCompactLayout(Culler);
+		const uint32 NumTiles = Culler.GetStats().TotalTileCount;
+		const int32 WallSlice = FTileLightCullerTestAccess::GetSliceForDepth(Culler, WallDepth);
+
+		// 근평면 라이트: 모든 타일의 슬라이스 0에만
+		const TArray<uint32> NearHistogram = GetSliceHistogram(Culler, 0u);
+		TEST_CHECK(NearHistogram[0] == NumTiles);
+		TEST_CHECK(std::accumulate(NearHistogram.begin(), NearHistogram.end(), 0u) == NumTiles);
+
+		// 벽 위 라이트: 깊이 [29, 31]에 걸친 슬라이스에만, 중앙 타일의 벽 슬라이스에 있음
+		const TArray<uint32> WallHistogram = GetSliceHistogram(Culler, 1u);
+		const int32 WallMinSlice = FTileLightCullerTestAccess::GetSliceForDepth(Culler, WallDepth - 1.0f);
+		const int32 WallMaxSlice = FTileLightCullerTestAccess::GetSliceForDepth(Culler, WallDepth + 1.0f);
+		bool bWallLightInRange = true;
+		for (int32 Slice = 0; Slice < WallHistogram.Num(); ++Slice)
+		{
+			bWallLightInRange &= WallHistogram[Slice] == 0 || (Slice >= WallMinSlice && Slice <= WallMaxSlice);
+		}
+		TEST_CHECK(bWallLightInRange);
+		const int32 CenterTileX = int32(Scene.Width / 2 / TileSize);
+		const int32 CenterTileY = int32(Scene.Height / 2 / TileSize);
+		TEST_CHECK(GetCellList(Culler, GetCell(Culler, CenterTileX, CenterTileY, WallSlice)) == (TArray<uint32>{ 1u }));
+
+		// 벽 뒤 라이트: 벽 깊이 슬라이스에는 하나도 없고, 중앙 라이트는 중앙 타일의 깊이 80 슬라이스에 있음
+		uint32 BehindWallAtWall = 0;
+		for (uint32 PackedIndex = 2; PackedIndex < 17; ++PackedIndex)
+		{
+			BehindWallAtWall += GetSliceHistogram(Culler, PackedIndex)[WallSlice];
+		}
+		TEST_CHECK(BehindWallAtWall == 0);
+		const int32 Slice80 = FTileLightCullerTestAccess::GetSliceForDepth(Culler, 80.0f);
+		const TArray<uint32> Center80 = GetCellList(Culler, GetCell(Culler, CenterTileX, CenterTileY, Slice80));
+		TEST_CHECK(std::find(Center80.begin(), Center80.end(), BehindWallCenter) != Center80.end());
+
+		// 벽 앞 픽셀이 순회하는 라이트 수: 2D 타일 평균보다 벽 슬라이스 평균이 작음
+		uint64 WallLightCount = 0;
+		for (uint32 Tile = 0; Tile < NumTiles; ++Tile)
+		{
+			WallLightCount += GetCellList(Culler, Tile * 24 + WallSlice).Num();
+		}
+		TEST_CHECK(float(WallLightCount) / NumTiles < AvgLightsPerTile2D);
+	}
+
+	/** 라이트 볼륨 안의 점 → 셰이더와 같은 방식으로 찾은 클러스터 목록에 그 라이트가 있음 */
+	void TestClusterVolumeSamples()
+	{
+		constexpr UINT TileSize = 16;
+		const FTestScene Scene = MakeRandomScene(256, 1280, 720, 500.0f, 4321, -20.0f, 300.0f, 1.0f, 20.0f, 1.2f);
+		FTileLightCuller Culler;
+		BuildLists(Culler, Scene, TileSize, 24);
+
+		const FMatrix& Proj = Scene.ProjMatrix;
+		uint32 NumSamples = 0;
+		uint32 NumMissedSamples = 0;
+		auto CheckSample = [&](const FVector& ViewPoint, uint32 PackedIndex)
+		{
+			if (ViewPoint.Z < NearPlane || ViewPoint.Z > Scene.FarPlane)
+			{
+				return;
+			}
+
+			const float NdcX = (ViewPoint.X * Proj.M[0][0] + ViewPoint.Z * Proj.M[2][0]) / ViewPoint.Z;
+			const float NdcY = (ViewPoint.Y * Proj.M[1][1] + ViewPoint.Z * Proj.M[2][1]) / ViewPoint.Z;
+			const float PixelX = (NdcX * 0.5f + 0.5f) * Scene.Width;
+			const float PixelY = (0.5f - NdcY * 0.5f) * Scene.Height;
+			if (PixelX < 0.0f || PixelX >= Scene.Width || PixelY < 0.0f || PixelY >= Scene.Height)
+			{
+				return;
+			}
+
+			const int32 Slice = FTileLightCullerTestAccess::GetSliceForDepth(Culler, ViewPoint.Z);
+			const TArray<uint32> List = GetCellList(Culler, GetCell(Culler, int32(PixelX) / TileSize, int32(PixelY) / TileSize, Slice));
+			++NumSamples;
+			if (std::find(List.begin(), List.end(), PackedIndex) == List.end())
+			{
+				++NumMissedSamples;
+			}
+		};
+
+		// 절반은 표면 바로 안, 절반은 내부
+		constexpr int32 SamplesPerLight = 64;
+		std::mt19937 Rng(8765);
+		std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> Unit01(0.0f, 1.0f);
+		for (int32 Index = 0; Index < Scene.PointLights.Num(); ++Index)
+		{
+			const FPointLightInfo& Light = Scene.PointLights[Index];
+			for (int32 Sample = 0; Sample < SamplesPerLight; ++Sample)
+			{
+				const FVector Direction = FVector(Unit(Rng), Unit(Rng), Unit(Rng)).GetSafeNormal();
+				const float Distance = Light.AttenuationRadius * 0.999f * (Sample % 2 == 0 ? 1.0f : std::cbrt(Unit01(Rng)));
+				CheckSample(Light.Position + Direction * Distance, uint32(Index));
+			}
+		}
+		for (int32 Index = 0; Index < Scene.SpotLights.Num(); ++Index)
+		{
+			const FSpotLightInfo& Light = Scene.SpotLights[Index];
+			const FVector Axis = Light.Direction;
+			const FVector Helper = std::fabs(Axis.X) < 0.9f ? FVector(1.0f, 0.0f, 0.0f) : FVector(0.0f, 1.0f, 0.0f);
+			const FVector Tangent = FVector::Cross(Axis, Helper).GetSafeNormal();
+			const FVector Bitangent = FVector::Cross(Axis, Tangent);
+			const float HalfAngle = DegreesToRadians(Light.OuterConeAngle);
+			for (int32 Sample = 0; Sample < SamplesPerLight; ++Sample)
+			{
+				const float Angle = Unit01(Rng) * HalfAngle;
+				const float Phi = Unit01(Rng) * 2.0f * PI;
+				const float Distance = Light.AttenuationRadius * 0.999f * (Sample % 2 == 0 ? 1.0f : Unit01(Rng));
+				const FVector Direction = Axis * std::cos(Angle) + (Tangent * std::cos(Phi) + Bitangent * std::sin(Phi)) * std::sin(Angle);
+				CheckSample(Light.Position + Direction * Distance, (1u << 16) | uint32(Index));
+			}
+		}
+
+		TEST_CHECK(NumMissedSamples == 0);
+		TEST_CHECK(NumSamples > 4000);
+		if (NumMissedSamples != 0)
+		{
+			std::printf("  volume samples: %u of %u missed\n", NumMissedSamples, NumSamples);
+		}
+	}
+
+	/** TaskGraph 초기화 전에 만든 목록 (ParallelFor가 호출 스레드에서 직렬로 돎) */
+	struct FSerialResult
+	{
+		TArray<uint32> Data2D;
+		TArray<uint32> DataClustered;
+	};
+
+	FSerialResult BuildSerialReference(const FTestScene& Scene)
+	{
+		FSerialResult Result;
+		FTileLightCuller Culler;
+		BuildLists(Culler, Scene, 16, 0);
+		Result.Data2D = Culler.GetTileLightData();
+		BuildLists(Culler, Scene, 16, 24);
+		Result.DataClustered = Culler.GetTileLightData();
+		return Result;
+	}
+
+	void TestParallelMatchesSerial(const FTestScene& Scene, const FSerialResult& Serial)
+	{
+		FTileLightCuller Culler;
+		BuildLists(Culler, Scene, 16, 0);
+		TEST_CHECK(Culler.GetTileLightData() == Serial.Data2D);
+		BuildLists(Culler, Scene, 16, 24);
+		TEST_CHECK(Culler.GetTileLightData() == Serial.DataClustered);
+		CheckCompactLayout(Culler);
+	}
+
+	// ──────────────────────────────────────────────
+	// 벤치마크
+	// ──────────────────────────────────────────────
+
+	void RunBenchmark()
+	{
+		constexpr uint32 NumLights = 1000;
+		constexpr int32 NumIterations = 20;
+		const uint32 Resolutions[2][2] = { { 1920, 1080 }, { 3840, 2160 } };
+		const uint32 SliceCounts[2] = { 0, 24 };
+
+		std::printf("TILE CULLING BENCH (%u lights on screen, %d workers)\n", NumLights, FTaskGraph::GetInstance().GetNumWorkers());
+		for (const auto& Resolution : Resolutions)
+		{
+			const FTestScene Scene = MakeRandomScene(NumLights, Resolution[0], Resolution[1], 1000.0f, 1234, 5.0f, 200.0f, 2.0f, 15.0f, 1.0f);
+			for (const uint32 SliceCount : SliceCounts)
+			{
+				// 첫 실행에서 버퍼 할당을 끝낸 뒤 측정
+				FTileLightCuller Culler;
+				BuildLists(Culler, Scene, 16, SliceCount);
+
+				MundiTest::FTimer Timer;
+				for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+				{
+					BuildLists(Culler, Scene, 16, SliceCount);
+				}
+				const double CullMS = Timer.ElapsedMS() / NumIterations;
+
+				const FTileCullingStats& Stats = Culler.GetStats();
+				std::printf("  %ux%u, %u tiles, %u slices: cull %.3f ms, %u indices (%.1f per cell)\n",
+					Resolution[0], Resolution[1], Stats.TotalTileCount, SliceCount, CullMS, Stats.TotalLightsPassed,
+					Stats.TotalClusterCount > 0 ? float(Stats.TotalLightsPassed) / Stats.TotalClusterCount : 0.0f);
+				std::printf("    buffer %u KB (fixed 256/tile: %u KB)\n",
+					Stats.LightIndexBufferSizeBytes / 1024, uint32(Stats.TotalTileCount * 256 * sizeof(uint32)) / 1024);
+			}
+		}
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	TestTileListsMatchScalar();
+	TestFixtureLights();
+	TestClusterSlices();
+	TestClusterFixtureLights();
+
+	const FTestScene Scene = MakeRandomScene(800, 1000, 563, 500.0f, 99, -20.0f, 300.0f, 1.0f, 20.0f, 1.2f);
+	const FSerialResult Serial = BuildSerialReference(Scene);
+
+	FTaskGraph::GetInstance().Initialize(4);
+
+	TestParallelMatchesSerial(Scene, Serial);
+	TestTileListsMatchScalar();
+	TestClusterListsMatchBruteForce();
+	TestClusterVolumeSamples();
+
+	if (MundiTest::HasArg(Argc, Argv, "--bench"))
+	{
+		RunBenchmark();
+	}
+
+	FTaskGraph::GetInstance().Shutdown();
+	return MundiTest::Finish("TileLightCullerTests");
+}
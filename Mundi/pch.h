@@ -5,6 +5,12 @@
 #define USE_DDS_CACHE
 #define USE_OBJ_CACHE
 
+// STAT ALLOC: 전역 operator new/delete를 교체해 프레임당 힙 할당을 셈 (AllocationCounter.cpp)
+// 에디터/디버그 빌드에서만 교체. 릴리스 게임 빌드는 기본 할당자를 그대로 씀
+#if defined(_EDITOR) || defined(_DEBUG)
+#define USE_ALLOCATION_STATS
+#endif
+
 #define IMGUI_DEFINE_MATH_OPERATORS	// Imgui에서 곡선 표시를 위한 전용 벡터 연산자 활성화
 
 // Linker
@@ -52,6 +58,7 @@
 #include "ResourceData.h"
 #include "VertexData.h"
 #include "UEContainer.h"
+#include "FlatHashMap.h"
 #include "Name.h"
 #include "PathUtils.h"
 #include "Object.h"